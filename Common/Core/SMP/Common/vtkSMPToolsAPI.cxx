@@ -2,13 +2,20 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "SMP/Common/vtkSMPToolsAPI.h"
-#include "vtkSMP.h"    // For SMP preprocessor information
-#include "vtkSetGet.h" // For vtkWarningMacro
+#include "vtkCxxABIConfigure.h" // For abi::__cxa_demangle
+#include "vtkSMP.h"             // For SMP preprocessor information
+#include "vtkSetGet.h"          // For vtkWarningMacro
 
 #include <algorithm> // For std::toupper
+#include <chrono>    // For std::chrono::steady_clock
+#include <cstdio>    // For snprintf
 #include <cstdlib>   // For std::getenv
 #include <iostream>  // For std::cerr
+#include <mutex>     // For std::mutex
+#include <sstream>   // For std::ostringstream
 #include <string>    // For std::string
+#include <thread>    // For std::this_thread
+#include <utility>   // For std::pair
 
 namespace vtk
 {
@@ -48,6 +55,13 @@ vtkSMPToolsAPI::vtkSMPToolsAPI()
 
   // Set max thread number from env
   this->RefreshNumberOfThread();
+
+  // Enable the instrumentation from env if set
+  const char* vtkSMPInstrumentation = std::getenv("VTK_SMP_INSTRUMENTATION");
+  if (vtkSMPInstrumentation && std::atoi(vtkSMPInstrumentation) != 0)
+  {
+    this->SetInstrumentationEnabled(true);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -271,6 +285,239 @@ bool vtkSMPToolsAPI::GetSingleThread()
   }
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+struct vtkSMPInstrumentationStorage
+{
+  std::mutex Mutex;
+  std::vector<vtkSMPForStatistics> Statistics;
+};
+
+vtkSMPInstrumentationStorage& GetInstrumentationStorage()
+{
+  static vtkSMPInstrumentationStorage storage;
+  return storage;
+}
+
+// Label of the For invocations of the calling thread.
+thread_local std::string vtkSMPInstrumentationLabel;
+
+double GetInstrumentationTime()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+// Name a For invocation after the functor given to vtkSMPTools::For: strip
+// the internal wrapper from the demangled name of the internal functor.
+std::string GetFunctorName(const std::type_info& functorType)
+{
+  std::string name = functorType.name();
+#ifdef VTK_HAS_CXXABI_DEMANGLE
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+  if (!status && demangled)
+  {
+    name = demangled;
+  }
+  free(demangled);
+#endif
+  const std::string wrapper = "vtkSMPTools_FunctorInternal<";
+  const std::string::size_type begin = name.find(wrapper);
+  const std::string::size_type end = name.rfind(',');
+  if (begin != std::string::npos && end != std::string::npos && end > begin)
+  {
+    name = name.substr(begin + wrapper.size(), end - begin - wrapper.size());
+  }
+  return name;
+}
+
+void WriteJSONString(std::ostream& os, const std::string& str)
+{
+  os << '"';
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      os << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+      os << buffer;
+    }
+    else
+    {
+      os << c;
+    }
+  }
+  os << '"';
+}
+}
+
+//------------------------------------------------------------------------------
+struct vtkSMPForRecorder::vtkInternals
+{
+  const std::type_info& FunctorType;
+  std::string Label;
+  std::string Backend;
+  vtkIdType RangeSize;
+  vtkIdType Grain;
+  double StartTime;
+
+  std::mutex Mutex;
+  vtkIdType NumberOfChunks = 0;
+  std::vector<std::pair<std::thread::id, double>> BusyTimes;
+
+  vtkInternals(const std::type_info& functorType)
+    : FunctorType(functorType)
+  {
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkSMPForRecorder::vtkSMPForRecorder(
+  const std::type_info& functorType, vtkIdType first, vtkIdType last, vtkIdType grain)
+  : Internals(new vtkInternals(functorType))
+{
+  this->Internals->Label = vtkSMPInstrumentationLabel;
+  this->Internals->Backend = vtkSMPToolsAPI::GetInstance().GetBackend();
+  this->Internals->RangeSize = last - first;
+  this->Internals->Grain = grain;
+  this->Internals->StartTime = GetInstrumentationTime();
+}
+
+//------------------------------------------------------------------------------
+vtkSMPForRecorder::~vtkSMPForRecorder()
+{
+  vtkSMPForStatistics statistics;
+  statistics.WallTime = GetInstrumentationTime() - this->Internals->StartTime;
+  statistics.Label = this->Internals->Label.empty() ? GetFunctorName(this->Internals->FunctorType)
+                                                    : this->Internals->Label;
+  statistics.Backend = this->Internals->Backend;
+  statistics.RangeSize = this->Internals->RangeSize;
+  statistics.Grain = this->Internals->Grain;
+  statistics.NumberOfChunks = this->Internals->NumberOfChunks;
+
+  double totalTime = 0.0;
+  double maxTime = 0.0;
+  for (const auto& busyTime : this->Internals->BusyTimes)
+  {
+    statistics.ThreadBusyTimes.push_back(busyTime.second);
+    totalTime += busyTime.second;
+    maxTime = std::max(maxTime, busyTime.second);
+  }
+  if (totalTime > 0.0)
+  {
+    statistics.ImbalanceRatio = maxTime * statistics.ThreadBusyTimes.size() / totalTime;
+  }
+
+  vtkSMPToolsAPI::GetInstance().AddInstrumentationStatistics(std::move(statistics));
+}
+
+//------------------------------------------------------------------------------
+double vtkSMPForRecorder::StartChunk()
+{
+  return GetInstrumentationTime();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPForRecorder::EndChunk(double startTime)
+{
+  const double busyTime = GetInstrumentationTime() - startTime;
+  const std::thread::id threadId = std::this_thread::get_id();
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  ++this->Internals->NumberOfChunks;
+  for (auto& threadBusyTime : this->Internals->BusyTimes)
+  {
+    if (threadBusyTime.first == threadId)
+    {
+      threadBusyTime.second += busyTime;
+      return;
+    }
+  }
+  this->Internals->BusyTimes.emplace_back(threadId, busyTime);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetInstrumentationEnabled(bool enabled)
+{
+  this->InstrumentationEnabled = enabled;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::GetInstrumentationEnabled()
+{
+  return this->InstrumentationEnabled;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetInstrumentationLabel(const char* label)
+{
+  vtkSMPInstrumentationLabel = label ? label : "";
+}
+
+//------------------------------------------------------------------------------
+const char* vtkSMPToolsAPI::GetInstrumentationLabel()
+{
+  return vtkSMPInstrumentationLabel.c_str();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::AddInstrumentationStatistics(vtkSMPForStatistics&& statistics)
+{
+  vtkSMPInstrumentationStorage& storage = GetInstrumentationStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  storage.Statistics.push_back(std::move(statistics));
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::ClearInstrumentation()
+{
+  vtkSMPInstrumentationStorage& storage = GetInstrumentationStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  storage.Statistics.clear();
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkSMPForStatistics> vtkSMPToolsAPI::GetInstrumentationStatistics()
+{
+  vtkSMPInstrumentationStorage& storage = GetInstrumentationStorage();
+  std::lock_guard<std::mutex> lock(storage.Mutex);
+  return storage.Statistics;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkSMPToolsAPI::GetInstrumentationReport()
+{
+  const std::vector<vtkSMPForStatistics> allStatistics = this->GetInstrumentationStatistics();
+  std::ostringstream os;
+  os.precision(9);
+  os << "{\"loops\":[";
+  for (std::size_t i = 0; i < allStatistics.size(); ++i)
+  {
+    const vtkSMPForStatistics& statistics = allStatistics[i];
+    os << (i == 0 ? "\n" : ",\n") << "{\"label\":";
+    WriteJSONString(os, statistics.Label);
+    os << ",\"backend\":";
+    WriteJSONString(os, statistics.Backend);
+    os << ",\"range_size\":" << statistics.RangeSize << ",\"grain\":" << statistics.Grain
+       << ",\"chunks\":" << statistics.NumberOfChunks
+       << ",\"threads\":" << statistics.ThreadBusyTimes.size()
+       << ",\"wall_time\":" << statistics.WallTime << ",\"thread_busy_times\":[";
+    for (std::size_t j = 0; j < statistics.ThreadBusyTimes.size(); ++j)
+    {
+      os << (j == 0 ? "" : ",") << statistics.ThreadBusyTimes[j];
+    }
+    os << "],\"imbalance_ratio\":" << statistics.ImbalanceRatio << "}";
+  }
+  os << "\n]}\n";
+  return os.str();
+}
+
 //------------------------------------------------------------------------------
 // Must NOT be initialized. Default initialization to zero is necessary.
 unsigned int vtkSMPToolsAPIInitializeCount;
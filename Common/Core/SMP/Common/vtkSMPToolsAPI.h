@@ -9,7 +9,11 @@
 #include "vtkObject.h"
 #include "vtkSMP.h"
 
-#include <memory>
+#include <atomic>   // For std::atomic
+#include <memory>   // For std::unique_ptr
+#include <string>   // For std::string
+#include <typeinfo> // For typeid
+#include <vector>   // For std::vector
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #if VTK_SMP_ENABLE_SEQUENTIAL
@@ -35,6 +39,73 @@ VTK_ABI_NAMESPACE_BEGIN
 
 using vtkSMPToolsDefaultImpl = vtkSMPToolsImpl<DefaultBackend>;
 
+//--------------------------------------------------------------------------------
+// Statistics of one vtkSMPTools::For invocation, recorded when the SMP
+// instrumentation is enabled. Times are in seconds.
+struct VTKCOMMONCORE_EXPORT vtkSMPForStatistics
+{
+  std::string Label;                   // call-site label, or the functor type
+  std::string Backend;                 // backend that executed the loop
+  vtkIdType RangeSize = 0;             // last - first
+  vtkIdType Grain = 0;                 // requested grain (0: chosen by the backend)
+  vtkIdType NumberOfChunks = 0;        // number of calls to the functor
+  double WallTime = 0.0;               // duration of the whole For
+  std::vector<double> ThreadBusyTimes; // time spent in the functor, per thread
+  double ImbalanceRatio = 1.0;         // maximum over mean thread busy time
+};
+
+//--------------------------------------------------------------------------------
+// Collects the statistics of one vtkSMPTools::For invocation and stores them
+// in vtkSMPToolsAPI when destroyed. Chunks may be recorded concurrently.
+class VTKCOMMONCORE_EXPORT vtkSMPForRecorder
+{
+public:
+  vtkSMPForRecorder(
+    const std::type_info& functorType, vtkIdType first, vtkIdType last, vtkIdType grain);
+  ~vtkSMPForRecorder();
+
+  double StartChunk();
+  void EndChunk(double startTime);
+
+  vtkSMPForRecorder(vtkSMPForRecorder const&) = delete;
+  void operator=(vtkSMPForRecorder const&) = delete;
+
+private:
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+//--------------------------------------------------------------------------------
+// Wraps the functor given to the backends so that, when a recorder is given,
+// the time spent in each chunk is recorded. Without recorder it only adds a
+// test per chunk.
+template <typename FunctorInternal>
+class vtkSMPInstrumentedFunctor
+{
+public:
+  vtkSMPInstrumentedFunctor(FunctorInternal& fi, vtkSMPForRecorder* recorder)
+    : FI(fi)
+    , Recorder(recorder)
+  {
+  }
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    if (!this->Recorder)
+    {
+      this->FI.Execute(first, last);
+      return;
+    }
+    const double startTime = this->Recorder->StartChunk();
+    this->FI.Execute(first, last);
+    this->Recorder->EndChunk(startTime);
+  }
+
+private:
+  FunctorInternal& FI;
+  vtkSMPForRecorder* Recorder;
+};
+
 class VTKCOMMONCORE_EXPORT vtkSMPToolsAPI
 {
 public:
@@ -96,23 +167,51 @@ public:
   template <typename FunctorInternal>
   void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
   {
+    std::unique_ptr<vtkSMPForRecorder> recorder;
+    if (this->InstrumentationEnabled.load(std::memory_order_relaxed))
+    {
+      recorder.reset(new vtkSMPForRecorder(typeid(FunctorInternal), first, last, grain));
+    }
+    vtkSMPInstrumentedFunctor<FunctorInternal> ifi(fi, recorder.get());
+
     switch (this->ActivatedBackend)
     {
       case BackendType::Sequential:
-        this->SequentialBackend->For(first, last, grain, fi);
+        this->SequentialBackend->For(first, last, grain, ifi);
         break;
       case BackendType::STDThread:
-        this->STDThreadBackend->For(first, last, grain, fi);
+        this->STDThreadBackend->For(first, last, grain, ifi);
         break;
       case BackendType::TBB:
-        this->TBBBackend->For(first, last, grain, fi);
+        this->TBBBackend->For(first, last, grain, ifi);
         break;
       case BackendType::OpenMP:
-        this->OpenMPBackend->For(first, last, grain, fi);
+        this->OpenMPBackend->For(first, last, grain, ifi);
         break;
     }
   }
 
+  //--------------------------------------------------------------------------------
+  void SetInstrumentationEnabled(bool enabled);
+
+  //--------------------------------------------------------------------------------
+  bool GetInstrumentationEnabled();
+
+  //--------------------------------------------------------------------------------
+  void SetInstrumentationLabel(const char* label);
+
+  //--------------------------------------------------------------------------------
+  const char* GetInstrumentationLabel();
+
+  //--------------------------------------------------------------------------------
+  void ClearInstrumentation();
+
+  //--------------------------------------------------------------------------------
+  std::vector<vtkSMPForStatistics> GetInstrumentationStatistics();
+
+  //--------------------------------------------------------------------------------
+  std::string GetInstrumentationReport();
+
   //--------------------------------------------------------------------------------
   template <typename InputIt, typename OutputIt, typename Functor>
   void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor& transform)
@@ -260,6 +359,17 @@ private:
    */
   int DesiredNumberOfThread = 0;
 
+  /**
+   * Record the statistics of each For invocation
+   */
+  std::atomic<bool> InstrumentationEnabled{ false };
+
+  /**
+   * Store the statistics of a For invocation (used by vtkSMPForRecorder)
+   */
+  friend class vtkSMPForRecorder;
+  void AddInstrumentationStatistics(vtkSMPForStatistics&& statistics);
+
   /**
    * Sequential backend
    */
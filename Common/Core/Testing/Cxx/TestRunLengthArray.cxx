@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkRunLengthArray.h"
+
+#include "vtkDataArrayRange.h"
+#include "vtkShortArray.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+int TestRunLengthArray(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // 12 rows of 10 voxels with a background of -1, and the same values in a dense array
+  const int rowLength = 10;
+  const int numberOfRows = 12;
+  std::vector<short> dense(rowLength * numberOfRows, -1);
+  vtkNew<vtkRunLengthArray<short>> runs;
+  runs->ConstructBackend(rowLength, numberOfRows, static_cast<short>(-1));
+  runs->SetNumberOfComponents(1);
+  runs->SetNumberOfTuples(rowLength * numberOfRows);
+  auto backend = runs->GetBackend();
+
+  struct Run
+  {
+    int Row, Start, End;
+    short Value;
+  };
+  const Run inserted[] = { { 1, 0, 3, 5 }, { 1, 4, 6, 5 }, { 1, 8, 20, 2 }, { 4, 2, 2, 7 },
+    { 4, 3, 5, -1 }, { 4, 6, 9, 3 }, { 11, -3, 4, 1 } };
+  for (const Run& run : inserted)
+  {
+    if (!backend->InsertNextRun(run.Row, run.Start, run.End, run.Value))
+    {
+      std::cout << "Insertion of a run failed." << std::endl;
+      res = EXIT_FAILURE;
+    }
+    for (int x = std::max(run.Start, 0); x <= std::min(run.End, rowLength - 1); ++x)
+    {
+      dense[run.Row * rowLength + x] = run.Value;
+    }
+  }
+
+  // runs out of order are rejected
+  if (backend->InsertNextRun(4, 0, 1, 2) || backend->InsertNextRun(11, 3, 5, 2) ||
+    backend->InsertNextRun(numberOfRows, 0, 1, 2))
+  {
+    std::cout << "A run out of order was inserted." << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // adjacent runs of the same value are merged, and the background is skipped
+  if (backend->GetNumberOfRuns() != 5)
+  {
+    std::cout << "Wrong number of runs: " << backend->GetNumberOfRuns() << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  auto range = vtk::DataArrayValueRange<1>(runs);
+  for (vtkIdType idx = 0; idx < rowLength * numberOfRows; ++idx)
+  {
+    if (runs->GetValue(idx) != dense[idx] || range[idx] != dense[idx])
+    {
+      std::cout << "Wrong value at " << idx << ": " << runs->GetValue(idx) << " instead of "
+                << dense[idx] << std::endl;
+      res = EXIT_FAILURE;
+    }
+  }
+
+  // decoding part of each row
+  short buffer[rowLength];
+  for (int row = 0; row < numberOfRows; ++row)
+  {
+    backend->DecodeRow(row, 2, 8, buffer);
+    for (int x = 2; x <= 8; ++x)
+    {
+      if (buffer[x - 2] != dense[row * rowLength + x])
+      {
+        std::cout << "Wrong decoded value in row " << row << " at " << x << std::endl;
+        res = EXIT_FAILURE;
+      }
+    }
+  }
+
+  const int* starts;
+  const int* ends;
+  const short* values;
+  if (backend->GetRowRuns(1, starts, ends, values) != 2 || starts[0] != 0 || ends[0] != 6 ||
+    values[0] != 5 || starts[1] != 8 || ends[1] != 9 || values[1] != 2 ||
+    backend->GetRowRuns(2, starts, ends, values) != 0)
+  {
+    std::cout << "Wrong runs in the rows." << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // copies to regular arrays give the dense values
+  vtkNew<vtkShortArray> copy;
+  copy->DeepCopy(runs);
+  for (vtkIdType idx = 0; idx < rowLength * numberOfRows; ++idx)
+  {
+    if (copy->GetValue(idx) != dense[idx])
+    {
+      std::cout << "Wrong copied value at " << idx << std::endl;
+      res = EXIT_FAILURE;
+    }
+  }
+
+  double valueRange[2];
+  runs->GetRange(valueRange);
+  if (valueRange[0] != -1.0 || valueRange[1] != 7.0)
+  {
+    std::cout << "Wrong range: " << valueRange[0] << " " << valueRange[1] << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  return res;
+}
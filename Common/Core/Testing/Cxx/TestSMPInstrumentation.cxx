@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the statistics recorded by the instrumentation of vtkSMPTools::For
+// with the default backend and the Sequential backend.
+
+#include "vtkLogger.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct SumSquareRoots
+{
+  vtkSMPThreadLocal<double> LocalSum;
+  double Sum = 0.0;
+
+  void Initialize() { this->LocalSum.Local() = 0.0; }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double& sum = this->LocalSum.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      sum += std::sqrt(static_cast<double>(i));
+    }
+  }
+
+  void Reduce()
+  {
+    for (double sum : this->LocalSum)
+    {
+      this->Sum += sum;
+    }
+  }
+};
+
+bool CheckStatistics(const vtkSMPTools::ForStatistics& statistics, const char* backend,
+  vtkIdType rangeSize, const std::string& label)
+{
+  if (statistics.Backend != backend || statistics.RangeSize != rangeSize)
+  {
+    vtkLog(ERROR, << backend << ": unexpected backend " << statistics.Backend << " or range size "
+                  << statistics.RangeSize);
+    return false;
+  }
+  if (statistics.Label.find(label) == std::string::npos)
+  {
+    vtkLog(ERROR, << backend << ": label \"" << statistics.Label << "\" does not contain \""
+                  << label << "\"");
+    return false;
+  }
+  if (statistics.NumberOfChunks < 1 || statistics.ThreadBusyTimes.empty() ||
+    statistics.ThreadBusyTimes.size() > static_cast<std::size_t>(statistics.NumberOfChunks))
+  {
+    vtkLog(ERROR, << backend << ": " << statistics.NumberOfChunks << " chunks executed by "
+                  << statistics.ThreadBusyTimes.size() << " threads");
+    return false;
+  }
+  double busyTime = 0.0;
+  for (double time : statistics.ThreadBusyTimes)
+  {
+    busyTime += time;
+  }
+  if (busyTime <= 0.0 || statistics.WallTime <= 0.0 || statistics.ImbalanceRatio < 1.0 ||
+    statistics.ImbalanceRatio > statistics.ThreadBusyTimes.size() + 1e-6)
+  {
+    vtkLog(ERROR, << backend << ": unexpected times, busy " << busyTime << ", wall "
+                  << statistics.WallTime << ", imbalance " << statistics.ImbalanceRatio);
+    return false;
+  }
+  return true;
+}
+
+bool TestBackend(const char* backend)
+{
+  vtkSMPTools::SetBackend(backend);
+  vtkSMPTools::ClearInstrumentation();
+  const vtkIdType rangeSize = 1000000;
+
+  // Nothing is recorded when the instrumentation is disabled.
+  SumSquareRoots functor;
+  vtkSMPTools::For(0, rangeSize, functor);
+  if (!vtkSMPTools::GetInstrumentationStatistics().empty())
+  {
+    vtkLog(ERROR, << backend << ": statistics recorded while disabled");
+    return false;
+  }
+
+  vtkSMPTools::SetInstrumentationEnabled(true);
+
+  SumSquareRoots unlabeled;
+  vtkSMPTools::For(0, rangeSize, unlabeled);
+
+  vtkSMPTools::SetInstrumentationLabel("TestSMPInstrumentation lambda");
+  std::vector<double> values(rangeSize);
+  vtkSMPTools::For(0, rangeSize, 1000, [&values](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      values[i] = std::sqrt(static_cast<double>(i));
+    }
+  });
+  vtkSMPTools::SetInstrumentationLabel(nullptr);
+
+  vtkSMPTools::SetInstrumentationEnabled(false);
+
+  if (std::abs(unlabeled.Sum - functor.Sum) > 1e-6 * functor.Sum)
+  {
+    vtkLog(ERROR, << backend << ": wrong result " << unlabeled.Sum << " != " << functor.Sum);
+    return false;
+  }
+
+  const std::vector<vtkSMPTools::ForStatistics> statistics =
+    vtkSMPTools::GetInstrumentationStatistics();
+  if (statistics.size() != 2)
+  {
+    vtkLog(ERROR, << backend << ": expected 2 loops, got " << statistics.size());
+    return false;
+  }
+  if (!CheckStatistics(statistics[0], backend, rangeSize, "SumSquareRoots") ||
+    !CheckStatistics(statistics[1], backend, rangeSize, "TestSMPInstrumentation lambda"))
+  {
+    return false;
+  }
+  if (statistics[1].Grain != 1000 || statistics[1].NumberOfChunks < 1)
+  {
+    vtkLog(ERROR, << backend << ": unexpected grain " << statistics[1].Grain);
+    return false;
+  }
+
+  const std::string report = vtkSMPTools::GetInstrumentationReport();
+  if (report.find("\"loops\":[") == std::string::npos ||
+    report.find("\"label\":\"TestSMPInstrumentation lambda\"") == std::string::npos ||
+    report.find("\"imbalance_ratio\":") == std::string::npos)
+  {
+    vtkLog(ERROR, << backend << ": unexpected report " << report);
+    return false;
+  }
+
+  vtkSMPTools::ClearInstrumentation();
+  return true;
+}
+}
+
+int TestSMPInstrumentation(int, char*[])
+{
+  const std::string defaultBackend = vtkSMPTools::GetBackend();
+  bool success = TestBackend(defaultBackend.c_str());
+  if (defaultBackend != "Sequential" && vtkSMPTools::SetBackend("Sequential"))
+  {
+    success &= TestBackend("Sequential");
+    vtkSMPTools::SetBackend(defaultBackend.c_str());
+  }
+  return success ? 0 : 1;
+}
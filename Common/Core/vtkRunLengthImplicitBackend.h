@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkRunLengthImplicitBackend_h
+#define vtkRunLengthImplicitBackend_h
+
+/**
+ * \class vtkRunLengthImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework that stores the values of an image, one value
+ * per voxel, as runs of constant value along the rows of the image. The voxels that are not
+ * covered by a run have the background value. This is meant for label maps and masks where most
+ * of the voxels are background, where the memory used is proportional to the number of runs
+ * rather than to the number of voxels.
+ *
+ * The rows are indexed as in vtkImageData, so that the value at index `x + rowLength * row` is
+ * the value of voxel `x` of the row. The runs are inserted row by row, in increasing order along
+ * each row, in the same way as the extents of vtkImageStencilData. Adjacent runs with the same
+ * value are merged, and runs of the background value are skipped.
+ *
+ * Filters that know about this backend can visit the runs of each row with `GetRowRuns` instead
+ * of visiting every voxel, other filters see an ordinary single-component array.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * vtkNew<vtkRunLengthArray<short>> labels; // dimensions 100x80x60
+ * labels->ConstructBackend(100, 80 * 60, 0);
+ * labels->GetBackend()->InsertNextRun(12, 30, 59, 3); // voxels 30 to 59 of row 12 have label 3
+ * labels->SetNumberOfComponents(1);
+ * labels->SetNumberOfTuples(100 * 80 * 60);
+ * CHECK(labels->GetValue(12 * 100 + 40) == 3);
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkRunLengthArray, vtkImageStencilData
+ */
+
+#include "vtkCommonCoreModule.h"
+
+#include "vtkType.h"
+
+#include <memory>
+
+VTK_ABI_NAMESPACE_BEGIN
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkRunLengthImplicitBackend final
+{
+public:
+  /**
+   * Constructor
+   * @param rowLength number of voxels in each row
+   * @param numberOfRows number of rows, the product of the other dimensions of the image
+   * @param background value of the voxels that are not covered by a run
+   */
+  vtkRunLengthImplicitBackend(int rowLength, vtkIdType numberOfRows, ValueType background);
+  ~vtkRunLengthImplicitBackend();
+
+  /**
+   * Indexing operation for the run-length array respecting the backend expectations of
+   * `vtkImplicitArray`
+   */
+  ValueType operator()(vtkIdType idx) const;
+
+  /**
+   * Returns the smallest integer memory size in KiB needed to store the runs.
+   */
+  unsigned long getMemorySize() const;
+
+  /**
+   * Set the voxels from start to end (inclusive) of the given row to the value. The rows must be
+   * inserted in increasing order, and the runs of a row in increasing order without overlap.
+   * Returns false if the run is out of order, the run is then ignored.
+   */
+  bool InsertNextRun(vtkIdType row, int start, int end, ValueType value);
+
+  /**
+   * Get the runs of a row. The start and end of each run, and its value, are returned as
+   * pointers into the internal storage, valid until the next insertion.
+   * Returns the number of runs in the row.
+   */
+  int GetRowRuns(
+    vtkIdType row, const int*& starts, const int*& ends, const ValueType*& values) const;
+
+  /**
+   * Write the values of the voxels from start to end (inclusive) of the given row to the
+   * buffer, which must have room for end - start + 1 values.
+   */
+  void DecodeRow(vtkIdType row, int start, int end, ValueType* buffer) const;
+
+  ///@{
+  /**
+   * The dimensions and the background value given at construction.
+   */
+  int GetRowLength() const;
+  vtkIdType GetNumberOfRows() const;
+  ValueType GetBackgroundValue() const;
+  ///@}
+
+  /**
+   * The total number of runs.
+   */
+  vtkIdType GetNumberOfRuns() const;
+
+private:
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkRunLengthImplicitBackend_h
+
+#if defined(VTK_RUN_LENGTH_BACKEND_INSTANTIATING)
+
+#define VTK_INSTANTIATE_RUN_LENGTH_BACKEND(ValueType)                                              \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkRunLengthImplicitBackend<ValueType>;                      \
+  VTK_ABI_NAMESPACE_END
+
+#elif defined(VTK_USE_EXTERN_TEMPLATE)
+
+#ifndef VTK_RUN_LENGTH_BACKEND_TEMPLATE_EXTERN
+#define VTK_RUN_LENGTH_BACKEND_TEMPLATE_EXTERN
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4910) // extern and dllexport incompatible
+#endif
+VTK_ABI_NAMESPACE_BEGIN
+vtkExternTemplateMacro(extern template class VTKCOMMONCORE_EXPORT vtkRunLengthImplicitBackend);
+VTK_ABI_NAMESPACE_END
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#endif // VTK_RUN_LENGTH_BACKEND_TEMPLATE_EXTERN
+
+#endif
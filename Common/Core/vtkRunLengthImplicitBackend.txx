@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkRunLengthImplicitBackend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct vtkRunLengthImplicitBackend<ValueType>::Internals
+{
+  Internals(int rowLength, vtkIdType numberOfRows, ValueType background)
+    : RowLength(rowLength)
+    , NumberOfRows(numberOfRows)
+    , Background(background)
+    , LastRow(-1)
+    , RowOffsets(numberOfRows, 0)
+  {
+  }
+
+  // The range of runs of a row, the rows after the last inserted row are empty.
+  void GetRange(vtkIdType row, vtkIdType& begin, vtkIdType& end) const
+  {
+    if (row > this->LastRow)
+    {
+      begin = end = 0;
+      return;
+    }
+    begin = this->RowOffsets[row];
+    end = (row < this->LastRow ? this->RowOffsets[row + 1]
+                               : static_cast<vtkIdType>(this->Starts.size()));
+  }
+
+  int RowLength;
+  vtkIdType NumberOfRows;
+  ValueType Background;
+  vtkIdType LastRow;
+  // The index of the first run of each row, up to the last inserted row.
+  std::vector<vtkIdType> RowOffsets;
+  std::vector<int> Starts;
+  std::vector<int> Ends;
+  std::vector<ValueType> Values;
+};
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkRunLengthImplicitBackend<ValueType>::vtkRunLengthImplicitBackend(
+  int rowLength, vtkIdType numberOfRows, ValueType background)
+  : Internal(new Internals(rowLength, numberOfRows, background))
+{
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkRunLengthImplicitBackend<ValueType>::~vtkRunLengthImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkRunLengthImplicitBackend<ValueType>::operator()(vtkIdType idx) const
+{
+  const Internals& internal = *this->Internal;
+  const vtkIdType row = idx / internal.RowLength;
+  const int x = static_cast<int>(idx - row * internal.RowLength);
+  vtkIdType begin, end;
+  internal.GetRange(row, begin, end);
+
+  // the last run that starts at or before x
+  const auto first = internal.Starts.begin();
+  const vtkIdType run = std::upper_bound(first + begin, first + end, x) - first - 1;
+  if (run >= begin && internal.Ends[run] >= x)
+  {
+    return internal.Values[run];
+  }
+  return internal.Background;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkRunLengthImplicitBackend<ValueType>::getMemorySize() const
+{
+  const Internals& internal = *this->Internal;
+  const double bytes = static_cast<double>(sizeof(vtkIdType)) * internal.RowOffsets.size() +
+    (2.0 * sizeof(int) + sizeof(ValueType)) * internal.Starts.size();
+  return static_cast<unsigned long>(std::ceil(bytes / 1024.0));
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+bool vtkRunLengthImplicitBackend<ValueType>::InsertNextRun(
+  vtkIdType row, int start, int end, ValueType value)
+{
+  Internals& internal = *this->Internal;
+  start = std::max(start, 0);
+  end = std::min(end, internal.RowLength - 1);
+  if (row < 0 || row >= internal.NumberOfRows || row < internal.LastRow ||
+    (row == internal.LastRow && !internal.Ends.empty() && start <= internal.Ends.back()))
+  {
+    return false;
+  }
+  if (start > end || value == internal.Background)
+  {
+    return true;
+  }
+
+  const vtkIdType numberOfRuns = static_cast<vtkIdType>(internal.Starts.size());
+  if (row > internal.LastRow)
+  {
+    std::fill(internal.RowOffsets.begin() + (internal.LastRow + 1),
+      internal.RowOffsets.begin() + (row + 1), numberOfRuns);
+    internal.LastRow = row;
+  }
+  else if (internal.Ends.back() + 1 == start && internal.Values.back() == value)
+  {
+    internal.Ends.back() = end;
+    return true;
+  }
+
+  internal.Starts.push_back(start);
+  internal.Ends.push_back(end);
+  internal.Values.push_back(value);
+  return true;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+int vtkRunLengthImplicitBackend<ValueType>::GetRowRuns(
+  vtkIdType row, const int*& starts, const int*& ends, const ValueType*& values) const
+{
+  const Internals& internal = *this->Internal;
+  vtkIdType begin, end;
+  internal.GetRange(row, begin, end);
+  starts = internal.Starts.data() + begin;
+  ends = internal.Ends.data() + begin;
+  values = internal.Values.data() + begin;
+  return static_cast<int>(end - begin);
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+void vtkRunLengthImplicitBackend<ValueType>::DecodeRow(
+  vtkIdType row, int start, int end, ValueType* buffer) const
+{
+  const int* starts;
+  const int* ends;
+  const ValueType* values;
+  const int n = this->GetRowRuns(row, starts, ends, values);
+  std::fill(buffer, buffer + (end - start + 1), this->Internal->Background);
+  for (int i = 0; i < n; ++i)
+  {
+    const int r1 = std::max(starts[i], start);
+    const int r2 = std::min(ends[i], end);
+    if (r1 <= r2)
+    {
+      std::fill(buffer + (r1 - start), buffer + (r2 - start + 1), values[i]);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+int vtkRunLengthImplicitBackend<ValueType>::GetRowLength() const
+{
+  return this->Internal->RowLength;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkIdType vtkRunLengthImplicitBackend<ValueType>::GetNumberOfRows() const
+{
+  return this->Internal->NumberOfRows;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkRunLengthImplicitBackend<ValueType>::GetBackgroundValue() const
+{
+  return this->Internal->Background;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkIdType vtkRunLengthImplicitBackend<ValueType>::GetNumberOfRuns() const
+{
+  return static_cast<vtkIdType>(this->Internal->Starts.size());
+}
+VTK_ABI_NAMESPACE_END
@@ -68,4 +68,53 @@ bool vtkSMPTools::GetSingleThread()
   auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
   return SMPToolsAPI.GetSingleThread();
 }
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetInstrumentationEnabled(bool enabled)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.SetInstrumentationEnabled(enabled);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetInstrumentationEnabled()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetInstrumentationEnabled();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetInstrumentationLabel(const char* label)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.SetInstrumentationLabel(label);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkSMPTools::GetInstrumentationLabel()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetInstrumentationLabel();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::ClearInstrumentation()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.ClearInstrumentation();
+}
+
+//------------------------------------------------------------------------------
+std::string vtkSMPTools::GetInstrumentationReport()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetInstrumentationReport();
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkSMPTools::ForStatistics> vtkSMPTools::GetInstrumentationStatistics()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetInstrumentationStatistics();
+}
 VTK_ABI_NAMESPACE_END
@@ -14,12 +14,14 @@
 #include "vtkNew.h"
 #include "vtkPolyData.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSetGet.h"
 #include "vtkSmartPointer.h"
 #include "vtkTypeInt32Array.h"
 #include "vtkTypeInt64Array.h"
 
 #include <algorithm>
+#include <atomic>
 #include <initializer_list>
 #include <stdexcept>
 #include <type_traits>
@@ -62,6 +64,16 @@ vtkSmartPointer<vtkCellArray> NewCellArray(bool use64BitStorage)
   return cellArray;
 }
 
+struct GetCellPointId
+{
+  template <typename CellStateT>
+  vtkIdType operator()(const CellStateT& state, vtkIdType cellId, vtkIdType i) const
+  {
+    const vtkIdType offset = state.GetBeginOffset(cellId);
+    return static_cast<vtkIdType>(state.GetConnectivity()->GetValue(offset + i));
+  }
+};
+
 void FillCellArray(vtkCellArray* cellArray)
 {
   cellArray->InsertNextCell({ 0, 1, 2, 3, 4 });
@@ -934,6 +946,139 @@ void TestShallowCopy(vtkSmartPointer<vtkCellArray> cellArray)
   TEST_ASSERT(cellArray->GetConnectivityArray() == other->GetConnectivityArray());
 }
 
+void TestCompressedStorage(vtkSmartPointer<vtkCellArray> cellArray)
+{
+  vtkLogScopeFunction(INFO);
+
+  // Heterogeneous cells keep their offsets.
+  FillCellArray(cellArray);
+  const bool is64Bit = cellArray->IsStorage64Bit();
+  TEST_ASSERT(cellArray->ConvertToCompressedStorage());
+  TEST_ASSERT(cellArray->IsStorageCompressed());
+  TEST_ASSERT(!cellArray->IsStorageShareable());
+  TEST_ASSERT(cellArray->GetNumberOfCells() == 3);
+  TEST_ASSERT(cellArray->GetNumberOfOffsets() == 4);
+  TEST_ASSERT(cellArray->GetNumberOfConnectivityIds() == 14);
+  TEST_ASSERT(cellArray->GetOffset(2) == 8);
+  TEST_ASSERT(cellArray->GetCellSize(1) == 3);
+  TEST_ASSERT(cellArray->IsHomogeneous() == -1);
+  TEST_ASSERT(cellArray->GetMaxCellSize() == 6);
+  ValidateCellArray(cellArray);
+
+  vtkNew<vtkCellArray> shallowCopy;
+  shallowCopy->ShallowCopy(cellArray);
+  vtkNew<vtkCellArray> deepCopy;
+  deepCopy->DeepCopy(cellArray);
+  TEST_ASSERT(shallowCopy->IsStorageCompressed() && deepCopy->IsStorageCompressed());
+  ValidateCellArray(shallowCopy);
+  ValidateCellArray(deepCopy);
+
+  // Modifying the cells expands the storage, to the smallest type.
+  cellArray->InsertNextCell({ 1, 2 });
+  TEST_ASSERT(!cellArray->IsStorageCompressed());
+  TEST_ASSERT(!cellArray->IsStorage64Bit());
+  TEST_ASSERT(cellArray->GetNumberOfCells() == 4);
+  TEST_ASSERT(cellArray->IsValid());
+  TEST_ASSERT(shallowCopy->IsStorageCompressed());
+  ValidateCellArray(shallowCopy);
+
+  // Fixed-size cells, with point ids spread over all the widths of the
+  // compressed blocks.
+  vtkNew<vtkCellArray> tets;
+  if (is64Bit)
+  {
+    tets->Use64BitStorage();
+  }
+  else
+  {
+    tets->Use32BitStorage();
+  }
+  const vtkIdType numTets = 1000;
+  auto pointId = [&](vtkIdType cellId, vtkIdType i) -> vtkIdType {
+    const vtkIdType base = 3 * cellId + i;
+    if (cellId < 250)
+    {
+      return base;
+    }
+    if (cellId < 500)
+    {
+      return base + (i == 3 ? 20000 * (cellId % 3) : 0);
+    }
+    if (cellId < 750 || !is64Bit || sizeof(vtkIdType) < 8)
+    {
+      return base + (i == 2 ? 100000000 : 0);
+    }
+    return base + (i == 1 ? (static_cast<vtkIdType>(1) << 40) : 0);
+  };
+  for (vtkIdType cellId = 0; cellId < numTets; ++cellId)
+  {
+    const vtkIdType pts[4] = { pointId(cellId, 0), pointId(cellId, 1), pointId(cellId, 2),
+      pointId(cellId, 3) };
+    tets->InsertNextCell(4, pts);
+  }
+  const unsigned long explicitSize = tets->GetActualMemorySize();
+  TEST_ASSERT(tets->ConvertToCompressedStorage());
+  TEST_ASSERT(tets->IsHomogeneous() == 4);
+  TEST_ASSERT(tets->GetMaxCellSize() == 4);
+  TEST_ASSERT(tets->GetActualMemorySize() < explicitSize);
+
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType cellId = 0; cellId < numTets; ++cellId)
+  {
+    tets->GetCellAtId(cellId, ids);
+    TEST_ASSERT(ids->GetNumberOfIds() == 4);
+    for (vtkIdType i = 0; i < 4; ++i)
+    {
+      TEST_ASSERT(ids->GetId(i) == pointId(cellId, i));
+    }
+  }
+
+  // Visit() gets the explicit arrays back.
+  auto* connectivity = tets->GetConnectivityArray();
+  TEST_ASSERT(!tets->IsStorageCompressed());
+  TEST_ASSERT(tets->IsValid());
+  TEST_ASSERT(connectivity->GetNumberOfValues() == 4 * numTets);
+  TEST_ASSERT(static_cast<vtkIdType>(connectivity->GetComponent(4 * 900 + 1, 0)) ==
+    pointId(900, 1));
+  TEST_ASSERT(tets->GetOffset(numTets) == 4 * numTets);
+
+  // Visit() may expand the storage while other threads read the cells.
+  TEST_ASSERT(tets->ConvertToCompressedStorage());
+  TEST_ASSERT(tets->IsStorageCompressed());
+  const vtkCellArray* constTets = tets;
+  std::atomic<bool> valid(true);
+  vtkSMPTools::For(0, numTets, 10, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkNew<vtkIdList> cellIds;
+    for (; cellId < endCellId; ++cellId)
+    {
+      tets->GetCellAtId(cellId, cellIds);
+      for (vtkIdType i = 0; i < 4; ++i)
+      {
+        if (cellIds->GetId(i) != pointId(cellId, i) ||
+          constTets->Visit(GetCellPointId{}, cellId, i) != pointId(cellId, i))
+        {
+          valid = false;
+        }
+      }
+    }
+  });
+  TEST_ASSERT(valid);
+  TEST_ASSERT(!tets->IsStorageCompressed());
+
+  // The compressed storage is kept for the readers until the cells are modified.
+  const unsigned long expandedSize = tets->GetActualMemorySize();
+  tets->ReplaceCellPointAtId(0, 0, pointId(0, 0));
+  TEST_ASSERT(tets->GetActualMemorySize() < expandedSize);
+  TEST_ASSERT(tets->GetCellSize(numTets - 1) == 4);
+
+  // Resetting the cells does not expand them.
+  TEST_ASSERT(tets->ConvertToCompressedStorage());
+  tets->Reset();
+  TEST_ASSERT(!tets->IsStorageCompressed());
+  TEST_ASSERT(tets->GetNumberOfCells() == 0);
+  TEST_ASSERT(tets->IsValid());
+}
+
 void TestAppendImpl(vtkSmartPointer<vtkCellArray> first, vtkSmartPointer<vtkCellArray> second)
 {
   first->InsertNextCell({ 0, 1, 2 });
@@ -1386,6 +1531,7 @@ void RunTests(bool use64BitStorage)
   TestGetMaxCellSize(NewCellArray(use64BitStorage));
   TestDeepCopy(NewCellArray(use64BitStorage));
   TestShallowCopy(NewCellArray(use64BitStorage));
+  TestCompressedStorage(NewCellArray(use64BitStorage));
   TestAppend32(NewCellArray(use64BitStorage));
   TestAppend64(NewCellArray(use64BitStorage));
   TestLegacyFormatImportExportAppend(NewCellArray(use64BitStorage));
@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the stack-like reuse of vtkCellScratch, the in place access to the
+// connectivity of a vtkCellArray, and that repeating cell computations does
+// not allocate memory once the scratch has grown.
+
+#include "vtkCellArray.h"
+#include "vtkCellScratch.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace
+{
+bool TestFrames()
+{
+  vtkCellScratch scratch;
+  double* first;
+  {
+    vtkCellScratch::Frame frame(scratch);
+    first = frame.Allocate<double>(10);
+    first[0] = 1.0;
+    double* second = frame.Allocate<double>(3);
+    if (second < first + 10)
+    {
+      std::cerr << "Overlapping buffers." << std::endl;
+      return false;
+    }
+    if (reinterpret_cast<std::uintptr_t>(second) % alignof(double) != 0)
+    {
+      std::cerr << "Misaligned buffer." << std::endl;
+      return false;
+    }
+
+    // A buffer larger than the block makes the scratch grow, without moving
+    // the buffers already handed out.
+    double* large = frame.Allocate<double>(100000);
+    large[99999] = 2.0;
+    if (first[0] != 1.0 || scratch.GetCapacity() < 100000 * sizeof(double))
+    {
+      std::cerr << "Wrong growth of the scratch." << std::endl;
+      return false;
+    }
+
+    vtkCellScratch::Frame nested(scratch);
+    vtkIdList* ids = nested.GetIdList();
+    vtkIdList* otherIds = nested.GetIdList();
+    if (ids == otherIds || ids->GetNumberOfIds() != 0)
+    {
+      std::cerr << "Wrong id lists." << std::endl;
+      return false;
+    }
+  }
+
+  // Once released, the memory and the objects are reused.
+  const vtkIdType allocations = scratch.GetNumberOfAllocations();
+  {
+    vtkCellScratch::Frame frame(scratch);
+    if (frame.Allocate<double>(10) != first)
+    {
+      std::cerr << "The released memory is not reused." << std::endl;
+      return false;
+    }
+    frame.Allocate<double>(3);
+    frame.Allocate<double>(100000);
+    frame.GetIdList()->InsertNextId(3);
+    if (frame.GetIdList()->GetNumberOfIds() != 0)
+    {
+      std::cerr << "The id lists are not reset." << std::endl;
+      return false;
+    }
+  }
+  if (scratch.GetNumberOfAllocations() != allocations)
+  {
+    std::cerr << "Repeating the allocations allocated memory." << std::endl;
+    return false;
+  }
+
+  scratch.Squeeze();
+  if (scratch.GetCapacity() != 0)
+  {
+    std::cerr << "Squeeze() did not free the memory." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestCellPoints()
+{
+  vtkNew<vtkCellArray> cells;
+  cells->Use64BitStorage();
+  const vtkIdType quad[4] = { 0, 1, 2, 3 };
+  const vtkIdType triangle[3] = { 1, 4, 2 };
+  cells->InsertNextCell(4, quad);
+  cells->InsertNextCell(3, triangle);
+
+  vtkCellScratch::Frame frame;
+  for (int storage = 0; storage < 2; ++storage)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts = frame.GetCellPoints(cells, 1, npts);
+    if (npts != 3 || pts[0] != 1 || pts[1] != 4 || pts[2] != 2)
+    {
+      std::cerr << "Wrong cell points." << std::endl;
+      return false;
+    }
+
+    // The vtkIdType connectivity is read in place.
+    if (cells->IsStorageShareable() && pts != cells->GetConnectivityArray64()->GetPointer(4))
+    {
+      std::cerr << "Wrong in place access to the connectivity." << std::endl;
+      return false;
+    }
+
+    vtkNew<vtkPoints> points;
+    for (int i = 0; i < 5; ++i)
+    {
+      points->InsertNextPoint(i, 2.0 * i, 3.0 * i);
+    }
+    const double* x = frame.GetCoordinates(points, npts, pts);
+    if (x[3] != 4.0 || x[4] != 8.0 || x[5] != 12.0)
+    {
+      std::cerr << "Wrong coordinates." << std::endl;
+      return false;
+    }
+
+    cells->ConvertTo32BitStorage();
+  }
+  return true;
+}
+
+// Repeats the polygon computations that use the scratch.
+void EvaluatePolygon(vtkPolygon* polygon)
+{
+  const vtkIdType npts = polygon->GetNumberOfPoints();
+  double weights[8], closest[3], pcoords[3], dist2, derivs[3], values[8];
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    values[i] = polygon->GetPoints()->GetPoint(i)[0];
+  }
+  const double x[3] = { 0.2, 0.1, 0.0 };
+  int subId;
+  polygon->EvaluatePosition(x, closest, subId, pcoords, dist2, weights);
+  polygon->Derivatives(0, pcoords, values, 1, derivs);
+  polygon->InterpolateFunctions(x, weights);
+}
+
+bool TestCellAllocations()
+{
+  vtkNew<vtkPolygon> polygon;
+  const int npts = 8;
+  polygon->GetPointIds()->SetNumberOfIds(npts);
+  polygon->GetPoints()->SetNumberOfPoints(npts);
+  for (int i = 0; i < npts; ++i)
+  {
+    const double angle = 2.0 * vtkMath::Pi() * i / npts;
+    polygon->GetPointIds()->SetId(i, i);
+    polygon->GetPoints()->SetPoint(i, std::cos(angle), std::sin(angle), 0.0);
+  }
+  polygon->SetUseMVCInterpolation(true);
+
+  vtkCellScratch& scratch = vtkCellScratch::GetLocal();
+  EvaluatePolygon(polygon);
+  const vtkIdType allocations = scratch.GetNumberOfAllocations();
+  for (int i = 0; i < 10; ++i)
+  {
+    EvaluatePolygon(polygon);
+  }
+  if (scratch.GetNumberOfAllocations() != allocations)
+  {
+    std::cerr << "The polygon computations allocated memory." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestThreads()
+{
+  // Each thread writes to its own scratch.
+  std::atomic<int> errors(0);
+  vtkSMPTools::For(0, 1000, 10, [&errors](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkCellScratch::Frame frame;
+      vtkIdType* values = frame.Allocate<vtkIdType>(100);
+      for (vtkIdType j = 0; j < 100; ++j)
+      {
+        values[j] = i + j;
+      }
+      vtkGenericCell* cell = frame.GetGenericCell();
+      cell->SetCellTypeToTriangle();
+      for (vtkIdType j = 0; j < 100; ++j)
+      {
+        if (values[j] != i + j)
+        {
+          ++errors;
+        }
+      }
+    }
+  });
+  if (errors > 0)
+  {
+    std::cerr << "The scratch is shared by several threads." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCellScratch(int, char*[])
+{
+  if (!TestFrames() || !TestCellPoints() || !TestCellAllocations() || !TestThreads())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that the batched evaluation of the implicit functions
+// (FunctionValueBatch() and FunctionValue(vtkDataArray*, vtkDataArray*))
+// gives the same values as the point by point evaluation, for the built-in
+// primitives, boolean trees and transformed functions.
+
+#include "vtkBox.h"
+#include "vtkCylinder.h"
+#include "vtkDoubleArray.h"
+#include "vtkImplicitBoolean.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPerspectiveTransform.h"
+#include "vtkPlane.h"
+#include "vtkQuadric.h"
+#include "vtkSphere.h"
+#include "vtkTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+bool CheckFunction(vtkImplicitFunction* function, const char* name, vtkDoubleArray* points)
+{
+  const vtkIdType numPoints = points->GetNumberOfTuples();
+  std::vector<double> values(numPoints);
+  function->FunctionValueBatch(points->GetPointer(0), values.data(), numPoints);
+  vtkNew<vtkDoubleArray> arrayValues;
+  arrayValues->SetNumberOfTuples(numPoints);
+  function->FunctionValue(points, arrayValues);
+  if (arrayValues->GetNumberOfTuples() != numPoints)
+  {
+    vtkLog(ERROR, << name << ": wrong number of values");
+    return false;
+  }
+
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    const double expected = function->FunctionValue(points->GetTuple3(i));
+    const double tolerance = 1e-12 * std::max(1.0, std::fabs(expected));
+    if (std::fabs(values[i] - expected) > tolerance ||
+      std::fabs(arrayValues->GetValue(i) - expected) > tolerance)
+    {
+      vtkLog(ERROR, << name << ": point " << i << " evaluates to " << values[i] << " and "
+                    << arrayValues->GetValue(i) << " instead of " << expected);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestImplicitFunctionBatch(int, char*[])
+{
+  // Enough points to span several blocks, with a partial last block.
+  const vtkIdType numPoints = 10007;
+  vtkNew<vtkDoubleArray> points;
+  points->SetNumberOfComponents(3);
+  points->SetNumberOfTuples(numPoints);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  for (vtkIdType i = 0; i < 3 * numPoints; ++i)
+  {
+    points->SetValue(i, random->GetNextRangeValue(-2.0, 2.0));
+  }
+  // Points on the faces and edges of the box.
+  points->SetTuple3(0, -1.0, 0.0, 0.0);
+  points->SetTuple3(1, 1.0, 1.0, 1.0);
+  points->SetTuple3(2, 0.0, 0.0, 0.0);
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.1, 0.2, 0.3);
+  plane->SetNormal(1.0, 2.0, -1.0);
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.5, -0.2, 0.1);
+  sphere->SetRadius(0.8);
+  vtkNew<vtkBox> box;
+  box->SetBounds(-1.0, 1.0, -0.5, 1.0, -0.25, 0.75);
+  vtkNew<vtkBox> flatBox;
+  flatBox->SetBounds(-1.0, 1.0, 0.0, 0.0, -0.25, 0.75);
+  vtkNew<vtkCylinder> cylinder;
+  cylinder->SetCenter(0.1, 0.0, -0.1);
+  cylinder->SetAxis(1.0, 1.0, 0.0);
+  cylinder->SetRadius(0.5);
+  vtkNew<vtkQuadric> quadric;
+  quadric->SetCoefficients(1.0, 2.0, 3.0, 0.5, -0.5, 0.25, 1.0, -1.0, 0.5, -2.0);
+
+  bool success = CheckFunction(plane, "plane", points) &&
+    CheckFunction(sphere, "sphere", points) && CheckFunction(box, "box", points) &&
+    CheckFunction(flatBox, "flat box", points) && CheckFunction(cylinder, "cylinder", points) &&
+    CheckFunction(quadric, "quadric", points);
+
+  // Transformed functions, through a linear and a non-linear transform.
+  vtkNew<vtkTransform> transform;
+  transform->RotateZ(30.0);
+  transform->Translate(0.2, 0.0, -0.3);
+  transform->Scale(1.0, 2.0, 0.5);
+  vtkNew<vtkSphere> transformedSphere;
+  transformedSphere->SetRadius(0.7);
+  transformedSphere->SetTransform(transform);
+  success = success && CheckFunction(transformedSphere, "transformed sphere", points);
+
+  vtkNew<vtkPerspectiveTransform> perspective;
+  perspective->Frustum(-1.0, 1.0, -1.0, 1.0, 3.0, 10.0);
+  perspective->Translate(0.0, 0.0, -5.0);
+  vtkNew<vtkPlane> perspectivePlane;
+  perspectivePlane->SetTransform(perspective);
+  success = success && CheckFunction(perspectivePlane, "perspective plane", points);
+
+  // Boolean trees, with all the operations.
+  vtkNew<vtkImplicitBoolean> nested;
+  nested->SetOperationTypeToIntersection();
+  nested->AddFunction(box);
+  nested->AddFunction(transformedSphere);
+  vtkNew<vtkImplicitBoolean> tree;
+  tree->AddFunction(nested);
+  tree->AddFunction(cylinder);
+  tree->AddFunction(plane);
+  const char* operations[] = { "union", "intersection", "difference", "union of magnitudes" };
+  for (int operation = vtkImplicitBoolean::VTK_UNION;
+       operation <= vtkImplicitBoolean::VTK_UNION_OF_MAGNITUDES; ++operation)
+  {
+    tree->SetOperationType(operation);
+    success = success && CheckFunction(tree, operations[operation], points);
+  }
+  tree->SetTransform(transform);
+  success = success && CheckFunction(tree, "transformed tree", points);
+
+  vtkNew<vtkImplicitBoolean> empty;
+  success = success && CheckFunction(empty, "empty boolean", points);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,324 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that the polyhedra bound to a vtkPolyhedronTopology give the same
+// faces, edges, triangulation and geometric queries as the polyhedra that
+// compute them, and that the topology is dropped once the grid is modified.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyhedron.h"
+#include "vtkPolyhedronTopology.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int Resolution = 4;
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (Resolution + 1) * (j + (Resolution + 1) * k);
+}
+
+// A grid of hexahedral polyhedra with non planar faces, and a regular
+// hexahedron.
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Resolution; ++k)
+  {
+    for (int j = 0; j <= Resolution; ++j)
+    {
+      for (int i = 0; i <= Resolution; ++i)
+      {
+        // perturb the points so that the faces are not planar
+        points->InsertNextPoint(i + 0.1 * std::sin(3.0 * j + k), j + 0.1 * std::cos(2.0 * i + k),
+          k + 0.1 * std::sin(i + j));
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate();
+
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        const vtkIdType p[8] = { PointId(i, j, k), PointId(i + 1, j, k), PointId(i + 1, j + 1, k),
+          PointId(i, j + 1, k), PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+          PointId(i + 1, j + 1, k + 1), PointId(i, j + 1, k + 1) };
+        if (i == 1 && j == 1 && k == 1)
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, p);
+          continue;
+        }
+        const vtkIdType faces[] = { 4, p[0], p[3], p[2], p[1], 4, p[4], p[5], p[6], p[7], 4, p[0],
+          p[1], p[5], p[4], 4, p[1], p[2], p[6], p[5], 4, p[2], p[3], p[7], p[6], 4, p[3], p[0],
+          p[4], p[7] };
+        grid->InsertNextCell(VTK_POLYHEDRON, 8, p, 6, faces);
+      }
+    }
+  }
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(points->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    scalars->SetValue(i, x[0] + 0.5 * x[1] + 0.25 * x[2]);
+  }
+  grid->GetPointData()->SetScalars(scalars);
+}
+
+bool SameIds(vtkIdList* a, vtkIdList* b)
+{
+  if (a->GetNumberOfIds() != b->GetNumberOfIds())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfIds(); ++i)
+  {
+    if (a->GetId(i) != b->GetId(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+int CountContour(vtkPolyhedron* polyhedron, vtkPointData* inPd, double value)
+{
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetNumberOfTuples(polyhedron->GetNumberOfPoints());
+  inPd->GetScalars()->GetTuples(polyhedron->GetPointIds(), cellScalars);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkMergePoints> locator;
+  double bounds[6] = { -1.0, Resolution + 1.0, -1.0, Resolution + 1.0, -1.0, Resolution + 1.0 };
+  locator->InitPointInsertion(points, bounds);
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkPointData> outPd;
+  outPd->InterpolateAllocate(inPd);
+  polyhedron->Contour(
+    value, cellScalars, locator, verts, lines, polys, inPd, outPd, nullptr, 0, nullptr);
+  return static_cast<int>(polys->GetNumberOfCells());
+}
+
+bool Compare(vtkPolyhedron* bound, vtkPolyhedron* computed, vtkPointData* pd)
+{
+  if (bound->GetNumberOfFaces() != computed->GetNumberOfFaces() ||
+    bound->GetNumberOfEdges() != computed->GetNumberOfEdges())
+  {
+    std::cerr << "Wrong number of faces or edges." << std::endl;
+    return false;
+  }
+  for (int i = 0; i < bound->GetNumberOfFaces(); ++i)
+  {
+    vtkCell* boundFace = bound->GetFace(i);
+    vtkNew<vtkIdList> boundIds;
+    boundIds->DeepCopy(boundFace->GetPointIds());
+    double boundPoint[3];
+    boundFace->GetPoints()->GetPoint(0, boundPoint);
+    vtkCell* computedFace = computed->GetFace(i);
+    if (!SameIds(boundIds, computedFace->GetPointIds()) ||
+      vtkMath::Distance2BetweenPoints(boundPoint, computedFace->GetPoints()->GetPoint(0)) != 0.0)
+    {
+      std::cerr << "Wrong face " << i << std::endl;
+      return false;
+    }
+  }
+  for (int i = 0; i < bound->GetNumberOfEdges(); ++i)
+  {
+    vtkNew<vtkIdList> boundIds;
+    boundIds->DeepCopy(bound->GetEdge(i)->GetPointIds());
+    if (!SameIds(boundIds, computed->GetEdge(i)->GetPointIds()))
+    {
+      std::cerr << "Wrong edge " << i << std::endl;
+      return false;
+    }
+  }
+
+  vtkNew<vtkIdList> boundTriangles;
+  vtkNew<vtkIdList> computedTriangles;
+  bound->TriangulateFaces(boundTriangles);
+  computed->TriangulateFaces(computedTriangles);
+  if (!SameIds(boundTriangles, computedTriangles))
+  {
+    std::cerr << "Wrong face triangulation." << std::endl;
+    return false;
+  }
+
+  if (bound->IsConvex() != computed->IsConvex())
+  {
+    std::cerr << "Wrong convexity." << std::endl;
+    return false;
+  }
+
+  double center[3] = { 0.0, 0.0, 0.0 };
+  for (vtkIdType i = 0; i < bound->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    bound->GetPoints()->GetPoint(i, x);
+    vtkMath::Add(center, x, center);
+  }
+  vtkMath::MultiplyScalar(center, 1.0 / bound->GetNumberOfPoints());
+  const double outside[3] = { center[0] + 2.0, center[1] - 0.3, center[2] + 0.7 };
+  const double* positions[2] = { center, outside };
+  for (const double* x : positions)
+  {
+    int subId;
+    double boundCp[3], computedCp[3], pcoords[3], boundDist2, computedDist2;
+    std::vector<double> weights(bound->GetNumberOfPoints());
+    const int boundInside =
+      bound->EvaluatePosition(x, boundCp, subId, pcoords, boundDist2, weights.data());
+    const int computedInside =
+      computed->EvaluatePosition(x, computedCp, subId, pcoords, computedDist2, weights.data());
+    if (boundInside != computedInside)
+    {
+      std::cerr << "Wrong EvaluatePosition." << std::endl;
+      return false;
+    }
+    if (x == center)
+    {
+      if (boundDist2 != 0.0 || computedDist2 != 0.0)
+      {
+        std::cerr << "Point inside of the polyhedron found outside." << std::endl;
+        return false;
+      }
+      continue;
+    }
+
+    // The bound polyhedron visits its faces instead of using a locator, so
+    // its closest point must be the closest point of the faces.
+    double expectedDist2 = VTK_DOUBLE_MAX;
+    double expectedCp[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < computed->GetNumberOfFaces(); ++i)
+    {
+      vtkCell* face = computed->GetFace(i);
+      double faceCp[3], dist2;
+      std::vector<double> faceWeights(face->GetNumberOfPoints());
+      if (face->EvaluatePosition(x, faceCp, subId, pcoords, dist2, faceWeights.data()) != -1 &&
+        dist2 < expectedDist2)
+      {
+        expectedDist2 = dist2;
+        expectedCp[0] = faceCp[0];
+        expectedCp[1] = faceCp[1];
+        expectedCp[2] = faceCp[2];
+      }
+    }
+    if (std::abs(boundDist2 - expectedDist2) > 1e-12 ||
+      vtkMath::Distance2BetweenPoints(boundCp, expectedCp) > 1e-12)
+    {
+      std::cerr << "Wrong closest point." << std::endl;
+      return false;
+    }
+    if (boundDist2 <= 0.0)
+    {
+      std::cerr << "Point outside of the polyhedron found inside." << std::endl;
+      return false;
+    }
+  }
+
+  const double value = center[0] + 0.5 * center[1] + 0.25 * center[2];
+  if (CountContour(bound, pd, value) != CountContour(computed, pd, value))
+  {
+    std::cerr << "Wrong contour." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPolyhedronTopology(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+  if (grid->GetPolyhedronTopology())
+  {
+    std::cerr << "The topology is not built by default." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The deep copy does not get the topology, its polyhedra compute it.
+  vtkNew<vtkUnstructuredGrid> computedGrid;
+  grid->BuildPolyhedronTopology();
+  computedGrid->DeepCopy(grid);
+  vtkPolyhedronTopology* topology = grid->GetPolyhedronTopology();
+  if (!topology || computedGrid->GetPolyhedronTopology())
+  {
+    std::cerr << "Wrong topology after BuildPolyhedronTopology()." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (topology->GetNumberOfCells() != grid->GetNumberOfCells() ||
+    topology->HasCell(1 + Resolution + Resolution * Resolution) ||
+    !topology->HasCell(0) || topology->GetNumberOfFaces(0) != 6 ||
+    topology->GetNumberOfEdges(0) != 12 || topology->GetNumberOfTriangles(0) != 12)
+  {
+    std::cerr << "Wrong polyhedron topology." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkPointData* pd = grid->GetPointData();
+  vtkNew<vtkGenericCell> boundCell;
+  vtkNew<vtkGenericCell> computedCell;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCell(cellId, boundCell);
+    computedGrid->GetCell(cellId, computedCell);
+    if (boundCell->GetCellType() != VTK_POLYHEDRON)
+    {
+      continue;
+    }
+    if (!Compare(vtkPolyhedron::SafeDownCast(boundCell->GetRepresentativeCell()),
+          vtkPolyhedron::SafeDownCast(computedCell->GetRepresentativeCell()), pd))
+    {
+      std::cerr << "for cell " << cellId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Shallow copies share the topology.
+  vtkNew<vtkUnstructuredGrid> shallowCopy;
+  shallowCopy->ShallowCopy(grid);
+  if (shallowCopy->GetPolyhedronTopology() != topology)
+  {
+    std::cerr << "The topology is not shared by the shallow copy." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the points makes the topology out of date.
+  double x[3];
+  grid->GetPoints()->GetPoint(0, x);
+  x[0] -= 0.2;
+  grid->GetPoints()->SetPoint(0, x);
+  grid->GetPoints()->Modified();
+  if (grid->GetPolyhedronTopology())
+  {
+    std::cerr << "The topology is not out of date after modifying the points." << std::endl;
+    return EXIT_FAILURE;
+  }
+  grid->BuildPolyhedronTopology();
+  if (grid->GetPolyhedronTopology() != topology)
+  {
+    std::cerr << "The topology is not updated." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -35,11 +35,14 @@ public:
    */
   static vtkBox* New();
 
+  ///@{
   /**
    * Evaluate box defined by the two points (pMin,pMax).
    */
   using vtkImplicitFunction::EvaluateFunction;
   double EvaluateFunction(double x[3]) override;
+  void EvaluateFunctionBatch(const double* points, double* values, vtkIdType n) override;
+  ///@}
 
   /**
    * Evaluate the gradient of the box.
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <iterator>
 
 namespace
@@ -361,6 +362,15 @@ struct FindMaxCell // SMP functor
   void operator()(vtkIdType cellId, vtkIdType endCellId)
   {
     vtkIdType& lval = this->LocalResult.Local();
+    if (this->CellArray->IsStorageCompressed())
+    {
+      // Visit() would expand the storage, read the cell sizes instead.
+      for (; cellId < endCellId; ++cellId)
+      {
+        lval = std::max(lval, this->CellArray->GetCellSize(cellId));
+      }
+      return;
+    }
     lval = std::max(lval, this->CellArray->Visit(Impl{}, cellId, endCellId));
   }
 
@@ -522,6 +532,256 @@ struct AppendImpl
 } // end anon namespace
 
 VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+// The compressed representation of the cells. The offsets are implicit when
+// all the cells have the same size. The connectivity is split into blocks of
+// BlockSize values; the values of a block are stored as the difference to the
+// smallest value of the block, with the smallest of 1, 2, 4 or 8 bytes that
+// represents all the differences. Random access to a value is then a lookup
+// in the block tables and a read in Data.
+struct vtkCellArray::CompressedStorage
+{
+  static constexpr int BlockShift = 8;
+  static constexpr vtkIdType BlockSize = 1 << BlockShift;
+
+  vtkIdType NumberOfCells = 0;
+  vtkIdType NumberOfConnectivityIds = 0;
+
+  // Size of all the cells, or 0 if the offsets are stored in one of the
+  // offsets arrays (depending on the type the storage expands to).
+  vtkIdType CellSize = 0;
+  vtkSmartPointer<ArrayType32> Offsets32;
+  vtkSmartPointer<ArrayType64> Offsets64;
+
+  // For each block: its smallest value, the position of its first value in
+  // Data and the number of bytes per value.
+  std::vector<vtkTypeInt64> BlockBase;
+  std::vector<vtkTypeInt64> BlockStart;
+  std::vector<unsigned char> BlockWidth;
+  std::vector<unsigned char> Data;
+
+  // Largest value stored by the cell array, connectivity or offsets.
+  vtkTypeInt64 MaxValue = 0;
+
+  vtkIdType GetOffset(vtkIdType cellId) const
+  {
+    if (this->CellSize > 0)
+    {
+      return cellId * this->CellSize;
+    }
+    return this->Offsets64 ? static_cast<vtkIdType>(this->Offsets64->GetValue(cellId))
+                           : static_cast<vtkIdType>(this->Offsets32->GetValue(cellId));
+  }
+
+  template <typename DiffT, typename OutT>
+  static void DecodeValues(
+    const unsigned char* data, vtkTypeInt64 base, vtkIdType index, vtkIdType count, OutT* values)
+  {
+    data += index * sizeof(DiffT);
+    for (vtkIdType i = 0; i < count; ++i, data += sizeof(DiffT))
+    {
+      DiffT diff;
+      std::memcpy(&diff, data, sizeof(DiffT));
+      values[i] = static_cast<OutT>(base + static_cast<vtkTypeInt64>(diff));
+    }
+  }
+
+  // Decode the connectivity values in [begin, end).
+  template <typename OutT>
+  void Decode(vtkIdType begin, vtkIdType end, OutT* values) const
+  {
+    while (begin < end)
+    {
+      const vtkIdType block = begin >> BlockShift;
+      const vtkIdType index = begin & (BlockSize - 1);
+      const vtkIdType count = std::min(end - begin, BlockSize - index);
+      const unsigned char* data = this->Data.data() + this->BlockStart[block];
+      const vtkTypeInt64 base = this->BlockBase[block];
+      switch (this->BlockWidth[block])
+      {
+        case 1:
+          DecodeValues<vtkTypeUInt8>(data, base, index, count, values);
+          break;
+        case 2:
+          DecodeValues<vtkTypeUInt16>(data, base, index, count, values);
+          break;
+        case 4:
+          DecodeValues<vtkTypeUInt32>(data, base, index, count, values);
+          break;
+        default:
+          DecodeValues<vtkTypeUInt64>(data, base, index, count, values);
+          break;
+      }
+      begin += count;
+      values += count;
+    }
+  }
+
+  template <typename DiffT, typename ValueType>
+  static void EncodeValues(
+    const ValueType* values, vtkIdType count, vtkTypeInt64 base, unsigned char* data)
+  {
+    for (vtkIdType i = 0; i < count; ++i, data += sizeof(DiffT))
+    {
+      const DiffT diff = static_cast<DiffT>(static_cast<vtkTypeInt64>(values[i]) - base);
+      std::memcpy(data, &diff, sizeof(DiffT));
+    }
+  }
+
+  void SetOffsets(ArrayType32* offsets)
+  {
+    this->Offsets32 = vtkSmartPointer<ArrayType32>::New();
+    this->Offsets32->DeepCopy(offsets);
+  }
+  void SetOffsets(ArrayType64* offsets)
+  {
+    this->Offsets64 = vtkSmartPointer<ArrayType64>::New();
+    this->Offsets64->DeepCopy(offsets);
+  }
+
+  template <typename CellStateT>
+  void Build(CellStateT& state)
+  {
+    using ValueType = typename CellStateT::ValueType;
+
+    this->NumberOfCells = state.GetNumberOfCells();
+    this->NumberOfConnectivityIds = state.GetConnectivity()->GetNumberOfValues();
+    this->MaxValue = this->NumberOfConnectivityIds;
+    const vtkIdType cellSize = IsHomogeneousImpl{}(state);
+    if (cellSize > 0)
+    {
+      this->CellSize = cellSize;
+    }
+    else
+    {
+      this->SetOffsets(state.GetOffsets());
+    }
+
+    const ValueType* conn = state.GetConnectivity()->GetPointer(0);
+    const vtkIdType numIds = this->NumberOfConnectivityIds;
+    const vtkIdType numBlocks = (numIds + BlockSize - 1) >> BlockShift;
+    this->BlockBase.resize(numBlocks);
+    this->BlockStart.resize(numBlocks + 1);
+    this->BlockWidth.resize(numBlocks);
+    std::vector<vtkTypeInt64> blockMax(numBlocks);
+
+    // Range of the values of each block, and the width of the differences.
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+      for (; block < endBlock; ++block)
+      {
+        const vtkIdType begin = block << BlockShift;
+        const vtkIdType end = std::min(begin + BlockSize, numIds);
+        const auto range = std::minmax_element(conn + begin, conn + end);
+        const vtkTypeInt64 base = static_cast<vtkTypeInt64>(*range.first);
+        const vtkTypeUInt64 diff = static_cast<vtkTypeUInt64>(*range.second - base);
+        this->BlockBase[block] = base;
+        blockMax[block] = static_cast<vtkTypeInt64>(*range.second);
+        this->BlockWidth[block] = diff <= VTK_TYPE_UINT8_MAX ? 1
+          : diff <= VTK_TYPE_UINT16_MAX                      ? 2
+          : diff <= VTK_TYPE_UINT32_MAX                      ? 4
+                                                             : 8;
+      }
+    });
+
+    vtkTypeInt64 start = 0;
+    for (vtkIdType block = 0; block < numBlocks; ++block)
+    {
+      this->BlockStart[block] = start;
+      const vtkIdType count = std::min(BlockSize, numIds - (block << BlockShift));
+      start += count * this->BlockWidth[block];
+      this->MaxValue = std::max(this->MaxValue, blockMax[block]);
+    }
+    this->BlockStart[numBlocks] = start;
+    this->Data.resize(start);
+
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+      for (; block < endBlock; ++block)
+      {
+        const vtkIdType begin = block << BlockShift;
+        const vtkIdType count = std::min(BlockSize, numIds - begin);
+        unsigned char* data = this->Data.data() + this->BlockStart[block];
+        const vtkTypeInt64 base = this->BlockBase[block];
+        switch (this->BlockWidth[block])
+        {
+          case 1:
+            EncodeValues<vtkTypeUInt8>(conn + begin, count, base, data);
+            break;
+          case 2:
+            EncodeValues<vtkTypeUInt16>(conn + begin, count, base, data);
+            break;
+          case 4:
+            EncodeValues<vtkTypeUInt32>(conn + begin, count, base, data);
+            break;
+          default:
+            EncodeValues<vtkTypeUInt64>(conn + begin, count, base, data);
+            break;
+        }
+      }
+    });
+  }
+
+  template <typename CellStateT>
+  void Expand(CellStateT& state) const
+  {
+    using ValueType = typename CellStateT::ValueType;
+
+    auto* offsets = state.GetOffsets();
+    if (this->CellSize > 0)
+    {
+      offsets->SetNumberOfValues(this->NumberOfCells + 1);
+      ValueType* offsetsPtr = offsets->GetPointer(0);
+      const vtkIdType cellSize = this->CellSize;
+      vtkSMPTools::For(0, this->NumberOfCells + 1, [&](vtkIdType cellId, vtkIdType endCellId) {
+        for (; cellId < endCellId; ++cellId)
+        {
+          offsetsPtr[cellId] = static_cast<ValueType>(cellId * cellSize);
+        }
+      });
+    }
+    else if (this->Offsets64)
+    {
+      offsets->DeepCopy(this->Offsets64);
+    }
+    else
+    {
+      offsets->DeepCopy(this->Offsets32);
+    }
+
+    auto* conn = state.GetConnectivity();
+    conn->SetNumberOfValues(this->NumberOfConnectivityIds);
+    ValueType* connPtr = conn->GetPointer(0);
+    const vtkIdType numBlocks = static_cast<vtkIdType>(this->BlockWidth.size());
+    const vtkIdType numIds = this->NumberOfConnectivityIds;
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+      const vtkIdType begin = block << BlockShift;
+      const vtkIdType end = std::min(endBlock << BlockShift, numIds);
+      this->Decode(begin, end, connPtr + begin);
+    });
+  }
+
+  unsigned long GetActualMemorySize() const
+  {
+    size_t size = this->BlockBase.capacity() * sizeof(vtkTypeInt64) +
+      this->BlockStart.capacity() * sizeof(vtkTypeInt64) + this->BlockWidth.capacity() +
+      this->Data.capacity();
+    unsigned long offsetsSize = 0;
+    if (this->Offsets32)
+    {
+      offsetsSize = this->Offsets32->GetActualMemorySize();
+    }
+    else if (this->Offsets64)
+    {
+      offsetsSize = this->Offsets64->GetActualMemorySize();
+    }
+    return static_cast<unsigned long>(size / 1024 + 1) + offsetsSize;
+  }
+};
+
+// Definitions of the constants bound to references by std::min.
+constexpr int vtkCellArray::CompressedStorage::BlockShift;
+constexpr vtkIdType vtkCellArray::CompressedStorage::BlockSize;
+
+//------------------------------------------------------------------------------
 vtkCellArray::vtkCellArray() = default;
 vtkCellArray::~vtkCellArray() = default;
 vtkStandardNewMacro(vtkCellArray);
@@ -683,6 +943,33 @@ void vtkCellArray::DeepCopy(vtkAbstractCellArray* ca)
     return;
   }
 
+  this->ReleaseCompressedStorage();
+  if (other->UseCompressedStorage())
+  {
+    // Copy the compressed storage, with its own offsets.
+    this->Initialize();
+    if (other->Storage.Is64Bit())
+    {
+      this->Storage.Use64BitStorage();
+    }
+    else
+    {
+      this->Storage.Use32BitStorage();
+    }
+    auto compressed = std::make_shared<CompressedStorage>(*other->Compressed);
+    if (compressed->Offsets32)
+    {
+      compressed->SetOffsets(compressed->Offsets32);
+    }
+    if (compressed->Offsets64)
+    {
+      compressed->SetOffsets(compressed->Offsets64);
+    }
+    this->Compressed = compressed;
+    this->Modified();
+    return;
+  }
+
   if (other->Storage.Is64Bit())
   {
     this->Storage.Use64BitStorage();
@@ -716,6 +1003,23 @@ void vtkCellArray::ShallowCopy(vtkAbstractCellArray* ca)
     return;
   }
 
+  if (other->UseCompressedStorage())
+  {
+    // The compressed storage is never modified, it is shared.
+    this->Initialize();
+    if (other->Storage.Is64Bit())
+    {
+      this->Storage.Use64BitStorage();
+    }
+    else
+    {
+      this->Storage.Use32BitStorage();
+    }
+    this->Compressed = other->Compressed;
+    this->Modified();
+    return;
+  }
+
   if (other->Storage.Is64Bit())
   {
     auto& srcStorage = other->Storage.GetArrays64();
@@ -733,6 +1037,7 @@ void vtkCellArray::Append(vtkCellArray* src, vtkIdType pointOffset)
 {
   if (src->GetNumberOfCells() > 0)
   {
+    this->DetachCompressedStorage();
     this->Visit(AppendImpl{}, src, pointOffset);
   }
 }
@@ -740,6 +1045,7 @@ void vtkCellArray::Append(vtkCellArray* src, vtkIdType pointOffset)
 //------------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
+  this->ReleaseCompressedStorage();
   this->Visit(InitializeImpl{});
 
   this->LegacyData->Initialize();
@@ -764,6 +1070,7 @@ void vtkCellArray::SetData(vtkTypeInt32Array* offsets, vtkTypeInt32Array* connec
     return;
   }
 
+  this->ReleaseCompressedStorage();
   this->Storage.Use32BitStorage();
   auto& storage = this->Storage.GetArrays32();
 
@@ -783,6 +1090,7 @@ void vtkCellArray::SetData(vtkTypeInt64Array* offsets, vtkTypeInt64Array* connec
     return;
   }
 
+  this->ReleaseCompressedStorage();
   this->Storage.Use64BitStorage();
   auto& storage = this->Storage.GetArrays64();
 
@@ -976,6 +1284,7 @@ bool vtkCellArray::SetData(vtkIdType cellSize, vtkDataArray* connectivity)
 //------------------------------------------------------------------------------
 void vtkCellArray::Use32BitStorage()
 {
+  this->ReleaseCompressedStorage();
   if (!this->Storage.Is64Bit())
   {
     this->Initialize();
@@ -987,6 +1296,7 @@ void vtkCellArray::Use32BitStorage()
 //------------------------------------------------------------------------------
 void vtkCellArray::Use64BitStorage()
 {
+  this->ReleaseCompressedStorage();
   if (this->Storage.Is64Bit())
   {
     this->Initialize();
@@ -1012,6 +1322,10 @@ bool vtkCellArray::CanConvertTo32BitStorage() const
   {
     return true;
   }
+  if (this->UseCompressedStorage())
+  {
+    return this->Compressed->MaxValue <= VTK_TYPE_INT32_MAX;
+  }
   return this->Visit(CanConvert<ArrayType32::ValueType>{});
 }
 
@@ -1034,6 +1348,7 @@ bool vtkCellArray::CanConvertToDefaultStorage() const
 //------------------------------------------------------------------------------
 bool vtkCellArray::ConvertTo32BitStorage()
 {
+  this->ExpandCompressedStorage();
   if (!this->IsStorage64Bit())
   {
     return true;
@@ -1052,6 +1367,7 @@ bool vtkCellArray::ConvertTo32BitStorage()
 //------------------------------------------------------------------------------
 bool vtkCellArray::ConvertTo64BitStorage()
 {
+  this->ExpandCompressedStorage();
   if (this->IsStorage64Bit())
   {
     return true;
@@ -1080,6 +1396,7 @@ bool vtkCellArray::ConvertToDefaultStorage()
 //------------------------------------------------------------------------------
 bool vtkCellArray::ConvertToSmallestStorage()
 {
+  this->ExpandCompressedStorage();
   if (this->IsStorage64Bit() && this->CanConvertTo32BitStorage())
   {
     return this->ConvertTo32BitStorage();
@@ -1088,15 +1405,101 @@ bool vtkCellArray::ConvertToSmallestStorage()
   return true;
 }
 
+//------------------------------------------------------------------------------
+bool vtkCellArray::ConvertToCompressedStorage()
+{
+  if (this->UseCompressedStorage())
+  {
+    return true;
+  }
+  // The arrays may have been modified since an earlier compression was
+  // expanded.
+  this->ReleaseCompressedStorage();
+  // The storage expands to the smallest type.
+  if (!this->ConvertToSmallestStorage())
+  {
+    return false;
+  }
+
+  auto compressed = std::make_shared<CompressedStorage>();
+  if (this->Storage.Is64Bit())
+  {
+    compressed->Build(this->Storage.GetArrays64());
+    InitializeImpl{}(this->Storage.GetArrays64());
+  }
+  else
+  {
+    compressed->Build(this->Storage.GetArrays32());
+    InitializeImpl{}(this->Storage.GetArrays32());
+  }
+  this->Compressed = compressed;
+  this->LegacyData->Initialize();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::ExpandCompressedStorageInternal() const
+{
+  // Several threads may read the cell array when it is expanded: the first one
+  // expands it while the others wait, and the compressed storage is kept for
+  // the threads that are still reading it.
+  std::lock_guard<std::mutex> lock(this->CompressedMutex);
+  if (this->CompressedExpanded.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+  auto& storage = const_cast<vtkCellArray*>(this)->Storage;
+  if (storage.Is64Bit())
+  {
+    this->Compressed->Expand(storage.GetArrays64());
+  }
+  else
+  {
+    this->Compressed->Expand(storage.GetArrays32());
+  }
+  this->CompressedExpanded.store(true, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCompressedNumberOfCells() const
+{
+  return this->Compressed->NumberOfCells;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCompressedNumberOfConnectivityIds() const
+{
+  return this->Compressed->NumberOfConnectivityIds;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCompressedOffset(vtkIdType cellId) const
+{
+  return this->Compressed->GetOffset(cellId);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::GetCompressedCellAtId(
+  vtkIdType cellId, vtkIdType& cellSize, vtkIdType* cellPoints) const
+{
+  const CompressedStorage* compressed = this->Compressed.get();
+  const vtkIdType begin = compressed->GetOffset(cellId);
+  const vtkIdType end = compressed->GetOffset(cellId + 1);
+  cellSize = end - begin;
+  compressed->Decode(begin, end, cellPoints);
+}
+
 //------------------------------------------------------------------------------
 bool vtkCellArray::AllocateExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
+  this->ReleaseCompressedStorage();
   return this->Visit(AllocateExactImpl{}, numCells, connectivitySize);
 }
 
 //------------------------------------------------------------------------------
 bool vtkCellArray::ResizeExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
+  this->DetachCompressedStorage();
   return this->Visit(ResizeExactImpl{}, numCells, connectivitySize);
 }
 
@@ -1105,6 +1508,10 @@ bool vtkCellArray::ResizeExact(vtkIdType numCells, vtkIdType connectivitySize)
 // defining the cell.
 int vtkCellArray::GetMaxCellSize()
 {
+  if (this->UseCompressedStorage() && this->Compressed->CellSize > 0)
+  {
+    return static_cast<int>(this->Compressed->CellSize);
+  }
   const vtkIdType numCells = this->GetNumberOfCells();
   // We use THRESHOLD to test if the data size is small enough
   // to execute the functor serially. This is faster.
@@ -1118,7 +1525,13 @@ int vtkCellArray::GetMaxCellSize()
 //------------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize() const
 {
-  return this->Visit(GetActualMemorySizeImpl{});
+  if (this->UseCompressedStorage())
+  {
+    return this->Compressed->GetActualMemorySize();
+  }
+  // An expanded compressed storage is kept until the cells are modified.
+  return this->Visit(GetActualMemorySizeImpl{}) +
+    (this->Compressed ? this->Compressed->GetActualMemorySize() : 0);
 }
 
 //------------------------------------------------------------------------------
@@ -1127,6 +1540,18 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "StorageIs64Bit: " << this->Storage.Is64Bit() << "\n";
+  os << indent << "StorageIsCompressed: " << this->UseCompressedStorage() << "\n";
+
+  if (this->UseCompressedStorage())
+  {
+    // Do not expand the storage to print it.
+    os << indent << "NumberOfCells: " << this->Compressed->NumberOfCells << "\n";
+    os << indent << "NumberOfConnectivityIds: " << this->Compressed->NumberOfConnectivityIds
+       << "\n";
+    os << indent << "CellSize: " << this->Compressed->CellSize << "\n";
+    os << indent << "CompressedConnectivitySize: " << this->Compressed->Data.size() << "\n";
+    return;
+  }
 
   PrintSelfImpl functor;
   this->Visit(functor, os, indent);
@@ -1154,12 +1579,14 @@ void vtkCellArray::SetTraversalCellId(vtkIdType cellId)
 //------------------------------------------------------------------------------
 void vtkCellArray::ReverseCellAtId(vtkIdType cellId)
 {
+  this->DetachCompressedStorage();
   this->Visit(ReverseCellAtIdImpl{}, cellId);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::ReplaceCellAtId(vtkIdType cellId, vtkIdList* list)
 {
+  this->DetachCompressedStorage();
   this->Visit(ReplaceCellAtIdImpl{}, cellId, list->GetNumberOfIds(), list->GetPointer(0));
 }
 
@@ -1167,6 +1594,7 @@ void vtkCellArray::ReplaceCellAtId(vtkIdType cellId, vtkIdList* list)
 void vtkCellArray::ReplaceCellAtId(
   vtkIdType cellId, vtkIdType cellSize, const vtkIdType cellPoints[])
 {
+  this->DetachCompressedStorage();
   this->Visit(ReplaceCellAtIdImpl{}, cellId, cellSize, cellPoints);
 }
 
@@ -1174,13 +1602,14 @@ void vtkCellArray::ReplaceCellAtId(
 void vtkCellArray::ReplaceCellPointAtId(
   vtkIdType cellId, vtkIdType cellPointIndex, vtkIdType newPointId)
 {
+  this->DetachCompressedStorage();
   this->Visit(ReplaceCellPointAtIdImpl{}, cellId, cellPointIndex, newPointId);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::ExportLegacyFormat(vtkIdTypeArray* data)
 {
-  data->Allocate(this->Visit(GetLegacyDataSizeImpl{}));
+  data->Allocate(this->GetNumberOfCells() + this->GetNumberOfConnectivityIds());
 
   auto it = vtk::TakeSmartPointer(this->NewIterator());
 
@@ -1219,12 +1648,21 @@ void vtkCellArray::AppendLegacyFormat(vtkIdTypeArray* data, vtkIdType ptOffset)
 //------------------------------------------------------------------------------
 void vtkCellArray::AppendLegacyFormat(const vtkIdType* data, vtkIdType len, vtkIdType ptOffset)
 {
+  this->DetachCompressedStorage();
   this->Visit(AppendLegacyFormatImpl{}, data, len, ptOffset);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::Squeeze()
 {
+  if (this->UseCompressedStorage())
+  {
+    // The compressed storage is already tight.
+    this->LegacyData->Initialize();
+    return;
+  }
+  // Release the compressed storage kept after its expansion.
+  this->ReleaseCompressedStorage();
   this->Visit(SqueezeImpl{});
 
   // Just delete the legacy buffer.
@@ -1240,6 +1678,13 @@ bool vtkCellArray::IsValid()
 //------------------------------------------------------------------------------
 vtkIdType vtkCellArray::IsHomogeneous()
 {
+  if (this->UseCompressedStorage())
+  {
+    // The offsets are only kept for heterogeneous, non empty, cell arrays.
+    return this->Compressed->CellSize > 0 ? this->Compressed->CellSize
+      : this->Compressed->NumberOfCells > 0 ? -1
+                                            : 0;
+  }
   return this->Visit(IsHomogeneousImpl{});
 }
 VTK_ABI_NAMESPACE_END
@@ -83,6 +83,32 @@
  * - `bool ConvertTo64BitStorage()`
  * - `bool ConvertToDefaultStorage() // Depends on vtkIdType`
  * - `bool ConvertToSmallestStorage() // Depends on current values in arrays`
+ * - `bool ConvertToCompressedStorage()`
+ * - `bool IsStorageCompressed()`
+ *
+ * The compressed storage is a read-only representation meant for large,
+ * static topologies. The offsets are not stored when all the cells have the
+ * same size (e.g. tetrahedral or hexahedral meshes), and the connectivity is
+ * split into blocks of 256 values, each stored with 8, 16, 32 or 64 bits as
+ * differences to the smallest value of the block. Point ids of meshes with a
+ * good locality usually fit in 16 bits or less. GetNumberOfCells(),
+ * GetCellSize(), GetCellAtId(), GetOffset(), the traversal methods and
+ * vtkCellArrayIterator read the compressed storage directly. The other
+ * methods first expand the storage back to the explicit offsets and
+ * connectivity arrays, notably:
+ *
+ * - Visit(), GetOffsetsArray() and GetConnectivityArray(), so any filter using
+ *   them, building the cell links (vtkStaticCellLinks, BuildLinks()) and
+ *   vtkPolyData::BuildCells() expand the storage;
+ * - the legacy location based methods and GetData();
+ * - the storage conversions and the methods modifying the cells.
+ *
+ * The expansion happens once, under a lock, and keeps the compressed storage
+ * alive, so the reading methods may be called while other threads read the
+ * cell array, as the SMP filters do. The compressed storage is released by
+ * the next modification of the cells (InsertNextCell(), ReplaceCellAtId(),
+ * Reset(), Append()...), by Squeeze() and by the methods resetting the arrays
+ * (Initialize(), SetData(), the storage conversions).
  *
  * Note that some legacy methods are still available that reflect the
  * previous storage format of this data, which embedded the cell sizes into
@@ -136,8 +162,11 @@
 #include "vtkTypeInt64Array.h"       // Needed for inline methods
 #include "vtkTypeList.h"             // Needed for ArrayList definition
 
+#include <atomic>           // for std::atomic
 #include <cassert>          // for assert
 #include <initializer_list> // for API
+#include <memory>           // for std::shared_ptr
+#include <mutex>            // for std::mutex
 #include <type_traits>      // for std::is_same
 #include <utility>          // for std::forward
 
@@ -303,6 +332,10 @@ public:
    */
   vtkIdType GetNumberOfCells() const override
   {
+    if (this->UseCompressedStorage())
+    {
+      return this->GetCompressedNumberOfCells();
+    }
     if (this->Storage.Is64Bit())
     {
       return this->Storage.GetArrays64().Offsets->GetNumberOfValues() - 1;
@@ -319,6 +352,10 @@ public:
    */
   vtkIdType GetNumberOfOffsets() const override
   {
+    if (this->UseCompressedStorage())
+    {
+      return this->GetCompressedNumberOfCells() + 1;
+    }
     if (this->Storage.Is64Bit())
     {
       return this->Storage.GetArrays64().Offsets->GetNumberOfValues();
@@ -334,6 +371,10 @@ public:
    */
   vtkIdType GetOffset(vtkIdType cellId) override
   {
+    if (this->UseCompressedStorage())
+    {
+      return this->GetCompressedOffset(cellId);
+    }
     if (this->Storage.Is64Bit())
     {
       return this->Storage.GetArrays64().Offsets->GetValue(cellId);
@@ -352,6 +393,10 @@ public:
    */
   vtkIdType GetNumberOfConnectivityIds() const override
   {
+    if (this->UseCompressedStorage())
+    {
+      return this->GetCompressedNumberOfConnectivityIds();
+    }
     if (this->Storage.Is64Bit())
     {
       return this->Storage.GetArrays64().Connectivity->GetNumberOfValues();
@@ -431,6 +476,10 @@ public:
    */
   bool IsStorageShareable() const override
   {
+    if (this->UseCompressedStorage())
+    {
+      return false;
+    }
     if (this->Storage.Is64Bit())
     {
       return VisitState<ArrayType64>::ValueTypeIsSameAsIdType;
@@ -489,6 +538,25 @@ public:
   bool ConvertToSmallestStorage();
   /**@}*/
 
+  /**
+   * Convert the internal data structures to the compressed storage: the
+   * offsets are dropped when all the cells have the same size, and the
+   * connectivity is stored by blocks with the smallest number of bits
+   * representing the differences to the smallest id of each block. Existing
+   * data is preserved. The storage is expanded back to explicit arrays (of
+   * the smallest type) by the methods that modify the cell array or access
+   * its internal arrays, see the class documentation.
+   *
+   * @return True on success, false on failure.
+   */
+  bool ConvertToCompressedStorage();
+
+  /**
+   * @return True if the internal storage is compressed, see
+   * ConvertToCompressedStorage().
+   */
+  bool IsStorageCompressed() const { return this->UseCompressedStorage(); }
+
   /**
    * Return the array used to store cell offsets. The 32/64 variants are only
    * valid when IsStorage64Bit() returns the appropriate value.
@@ -496,6 +564,7 @@ public:
    */
   vtkDataArray* GetOffsetsArray()
   {
+    this->ExpandCompressedStorage();
     if (this->Storage.Is64Bit())
     {
       return this->GetOffsetsArray64();
@@ -505,8 +574,16 @@ public:
       return this->GetOffsetsArray32();
     }
   }
-  ArrayType32* GetOffsetsArray32() { return this->Storage.GetArrays32().Offsets; }
-  ArrayType64* GetOffsetsArray64() { return this->Storage.GetArrays64().Offsets; }
+  ArrayType32* GetOffsetsArray32()
+  {
+    this->ExpandCompressedStorage();
+    return this->Storage.GetArrays32().Offsets;
+  }
+  ArrayType64* GetOffsetsArray64()
+  {
+    this->ExpandCompressedStorage();
+    return this->Storage.GetArrays64().Offsets;
+  }
   /**@}*/
 
   /**
@@ -517,6 +594,7 @@ public:
    */
   vtkDataArray* GetConnectivityArray()
   {
+    this->ExpandCompressedStorage();
     if (this->Storage.Is64Bit())
     {
       return this->GetConnectivityArray64();
@@ -526,8 +604,16 @@ public:
       return this->GetConnectivityArray32();
     }
   }
-  ArrayType32* GetConnectivityArray32() { return this->Storage.GetArrays32().Connectivity; }
-  ArrayType64* GetConnectivityArray64() { return this->Storage.GetArrays64().Connectivity; }
+  ArrayType32* GetConnectivityArray32()
+  {
+    this->ExpandCompressedStorage();
+    return this->Storage.GetArrays32().Connectivity;
+  }
+  ArrayType64* GetConnectivityArray64()
+  {
+    this->ExpandCompressedStorage();
+    return this->Storage.GetArrays64().Connectivity;
+  }
   /**@}*/
 
   /**
@@ -912,7 +998,9 @@ public:
    *
    * where `state` is an instance of the vtkCellArray::VisitState<ArrayT> class,
    * instantiated for the current storage type of the cell array. See that
-   * class for usage details.
+   * class for usage details. A compressed storage is expanded before the
+   * functor is called, see ConvertToCompressedStorage(). The expansion is
+   * thread-safe.
    *
    * The functor may also:
    * - Return a value from `operator()`
@@ -960,6 +1048,7 @@ public:
     typename = typename std::enable_if<ReturnsVoid<Functor, Args...>::value>::type>
   void Visit(Functor&& functor, Args&&... args)
   {
+    this->ExpandCompressedStorage();
     if (this->Storage.Is64Bit())
     {
       // If you get an error on the next line, a call to Visit(functor, Args...)
@@ -980,6 +1069,7 @@ public:
     typename = typename std::enable_if<ReturnsVoid<Functor, Args...>::value>::type>
   void Visit(Functor&& functor, Args&&... args) const
   {
+    this->ExpandCompressedStorage();
     if (this->Storage.Is64Bit())
     {
       // If you get an error on the next line, a call to Visit(functor, Args...)
@@ -1000,6 +1090,7 @@ public:
     typename = typename std::enable_if<!ReturnsVoid<Functor, Args...>::value>::type>
   GetReturnType<Functor, Args...> Visit(Functor&& functor, Args&&... args)
   {
+    this->ExpandCompressedStorage();
     if (this->Storage.Is64Bit())
     {
       // If you get an error on the next line, a call to Visit(functor, Args...)
@@ -1019,6 +1110,7 @@ public:
     typename = typename std::enable_if<!ReturnsVoid<Functor, Args...>::value>::type>
   GetReturnType<Functor, Args...> Visit(Functor&& functor, Args&&... args) const
   {
+    this->ExpandCompressedStorage();
     if (this->Storage.Is64Bit())
     {
       // If you get an error on the next line, a call to Visit(functor, Args...)
@@ -1334,6 +1426,60 @@ protected:
   Storage Storage;
   vtkIdType TraversalCellId{ 0 };
 
+  // Compressed representation of the cells, see ConvertToCompressedStorage().
+  // Until it is expanded, the arrays of Storage are empty but keep the type
+  // the storage is expanded to. It is never modified once built, so it is
+  // shared by the shallow copies.
+  struct CompressedStorage;
+  std::shared_ptr<const CompressedStorage> Compressed;
+  // Set once Compressed has been expanded to the arrays of Storage, which are
+  // then used. Compressed is kept so that the threads still reading it are
+  // not affected, and released by the next modification of the cells.
+  mutable std::atomic<bool> CompressedExpanded{ false };
+  mutable std::mutex CompressedMutex;
+
+  // Whether the cells are read from the compressed storage.
+  bool UseCompressedStorage() const
+  {
+    return this->Compressed && !this->CompressedExpanded.load(std::memory_order_acquire);
+  }
+
+  // Expand the compressed storage, if any, to the arrays of Storage. This is
+  // thread-safe.
+  void ExpandCompressedStorage() const
+  {
+    if (this->UseCompressedStorage())
+    {
+      this->ExpandCompressedStorageInternal();
+    }
+  }
+  void ExpandCompressedStorageInternal() const;
+
+  // Drop the compressed storage, expanded or not. Not thread-safe.
+  void ReleaseCompressedStorage()
+  {
+    this->Compressed = nullptr;
+    this->CompressedExpanded.store(false, std::memory_order_relaxed);
+  }
+
+  // Expand and drop the compressed storage before the cells are modified: it
+  // would not match the modified arrays, so it cannot be read again. Like the
+  // modifications, this is not thread-safe.
+  void DetachCompressedStorage()
+  {
+    if (this->Compressed)
+    {
+      this->ExpandCompressedStorage();
+      this->ReleaseCompressedStorage();
+    }
+  }
+
+  // Read the compressed storage.
+  vtkIdType GetCompressedNumberOfCells() const;
+  vtkIdType GetCompressedNumberOfConnectivityIds() const;
+  vtkIdType GetCompressedOffset(vtkIdType cellId) const;
+  void GetCompressedCellAtId(vtkIdType cellId, vtkIdType& cellSize, vtkIdType* cellPoints) const;
+
   vtkNew<vtkIdTypeArray> LegacyData; // For GetData().
 
   static bool DefaultStorageIs64Bit;
@@ -1584,6 +1730,10 @@ inline int vtkCellArray::GetNextCell(vtkIdList* pts)
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::GetCellSize(const vtkIdType cellId) const
 {
+  if (this->UseCompressedStorage())
+  {
+    return this->GetCompressedOffset(cellId + 1) - this->GetCompressedOffset(cellId);
+  }
   return this->Visit(vtkCellArray_detail::GetCellSizeImpl{}, cellId);
 }
 
@@ -1591,18 +1741,37 @@ inline vtkIdType vtkCellArray::GetCellSize(const vtkIdType cellId) const
 inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType& cellSize,
   vtkIdType const*& cellPoints, vtkIdList* ptIds) VTK_SIZEHINT(cellPoints, cellSize)
 {
+  if (this->UseCompressedStorage())
+  {
+    ptIds->SetNumberOfIds(this->GetCellSize(cellId));
+    this->GetCompressedCellAtId(cellId, cellSize, ptIds->GetPointer(0));
+    cellPoints = ptIds->GetPointer(0);
+    return;
+  }
   this->Visit(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints, ptIds);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList* pts)
 {
+  if (this->UseCompressedStorage())
+  {
+    vtkIdType cellSize;
+    pts->SetNumberOfIds(this->GetCellSize(cellId));
+    this->GetCompressedCellAtId(cellId, cellSize, pts->GetPointer(0));
+    return;
+  }
   this->Visit(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, pts);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType& cellSize, vtkIdType* cellPoints)
 {
+  if (this->UseCompressedStorage())
+  {
+    this->GetCompressedCellAtId(cellId, cellSize, cellPoints);
+    return;
+  }
   this->Visit(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints);
 }
 
@@ -1610,18 +1779,21 @@ inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType& cellSize, vtk
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts, const vtkIdType* pts)
   VTK_SIZEHINT(pts, npts)
 {
+  this->DetachCompressedStorage();
   return this->Visit(vtkCellArray_detail::InsertNextCellImpl{}, npts, pts);
 }
 
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
+  this->DetachCompressedStorage();
   return this->Visit(vtkCellArray_detail::InsertNextCellImpl{}, npts);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  this->DetachCompressedStorage();
   if (this->Storage.Is64Bit())
   {
     using ValueType = typename ArrayType64::ValueType;
@@ -1637,12 +1809,14 @@ inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
+  this->DetachCompressedStorage();
   this->Visit(vtkCellArray_detail::UpdateCellCountImpl{}, npts);
 }
 
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdList* pts)
 {
+  this->DetachCompressedStorage();
   return this->Visit(
     vtkCellArray_detail::InsertNextCellImpl{}, pts->GetNumberOfIds(), pts->GetPointer(0));
 }
@@ -1651,6 +1825,7 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdList* pts)
 inline vtkIdType vtkCellArray::InsertNextCell(vtkCell* cell)
 {
   vtkIdList* pts = cell->GetPointIds();
+  this->DetachCompressedStorage();
   return this->Visit(
     vtkCellArray_detail::InsertNextCellImpl{}, pts->GetNumberOfIds(), pts->GetPointer(0));
 }
@@ -1658,6 +1833,7 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkCell* cell)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::Reset()
 {
+  this->ReleaseCompressedStorage();
   this->Visit(vtkCellArray_detail::ResetImpl{});
 }
 
@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellScratch.h"
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkSetGet.h"
+
+#include <algorithm>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Alignment of the buffers, and size of the first block.
+constexpr size_t ScratchAlignment = alignof(std::max_align_t);
+constexpr size_t MinimumBlockSize = 16384;
+}
+
+//------------------------------------------------------------------------------
+vtkCellScratch::vtkCellScratch() = default;
+
+//------------------------------------------------------------------------------
+vtkCellScratch::~vtkCellScratch() = default;
+
+//------------------------------------------------------------------------------
+vtkCellScratch& vtkCellScratch::GetLocal()
+{
+  static VTK_THREAD_LOCAL vtkCellScratch scratch;
+  return scratch;
+}
+
+//------------------------------------------------------------------------------
+void* vtkCellScratch::AllocateBytes(size_t size)
+{
+  size = (std::max<size_t>(size, 1) + ScratchAlignment - 1) / ScratchAlignment * ScratchAlignment;
+
+  // Move to the next block when the current one is full. The blocks after the
+  // current one are not in use, a block too small for the request is replaced.
+  if (this->CurrentBlock >= this->Blocks.size() ||
+    this->CurrentOffset + size > this->Blocks[this->CurrentBlock].Size)
+  {
+    if (this->CurrentBlock < this->Blocks.size() && this->CurrentOffset > 0)
+    {
+      ++this->CurrentBlock;
+    }
+    this->CurrentOffset = 0;
+    if (this->CurrentBlock >= this->Blocks.size() || this->Blocks[this->CurrentBlock].Size < size)
+    {
+      size_t blockSize = std::max(size, MinimumBlockSize);
+      if (!this->Blocks.empty())
+      {
+        blockSize = std::max(blockSize, 2 * this->Blocks.back().Size);
+      }
+      BlockType block;
+      block.Data.reset(new unsigned char[blockSize]);
+      block.Size = blockSize;
+      if (this->CurrentBlock < this->Blocks.size())
+      {
+        this->Blocks[this->CurrentBlock] = std::move(block);
+      }
+      else
+      {
+        this->Blocks.push_back(std::move(block));
+      }
+      ++this->NumberOfAllocations;
+    }
+  }
+
+  void* buffer = this->Blocks[this->CurrentBlock].Data.get() + this->CurrentOffset;
+  this->CurrentOffset += size;
+  return buffer;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkCellScratch::GetCapacity() const
+{
+  size_t capacity = 0;
+  for (const BlockType& block : this->Blocks)
+  {
+    capacity += block.Size;
+  }
+  return capacity;
+}
+
+//------------------------------------------------------------------------------
+void vtkCellScratch::Squeeze()
+{
+  this->Blocks.clear();
+  this->CurrentBlock = 0;
+  this->CurrentOffset = 0;
+  this->IdLists.clear();
+  this->NumberOfIdLists = 0;
+  this->Points.clear();
+  this->NumberOfPoints = 0;
+  this->GenericCells.clear();
+  this->NumberOfGenericCells = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkCellScratch::Frame::Frame()
+  : Frame(vtkCellScratch::GetLocal())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkCellScratch::Frame::Frame(vtkCellScratch& scratch)
+  : Scratch(scratch)
+  , Block(scratch.CurrentBlock)
+  , Offset(scratch.CurrentOffset)
+  , NumberOfIdLists(scratch.NumberOfIdLists)
+  , NumberOfPoints(scratch.NumberOfPoints)
+  , NumberOfGenericCells(scratch.NumberOfGenericCells)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkCellScratch::Frame::~Frame()
+{
+  this->Scratch.CurrentBlock = this->Block;
+  this->Scratch.CurrentOffset = this->Offset;
+  this->Scratch.NumberOfIdLists = this->NumberOfIdLists;
+  this->Scratch.NumberOfPoints = this->NumberOfPoints;
+  this->Scratch.NumberOfGenericCells = this->NumberOfGenericCells;
+}
+
+//------------------------------------------------------------------------------
+vtkIdList* vtkCellScratch::Frame::GetIdList()
+{
+  vtkCellScratch& scratch = this->Scratch;
+  if (scratch.NumberOfIdLists == scratch.IdLists.size())
+  {
+    scratch.IdLists.push_back(vtkSmartPointer<vtkIdList>::New());
+    ++scratch.NumberOfAllocations;
+  }
+  vtkIdList* ids = scratch.IdLists[scratch.NumberOfIdLists++];
+  ids->Reset();
+  return ids;
+}
+
+//------------------------------------------------------------------------------
+vtkPoints* vtkCellScratch::Frame::GetPoints()
+{
+  vtkCellScratch& scratch = this->Scratch;
+  if (scratch.NumberOfPoints == scratch.Points.size())
+  {
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->SetDataTypeToDouble();
+    scratch.Points.push_back(points);
+    ++scratch.NumberOfAllocations;
+  }
+  vtkPoints* points = scratch.Points[scratch.NumberOfPoints++];
+  points->Reset();
+  return points;
+}
+
+//------------------------------------------------------------------------------
+vtkGenericCell* vtkCellScratch::Frame::GetGenericCell()
+{
+  vtkCellScratch& scratch = this->Scratch;
+  if (scratch.NumberOfGenericCells == scratch.GenericCells.size())
+  {
+    scratch.GenericCells.push_back(vtkSmartPointer<vtkGenericCell>::New());
+    ++scratch.NumberOfAllocations;
+  }
+  return scratch.GenericCells[scratch.NumberOfGenericCells++];
+}
+
+//------------------------------------------------------------------------------
+const vtkIdType* vtkCellScratch::Frame::GetCellPoints(
+  vtkCellArray* cells, vtkIdType cellId, vtkIdType& npts)
+{
+  const vtkIdType* pts;
+  if (cells->IsStorageShareable())
+  {
+    // The connectivity is stored as vtkIdType and read in place.
+    cells->GetCellAtId(cellId, npts, pts, nullptr);
+    return pts;
+  }
+  npts = cells->GetCellSize(cellId);
+  vtkIdType* ids = this->Allocate<vtkIdType>(npts);
+  cells->GetCellAtId(cellId, npts, ids);
+  return ids;
+}
+
+//------------------------------------------------------------------------------
+double* vtkCellScratch::Frame::GetCoordinates(
+  vtkPoints* points, vtkIdType npts, const vtkIdType* pts)
+{
+  double* coordinates = this->Allocate<double>(3 * npts);
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    points->GetPoint(pts[i], coordinates + 3 * i);
+  }
+  return coordinates;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkCellScratch
+ * @brief   thread-local scratch memory for per-cell computations
+ *
+ * vtkCellScratch provides the temporary buffers and objects (vtkIdList,
+ * vtkPoints, vtkGenericCell) that per-cell computations such as interpolation
+ * weights, derivatives or point location need, without allocating memory for
+ * every cell. Each thread has its own scratch, returned by GetLocal(), so the
+ * SMP filters do not have to keep thread-local copies of these objects.
+ *
+ * The scratch is handed out with a stack-like lifetime through
+ * vtkCellScratch::Frame: the buffers and objects obtained from a frame are
+ * released when the frame is destroyed, and reused by the following frames.
+ * Once the scratch has grown to the needs of a computation, repeating it
+ * does not allocate memory anymore.
+ *
+ * @code
+ * vtkCellScratch::Frame frame;
+ * double* weights = frame.Allocate<double>(cell->GetNumberOfPoints());
+ * vtkIdType npts;
+ * const vtkIdType* pts = frame.GetCellPoints(cellArray, cellId, npts);
+ * @endcode
+ *
+ * The frames of a thread must be destroyed in the reverse order of their
+ * creation, which is the case when they are local variables. Buffers are
+ * uninitialized and suitably aligned for any fundamental type; they remain
+ * valid until their frame is destroyed, even when more memory is allocated.
+ *
+ * @sa
+ * vtkGenericCell vtkCellArray
+ */
+
+#ifndef vtkCellScratch_h
+#define vtkCellScratch_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkSmartPointer.h"          // For vtkSmartPointer
+#include "vtkType.h"                  // For vtkIdType
+
+#include <cstddef> // For size_t
+#include <memory>  // For std::unique_ptr
+#include <vector>  // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkCellArray;
+class vtkGenericCell;
+class vtkIdList;
+class vtkPoints;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkCellScratch
+{
+public:
+  vtkCellScratch();
+  ~vtkCellScratch();
+
+  /**
+   * Return the scratch of the calling thread.
+   */
+  static vtkCellScratch& GetLocal();
+
+  class VTKCOMMONDATAMODEL_EXPORT Frame
+  {
+  public:
+    /**
+     * Open a frame on the scratch of the calling thread, or on the given
+     * scratch.
+     */
+    Frame();
+    explicit Frame(vtkCellScratch& scratch);
+
+    /**
+     * Release everything obtained from the frame.
+     */
+    ~Frame();
+
+    /**
+     * Return an uninitialized buffer of n values. T must be trivially
+     * copyable and destructible, since no constructor nor destructor is
+     * called.
+     */
+    template <typename T>
+    T* Allocate(size_t n)
+    {
+      return static_cast<T*>(this->Scratch.AllocateBytes(n * sizeof(T)));
+    }
+
+    ///@{
+    /**
+     * Return an empty id list, an empty set of points (with double precision)
+     * or a generic cell. They must not be kept after the frame is destroyed.
+     */
+    vtkIdList* GetIdList();
+    vtkPoints* GetPoints();
+    vtkGenericCell* GetGenericCell();
+    ///@}
+
+    /**
+     * Return a view of the point ids of a cell. The ids are read in place
+     * when the cell array stores vtkIdType values, they are copied in the
+     * frame otherwise.
+     */
+    const vtkIdType* GetCellPoints(vtkCellArray* cells, vtkIdType cellId, vtkIdType& npts);
+
+    /**
+     * Gather the coordinates of the given points (3 values per point) in a
+     * buffer of the frame.
+     */
+    double* GetCoordinates(vtkPoints* points, vtkIdType npts, const vtkIdType* pts);
+
+  private:
+    Frame(const Frame&) = delete;
+    void operator=(const Frame&) = delete;
+
+    vtkCellScratch& Scratch;
+    size_t Block;
+    size_t Offset;
+    size_t NumberOfIdLists;
+    size_t NumberOfPoints;
+    size_t NumberOfGenericCells;
+  };
+
+  /**
+   * Return the number of memory blocks and objects the scratch allocated
+   * since its creation. It does not change when a computation is repeated
+   * once the scratch has grown to its needs.
+   */
+  vtkIdType GetNumberOfAllocations() const { return this->NumberOfAllocations; }
+
+  /**
+   * Return the size in bytes of the buffer memory held by the scratch.
+   */
+  size_t GetCapacity() const;
+
+  /**
+   * Free the memory held by the scratch. No frame must be open.
+   */
+  void Squeeze();
+
+private:
+  vtkCellScratch(const vtkCellScratch&) = delete;
+  void operator=(const vtkCellScratch&) = delete;
+
+  void* AllocateBytes(size_t size);
+
+  struct BlockType
+  {
+    std::unique_ptr<unsigned char[]> Data;
+    size_t Size;
+  };
+  std::vector<BlockType> Blocks;
+  size_t CurrentBlock = 0;
+  size_t CurrentOffset = 0;
+
+  std::vector<vtkSmartPointer<vtkIdList>> IdLists;
+  size_t NumberOfIdLists = 0;
+  std::vector<vtkSmartPointer<vtkPoints>> Points;
+  size_t NumberOfPoints = 0;
+  std::vector<vtkSmartPointer<vtkGenericCell>> GenericCells;
+  size_t NumberOfGenericCells = 0;
+
+  vtkIdType NumberOfAllocations = 0;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -37,6 +37,22 @@ double vtkCylinder::EvaluateFunction(double x[3])
   return ((vtkMath::Dot(x2C, x2C) - proj * proj) - this->Radius * this->Radius);
 }
 
+//------------------------------------------------------------------------------
+// Evaluate cylinder equation for n points.
+void vtkCylinder::EvaluateFunctionBatch(const double* points, double* values, vtkIdType n)
+{
+  const double c0 = this->Center[0], c1 = this->Center[1], c2 = this->Center[2];
+  const double a0 = this->Axis[0], a1 = this->Axis[1], a2 = this->Axis[2];
+  const double r2 = this->Radius * this->Radius;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const double* x = points + 3 * i;
+    const double d0 = x[0] - c0, d1 = x[1] - c1, d2 = x[2] - c2;
+    const double proj = a0 * d0 + a1 * d1 + a2 * d2;
+    values[i] = ((d0 * d0 + d1 * d1 + d2 * d2) - proj * proj) - r2;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Evaluate cylinder function gradient (along potentially oriented axis). The
 // gradient is always in the radial direction, and thus must be projected
@@ -4,6 +4,7 @@
 #include "vtkHigherOrderQuadrilateral.h"
 
 #include "vtkCellData.h"
+#include "vtkCellScratch.h"
 #include "vtkDoubleArray.h"
 #include "vtkHigherOrderCurve.h"
 #include "vtkHigherOrderInterpolation.h"
@@ -311,11 +312,12 @@ void vtkHigherOrderQuadrilateral::Derivatives(
   vtkIdType numberOfPoints = this->Points->GetNumberOfPoints();
 
   double sum[2], p[3];
-  std::vector<double> functionDerivs(2 * numberOfPoints);
+  vtkCellScratch::Frame frame;
+  double* functionDerivs = frame.Allocate<double>(2 * numberOfPoints);
   double *J[3], J0[3], J1[3], J2[3];
   double *JI[3], JI0[3], JI1[3], JI2[3];
 
-  this->InterpolateDerivs(pcoords, functionDerivs.data());
+  this->InterpolateDerivs(pcoords, functionDerivs);
 
   // Compute transposed Jacobian and inverse Jacobian
   J[0] = J0;
@@ -3,6 +3,7 @@
 
 #include "vtkHigherOrderTetra.h"
 
+#include "vtkCellScratch.h"
 #include "vtkDoubleArray.h"
 #include "vtkHigherOrderCurve.h"
 #include "vtkHigherOrderTriangle.h"
@@ -724,7 +725,8 @@ void vtkHigherOrderTetra::Derivatives(
 {
   double *jI[3], j0[3], j1[3], j2[3];
   vtkIdType numberOfPoints = this->Points->GetNumberOfPoints();
-  std::vector<double> fDs(3 * numberOfPoints);
+  vtkCellScratch::Frame frame;
+  double* fDs = frame.Allocate<double>(3 * numberOfPoints);
   double sum[3];
   int i, j, k;
 
@@ -732,7 +734,7 @@ void vtkHigherOrderTetra::Derivatives(
   jI[0] = j0;
   jI[1] = j1;
   jI[2] = j2;
-  this->JacobianInverse(pcoords, jI, fDs.data());
+  this->JacobianInverse(pcoords, jI, fDs);
 
   // now compute derivatives of values provided
   for (k = 0; k < dim; k++) // loop over values per vertex
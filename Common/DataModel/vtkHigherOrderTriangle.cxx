@@ -7,6 +7,7 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCellScratch.h"
 #include "vtkDoubleArray.h"
 #include "vtkHigherOrderCurve.h"
 #include "vtkIncrementalPointLocator.h"
@@ -588,7 +589,8 @@ void vtkHigherOrderTriangle::Derivatives(
   int vtkNotUsed(subId), const double pcoords[3], const double* values, int dim, double* derivs)
 {
   double *jI[3], j0[3], j1[3], j2[3];
-  std::vector<double> fDs(2 * this->Points->GetNumberOfPoints());
+  vtkCellScratch::Frame frame;
+  double* fDs = frame.Allocate<double>(2 * this->Points->GetNumberOfPoints());
   double sum[3];
   int i, j, k;
   vtkIdType numberOfPoints = this->Points->GetNumberOfPoints();
@@ -597,7 +599,7 @@ void vtkHigherOrderTriangle::Derivatives(
   jI[0] = j0;
   jI[1] = j1;
   jI[2] = j2;
-  this->JacobianInverse(pcoords, jI, fDs.data());
+  this->JacobianInverse(pcoords, jI, fDs);
 
   // now compute derivates of values provided
   for (k = 0; k < dim; k++) // loop over values per vertex
@@ -5,6 +5,7 @@
 #include "vtkImplicitFunctionCollection.h"
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
 #include <cmath>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -135,6 +136,77 @@ double vtkImplicitBoolean::EvaluateFunction(double x[3])
   return value;
 }
 
+// Evaluate the boolean combination for n points: each function is evaluated
+// for a block of points and the values are combined while they are still in
+// cache, instead of traversing the function list for each point.
+void vtkImplicitBoolean::EvaluateFunctionBatch(const double* points, double* values, vtkIdType n)
+{
+  if (this->FunctionList->GetNumberOfItems() == 0)
+  {
+    std::fill_n(values, n, 0.0);
+    return;
+  }
+
+  constexpr vtkIdType blockSize = 256;
+  double functionValues[blockSize];
+  for (vtkIdType begin = 0; begin < n; begin += blockSize)
+  {
+    const vtkIdType count = std::min(blockSize, n - begin);
+    const double* x = points + 3 * begin;
+    double* value = values + begin;
+
+    vtkCollectionSimpleIterator sit;
+    this->FunctionList->InitTraversal(sit);
+    vtkImplicitFunction* firstF = this->FunctionList->GetNextImplicitFunction(sit);
+    firstF->FunctionValueBatch(x, value, count);
+    if (this->OperationType == VTK_UNION_OF_MAGNITUDES)
+    {
+      for (vtkIdType i = 0; i < count; ++i)
+      {
+        value[i] = std::fabs(value[i]);
+      }
+    }
+
+    vtkImplicitFunction* f;
+    while ((f = this->FunctionList->GetNextImplicitFunction(sit)))
+    {
+      if (f == firstF)
+      {
+        continue;
+      }
+      f->FunctionValueBatch(x, functionValues, count);
+      if (this->OperationType == VTK_UNION)
+      { // take minimum value
+        for (vtkIdType i = 0; i < count; ++i)
+        {
+          value[i] = std::min(value[i], functionValues[i]);
+        }
+      }
+      else if (this->OperationType == VTK_INTERSECTION)
+      { // take maximum value
+        for (vtkIdType i = 0; i < count; ++i)
+        {
+          value[i] = std::max(value[i], functionValues[i]);
+        }
+      }
+      else if (this->OperationType == VTK_UNION_OF_MAGNITUDES)
+      { // take minimum absolute value
+        for (vtkIdType i = 0; i < count; ++i)
+        {
+          value[i] = std::min(value[i], std::fabs(functionValues[i]));
+        }
+      }
+      else // difference
+      {
+        for (vtkIdType i = 0; i < count; ++i)
+        {
+          value[i] = std::max(value[i], -functionValues[i]);
+        }
+      }
+    }
+  }
+}
+
 // Evaluate gradient of boolean combination.
 void vtkImplicitBoolean::EvaluateGradient(double x[3], double g[3])
 {
@@ -54,6 +54,7 @@ public:
    */
   using vtkImplicitFunction::EvaluateFunction;
   double EvaluateFunction(double x[3]) override;
+  void EvaluateFunctionBatch(const double* points, double* values, vtkIdType n) override;
   ///@}
 
   /**
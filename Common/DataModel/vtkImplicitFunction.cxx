@@ -5,7 +5,9 @@
 #include "vtkAbstractTransform.h"
 #include "vtkArrayDispatch.h"
 #include "vtkDataArrayRange.h"
+#include "vtkLinearTransform.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkSMPTools.h"
 #include "vtkTransform.h"
 
@@ -28,6 +30,8 @@ vtkImplicitFunction::~vtkImplicitFunction()
 
 namespace
 {
+// Number of points evaluated at once by the batched evaluation.
+constexpr vtkIdType BlockSize = 256;
 
 template <class Func>
 struct FunctionWorker
@@ -48,14 +52,24 @@ struct FunctionWorker
 
     using DstValueT = typename decltype(dstValues)::ValueType;
     vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
-      double tuple[3];
-      for (vtkIdType pointId = begin; pointId < end; ++pointId)
+      double points[3 * BlockSize];
+      double values[BlockSize];
+      for (vtkIdType blockBegin = begin; blockBegin < end; blockBegin += BlockSize)
       {
+        const vtkIdType blockEnd = std::min(blockBegin + BlockSize, end);
         // GetTuple creates a copy of the tuple using GetTypedTuple if it's not a vktDataArray
         // we do that since the input points can be implicit points, and GetTypedTuple is faster
         // than accessing the component of the TupleReference using GetTypedComponent internally.
-        srcTuples.GetTuple(pointId, tuple);
-        dstValues[pointId] = static_cast<DstValueT>(this->F(tuple));
+        double* point = points;
+        for (vtkIdType pointId = blockBegin; pointId < blockEnd; ++pointId, point += 3)
+        {
+          srcTuples.GetTuple(pointId, point);
+        }
+        this->F(points, values, blockEnd - blockBegin);
+        for (vtkIdType pointId = blockBegin; pointId < blockEnd; ++pointId)
+        {
+          dstValues[pointId] = static_cast<DstValueT>(values[pointId - blockBegin]);
+        }
       }
     });
   }
@@ -68,7 +82,10 @@ public:
     : Function(function)
   {
   }
-  double operator()(double in[3]) { return this->Function->EvaluateFunction(in); }
+  void operator()(const double* points, double* values, vtkIdType n)
+  {
+    this->Function->EvaluateFunctionBatch(points, values, n);
+  }
 
 private:
   vtkImplicitFunction* Function;
@@ -77,20 +94,17 @@ private:
 class TransformFunction
 {
 public:
-  TransformFunction(vtkImplicitFunction* function, vtkAbstractTransform* transform)
+  TransformFunction(vtkImplicitFunction* function)
     : Function(function)
-    , Transform(transform)
   {
   }
-  double operator()(double in[3])
+  void operator()(const double* points, double* values, vtkIdType n)
   {
-    this->Transform->TransformPoint(in, in);
-    return this->Function->EvaluateFunction(in);
+    this->Function->FunctionValueBatch(points, values, n);
   }
 
 private:
   vtkImplicitFunction* Function;
-  vtkAbstractTransform* Transform;
 };
 
 } // end anon namespace
@@ -103,7 +117,7 @@ void vtkImplicitFunction::FunctionValue(vtkDataArray* input, vtkDataArray* outpu
   }
   else // pass point through transform
   {
-    FunctionWorker<TransformFunction> worker(TransformFunction(this, this->Transform));
+    FunctionWorker<TransformFunction> worker((TransformFunction(this)));
     typedef vtkTypeList::Create<float, double> InputTypes;
     typedef vtkTypeList::Create<float, double> OutputTypes;
     typedef vtkArrayDispatch::Dispatch2ByValueTypeUsingArrays<vtkArrayDispatch::AllArrays,
@@ -134,6 +148,72 @@ void vtkImplicitFunction::EvaluateFunction(vtkDataArray* input, vtkDataArray* ou
   }
 }
 
+void vtkImplicitFunction::EvaluateFunctionBatch(
+  const double* points, double* values, vtkIdType n)
+{
+  double x[3];
+  for (vtkIdType i = 0; i < n; ++i, points += 3)
+  {
+    x[0] = points[0];
+    x[1] = points[1];
+    x[2] = points[2];
+    values[i] = this->EvaluateFunction(x);
+  }
+}
+
+// Evaluate the function at n points, transformed through transform (if
+// provided). The points are transformed block by block in a local buffer.
+void vtkImplicitFunction::FunctionValueBatch(const double* points, double* values, vtkIdType n)
+{
+  if (!this->Transform)
+  {
+    this->EvaluateFunctionBatch(points, values, n);
+    return;
+  }
+
+  // Linear transforms are applied inline, other transforms point by point.
+  vtkLinearTransform* linear = vtkLinearTransform::SafeDownCast(this->Transform);
+  double m[3][4];
+  if (linear)
+  {
+    vtkMatrix4x4* matrix = linear->GetMatrix();
+    for (int i = 0; i < 3; ++i)
+    {
+      std::copy_n(matrix->GetData() + 4 * i, 4, m[i]);
+    }
+  }
+  else
+  {
+    this->Transform->Update();
+  }
+
+  double transformed[3 * BlockSize];
+  for (vtkIdType begin = 0; begin < n; begin += BlockSize)
+  {
+    const vtkIdType count = std::min(BlockSize, n - begin);
+    const double* x = points + 3 * begin;
+    if (linear)
+    {
+      for (vtkIdType i = 0; i < count; ++i)
+      {
+        const double* p = x + 3 * i;
+        double* t = transformed + 3 * i;
+        t[0] = m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2] + m[0][3];
+        t[1] = m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2] + m[1][3];
+        t[2] = m[2][0] * p[0] + m[2][1] * p[1] + m[2][2] * p[2] + m[2][3];
+      }
+    }
+    else
+    {
+      for (vtkIdType i = 0; i < count; ++i)
+      {
+        this->Transform->InternalTransformPoint(x + 3 * i, transformed + 3 * i);
+      }
+    }
+    this->EvaluateFunctionBatch(transformed, values + begin, count);
+  }
+}
+
 // Evaluate function at position x-y-z and return value. Point x[3] is
 // transformed through transform (if provided).
 double vtkImplicitFunction::FunctionValue(const double x[3])
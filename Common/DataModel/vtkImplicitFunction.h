@@ -72,6 +72,15 @@ public:
   }
   ///@}
 
+  /**
+   * Evaluate the function at `n` points stored contiguously in `points`
+   * (x0, y0, z0, x1, y1, z1, ...) and store the values in `values`. The
+   * points are transformed through the transform (if provided). This is the
+   * batched equivalent of FunctionValue(const double x[3]) and is safe to call
+   * from several threads.
+   */
+  void FunctionValueBatch(const double* points, double* values, vtkIdType n);
+
   ///@{
   /**
    * Evaluate function gradient at position x-y-z and pass back vector. Point
@@ -116,6 +125,17 @@ public:
   }
   ///@}
 
+  /**
+   * Evaluate the function at `n` points stored contiguously in `points`
+   * and store the values in `values`, without applying the transform. You
+   * should generally use FunctionValueBatch() instead. The default
+   * implementation calls EvaluateFunction() for each point; subclasses
+   * override it with loops free of virtual calls that the compiler can
+   * vectorize. FunctionValue(vtkDataArray*, vtkDataArray*) evaluates the
+   * points through this method, block by block.
+   */
+  virtual void EvaluateFunctionBatch(const double* points, double* values, vtkIdType n);
+
   /**
    * Evaluate function gradient at position x-y-z and pass back vector.
    * You should generally not call this method directly, you should use
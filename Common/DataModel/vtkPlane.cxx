@@ -140,6 +140,20 @@ double vtkPlane::EvaluateFunction(double x[3])
     this->Normal[2] * (x[2] - this->Origin[2]));
 }
 
+//------------------------------------------------------------------------------
+// Evaluate plane equation for n points, the loop has no dependencies and
+// can be vectorized.
+void vtkPlane::EvaluateFunctionBatch(const double* points, double* values, vtkIdType n)
+{
+  const double n0 = this->Normal[0], n1 = this->Normal[1], n2 = this->Normal[2];
+  const double o0 = this->Origin[0], o1 = this->Origin[1], o2 = this->Origin[2];
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const double* x = points + 3 * i;
+    values[i] = n0 * (x[0] - o0) + n1 * (x[1] - o1) + n2 * (x[2] - o2);
+  }
+}
+
 //------------------------------------------------------------------------------
 // Evaluate function gradient at point x[3].
 void vtkPlane::EvaluateGradient(double vtkNotUsed(x)[3], double n[3])
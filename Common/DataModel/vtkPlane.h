@@ -37,6 +37,7 @@ public:
   using vtkImplicitFunction::EvaluateFunction;
   void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
   double EvaluateFunction(double x[3]) override;
+  void EvaluateFunctionBatch(const double* points, double* values, vtkIdType n) override;
   ///@}
 
   /**
@@ -6,6 +6,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellLinks.h"
+#include "vtkCellScratch.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
 #include "vtkInformation.h"
@@ -292,6 +293,15 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
 
   vtkCellArray* cells = this->GetCellArrayInternal(tag);
   const vtkIdType localCellId = tag.GetCellId();
+  if (cells->IsStorageCompressed())
+  {
+    // Visit() would expand the compressed storage.
+    vtkCellScratch::Frame frame;
+    vtkIdType npts;
+    const vtkIdType* pts = frame.GetCellPoints(cells, localCellId, npts);
+    vtkBoundingBox::ComputeBounds(this->Points, pts, npts, bounds);
+    return;
+  }
   cells->Visit(ComputeCellBoundsVisitor{}, this->Points, localCellId, bounds);
 }
 
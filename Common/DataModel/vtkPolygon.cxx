@@ -7,6 +7,7 @@
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
+#include "vtkCellScratch.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkIncrementalPointLocator.h"
@@ -502,8 +503,9 @@ void vtkPolygon::InterpolateFunctionsUsingMVC(const double x[3], double* weights
   }
 
   // create local array for storing point-to-vertex vectors and distances
-  std::vector<double> dist(numPts);
-  std::vector<double> uVec(3 * numPts);
+  vtkCellScratch::Frame frame;
+  double* dist = frame.Allocate<double>(numPts);
+  double* uVec = frame.Allocate<double>(3 * numPts);
   static const double eps = 0.00000001;
   for (int i = 0; i < numPts; i++)
   {
@@ -516,7 +518,7 @@ void vtkPolygon::InterpolateFunctionsUsingMVC(const double x[3], double* weights
     uVec[3 * i + 2] = pt[2] - x[2];
 
     // distance
-    dist[i] = vtkMath::Norm(uVec.data() + 3 * i);
+    dist[i] = vtkMath::Norm(uVec + 3 * i);
 
     // handle special case when the point is really close to a vertex
     if (dist[i] < eps)
@@ -535,7 +537,7 @@ void vtkPolygon::InterpolateFunctionsUsingMVC(const double x[3], double* weights
   // To do consider the simplification of
   // tan(alpha/2) = (1-cos(alpha))/sin(alpha)
   //              = (d0*d1 - cross(u0, u1))/(2*dot(u0,u1))
-  std::vector<double> tanHalfTheta(numPts);
+  double* tanHalfTheta = frame.Allocate<double>(numPts);
   for (int i = 0; i < numPts; i++)
   {
     int i1 = i + 1;
@@ -544,8 +546,8 @@ void vtkPolygon::InterpolateFunctionsUsingMVC(const double x[3], double* weights
       i1 = 0;
     }
 
-    double* u0 = uVec.data() + 3 * i;
-    double* u1 = uVec.data() + 3 * i1;
+    double* u0 = uVec + 3 * i;
+    double* u1 = uVec + 3 * i1;
 
     double l = sqrt(vtkMath::Distance2BetweenPoints(u0, u1));
     double theta = 2.0 * asin(l / 2.0);
@@ -1902,8 +1904,9 @@ int vtkPolygon::IntersectWithLine(const double p1[3], const double p2[3], double
 
   // Evaluate position
   //
-  std::vector<double> weights(npts);
-  if (this->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights.data()) >= 0)
+  vtkCellScratch::Frame frame;
+  double* weights = frame.Allocate<double>(npts);
+  if (this->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights) >= 0)
   {
     if (dist2 <= tol2)
     {
@@ -1973,8 +1976,9 @@ void vtkPolygon::Derivatives(
   }
 
   int numVerts = this->PointIds->GetNumberOfIds();
-  std::vector<double> weights(numVerts);
-  std::vector<double> sample(dim * 3);
+  vtkCellScratch::Frame frame;
+  double* weights = frame.Allocate<double>(numVerts);
+  double* sample = frame.Allocate<double>(dim * 3);
 
   // compute positions of three sample points
   for (i = 0; i < 3; i++)
@@ -1987,7 +1991,7 @@ void vtkPolygon::Derivatives(
   // for each sample point, sample data values
   for (idx = 0, k = 0; k < 3; k++) // loop over three sample points
   {
-    this->InterpolateFunctions(x[k], weights.data());
+    this->InterpolateFunctions(x[k], weights);
     for (j = 0; j < dim; j++, idx++) // over number of derivates requested
     {
       sample[idx] = 0.0;
@@ -6,6 +6,7 @@
 #include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
+#include "vtkCellScratch.h"
 #include "vtkEdgeTable.h"
 #include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
@@ -18,6 +19,7 @@
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkPolyhedronTopology.h"
 #include "vtkQuad.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
@@ -235,21 +237,11 @@ void vtkPolyhedron::ComputePositionFromParametricCoordinate(const double pc[3],
 // points, point ids, and faces have been loaded.
 void vtkPolyhedron::Initialize()
 {
-  // Clear out any remaining memory.
-  this->PointIdMap.clear();
-
   // Clear out any remaining memory.
   this->PointToIncidentFaces.clear();
 
-  // We need to create a reverse map from the point ids to their canonical cell
-  // ids. This is a fancy way of saying that we have to be able to rapidly go
-  // from a PointId[i] to the location i in the cell.
-  vtkIdType i, id, numPointIds = this->PointIds->GetNumberOfIds();
-  for (i = 0; i < numPointIds; ++i)
-  {
-    id = this->PointIds->GetId(i);
-    this->PointIdMap[id] = i;
-  }
+  // The map from the point ids to their canonical cell ids is built on demand.
+  this->PointIdMapGenerated = false;
 
   // Edges have to be reset
   this->EdgesGenerated = 0;
@@ -272,6 +264,43 @@ void vtkPolyhedron::Initialize()
   this->LocatorConstructed = 0;
 }
 
+//------------------------------------------------------------------------------
+// We need a reverse map from the point ids to their canonical cell ids. This
+// is a fancy way of saying that we have to be able to rapidly go from a
+// PointId[i] to the location i in the cell.
+void vtkPolyhedron::GeneratePointIdMap()
+{
+  if (this->PointIdMapGenerated)
+  {
+    return;
+  }
+
+  this->PointIdMap.clear();
+  vtkIdType i, id, numPointIds = this->PointIds->GetNumberOfIds();
+  for (i = 0; i < numPointIds; ++i)
+  {
+    id = this->PointIds->GetId(i);
+    this->PointIdMap[id] = i;
+  }
+  this->PointIdMapGenerated = true;
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyhedron::SetTopology(vtkPolyhedronTopology* topology, vtkIdType cellId)
+{
+  if (topology && !topology->HasCell(cellId))
+  {
+    topology = nullptr;
+  }
+  // Avoid touching the reference count when the cells of the same grid are
+  // loaded in turn.
+  if (this->Topology != topology)
+  {
+    this->Topology = topology;
+  }
+  this->TopologyCellId = topology ? cellId : -1;
+}
+
 //------------------------------------------------------------------------------
 int vtkPolyhedron::GetNumberOfEdges()
 {
@@ -330,6 +359,21 @@ int vtkPolyhedron::GenerateEdges()
     return 0;
   }
 
+  // The edges are precomputed
+  if (this->Topology)
+  {
+    const vtkIdType numEdges = this->Topology->GetNumberOfEdges(this->TopologyCellId);
+    this->Edges->SetNumberOfTuples(numEdges);
+    this->EdgeFaces->SetNumberOfTuples(numEdges);
+    std::copy_n(this->Topology->GetEdges(this->TopologyCellId), 2 * numEdges,
+      this->Edges->GetPointer(0));
+    std::copy_n(this->Topology->GetEdgeFaces(this->TopologyCellId), 2 * numEdges,
+      this->EdgeFaces->GetPointer(0));
+    this->EdgesGenerated = 1;
+    return numEdges;
+  }
+
+  this->GeneratePointIdMap();
   vtkNew<vtkIdList> tmpface;
   vtkIdType nfaces = 0;
   const vtkIdType* face;
@@ -395,8 +439,24 @@ void vtkPolyhedron::GenerateFaces()
     return;
   }
 
+  // The faces are precomputed in canonical ids
+  if (this->Topology)
+  {
+    const vtkIdType nfaces = this->Topology->GetNumberOfFaces(this->TopologyCellId);
+    this->Faces->Reset();
+    for (vtkIdType fid = 0; fid < nfaces; ++fid)
+    {
+      vtkIdType npts;
+      const vtkIdType* face = this->Topology->GetFace(this->TopologyCellId, fid, npts);
+      this->Faces->InsertNextCell(npts, face);
+    }
+    this->FacesGenerated = 1;
+    return;
+  }
+
   // Basically we just run through the faces and change the global ids to the
   // canonical ids using the PointIdMap.
+  this->GeneratePointIdMap();
   this->Faces->DeepCopy(this->GlobalFaces);
   vtkIdType numConn = this->Faces->GetNumberOfConnectivityIds();
 
@@ -438,6 +498,17 @@ vtkCell* vtkPolyhedron::GetFace(int faceId)
   this->Polygon->Points->SetNumberOfPoints(numPts);
 
   // grab faces in global id space
+  if (this->Topology)
+  {
+    vtkIdType npts;
+    const vtkIdType* face = this->Topology->GetFace(this->TopologyCellId, faceId, npts);
+    for (i = 0; i < numPts; ++i)
+    {
+      this->Polygon->Points->SetPoint(i, this->Points->GetPoint(face[i]));
+    }
+    return this->Polygon;
+  }
+  this->GeneratePointIdMap();
   for (i = 0; i < numPts; ++i)
   {
     vtkIdType pid = this->Polygon->PointIds->GetId(i);
@@ -453,6 +524,7 @@ vtkCell* vtkPolyhedron::GetFace(int faceId)
 void vtkPolyhedron::SetFaces(vtkIdType* faces)
 {
   // Set up face structure
+  this->SetTopology(nullptr, -1);
   this->GlobalFaces->Reset();
 
   if (!faces)
@@ -479,6 +551,7 @@ void vtkPolyhedron::SetFaces(vtkIdType* faces)
 int vtkPolyhedron::SetCellFaces(vtkCellArray* faces)
 {
   // Set up face structure
+  this->SetTopology(nullptr, -1);
   this->GlobalFaces->Reset();
 
   if (!faces)
@@ -515,6 +588,8 @@ vtkIdType* vtkPolyhedron::GetFaces()
 
 vtkCellArray* vtkPolyhedron::GetCellFaces()
 {
+  // The faces may be modified through the returned array
+  this->SetTopology(nullptr, -1);
   return this->GlobalFaces;
 }
 
@@ -768,7 +843,7 @@ bool vtkPolyhedron::IsConvex()
 {
   double x[2][3], n[3], c[3], c0[3], c1[3], c0p[3], c1p[3], n0[3], n1[3];
   double np[3], tmp0, tmp1;
-  vtkIdType i, w[2], edgeId, edgeFaces[2], v, r = 0;
+  vtkIdType i, w[2], edgeId, numEdges, edgeFaces[2], v, r = 0;
   vtkIdType numPts;
   vtkNew<vtkIdList> face_tmp;
   const vtkIdType* face;
@@ -784,9 +859,11 @@ bool vtkPolyhedron::IsConvex()
   this->ComputeBounds();
 
   // loop over all edges in the polyhedron
-  this->EdgeTable->InitTraversal();
-  while ((edgeId = this->EdgeTable->GetNextEdge(w[0], w[1])) >= 0)
+  numEdges = this->Edges->GetNumberOfTuples();
+  for (edgeId = 0; edgeId < numEdges; ++edgeId)
   {
+    this->Edges->GetTypedTuple(edgeId, w);
+
     // get the edge points
     this->Points->GetPoint(w[0], x[0]);
     this->Points->GetPoint(w[1], x[1]);
@@ -986,6 +1063,11 @@ int vtkPolyhedron::CellBoundary(int vtkNotUsed(subId), const double pcoords[3],
   }
 }
 
+//------------------------------------------------------------------------------
+// Polyhedra bound to a precomputed topology with at most this many faces find
+// the closest point without a locator
+static const int VTK_MAX_FACES_WITHOUT_LOCATOR = 25;
+
 //------------------------------------------------------------------------------
 int vtkPolyhedron::EvaluatePosition(const double x[3], double closestPoint[3],
   int& vtkNotUsed(subId), double pcoords[3], double& minDist2, double weights[])
@@ -997,15 +1079,42 @@ int vtkPolyhedron::EvaluatePosition(const double x[3], double closestPoint[3],
   // the cell array is stored in this->Faces
   this->ConstructPolyData();
 
-  // Construct cell locator
-  this->ConstructLocator();
-
   // find closest point and store the squared distance
-  vtkIdType cellId;
-  int id;
   double cp[3];
-  this->Cell->Initialize();
-  this->CellLocator->FindClosestPoint(x, cp, this->Cell, cellId, id, minDist2);
+  const vtkIdType numFaces = this->GetNumberOfFaces();
+  if (this->Topology && numFaces <= VTK_MAX_FACES_WITHOUT_LOCATOR)
+  {
+    // With a precomputed topology, building a locator costs more than
+    // visiting the faces of a small polyhedron, which is the common case when
+    // the cells of a grid are probed one at a time.
+    int subId;
+    double faceCp[3], facePcoords[3], dist2;
+    minDist2 = VTK_DOUBLE_MAX;
+    for (vtkIdType faceId = 0; faceId < numFaces; ++faceId)
+    {
+      vtkCell* face = this->GetFace(faceId);
+      this->FaceWeights.resize(face->GetNumberOfPoints());
+      if (face->EvaluatePosition(
+            x, faceCp, subId, facePcoords, dist2, this->FaceWeights.data()) != -1 &&
+        dist2 < minDist2)
+      {
+        minDist2 = dist2;
+        cp[0] = faceCp[0];
+        cp[1] = faceCp[1];
+        cp[2] = faceCp[2];
+      }
+    }
+  }
+  else
+  {
+    // Construct cell locator
+    this->ConstructLocator();
+
+    vtkIdType cellId;
+    int id;
+    this->Cell->Initialize();
+    this->CellLocator->FindClosestPoint(x, cp, this->Cell, cellId, id, minDist2);
+  }
 
   if (closestPoint)
   {
@@ -1075,8 +1184,9 @@ void vtkPolyhedron::Derivatives(
   this->ConstructPolyData();
   int numVerts = this->PolyData->GetNumberOfPoints();
 
-  double* weights = new double[numVerts];
-  double* sample = new double[dim * 4];
+  vtkCellScratch::Frame frame;
+  double* weights = frame.Allocate<double>(numVerts);
+  double* sample = frame.Allocate<double>(dim * 4);
   // for each sample point, sample data values
   for (idx = 0, k = 0; k < 4; k++) // loop over three sample points
   {
@@ -1117,9 +1227,6 @@ void vtkPolyhedron::Derivatives(
     derivs[3 * j + 1] = ddx * v1[1] + ddy * v2[1] + ddz * v3[1];
     derivs[3 * j + 2] = ddx * v1[2] + ddy * v2[2] + ddz * v3[2];
   }
-
-  delete[] weights;
-  delete[] sample;
 }
 
 //------------------------------------------------------------------------------
@@ -1185,6 +1292,25 @@ int vtkPolyhedron::TriangulateLocalIds(int vtkNotUsed(index), vtkIdList* ptIds)
 int vtkPolyhedron::TriangulateFaces(vtkIdList* newFaces)
 {
   newFaces->Initialize();
+
+  // The triangulation is precomputed
+  if (this->Topology)
+  {
+    const vtkIdType nbOfTriangles = this->Topology->GetNumberOfTriangles(this->TopologyCellId);
+    const vtkIdType* triangles = this->Topology->GetTriangles(this->TopologyCellId);
+    newFaces->SetNumberOfIds(1 + 4 * nbOfTriangles);
+    newFaces->SetId(0, nbOfTriangles);
+    for (vtkIdType i = 0; i < nbOfTriangles; i++)
+    {
+      newFaces->SetId(1 + 4 * i, 3); // Number of points
+      for (vtkIdType j = 0; j < 3; j++)
+      {
+        newFaces->SetId(2 + 4 * i + j, this->PointIds->GetId(triangles[3 * i + j]));
+      }
+    }
+    return 1;
+  }
+
   newFaces->InsertNextId(0); // Keep room for the total nb of faces
   vtkIdType totalNbOfFaces = 0;
 
@@ -1233,6 +1359,23 @@ int vtkPolyhedron::TriangulateFaces(vtkCellArray* newFaces)
 {
   newFaces->Initialize();
 
+  // The triangulation is precomputed
+  if (this->Topology)
+  {
+    const vtkIdType nbOfTriangles = this->Topology->GetNumberOfTriangles(this->TopologyCellId);
+    const vtkIdType* triangles = this->Topology->GetTriangles(this->TopologyCellId);
+    newFaces->AllocateExact(nbOfTriangles, 3 * nbOfTriangles);
+    for (vtkIdType i = 0; i < nbOfTriangles; i++)
+    {
+      newFaces->InsertNextCell(3); // Number of points
+      for (vtkIdType j = 0; j < 3; j++)
+      {
+        newFaces->InsertCellPoint(this->PointIds->GetId(triangles[3 * i + j]));
+      }
+    }
+    return 1;
+  }
+
   for (vtkIdType faceId = 0; faceId < this->GetNumberOfFaces(); ++faceId)
   {
     vtkCell* face = this->GetFace(faceId);
@@ -1272,6 +1415,8 @@ int vtkPolyhedron::TriangulateFaces(vtkCellArray* newFaces)
 //------------------------------------------------------------------------------
 void vtkPolyhedron::GeneratePointToIncidentFaces()
 {
+  this->GeneratePointIdMap();
+
   // Allocate memory
   this->PointToIncidentFaces.clear();
   this->PointToIncidentFaces.resize(this->GetNumberOfPoints());
@@ -1945,6 +2090,7 @@ void vtkPolyhedron::Contour(double value, vtkDataArray* pointScalars,
   EdgeSet originalEdges;
   std::vector<std::vector<vtkIdType>> oririginalFaceTriFaceMap;
 
+  this->GeneratePointIdMap();
   if (!GetContourPoints(value, this, this->PointIdMap, faceEdgesVector, edgeFaceMap, originalEdges,
         oririginalFaceTriFaceMap, contourPointEdgeMultiMap, edgeContourPointMap, pointLocationMap,
         locator, pointScalars, inPd, outPd))
@@ -2277,6 +2423,7 @@ void vtkPolyhedron::Clip(double value, vtkDataArray* pointScalars,
   };
 
   bool all(true);
+  this->GeneratePointIdMap();
 
   // check if polyhedron is all in
   bool intersect = IntersectWithContour(this, pointScalars, this->PointIdMap, value, c, all);
@@ -2508,6 +2655,8 @@ void vtkPolyhedron::ShallowCopy(vtkCell* c)
   if (cell)
   {
     this->GlobalFaces->ShallowCopy(cell->GlobalFaces);
+    // The precomputed topology is read-only, it can be shared
+    this->SetTopology(cell->Topology, cell->TopologyCellId);
     this->Initialize();
   }
 }
@@ -2521,6 +2670,8 @@ void vtkPolyhedron::DeepCopy(vtkCell* c)
   if (cell)
   {
     this->GlobalFaces->DeepCopy(cell->GlobalFaces);
+    // The precomputed topology is read-only, it can be shared
+    this->SetTopology(cell->Topology, cell->TopologyCellId);
     this->Initialize();
   }
 }
@@ -98,6 +98,15 @@
  * is adjacent to exactly two faces and will definitely lead to bad results (and generate numerous
  * warnings) if this criterion is not fulfilled.
  *
+ * @section Topology Precomputed topology
+ *
+ * Building the faces and edges of a polyhedron in its canonical numbering is
+ * done each time the cell is initialized. To avoid this cost when the cells of
+ * a vtkUnstructuredGrid are visited repeatedly, use
+ * vtkUnstructuredGrid::BuildPolyhedronTopology(): vtkUnstructuredGrid::GetCell()
+ * then binds the polyhedron to the precomputed vtkPolyhedronTopology of the
+ * cell, from which the faces, edges and face triangulation are read.
+ *
  * @section Limitations Limitations
  *
  * The class does not require the polyhedron to be convex. However, the support of concave
@@ -115,6 +124,7 @@
  *
  * @sa
  * vtkCell3D vtkConvexPointSet vtkMeanValueCoordinatesInterpolator vtkPolyhedronUtilities
+ * vtkPolyhedronTopology
  */
 
 #ifndef vtkPolyhedron_h
@@ -124,6 +134,7 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkDeprecation.h"           // For VTK_DEPRECATED
 #include "vtkNew.h"                   // For vtkNew
+#include "vtkSmartPointer.h"          // For vtkSmartPointer
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkIdTypeArray;
@@ -139,6 +150,7 @@ class vtkCellLocator;
 class vtkGenericCell;
 class vtkPointLocator;
 class vtkMinimalStandardRandomSequence;
+class vtkPolyhedronTopology;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkPolyhedron : public vtkCell3D
 {
@@ -430,6 +442,17 @@ public:
    */
   bool IsConvex();
 
+  /**
+   * Bind the polyhedron to the precomputed topology of the cell cellId of a
+   * vtkUnstructuredGrid, so that its faces, edges and face triangulation are
+   * read from the topology instead of being computed. This is done by
+   * vtkUnstructuredGrid::GetCell(), after the points, point ids and faces of
+   * the cell are loaded and before Initialize() is called. Setting the faces
+   * of the polyhedron, or accessing them with GetCellFaces(), unbinds it. Pass
+   * nullptr to unbind it explicitly.
+   */
+  void SetTopology(vtkPolyhedronTopology* topology, vtkIdType cellId);
+
   /**
    * Construct polydata if no one exist, then return this->PolyData
    */
@@ -497,6 +520,11 @@ protected:
   void ConstructLocator();
   vtkNew<vtkIdList> CellIds;
   vtkNew<vtkGenericCell> Cell;
+  std::vector<double> FaceWeights; // scratch for EvaluatePosition() on the faces
+
+  // The precomputed topology this polyhedron is bound to, if any.
+  vtkSmartPointer<vtkPolyhedronTopology> Topology;
+  vtkIdType TopologyCellId = -1;
 
 private:
   vtkPolyhedron(const vtkPolyhedron&) = delete;
@@ -507,9 +535,11 @@ private:
   // vtkCell has the data members Points (x,y,z coordinates) and PointIds (global cell ids).
   // These data members are implicitly organized in canonical space, i.e., where the cell
   // point ids are (0,1,...,npts-1).
-  // The PointIdMap is constructed during the call of the Initialize() method and maps global
-  // point ids to the canonical point ids.
+  // The PointIdMap is constructed on demand by GeneratePointIdMap() and maps global point
+  // ids to the canonical point ids.
   vtkPointIdMap PointIdMap;
+  bool PointIdMapGenerated = false;
+  void GeneratePointIdMap();
 
   void GeneratePointToIncidentFaces();
 
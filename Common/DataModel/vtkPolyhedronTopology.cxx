@@ -0,0 +1,349 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPolyhedronTopology.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkPolyhedronTopology);
+
+namespace
+{
+// The topology of the cells processed by one thread, concatenated.
+struct LocalTopology
+{
+  std::vector<vtkIdType> CellIds;
+  std::vector<vtkIdType> FaceSizes;
+  std::vector<vtkIdType> FaceConnectivity;
+  std::vector<vtkIdType> Edges;
+  std::vector<vtkIdType> EdgeFaces;
+  std::vector<vtkIdType> Triangles;
+
+  // Scratch objects
+  vtkSmartPointer<vtkIdList> CellPoints;
+  vtkSmartPointer<vtkIdList> FacePoints;
+  vtkSmartPointer<vtkCellArray> CellFaces;
+  vtkSmartPointer<vtkPolygon> Polygon;
+  vtkSmartPointer<vtkIdList> TriangleIds;
+  std::vector<std::pair<vtkIdType, vtkIdType>> PointIdMap;
+  std::unordered_map<vtkIdType, vtkIdType> EdgeMap;
+  std::vector<vtkIdType> Face;
+};
+
+struct BuildWorker
+{
+  vtkUnstructuredGrid* Grid;
+  vtkPoints* Points;
+  vtkIdType* NumberOfFaces;
+  vtkIdType* NumberOfFacePoints;
+  vtkIdType* NumberOfEdges;
+  vtkIdType* NumberOfTriangles;
+  vtkSMPThreadLocal<LocalTopology> Locals;
+
+  void Initialize()
+  {
+    LocalTopology& local = this->Locals.Local();
+    local.CellPoints = vtkSmartPointer<vtkIdList>::New();
+    local.FacePoints = vtkSmartPointer<vtkIdList>::New();
+    local.CellFaces = vtkSmartPointer<vtkCellArray>::New();
+    local.Polygon = vtkSmartPointer<vtkPolygon>::New();
+    local.TriangleIds = vtkSmartPointer<vtkIdList>::New();
+  }
+
+  // Same mapping as vtkPolyhedron::PointIdMap: the last occurrence of a
+  // global id wins, and unknown ids map to 0.
+  static vtkIdType ToCanonical(const LocalTopology& local, vtkIdType id)
+  {
+    auto it = std::upper_bound(local.PointIdMap.begin(), local.PointIdMap.end(),
+      std::make_pair(id, VTK_ID_MAX));
+    if (it == local.PointIdMap.begin() || (--it)->first != id)
+    {
+      return 0;
+    }
+    return it->second;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalTopology& local = this->Locals.Local();
+    vtkCellArray* cells = this->Grid->GetCells();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->NumberOfFaces[cellId] = 0;
+      this->NumberOfFacePoints[cellId] = 0;
+      this->NumberOfEdges[cellId] = 0;
+      this->NumberOfTriangles[cellId] = 0;
+      if (this->Grid->GetCellType(cellId) != VTK_POLYHEDRON)
+      {
+        continue;
+      }
+      this->Grid->GetPolyhedronFaces(cellId, local.CellFaces);
+      const vtkIdType nfaces = local.CellFaces->GetNumberOfCells();
+      if (nfaces == 0)
+      {
+        continue;
+      }
+
+      vtkIdType npts;
+      const vtkIdType* pts;
+      cells->GetCellAtId(cellId, npts, pts, local.CellPoints);
+      local.PointIdMap.resize(npts);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        local.PointIdMap[i] = std::make_pair(pts[i], i);
+      }
+      std::sort(local.PointIdMap.begin(), local.PointIdMap.end());
+
+      local.CellIds.push_back(cellId);
+      local.EdgeMap.clear();
+      const vtkIdType firstEdge = static_cast<vtkIdType>(local.EdgeFaces.size()) / 2;
+      const vtkIdType firstTriangle = static_cast<vtkIdType>(local.Triangles.size()) / 3;
+      vtkIdType numFacePoints = 0;
+      for (vtkIdType fid = 0; fid < nfaces; ++fid)
+      {
+        vtkIdType nfpts;
+        const vtkIdType* face;
+        local.CellFaces->GetCellAtId(fid, nfpts, face, local.FacePoints);
+        numFacePoints += nfpts;
+        local.FaceSizes.push_back(nfpts);
+        local.Face.resize(nfpts);
+        for (vtkIdType i = 0; i < nfpts; ++i)
+        {
+          local.Face[i] = ToCanonical(local, face[i]);
+          local.FaceConnectivity.push_back(local.Face[i]);
+        }
+
+        // The edges, in the order vtkPolyhedron::GenerateEdges() finds them.
+        for (vtkIdType i = 0; i < nfpts; ++i)
+        {
+          const vtkIdType e0 = local.Face[i];
+          const vtkIdType e1 = local.Face[(i + 1) != nfpts ? i + 1 : 0];
+          const vtkIdType key = std::min(e0, e1) * npts + std::max(e0, e1);
+          auto inserted = local.EdgeMap.insert(
+            std::make_pair(key, static_cast<vtkIdType>(local.EdgeFaces.size()) / 2));
+          if (inserted.second)
+          {
+            local.Edges.push_back(e0);
+            local.Edges.push_back(e1);
+            local.EdgeFaces.push_back(fid);
+            local.EdgeFaces.push_back(-1);
+          }
+          else
+          {
+            local.EdgeFaces[2 * inserted.first->second + 1] = fid;
+          }
+        }
+
+        // The triangulation vtkPolyhedron::TriangulateFaces() computes.
+        vtkPolygon* polygon = local.Polygon;
+        polygon->PointIds->SetNumberOfIds(nfpts);
+        polygon->Points->SetNumberOfPoints(nfpts);
+        for (vtkIdType i = 0; i < nfpts; ++i)
+        {
+          polygon->PointIds->SetId(i, face[i]);
+          polygon->Points->SetPoint(i, this->Points->GetPoint(pts[local.Face[i]]));
+        }
+        local.TriangleIds->Reset();
+        polygon->TriangulateLocalIds(0, local.TriangleIds);
+        const vtkIdType numTriangleIds = local.TriangleIds->GetNumberOfIds() / 3 * 3;
+        for (vtkIdType i = 0; i < numTriangleIds; ++i)
+        {
+          local.Triangles.push_back(local.Face[local.TriangleIds->GetId(i)]);
+        }
+      }
+      this->NumberOfFaces[cellId] = nfaces;
+      this->NumberOfFacePoints[cellId] = numFacePoints;
+      this->NumberOfEdges[cellId] = static_cast<vtkIdType>(local.EdgeFaces.size()) / 2 - firstEdge;
+      this->NumberOfTriangles[cellId] =
+        static_cast<vtkIdType>(local.Triangles.size()) / 3 - firstTriangle;
+    }
+  }
+
+  void Reduce() {}
+};
+}
+
+//------------------------------------------------------------------------------
+vtkPolyhedronTopology::vtkPolyhedronTopology()
+{
+  this->Points = nullptr;
+  this->Cells = nullptr;
+  this->Faces = nullptr;
+  this->FaceLocations = nullptr;
+  this->PointsMTime = 0;
+  this->CellsMTime = 0;
+  this->FacesMTime = 0;
+  this->FaceLocationsMTime = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkPolyhedronTopology::~vtkPolyhedronTopology() = default;
+
+//------------------------------------------------------------------------------
+void vtkPolyhedronTopology::Initialize()
+{
+  this->CellFaceOffsets.clear();
+  this->CellEdgeOffsets.clear();
+  this->CellTriangleOffsets.clear();
+  this->FaceOffsets.clear();
+  this->FaceConnectivity.clear();
+  this->Edges.clear();
+  this->EdgeFaces.clear();
+  this->Triangles.clear();
+  this->Points = nullptr;
+  this->Cells = nullptr;
+  this->Faces = nullptr;
+  this->FaceLocations = nullptr;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyhedronTopology::Build(vtkUnstructuredGrid* grid)
+{
+  this->Initialize();
+  if (!grid || !grid->GetPoints() || !grid->GetCells())
+  {
+    return;
+  }
+
+  const vtkIdType numCells = grid->GetNumberOfCells();
+  this->CellFaceOffsets.assign(numCells + 1, 0);
+  this->CellEdgeOffsets.assign(numCells + 1, 0);
+  this->CellTriangleOffsets.assign(numCells + 1, 0);
+  this->FaceOffsets.assign(1, 0);
+  std::vector<vtkIdType> numFacePoints(numCells + 1, 0);
+
+  if (grid->GetPolyhedronFaces() && grid->GetPolyhedronFaceLocations())
+  {
+    // Compute the topology of each cell, and the number of faces, edges and
+    // triangles of each cell. The counts are stored shifted by one, so that
+    // an inclusive scan turns them into offsets.
+    BuildWorker worker;
+    worker.Grid = grid;
+    worker.Points = grid->GetPoints();
+    worker.NumberOfFaces = this->CellFaceOffsets.data() + 1;
+    worker.NumberOfFacePoints = numFacePoints.data() + 1;
+    worker.NumberOfEdges = this->CellEdgeOffsets.data() + 1;
+    worker.NumberOfTriangles = this->CellTriangleOffsets.data() + 1;
+    vtkSMPTools::For(0, numCells, worker);
+
+    std::partial_sum(
+      this->CellFaceOffsets.begin(), this->CellFaceOffsets.end(), this->CellFaceOffsets.begin());
+    std::partial_sum(numFacePoints.begin(), numFacePoints.end(), numFacePoints.begin());
+    std::partial_sum(
+      this->CellEdgeOffsets.begin(), this->CellEdgeOffsets.end(), this->CellEdgeOffsets.begin());
+    std::partial_sum(this->CellTriangleOffsets.begin(), this->CellTriangleOffsets.end(),
+      this->CellTriangleOffsets.begin());
+
+    this->FaceOffsets.resize(this->CellFaceOffsets[numCells] + 1);
+    this->FaceConnectivity.resize(numFacePoints[numCells]);
+    this->Edges.resize(2 * this->CellEdgeOffsets[numCells]);
+    this->EdgeFaces.resize(2 * this->CellEdgeOffsets[numCells]);
+    this->Triangles.resize(3 * this->CellTriangleOffsets[numCells]);
+
+    // Scatter the topology of the cells computed by each thread.
+    std::vector<LocalTopology*> locals;
+    for (LocalTopology& local : worker.Locals)
+    {
+      locals.push_back(&local);
+    }
+    vtkSMPTools::For(0, static_cast<vtkIdType>(locals.size()), 1,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType l = begin; l < end; ++l)
+        {
+          const LocalTopology& local = *locals[l];
+          vtkIdType face = 0, faceConn = 0, edge = 0, triangle = 0;
+          for (vtkIdType cellId : local.CellIds)
+          {
+            vtkIdType offset = this->CellFaceOffsets[cellId];
+            vtkIdType connOffset = numFacePoints[cellId];
+            for (vtkIdType f = offset; f < this->CellFaceOffsets[cellId + 1]; ++f)
+            {
+              this->FaceOffsets[f] = connOffset;
+              connOffset += local.FaceSizes[face++];
+            }
+            std::copy(local.FaceConnectivity.begin() + faceConn,
+              local.FaceConnectivity.begin() + faceConn + connOffset - numFacePoints[cellId],
+              this->FaceConnectivity.begin() + numFacePoints[cellId]);
+            faceConn += connOffset - numFacePoints[cellId];
+
+            const vtkIdType numEdges = this->GetNumberOfEdges(cellId);
+            std::copy(local.Edges.begin() + 2 * edge, local.Edges.begin() + 2 * (edge + numEdges),
+              this->Edges.begin() + 2 * this->CellEdgeOffsets[cellId]);
+            std::copy(local.EdgeFaces.begin() + 2 * edge,
+              local.EdgeFaces.begin() + 2 * (edge + numEdges),
+              this->EdgeFaces.begin() + 2 * this->CellEdgeOffsets[cellId]);
+            edge += numEdges;
+
+            const vtkIdType numTriangles = this->GetNumberOfTriangles(cellId);
+            std::copy(local.Triangles.begin() + 3 * triangle,
+              local.Triangles.begin() + 3 * (triangle + numTriangles),
+              this->Triangles.begin() + 3 * this->CellTriangleOffsets[cellId]);
+            triangle += numTriangles;
+          }
+        }
+      });
+    this->FaceOffsets.back() = numFacePoints[numCells];
+  }
+
+  this->Points = grid->GetPoints();
+  this->Cells = grid->GetCells();
+  this->Faces = grid->GetPolyhedronFaces();
+  this->FaceLocations = grid->GetPolyhedronFaceLocations();
+  this->PointsMTime = grid->GetPoints()->GetMTime();
+  this->CellsMTime = grid->GetCells()->GetMTime();
+  this->FacesMTime = this->Faces ? grid->GetPolyhedronFaces()->GetMTime() : 0;
+  this->FaceLocationsMTime =
+    this->FaceLocations ? grid->GetPolyhedronFaceLocations()->GetMTime() : 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkPolyhedronTopology::IsUpToDate(vtkUnstructuredGrid* grid)
+{
+  vtkPoints* points = grid->GetPoints();
+  vtkCellArray* cells = grid->GetCells();
+  vtkCellArray* faces = grid->GetPolyhedronFaces();
+  vtkCellArray* faceLocations = grid->GetPolyhedronFaceLocations();
+  return points && points == this->Points && cells == this->Cells && faces == this->Faces &&
+    faceLocations == this->FaceLocations && points->GetMTime() == this->PointsMTime &&
+    cells->GetMTime() == this->CellsMTime && (!faces || faces->GetMTime() == this->FacesMTime) &&
+    (!faceLocations || faceLocations->GetMTime() == this->FaceLocationsMTime);
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkPolyhedronTopology::GetActualMemorySize()
+{
+  const size_t size = this->CellFaceOffsets.capacity() + this->CellEdgeOffsets.capacity() +
+    this->CellTriangleOffsets.capacity() + this->FaceOffsets.capacity() +
+    this->FaceConnectivity.capacity() + this->Edges.capacity() + this->EdgeFaces.capacity() +
+    this->Triangles.capacity();
+  return static_cast<unsigned long>(size * sizeof(vtkIdType) / 1024);
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyhedronTopology::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Cells: " << this->GetNumberOfCells() << "\n";
+  os << indent << "Number Of Faces: "
+     << (this->FaceOffsets.empty() ? 0 : this->FaceOffsets.size() - 1) << "\n";
+  os << indent << "Number Of Edges: " << (this->Edges.size() / 2) << "\n";
+  os << indent << "Number Of Triangles: " << (this->Triangles.size() / 3) << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPolyhedronTopology
+ * @brief   precomputed topology of the polyhedral cells of an unstructured grid
+ *
+ * vtkPolyhedronTopology stores, for every polyhedral cell of a
+ * vtkUnstructuredGrid, the structures that vtkPolyhedron otherwise rebuilds
+ * each time a cell is loaded:
+ * - the faces, with their point ids in the canonical (cell local) numbering,
+ * - the edges, in canonical numbering, with the two faces sharing each edge,
+ * - the triangulation of the faces, in canonical numbering.
+ *
+ * The data is stored in a few flat arrays indexed by cell id, and is built in
+ * parallel with vtkSMPTools. Once built, it is read-only and can be shared
+ * by the threads loading cells from the grid, and by the shallow copies of
+ * the grid. vtkPolyhedron binds to the topology of the cell it represents
+ * when it is loaded by vtkUnstructuredGrid::GetCell(), and then reads its
+ * faces and edges from it instead of computing them.
+ *
+ * The face triangulation depends on the point coordinates, so the topology
+ * is out of date when the points, the cells or the faces of the grid are
+ * modified. Use vtkUnstructuredGrid::BuildPolyhedronTopology() to build the
+ * topology of a grid.
+ *
+ * @sa
+ * vtkPolyhedron vtkUnstructuredGrid
+ */
+
+#ifndef vtkPolyhedronTopology_h
+#define vtkPolyhedronTopology_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <vector> // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkUnstructuredGrid;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkPolyhedronTopology : public vtkObject
+{
+public:
+  static vtkPolyhedronTopology* New();
+  vtkTypeMacro(vtkPolyhedronTopology, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Build the topology of the polyhedral cells of the grid.
+   */
+  void Build(vtkUnstructuredGrid* grid);
+
+  /**
+   * Return true if the topology was built from the grid, and neither the
+   * points, the cells nor the faces of the grid were modified since.
+   */
+  bool IsUpToDate(vtkUnstructuredGrid* grid);
+
+  /**
+   * Free the memory and return to the initial state.
+   */
+  void Initialize();
+
+  /**
+   * Return the number of cells of the grid the topology was built from.
+   */
+  vtkIdType GetNumberOfCells() const
+  {
+    return this->CellFaceOffsets.empty()
+      ? 0
+      : static_cast<vtkIdType>(this->CellFaceOffsets.size()) - 1;
+  }
+
+  /**
+   * Return true if the topology of the given cell is available, i.e. if it
+   * is a polyhedral cell of the grid.
+   */
+  bool HasCell(vtkIdType cellId) const
+  {
+    return cellId >= 0 && cellId < this->GetNumberOfCells() &&
+      this->CellFaceOffsets[cellId + 1] > this->CellFaceOffsets[cellId];
+  }
+
+  ///@{
+  /**
+   * Access the faces of a cell. The point ids of the faces are in the
+   * canonical numbering of the cell.
+   */
+  vtkIdType GetNumberOfFaces(vtkIdType cellId) const
+  {
+    return this->CellFaceOffsets[cellId + 1] - this->CellFaceOffsets[cellId];
+  }
+  const vtkIdType* GetFace(vtkIdType cellId, vtkIdType faceId, vtkIdType& npts) const
+  {
+    const vtkIdType face = this->CellFaceOffsets[cellId] + faceId;
+    npts = this->FaceOffsets[face + 1] - this->FaceOffsets[face];
+    return this->FaceConnectivity.data() + this->FaceOffsets[face];
+  }
+  ///@}
+
+  ///@{
+  /**
+   * Access the edges of a cell: two point ids in canonical numbering per
+   * edge, and the ids of the two faces using each edge (the second one is -1
+   * for an edge used by a single face).
+   */
+  vtkIdType GetNumberOfEdges(vtkIdType cellId) const
+  {
+    return this->CellEdgeOffsets[cellId + 1] - this->CellEdgeOffsets[cellId];
+  }
+  const vtkIdType* GetEdges(vtkIdType cellId) const
+  {
+    return this->Edges.data() + 2 * this->CellEdgeOffsets[cellId];
+  }
+  const vtkIdType* GetEdgeFaces(vtkIdType cellId) const
+  {
+    return this->EdgeFaces.data() + 2 * this->CellEdgeOffsets[cellId];
+  }
+  ///@}
+
+  ///@{
+  /**
+   * Access the triangulation of the faces of a cell: three point ids in
+   * canonical numbering per triangle.
+   */
+  vtkIdType GetNumberOfTriangles(vtkIdType cellId) const
+  {
+    return this->CellTriangleOffsets[cellId + 1] - this->CellTriangleOffsets[cellId];
+  }
+  const vtkIdType* GetTriangles(vtkIdType cellId) const
+  {
+    return this->Triangles.data() + 3 * this->CellTriangleOffsets[cellId];
+  }
+  ///@}
+
+  /**
+   * Return the memory used by the topology in kibibytes.
+   */
+  unsigned long GetActualMemorySize();
+
+protected:
+  vtkPolyhedronTopology();
+  ~vtkPolyhedronTopology() override;
+
+  // Offsets of the faces, edges and triangles of each cell (one more than
+  // the number of cells).
+  std::vector<vtkIdType> CellFaceOffsets;
+  std::vector<vtkIdType> CellEdgeOffsets;
+  std::vector<vtkIdType> CellTriangleOffsets;
+
+  // Offsets of each face in FaceConnectivity (one more than the number of
+  // faces).
+  std::vector<vtkIdType> FaceOffsets;
+  std::vector<vtkIdType> FaceConnectivity;
+  std::vector<vtkIdType> Edges;
+  std::vector<vtkIdType> EdgeFaces;
+  std::vector<vtkIdType> Triangles;
+
+  // What the topology was built from, to detect modifications.
+  const void* Points;
+  const void* Cells;
+  const void* Faces;
+  const void* FaceLocations;
+  vtkMTimeType PointsMTime;
+  vtkMTimeType CellsMTime;
+  vtkMTimeType FacesMTime;
+  vtkMTimeType FaceLocationsMTime;
+
+private:
+  vtkPolyhedronTopology(const vtkPolyhedronTopology&) = delete;
+  void operator=(const vtkPolyhedronTopology&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -148,6 +148,7 @@ vtkSmartPointer<vtkUnstructuredGrid> vtkPolyhedronUtilities::Decompose(
   typedef vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::AllTypes> Dispatcher;
   typedef vtkArrayDispatch::Dispatch2BySameValueType<vtkArrayDispatch::AllTypes> Dispatcher2;
 
+  polyhedron->GeneratePointIdMap();
   const vtkPolyhedron::vtkPointIdMap& pointIdMap = polyhedron->PointIdMap;
   vtkIdList* pointIds = polyhedron->GetPointIds();
 
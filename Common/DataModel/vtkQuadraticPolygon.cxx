@@ -3,6 +3,7 @@
 #include "vtkQuadraticPolygon.h"
 
 #include "vtkCellData.h"
+#include "vtkCellScratch.h"
 #include "vtkDataArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkObjectFactory.h"
@@ -170,14 +171,11 @@ void vtkQuadraticPolygon::PrintSelf(ostream& os, vtkIndent indent)
 double vtkQuadraticPolygon::DistanceToPolygon(
   double x[3], int numPts, double* pts, double bounds[6], double closest[3])
 {
-  double* convertedPts = new double[numPts * 3];
+  vtkCellScratch::Frame frame;
+  double* convertedPts = frame.Allocate<double>(numPts * 3);
   vtkQuadraticPolygon::PermuteToPolygon(numPts, pts, convertedPts);
 
-  double result = vtkPolygon::DistanceToPolygon(x, numPts, convertedPts, bounds, closest);
-
-  delete[] convertedPts;
-
-  return result;
+  return vtkPolygon::DistanceToPolygon(x, numPts, convertedPts, bounds, closest);
 }
 
 //------------------------------------------------------------------------------
@@ -207,19 +205,15 @@ int vtkQuadraticPolygon::ParameterizePolygon(
 int vtkQuadraticPolygon::IntersectPolygonWithPolygon(int npts, double* pts, double bounds[6],
   int npts2, double* pts2, double bounds2[6], double tol2, double x[3])
 {
-  double* convertedPts = new double[npts * 3];
+  vtkCellScratch::Frame frame;
+  double* convertedPts = frame.Allocate<double>(npts * 3);
   vtkQuadraticPolygon::PermuteToPolygon(npts, pts, convertedPts);
 
-  double* convertedPts2 = new double[npts2 * 3];
+  double* convertedPts2 = frame.Allocate<double>(npts2 * 3);
   vtkQuadraticPolygon::PermuteToPolygon(npts2, pts2, convertedPts2);
 
-  int result = vtkPolygon::IntersectPolygonWithPolygon(
+  return vtkPolygon::IntersectPolygonWithPolygon(
     npts, convertedPts, bounds, npts2, convertedPts2, bounds2, tol2, x);
-
-  delete[] convertedPts;
-  delete[] convertedPts2;
-
-  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -262,14 +256,11 @@ int vtkQuadraticPolygon::IntersectConvex2DCells(
 int vtkQuadraticPolygon::PointInPolygon(
   double x[3], int numPts, double* pts, double bounds[6], double* n)
 {
-  double* convertedPts = new double[numPts * 3];
+  vtkCellScratch::Frame frame;
+  double* convertedPts = frame.Allocate<double>(numPts * 3);
   vtkQuadraticPolygon::PermuteToPolygon(numPts, pts, convertedPts);
 
-  int result = vtkPolygon::PointInPolygon(x, numPts, convertedPts, bounds, n);
-
-  delete[] convertedPts;
-
-  return result;
+  return vtkPolygon::PointInPolygon(x, numPts, convertedPts, bounds, n);
 }
 
 //------------------------------------------------------------------------------
@@ -285,7 +276,8 @@ void vtkQuadraticPolygon::GetPermutationFromPolygon(vtkIdType nb, vtkIdList* per
 //------------------------------------------------------------------------------
 void vtkQuadraticPolygon::PermuteToPolygon(vtkIdType nbPoints, double* inPoints, double* outPoints)
 {
-  vtkIdList* permutation = vtkIdList::New();
+  vtkCellScratch::Frame frame;
+  vtkIdList* permutation = frame.GetIdList();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nbPoints, permutation);
 
   for (vtkIdType i = 0; i < nbPoints; i++)
@@ -295,8 +287,6 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkIdType nbPoints, double* inPoints,
       outPoints[3 * i + j] = inPoints[3 * permutation->GetId(i) + j];
     }
   }
-
-  permutation->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -353,7 +343,8 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkCell* inCell, vtkCell* outCell)
 {
   vtkIdType nbPoints = inCell->GetNumberOfPoints();
 
-  vtkIdList* permutation = vtkIdList::New();
+  vtkCellScratch::Frame frame;
+  vtkIdList* permutation = frame.GetIdList();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nbPoints, permutation);
 
   outCell->Points->SetNumberOfPoints(nbPoints);
@@ -364,8 +355,6 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkCell* inCell, vtkCell* outCell)
     outCell->PointIds->SetId(i, inCell->PointIds->GetId(permutation->GetId(i)));
     outCell->Points->SetPoint(i, inCell->Points->GetPoint(permutation->GetId(i)));
   }
-
-  permutation->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -387,10 +376,11 @@ void vtkQuadraticPolygon::GetPermutationToPolygon(vtkIdType nb, vtkIdList* permu
 //------------------------------------------------------------------------------
 void vtkQuadraticPolygon::PermuteFromPolygon(vtkIdType nb, double* values)
 {
-  vtkIdList* permutation = vtkIdList::New();
+  vtkCellScratch::Frame frame;
+  vtkIdList* permutation = frame.GetIdList();
   vtkQuadraticPolygon::GetPermutationToPolygon(nb, permutation);
 
-  double* save = new double[nb];
+  double* save = frame.Allocate<double>(nb);
   for (vtkIdType i = 0; i < nb; i++)
   {
     save[i] = values[i];
@@ -399,9 +389,6 @@ void vtkQuadraticPolygon::PermuteFromPolygon(vtkIdType nb, double* values)
   {
     values[i] = save[permutation->GetId(i)];
   }
-
-  permutation->Delete();
-  delete[] save;
 }
 
 //------------------------------------------------------------------------------
@@ -409,10 +396,11 @@ void vtkQuadraticPolygon::ConvertFromPolygon(vtkIdType nb, vtkIdList* ids)
 {
   vtkIdType nbIds = ids->GetNumberOfIds();
 
-  vtkIdList* permutation = vtkIdList::New();
+  vtkCellScratch::Frame frame;
+  vtkIdList* permutation = frame.GetIdList();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nb, permutation);
 
-  vtkIdList* saveList = vtkIdList::New();
+  vtkIdList* saveList = frame.GetIdList();
   saveList->SetNumberOfIds(nbIds);
   ids->SetNumberOfIds(nbIds);
 
@@ -424,9 +412,6 @@ void vtkQuadraticPolygon::ConvertFromPolygon(vtkIdType nb, vtkIdList* ids)
   {
     ids->SetId(i, permutation->GetId(saveList->GetId(i)));
   }
-
-  permutation->Delete();
-  saveList->Delete();
 }
 
 //------------------------------------------------------------------------------
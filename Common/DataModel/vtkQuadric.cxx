@@ -3,6 +3,8 @@
 #include "vtkQuadric.h"
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadric);
 
@@ -65,6 +67,20 @@ double vtkQuadric::EvaluateFunction(double x[3])
     a[4] * x[1] * x[2] + a[5] * x[0] * x[2] + a[6] * x[0] + a[7] * x[1] + a[8] * x[2] + a[9]);
 }
 
+//------------------------------------------------------------------------------
+// Evaluate quadric equation for n points.
+void vtkQuadric::EvaluateFunctionBatch(const double* points, double* values, vtkIdType n)
+{
+  double a[10];
+  std::copy_n(this->Coefficients, 10, a);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const double* x = points + 3 * i;
+    values[i] = a[0] * x[0] * x[0] + a[1] * x[1] * x[1] + a[2] * x[2] * x[2] + a[3] * x[0] * x[1] +
+      a[4] * x[1] * x[2] + a[5] * x[0] * x[2] + a[6] * x[0] + a[7] * x[1] + a[8] * x[2] + a[9];
+  }
+}
+
 // Evaluate the gradient to the quadric equation.
 void vtkQuadric::EvaluateGradient(double x[3], double n[3])
 {
@@ -30,6 +30,20 @@ double vtkSphere::EvaluateFunction(double x[3])
     this->Radius * this->Radius);
 }
 
+//------------------------------------------------------------------------------
+// Evaluate sphere equation for n points.
+void vtkSphere::EvaluateFunctionBatch(const double* points, double* values, vtkIdType n)
+{
+  const double c0 = this->Center[0], c1 = this->Center[1], c2 = this->Center[2];
+  const double r2 = this->Radius * this->Radius;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const double* x = points + 3 * i;
+    const double d0 = x[0] - c0, d1 = x[1] - c1, d2 = x[2] - c2;
+    values[i] = (d0 * d0 + d1 * d1 + d2 * d2) - r2;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Evaluate sphere gradient.
 void vtkSphere::EvaluateGradient(double x[3], double n[3])
@@ -72,6 +72,13 @@ public:
    */
   vtkIdType* GetCells(vtkIdType ptId) { return this->Impl->GetCells(ptId); }
 
+  /**
+   * Sort the cell ids using each point in increasing (or, if descending is
+   * true, decreasing) order, so that the links do not depend on the number
+   * of threads used to build them.
+   */
+  void SortLinks(bool descending = false) { this->Impl->SortLinks(descending); }
+
   ///@{
   /**
    * Select all cells with a point degree in the range [minDegree,maxDegree).
@@ -144,6 +144,14 @@ public:
    */
   TIds GetOffset(vtkIdType ptId) { return this->Offsets[ptId]; }
 
+  /**
+   * Sort the cell ids using each point in increasing (or, if descending is
+   * true, decreasing) order. The threaded build does not order the cells
+   * using a point; sorting them makes the links, and any traversal of them,
+   * independent of the number of threads.
+   */
+  void SortLinks(bool descending = false);
+
   ///@{
   /**
    * Support vtkAbstractCellLinks API.
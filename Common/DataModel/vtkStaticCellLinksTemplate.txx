@@ -12,8 +12,10 @@
 #include "vtkPolyData.h"
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <functional>
 
 #include <type_traits>
 
@@ -677,6 +679,27 @@ void vtkStaticCellLinksTemplate<TIds>::ShallowCopy(vtkStaticCellLinksTemplate* l
   this->Offsets = this->OffsetsSharedPtr.get();
 }
 
+//----------------------------------------------------------------------------
+template <typename TIds>
+void vtkStaticCellLinksTemplate<TIds>::SortLinks(bool descending)
+{
+  vtkSMPTools::For(0, this->NumPts, [this, descending](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      TIds* begin = this->Links + this->Offsets[ptId];
+      TIds* end = this->Links + this->Offsets[ptId + 1];
+      if (descending)
+      {
+        std::sort(begin, end, std::greater<TIds>());
+      }
+      else
+      {
+        std::sort(begin, end);
+      }
+    }
+  }); // end lambda
+}
+
 //----------------------------------------------------------------------------
 // Support the vtkAbstractCellLinks API
 template <typename TIds>
@@ -8,6 +8,7 @@
 #include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCellLinks.h"
+#include "vtkCellScratch.h"
 #include "vtkCellTypes.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
@@ -19,6 +20,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkPolyhedronTopology.h"
 #include "vtkStaticCellLinks.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGridCellIterator.h"
@@ -296,6 +298,7 @@ void vtkUnstructuredGrid::CopyStructure(vtkDataSet* ds)
   this->DistinctCellTypesUpdateMTime = 0;
   this->Faces = ug->Faces;
   this->FaceLocations = ug->FaceLocations;
+  this->PolyhedronTopology = ug->PolyhedronTopology;
 }
 
 //------------------------------------------------------------------------------
@@ -308,6 +311,7 @@ void vtkUnstructuredGrid::Cleanup()
   this->DistinctCellTypesUpdateMTime = 0;
   this->Faces = nullptr;
   this->FaceLocations = nullptr;
+  this->PolyhedronTopology = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -358,6 +362,11 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell* cell)
   if (cell->RequiresExplicitFaceRepresentation())
   {
     this->GetPolyhedronFaces(cellId, cell->GetCellFaces());
+    if (cellType == VTK_POLYHEDRON)
+    {
+      static_cast<vtkPolyhedron*>(cell->GetRepresentativeCell())
+        ->SetTopology(this->GetPolyhedronTopology(), cellId);
+    }
   }
 
   // Some cells require special initialization to build data structures and such.
@@ -393,6 +402,15 @@ struct ComputeCellBoundsVisitor
 // constructing a cell.
 void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
 {
+  if (this->Connectivity->IsStorageCompressed())
+  {
+    // Visit() would expand the compressed storage.
+    vtkCellScratch::Frame frame;
+    vtkIdType npts;
+    const vtkIdType* pts = frame.GetCellPoints(this->Connectivity, cellId, npts);
+    vtkBoundingBox::ComputeBounds(this->Points, pts, npts, bounds);
+    return;
+  }
   this->Connectivity->Visit(ComputeCellBoundsVisitor{}, this->Points, cellId, bounds);
 }
 
@@ -1126,6 +1144,24 @@ void vtkUnstructuredGrid::BuildLinks()
   this->Links->BuildLinks();
 }
 
+//------------------------------------------------------------------------------
+void vtkUnstructuredGrid::BuildPolyhedronTopology()
+{
+  if (!this->PolyhedronTopology)
+  {
+    this->PolyhedronTopology = vtkSmartPointer<vtkPolyhedronTopology>::New();
+  }
+  this->PolyhedronTopology->Build(this);
+}
+
+//------------------------------------------------------------------------------
+vtkPolyhedronTopology* vtkUnstructuredGrid::GetPolyhedronTopology()
+{
+  return this->PolyhedronTopology && this->PolyhedronTopology->IsUpToDate(this)
+    ? this->PolyhedronTopology.Get()
+    : nullptr;
+}
+
 //------------------------------------------------------------------------------
 vtkAbstractCellLinks* vtkUnstructuredGrid::GetCellLinks()
 {
@@ -1506,6 +1542,11 @@ unsigned long vtkUnstructuredGrid::GetActualMemorySize()
     size += this->FaceLocations->GetActualMemorySize();
   }
 
+  if (this->PolyhedronTopology)
+  {
+    size += this->PolyhedronTopology->GetActualMemorySize();
+  }
+
   return size;
 }
 
@@ -1529,6 +1570,7 @@ void vtkUnstructuredGrid::ShallowCopy(vtkDataObject* dataObject)
     this->DistinctCellTypesUpdateMTime = 0;
     this->Faces = grid->Faces;
     this->FaceLocations = grid->FaceLocations;
+    this->PolyhedronTopology = grid->PolyhedronTopology;
 
     if (grid->Links)
     {
@@ -1634,6 +1676,8 @@ void vtkUnstructuredGrid::DeepCopy(vtkDataObject* dataObject)
     {
       this->Links = nullptr;
     }
+    // The polyhedron topology refers to the arrays of the source grid.
+    this->PolyhedronTopology = nullptr;
   }
   else
   {
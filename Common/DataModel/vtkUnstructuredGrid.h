@@ -29,6 +29,7 @@ VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
 class vtkIdList;
 class vtkIdTypeArray;
+class vtkPolyhedronTopology;
 class vtkUnsignedCharArray;
 class vtkIdTypeArray;
 
@@ -238,6 +239,22 @@ public:
   vtkGetSmartPointerMacro(Links, vtkAbstractCellLinks);
   ///@}
 
+  /**
+   * Precompute the faces, edges and face triangulation of the polyhedral
+   * cells (see vtkPolyhedronTopology). Once built, the polyhedra returned by
+   * GetCell() use it instead of computing these structures each time a cell
+   * is loaded. The topology is shared by the shallow copies of the grid, and
+   * is ignored once the points, the cells or the faces are modified (call
+   * this method again to update it).
+   */
+  void BuildPolyhedronTopology();
+
+  /**
+   * Return the polyhedron topology built by BuildPolyhedronTopology(), or
+   * nullptr if it was not built or is out of date.
+   */
+  vtkPolyhedronTopology* GetPolyhedronTopology();
+
   /**
    * Get the cell links. The cell links will be one of nullptr=0;
    * vtkCellLinks=1; vtkStaticCellLinksTemplate<VTK_UNSIGNED_SHORT>=2;
@@ -578,6 +595,9 @@ protected:
   vtkSmartPointer<vtkCellArray> Faces;
   vtkSmartPointer<vtkCellArray> FaceLocations;
 
+  // Optional precomputed topology of the polyhedral cells.
+  vtkSmartPointer<vtkPolyhedronTopology> PolyhedronTopology;
+
   // Legacy support -- stores the old-style cell array locations.
   vtkSmartPointer<vtkIdTypeArray> CellLocations;
 
@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkConcurrentBranchPipeline produces the same result as the
+// default executive for a pipeline that forks after a source and merges the
+// branches with vtkAppendPolyData, that the independent branches made of
+// re-entrant algorithms are executed concurrently and that the other branches
+// are not.
+
+#include "vtkAlgorithm.h"
+#include "vtkAppendPolyData.h"
+#include "vtkConcurrentBranchPipeline.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <vector>
+
+namespace
+{
+const int NumberOfBranches = 6;
+
+struct Pipeline
+{
+  vtkNew<vtkSphereSource> Sphere;
+  std::vector<vtkSmartPointer<vtkElevationFilter>> Branches;
+  vtkNew<vtkAppendPolyData> Append;
+
+  Pipeline(bool reentrant)
+  {
+    this->Sphere->SetThetaResolution(128);
+    this->Sphere->SetPhiResolution(128);
+    for (int i = 0; i < NumberOfBranches; ++i)
+    {
+      auto elevation = vtkSmartPointer<vtkElevationFilter>::New();
+      elevation->SetInputConnection(this->Sphere->GetOutputPort());
+      elevation->SetLowPoint(0.0, 0.0, -0.5 - i);
+      elevation->SetHighPoint(0.0, 0.0, 0.5 + i);
+      elevation->GetInformation()->Set(vtkAlgorithm::REENTRANT(), reentrant ? 1 : 0);
+      this->Append->AddInputConnection(elevation->GetOutputPort());
+      this->Branches.push_back(elevation);
+    }
+  }
+};
+
+bool Compare(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfCells() != actual->GetNumberOfCells())
+  {
+    vtkLog(ERROR, "Wrong output size.");
+    return false;
+  }
+  vtkDataArray* expectedElevation = expected->GetPointData()->GetArray("Elevation");
+  vtkDataArray* actualElevation = actual->GetPointData()->GetArray("Elevation");
+  if (!actualElevation)
+  {
+    vtkLog(ERROR, "Missing elevation.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+  {
+    if (expectedElevation->GetComponent(i, 0) != actualElevation->GetComponent(i, 0))
+    {
+      vtkLog(ERROR, "Wrong elevation for point " << i);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestConcurrentBranchPipeline(int, char*[])
+{
+  Pipeline reference(false);
+  reference.Append->Update();
+
+  vtkNew<vtkConcurrentBranchPipeline> prototype;
+  vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+  Pipeline concurrent(true);
+  Pipeline serial(true);
+  serial.Branches[1]->GetInformation()->Set(vtkAlgorithm::REENTRANT(), 0);
+  Pipeline notReentrant(false);
+  vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+
+  concurrent.Append->Update();
+  auto executive = vtkConcurrentBranchPipeline::SafeDownCast(concurrent.Append->GetExecutive());
+  if (!executive || executive->GetNumberOfConcurrentBranches() != NumberOfBranches)
+  {
+    vtkLog(ERROR, "The branches were not executed concurrently.");
+    return 1;
+  }
+  if (!Compare(reference.Append->GetOutput(), concurrent.Append->GetOutput()))
+  {
+    return 1;
+  }
+
+  // Only the modified branch executes again.
+  concurrent.Branches[2]->SetHighPoint(0.0, 0.0, 10.0);
+  reference.Branches[2]->SetHighPoint(0.0, 0.0, 10.0);
+  const vtkMTimeType sphereTime = concurrent.Sphere->GetOutput()->GetMTime();
+  const vtkMTimeType branchTime = concurrent.Branches[0]->GetOutput()->GetMTime();
+  concurrent.Append->Update();
+  reference.Append->Update();
+  if (concurrent.Sphere->GetOutput()->GetMTime() != sphereTime ||
+    concurrent.Branches[0]->GetOutput()->GetMTime() != branchTime)
+  {
+    vtkLog(ERROR, "Up to date algorithms executed again.");
+    return 1;
+  }
+  if (!Compare(reference.Append->GetOutput(), concurrent.Append->GetOutput()))
+  {
+    return 1;
+  }
+
+  // The branches that are not re-entrant are executed on this thread.
+  serial.Append->Update();
+  executive = vtkConcurrentBranchPipeline::SafeDownCast(serial.Append->GetExecutive());
+  if (!executive || executive->GetNumberOfConcurrentBranches() != NumberOfBranches - 1)
+  {
+    vtkLog(ERROR, "A branch that is not re-entrant was executed concurrently.");
+    return 1;
+  }
+  serial.Branches[2]->SetHighPoint(0.0, 0.0, 10.0);
+  serial.Append->Update();
+  if (!Compare(reference.Append->GetOutput(), serial.Append->GetOutput()))
+  {
+    return 1;
+  }
+
+  // Concurrent execution is opt-in.
+  notReentrant.Branches[2]->SetHighPoint(0.0, 0.0, 10.0);
+  notReentrant.Append->Update();
+  executive = vtkConcurrentBranchPipeline::SafeDownCast(notReentrant.Append->GetExecutive());
+  if (!executive || executive->GetNumberOfConcurrentBranches() != 0)
+  {
+    vtkLog(ERROR, "Branches that are not re-entrant were executed concurrently.");
+    return 1;
+  }
+  if (!Compare(reference.Append->GetOutput(), notReentrant.Append->GetOutput()))
+  {
+    return 1;
+  }
+  return 0;
+}
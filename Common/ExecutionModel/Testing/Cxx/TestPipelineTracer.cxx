@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that the executives record the spans of the pipeline passes with
+// vtkPipelineTracer, including the blocks executed in parallel by
+// vtkThreadedCompositeDataPipeline, and that nothing is recorded when the
+// tracer is disabled.
+
+#include "vtkElevationFilter.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPipelineTracer.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+
+#include <string>
+
+namespace
+{
+int CountOccurrences(const std::string& str, const std::string& pattern)
+{
+  int count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos;
+       pos = str.find(pattern, pos + pattern.size()))
+  {
+    ++count;
+  }
+  return count;
+}
+}
+
+int TestPipelineTracer(int, char*[])
+{
+  vtkPipelineTracer::SetEnabled(false);
+  vtkPipelineTracer::Clear();
+
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->Update();
+  if (vtkPipelineTracer::GetNumberOfEvents() != 0)
+  {
+    vtkLog(ERROR, "Events were recorded while the tracer was disabled.");
+    return 1;
+  }
+
+  vtkPipelineTracer::SetEnabled(true);
+  sphere->SetThetaResolution(32);
+  elevation->Update();
+
+  std::string trace = vtkPipelineTracer::GetChromeTrace();
+  const char* expected[] = { "\"vtkSphereSource::RequestInformation\"",
+    "\"vtkSphereSource::RequestData\"", "\"vtkElevationFilter::RequestUpdateExtent\"",
+    "\"vtkElevationFilter::RequestData\"", "\"ph\":\"X\"", "\"thread_name\"",
+    "\"output_points\":" };
+  for (const char* pattern : expected)
+  {
+    if (trace.find(pattern) == std::string::npos)
+    {
+      vtkLog(ERROR, "Missing " << pattern << " in the trace:\n" << trace);
+      return 1;
+    }
+  }
+  const std::string numPoints =
+    "\"output_points\":" + std::to_string(elevation->GetOutput()->GetNumberOfPoints());
+  if (trace.find(numPoints) == std::string::npos)
+  {
+    vtkLog(ERROR, "Missing the output size in the trace:\n" << trace);
+    return 1;
+  }
+  if (trace.compare(0, 15, "{\"traceEvents\":") != 0)
+  {
+    vtkLog(ERROR, "Unexpected trace header.");
+    return 1;
+  }
+
+  // Each block of a composite dataset gets its own span.
+  vtkPipelineTracer::Clear();
+  const int numBlocks = 8;
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(numBlocks);
+  for (int i = 0; i < numBlocks; ++i)
+  {
+    vtkNew<vtkPolyData> block;
+    block->DeepCopy(sphere->GetOutput());
+    blocks->SetBlock(i, block);
+  }
+  vtkNew<vtkThreadedCompositeDataPipeline> executive;
+  vtkNew<vtkElevationFilter> compositeElevation;
+  compositeElevation->SetExecutive(executive);
+  compositeElevation->SetInputData(blocks);
+  compositeElevation->Update();
+
+  trace = vtkPipelineTracer::GetChromeTrace();
+  const int numSpans = CountOccurrences(trace, "\"vtkElevationFilter::RequestData\"");
+  if (numSpans != numBlocks)
+  {
+    vtkLog(ERROR, "Expected " << numBlocks << " RequestData spans, got " << numSpans);
+    return 1;
+  }
+
+  vtkPipelineTracer::SetEnabled(false);
+  vtkPipelineTracer::Clear();
+  return 0;
+}
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkThreadedCompositeDataPipeline places the outputs in the
+// right blocks with and without size aware scheduling and nested
+// parallelism, and that algorithms marked as re-entrant get a threaded
+// executive by default.
+
+#include "vtkAlgorithm.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+
+namespace
+{
+bool CheckOutput(vtkMultiBlockDataSet* input, vtkMultiBlockDataSet* output, const char* mode)
+{
+  if (!output || output->GetNumberOfBlocks() != input->GetNumberOfBlocks())
+  {
+    vtkLog(ERROR, << mode << ": wrong number of output blocks");
+    return false;
+  }
+  for (unsigned int i = 0; i < input->GetNumberOfBlocks(); ++i)
+  {
+    vtkPolyData* inBlock = vtkPolyData::SafeDownCast(input->GetBlock(i));
+    vtkPolyData* outBlock = vtkPolyData::SafeDownCast(output->GetBlock(i));
+    if (!outBlock || outBlock->GetNumberOfPoints() != inBlock->GetNumberOfPoints() ||
+      outBlock->GetNumberOfCells() != inBlock->GetNumberOfCells())
+    {
+      vtkLog(ERROR, << mode << ": block " << i << " does not match its input");
+      return false;
+    }
+    vtkDataArray* elevation = outBlock->GetPointData()->GetArray("Elevation");
+    if (!elevation || elevation->GetNumberOfTuples() != inBlock->GetNumberOfPoints())
+    {
+      vtkLog(ERROR, << mode << ": block " << i << " has no elevation");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestThreadedCompositeDataPipeline(int, char*[])
+{
+  // Many small blocks mixed with a few large ones, the large ones last so
+  // that a static split of the blocks would be unbalanced.
+  const unsigned int numSmallBlocks = 60;
+  const unsigned int numLargeBlocks = 3;
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(numSmallBlocks + numLargeBlocks);
+  for (unsigned int i = 0; i < numSmallBlocks + numLargeBlocks; ++i)
+  {
+    const int resolution = i < numSmallBlocks ? 4 + i % 5 : 256 + 32 * (i - numSmallBlocks);
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(resolution);
+    sphere->SetPhiResolution(resolution);
+    sphere->SetCenter(i, 0.0, 0.0);
+    sphere->Update();
+    blocks->SetBlock(i, sphere->GetOutput());
+  }
+
+  for (int sizeAware = 0; sizeAware < 2; ++sizeAware)
+  {
+    for (int nested = 0; nested < 2; ++nested)
+    {
+      vtkNew<vtkThreadedCompositeDataPipeline> executive;
+      executive->SetSizeAwareScheduling(sizeAware);
+      executive->SetNestedParallelism(nested);
+      vtkNew<vtkElevationFilter> elevation;
+      elevation->SetExecutive(executive);
+      elevation->SetInputData(blocks);
+      elevation->Update();
+
+      const char* mode = sizeAware ? (nested ? "size aware, nested" : "size aware")
+                                   : (nested ? "nested" : "default");
+      if (!CheckOutput(
+            blocks, vtkMultiBlockDataSet::SafeDownCast(elevation->GetOutputDataObject(0)), mode))
+      {
+        return 1;
+      }
+    }
+  }
+
+  // Algorithms marked as re-entrant get a threaded executive by default.
+  vtkNew<vtkElevationFilter> reentrant;
+  reentrant->GetInformation()->Set(vtkAlgorithm::REENTRANT(), 1);
+  if (!vtkThreadedCompositeDataPipeline::SafeDownCast(reentrant->GetExecutive()))
+  {
+    vtkLog(ERROR, "A re-entrant algorithm did not get a threaded executive.");
+    return 1;
+  }
+  reentrant->SetInputData(blocks);
+  reentrant->Update();
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(reentrant->GetOutputDataObject(0));
+  if (!CheckOutput(blocks, output, "re-entrant"))
+  {
+    return 1;
+  }
+
+  vtkNew<vtkElevationFilter> regular;
+  if (vtkThreadedCompositeDataPipeline::SafeDownCast(regular->GetExecutive()))
+  {
+    vtkLog(ERROR, "Only re-entrant algorithms should get a threaded executive.");
+    return 1;
+  }
+  return 0;
+}
@@ -31,6 +31,7 @@
 #include "vtkProgressObserver.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
+#include "vtkThreadedCompositeDataPipeline.h"
 #include "vtkTrivialProducer.h"
 
 #include <set>
@@ -52,6 +53,7 @@ vtkInformationKeyMacro(vtkAlgorithm, INPUT_CONNECTION, Integer);
 vtkInformationKeyMacro(vtkAlgorithm, INPUT_ARRAYS_TO_PROCESS, InformationVector);
 vtkInformationKeyMacro(vtkAlgorithm, CAN_PRODUCE_SUB_EXTENT, Integer);
 vtkInformationKeyMacro(vtkAlgorithm, CAN_HANDLE_PIECE_REQUEST, Integer);
+vtkInformationKeyMacro(vtkAlgorithm, REENTRANT, Integer);
 vtkInformationKeyMacro(vtkAlgorithm, ABORTED, Integer);
 
 vtkExecutive* vtkAlgorithm::DefaultExecutivePrototype = nullptr;
@@ -1038,6 +1040,10 @@ vtkExecutive* vtkAlgorithm::CreateDefaultExecutive()
   {
     return vtkAlgorithm::DefaultExecutivePrototype->NewInstance();
   }
+  if (this->Information->Get(vtkAlgorithm::REENTRANT()))
+  {
+    return vtkThreadedCompositeDataPipeline::New();
+  }
   return vtkCompositeDataPipeline::New();
 }
 
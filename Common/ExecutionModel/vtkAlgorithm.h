@@ -338,6 +338,18 @@ public:
    */
   static vtkInformationIntegerKey* CAN_HANDLE_PIECE_REQUEST();
 
+  /**
+   * Key that an algorithm sets in its own information (see GetInformation())
+   * to declare that all its pipeline passes are re-entrant: it keeps no
+   * state outside of the information objects and its outputs. The blocks of
+   * a composite input may then be processed concurrently, and such an
+   * algorithm gets a vtkThreadedCompositeDataPipeline as default executive
+   * (unless a default executive prototype is set). vtkConcurrentBranchPipeline
+   * also only executes the branches made of re-entrant algorithms concurrently.
+   * \ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* REENTRANT();
+
   /**
    *
    * \ingroup InformationKeys
@@ -22,6 +22,7 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSetCollection.h"
+#include "vtkPipelineTracer.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
@@ -100,7 +101,9 @@ int vtkCompositeDataPipeline::ExecuteDataObject(
   if (!shouldIterate)
   {
     // Invoke the request on the algorithm.
+    const double traceStart = vtkPipelineTracer::StartAlgorithmEvent();
     result = this->CallAlgorithm(request, vtkExecutive::RequestDownstream, inInfoVec, outInfoVec);
+    vtkPipelineTracer::EndAlgorithmEvent(traceStart, "RequestDataObject", this->Algorithm);
     if (!result)
     {
       return result;
@@ -0,0 +1,323 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkConcurrentBranchPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkFieldData.h"
+#include "vtkGenericCell.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkConcurrentBranchPipeline);
+
+namespace
+{
+// An input connection of the executive and everything upstream of it.
+struct Branch
+{
+  vtkExecutive* Producer;
+  int ProducerPort;
+  std::set<vtkExecutive*> Upstream;
+  bool Concurrent;
+};
+
+// Return the executive and output port producing the given input.
+vtkExecutive* GetProducer(vtkExecutive* exec, int port, int connection, int& producerPort)
+{
+  vtkInformation* info = exec->GetInputInformation(port)->GetInformationObject(connection);
+  vtkExecutive* producer = nullptr;
+  producerPort = 0;
+  if (info)
+  {
+    vtkExecutive::PRODUCER()->Get(info, producer, producerPort);
+  }
+  return producer;
+}
+
+// Collect the executives upstream of `exec` (included) in `upstream`, in
+// post order (upstream first) in `postOrder`, and the output ports of each
+// executive that are connected downstream in `ports`.
+void CollectUpstream(vtkExecutive* exec, std::set<vtkExecutive*>& upstream,
+  std::set<vtkExecutive*>& visited, std::vector<vtkExecutive*>& postOrder,
+  std::map<vtkExecutive*, std::set<int>>& ports)
+{
+  if (!upstream.insert(exec).second)
+  {
+    return;
+  }
+  for (int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < exec->GetNumberOfInputConnections(i); ++j)
+    {
+      int producerPort;
+      if (vtkExecutive* producer = GetProducer(exec, i, j, producerPort))
+      {
+        ports[producer].insert(producerPort);
+        CollectUpstream(producer, upstream, visited, postOrder, ports);
+      }
+    }
+  }
+  if (visited.insert(exec).second)
+  {
+    postOrder.push_back(exec);
+  }
+}
+
+int ProcessUpstream(vtkExecutive* producer, int producerPort, vtkInformation* request)
+{
+  request->Set(vtkExecutive::FROM_OUTPUT_PORT(), producerPort);
+  return producer->ProcessRequest(
+    request, producer->GetInputInformation(), producer->GetOutputInformation());
+}
+
+// Cache the ranges of all the components (and of the magnitude) of the
+// arrays, which vtkDataArray computes lazily on first access.
+void PrepareArrays(vtkFieldData* fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = fd->GetArray(i);
+    if (!array)
+    {
+      continue;
+    }
+    double range[2];
+    for (int comp = -1; comp < array->GetNumberOfComponents(); ++comp)
+    {
+      array->GetRange(range, comp);
+      array->GetFiniteRange(range, comp);
+      fd->GetRange(i, range, comp);
+      fd->GetFiniteRange(i, range, comp);
+    }
+  }
+}
+
+// Build the structures that vtkDataSet builds lazily on first access (cells,
+// cell links, bounds, array ranges), so that the data set can be read from
+// several threads.
+void PrepareForConcurrentAccess(vtkDataObject* dobj)
+{
+  if (!dobj)
+  {
+    return;
+  }
+  for (vtkDataSet* ds : vtkCompositeDataSet::GetDataSets(dobj))
+  {
+    if (ds->GetNumberOfCells() > 0)
+    {
+      vtkNew<vtkGenericCell> cell;
+      ds->GetCell(0, cell);
+    }
+    double bounds[6];
+    ds->GetBounds(bounds);
+    if (auto polyData = vtkPolyData::SafeDownCast(ds))
+    {
+      if (!polyData->GetLinks())
+      {
+        polyData->BuildLinks();
+      }
+    }
+    else if (auto grid = vtkUnstructuredGrid::SafeDownCast(ds))
+    {
+      if (!grid->GetLinks())
+      {
+        grid->BuildLinks();
+      }
+      grid->GetDistinctCellTypesArray();
+    }
+    PrepareArrays(ds->GetPointData());
+    PrepareArrays(ds->GetCellData());
+    PrepareArrays(ds->GetFieldData());
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+vtkConcurrentBranchPipeline::vtkConcurrentBranchPipeline()
+{
+  this->NumberOfConcurrentBranches = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkConcurrentBranchPipeline::~vtkConcurrentBranchPipeline() = default;
+
+//------------------------------------------------------------------------------
+void vtkConcurrentBranchPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Concurrent Branches: " << this->NumberOfConcurrentBranches << "\n";
+}
+
+//------------------------------------------------------------------------------
+int vtkConcurrentBranchPipeline::ForwardUpstream(vtkInformation* request)
+{
+  // Only the RequestData pass is worth executing concurrently.
+  if (!request->Has(REQUEST_DATA()))
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  // Do not forward upstream if the input is shared with another
+  // executive.
+  if (this->SharedInputInformation)
+  {
+    return 1;
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+  int port = request->Get(FROM_OUTPUT_PORT());
+
+  std::vector<Branch> branches;
+  for (int i = 0; i < this->GetNumberOfInputPorts(); ++i)
+  {
+    int nic = this->Algorithm->GetNumberOfInputConnections(i);
+    for (int j = 0; j < nic; ++j)
+    {
+      Branch branch;
+      branch.Producer = GetProducer(this, i, j, branch.ProducerPort);
+      branch.Concurrent = true;
+      if (branch.Producer)
+      {
+        branches.push_back(branch);
+      }
+    }
+  }
+
+  int result = 1;
+  this->NumberOfConcurrentBranches = 0;
+  if (branches.size() < 2)
+  {
+    for (const Branch& branch : branches)
+    {
+      if (!ProcessUpstream(branch.Producer, branch.ProducerPort, request))
+      {
+        result = 0;
+      }
+    }
+  }
+  else
+  {
+    // Find the executives shared by several branches.
+    std::set<vtkExecutive*> visited;
+    std::vector<vtkExecutive*> postOrder;
+    std::map<vtkExecutive*, std::set<int>> ports;
+    std::map<vtkExecutive*, int> numberOfBranches;
+    for (Branch& branch : branches)
+    {
+      ports[branch.Producer].insert(branch.ProducerPort);
+      CollectUpstream(branch.Producer, branch.Upstream, visited, postOrder, ports);
+      for (vtkExecutive* exec : branch.Upstream)
+      {
+        ++numberOfBranches[exec];
+      }
+    }
+
+    // A branch is executed concurrently only if all the algorithms it does
+    // not share with other branches are re-entrant.
+    for (Branch& branch : branches)
+    {
+      for (vtkExecutive* exec : branch.Upstream)
+      {
+        vtkAlgorithm* algorithm = exec->GetAlgorithm();
+        if (numberOfBranches[exec] < 2 &&
+          !(algorithm && algorithm->GetInformation()->Get(vtkAlgorithm::REENTRANT())))
+        {
+          branch.Concurrent = false;
+        }
+      }
+    }
+
+    // Update the shared executives first, upstream first, on this thread.
+    for (vtkExecutive* exec : postOrder)
+    {
+      if (numberOfBranches[exec] < 2)
+      {
+        continue;
+      }
+      for (int producerPort : ports[exec])
+      {
+        if (!ProcessUpstream(exec, producerPort, request))
+        {
+          result = 0;
+        }
+        PrepareForConcurrentAccess(exec->GetOutputData(producerPort));
+      }
+    }
+
+    // Then the branches that contain algorithms that are not re-entrant.
+    std::vector<const Branch*> concurrentBranches;
+    for (const Branch& branch : branches)
+    {
+      if (!branch.Concurrent || numberOfBranches[branch.Producer] > 1)
+      {
+        if (!ProcessUpstream(branch.Producer, branch.ProducerPort, request))
+        {
+          result = 0;
+        }
+      }
+      else
+      {
+        concurrentBranches.push_back(&branch);
+      }
+    }
+
+    // And finally the independent branches, concurrently. Each branch gets its
+    // own copy of the request, and nested parallelism is enabled so that the
+    // forks further upstream and the SMP algorithms can use the idle threads.
+    this->NumberOfConcurrentBranches = static_cast<int>(concurrentBranches.size());
+    std::vector<int> results(concurrentBranches.size(), 1);
+    const vtkSMPTools::Config config(
+      vtkSMPTools::GetEstimatedNumberOfThreads(), vtkSMPTools::GetBackend(), true);
+    vtkSMPTools::LocalScope(config, [&]() {
+      vtkSMPTools::For(0, static_cast<vtkIdType>(concurrentBranches.size()), 1,
+        [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType k = begin; k < end; ++k)
+          {
+            // vtkInformation::Copy() does not copy the request itself.
+            vtkNew<vtkInformation> branchRequest;
+            branchRequest->Copy(request);
+            branchRequest->Set(REQUEST_DATA());
+            const Branch* branch = concurrentBranches[k];
+            results[k] = ProcessUpstream(branch->Producer, branch->ProducerPort, branchRequest);
+          }
+        });
+    });
+    for (int branchResult : results)
+    {
+      if (!branchResult)
+      {
+        result = 0;
+      }
+    }
+  }
+  request->Set(FROM_OUTPUT_PORT(), port);
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+
+  return result;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkConcurrentBranchPipeline
+ * @brief   Executive that updates independent upstream branches concurrently
+ *
+ * vtkConcurrentBranchPipeline is a vtkCompositeDataPipeline that executes
+ * the independent branches upstream of an algorithm concurrently. When the
+ * RequestData pass is forwarded to the inputs of an algorithm with several
+ * input connections (for example a vtkAppendPolyData merging a contour, a
+ * slice and a glyph branch fed by the same reader), the executive first
+ * looks for the executives that are upstream of more than one connection
+ * (the reader in the example) and updates them on the calling thread. The
+ * remaining branches no longer share any algorithm, and their RequestData
+ * passes are run concurrently as vtkSMPTools tasks.
+ *
+ * Concurrent execution is opt-in: a branch is executed concurrently only if
+ * all the algorithms it does not share with other branches set the
+ * vtkAlgorithm::REENTRANT() key in their information. The other branches are
+ * executed on the calling thread, before the concurrent ones.
+ *
+ * Before the branches are executed, the structures that the shared data sets
+ * build lazily on first access (cells, cell links, bounds and the cached
+ * ranges of their arrays) are built so that the branches can read them
+ * concurrently. The other passes (RequestDataObject, RequestInformation,
+ * RequestUpdateExtent) are cheap and are still forwarded serially.
+ *
+ * The executive only parallelizes the branches upstream of the algorithms it
+ * is set on. Use vtkAlgorithm::SetDefaultExecutivePrototype() to use it
+ * for a whole pipeline, so that the forks further upstream are executed
+ * concurrently as well.
+ *
+ * @sa
+ * vtkThreadedCompositeDataPipeline vtkSMPTools
+ */
+
+#ifndef vtkConcurrentBranchPipeline_h
+#define vtkConcurrentBranchPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkConcurrentBranchPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkConcurrentBranchPipeline* New();
+  vtkTypeMacro(vtkConcurrentBranchPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Return the number of branches that were executed concurrently during the
+   * last RequestData pass forwarded by this executive.
+   */
+  vtkGetMacro(NumberOfConcurrentBranches, int);
+
+protected:
+  vtkConcurrentBranchPipeline();
+  ~vtkConcurrentBranchPipeline() override;
+
+  int ForwardUpstream(vtkInformation* request) override;
+  using Superclass::ForwardUpstream;
+
+  int NumberOfConcurrentBranches;
+
+private:
+  vtkConcurrentBranchPipeline(const vtkConcurrentBranchPipeline&) = delete;
+  void operator=(const vtkConcurrentBranchPipeline&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
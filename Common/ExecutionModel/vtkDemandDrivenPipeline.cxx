@@ -21,6 +21,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineTracer.h"
 #include "vtkPointData.h"
 
 #include <vector>
@@ -413,6 +414,7 @@ int vtkDemandDrivenPipeline::ExecuteDataObject(
   vtkInformation* request, vtkInformationVector** inInfo, vtkInformationVector* outInfo)
 {
   // Invoke the request on the algorithm.
+  const double traceStart = vtkPipelineTracer::StartAlgorithmEvent();
   int result = this->CallAlgorithm(request, vtkExecutive::RequestDownstream, inInfo, outInfo);
 
   // Make sure a valid data object exists for all output ports.
@@ -420,6 +422,7 @@ int vtkDemandDrivenPipeline::ExecuteDataObject(
   {
     result = this->CheckDataObject(i, outInfo);
   }
+  vtkPipelineTracer::EndAlgorithmEvent(traceStart, "RequestDataObject", this->Algorithm);
 
   return result;
 }
@@ -437,13 +440,18 @@ int vtkDemandDrivenPipeline::ExecuteInformation(
   }
 
   // Invoke the request on the algorithm.
-  return this->CallAlgorithm(request, vtkExecutive::RequestDownstream, inInfoVec, outInfoVec);
+  const double traceStart = vtkPipelineTracer::StartAlgorithmEvent();
+  int result =
+    this->CallAlgorithm(request, vtkExecutive::RequestDownstream, inInfoVec, outInfoVec);
+  vtkPipelineTracer::EndAlgorithmEvent(traceStart, "RequestInformation", this->Algorithm);
+  return result;
 }
 
 //------------------------------------------------------------------------------
 int vtkDemandDrivenPipeline::ExecuteData(
   vtkInformation* request, vtkInformationVector** inInfo, vtkInformationVector* outInfo)
 {
+  const double traceStart = vtkPipelineTracer::StartAlgorithmEvent();
   this->ExecuteDataStart(request, inInfo, outInfo);
   // Invoke the request on the algorithm.
   //   vtkMTimeType mTimeBefore = this->Algorithm->GetMTime();
@@ -456,6 +464,7 @@ int vtkDemandDrivenPipeline::ExecuteData(
   //                     << "executions");
   //     }
   this->ExecuteDataEnd(request, inInfo, outInfo);
+  vtkPipelineTracer::EndAlgorithmEvent(traceStart, "RequestData", this->Algorithm, outInfo);
 
   return result;
 }
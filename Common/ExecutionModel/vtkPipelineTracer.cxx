@@ -0,0 +1,307 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPipelineTracer.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <vtksys/SystemTools.hxx>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkPipelineTracer);
+
+namespace
+{
+struct TraceEvent
+{
+  std::string Name;
+  std::string Category;
+  double Start;
+  double Duration;
+  int ThreadId;
+  std::string Args; // JSON members, without the braces
+};
+
+void WriteJSONString(std::ostream& os, const std::string& str)
+{
+  os << '"';
+  for (char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+          os << buffer;
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+
+struct TracerState
+{
+  std::atomic<bool> Enabled;
+  std::chrono::steady_clock::time_point Epoch;
+  std::mutex Mutex;
+  std::vector<TraceEvent> Events;
+  std::map<std::thread::id, int> ThreadIds;
+  std::string FileName;
+
+  TracerState()
+    : Enabled(false)
+    , Epoch(std::chrono::steady_clock::now())
+  {
+    const char* fileName = vtksys::SystemTools::GetEnv("VTK_PIPELINE_TRACE_FILE");
+    if (fileName && *fileName)
+    {
+      this->FileName = fileName;
+      this->Enabled = true;
+    }
+  }
+
+  ~TracerState()
+  {
+    if (!this->FileName.empty())
+    {
+      std::ofstream file(this->FileName.c_str());
+      if (file)
+      {
+        this->Write(file);
+      }
+    }
+  }
+
+  // Must be called with the mutex locked.
+  int GetThreadId()
+  {
+    auto result = this->ThreadIds.insert(
+      std::make_pair(std::this_thread::get_id(), static_cast<int>(this->ThreadIds.size())));
+    return result.first->second;
+  }
+
+  void Write(std::ostream& os)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    // Name the tracks: the first thread that recorded a span is usually the
+    // main thread, the others are vtkSMPTools workers.
+    for (const auto& thread : this->ThreadIds)
+    {
+      os << (first ? "\n" : ",\n");
+      first = false;
+      os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.second
+         << ",\"args\":{\"name\":\"VTK thread " << thread.second << "\"}}";
+    }
+    char timing[128];
+    for (const auto& event : this->Events)
+    {
+      os << (first ? "\n" : ",\n");
+      first = false;
+      os << "{\"name\":";
+      WriteJSONString(os, event.Name);
+      os << ",\"cat\":";
+      WriteJSONString(os, event.Category);
+      snprintf(timing, sizeof(timing), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", event.Start,
+        event.Duration);
+      os << timing << ",\"pid\":1,\"tid\":" << event.ThreadId;
+      if (!event.Args.empty())
+      {
+        os << ",\"args\":{" << event.Args << "}";
+      }
+      os << "}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  }
+};
+
+// The state is constructed, and VTK_PIPELINE_TRACE_FILE is read, the first time
+// the tracer is used (at the latest, by the first request of a pipeline).
+TracerState& GetTracerState()
+{
+  static TracerState state;
+  return state;
+}
+
+void RecordEvent(TracerState& state, std::string&& name, const char* category, double startTime,
+  double endTime, std::string&& args)
+{
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  TraceEvent event;
+  event.Name = std::move(name);
+  event.Category = category ? category : "";
+  event.Start = startTime;
+  event.Duration = endTime - startTime;
+  event.ThreadId = state.GetThreadId();
+  event.Args = std::move(args);
+  state.Events.push_back(std::move(event));
+}
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineTracer::SetEnabled(bool enabled)
+{
+  GetTracerState().Enabled = enabled;
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineTracer::GetEnabled()
+{
+  return GetTracerState().Enabled;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineTracer::Clear()
+{
+  TracerState& state = GetTracerState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.Events.clear();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineTracer::GetNumberOfEvents()
+{
+  TracerState& state = GetTracerState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return static_cast<vtkIdType>(state.Events.size());
+}
+
+//------------------------------------------------------------------------------
+double vtkPipelineTracer::GetTime()
+{
+  return std::chrono::duration<double, std::micro>(
+    std::chrono::steady_clock::now() - GetTracerState().Epoch)
+    .count();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineTracer::AddEvent(
+  const char* name, const char* category, double startTime, double endTime)
+{
+  TracerState& state = GetTracerState();
+  if (!state.Enabled)
+  {
+    return;
+  }
+  RecordEvent(state, std::string(name ? name : ""), category, startTime, endTime, std::string());
+}
+
+//------------------------------------------------------------------------------
+std::string vtkPipelineTracer::GetChromeTrace()
+{
+  std::ostringstream os;
+  GetTracerState().Write(os);
+  return os.str();
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineTracer::WriteChromeTrace(const char* filename)
+{
+  if (!filename)
+  {
+    return false;
+  }
+  std::ofstream file(filename);
+  if (!file)
+  {
+    return false;
+  }
+  GetTracerState().Write(file);
+  return static_cast<bool>(file);
+}
+
+//------------------------------------------------------------------------------
+double vtkPipelineTracer::StartAlgorithmEvent()
+{
+  return GetTracerState().Enabled ? vtkPipelineTracer::GetTime() : -1.0;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineTracer::EndAlgorithmEvent(
+  double startTime, const char* request, vtkAlgorithm* algorithm, vtkInformationVector* outInfo)
+{
+  if (startTime < 0.0 || !algorithm)
+  {
+    return;
+  }
+  const double endTime = vtkPipelineTracer::GetTime();
+
+  std::string name = algorithm->GetClassName();
+  name += "::";
+  name += request;
+
+  std::ostringstream args;
+  args << "\"algorithm\":";
+  WriteJSONString(args, algorithm->GetObjectDescription());
+
+  // Summarize the outputs: the memory used by the output data objects is a
+  // good estimate of the memory allocated by the request.
+  const int numOutputs = outInfo ? outInfo->GetNumberOfInformationObjects() : 0;
+  if (numOutputs > 0)
+  {
+    vtkIdType numPoints = 0;
+    vtkIdType numCells = 0;
+    unsigned long long numBytes = 0;
+    std::string types;
+    for (int i = 0; i < numOutputs; ++i)
+    {
+      vtkInformation* info = outInfo->GetInformationObject(i);
+      vtkDataObject* output = info ? info->Get(vtkDataObject::DATA_OBJECT()) : nullptr;
+      if (!output)
+      {
+        continue;
+      }
+      numPoints += output->GetNumberOfElements(vtkDataObject::POINT);
+      numCells += output->GetNumberOfElements(vtkDataObject::CELL);
+      numBytes += 1024ull * output->GetActualMemorySize();
+      types += types.empty() ? "" : ",";
+      types += output->GetClassName();
+    }
+    args << ",\"output_types\":";
+    WriteJSONString(args, types);
+    args << ",\"output_points\":" << numPoints << ",\"output_cells\":" << numCells
+         << ",\"output_bytes\":" << numBytes;
+  }
+
+  RecordEvent(GetTracerState(), std::move(name), "pipeline", startTime, endTime, args.str());
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineTracer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << (vtkPipelineTracer::GetEnabled() ? "On\n" : "Off\n");
+  os << indent << "Number Of Events: " << vtkPipelineTracer::GetNumberOfEvents() << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPipelineTracer
+ * @brief   record pipeline execution spans and export them as a trace
+ *
+ * vtkPipelineTracer is a process wide, opt-in tracing facility for the
+ * pipeline. When it is enabled, vtkDemandDrivenPipeline and
+ * vtkStreamingDemandDrivenPipeline record a span for each
+ * RequestDataObject, RequestInformation, RequestUpdateExtent and RequestData
+ * pass of each algorithm, without any instrumentation of the algorithms
+ * themselves. Each span records the thread that executed it (so that blocks
+ * executed by vtkThreadedCompositeDataPipeline on vtkSMPTools workers appear
+ * on their own tracks) and, for RequestData, the size of the outputs: the
+ * number of points and cells and the memory used by the output data objects.
+ *
+ * The spans are exported in the Chrome trace event JSON format, which can be
+ * loaded in chrome://tracing, in the Perfetto UI (https://ui.perfetto.dev) or
+ * in Perfetto's trace processor to find the algorithms that dominate the
+ * execution time of a pipeline. Custom spans may be added with AddEvent().
+ *
+ * Tracing can also be enabled without modifying the application by setting
+ * the environment variable VTK_PIPELINE_TRACE_FILE to the name of a file. The
+ * variable is read the first time the tracer is used, which is at the latest
+ * when the first pipeline request executes: the tracer is then enabled, and
+ * the trace is written to that file when the process exits.
+ *
+ * When tracing is disabled, the executives only pay for the test of an atomic
+ * flag per request.
+ *
+ * @sa
+ * vtkDemandDrivenPipeline vtkStreamingDemandDrivenPipeline vtkTimerLog
+ */
+
+#ifndef vtkPipelineTracer_h
+#define vtkPipelineTracer_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <string> // For std::string
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineTracer : public vtkObject
+{
+public:
+  static vtkPipelineTracer* New();
+  vtkTypeMacro(vtkPipelineTracer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Enable or disable the recording of spans. Disabled by default (unless
+   * the VTK_PIPELINE_TRACE_FILE environment variable is set). Disabling the
+   * tracer does not discard the recorded spans.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  /**
+   * Discard all the recorded spans.
+   */
+  static void Clear();
+
+  /**
+   * Return the number of recorded spans.
+   */
+  static vtkIdType GetNumberOfEvents();
+
+  /**
+   * Return the time elapsed since the tracer was first used, in microseconds.
+   * This is the time base of the recorded spans.
+   */
+  static double GetTime();
+
+  /**
+   * Record a span named `name` in the category `category`, that started at
+   * `startTime` and ended at `endTime` (as returned by GetTime()), on the
+   * calling thread. Does nothing if the tracer is disabled.
+   */
+  static void AddEvent(const char* name, const char* category, double startTime, double endTime);
+
+  /**
+   * Return the recorded spans in the Chrome trace event JSON format.
+   */
+  static std::string GetChromeTrace();
+
+  /**
+   * Write the recorded spans in the Chrome trace event JSON format to the
+   * given file. Returns false if the file could not be written.
+   */
+  static bool WriteChromeTrace(const char* filename);
+
+  ///@{
+  /**
+   * Used by the executives to record the span of a request on an algorithm.
+   * StartAlgorithmEvent() returns a negative value if the tracer is
+   * disabled, in which case EndAlgorithmEvent() does nothing. When
+   * `outInfo` is given, the size of the output data objects is recorded
+   * with the span.
+   */
+  static double StartAlgorithmEvent();
+  static void EndAlgorithmEvent(double startTime, const char* request, vtkAlgorithm* algorithm,
+    vtkInformationVector* outInfo = nullptr);
+  ///@}
+
+protected:
+  vtkPipelineTracer() = default;
+  ~vtkPipelineTracer() override = default;
+
+private:
+  vtkPipelineTracer(const vtkPipelineTracer&) = delete;
+  void operator=(const vtkPipelineTracer&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -25,6 +25,7 @@
 #include "vtkLogger.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineTracer.h"
 #include "vtkSmartPointer.h"
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -309,7 +310,9 @@ vtkTypeBool vtkStreamingDemandDrivenPipeline ::ProcessRequest(
         // Invoke the request on the algorithm.
         this->LastPropogateUpdateExtentShortCircuited = 0;
         vtkLogF(TRACE, "%s execute-update-extent", vtkLogIdentifier(this->Algorithm));
+        const double traceStart = vtkPipelineTracer::StartAlgorithmEvent();
         result = this->CallAlgorithm(request, vtkExecutive::RequestUpstream, inInfoVec, outInfoVec);
+        vtkPipelineTracer::EndAlgorithmEvent(traceStart, "RequestUpdateExtent", this->Algorithm);
 
         // Propagate the update extent to all inputs.
         if (result)
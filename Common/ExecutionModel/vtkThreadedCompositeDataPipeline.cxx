@@ -28,7 +28,9 @@
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <vector>
 
 //------------------------------------------------------------------------------
@@ -103,7 +105,8 @@ class ProcessBlock
 public:
   ProcessBlock(vtkThreadedCompositeDataPipeline* exec, vtkInformationVector** inInfoVec,
     vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
-    const std::vector<vtkDataObject*>& inObjs, std::vector<vtkDataObject*>& outObjs)
+    const std::vector<vtkDataObject*>& inObjs, const std::vector<vtkIdType>& order,
+    std::vector<vtkDataObject*>& outObjs)
     : Exec(exec)
     , InInfoVec(inInfoVec)
     , OutInfoVec(outInfoVec)
@@ -111,6 +114,7 @@ public:
     , Connection(connection)
     , Request(request)
     , InObjs(inObjs)
+    , Order(order)
   {
     int numInputPorts = this->Exec->GetNumberOfInputPorts();
     this->OutObjs = outObjs.data();
@@ -158,8 +162,9 @@ public:
 
     vtkInformation* inInfo = inInfoVec[this->CompositePort]->GetInformationObject(this->Connection);
 
-    for (vtkIdType i = begin; i < end; ++i)
+    for (vtkIdType task = begin; task < end; ++task)
     {
+      const vtkIdType i = this->Order[task];
       std::vector<vtkDataObject*> outObjList = this->Exec->ExecuteSimpleAlgorithmForBlock(
         &inInfoVec[0], outInfoVec, inInfo, request, this->InObjs[i]);
       for (int j = 0; j < outInfoVec->GetNumberOfInformationObjects(); ++j)
@@ -180,6 +185,7 @@ protected:
   int Connection;
   vtkInformation* Request;
   const std::vector<vtkDataObject*>& InObjs;
+  const std::vector<vtkIdType>& Order;
   vtkDataObject** OutObjs;
 
   vtkSMPThreadLocal<vtkInformationVector**> InInfoVecs;
@@ -188,7 +194,11 @@ protected:
 };
 
 //------------------------------------------------------------------------------
-vtkThreadedCompositeDataPipeline::vtkThreadedCompositeDataPipeline() = default;
+vtkThreadedCompositeDataPipeline::vtkThreadedCompositeDataPipeline()
+{
+  this->SizeAwareScheduling = 0;
+  this->NestedParallelism = 0;
+}
 
 //------------------------------------------------------------------------------
 vtkThreadedCompositeDataPipeline::~vtkThreadedCompositeDataPipeline() = default;
@@ -197,6 +207,9 @@ vtkThreadedCompositeDataPipeline::~vtkThreadedCompositeDataPipeline() = default;
 void vtkThreadedCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Size Aware Scheduling: " << (this->SizeAwareScheduling ? "On\n" : "Off\n");
+  os << indent << "Nested Parallelism: " << (this->NestedParallelism ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -228,14 +241,51 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
   std::vector<vtkDataObject*> outObjs;
   outObjs.resize(indices.size() * outInfoVec->GetNumberOfInformationObjects(), nullptr);
 
+  // Order in which the blocks are processed. With size aware scheduling, the
+  // blocks are processed one at a time, largest first (using the number of
+  // cells, or of points, as cost estimate): the few large blocks start right
+  // away and the small ones fill the gaps, which balances the load.
+  const vtkIdType numBlocks = static_cast<vtkIdType>(inObjs.size());
+  std::vector<vtkIdType> order(numBlocks);
+  std::iota(order.begin(), order.end(), 0);
+  vtkIdType grain = 0;
+  if (this->SizeAwareScheduling && numBlocks > 1)
+  {
+    std::vector<vtkIdType> costs(numBlocks);
+    for (vtkIdType i = 0; i < numBlocks; ++i)
+    {
+      vtkIdType cost = inObjs[i]->GetNumberOfElements(vtkDataObject::CELL);
+      if (cost <= 0)
+      {
+        cost = inObjs[i]->GetNumberOfElements(vtkDataObject::POINT);
+      }
+      costs[i] = cost;
+    }
+    std::stable_sort(order.begin(), order.end(),
+      [&costs](vtkIdType a, vtkIdType b) { return costs[a] > costs[b]; });
+    grain = 1;
+  }
+
   // create the parallel task processBlock
   ProcessBlock processBlock(
-    this, inInfoVec, outInfoVec, compositePort, connection, request, inObjs, outObjs);
+    this, inInfoVec, outInfoVec, compositePort, connection, request, inObjs, order, outObjs);
 
   vtkSmartPointer<vtkProgressObserver> origPo(this->Algorithm->GetProgressObserver());
   vtkNew<vtkSMPProgressObserver> po;
   this->Algorithm->SetProgressObserver(po);
-  vtkSMPTools::For(0, static_cast<vtkIdType>(inObjs.size()), processBlock);
+  if (this->NestedParallelism)
+  {
+    // Let the SMP loops of the algorithm use the threads left idle by the
+    // loop over the blocks.
+    const vtkSMPTools::Config config(
+      vtkSMPTools::GetEstimatedNumberOfThreads(), vtkSMPTools::GetBackend(), true);
+    vtkSMPTools::LocalScope(
+      config, [&]() { vtkSMPTools::For(0, numBlocks, grain, processBlock); });
+  }
+  else
+  {
+    vtkSMPTools::For(0, numBlocks, grain, processBlock);
+  }
   this->Algorithm->SetProgressObserver(origPo);
 
   int i = 0;
@@ -11,6 +11,17 @@
  * algorithm implement all pipeline passes in a re-entrant way. It should
  * store/retrieve all state changes using input and output information
  * objects, which are unique to each thread.
+ *
+ * By default, the list of blocks is split into contiguous chunks. When
+ * SizeAwareScheduling is on, the blocks are scheduled one at a time, largest
+ * first, using their number of cells as an estimate of their cost. This keeps
+ * the threads busy when a few large blocks are mixed with many small ones. When
+ * NestedParallelism is on, the SMP loops of the algorithm executing a block
+ * may in turn use the threads left idle by the loop over the blocks, so that
+ * the work on a large block spreads over the idle workers.
+ *
+ * Algorithms that set the vtkAlgorithm::REENTRANT() key in their
+ * information get a vtkThreadedCompositeDataPipeline as default executive.
  */
 
 #ifndef vtkThreadedCompositeDataPipeline_h
@@ -38,6 +49,27 @@ public:
   int CallAlgorithm(vtkInformation* request, int direction, vtkInformationVector** inInfo,
     vtkInformationVector* outInfo) override;
 
+  ///@{
+  /**
+   * Process the blocks largest first, one block at a time, instead of
+   * splitting the list of blocks into contiguous chunks. Off by default.
+   */
+  vtkSetMacro(SizeAwareScheduling, vtkTypeBool);
+  vtkGetMacro(SizeAwareScheduling, vtkTypeBool);
+  vtkBooleanMacro(SizeAwareScheduling, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Enable nested parallelism while the blocks are processed, so that the
+   * SMP loops of the algorithm may use the idle threads. Off by default.
+   * See vtkSMPTools::SetNestedParallelism() for the behavior of each backend.
+   */
+  vtkSetMacro(NestedParallelism, vtkTypeBool);
+  vtkGetMacro(NestedParallelism, vtkTypeBool);
+  vtkBooleanMacro(NestedParallelism, vtkTypeBool);
+  ///@}
+
 protected:
   vtkThreadedCompositeDataPipeline();
   ~vtkThreadedCompositeDataPipeline() override;
@@ -45,6 +77,9 @@ protected:
     vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
     std::vector<vtkSmartPointer<vtkCompositeDataSet>>& compositeOutput) override;
 
+  vtkTypeBool SizeAwareScheduling;
+  vtkTypeBool NestedParallelism;
+
 private:
   vtkThreadedCompositeDataPipeline(const vtkThreadedCompositeDataPipeline&) = delete;
   void operator=(const vtkThreadedCompositeDataPipeline&) = delete;
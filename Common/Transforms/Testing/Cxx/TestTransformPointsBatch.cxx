@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that the batched TransformPoints() of vtkThinPlateSplineTransform
+// and vtkGeneralTransform give the same results as transforming the points
+// one at a time, and that the approximate thin plate spline evaluation is
+// within its tolerance.
+
+#include "vtkGeneralTransform.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkThinPlateSplineTransform.h"
+#include "vtkTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkPoints* points, vtkIdType n,
+  double scale)
+{
+  points->SetNumberOfPoints(n);
+  for (vtkIdType i = 0; i < n; i++)
+  {
+    double p[3];
+    for (int j = 0; j < 3; j++)
+    {
+      p[j] = random->GetNextRangeValue(-scale, scale);
+    }
+    points->SetPoint(i, p);
+  }
+}
+
+// Return the largest distance between the batched and per-point results. The
+// batched results are appended after a dummy point, to check the offset.
+double Compare(vtkAbstractTransform* transform, vtkPoints* points)
+{
+  vtkNew<vtkPoints> batched;
+  batched->SetDataTypeToDouble();
+  batched->InsertNextPoint(0.0, 0.0, 0.0);
+  transform->TransformPoints(points, batched);
+  if (batched->GetNumberOfPoints() != points->GetNumberOfPoints() + 1)
+  {
+    return VTK_DOUBLE_MAX;
+  }
+  double error = 0.0;
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); i++)
+  {
+    double p[3], q[3];
+    points->GetPoint(i, p);
+    transform->TransformPoint(p, p);
+    batched->GetPoint(i + 1, q);
+    error = std::max(error, std::sqrt(vtkMath::Distance2BetweenPoints(p, q)));
+  }
+  return error;
+}
+
+double CubicBasis(double r)
+{
+  return r * r * r;
+}
+
+double CubicBasisDerivative(double r, double& dUdr)
+{
+  dUdr = 3.0 * r * r;
+  return r * r * r;
+}
+}
+
+int TestTransformPointsBatch(int, char*[])
+{
+  int rval = 0;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  vtkNew<vtkPoints> source;
+  vtkNew<vtkPoints> target;
+  RandomPoints(random, source, 50, 1.0);
+  target->DeepCopy(source);
+  for (vtkIdType i = 0; i < target->GetNumberOfPoints(); i++)
+  {
+    double p[3];
+    target->GetPoint(i, p);
+    // a smooth warp, that the approximate evaluation can reproduce
+    target->SetPoint(i, p[0] + 0.1 * std::sin(p[1]), p[1] + 0.1 * std::sin(p[2]),
+      p[2] + 0.1 * std::sin(p[0]));
+  }
+
+  vtkNew<vtkPoints> points;
+  RandomPoints(random, points, 50000, 1.2);
+
+  vtkNew<vtkThinPlateSplineTransform> spline;
+  spline->SetSourceLandmarks(source);
+  spline->SetTargetLandmarks(target);
+
+  for (int basis = 0; basis < 3; basis++)
+  {
+    if (basis == 0)
+    {
+      spline->SetBasisToR();
+    }
+    else if (basis == 1)
+    {
+      spline->SetBasisToR2LogR();
+    }
+    else
+    {
+      spline->SetBasisFunction(CubicBasis);
+      spline->SetBasisDerivative(CubicBasisDerivative);
+    }
+    double error = Compare(spline, points);
+    if (error > 1e-10)
+    {
+      std::cerr << "Batched spline with basis " << spline->GetBasisAsString()
+                << " differs by " << error << std::endl;
+      rval = 1;
+    }
+    spline->Inverse();
+    error = Compare(spline, points);
+    if (error > 1e-10)
+    {
+      std::cerr << "Batched inverse spline with basis " << spline->GetBasisAsString()
+                << " differs by " << error << std::endl;
+      rval = 1;
+    }
+    spline->Inverse();
+  }
+
+  // The approximate evaluation.
+  spline->SetBasisToR();
+  const double tolerance = 5e-3;
+  spline->SetApproximationTolerance(tolerance);
+  double error = Compare(spline, points);
+  // The error is measured at the cell centers only, allow some slack.
+  if (error > 2.0 * tolerance)
+  {
+    std::cerr << "Approximate spline differs by " << error << std::endl;
+    rval = 1;
+  }
+  spline->SetApproximationTolerance(0.0);
+
+  // A concatenation of linear and nonlinear transforms.
+  vtkNew<vtkTransform> rotation;
+  rotation->RotateWXYZ(30.0, 1.0, 2.0, 3.0);
+  rotation->Translate(0.5, -0.2, 0.1);
+  vtkNew<vtkTransform> scale;
+  scale->Scale(2.0, 1.0, 0.5);
+  vtkNew<vtkGeneralTransform> general;
+  general->SetInput(spline);
+  general->PostMultiply();
+  general->Concatenate(scale);
+  general->PreMultiply();
+  general->Concatenate(rotation);
+  general->Concatenate(spline->GetInverse());
+  error = Compare(general, points);
+  if (error > 1e-10)
+  {
+    std::cerr << "Batched general transform differs by " << error << std::endl;
+    rval = 1;
+  }
+  general->Inverse();
+  error = Compare(general, points);
+  if (error > 1e-10)
+  {
+    std::cerr << "Batched inverse general transform differs by " << error << std::endl;
+    rval = 1;
+  }
+
+  return rval;
+}
@@ -3,6 +3,13 @@
 #include "vtkGeneralTransform.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkGeneralTransform);
@@ -135,6 +142,74 @@ void vtkConcatenationTransformDerivative(vtkAbstractTransform* input,
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkGeneralTransform::TransformPoints(vtkPoints* inPts, vtkPoints* outPts)
+{
+  this->Update();
+
+  // the transforms, in the order in which they are applied
+  std::vector<vtkAbstractTransform*> transforms;
+  vtkTransformConcatenation* concat = this->Concatenation;
+  int i = 0;
+  int nTransforms = concat->GetNumberOfTransforms();
+  int nPreTransforms = concat->GetNumberOfPreTransforms();
+  for (; i < nPreTransforms; i++)
+  {
+    transforms.push_back(concat->GetTransform(i));
+  }
+  if (this->Input)
+  {
+    transforms.push_back(
+      concat->GetInverseFlag() ? this->Input->GetInverse() : this->Input);
+  }
+  for (; i < nTransforms; i++)
+  {
+    transforms.push_back(concat->GetTransform(i));
+  }
+
+  if (transforms.size() < 2)
+  {
+    this->Superclass::TransformPoints(inPts, outPts);
+    return;
+  }
+
+  vtkIdType n = inPts->GetNumberOfPoints();
+  vtkIdType m = outPts->GetNumberOfPoints();
+  outPts->SetNumberOfPoints(m + n);
+
+  const vtkIdType blockSize = 1024;
+  vtkSMPThreadLocalObject<vtkPoints> localPoints;
+  vtkSMPThreadLocalObject<vtkPoints> localOutput;
+  vtkSMPTools::For(0, n, blockSize, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkPoints* points = localPoints.Local();
+    vtkPoints* output = localOutput.Local();
+    points->SetDataTypeToDouble();
+    output->SetDataTypeToDouble();
+    double point[3];
+    for (; ptId < endPtId; ptId += blockSize)
+    {
+      const vtkIdType count = std::min(blockSize, endPtId - ptId);
+      points->SetNumberOfPoints(count);
+      for (vtkIdType k = 0; k < count; k++)
+      {
+        inPts->GetPoint(ptId + k, point);
+        points->SetPoint(k, point);
+      }
+      for (vtkAbstractTransform* transform : transforms)
+      {
+        output->SetNumberOfPoints(0);
+        transform->TransformPoints(points, output);
+        std::swap(points, output);
+      }
+      for (vtkIdType k = 0; k < count; k++)
+      {
+        points->GetPoint(k, point);
+        outPts->SetPoint(m + ptId + k, point);
+      }
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 void vtkGeneralTransform::InternalTransformPoint(const float input[3], float output[3])
 {
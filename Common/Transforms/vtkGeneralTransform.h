@@ -251,6 +251,15 @@ public:
   }
   ///@}
 
+  /**
+   * Apply the transformation to a series of points, and append the results
+   * to outPts. The points are processed in parallel by blocks, and each
+   * block is passed through the TransformPoints() method of each transform of
+   * the concatenation in turn, so that the batched implementations of the
+   * concatenated transforms are used.
+   */
+  void TransformPoints(vtkPoints* inPts, vtkPoints* outPts) override;
+
   ///@{
   /**
    * This will calculate the transformation without calling Update.
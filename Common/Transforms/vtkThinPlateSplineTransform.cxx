@@ -5,6 +5,12 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkThinPlateSplineTransform);
@@ -99,8 +105,10 @@ vtkThinPlateSplineTransform::vtkThinPlateSplineTransform()
 
   this->NumberOfPoints = 0;
   this->MatrixW = nullptr;
+  this->SourcePoints = nullptr;
 
   this->RegularizeBulkTransform = true;
+  this->ApproximationTolerance = 0.0;
 }
 
 //------------------------------------------------------------------------------
@@ -119,6 +127,7 @@ vtkThinPlateSplineTransform::~vtkThinPlateSplineTransform()
     vtkDeleteMatrix(this->MatrixW);
     this->MatrixW = nullptr;
   }
+  delete[] this->SourcePoints;
 }
 
 //------------------------------------------------------------------------------
@@ -193,6 +202,8 @@ void vtkThinPlateSplineTransform::InternalUpdate()
       vtkDeleteMatrix(this->MatrixW);
     }
     this->MatrixW = nullptr;
+    delete[] this->SourcePoints;
+    this->SourcePoints = nullptr;
     this->NumberOfPoints = 0;
     return;
   }
@@ -491,6 +502,13 @@ void vtkThinPlateSplineTransform::InternalUpdate()
   }
   this->MatrixW = W;
   this->NumberOfPoints = N;
+
+  delete[] this->SourcePoints;
+  this->SourcePoints = new double[3 * N];
+  for (vtkIdType i = 0; i < N; i++)
+  {
+    this->SourceLandmarks->GetPoint(i, this->SourcePoints + 3 * i);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -499,7 +517,7 @@ void vtkThinPlateSplineTransform::InternalUpdate()
 // perturbations based on the landmarks.
 template <class T>
 inline void vtkThinPlateSplineForwardTransformPoint(vtkThinPlateSplineTransform* self, double** W,
-  int N, double (*phi)(double), const T point[3], T output[3])
+  const double* sourcePoints, int N, double (*phi)(double), const T point[3], T output[3])
 {
   if (N == 0)
   {
@@ -513,18 +531,16 @@ inline void vtkThinPlateSplineForwardTransformPoint(vtkThinPlateSplineTransform*
   double** A = &W[N + 1];
 
   double dx, dy, dz;
-  double p[3];
+  const double* p;
   double U, r;
   double invSigma = 1.0 / self->GetSigma();
 
   double x = 0, y = 0, z = 0;
 
-  vtkPoints* sourceLandmarks = self->GetSourceLandmarks();
-
   // do the nonlinear stuff
   for (vtkIdType i = 0; i < N; i++)
   {
-    sourceLandmarks->GetPoint(i, p);
+    p = sourcePoints + 3 * i;
     dx = point[0] - p[0];
     dy = point[1] - p[1];
     dz = point[2] - p[2];
@@ -547,22 +563,307 @@ inline void vtkThinPlateSplineForwardTransformPoint(vtkThinPlateSplineTransform*
 
 void vtkThinPlateSplineTransform::ForwardTransformPoint(const double point[3], double output[3])
 {
-  vtkThinPlateSplineForwardTransformPoint(
-    this, this->MatrixW, this->NumberOfPoints, this->BasisFunction, point, output);
+  vtkThinPlateSplineForwardTransformPoint(this, this->MatrixW, this->SourcePoints,
+    this->NumberOfPoints, this->BasisFunction, point, output);
 }
 
 void vtkThinPlateSplineTransform::ForwardTransformPoint(const float point[3], float output[3])
 {
-  vtkThinPlateSplineForwardTransformPoint(
-    this, this->MatrixW, this->NumberOfPoints, this->BasisFunction, point, output);
+  vtkThinPlateSplineForwardTransformPoint(this, this->MatrixW, this->SourcePoints,
+    this->NumberOfPoints, this->BasisFunction, point, output);
+}
+
+//------------------------------------------------------------------------------
+// Batched evaluation of the spline: the points are processed by blocks, and
+// the loop over the landmarks is the outer loop so that the inner loop over
+// the points of a block has no dependencies and can be vectorized. The basis
+// functions are inlined when possible.
+namespace
+{
+constexpr vtkIdType vtkThinPlateSplineBlockSize = 64;
+
+struct vtkThinPlateSplineBasisR
+{
+  double operator()(double r) const { return r; }
+};
+
+struct vtkThinPlateSplineBasisR2LogR
+{
+  double operator()(double r) const { return r != 0.0 ? r * r * std::log(r) : 0.0; }
+};
+
+struct vtkThinPlateSplineBasisCustom
+{
+  double (*Function)(double);
+  double operator()(double r) const { return this->Function(r); }
+};
+
+template <class TBasis>
+void vtkThinPlateSplineForwardTransformBlock(double** W, const double* sourcePoints, int N,
+  TBasis phi, double invSigma, const double* points, double* output, vtkIdType n)
+{
+  const double* C = W[N];
+  double** A = &W[N + 1];
+
+  double x[vtkThinPlateSplineBlockSize];
+  double y[vtkThinPlateSplineBlockSize];
+  double z[vtkThinPlateSplineBlockSize];
+  std::fill_n(x, n, 0.0);
+  std::fill_n(y, n, 0.0);
+  std::fill_n(z, n, 0.0);
+
+  // do the nonlinear stuff
+  for (vtkIdType i = 0; i < N; i++)
+  {
+    const double* p = sourcePoints + 3 * i;
+    const double w0 = W[i][0], w1 = W[i][1], w2 = W[i][2];
+    for (vtkIdType k = 0; k < n; k++)
+    {
+      const double dx = points[3 * k] - p[0];
+      const double dy = points[3 * k + 1] - p[1];
+      const double dz = points[3 * k + 2] - p[2];
+      const double U = phi(std::sqrt(dx * dx + dy * dy + dz * dz) * invSigma);
+      x[k] += U * w0;
+      y[k] += U * w1;
+      z[k] += U * w2;
+    }
+  }
+
+  // finish off with the affine transformation
+  for (vtkIdType k = 0; k < n; k++)
+  {
+    const double* point = points + 3 * k;
+    output[3 * k] = x[k] + (C[0] + point[0] * A[0][0] + point[1] * A[1][0] + point[2] * A[2][0]);
+    output[3 * k + 1] =
+      y[k] + (C[1] + point[0] * A[0][1] + point[1] * A[1][1] + point[2] * A[2][1]);
+    output[3 * k + 2] =
+      z[k] + (C[2] + point[0] * A[0][2] + point[1] * A[1][2] + point[2] * A[2][2]);
+  }
+}
+
+template <class TBasis>
+void vtkThinPlateSplineForwardTransformPoints(double** W, const double* sourcePoints, int N,
+  TBasis phi, double invSigma, const double* points, double* output, vtkIdType n)
+{
+  for (vtkIdType begin = 0; begin < n; begin += vtkThinPlateSplineBlockSize)
+  {
+    const vtkIdType count = std::min(vtkThinPlateSplineBlockSize, n - begin);
+    vtkThinPlateSplineForwardTransformBlock(
+      W, sourcePoints, N, phi, invSigma, points + 3 * begin, output + 3 * begin, count);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+void vtkThinPlateSplineTransform::ForwardTransformPoints(
+  const double* in, double* out, vtkIdType n)
+{
+  const int N = this->NumberOfPoints;
+  if (N == 0)
+  {
+    std::copy_n(in, 3 * n, out);
+    return;
+  }
+
+  const double invSigma = 1.0 / this->Sigma;
+  switch (this->Basis)
+  {
+    case VTK_RBF_R:
+      vtkThinPlateSplineForwardTransformPoints(this->MatrixW, this->SourcePoints, N,
+        vtkThinPlateSplineBasisR(), invSigma, in, out, n);
+      break;
+    case VTK_RBF_R2LOGR:
+      vtkThinPlateSplineForwardTransformPoints(this->MatrixW, this->SourcePoints, N,
+        vtkThinPlateSplineBasisR2LogR(), invSigma, in, out, n);
+      break;
+    default:
+      vtkThinPlateSplineForwardTransformPoints(this->MatrixW, this->SourcePoints, N,
+        vtkThinPlateSplineBasisCustom{ this->BasisFunction }, invSigma, in, out, n);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkThinPlateSplineTransform::TransformPoints(vtkPoints* inPts, vtkPoints* outPts)
+{
+  this->Update();
+
+  // The inverse is computed iteratively, point by point.
+  if (this->InverseFlag)
+  {
+    this->Superclass::TransformPoints(inPts, outPts);
+    return;
+  }
+
+  vtkIdType n = inPts->GetNumberOfPoints();
+  vtkIdType m = outPts->GetNumberOfPoints();
+  outPts->SetNumberOfPoints(m + n);
+
+  if (this->ApproximationTolerance > 0.0 && this->ApproximateTransformPoints(inPts, outPts, m))
+  {
+    return;
+  }
+
+  vtkSMPTools::For(0, n, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double points[3 * vtkThinPlateSplineBlockSize];
+    double output[3 * vtkThinPlateSplineBlockSize];
+    for (; ptId < endPtId; ptId += vtkThinPlateSplineBlockSize)
+    {
+      const vtkIdType count = std::min(vtkThinPlateSplineBlockSize, endPtId - ptId);
+      for (vtkIdType k = 0; k < count; k++)
+      {
+        inPts->GetPoint(ptId + k, points + 3 * k);
+      }
+      this->ForwardTransformPoints(points, output, count);
+      for (vtkIdType k = 0; k < count; k++)
+      {
+        outPts->SetPoint(m + ptId + k, output + 3 * k);
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// The spline is evaluated on a regular grid covering the points, starting
+// with 4 cells along each axis and doubling the resolution until the
+// trilinear interpolation of the grid matches the spline at the cell centers
+// within the tolerance. The affine part of the warp is reproduced exactly by
+// trilinear interpolation, only its nonlinear part is approximated. The error
+// at the cell centers is only an estimate of the largest interpolation error.
+bool vtkThinPlateSplineTransform::ApproximateTransformPoints(
+  vtkPoints* inPts, vtkPoints* outPts, vtkIdType offset)
+{
+  const vtkIdType n = inPts->GetNumberOfPoints();
+  // The grid must be much cheaper to evaluate than the points themselves.
+  const vtkIdType maxEvaluations = n / 8;
+
+  double bounds[6];
+  inPts->GetBounds(bounds);
+
+  for (vtkIdType resolution = 4;; resolution *= 2)
+  {
+    vtkIdType cells[3];
+    double spacing[3];
+    vtkIdType numNodes = 1;
+    vtkIdType numCells = 1;
+    for (int a = 0; a < 3; a++)
+    {
+      const double length = bounds[2 * a + 1] - bounds[2 * a];
+      cells[a] = length > 0.0 ? resolution : 0;
+      spacing[a] = length > 0.0 ? length / resolution : 0.0;
+      numNodes *= cells[a] + 1;
+      numCells *= std::max<vtkIdType>(cells[a], 1);
+    }
+    if (numNodes + numCells > maxEvaluations)
+    {
+      return false;
+    }
+    const vtkIdType dims[3] = { cells[0] + 1, cells[1] + 1, cells[2] + 1 };
+
+    // Exact values at the grid nodes.
+    std::vector<double> nodes(3 * numNodes);
+    vtkSMPTools::For(0, numNodes, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<double> points(3 * (end - begin));
+      for (vtkIdType id = begin; id < end; id++)
+      {
+        const vtkIdType ijk[3] = { id % dims[0], (id / dims[0]) % dims[1],
+          id / (dims[0] * dims[1]) };
+        for (int a = 0; a < 3; a++)
+        {
+          points[3 * (id - begin) + a] = bounds[2 * a] + ijk[a] * spacing[a];
+        }
+      }
+      this->ForwardTransformPoints(points.data(), nodes.data() + 3 * begin, end - begin);
+    });
+
+    auto interpolate = [&](const double point[3], double output[3]) {
+      vtkIdType ijk[3];
+      double f[3];
+      for (int a = 0; a < 3; a++)
+      {
+        if (cells[a] == 0)
+        {
+          ijk[a] = 0;
+          f[a] = 0.0;
+          continue;
+        }
+        const double t = (point[a] - bounds[2 * a]) / spacing[a];
+        ijk[a] = std::min(std::max(static_cast<vtkIdType>(std::floor(t)), vtkIdType(0)),
+          cells[a] - 1);
+        f[a] = std::min(std::max(t - ijk[a], 0.0), 1.0);
+      }
+      const vtkIdType step[3] = { cells[0] ? 1 : 0, cells[1] ? dims[0] : 0,
+        cells[2] ? dims[0] * dims[1] : 0 };
+      const double* v000 = nodes.data() + 3 * (ijk[0] + dims[0] * (ijk[1] + dims[1] * ijk[2]));
+      for (int c = 0; c < 3; c++)
+      {
+        const double* v = v000 + c;
+        const double x00 = v[0] + f[0] * (v[3 * step[0]] - v[0]);
+        const double x10 = v[3 * step[1]] + f[0] * (v[3 * (step[0] + step[1])] - v[3 * step[1]]);
+        const double x01 = v[3 * step[2]] + f[0] * (v[3 * (step[0] + step[2])] - v[3 * step[2]]);
+        const double x11 = v[3 * (step[1] + step[2])] +
+          f[0] * (v[3 * (step[0] + step[1] + step[2])] - v[3 * (step[1] + step[2])]);
+        const double y0 = x00 + f[1] * (x10 - x00);
+        const double y1 = x01 + f[1] * (x11 - x01);
+        output[c] = y0 + f[2] * (y1 - y0);
+      }
+    };
+
+    // Interpolation error at the cell centers.
+    const vtkIdType cellDims[3] = { std::max<vtkIdType>(cells[0], 1),
+      std::max<vtkIdType>(cells[1], 1), std::max<vtkIdType>(cells[2], 1) };
+    vtkSMPThreadLocal<double> localError(0.0);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<double> points(3 * (end - begin));
+      std::vector<double> exact(3 * (end - begin));
+      for (vtkIdType id = begin; id < end; id++)
+      {
+        const vtkIdType ijk[3] = { id % cellDims[0], (id / cellDims[0]) % cellDims[1],
+          id / (cellDims[0] * cellDims[1]) };
+        for (int a = 0; a < 3; a++)
+        {
+          points[3 * (id - begin) + a] = bounds[2 * a] + (ijk[a] + 0.5) * spacing[a];
+        }
+      }
+      this->ForwardTransformPoints(points.data(), exact.data(), end - begin);
+      double& error = localError.Local();
+      double approximate[3];
+      for (vtkIdType k = 0; k < end - begin; k++)
+      {
+        interpolate(points.data() + 3 * k, approximate);
+        error = std::max(error,
+          std::sqrt(vtkMath::Distance2BetweenPoints(approximate, exact.data() + 3 * k)));
+      }
+    });
+    double error = 0.0;
+    for (double e : localError)
+    {
+      error = std::max(error, e);
+    }
+    if (error > this->ApproximationTolerance)
+    {
+      continue;
+    }
+
+    vtkSMPTools::For(0, n, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double point[3];
+      for (; ptId < endPtId; ptId++)
+      {
+        inPts->GetPoint(ptId, point);
+        interpolate(point, point);
+        outPts->SetPoint(offset + ptId, point);
+      }
+    });
+    return true;
+  }
 }
 
 //------------------------------------------------------------------------------
 // calculate the thin plate spline as well as the jacobian
 template <class T>
 inline void vtkThinPlateSplineForwardTransformDerivative(vtkThinPlateSplineTransform* self,
-  double** W, int N, double (*phi)(double, double&), const T point[3], T output[3],
-  T derivative[3][3])
+  double** W, const double* sourcePoints, int N, double (*phi)(double, double&), const T point[3],
+  T output[3], T derivative[3][3])
 {
   if (N == 0)
   {
@@ -579,7 +880,7 @@ inline void vtkThinPlateSplineForwardTransformDerivative(vtkThinPlateSplineTrans
   double** A = &W[N + 1];
 
   double dx, dy, dz;
-  double p[3];
+  const double* p;
   double r, U, f, Ux, Uy, Uz;
   double x = 0, y = 0, z = 0;
   double invSigma = 1.0 / self->GetSigma();
@@ -588,12 +889,10 @@ inline void vtkThinPlateSplineForwardTransformDerivative(vtkThinPlateSplineTrans
   derivative[1][0] = derivative[1][1] = derivative[1][2] = 0;
   derivative[2][0] = derivative[2][1] = derivative[2][2] = 0;
 
-  vtkPoints* sourceLandmarks = self->GetSourceLandmarks();
-
   // do the nonlinear stuff
   for (vtkIdType i = 0; i < N; i++)
   {
-    sourceLandmarks->GetPoint(i, p);
+    p = sourcePoints + 3 * i;
     dx = point[0] - p[0];
     dy = point[1] - p[1];
     dz = point[2] - p[2];
@@ -651,14 +950,16 @@ void vtkThinPlateSplineTransform::ForwardTransformDerivative(
   const double point[3], double output[3], double derivative[3][3])
 {
   vtkThinPlateSplineForwardTransformDerivative(
-    this, this->MatrixW, this->NumberOfPoints, this->BasisDerivative, point, output, derivative);
+    this, this->MatrixW, this->SourcePoints, this->NumberOfPoints, this->BasisDerivative, point,
+    output, derivative);
 }
 
 void vtkThinPlateSplineTransform::ForwardTransformDerivative(
   const float point[3], float output[3], float derivative[3][3])
 {
   vtkThinPlateSplineForwardTransformDerivative(
-    this, this->MatrixW, this->NumberOfPoints, this->BasisDerivative, point, output, derivative);
+    this, this->MatrixW, this->SourcePoints, this->NumberOfPoints, this->BasisDerivative, point,
+    output, derivative);
 }
 
 //------------------------------------------------------------------------------
@@ -669,6 +970,7 @@ void vtkThinPlateSplineTransform::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Sigma: " << this->Sigma << "\n";
   os << indent << "Basis: " << this->GetBasisAsString() << "\n";
   os << indent << "RegularizeBulkTransform: " << this->RegularizeBulkTransform << "\n";
+  os << indent << "ApproximationTolerance: " << this->ApproximationTolerance << "\n";
   os << indent << "Source Landmarks: " << this->SourceLandmarks << "\n";
   if (this->SourceLandmarks)
   {
@@ -697,6 +999,7 @@ void vtkThinPlateSplineTransform::InternalDeepCopy(vtkAbstractTransform* transfo
   this->SetSigma(t->Sigma);
   this->SetBasis(t->GetBasis());
   this->SetRegularizeBulkTransform(t->GetRegularizeBulkTransform());
+  this->SetApproximationTolerance(t->ApproximationTolerance);
   this->SetSourceLandmarks(t->SourceLandmarks);
   this->SetTargetLandmarks(t->TargetLandmarks);
 
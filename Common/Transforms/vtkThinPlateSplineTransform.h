@@ -140,6 +140,31 @@ public:
   vtkBooleanMacro(RegularizeBulkTransform, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set the tolerance of the approximate evaluation of TransformPoints(). The
+   * default is 0, which means that each point is transformed exactly. When it
+   * is larger than 0 and there are many more points than landmarks, the
+   * spline is evaluated exactly on a regular grid covering the points, and
+   * the points are transformed by trilinear interpolation of the grid. The
+   * grid is refined until the interpolation error measured at the centers of
+   * the grid cells is below the tolerance. This is an estimate, not a bound:
+   * the error is only sampled at the cell centers, and it may be larger
+   * elsewhere in a cell, for instance close to a landmark where the warp
+   * bends sharply. If the grid would become too large to be worth it, the
+   * points are transformed exactly. The inverse transform is always exact.
+   */
+  vtkSetClampMacro(ApproximationTolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(ApproximationTolerance, double);
+  ///@}
+
+  /**
+   * Apply the transformation to a series of points, and append the results
+   * to outPts. The forward transform evaluates the spline for blocks of
+   * points in parallel, with one pass over the landmarks per block.
+   */
+  void TransformPoints(vtkPoints* inPts, vtkPoints* outPts) override;
+
 protected:
   vtkThinPlateSplineTransform();
   ~vtkThinPlateSplineTransform() override;
@@ -161,6 +186,18 @@ protected:
   void ForwardTransformDerivative(
     const double in[3], double out[3], double derivative[3][3]) override;
 
+  /**
+   * Evaluate the spline for n points, without threading.
+   */
+  void ForwardTransformPoints(const double* in, double* out, vtkIdType n);
+
+  /**
+   * Transform the points through the interpolation of a grid, see
+   * SetApproximationTolerance(). Returns false if the approximation is not
+   * worth it, in which case nothing is written in outPts.
+   */
+  bool ApproximateTransformPoints(vtkPoints* inPts, vtkPoints* outPts, vtkIdType offset);
+
   double Sigma;
   vtkPoints* SourceLandmarks;
   vtkPoints* TargetLandmarks;
@@ -173,6 +210,10 @@ protected:
 
   int NumberOfPoints;
   double** MatrixW;
+  // the source landmarks as a contiguous array, for fast access
+  double* SourcePoints;
+
+  double ApproximationTolerance;
 
   bool RegularizeBulkTransform;
 
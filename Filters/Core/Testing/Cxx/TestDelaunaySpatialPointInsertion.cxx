@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkDelaunay2D and vtkDelaunay3D produce the same triangulation
+// when the points are inserted in a spatially coherent order as when they are
+// inserted in the given order, with and without alpha.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkDelaunay3D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> CreatePoints(vtkIdType numPts, bool planar)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = random->GetNextRangeValue(-1.0, 1.0);
+    }
+    if (planar)
+    {
+      x[2] = 0.0;
+    }
+    points->SetPoint(ptId, x);
+  }
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  return polyData;
+}
+
+// Collect the cells (of the given size) as sorted lists of point ids, so that
+// the triangulations can be compared regardless of the order and orientation
+// of the cells.
+std::vector<std::vector<vtkIdType>> GetCells(vtkCellArray* cells, vtkIdType cellSize)
+{
+  std::vector<std::vector<vtkIdType>> result;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+  {
+    if (npts != cellSize)
+    {
+      continue;
+    }
+    std::vector<vtkIdType> cell(pts, pts + npts);
+    std::sort(cell.begin(), cell.end());
+    result.push_back(cell);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+bool Compare(const char* name, vtkCellArray* expected, vtkCellArray* cells, vtkIdType cellSize)
+{
+  const auto expectedCells = GetCells(expected, cellSize);
+  const auto actualCells = GetCells(cells, cellSize);
+  std::cout << name << ": " << expectedCells.size() << " cells" << std::endl;
+  if (expectedCells.empty() || expectedCells != actualCells)
+  {
+    std::cerr << name << ": expected " << expectedCells.size() << " cells, got "
+              << actualCells.size() << " (or different cells)" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool Test3D(vtkPolyData* input, double alpha)
+{
+  vtkNew<vtkDelaunay3D> serial;
+  serial->SetInputData(input);
+  serial->SetAlpha(alpha);
+  serial->Update();
+
+  vtkNew<vtkDelaunay3D> spatial;
+  spatial->SetInputData(input);
+  spatial->SetAlpha(alpha);
+  spatial->SpatialPointInsertionOn();
+  spatial->Update();
+
+  // Only compare the tetrahedra: the lower dimensional alpha shape cells
+  // depend on the numbering of the tetrahedra.
+  return Compare(alpha > 0.0 ? "vtkDelaunay3D with alpha" : "vtkDelaunay3D",
+    serial->GetOutput()->GetCells(), spatial->GetOutput()->GetCells(), 4);
+}
+
+bool Test2D(vtkPolyData* input, double alpha)
+{
+  vtkNew<vtkDelaunay2D> serial;
+  serial->SetInputData(input);
+  serial->SetAlpha(alpha);
+  serial->Update();
+
+  vtkNew<vtkDelaunay2D> spatial;
+  spatial->SetInputData(input);
+  spatial->SetAlpha(alpha);
+  spatial->SpatialPointInsertionOn();
+  spatial->Update();
+
+  return Compare(alpha > 0.0 ? "vtkDelaunay2D with alpha" : "vtkDelaunay2D",
+    serial->GetOutput()->GetPolys(), spatial->GetOutput()->GetPolys(), 3);
+}
+}
+
+int TestDelaunaySpatialPointInsertion(int, char*[])
+{
+  bool success = true;
+
+  vtkSmartPointer<vtkPolyData> points3D = CreatePoints(3000, false);
+  success &= Test3D(points3D, 0.0);
+  success &= Test3D(points3D, 0.15);
+
+  vtkSmartPointer<vtkPolyData> points2D = CreatePoints(20000, true);
+  success &= Test2D(points2D, 0.0);
+  success &= Test2D(points2D, 0.02);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
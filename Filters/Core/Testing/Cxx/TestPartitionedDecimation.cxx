@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the partitioned (parallel) decimation of vtkQuadricDecimation and
+// vtkDecimatePro: the partitions must be stitched back together without
+// cracks, and the requested reduction must be honored.
+
+#include "vtkDecimatePro.h"
+#include "vtkDoubleArray.h"
+#include "vtkFeatureEdges.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+vtkIdType CountBoundaryEdges(vtkPolyData* mesh)
+{
+  vtkNew<vtkFeatureEdges> edges;
+  edges->SetInputData(mesh);
+  edges->BoundaryEdgesOn();
+  edges->FeatureEdgesOff();
+  edges->ManifoldEdgesOff();
+  edges->NonManifoldEdgesOff();
+  edges->Update();
+  return edges->GetOutput()->GetNumberOfLines();
+}
+
+bool CheckOutput(const char* name, vtkPolyData* input, vtkPolyData* output, double minReduction)
+{
+  const double reduction =
+    1.0 - static_cast<double>(output->GetNumberOfPolys()) / input->GetNumberOfPolys();
+  std::cout << name << ": " << input->GetNumberOfPolys() << " to " << output->GetNumberOfPolys()
+            << " triangles" << std::endl;
+  if (reduction < minReduction)
+  {
+    std::cerr << name << ": expected a reduction of at least " << minReduction << ", got "
+              << reduction << std::endl;
+    return false;
+  }
+  const vtkIdType numBoundaryEdges = CountBoundaryEdges(output);
+  if (numBoundaryEdges != 0)
+  {
+    std::cerr << name << ": found " << numBoundaryEdges << " boundary edges" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPartitionedDecimation(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(160);
+  sphere->SetPhiResolution(160);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    input->GetPoint(ptId, x);
+    scalars->SetValue(ptId, std::sin(3.0 * (x[0] + x[1] + x[2])));
+  }
+  input->GetPointData()->SetScalars(scalars);
+
+  if (CountBoundaryEdges(input) != 0)
+  {
+    std::cerr << "The input should be closed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool success = true;
+
+  vtkNew<vtkQuadricDecimation> quadric;
+  quadric->SetInputData(input);
+  quadric->SetTargetReduction(0.9);
+  quadric->PartitionedDecimationOn();
+  quadric->SetNumberOfPartitions(5);
+  quadric->Update();
+  success &= CheckOutput("vtkQuadricDecimation", input, quadric->GetOutput(), 0.85);
+  if (std::abs(quadric->GetActualReduction() -
+        (1.0 -
+          static_cast<double>(quadric->GetOutput()->GetNumberOfPolys()) /
+            input->GetNumberOfPolys())) > 1e-12)
+  {
+    std::cerr << "vtkQuadricDecimation: wrong actual reduction" << std::endl;
+    success = false;
+  }
+
+  quadric->AttributeErrorMetricOn();
+  quadric->MapPointDataOn();
+  quadric->Update();
+  success &= CheckOutput("vtkQuadricDecimation with attributes", input, quadric->GetOutput(), 0.85);
+  if (!quadric->GetOutput()->GetPointData()->GetScalars())
+  {
+    std::cerr << "vtkQuadricDecimation: missing scalars" << std::endl;
+    success = false;
+  }
+
+  vtkNew<vtkDecimatePro> pro;
+  pro->SetInputData(input);
+  pro->SetTargetReduction(0.9);
+  pro->PreserveTopologyOn();
+  pro->PartitionedDecimationOn();
+  pro->SetNumberOfPartitions(5);
+  pro->Update();
+  success &= CheckOutput("vtkDecimatePro", input, pro->GetOutput(), 0.8);
+  if (!pro->GetOutput()->GetPointData()->GetScalars())
+  {
+    std::cerr << "vtkDecimatePro: missing scalars" << std::endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the partitioned (parallel) triangle strip generation of vtkStripper
+// on a mesh made of several spheres whose triangles are interleaved: the
+// strips and the original cell ids must be the same, in the same order, as
+// without partitions, and the strips must cover every triangle once.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr int NumberOfSpheres = 4;
+
+// Append spheres, then interleave their triangles so that the patches of
+// triangles are not contiguous ranges of cells.
+vtkSmartPointer<vtkPolyData> CreateMesh()
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (int i = 0; i < NumberOfSpheres; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(100);
+    sphere->SetPhiResolution(100);
+    sphere->SetCenter(2.0 * i, 0.0, 0.0);
+    append->AddInputConnection(sphere->GetOutputPort());
+  }
+  append->Update();
+  vtkPolyData* spheres = append->GetOutput();
+
+  const vtkIdType numTrisPerSphere = spheres->GetNumberOfPolys() / NumberOfSpheres;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType i = 0; i < numTrisPerSphere; ++i)
+  {
+    for (int j = 0; j < NumberOfSpheres; ++j)
+    {
+      spheres->GetCellPoints(j * numTrisPerSphere + i, pts);
+      polys->InsertNextCell(pts);
+    }
+  }
+  auto mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->SetPoints(spheres->GetPoints());
+  mesh->SetPolys(polys);
+  return mesh;
+}
+
+vtkSmartPointer<vtkPolyData> Strip(vtkPolyData* input, int numThreads, bool partitioned)
+{
+  vtkSMPTools::Initialize(numThreads);
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputData(input);
+  stripper->PassThroughCellIdsOn();
+  stripper->SetPartitionedStripping(partitioned);
+  stripper->SetNumberOfPartitions(NumberOfSpheres);
+  stripper->Update();
+  vtkSmartPointer<vtkPolyData> output = stripper->GetOutput();
+  return output;
+}
+
+bool SameCells(vtkCellArray* cells0, vtkCellArray* cells1)
+{
+  if (cells0->GetNumberOfCells() != cells1->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < cells0->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts0, npts1;
+    const vtkIdType *pts0, *pts1;
+    cells0->GetCellAtId(cellId, npts0, pts0);
+    cells1->GetCellAtId(cellId, npts1, pts1);
+    if (npts0 != npts1 || !std::equal(pts0, pts0 + npts0, pts1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPartitionedStripper(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = CreateMesh();
+  const vtkIdType numTris = input->GetNumberOfPolys();
+
+  vtkSmartPointer<vtkPolyData> serial = Strip(input, 1, false);
+  vtkSmartPointer<vtkPolyData> threaded = Strip(input, 4, true);
+  vtkSMPTools::Initialize();
+
+  vtkCellArray* strips = threaded->GetStrips();
+  std::cout << numTris << " triangles in " << strips->GetNumberOfCells() << " strips"
+            << std::endl;
+  if (strips->GetNumberOfCells() == 0 || strips->GetNumberOfCells() >= numTris / 2)
+  {
+    std::cerr << "Unexpected number of strips" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!SameCells(serial->GetStrips(), strips))
+  {
+    std::cerr << "The partitioned strips differ from the serial ones" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkIdTypeArray* ids =
+    vtkIdTypeArray::SafeDownCast(threaded->GetFieldData()->GetArray("vtkOriginalCellIds"));
+  vtkIdTypeArray* serialIds =
+    vtkIdTypeArray::SafeDownCast(serial->GetFieldData()->GetArray("vtkOriginalCellIds"));
+  if (!ids || !serialIds)
+  {
+    std::cerr << "Missing original cell ids" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (ids->GetNumberOfValues() != serialIds->GetNumberOfValues() ||
+    !std::equal(ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfValues(),
+      serialIds->GetPointer(0)))
+  {
+    std::cerr << "The original cell ids differ from the serial ones" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Every triangle of a strip must be the input triangle of its original id,
+  // and every input triangle must be used once.
+  std::vector<int> used(numTris, 0);
+  vtkNew<vtkIdList> triPts;
+  vtkIdType idx = 0;
+  for (vtkIdType stripId = 0; stripId < strips->GetNumberOfCells(); ++stripId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    strips->GetCellAtId(stripId, npts, pts);
+    for (vtkIdType i = 0; i + 2 < npts; ++i, ++idx)
+    {
+      if (idx >= ids->GetNumberOfValues())
+      {
+        std::cerr << "Not enough original cell ids" << std::endl;
+        return EXIT_FAILURE;
+      }
+      const vtkIdType cellId = ids->GetValue(idx);
+      input->GetCellPoints(cellId, triPts);
+      if (triPts->IsId(pts[i]) < 0 || triPts->IsId(pts[i + 1]) < 0 || triPts->IsId(pts[i + 2]) < 0)
+      {
+        std::cerr << "Strip " << stripId << ": triangle " << i << " is not input cell " << cellId
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+      ++used[cellId];
+    }
+  }
+  if (std::count(used.begin(), used.end(), 1) != numTris)
+  {
+    std::cerr << "Some triangles are not stripped exactly once" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
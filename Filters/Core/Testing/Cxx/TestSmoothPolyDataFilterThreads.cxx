@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that the threaded vtkSmoothPolyDataFilter produces the same points
+// regardless of the number of threads, with and without feature edge
+// smoothing and a smoothing source.
+
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> Smooth(
+  vtkPolyData* input, vtkPolyData* source, bool featureEdgeSmoothing, int numThreads)
+{
+  vtkSMPTools::Initialize(numThreads);
+  vtkNew<vtkSmoothPolyDataFilter> smoother;
+  smoother->SetInputData(input);
+  smoother->SetSourceData(source);
+  smoother->SetNumberOfIterations(50);
+  smoother->SetRelaxationFactor(0.1);
+  smoother->SetConvergence(0.0);
+  smoother->SetFeatureEdgeSmoothing(featureEdgeSmoothing);
+  smoother->SetFeatureAngle(30.0);
+  smoother->BoundarySmoothingOn();
+  smoother->Update();
+  vtkSmartPointer<vtkPolyData> output = smoother->GetOutput();
+  return output;
+}
+
+bool Compare(const char* name, vtkPolyData* input, vtkPolyData* source, bool featureEdgeSmoothing)
+{
+  vtkSmartPointer<vtkPolyData> serial = Smooth(input, source, featureEdgeSmoothing, 1);
+  vtkSmartPointer<vtkPolyData> threaded = Smooth(input, source, featureEdgeSmoothing, 4);
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  if (serial->GetNumberOfPoints() != numPts || threaded->GetNumberOfPoints() != numPts)
+  {
+    std::cerr << name << ": wrong number of points" << std::endl;
+    return false;
+  }
+
+  vtkIdType numMoved = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3], y[3], x0[3];
+    serial->GetPoint(ptId, x);
+    threaded->GetPoint(ptId, y);
+    input->GetPoint(ptId, x0);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << name << ": point " << ptId << " differs with the number of threads"
+                << std::endl;
+      return false;
+    }
+    numMoved += (x[0] != x0[0] || x[1] != x0[1] || x[2] != x0[2]);
+  }
+  std::cout << name << ": " << numMoved << " of " << numPts << " points moved" << std::endl;
+  if (numMoved == 0)
+  {
+    std::cerr << name << ": no point was smoothed" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSmoothPolyDataFilterThreads(int, char*[])
+{
+  // A noisy, open hemisphere
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(100);
+  sphere->SetPhiResolution(100);
+  sphere->SetEndPhi(90.0);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> input;
+  input->DeepCopy(sphere->GetOutput());
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkPoints* points = input->GetPoints();
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] += random->GetNextRangeValue(-0.005, 0.005);
+    }
+    points->SetPoint(ptId, x);
+  }
+
+  bool success = true;
+  success &= Compare("vtkSmoothPolyDataFilter", input, nullptr, false);
+  success &= Compare("vtkSmoothPolyDataFilter with feature edges", input, nullptr, true);
+  success &= Compare("vtkSmoothPolyDataFilter with source", input, sphere->GetOutput(), true);
+
+  vtkSMPTools::Initialize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkTriangleFilter triangulates polygons and triangle strips
+// consistently with their cell data, and independently of the number of
+// threads.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTriangleFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Rows of polygons with 3 to 9 sides (regular, and concave "stars") and rows
+// of triangle strips.
+vtkSmartPointer<vtkPolyData> CreateInput()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("InputIds");
+
+  std::vector<vtkIdType> pts;
+  for (int row = 0; row < 100; ++row)
+  {
+    for (int col = 0; col < 100; ++col)
+    {
+      const int numSides = 3 + (row + col) % 7;
+      const bool star = ((row + col) % 2 == 1) && numSides > 4;
+      pts.clear();
+      for (int i = 0; i < numSides; ++i)
+      {
+        const double angle = 2.0 * vtkMath::Pi() * i / numSides;
+        const double radius = (star && i % 2) ? 0.2 : 0.45;
+        pts.push_back(points->InsertNextPoint(
+          col + radius * std::cos(angle), row + radius * std::sin(angle), 0.0));
+      }
+      polys->InsertNextCell(static_cast<vtkIdType>(pts.size()), pts.data());
+    }
+  }
+
+  for (int row = 0; row < 100; ++row)
+  {
+    pts.clear();
+    const int length = 3 + row % 20;
+    for (int i = 0; i < length; ++i)
+    {
+      pts.push_back(points->InsertNextPoint(0.5 * (i / 2), -row - 1.0 + 0.5 * (i % 2), 0.0));
+    }
+    strips->InsertNextCell(static_cast<vtkIdType>(pts.size()), pts.data());
+  }
+
+  const vtkIdType numCells = polys->GetNumberOfCells() + strips->GetNumberOfCells();
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    ids->InsertNextValue(cellId);
+  }
+
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->SetPolys(polys);
+  input->SetStrips(strips);
+  input->GetCellData()->AddArray(ids);
+  return input;
+}
+
+// Count the progress events reported between the start and the end of the
+// execution.
+void CountProgress(vtkObject* caller, unsigned long, void* clientData, void*)
+{
+  const double progress = static_cast<vtkAlgorithm*>(caller)->GetProgress();
+  if (progress > 0.0 && progress < 1.0)
+  {
+    ++*static_cast<int*>(clientData);
+  }
+}
+
+vtkSmartPointer<vtkPolyData> Triangulate(vtkPolyData* input, int numThreads, int& numProgress)
+{
+  vtkSMPTools::Initialize(numThreads);
+  vtkNew<vtkTriangleFilter> triangles;
+  vtkNew<vtkCallbackCommand> progress;
+  progress->SetCallback(CountProgress);
+  progress->SetClientData(&numProgress);
+  triangles->AddObserver(vtkCommand::ProgressEvent, progress);
+  triangles->SetInputData(input);
+  triangles->Update();
+  vtkSmartPointer<vtkPolyData> output = triangles->GetOutput();
+  return output;
+}
+
+double Area(vtkPolyData* pd, vtkIdType npts, const vtkIdType* pts)
+{
+  double area = 0.0;
+  double x0[3], x1[3];
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    pd->GetPoint(pts[i], x0);
+    pd->GetPoint(pts[(i + 1) % npts], x1);
+    area += 0.5 * (x0[0] * x1[1] - x1[0] * x0[1]);
+  }
+  return std::abs(area);
+}
+}
+
+int TestTriangleFilter(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = CreateInput();
+  const vtkIdType numInPolys = input->GetNumberOfPolys();
+  int numProgress = 0;
+  vtkSmartPointer<vtkPolyData> serial = Triangulate(input, 1, numProgress);
+  if (numProgress == 0)
+  {
+    std::cerr << "No progress was reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkPolyData> threaded = Triangulate(input, 4, numProgress);
+  vtkSMPTools::Initialize();
+
+  // The triangles must not depend on the number of threads.
+  vtkCellArray* serialTris = serial->GetPolys();
+  vtkCellArray* threadedTris = threaded->GetPolys();
+  if (serialTris->GetNumberOfCells() != threadedTris->GetNumberOfCells())
+  {
+    std::cerr << "The number of triangles depends on the number of threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType cellId = 0; cellId < serialTris->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts0, npts1;
+    const vtkIdType *pts0, *pts1;
+    serialTris->GetCellAtId(cellId, npts0, pts0);
+    threadedTris->GetCellAtId(cellId, npts1, pts1);
+    if (npts0 != 3 || npts1 != 3 || !std::equal(pts0, pts0 + 3, pts1))
+    {
+      std::cerr << "Triangle " << cellId << " depends on the number of threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Every input cell must be covered by npts-2 triangles carrying its cell
+  // data, which use its points and cover its area.
+  vtkIdTypeArray* ids =
+    vtkIdTypeArray::SafeDownCast(threaded->GetCellData()->GetArray("InputIds"));
+  if (!ids || ids->GetNumberOfTuples() != threadedTris->GetNumberOfCells())
+  {
+    std::cerr << "Missing cell data" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<vtkIdType> numTris(input->GetNumberOfCells(), 0);
+  std::vector<double> area(input->GetNumberOfCells(), 0.0);
+  vtkNew<vtkIdList> cellPts;
+  for (vtkIdType cellId = 0; cellId < threadedTris->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    threadedTris->GetCellAtId(cellId, npts, pts);
+    const vtkIdType inCellId = ids->GetValue(cellId);
+    input->GetCellPoints(inCellId, cellPts);
+    for (vtkIdType i = 0; i < 3; ++i)
+    {
+      if (cellPts->IsId(pts[i]) < 0)
+      {
+        std::cerr << "Triangle " << cellId << " does not match the cell data" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    ++numTris[inCellId];
+    area[inCellId] += Area(threaded, npts, pts);
+  }
+  for (vtkIdType inCellId = 0; inCellId < input->GetNumberOfCells(); ++inCellId)
+  {
+    input->GetCellPoints(inCellId, cellPts);
+    const vtkIdType npts = cellPts->GetNumberOfIds();
+    if (numTris[inCellId] != npts - 2)
+    {
+      std::cerr << "Cell " << inCellId << ": expected " << npts - 2 << " triangles, got "
+                << numTris[inCellId] << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (inCellId < numInPolys &&
+      std::abs(area[inCellId] - Area(input, npts, cellPts->GetPointer(0))) > 1e-6)
+    {
+      std::cerr << "Cell " << inCellId << ": the triangles do not cover the polygon" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
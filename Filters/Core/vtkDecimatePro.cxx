@@ -10,12 +10,16 @@
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPartitionedDecimationInternal.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <cmath>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDecimatePro);
 
@@ -73,9 +77,13 @@ vtkDecimatePro::vtkDecimatePro()
   this->BoundaryVertexDeletion = 1;
   this->InflectionPointRatio = 10.0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->PartitionedDecimation = 0;
+  this->NumberOfPartitions = 0;
 
   this->Queue = nullptr;
   this->VertexError = nullptr;
+  this->LockedPoints = nullptr;
+  this->NumberOfLockedPoints = 0;
 
   this->Mesh = nullptr;
 }
@@ -113,6 +121,140 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+  vtkIdType numPts, numTris;
+  if (!input)
+  {
+    vtkErrorMacro(<< "No input!");
+    return 1;
+  }
+
+  vtkDebugMacro(<< "Executing progressive decimation...");
+
+  // Check input
+  this->NumberOfRemainingTris = numTris = input->GetNumberOfPolys();
+  if (((numPts = input->GetNumberOfPoints()) < 1 || numTris < 1) && (this->TargetReduction > 0.0))
+  {
+    vtkErrorMacro(<< "No data to decimate!");
+    return 1;
+  }
+
+  // Lets check to make sure there are only triangles in the input.
+  {
+    const vtkIdType cellSize = input->GetPolys()->IsHomogeneous();
+    if (cellSize != 3)
+    {
+      vtkErrorMacro("DecimatePro does not accept polygons that are not triangles.");
+      output->CopyStructure(input);
+      output->GetPointData()->PassData(input->GetPointData());
+      output->GetCellData()->PassData(input->GetCellData());
+      return 1;
+    }
+  }
+
+  if (this->TargetReduction <= 0.0)
+  {
+    output->CopyStructure(input);
+    output->GetPointData()->PassData(input->GetPointData());
+    output->GetCellData()->PassData(input->GetCellData());
+    // vtkWarningMacro(<<"Reduction == 0: passing data through unchanged");
+    return 1;
+  }
+
+  if (this->PartitionedDecimation)
+  {
+    int numParts = GetNumberOfDecimationPartitions(numTris, this->NumberOfPartitions);
+    if (numParts > 1)
+    {
+      return this->RequestPartitionedData(input, output, numParts);
+    }
+  }
+
+  this->DecimateMesh(input, this->TargetReduction, input->GetBounds(), nullptr);
+  this->CopyMeshToOutput(output);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkDecimatePro::RequestPartitionedData(vtkPolyData* input, vtkPolyData* output, int numParts)
+{
+  const vtkIdType numTris = input->GetNumberOfPolys();
+
+  // The error and tolerances are relative to the bounds of the whole input,
+  // so that they do not depend on the partitioning.
+  double bounds[6];
+  input->GetBounds(bounds);
+
+  vtkDebugMacro(<< "Decimating " << numParts << " partitions");
+  DecimationPartitions parts;
+  BuildDecimationPartitions(input, numParts, parts);
+  this->UpdateProgress(0.05);
+
+  // Decimate the partitions concurrently, leaving the seams untouched. Each
+  // partition is decimated by its own instance of this filter.
+  std::vector<DecimatedPartition> decimated(numParts);
+  vtkSMPTools::For(0, numParts, 1, [&](vtkIdType part, vtkIdType endPart) {
+    std::vector<unsigned char> lockedPoints;
+    for (; part < endPart; ++part)
+    {
+      vtkSmartPointer<vtkPolyData> mesh = ExtractDecimationPartition(
+        input, parts, static_cast<int>(part), true, decimated[part].PointMap, lockedPoints);
+
+      vtkNew<vtkDecimatePro> decimator;
+      decimator->CopyParameters(this);
+      decimator->DecimateMesh(mesh, this->TargetReduction, bounds, lockedPoints.data());
+      decimator->Mesh->DeleteLinks();
+      decimated[part].Mesh.TakeReference(decimator->Mesh);
+      decimator->Mesh = nullptr;
+    }
+  });
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+  this->UpdateProgress(0.8);
+
+  // Stitch the partitions together and decimate across the seams, asking for
+  // what is left of the requested reduction.
+  vtkSmartPointer<vtkPolyData> merged = MergeDecimationPartitions(input, parts, decimated, true);
+  decimated.clear();
+  const vtkIdType numMergedTris = merged->GetNumberOfPolys();
+  if (numMergedTris < 1)
+  {
+    output->ShallowCopy(merged);
+    return 1;
+  }
+  double reduction = 1.0 - (1.0 - this->TargetReduction) * numTris / numMergedTris;
+  reduction = vtkMath::ClampValue(reduction, 0.0, 1.0);
+  this->NumberOfRemainingTris = numMergedTris;
+  this->DecimateMesh(merged, reduction, bounds, nullptr);
+  this->CopyMeshToOutput(output);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkDecimatePro::CopyParameters(vtkDecimatePro* decimator)
+{
+  this->FeatureAngle = decimator->FeatureAngle;
+  this->MaximumError = decimator->MaximumError;
+  this->AbsoluteError = decimator->AbsoluteError;
+  this->ErrorIsAbsolute = decimator->ErrorIsAbsolute;
+  this->AccumulateError = decimator->AccumulateError;
+  this->SplitAngle = decimator->SplitAngle;
+  this->Splitting = decimator->Splitting;
+  this->PreSplitMesh = decimator->PreSplitMesh;
+  this->BoundaryVertexDeletion = decimator->BoundaryVertexDeletion;
+  this->PreserveTopology = decimator->PreserveTopology;
+  this->Degree = decimator->Degree;
+  this->InflectionPointRatio = decimator->InflectionPointRatio;
+  this->OutputPointsPrecision = decimator->OutputPointsPrecision;
+}
+
+//------------------------------------------------------------------------------
+void vtkDecimatePro::DecimateMesh(vtkPolyData* input, double targetReduction,
+  const double bounds[6], const unsigned char* lockedPoints)
+{
   vtkIdType i, ptId, numPts, numTris, collapseId;
   vtkPoints* inPts;
   vtkPoints* newPts;
@@ -121,40 +263,25 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
   double error, previousError = 0.0, reduction;
   int type;
   vtkIdType npts;
-  const vtkIdType* pts;
   vtkIdType totalEliminated, numRecycles, numPops;
   vtkIdType ncells;
-  vtkIdType pt1, pt2, cellId, fedges[2];
+  vtkIdType pt1, pt2, fedges[2];
   vtkIdType* cells;
   vtkIdList* CollapseTris;
-  double max;
-  if (!input)
-  {
-    vtkErrorMacro(<< "No input!");
-    return 1;
-  }
-  vtkPointData* outputPD = output->GetPointData();
+  double max, length;
   vtkPointData* inPD = input->GetPointData();
   vtkPointData* meshPD = nullptr;
-  vtkIdType *map, numNewPts, totalPts;
-  vtkIdType newCellPts[3];
+  vtkIdType totalPts;
   bool abortExecute = false;
 
-  vtkDebugMacro(<< "Executing progressive decimation...");
-
-  // Check input
   this->NumberOfRemainingTris = numTris = input->GetNumberOfPolys();
-  if (((numPts = input->GetNumberOfPoints()) < 1 || numTris < 1) && (this->TargetReduction > 0.0))
-  {
-    vtkErrorMacro(<< "No data to decimate!");
-    return 1;
-  }
+  numPts = input->GetNumberOfPoints();
 
   // Initialize
-  const double* bounds = input->GetBounds();
-  for (max = 0.0, i = 0; i < 3; i++)
+  for (max = 0.0, length = 0.0, i = 0; i < 3; i++)
   {
     max = ((bounds[2 * i + 1] - bounds[2 * i]) > max ? (bounds[2 * i + 1] - bounds[2 * i]) : max);
+    length += (bounds[2 * i + 1] - bounds[2 * i]) * (bounds[2 * i + 1] - bounds[2 * i]);
   }
   if (!this->ErrorIsAbsolute)
   {
@@ -165,81 +292,59 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
   {
     this->Error = (this->AbsoluteError >= VTK_DOUBLE_MAX ? VTK_DOUBLE_MAX : this->AbsoluteError);
   }
-  this->Tolerance = VTK_TOLERANCE * input->GetLength();
+  this->Tolerance = VTK_TOLERANCE * std::sqrt(length);
   this->CosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
   this->Split = (this->Splitting && !this->PreserveTopology);
   this->VertexDegree = this->Degree;
   this->TheSplitAngle = this->SplitAngle;
   this->SplitState = VTK_STATE_UNSPLIT;
-
-  // Lets check to make sure there are only triangles in the input.
-  {
-    const vtkIdType cellSize = input->GetPolys()->IsHomogeneous();
-    if (cellSize != 3)
-    {
-      vtkErrorMacro("DecimatePro does not accept polygons that are not triangles.");
-      output->CopyStructure(input);
-      output->GetPointData()->PassData(input->GetPointData());
-      output->GetCellData()->PassData(input->GetCellData());
-      return 1;
-    }
-  }
+  this->LockedPoints = lockedPoints;
+  this->NumberOfLockedPoints = lockedPoints ? numPts : 0;
 
   // Build cell data structure. Need to copy triangle connectivity data
   // so we can modify it.
-  if (this->TargetReduction > 0.0)
-  {
-    inPts = input->GetPoints();
-    inPolys = input->GetPolys();
+  inPts = input->GetPoints();
+  inPolys = input->GetPolys();
 
-    // this static should be eliminated
-    if (this->Mesh != nullptr)
-    {
-      this->Mesh->Delete();
-      this->Mesh = nullptr;
-    }
-    this->Mesh = vtkPolyData::New();
+  // this static should be eliminated
+  if (this->Mesh != nullptr)
+  {
+    this->Mesh->Delete();
+    this->Mesh = nullptr;
+  }
+  this->Mesh = vtkPolyData::New();
 
-    newPts = vtkPoints::New();
+  newPts = vtkPoints::New();
 
-    if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-    {
-      newPts->SetDataType(inPts->GetDataType());
-    }
-    else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-    {
-      newPts->SetDataType(VTK_FLOAT);
-    }
-    else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-    {
-      newPts->SetDataType(VTK_DOUBLE);
-    }
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
 
-    newPts->SetNumberOfPoints(numPts);
-    newPts->DeepCopy(inPts);
-    this->Mesh->SetPoints(newPts);
-    newPts->Delete(); // registered by Mesh and preserved
+  newPts->SetNumberOfPoints(numPts);
+  newPts->DeepCopy(inPts);
+  this->Mesh->SetPoints(newPts);
+  newPts->Delete(); // registered by Mesh and preserved
 
-    newPolys = vtkCellArray::New();
-    newPolys->DeepCopy(inPolys);
-    this->Mesh->SetPolys(newPolys);
-    newPolys->Delete(); // registered by Mesh and preserved
+  newPolys = vtkCellArray::New();
+  newPolys->DeepCopy(inPolys);
+  this->Mesh->SetPolys(newPolys);
+  newPolys->Delete(); // registered by Mesh and preserved
 
-    meshPD = this->Mesh->GetPointData();
-    meshPD->DeepCopy(inPD);
-    meshPD->CopyAllocate(meshPD, input->GetNumberOfPoints());
+  meshPD = this->Mesh->GetPointData();
+  meshPD->DeepCopy(inPD);
+  meshPD->CopyAllocate(meshPD, input->GetNumberOfPoints());
 
-    this->Mesh->EditableOn();
-    this->Mesh->BuildLinks();
-  }
-  else
-  {
-    output->CopyStructure(input);
-    output->GetPointData()->PassData(input->GetPointData());
-    output->GetCellData()->PassData(input->GetCellData());
-    // vtkWarningMacro(<<"Reduction == 0: passing data through unchanged");
-    return 1;
-  }
+  this->Mesh->EditableOn();
+  this->Mesh->BuildLinks();
 
   // Initialize data structures: priority queue and errors.
   this->InitializeQueue(numPts);
@@ -293,13 +398,12 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
   // (While this is happening we keep track of operations on the data -
   // this forms the core of the progressive mesh representation.)
   for (totalEliminated = 0, reduction = 0.0, numRecycles = 0, numPops = 0;
-       reduction < this->TargetReduction && (ptId = this->Pop(error)) >= 0 && !abortExecute;
-       numPops++)
+       reduction < targetReduction && (ptId = this->Pop(error)) >= 0 && !abortExecute; numPops++)
   {
     if (numPops && !(numPops % 5000))
     {
       vtkDebugMacro(<< "Deleting vertex #" << numPops);
-      this->UpdateProgress(0.25 + 0.75 * (reduction / this->TargetReduction));
+      this->UpdateProgress(0.25 + 0.75 * (reduction / targetReduction));
       abortExecute = this->CheckAbort();
     }
 
@@ -358,14 +462,40 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
                 << "\n\tAdded " << totalPts - numPts << " points (" << numPts << " to " << totalPts
                 << " points)");
 
+  this->DeleteQueue();
+  if (this->VertexError)
+  {
+    this->VertexError->Delete();
+    this->VertexError = nullptr;
+  }
+  this->LockedPoints = nullptr;
+  this->NumberOfLockedPoints = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkDecimatePro::CopyMeshToOutput(vtkPolyData* output)
+{
+  vtkIdType i, ptId, cellId;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType ncells;
+  vtkIdType* cells;
+  vtkIdType *map, numNewPts, totalPts;
+  vtkIdType newCellPts[3];
+  vtkPointData* outputPD = output->GetPointData();
+  vtkPointData* meshPD = this->Mesh->GetPointData();
+  vtkPoints* newPts = this->Mesh->GetPoints();
+  vtkIdType numTris = this->Mesh->GetNumberOfPolys();
+  vtkCellArray* newPolys;
+
   //
   // Create output and release memory
   //
   vtkDebugMacro(<< "Creating output...");
-  this->DeleteQueue();
 
   // Grab the points that are left; copy point data. Remember that splitting
   // data may have added new points.
+  totalPts = this->Mesh->GetNumberOfPoints();
   map = new vtkIdType[totalPts];
   for (i = 0; i < totalPts; i++)
   {
@@ -398,7 +528,7 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
 
   // Now renumber connectivity
   newPolys = vtkCellArray::New();
-  newPolys->AllocateEstimate(numTris - totalEliminated, 3);
+  newPolys->AllocateEstimate(this->NumberOfRemainingTris, 3);
 
   for (cellId = 0; cellId < numTris; cellId++)
   {
@@ -422,8 +552,6 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
     this->Mesh = nullptr;
   }
   newPolys->Delete();
-
-  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -468,6 +596,10 @@ void vtkDecimatePro::SplitMesh()
   this->CosAngle = cos(vtkMath::RadiansFromDegrees(this->SplitAngle));
   for (ptId = 0; ptId < this->Mesh->GetNumberOfPoints(); ptId++)
   {
+    if (ptId < this->NumberOfLockedPoints && this->LockedPoints[ptId])
+    {
+      continue;
+    }
     this->Mesh->GetPoint(ptId, this->X);
     this->Mesh->GetPointCells(ptId, ncells, cells);
 
@@ -1593,6 +1725,12 @@ void vtkDecimatePro::Insert(vtkIdType ptId, double error)
   vtkIdType fedges[2];
   vtkIdType ncells;
 
+  // locked points are never deleted nor split
+  if (ptId < this->NumberOfLockedPoints && this->LockedPoints[ptId])
+  {
+    return;
+  }
+
   // on value of error, we need to compute it or just insert the point
   if (error < -this->Tolerance)
   {
@@ -1736,5 +1874,8 @@ void vtkDecimatePro::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Inflection Points: " << this->GetNumberOfInflectionPoints() << "\n";
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+
+  os << indent << "Partitioned Decimation: " << (this->PartitionedDecimation ? "On\n" : "Off\n");
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
 }
 VTK_ABI_NAMESPACE_END
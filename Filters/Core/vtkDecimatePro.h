@@ -274,12 +274,69 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the parallel decimation of large meshes. When on, the
+   * triangles are split into spatially coherent partitions (using a balanced
+   * k-d tree built on the triangle centroids) which are decimated
+   * concurrently using vtkSMPTools. The points shared by several partitions
+   * (the seams) are neither deleted nor split during this step. A final
+   * serial pass then decimates the merged mesh across the seams to reach the
+   * TargetReduction. The MaximumError is relative to the bounds of the whole
+   * input in both passes; however, when AccumulateError is on, the error
+   * accumulated in the partitions is not carried over to the final pass, and
+   * the inflection points are the ones of the final pass only. By default
+   * this is off.
+   */
+  vtkSetMacro(PartitionedDecimation, vtkTypeBool);
+  vtkGetMacro(PartitionedDecimation, vtkTypeBool);
+  vtkBooleanMacro(PartitionedDecimation, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of partitions used when PartitionedDecimation is on.
+   * If set to 0 (the default), the estimated number of threads of
+   * vtkSMPTools is used. The number of partitions is reduced for small
+   * meshes, and the mesh is decimated serially when a single partition is
+   * left.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
 protected:
   vtkDecimatePro();
   ~vtkDecimatePro() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Decimate the triangles of input into the working mesh until
+   * targetReduction is reached. The error is relative to the given bounds.
+   * The points flagged in lockedPoints (if not null) are never deleted nor
+   * split.
+   */
+  void DecimateMesh(vtkPolyData* input, double targetReduction, const double bounds[6],
+    const unsigned char* lockedPoints);
+
+  /**
+   * Copy the triangles left in the working mesh to output and release the
+   * working mesh.
+   */
+  void CopyMeshToOutput(vtkPolyData* output);
+
+  /**
+   * Decimate numParts partitions of input concurrently, then decimate across
+   * the partition seams. See PartitionedDecimation.
+   */
+  int RequestPartitionedData(vtkPolyData* input, vtkPolyData* output, int numParts);
+
+  /**
+   * Copy the decimation parameters of another instance.
+   */
+  void CopyParameters(vtkDecimatePro* decimator);
+
   double TargetReduction;
   double FeatureAngle;
   double MaximumError;
@@ -295,6 +352,8 @@ protected:
   double InflectionPointRatio;
   vtkDoubleArray* InflectionPoints;
   int OutputPointsPrecision;
+  vtkTypeBool PartitionedDecimation;
+  int NumberOfPartitions;
 
   // to replace a static object
   vtkIdList* Neighbors;
@@ -412,6 +471,8 @@ private:
   double TheSplitAngle;            // Split angle
   int SplitState;                  // State of the splitting process
   double Error;                    // Maximum allowable surface error
+  const unsigned char* LockedPoints; // Points that must not be deleted (may be null)
+  vtkIdType NumberOfLockedPoints;    // Number of entries in LockedPoints
 
   vtkDecimatePro(const vtkDecimatePro&) = delete;
   void operator=(const vtkDecimatePro&) = delete;
@@ -56,7 +56,8 @@
  * problems are present, you will see a warning message to this effect at
  * the end of the triangulation process. Note also that the
  * RandomPointInsertion mode can be set which will insert the points in
- * pseudo-random order.
+ * pseudo-random order, and the SpatialPointInsertion mode which will insert
+ * the points in a spatially coherent order.
  *
  * To create constrained meshes, you must define an additional
  * input. This input is an instance of vtkPolyData which contains
@@ -255,6 +256,22 @@ public:
   vtkBooleanMacro(RandomPointInsertion, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in a spatially coherent order. When
+   * on, the points are split into rounds of increasing size, and each round is
+   * sorted along a Hilbert curve (a biased randomized insertion order). The
+   * sort keys are computed (and sorted) in parallel with vtkSMPTools. Since
+   * the search for the triangle containing a point starts from the last
+   * modified triangle, this keeps the searches short and usually speeds up the
+   * triangulation of large point sets significantly. This option takes
+   * precedence over RandomPointInsertion. By default this is off.
+   */
+  vtkSetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatialPointInsertion, vtkTypeBool);
+  ///@}
+
 protected:
   vtkDelaunay2D();
 
@@ -265,6 +282,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   vtkTypeBool RandomPointInsertion;
+  vtkTypeBool SpatialPointInsertion;
 
   // Transform input points (if necessary)
   vtkSmartPointer<vtkAbstractTransform> Transform;
@@ -3,6 +3,7 @@
 
 #include "vtkDelaunay3D.h"
 
+#include "vtkDelaunaySpatialSortInternal.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
 #include "vtkIncrementalPointLocator.h"
@@ -17,6 +18,8 @@
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDelaunay3D);
 
@@ -127,6 +130,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SpatialPointInsertion = 0;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
   this->References = nullptr;
@@ -138,6 +142,8 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->Faces->Allocate(15);
   this->CheckedTetras = vtkIdList::New();
   this->CheckedTetras->Allocate(25);
+  this->WalkFromLastTetra = false;
+  this->LastTetra = -1;
 }
 
 //------------------------------------------------------------------------------
@@ -193,26 +199,38 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
     return 0;
   }
 
-  closestPoint = locator->FindClosestInsertedPoint(x);
-  vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetLinks());
-  int numCells = links->GetNcells(closestPoint);
-  vtkIdType* cells = links->GetCells(closestPoint);
-  if (numCells <= 0) // shouldn't happen
-  {
-    this->NumberOfDegeneracies++;
-    return 0;
-  }
-  else
+  // When points are inserted in a spatially coherent order, the last
+  // created tetra is usually close to the point: walk from there. If the
+  // walk fails, fall back to the closest inserted point.
+  tetraId = -1;
+  if (this->WalkFromLastTetra && this->LastTetra >= 0)
   {
-    tetraId = cells[0];
+    tetraId = this->FindTetra(Mesh, xd, this->LastTetra, 0);
   }
 
-  // Okay, walk towards the containing tetrahedron
-  tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
   if (tetraId < 0)
   {
-    this->NumberOfDegeneracies++;
-    return 0;
+    closestPoint = locator->FindClosestInsertedPoint(x);
+    vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetLinks());
+    int numCells = links->GetNcells(closestPoint);
+    vtkIdType* cells = links->GetCells(closestPoint);
+    if (numCells <= 0) // shouldn't happen
+    {
+      this->NumberOfDegeneracies++;
+      return 0;
+    }
+    else
+    {
+      tetraId = cells[0];
+    }
+
+    // Okay, walk towards the containing tetrahedron
+    tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
+    if (tetraId < 0)
+    {
+      this->NumberOfDegeneracies++;
+      return 0;
+    }
   }
 
   // Initialize the list of tetras who contain the point according
@@ -481,20 +499,30 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
 
   Mesh = this->InitPointInsertion(center, this->Offset * tol, numPoints, points);
 
+  // The points may be inserted in the given order, or in a spatially
+  // coherent order (computed in parallel).
+  std::vector<vtkIdType> insertionOrder;
+  if (this->SpatialPointInsertion)
+  {
+    ComputeSpatialInsertionOrder(inPoints, numPoints, 3, insertionOrder);
+  }
+  this->WalkFromLastTetra = (this->SpatialPointInsertion != 0);
+
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  for (vtkIdType idx = 0; idx < numPoints; idx++)
   {
+    ptId = (this->SpatialPointInsertion ? insertionOrder[idx] : idx);
     inPoints->GetPoint(ptId, x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
+    if (!(idx % 250))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << idx);
+      this->UpdateProgress(static_cast<double>(idx) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -503,6 +531,8 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
 
   } // for all points
 
+  this->WalkFromLastTetra = false;
+
   this->EndPointInsertion();
 
   vtkDebugMacro(<< "Triangulated " << numPoints << " points, " << this->NumberOfDuplicatePoints
@@ -779,6 +809,7 @@ vtkUnstructuredGrid* vtkDelaunay3D::InitPointInsertion(
   vtkIdType pts[4];
   vtkUnstructuredGrid* Mesh = vtkUnstructuredGrid::New();
   Mesh->EditableOn();
+  this->LastTetra = -1;
 
   if (numPtsToInsert == 0)
   {
@@ -870,6 +901,7 @@ vtkUnstructuredGrid* vtkDelaunay3D::InitPointInsertion(
   pts[3] = numPtsToInsert;
   tetraId = Mesh->InsertNextCell(VTK_TETRA, 4, pts);
   this->InsertTetra(Mesh, points, tetraId);
+  this->LastTetra = tetraId;
 
   Mesh->SetPoints(points);
   points->Delete();
@@ -952,6 +984,7 @@ void vtkDelaunay3D::InsertPoint(
       }
 
       this->InsertTetra(Mesh, points, tetraId);
+      this->LastTetra = tetraId;
 
     } // for each face
 
@@ -1051,6 +1084,7 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Spatial Point Insertion: " << (this->SpatialPointInsertion ? "On\n" : "Off\n");
 
   if (this->Locator)
   {
@@ -186,6 +186,24 @@ public:
   vtkBooleanMacro(BoundingTriangulation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in given order, or in a spatially
+   * coherent order. When on, the insertion order is a biased randomized
+   * insertion order (BRIO): the points are split into rounds of increasing
+   * size, and each round is sorted along a Hilbert curve. The sort keys are
+   * computed (and sorted) in parallel with vtkSMPTools, and the search for the
+   * tetrahedron enclosing a point starts from the last created tetrahedron
+   * instead of a locator query. This usually speeds up the triangulation of
+   * large point sets significantly. In general position the triangulation is
+   * the same as in the given order; in degenerate cases (e.g., points on a
+   * lattice, coincident points) it may differ. By default this is off.
+   */
+  vtkSetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatialPointInsertion, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -267,6 +285,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  vtkTypeBool SpatialPointInsertion;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -290,6 +309,8 @@ private:                    // members added for performance
   vtkIdList* Tetras;        // used in InsertPoint
   vtkIdList* Faces;         // used in InsertPoint
   vtkIdList* CheckedTetras; // used by InsertPoint
+  bool WalkFromLastTetra;   // start the search of enclosing tetras from LastTetra
+  vtkIdType LastTetra;      // last tetra created by InsertPoint
 
   vtkDelaunay3D(const vtkDelaunay3D&) = delete;
   void operator=(const vtkDelaunay3D&) = delete;
@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkDelaunaySpatialSortInternal
+ * @brief   spatially coherent point insertion order for the Delaunay filters
+ *
+ * vtkDelaunaySpatialSortInternal computes a biased randomized insertion
+ * order (BRIO) of a set of points, used by vtkDelaunay2D and vtkDelaunay3D
+ * when SpatialPointInsertion is enabled. The points are distributed into
+ * rounds of geometrically increasing size: a point belongs to the last round
+ * with probability 1/2, to the one before with probability 1/4, and so on.
+ * Within each round the points are ordered along a Hilbert curve. Randomizing
+ * the rounds keeps the expected cost of the incremental insertion low, while
+ * the Hilbert ordering guarantees that consecutive points are close to each
+ * other, so that the search for the enclosing simplex (a walk starting from
+ * the last inserted simplex) is short and memory accesses remain coherent.
+ *
+ * The pseudo-random round of a point only depends on its id, so the order is
+ * deterministic. The sort keys are computed and sorted with vtkSMPTools.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkDelaunay2D vtkDelaunay3D
+ */
+
+#ifndef vtkDelaunaySpatialSortInternal_h
+#define vtkDelaunaySpatialSortInternal_h
+
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Number of bits per axis of the Hilbert curve.
+constexpr int VTK_HILBERT_BITS = 16;
+
+// Rounds are not subdivided below this number of points.
+constexpr vtkIdType VTK_MINIMUM_POINTS_PER_ROUND = 256;
+
+// Maps the coordinates of a cell of a 2^VTK_HILBERT_BITS grid (in dim
+// dimensions) to its index along the Hilbert curve. See J. Skilling,
+// "Programming the Hilbert curve", AIP Conference Proceedings 707, 2004.
+inline std::uint64_t HilbertIndex(std::uint32_t X[3], int dim)
+{
+  const std::uint32_t M = 1u << (VTK_HILBERT_BITS - 1);
+  std::uint32_t t;
+
+  // Inverse undo
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    const std::uint32_t P = Q - 1;
+    for (int i = 0; i < dim; ++i)
+    {
+      if (X[i] & Q)
+      {
+        X[0] ^= P;
+      }
+      else
+      {
+        t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (int i = 1; i < dim; ++i)
+  {
+    X[i] ^= X[i - 1];
+  }
+  t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    if (X[dim - 1] & Q)
+    {
+      t ^= Q - 1;
+    }
+  }
+  for (int i = 0; i < dim; ++i)
+  {
+    X[i] ^= t;
+  }
+
+  // Interleave the transposed bits into a single index
+  std::uint64_t index = 0;
+  for (int b = VTK_HILBERT_BITS - 1; b >= 0; --b)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      index = (index << 1) | ((X[i] >> b) & 1u);
+    }
+  }
+  return index;
+}
+
+// Cheap, well mixed hash of a point id (splitmix64 finalizer).
+inline std::uint64_t HashPointId(vtkIdType ptId)
+{
+  std::uint64_t z = static_cast<std::uint64_t>(ptId) + 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+// Compute the BRIO sort key of each point: the round in the upper bits, the
+// Hilbert index within the round in the lower bits.
+struct ComputeSpatialSortKeys
+{
+  vtkPoints* Points;
+  int Dimension;
+  int NumberOfLevels;
+  double Origin[3];
+  double Scale[3];
+  std::vector<std::pair<std::uint64_t, vtkIdType>>& Keys;
+
+  ComputeSpatialSortKeys(vtkPoints* points, int dim, int numLevels, const double bounds[6],
+    std::vector<std::pair<std::uint64_t, vtkIdType>>& keys)
+    : Points(points)
+    , Dimension(dim)
+    , NumberOfLevels(numLevels)
+    , Keys(keys)
+  {
+    const double maxCoord = static_cast<double>((1u << VTK_HILBERT_BITS) - 1);
+    for (int i = 0; i < 3; ++i)
+    {
+      const double length = bounds[2 * i + 1] - bounds[2 * i];
+      this->Origin[i] = bounds[2 * i];
+      this->Scale[i] = (length > 0.0 ? maxCoord / length : 0.0);
+    }
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    const double maxCoord = static_cast<double>((1u << VTK_HILBERT_BITS) - 1);
+    double x[3];
+    std::uint32_t X[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      for (int i = 0; i < this->Dimension; ++i)
+      {
+        double c = (x[i] - this->Origin[i]) * this->Scale[i];
+        c = (c < 0.0 ? 0.0 : (c > maxCoord ? maxCoord : c));
+        X[i] = static_cast<std::uint32_t>(c);
+      }
+
+      // The level of a point is the number of trailing zeros of its hash,
+      // that is level >= k with probability 2^-k. Points with the highest
+      // levels are inserted first.
+      std::uint64_t hash = HashPointId(ptId);
+      int level = 0;
+      while (level < this->NumberOfLevels && !(hash & 1u))
+      {
+        hash >>= 1;
+        ++level;
+      }
+      const std::uint64_t round = static_cast<std::uint64_t>(this->NumberOfLevels - level);
+
+      this->Keys[ptId].first = (round << 56) | HilbertIndex(X, this->Dimension);
+      this->Keys[ptId].second = ptId;
+    }
+  }
+};
+
+// Compute the order in which the given points should be inserted into a
+// Delaunay triangulation. Only the first dim (2 or 3) coordinates are used.
+inline void ComputeSpatialInsertionOrder(
+  vtkPoints* points, vtkIdType numPts, int dim, std::vector<vtkIdType>& order)
+{
+  double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  if (numPts > 0)
+  {
+    double x[3];
+    points->GetPoint(0, x);
+    bounds[0] = bounds[1] = x[0];
+    bounds[2] = bounds[3] = x[1];
+    bounds[4] = bounds[5] = x[2];
+  }
+  for (vtkIdType ptId = 1; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    for (int i = 0; i < 3; ++i)
+    {
+      bounds[2 * i] = (x[i] < bounds[2 * i] ? x[i] : bounds[2 * i]);
+      bounds[2 * i + 1] = (x[i] > bounds[2 * i + 1] ? x[i] : bounds[2 * i + 1]);
+    }
+  }
+
+  // The first round holds about VTK_MINIMUM_POINTS_PER_ROUND points.
+  int numLevels = 0;
+  for (vtkIdType n = numPts; n > 2 * VTK_MINIMUM_POINTS_PER_ROUND && numLevels < 24; n /= 2)
+  {
+    ++numLevels;
+  }
+
+  std::vector<std::pair<std::uint64_t, vtkIdType>> keys(numPts);
+  ComputeSpatialSortKeys computeKeys(points, dim, numLevels, bounds, keys);
+  vtkSMPTools::For(0, numPts, computeKeys);
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  order.resize(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType idx, vtkIdType endIdx) {
+    for (; idx < endIdx; ++idx)
+    {
+      order[idx] = keys[idx].second;
+    }
+  });
+}
+
+} // anonymous namespace
+
+#endif // vtkDelaunaySpatialSortInternal_h
+// VTK-HeaderTest-Exclude: vtkDelaunaySpatialSortInternal.h
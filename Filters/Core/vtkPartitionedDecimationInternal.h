@@ -0,0 +1,443 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPartitionedDecimationInternal
+ * @brief   spatial partitioning support for the triangle decimation filters
+ *
+ * vtkPartitionedDecimationInternal provides the machinery shared by
+ * vtkQuadricDecimation and vtkDecimatePro to decimate a large triangle mesh
+ * in parallel. The triangles are split into spatially coherent partitions by
+ * recursive median bisection of their centroids (i.e., a balanced k-d tree
+ * built on the triangles). Points used by triangles of more than one
+ * partition are seam points. Each partition is extracted as a standalone
+ * mesh together with a mask of its locked (seam) points, so that it can be
+ * decimated independently without modifying the seams. Finally the
+ * decimated partitions are merged back into a single mesh, stitching the
+ * partitions together through their seam points.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkQuadricDecimation vtkDecimatePro
+ */
+
+#ifndef vtkPartitionedDecimationInternal_h
+#define vtkPartitionedDecimationInternal_h
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Partitions smaller than this are not worth the overhead of partitioning.
+constexpr vtkIdType VTK_MINIMUM_TRIANGLES_PER_PARTITION = 1000;
+
+// Owner of a point used by the triangles of several partitions.
+constexpr int VTK_SEAM_POINT = -2;
+
+struct DecimationPartitions
+{
+  // Input cell ids of the triangles, sorted by partition. The triangles of
+  // partition p are Triangles[Offsets[p]] to Triangles[Offsets[p+1]-1].
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Triangles;
+
+  // For each input point, the partition using it, VTK_SEAM_POINT if it is
+  // used by several partitions, or -1 if it is not used at all.
+  std::vector<int> PointOwner;
+
+  // For each point owned by a single partition, its id in that partition.
+  std::vector<vtkIdType> LocalIds;
+
+  int GetNumberOfPartitions() const { return static_cast<int>(this->Offsets.size()) - 1; }
+};
+
+// The result of the decimation of a partition: the decimated mesh (deleted
+// triangles are no longer of type VTK_TRIANGLE) and the map from the mesh
+// point ids to the input point ids. Points created during the decimation
+// (e.g. by vertex splitting) are not in the map.
+struct DecimatedPartition
+{
+  vtkSmartPointer<vtkPolyData> Mesh;
+  std::vector<vtkIdType> PointMap;
+};
+
+// Compute the number of partitions to use for a mesh.
+inline int GetNumberOfDecimationPartitions(vtkIdType numTris, int requestedPartitions)
+{
+  vtkIdType numParts =
+    requestedPartitions > 0 ? requestedPartitions : vtkSMPTools::GetEstimatedNumberOfThreads();
+  numParts = std::min(numParts, numTris / VTK_MINIMUM_TRIANGLES_PER_PARTITION);
+  return static_cast<int>(std::max<vtkIdType>(numParts, 1));
+}
+
+// Recursively bisect [begin,end) along the longest axis of the triangle
+// centroids, appending the end of each leaf to offsets.
+inline void BisectTriangles(const float* centers, vtkIdType* base, vtkIdType* begin,
+  vtkIdType* end, int numParts, std::vector<vtkIdType>& offsets)
+{
+  if (numParts <= 1 || end - begin < 2)
+  {
+    offsets.push_back(end - base);
+    return;
+  }
+
+  float bmin[3] = { VTK_FLOAT_MAX, VTK_FLOAT_MAX, VTK_FLOAT_MAX };
+  float bmax[3] = { VTK_FLOAT_MIN, VTK_FLOAT_MIN, VTK_FLOAT_MIN };
+  for (vtkIdType* tri = begin; tri != end; ++tri)
+  {
+    const float* c = centers + 3 * (*tri);
+    for (int i = 0; i < 3; ++i)
+    {
+      bmin[i] = std::min(bmin[i], c[i]);
+      bmax[i] = std::max(bmax[i], c[i]);
+    }
+  }
+  int axis = 0;
+  for (int i = 1; i < 3; ++i)
+  {
+    if (bmax[i] - bmin[i] > bmax[axis] - bmin[axis])
+    {
+      axis = i;
+    }
+  }
+
+  // Partitions need not be a power of two: split the triangles in
+  // proportion to the number of partitions on each side.
+  const int leftParts = numParts / 2;
+  vtkIdType* mid = begin + (end - begin) * leftParts / numParts;
+  std::nth_element(begin, mid, end, [centers, axis](vtkIdType t0, vtkIdType t1) {
+    return centers[3 * t0 + axis] < centers[3 * t1 + axis];
+  });
+
+  BisectTriangles(centers, base, begin, mid, leftParts, offsets);
+  BisectTriangles(centers, base, mid, end, numParts - leftParts, offsets);
+}
+
+// Compute the centroids of the input triangles.
+struct ComputeTriangleCenters
+{
+  vtkPoints* Points;
+  vtkCellArray* Polys;
+  float* Centers;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  ComputeTriangleCenters(vtkPoints* pts, vtkCellArray* polys, float* centers)
+    : Points(pts)
+    , Polys(polys)
+    , Centers(centers)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double x[3];
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      double c[3] = { 0.0, 0.0, 0.0 };
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        this->Points->GetPoint(pts[i], x);
+        c[0] += x[0];
+        c[1] += x[1];
+        c[2] += x[2];
+      }
+      const double w = npts > 0 ? 1.0 / npts : 0.0;
+      float* center = this->Centers + 3 * cellId;
+      center[0] = static_cast<float>(c[0] * w);
+      center[1] = static_cast<float>(c[1] * w);
+      center[2] = static_cast<float>(c[2] * w);
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Classify the input points: owned by a single partition, or seam points.
+struct ClassifyPartitionPoints
+{
+  vtkCellArray* Polys;
+  DecimationPartitions* Partitions;
+  std::atomic<int>* Owners;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  ClassifyPartitionPoints(vtkCellArray* polys, DecimationPartitions* parts, std::atomic<int>* owners)
+    : Polys(polys)
+    , Partitions(parts)
+    , Owners(owners)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType part, vtkIdType endPart)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; part < endPart; ++part)
+    {
+      const int owner = static_cast<int>(part);
+      for (vtkIdType i = this->Partitions->Offsets[part]; i < this->Partitions->Offsets[part + 1];
+           ++i)
+      {
+        iter->GetCellAtId(this->Partitions->Triangles[i], npts, pts);
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          int current = -1;
+          if (!this->Owners[pts[j]].compare_exchange_strong(current, owner) &&
+            current != owner && current != VTK_SEAM_POINT)
+          {
+            this->Owners[pts[j]].store(VTK_SEAM_POINT);
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Split the polygons of the input into numParts spatially coherent partitions.
+inline void BuildDecimationPartitions(
+  vtkPolyData* input, int numParts, DecimationPartitions& parts)
+{
+  vtkCellArray* polys = input->GetPolys();
+  const vtkIdType numTris = polys->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // Floats are plenty to sort the triangles spatially.
+  std::vector<float> centers(3 * numTris);
+  ComputeTriangleCenters centersWorker(input->GetPoints(), polys, centers.data());
+  vtkSMPTools::For(0, numTris, centersWorker);
+
+  parts.Triangles.resize(numTris);
+  std::iota(parts.Triangles.begin(), parts.Triangles.end(), 0);
+  parts.Offsets.clear();
+  parts.Offsets.reserve(numParts + 1);
+  parts.Offsets.push_back(0);
+  vtkIdType* tris = parts.Triangles.data();
+  BisectTriangles(centers.data(), tris, tris, tris + numTris, numParts, parts.Offsets);
+
+  std::unique_ptr<std::atomic<int>[]> owners(new std::atomic<int>[numPts]);
+  vtkSMPTools::For(0, numPts, [&owners](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      owners[ptId].store(-1, std::memory_order_relaxed);
+    }
+  });
+  ClassifyPartitionPoints classifyWorker(polys, &parts, owners.get());
+  vtkSMPTools::For(0, parts.GetNumberOfPartitions(), 1, classifyWorker);
+
+  parts.PointOwner.resize(numPts);
+  parts.LocalIds.resize(numPts);
+  vtkSMPTools::For(0, numPts, [&owners, &parts](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      parts.PointOwner[ptId] = owners[ptId].load(std::memory_order_relaxed);
+      parts.LocalIds[ptId] = -1;
+    }
+  });
+}
+
+// Extract the triangles of a partition as a standalone mesh. The map from the
+// partition point ids to the input point ids and the mask of the seam points
+// (which must not be modified by the decimation) are returned as well. Only
+// the triangles of the partition are extracted. This may be invoked
+// concurrently for different partitions.
+inline vtkSmartPointer<vtkPolyData> ExtractDecimationPartition(vtkPolyData* input,
+  DecimationPartitions& parts, int part, bool copyPointData, std::vector<vtkIdType>& pointMap,
+  std::vector<unsigned char>& lockedPoints)
+{
+  vtkCellArray* polys = input->GetPolys();
+  auto iter = vtk::TakeSmartPointer(polys->NewIterator());
+  const vtkIdType beginTri = parts.Offsets[part];
+  const vtkIdType endTri = parts.Offsets[part + 1];
+
+  // Owned points are renumbered through the shared LocalIds array (each point
+  // is written by a single partition); seam points through a local map.
+  std::unordered_map<vtkIdType, vtkIdType> seamIds;
+  pointMap.clear();
+  lockedPoints.clear();
+
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->AllocateExact(endTri - beginTri, 3 * (endTri - beginTri));
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType newPts[3];
+  for (vtkIdType i = beginTri; i < endTri; ++i)
+  {
+    iter->GetCellAtId(parts.Triangles[i], npts, pts);
+    if (npts != 3)
+    {
+      continue;
+    }
+    for (int j = 0; j < 3; ++j)
+    {
+      const vtkIdType ptId = pts[j];
+      if (parts.PointOwner[ptId] == VTK_SEAM_POINT)
+      {
+        auto inserted = seamIds.insert(std::make_pair(ptId, static_cast<vtkIdType>(pointMap.size())));
+        if (inserted.second)
+        {
+          pointMap.push_back(ptId);
+          lockedPoints.push_back(1);
+        }
+        newPts[j] = inserted.first->second;
+      }
+      else
+      {
+        if (parts.LocalIds[ptId] < 0)
+        {
+          parts.LocalIds[ptId] = static_cast<vtkIdType>(pointMap.size());
+          pointMap.push_back(ptId);
+          lockedPoints.push_back(0);
+        }
+        newPts[j] = parts.LocalIds[ptId];
+      }
+    }
+    newPolys->InsertNextCell(3, newPts);
+  }
+
+  const vtkIdType numNewPts = static_cast<vtkIdType>(pointMap.size());
+  vtkPoints* inPts = input->GetPoints();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(inPts->GetDataType());
+  points->SetNumberOfPoints(numNewPts);
+  double x[3];
+  for (vtkIdType ptId = 0; ptId < numNewPts; ++ptId)
+  {
+    inPts->GetPoint(pointMap[ptId], x);
+    points->SetPoint(ptId, x);
+  }
+
+  auto mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->SetPoints(points);
+  mesh->SetPolys(newPolys);
+  if (copyPointData)
+  {
+    vtkPointData* inPD = input->GetPointData();
+    vtkPointData* outPD = mesh->GetPointData();
+    vtkNew<vtkIdList> fromIds;
+    vtkNew<vtkIdList> toIds;
+    fromIds->SetNumberOfIds(numNewPts);
+    toIds->SetNumberOfIds(numNewPts);
+    std::copy(pointMap.begin(), pointMap.end(), fromIds->GetPointer(0));
+    std::iota(toIds->GetPointer(0), toIds->GetPointer(0) + numNewPts, 0);
+    outPD->CopyAllOn();
+    outPD->CopyAllocate(inPD, numNewPts);
+    outPD->CopyData(inPD, fromIds, toIds);
+  }
+  return mesh;
+}
+
+// Merge the decimated partitions into a single mesh, stitching them together
+// through their seam points.
+inline vtkSmartPointer<vtkPolyData> MergeDecimationPartitions(vtkPolyData* input,
+  const DecimationPartitions& parts, const std::vector<DecimatedPartition>& decimated,
+  bool copyPointData)
+{
+  std::unordered_map<vtkIdType, vtkIdType> seamIds;
+  vtkIdType numTris = 0;
+  for (const auto& partition : decimated)
+  {
+    numTris += partition.Mesh->GetNumberOfCells();
+  }
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(input->GetPoints()->GetDataType());
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->AllocateEstimate(numTris, 3);
+  auto merged = vtkSmartPointer<vtkPolyData>::New();
+  vtkPointData* outPD = merged->GetPointData();
+  if (copyPointData && !decimated.empty())
+  {
+    outPD->CopyAllOn();
+    outPD->CopyAllocate(decimated[0].Mesh->GetPointData(), numTris / 2);
+  }
+
+  std::vector<vtkIdType> pointIds;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType newCellPts[3];
+  double x[3];
+  for (const auto& partition : decimated)
+  {
+    vtkPolyData* mesh = partition.Mesh;
+    vtkPointData* meshPD = mesh->GetPointData();
+    const vtkIdType numMapped = static_cast<vtkIdType>(partition.PointMap.size());
+    pointIds.assign(mesh->GetNumberOfPoints(), -1);
+    for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+    {
+      if (mesh->GetCellType(cellId) != VTK_TRIANGLE)
+      {
+        continue;
+      }
+      mesh->GetCellPoints(cellId, npts, pts);
+      for (int i = 0; i < 3; ++i)
+      {
+        const vtkIdType ptId = pts[i];
+        if (pointIds[ptId] < 0)
+        {
+          const vtkIdType inputId = ptId < numMapped ? partition.PointMap[ptId] : -1;
+          const bool isSeam = inputId >= 0 && parts.PointOwner[inputId] == VTK_SEAM_POINT;
+          auto seam = isSeam ? seamIds.find(inputId) : seamIds.end();
+          if (seam != seamIds.end())
+          {
+            pointIds[ptId] = seam->second;
+          }
+          else
+          {
+            mesh->GetPoint(ptId, x);
+            pointIds[ptId] = newPts->InsertNextPoint(x);
+            if (copyPointData)
+            {
+              outPD->CopyData(meshPD, ptId, pointIds[ptId]);
+            }
+            if (isSeam)
+            {
+              seamIds[inputId] = pointIds[ptId];
+            }
+          }
+        }
+        newCellPts[i] = pointIds[ptId];
+      }
+      newPolys->InsertNextCell(3, newCellPts);
+    }
+  }
+
+  merged->SetPoints(newPts);
+  merged->SetPolys(newPolys);
+  return merged;
+}
+
+} // anonymous namespace
+
+#endif // vtkPartitionedDecimationInternal_h
+// VTK-HeaderTest-Exclude: vtkPartitionedDecimationInternal.h
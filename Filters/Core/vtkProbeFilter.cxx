@@ -7,6 +7,7 @@
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCellLocatorStrategy.h"
+#include "vtkCellScratch.h"
 #include "vtkCharArray.h"
 #include "vtkClosestPointStrategy.h"
 #include "vtkFindCellStrategy.h"
@@ -21,7 +22,6 @@
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
 #include "vtkSMPThreadLocal.h"
-#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -890,19 +890,21 @@ public:
   {
     // make source API threadsafe by calling it once in a single thread.
     source->GetCellType(0);
-    source->GetCell(0, this->TLGenericCell.Local());
+    vtkCellScratch::Frame frame;
+    source->GetCell(0, frame.GetGenericCell());
   }
 
-  void Initialize() { this->TLWeights.Local().resize(this->MaxCellSize); }
-
   void operator()(vtkIdType cellBegin, vtkIdType cellEnd)
   {
-    double* weights = this->TLWeights.Local().data();
+    // The cell and the weights come from the thread-local scratch, so that
+    // probing does not allocate memory per cell nor per chunk of cells.
+    vtkCellScratch::Frame frame;
+    vtkGenericCell* cell = frame.GetGenericCell();
+    double* weights = frame.Allocate<double>(this->MaxCellSize);
 
     auto sourceGhostFlags = vtkUnsignedCharArray::SafeDownCast(
       this->Source->GetCellData()->GetArray(vtkDataSetAttributes::GhostArrayName()));
 
-    auto& cell = this->TLGenericCell.Local();
     bool isFirst = vtkSMPTools::GetSingleThread();
     vtkIdType checkAbortInterval = std::min((cellEnd - cellBegin) / 10 + 1, (vtkIdType)1000);
     for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
@@ -928,8 +930,6 @@ public:
     }
   }
 
-  void Reduce() {}
-
 private:
   vtkProbeFilter* ProbeFilter;
   vtkDataSet* Source;
@@ -940,9 +940,6 @@ private:
   vtkPointData* OutPointData;
   char* MaskArray;
   int MaxCellSize;
-
-  vtkSMPThreadLocal<std::vector<double>> TLWeights;
-  vtkSMPThreadLocalObject<vtkGenericCell> TLGenericCell;
 };
 
 //------------------------------------------------------------------------------
@@ -40,9 +40,14 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkPartitionedDecimationInternal.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <numeric>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricDecimation);
 
@@ -76,6 +81,9 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->TensorsWeight = 0.1;
 
   this->ActualReduction = 0.0;
+
+  this->PartitionedDecimation = 0;
+  this->NumberOfPartitions = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -225,21 +233,6 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts = input->GetNumberOfPoints();
-  vtkIdType numTris = input->GetNumberOfPolys();
-  vtkIdType edgeId, i;
-  int j;
-  double cost;
-  double* x;
-  vtkCellArray* polys;
-  vtkDataArray* attrib;
-  vtkPoints* points;
-  vtkIdType endPtIds[2];
-  vtkIdList* outputCellList;
-  vtkIdType npts;
-  const vtkIdType* pts;
-  vtkIdType numDeletedTris = 0;
-
   // check some assumptions about the data
   if (input->GetPolys() == nullptr || input->GetPoints() == nullptr ||
     input->GetPointData() == nullptr || input->GetFieldData() == nullptr)
@@ -254,9 +247,140 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  if (this->PartitionedDecimation)
+  {
+    int numParts =
+      GetNumberOfDecimationPartitions(input->GetNumberOfPolys(), this->NumberOfPartitions);
+    if (numParts > 1)
+    {
+      return this->RequestPartitionedData(input, output, numParts);
+    }
+  }
+
+  this->DecimateMesh(input, this->TargetReduction, nullptr, nullptr);
+  this->CopyMeshToOutput(output);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkQuadricDecimation::RequestPartitionedData(
+  vtkPolyData* input, vtkPolyData* output, int numParts)
+{
+  const vtkIdType numTris = input->GetNumberOfPolys();
+  const bool copyPointData = this->AttributeErrorMetric || this->MapPointData;
+
+  // The attributes are scaled by their range over the whole input, so that
+  // the error metric does not depend on the partitioning.
+  double attributeScale[6];
+  if (this->AttributeErrorMetric)
+  {
+    vtkNew<vtkPolyData> attributes;
+    attributes->GetPointData()->ShallowCopy(input->GetPointData());
+    this->Mesh = attributes;
+    this->ComputeNumberOfComponents();
+    this->Mesh = nullptr;
+    std::copy(this->AttributeScale, this->AttributeScale + 6, attributeScale);
+  }
+
+  vtkDebugMacro(<< "Decimating " << numParts << " partitions");
+  DecimationPartitions parts;
+  BuildDecimationPartitions(input, numParts, parts);
+  this->UpdateProgress(0.05);
+
+  // Decimate the partitions concurrently, leaving the seams untouched. Each
+  // partition is decimated by its own instance of this filter.
+  std::vector<DecimatedPartition> decimated(numParts);
+  std::vector<int> numberOfEdgeCollapses(numParts, 0);
+  vtkSMPTools::For(0, numParts, 1, [&](vtkIdType part, vtkIdType endPart) {
+    std::vector<unsigned char> lockedPoints;
+    for (; part < endPart; ++part)
+    {
+      vtkSmartPointer<vtkPolyData> mesh = ExtractDecimationPartition(input, parts,
+        static_cast<int>(part), copyPointData, decimated[part].PointMap, lockedPoints);
+
+      vtkNew<vtkQuadricDecimation> decimator;
+      decimator->CopyParameters(this);
+      decimator->DecimateMesh(mesh, this->TargetReduction, lockedPoints.data(),
+        this->AttributeErrorMetric ? attributeScale : nullptr);
+      decimator->Mesh->DeleteLinks();
+      decimated[part].Mesh.TakeReference(decimator->Mesh);
+      decimator->Mesh = nullptr;
+      numberOfEdgeCollapses[part] = decimator->NumberOfEdgeCollapses;
+    }
+  });
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+  this->UpdateProgress(0.8);
+
+  // Stitch the partitions together and decimate across the seams, asking for
+  // what is left of the requested reduction.
+  vtkSmartPointer<vtkPolyData> merged =
+    MergeDecimationPartitions(input, parts, decimated, copyPointData);
+  decimated.clear();
+  const vtkIdType numMergedTris = merged->GetNumberOfPolys();
+  double reduction = 0.0;
+  if (numMergedTris > 0)
+  {
+    reduction = 1.0 - (1.0 - this->TargetReduction) * numTris / numMergedTris;
+    reduction = vtkMath::ClampValue(reduction, 0.0, 1.0);
+  }
+  this->DecimateMesh(merged, reduction, nullptr,
+    this->AttributeErrorMetric ? attributeScale : nullptr);
+  this->NumberOfEdgeCollapses +=
+    std::accumulate(numberOfEdgeCollapses.begin(), numberOfEdgeCollapses.end(), 0);
+  this->CopyMeshToOutput(output);
+
+  this->ActualReduction =
+    numTris > 0 ? 1.0 - static_cast<double>(output->GetNumberOfPolys()) / numTris : 0.0;
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkQuadricDecimation::CopyParameters(vtkQuadricDecimation* decimator)
+{
+  this->AttributeErrorMetric = decimator->AttributeErrorMetric;
+  this->VolumePreservation = decimator->VolumePreservation;
+  this->MapPointData = decimator->MapPointData;
+  this->ScalarsAttribute = decimator->ScalarsAttribute;
+  this->VectorsAttribute = decimator->VectorsAttribute;
+  this->NormalsAttribute = decimator->NormalsAttribute;
+  this->TCoordsAttribute = decimator->TCoordsAttribute;
+  this->TensorsAttribute = decimator->TensorsAttribute;
+  this->ScalarsWeight = decimator->ScalarsWeight;
+  this->VectorsWeight = decimator->VectorsWeight;
+  this->NormalsWeight = decimator->NormalsWeight;
+  this->TCoordsWeight = decimator->TCoordsWeight;
+  this->TensorsWeight = decimator->TensorsWeight;
+  this->Regularize = decimator->Regularize;
+  this->Regularization = decimator->Regularization;
+  this->WeighBoundaryConstraintsByLength = decimator->WeighBoundaryConstraintsByLength;
+  this->BoundaryWeightFactor = decimator->BoundaryWeightFactor;
+}
+
+//------------------------------------------------------------------------------
+void vtkQuadricDecimation::DecimateMesh(vtkPolyData* input, double targetReduction,
+  const unsigned char* lockedPoints, const double* attributeScale)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numTris = input->GetNumberOfPolys();
+  vtkIdType edgeId, i;
+  int j;
+  double cost;
+  double* x;
+  vtkCellArray* polys;
+  vtkPoints* points;
+  vtkIdType endPtIds[2];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType numDeletedTris = 0;
+
   polys = vtkCellArray::New();
   points = vtkPoints::New();
-  outputCellList = vtkIdList::New();
+  this->LockedPoints = lockedPoints;
 
   // copy the input (only polys) to our working mesh
   this->Mesh = vtkPolyData::New();
@@ -314,6 +438,10 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   if (this->AttributeErrorMetric)
   {
     this->ComputeNumberOfComponents();
+    if (attributeScale)
+    {
+      std::copy(attributeScale, attributeScale + 6, this->AttributeScale);
+    }
   }
   x = new double[3 + this->NumberOfComponents + this->VolumePreservation];
   this->CollapseCellIds = vtkIdList::New();
@@ -360,7 +488,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   bool abort = false;
   while (
-    !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX && this->ActualReduction < this->TargetReduction)
+    !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX && this->ActualReduction < targetReduction)
   {
     if (!(this->NumberOfEdgeCollapses % 10000))
     {
@@ -421,6 +549,15 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   delete[] this->TempB;
   delete[] this->TempA;
   delete[] this->TempData;
+  this->LockedPoints = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkQuadricDecimation::CopyMeshToOutput(vtkPolyData* output)
+{
+  vtkIdType i;
+  vtkDataArray* attrib;
+  vtkIdList* outputCellList = vtkIdList::New();
 
   // copy the simplified mesh from the working mesh to the output mesh
   for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
@@ -438,6 +575,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   this->Mesh->DeleteLinks();
   this->Mesh->Delete();
+  this->Mesh = nullptr;
   outputCellList->Delete();
 
   // renormalize, clamp attributes
@@ -452,8 +590,6 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     }
     // might want to add clamping texture coordinates??
   }
-
-  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -1023,6 +1159,12 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
     }
   }
 
+  // edges touching a locked point are never collapsed
+  if (this->LockedPoints && (this->LockedPoints[pointIds[0]] || this->LockedPoints[pointIds[1]]))
+  {
+    cost = VTK_DOUBLE_MAX;
+  }
+
   return cost;
 }
 
@@ -1269,6 +1411,12 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
 
   cost += this->TempQuad[9];
 
+  // edges touching a locked point are never collapsed
+  if (this->LockedPoints && (this->LockedPoints[pointIds[0]] || this->LockedPoints[pointIds[1]]))
+  {
+    cost = VTK_DOUBLE_MAX;
+  }
+
   return cost;
 }
 
@@ -1548,5 +1696,8 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+
+  os << indent << "Partitioned Decimation: " << (this->PartitionedDecimation ? "On\n" : "Off\n");
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
 }
 VTK_ABI_NAMESPACE_END
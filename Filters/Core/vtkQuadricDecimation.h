@@ -194,12 +194,69 @@ public:
   vtkGetMacro(ActualReduction, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the parallel decimation of large meshes. When on, the
+   * triangles are split into spatially coherent partitions (using a balanced
+   * k-d tree built on the triangle centroids) which are decimated
+   * concurrently using vtkSMPTools. The points shared by several partitions
+   * (the seams) are locked during this step. A final serial pass then
+   * decimates the merged mesh across the seams to reach the
+   * TargetReduction. The attribute error metric and all the other options
+   * are honored by both passes (the attributes are scaled by their range
+   * over the whole input). Since the edges are not collapsed in the same
+   * order, the output differs from the serial decimation. By default this
+   * is off.
+   */
+  vtkSetMacro(PartitionedDecimation, vtkTypeBool);
+  vtkGetMacro(PartitionedDecimation, vtkTypeBool);
+  vtkBooleanMacro(PartitionedDecimation, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of partitions used when PartitionedDecimation is on.
+   * If set to 0 (the default), the estimated number of threads of
+   * vtkSMPTools is used. The number of partitions is reduced for small
+   * meshes, and the mesh is decimated serially when a single partition is
+   * left.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
 protected:
   vtkQuadricDecimation();
   ~vtkQuadricDecimation() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Decimate the triangles of input into the working mesh (this->Mesh) until
+   * targetReduction is reached. Edges using a point flagged in lockedPoints
+   * (if not null) are never collapsed. If attributeScale is not null, it
+   * replaces the attribute scaling computed from the input.
+   */
+  void DecimateMesh(vtkPolyData* input, double targetReduction, const unsigned char* lockedPoints,
+    const double* attributeScale);
+
+  /**
+   * Copy the triangles left in the working mesh to output and release the
+   * working mesh.
+   */
+  void CopyMeshToOutput(vtkPolyData* output);
+
+  /**
+   * Decimate numParts partitions of input concurrently, then decimate across
+   * the partition seams. See PartitionedDecimation.
+   */
+  int RequestPartitionedData(vtkPolyData* input, vtkPolyData* output, int numParts);
+
+  /**
+   * Copy the decimation parameters of another instance.
+   */
+  void CopyParameters(vtkQuadricDecimation* decimator);
+
   /**
    * Do the dirty work of eliminating the edge; return the number of
    * triangles deleted.
@@ -277,6 +334,8 @@ protected:
   double ActualReduction;
   vtkTypeBool AttributeErrorMetric;
   vtkTypeBool VolumePreservation;
+  vtkTypeBool PartitionedDecimation;
+  int NumberOfPartitions;
 
   bool MapPointData = false;
 
@@ -319,6 +378,8 @@ protected:
 
   // Contains 4 doubles per point. Length = nPoints * 4
   double* VolumeConstraints;
+  // One flag per point, locked points are never moved. May be null.
+  const unsigned char* LockedPoints = nullptr;
   int AttributeComponents[6];
   double AttributeScale[6];
 
@@ -3,9 +3,11 @@
 #include "vtkSmoothPolyDataFilter.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -13,11 +15,18 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
@@ -153,125 +162,423 @@ vtkPolyData* vtkSmoothPolyDataFilter::GetSource()
 namespace
 {
 
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
+// The smoothing stencil of each point (i.e., the list of connected points
+// it is smoothed with) is stored in a compressed layout: the stencil of
+// point ptId starts at Offsets[ptId] in the Neighbors array, and is made of
+// Counts[ptId] points. The capacity reserved for each point is an upper
+// bound of its number of incident edges, so that the stencils can be built
+// in a single threaded pass.
+struct SmoothingStencils
 {
-  char type;
-  vtkIdList* edges; // connected edges (list of connected point ids)
-  _vtkMeshVertex()
-  {
-    type = VTK_SIMPLE_VERTEX; // can smooth
-    edges = nullptr;
-  }
-} vtkMeshVertex, *vtkMeshVertexPtr;
+  std::vector<char> Types;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Counts;
+  std::vector<vtkIdType> Neighbors;
+  std::vector<vtkIdType> LineNeighbors; // the two neighbors of points on feature lines
+};
 
-template <typename T>
-struct vtkSPDF_InternalParams
+// Compute normal vectors for mesh polygons. Only needed if feature
+// edge smoothing is enabled.
+void ComputePolygonNormals(vtkPoints* pts, vtkCellArray* polys, std::vector<double>& normals)
 {
-  vtkSmoothPolyDataFilter* spdf;
-  int numberOfIterations;
-  vtkPoints* newPts;
-  T factor;
-  T conv;
-  vtkIdType numPts;
-  vtkMeshVertexPtr vertexPtr;
-  vtkPolyData* source;
-  vtkSmoothPoints* SmoothPoints;
-  double* w;
-  vtkCellLocator* cellLocator;
-};
+  vtkIdType numCells = polys->GetNumberOfCells();
+  normals.resize(3 * numCells);
+  double* n = normals.data();
 
-template <typename T>
-void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
+  vtkSMPTools::For(0, numCells, [&, pts, polys, n](vtkIdType cellId, vtkIdType endCellId) {
+    vtkSmartPointer<vtkCellArrayIterator> cellIter;
+    cellIter.TakeReference(polys->NewIterator());
+    vtkIdType npts;
+    const vtkIdType* points;
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellIter->GetCellAtId(cellId, npts, points);
+      vtkPolygon::ComputeNormal(pts, npts, points, n + 3 * cellId);
+    }
+  }); // end lambda
+}
+
+// Classify each point and build its smoothing stencil from the polygons
+// using it. An edge (p,q) is a boundary edge if it is used by a single
+// polygon, a feature edge if it is used by more than two polygons (or by
+// two polygons forming a sharp angle, when feature edge smoothing is on),
+// and a simple edge otherwise. Points using no special edges are smoothed
+// with all their connected points; other points are smoothed along their
+// special edges only, if there are exactly two of them and the angle
+// between them is small enough. The classification of lines and vertices
+// has already been done.
+struct BuildSmoothingStencils
 {
-  int iterationNumber = 0;
-  for (T maxDist = std::numeric_limits<T>::max();
-       maxDist > params.conv && iterationNumber < params.numberOfIterations; ++iterationNumber)
+  vtkPoints* Points;
+  vtkCellArray* Polys;
+  vtkStaticCellLinks* Links;
+  const double* Normals;
+  SmoothingStencils* Stencils;
+  double CosFeatureAngle;
+  double CosEdgeAngle;
+  bool BoundarySmoothing;
+  vtkSmoothPolyDataFilter* Filter;
+
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> NeighborIterator;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Connected;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> EdgeNeighbors;
+
+  BuildSmoothingStencils(vtkPoints* pts, vtkCellArray* polys, vtkStaticCellLinks* links,
+    const double* normals, SmoothingStencils* stencils, double cosFeatureAngle,
+    double cosEdgeAngle, bool boundarySmoothing, vtkSmoothPolyDataFilter* filter)
+    : Points(pts)
+    , Polys(polys)
+    , Links(links)
+    , Normals(normals)
+    , Stencils(stencils)
+    , CosFeatureAngle(cosFeatureAngle)
+    , CosEdgeAngle(cosEdgeAngle)
+    , BoundarySmoothing(boundarySmoothing)
+    , Filter(filter)
   {
-    if (iterationNumber && !(iterationNumber % 5))
+  }
+
+  // Classify the edge (ptId,nei) of the polygon cellId.
+  char ClassifyEdge(vtkIdType ptId, vtkIdType nei, vtkIdType cellId)
+  {
+    vtkCellArrayIterator* iter = this->NeighborIterator.Local();
+    const vtkIdType numCells = this->Links->GetNcells(ptId);
+    const vtkIdType* cells = this->Links->GetCells(ptId);
+    vtkIdType numNei = 0, neiCellId = -1;
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (vtkIdType i = 0; i < numCells; ++i)
     {
-      params.spdf->UpdateProgress(0.5 + 0.5 * iterationNumber / params.numberOfIterations);
-      if (params.spdf->CheckAbort())
+      if (cells[i] != cellId)
       {
-        break;
+        iter->GetCellAtId(cells[i], npts, pts);
+        if (std::find(pts, pts + npts, nei) != pts + npts)
+        {
+          ++numNei;
+          neiCellId = cells[i];
+        }
       }
     }
 
-    maxDist = 0.0;
-    T* newPtsCoords = static_cast<T*>(params.newPts->GetVoidPointer(0));
-    T* start = newPtsCoords;
-    vtkMeshVertexPtr vertsPtr = params.vertexPtr;
-    vtkIdType npts, *edgeIdPtr;
-    T dist, deltaX[3];
-    double dist2, xNew[3], closestPt[3];
-
-    // For each non-fixed vertex of the mesh, move the point toward the mean
-    // position of its connected neighbors using the relaxation factor.
-    for (vtkIdType i = 0; i < params.numPts; ++i)
+    if (numNei == 0)
+    {
+      return VTK_BOUNDARY_EDGE_VERTEX;
+    }
+    else if (numNei >= 2)
+    {
+      return VTK_FEATURE_EDGE_VERTEX;
+    }
+    else if (this->Normals &&
+      vtkMath::Dot(this->Normals + 3 * cellId, this->Normals + 3 * neiCellId) <=
+        this->CosFeatureAngle)
+    {
+      return VTK_FEATURE_EDGE_VERTEX;
+    }
+    return VTK_SIMPLE_VERTEX;
+  }
+
+  void Initialize()
+  {
+    if (this->Polys)
+    {
+      this->Iterator.Local().TakeReference(this->Polys->NewIterator());
+      this->NeighborIterator.Local().TakeReference(this->Polys->NewIterator());
+    }
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    SmoothingStencils* stencils = this->Stencils;
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    std::vector<vtkIdType>& connected = this->Connected.Local();
+    std::vector<vtkIdType>& edgeNeighbors = this->EdgeNeighbors.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (; ptId < endPtId; ++ptId)
     {
-      if (vertsPtr->type != VTK_FIXED_VERTEX && vertsPtr->edges &&
-        (npts = vertsPtr->edges->GetNumberOfIds()) > 0)
+      if (ptId % checkAbortInterval == 0)
       {
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-        edgeIdPtr = vertsPtr->edges->GetPointer(0);
-        // Compute the mean (cumulated) direction vector
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      char type = stencils->Types[ptId];
+      if (type == VTK_FIXED_VERTEX)
+      {
+        continue;
+      }
+
+      // Gather the points connected to ptId through the polygon edges, in
+      // order of increasing polygon id. Keep the ones connected by a
+      // boundary or feature edge apart.
+      connected.clear();
+      edgeNeighbors.clear();
+      bool onBoundary = false;
+      const vtkIdType numCells = (this->Links ? this->Links->GetNcells(ptId) : 0);
+      const vtkIdType* cells = (this->Links ? this->Links->GetCells(ptId) : nullptr);
+      for (vtkIdType i = 0; i < numCells; ++i)
+      {
+        iter->GetCellAtId(cells[i], npts, pts);
         for (vtkIdType j = 0; j < npts; ++j)
         {
-          for (unsigned short k = 0; k < 3; ++k)
+          if (pts[j] != ptId)
           {
-            deltaX[k] += *(start + 3 * (*edgeIdPtr) + k);
+            continue;
           }
-          ++edgeIdPtr;
-        } // for all connected points
-
-        // Move the point
-        *newPtsCoords += params.factor * (deltaX[0] / npts - (*newPtsCoords));
-        xNew[0] = *newPtsCoords;
-        ++newPtsCoords;
-        *newPtsCoords += params.factor * (deltaX[1] / npts - (*newPtsCoords));
-        xNew[1] = *newPtsCoords;
-        ++newPtsCoords;
-        *newPtsCoords += params.factor * (deltaX[2] / npts - (*newPtsCoords));
-        xNew[2] = *newPtsCoords;
-        ++newPtsCoords;
-
-        // Constrain point to surface
-        if (params.source)
-        {
-          vtkSmoothPoint* sPtr = params.SmoothPoints->GetSmoothPoint(i);
-          vtkCell* cell = nullptr;
-
-          if (sPtr->cellId >= 0) // in cell
+          const vtkIdType prev = pts[(j + npts - 1) % npts];
+          const vtkIdType next = pts[(j + 1) % npts];
+          const vtkIdType nei[2] = { (j == 0 ? next : prev), (j == 0 ? prev : next) };
+          for (int k = 0; k < 2; ++k)
           {
-            cell = params.source->GetCell(sPtr->cellId);
+            if (nei[k] == ptId ||
+              std::find(connected.begin(), connected.end(), nei[k]) != connected.end())
+            {
+              continue;
+            }
+            connected.push_back(nei[k]);
+            const char edge = this->ClassifyEdge(ptId, nei[k], cells[i]);
+            if (edge != VTK_SIMPLE_VERTEX)
+            {
+              edgeNeighbors.push_back(nei[k]);
+              onBoundary |= (edge == VTK_BOUNDARY_EDGE_VERTEX);
+            }
           }
+        }
+      }
 
-          if (!cell ||
-            cell->EvaluatePosition(xNew, closestPt, sPtr->subId, sPtr->p, dist2, params.w) == 0)
-          { // not in cell anymore
-            params.cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId, sPtr->subId, dist2);
-          }
+      // Build the stencil
+      vtkIdType* stencil = stencils->Neighbors.data() + stencils->Offsets[ptId];
+      vtkIdType count = 0;
+      if (type == VTK_FEATURE_EDGE_VERTEX) // on a line
+      {
+        stencil[count++] = stencils->LineNeighbors[2 * ptId];
+        stencil[count++] = stencils->LineNeighbors[2 * ptId + 1];
+        std::copy(edgeNeighbors.begin(), edgeNeighbors.end(), stencil + count);
+        count += static_cast<vtkIdType>(edgeNeighbors.size());
+      }
+      else if (!edgeNeighbors.empty())
+      {
+        type = VTK_FEATURE_EDGE_VERTEX;
+        std::copy(edgeNeighbors.begin(), edgeNeighbors.end(), stencil);
+        count = static_cast<vtkIdType>(edgeNeighbors.size());
+      }
+      else
+      {
+        std::copy(connected.begin(), connected.end(), stencil);
+        count = static_cast<vtkIdType>(connected.size());
+      }
+      if (onBoundary)
+      {
+        type = VTK_BOUNDARY_EDGE_VERTEX;
+      }
+
+      // Make sure that edge vertices can be smoothed: they need exactly two
+      // edges, and the angle between them must be small enough.
+      if (type == VTK_FEATURE_EDGE_VERTEX || type == VTK_BOUNDARY_EDGE_VERTEX)
+      {
+        if (!this->BoundarySmoothing && type == VTK_BOUNDARY_EDGE_VERTEX)
+        {
+          type = VTK_FIXED_VERTEX;
+        }
+        else if (count != 2)
+        {
+          type = VTK_FIXED_VERTEX;
+        }
+        else
+        {
+          double x1[3], x2[3], x3[3], l1[3], l2[3];
+          this->Points->GetPoint(stencil[0], x1);
+          this->Points->GetPoint(ptId, x2);
+          this->Points->GetPoint(stencil[1], x3);
           for (int k = 0; k < 3; ++k)
           {
-            xNew[k] = closestPt[k];
+            l1[k] = x2[k] - x1[k];
+            l2[k] = x3[k] - x2[k];
+          }
+          if (vtkMath::Normalize(l1) >= 0.0 && vtkMath::Normalize(l2) >= 0.0 &&
+            vtkMath::Dot(l1, l2) < this->CosEdgeAngle)
+          {
+            type = VTK_FIXED_VERTEX;
           }
-          params.newPts->SetPoint(i, xNew);
         }
+      }
+
+      stencils->Types[ptId] = type;
+      stencils->Counts[ptId] = (type == VTK_FIXED_VERTEX ? 0 : count);
+    } // for all points
+  }
 
-        if ((dist = vtkMath::Norm(deltaX)) > maxDist)
+  void Reduce() {}
+};
+
+// Perform one smoothing iteration. The points are read from one buffer and
+// written to another one (Jacobi iteration), so that the result does not
+// depend on the order in which the points are processed. Optionally the
+// points are constrained to the surface of a source mesh.
+template <typename T>
+struct SmoothPoints
+{
+  const T* InPts;
+  T* OutPts;
+  const SmoothingStencils* Stencils;
+  T Factor;
+  vtkPolyData* Source;
+  vtkCellLocator* CellLocator;
+  vtkSmoothPoints* SmoothPts;
+  int MaxCellSize;
+  double MaxDistance;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+  vtkSMPThreadLocal<double> LocalMaxDistance;
+
+  SmoothPoints(const SmoothingStencils* stencils, T factor, vtkPolyData* source,
+    vtkCellLocator* cellLocator, vtkSmoothPoints* smoothPts)
+    : InPts(nullptr)
+    , OutPts(nullptr)
+    , Stencils(stencils)
+    , Factor(factor)
+    , Source(source)
+    , CellLocator(cellLocator)
+    , SmoothPts(smoothPts)
+    , MaxCellSize(source ? source->GetMaxCellSize() : 0)
+    , MaxDistance(0.0)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalMaxDistance.Local() = 0.0;
+    this->Weights.Local().resize(this->MaxCellSize);
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    const SmoothingStencils* stencils = this->Stencils;
+    double& maxDist = this->LocalMaxDistance.Local();
+    double* w = this->Weights.Local().data();
+    vtkGenericCell* cell = this->Cell.Local();
+    double xNew[3], closestPt[3], dist2;
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkIdType npts = stencils->Counts[ptId];
+      if (npts <= 0) // fixed point, or not connected
+      {
+        continue;
+      }
+
+      // Move the point toward the mean position of its connected neighbors
+      // using the relaxation factor.
+      const vtkIdType* nei = stencils->Neighbors.data() + stencils->Offsets[ptId];
+      const T* x = this->InPts + 3 * ptId;
+      T mean[3] = { 0, 0, 0 };
+      for (vtkIdType j = 0; j < npts; ++j)
+      {
+        const T* y = this->InPts + 3 * nei[j];
+        mean[0] += y[0];
+        mean[1] += y[1];
+        mean[2] += y[2];
+      }
+      for (int k = 0; k < 3; ++k)
+      {
+        xNew[k] = x[k] + this->Factor * (mean[k] / npts - x[k]);
+      }
+
+      // Constrain point to surface
+      if (this->Source)
+      {
+        vtkSmoothPoint* sPtr = this->SmoothPts->GetSmoothPoint(ptId);
+        bool inCell = false;
+        if (sPtr->cellId >= 0) // in cell
         {
-          maxDist = dist;
+          this->Source->GetCell(sPtr->cellId, cell);
+          inCell = (cell->EvaluatePosition(xNew, closestPt, sPtr->subId, sPtr->p, dist2, w) != 0);
         }
-      } // if can move point
-      else
-      {
-        newPtsCoords += 3;
+        if (!inCell) // not in cell anymore
+        {
+          this->CellLocator->FindClosestPoint(
+            xNew, closestPt, cell, sPtr->cellId, sPtr->subId, dist2);
+        }
+        xNew[0] = closestPt[0];
+        xNew[1] = closestPt[1];
+        xNew[2] = closestPt[2];
       }
-      ++vertsPtr;
+
+      T* y = this->OutPts + 3 * ptId;
+      y[0] = static_cast<T>(xNew[0]);
+      y[1] = static_cast<T>(xNew[1]);
+      y[2] = static_cast<T>(xNew[2]);
+
+      const double dist = std::sqrt(
+        (static_cast<double>(y[0]) - x[0]) * (static_cast<double>(y[0]) - x[0]) +
+        (static_cast<double>(y[1]) - x[1]) * (static_cast<double>(y[1]) - x[1]) +
+        (static_cast<double>(y[2]) - x[2]) * (static_cast<double>(y[2]) - x[2]));
+      maxDist = (dist > maxDist ? dist : maxDist);
     } // for all points
-  }   // for not converged or within iteration count
+  }
 
-  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+  void Reduce()
+  {
+    this->MaxDistance = 0.0;
+    for (const double& dist : this->LocalMaxDistance)
+    {
+      this->MaxDistance = (dist > this->MaxDistance ? dist : this->MaxDistance);
+    }
+  }
+};
+
+template <typename T>
+void MovePoints(vtkSmoothPolyDataFilter* self, vtkPoints* newPts, const SmoothingStencils& stencils,
+  int numberOfIterations, double factor, double conv, vtkPolyData* source,
+  vtkCellLocator* cellLocator, vtkSmoothPoints* smoothPts)
+{
+  const vtkIdType numPts = newPts->GetNumberOfPoints();
+  T* pts = static_cast<T*>(newPts->GetVoidPointer(0));
+  std::vector<T> buffer(pts, pts + 3 * numPts);
+  T* buffers[2] = { pts, buffer.data() };
+  int current = 0;
+
+  SmoothPoints<T> smooth(&stencils, static_cast<T>(factor), source, cellLocator, smoothPts);
+
+  int iterationNumber = 0;
+  for (double maxDist = std::numeric_limits<double>::max();
+       maxDist > conv && iterationNumber < numberOfIterations; ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      self->UpdateProgress(0.5 + 0.5 * iterationNumber / numberOfIterations);
+      if (self->CheckAbort())
+      {
+        break;
+      }
+    }
+
+    smooth.InPts = buffers[current];
+    smooth.OutPts = buffers[1 - current];
+    vtkSMPTools::For(0, numPts, smooth);
+    maxDist = smooth.MaxDistance;
+    current = 1 - current;
+  } // for not converged or within iteration count
+
+  if (buffers[current] != pts)
+  {
+    std::copy(buffer.begin(), buffer.end(), pts);
+  }
+
+  vtkDebugWithObjectMacro(self, << "Performed " << iterationNumber << " smoothing passes");
 }
 
 } // namespace
@@ -295,17 +602,14 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType numPts, numCells, i, numPolys, numStrips;
-  int j, k;
+  int j;
   vtkIdType npts = 0;
   const vtkIdType* pts = nullptr;
-  vtkIdType p1, p2;
   double conv;
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
+  double x1[3], x2[3], x3[3];
   double CosFeatureAngle; // Cosine of angle between adjacent polys
   double CosEdgeAngle;    // Cosine of angle between adjacent edges
-  double closestPt[3], dist2;
   vtkIdType numSimple = 0, numBEdges = 0, numFixed = 0, numFEdges = 0;
-  vtkPolyData* Mesh;
   vtkPoints* inPts;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
 
@@ -349,9 +653,9 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   vtkDebugMacro(<< "Analyzing topology...");
 
-  // Smart pointer to storage; use a raw pointer for operator[] array access.
-  std::unique_ptr<vtkMeshVertex[]> uVerts(new vtkMeshVertex[numPts]);
-  vtkMeshVertex* Verts = uVerts.get();
+  SmoothingStencils stencils;
+  stencils.Types.resize(numPts, VTK_SIMPLE_VERTEX);
+  char* types = stencils.Types.data();
 
   inPts = input->GetPoints();
   conv = this->Convergence * input->GetLength();
@@ -361,7 +665,7 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     for (j = 0; j < npts; j++)
     {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      types[pts[j]] = VTK_FIXED_VERTEX;
     }
   }
   this->UpdateProgress(0.10);
@@ -369,7 +673,12 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType progressCounter = 0;
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines = input->GetLines(), inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
+  inLines = input->GetLines();
+  if (inLines->GetNumberOfCells() > 0)
+  {
+    stencils.LineNeighbors.resize(2 * numPts);
+  }
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
   {
     if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
     {
@@ -378,33 +687,23 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     progressCounter++;
     for (j = 0; j < npts; j++)
     {
-      if (Verts[pts[j]].type == VTK_SIMPLE_VERTEX)
+      if (types[pts[j]] == VTK_SIMPLE_VERTEX)
       {
-        if (j == (npts - 1)) // end-of-line marked FIXED
-        {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        }
-        else if (j == 0) // beginning-of-line marked FIXED
+        if (j == (npts - 1) || j == 0) // end-of-line or beginning-of-line marked FIXED
         {
-          Verts[pts[0]].type = VTK_FIXED_VERTEX;
-          inPts->GetPoint(pts[0], x2);
-          inPts->GetPoint(pts[1], x3);
+          types[pts[j]] = VTK_FIXED_VERTEX;
         }
         else // is edge vertex (unless already edge vertex!)
         {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0, pts[j - 1]);
-          Verts[pts[j]].edges->SetId(1, pts[j + 1]);
+          types[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          stencils.LineNeighbors[2 * pts[j]] = pts[j - 1];
+          stencils.LineNeighbors[2 * pts[j] + 1] = pts[j + 1];
         }
       } // if simple vertex
 
-      else if (Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX)
+      else if (types[pts[j]] == VTK_FEATURE_EDGE_VERTEX)
       { // multiply connected, becomes fixed!
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
+        types[pts[j]] = VTK_FIXED_VERTEX;
       }
 
     } // for all points in this line
@@ -417,209 +716,76 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   inStrips = input->GetStrips();
   numStrips = inStrips->GetNumberOfCells();
 
+  vtkSmartPointer<vtkPolyData> Mesh;
+  vtkNew<vtkStaticCellLinks> links;
+  std::vector<double> normals;
   if (numPolys > 0 || numStrips > 0)
   { // build cell structure
-    vtkCellArray* polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    const vtkIdType* neiPts;
-    double normal[3], neiNormal[3];
-
-    vtkNew<vtkIdList> neighbors;
-    neighbors->Allocate(VTK_CELL_SIZE);
-
-    vtkNew<vtkPolyData> inMesh;
-    inMesh->SetPoints(inPts);
-    inMesh->SetPolys(inPolys);
-    Mesh = inMesh;
-
-    vtkSmartPointer<vtkTriangleFilter> toTris;
-    if ((numStrips = inStrips->GetNumberOfCells()) > 0)
+    Mesh = vtkSmartPointer<vtkPolyData>::New();
+    Mesh->SetPoints(inPts);
+    Mesh->SetPolys(inPolys);
+
+    if (numStrips > 0)
     { // convert data to triangles
-      inMesh->SetStrips(inStrips);
-      toTris.TakeReference(vtkTriangleFilter::New());
-      toTris->SetInputData(inMesh);
+      Mesh->SetStrips(inStrips);
+      vtkNew<vtkTriangleFilter> toTris;
+      toTris->SetInputData(Mesh);
+      toTris->SetContainerAlgorithm(this);
       toTris->Update();
       Mesh = toTris->GetOutput();
     }
 
-    Mesh->BuildLinks(); // to do neighborhood searching
-    polys = Mesh->GetPolys();
-    this->UpdateProgress(0.375);
-
-    checkAbortInterval = std::min(polys->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-
-    for (cellId = 0, polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
+    links->SetDataSet(Mesh); // to do neighborhood searching
+    links->BuildLinks();
+    links->SortLinks();
+    if (this->FeatureEdgeSmoothing)
     {
-      if (cellId % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-      for (i = 0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i + 1) % npts];
-
-        if (Verts[p1].edges == nullptr)
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16, 6);
-        }
-        if (Verts[p2].edges == nullptr)
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16, 6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if (numNei == 0)
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if (numNei >= 2)
-        {
-          // check to make sure that this edge hasn't been marked already
-          for (j = 0; j < numNei; j++)
-          {
-            if (neighbors->GetId(j) < cellId)
-            {
-              break;
-            }
-          }
-          if (j >= numNei)
-          {
-            edge = VTK_FEATURE_EDGE_VERTEX;
-          }
-        }
-
-        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
-            Mesh->GetCellPoints(nei, numNeiPts, neiPts);
-            vtkPolygon::ComputeNormal(inPts, numNeiPts, neiPts, neiNormal);
-
-            if (vtkMath::Dot(normal, neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if (edge && Verts[p1].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ((edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if (Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if (edge && Verts[p2].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ((edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if (Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
+      ComputePolygonNormals(inPts, Mesh->GetPolys(), normals);
     }
   } // if strips or polys
+  this->UpdateProgress(0.375);
 
-  this->UpdateProgress(0.50);
-
-  checkAbortInterval = std::min(numPts / 10 + 1, (vtkIdType)1000);
-
-  // post-process edge vertices to make sure we can smooth them
+  // Reserve room for the stencils: a point has at most two edges per
+  // incident polygon, plus two line edges.
+  stencils.Offsets.resize(numPts + 1);
+  stencils.Counts.resize(numPts, 0);
+  stencils.Offsets[0] = 0;
   for (i = 0; i < numPts; i++)
   {
-    if (i % checkAbortInterval == 0 && this->CheckAbort())
+    vtkIdType capacity = (Mesh ? 2 * links->GetNcells(i) : 0);
+    if (types[i] == VTK_FEATURE_EDGE_VERTEX)
     {
-      break;
-    }
-    if (Verts[i].type == VTK_SIMPLE_VERTEX)
-    {
-      numSimple++;
-    }
-
-    else if (Verts[i].type == VTK_FIXED_VERTEX)
-    {
-      numFixed++;
+      capacity += 2;
     }
+    stencils.Offsets[i + 1] = stencils.Offsets[i] + capacity;
+  }
+  stencils.Neighbors.resize(stencils.Offsets[numPts]);
 
-    else if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX || Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
-    { // see how many edges; if two, what the angle is
+  // classify the points and build their smoothing stencils
+  BuildSmoothingStencils buildStencils(inPts, (Mesh ? Mesh->GetPolys() : nullptr),
+    (Mesh ? links.Get() : nullptr), (normals.empty() ? nullptr : normals.data()), &stencils,
+    CosFeatureAngle, CosEdgeAngle, this->BoundarySmoothing != 0, this);
+  vtkSMPTools::For(0, numPts, buildStencils);
 
-      if (!this->BoundarySmoothing && Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
-      {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numBEdges++;
-      }
+  this->UpdateProgress(0.50);
 
-      else if ((npts = Verts[i].edges->GetNumberOfIds()) != 2)
-      {
-        Verts[i].type = VTK_FIXED_VERTEX;
+  for (i = 0; i < numPts; i++)
+  {
+    switch (types[i])
+    {
+      case VTK_SIMPLE_VERTEX:
+        numSimple++;
+        break;
+      case VTK_FIXED_VERTEX:
         numFixed++;
-      }
-
-      else // check angle between edges
-      {
-        inPts->GetPoint(Verts[i].edges->GetId(0), x1);
-        inPts->GetPoint(i, x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1), x3);
-
-        for (k = 0; k < 3; k++)
-        {
-          l1[k] = x2[k] - x1[k];
-          l2[k] = x3[k] - x2[k];
-        }
-        if (vtkMath::Normalize(l1) >= 0.0 && vtkMath::Normalize(l2) >= 0.0 &&
-          vtkMath::Dot(l1, l2) < CosEdgeAngle)
-        {
-          numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
-        }
-        else
-        {
-          if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX)
-          {
-            numFEdges++;
-          }
-          else
-          {
-            numBEdges++;
-          }
-        }
-      } // if along edge
-    }   // if edge vertex
-  }     // for all points
+        break;
+      case VTK_FEATURE_EDGE_VERTEX:
+        numFEdges++;
+        break;
+      default:
+        numBEdges++;
+    }
+  }
 
   vtkDebugMacro(<< "Found\n\t" << numSimple << " simple vertices\n\t" << numFEdges
                 << " feature edge vertices\n\t" << numBEdges << " boundary edge vertices\n\t"
@@ -653,49 +819,53 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   // If a Source is defined, we do constrained smoothing (that is, points are
   // constrained to the surface of the mesh object).
-  std::unique_ptr<double[]> w;
   vtkSmartPointer<vtkCellLocator> cellLocator;
   if (source)
   {
     this->SmoothPoints = std::unique_ptr<vtkSmoothPoints>(new vtkSmoothPoints);
-    vtkSmoothPoint* sPtr;
+    this->SmoothPoints->InsertSmoothPoint(numPts - 1);
     cellLocator.TakeReference(vtkCellLocator::New());
-    auto maxCellSize = source->GetMaxCellSize();
-    w.reset(new double[maxCellSize]);
     cellLocator->SetDataSet(source);
     cellLocator->BuildLocator();
-
-    for (i = 0; i < numPts; i++)
+    if (source->NeedToBuildCells())
     {
-      sPtr = this->SmoothPoints->InsertSmoothPoint(i);
-      cellLocator->FindClosestPoint(
-        inPts->GetPoint(i), closestPt, sPtr->cellId, sPtr->subId, dist2);
-      newPts->SetPoint(i, closestPt);
+      source->BuildCells();
     }
+
+    vtkSmoothPoints* smoothPts = this->SmoothPoints.get();
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      vtkNew<vtkGenericCell> cell;
+      double x[3], closest[3], d2;
+      for (; ptId < endPtId; ptId++)
+      {
+        vtkSmoothPoint* sPtr = smoothPts->GetSmoothPoint(ptId);
+        inPts->GetPoint(ptId, x);
+        cellLocator->FindClosestPoint(x, closest, cell, sPtr->cellId, sPtr->subId, d2);
+        newPts->SetPoint(ptId, closest);
+      }
+    }); // end lambda
   }
   else // smooth normally
   {
-    for (i = 0; i < numPts; i++) // initialize to old coordinates
-    {
-      newPts->SetPoint(i, inPts->GetPoint(i));
-    }
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ptId++) // initialize to old coordinates
+      {
+        inPts->GetPoint(ptId, x);
+        newPts->SetPoint(ptId, x);
+      }
+    }); // end lambda
   }
 
   if (newPts->GetDataType() == VTK_DOUBLE)
   {
-    vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
-      this->RelaxationFactor, conv, numPts, Verts, source, this->SmoothPoints.get(), w.get(),
-      cellLocator };
-
-    vtkSPDF_MovePoints(params);
+    MovePoints<double>(this, newPts, stencils, this->NumberOfIterations, this->RelaxationFactor,
+      conv, source, cellLocator, this->SmoothPoints.get());
   }
   else
   {
-    vtkSPDF_InternalParams<float> params = { this, this->NumberOfIterations, newPts,
-      static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, Verts, source,
-      this->SmoothPoints.get(), w.get(), cellLocator };
-
-    vtkSPDF_MovePoints(params);
+    MovePoints<float>(this, newPts, stencils, this->NumberOfIterations, this->RelaxationFactor,
+      conv, source, cellLocator, this->SmoothPoints.get());
   }
 
   // Release memory if it's been allocated
@@ -745,16 +915,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // free up connectivity storage
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].edges)
-    {
-      Verts[i].edges->Delete();
-      Verts[i].edges = nullptr;
-    }
-  }
-
   return 1;
 }
 
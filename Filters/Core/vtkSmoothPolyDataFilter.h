@@ -22,6 +22,19 @@
  * vertices is a single iteration. Many iterations (generally around 20 or
  * so) are repeated until the desired result is obtained.
  *
+ * The connectivity array is built, and the iterations are performed, in
+ * parallel using vtkSMPTools. Within an iteration all the vertices are moved
+ * simultaneously: the new coordinates are computed from the coordinates of
+ * the previous iteration (i.e., a Jacobi iteration). Hence the result does not
+ * depend on the order of the vertices, nor on the number of threads.
+ *
+ * @warning
+ * Before VTK 9.4 the vertices were moved in place, one after the other (i.e.,
+ * a Gauss-Seidel iteration), and the Convergence test was applied to the
+ * length of the averaged displacement rather than to the actual motion of the
+ * vertices. The smoothed coordinates, and the number of iterations performed
+ * for a given Convergence, therefore differ slightly from earlier releases.
+ *
  * There are some special instance variables used to control the execution
  * of this filter. (These ivars basically control what vertices can be
  * smoothed, and the creation of the connectivity array.) The
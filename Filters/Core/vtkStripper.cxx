@@ -12,12 +12,301 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStripper);
 
+namespace
+{
+// Partitions smaller than this are not worth stripping in parallel.
+constexpr vtkIdType VTK_MINIMUM_CELLS_PER_STRIP_PARTITION = 10000;
+
+// The triangle strips built from a partition of the cells, and the cells
+// each strip was built from (in the order used for the field data).
+struct StripPartition
+{
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Conn;
+  std::vector<vtkIdType> CellOffsets;
+  std::vector<vtkIdType> CellIds;
+  int LongestStrip = 0;
+};
+
+// Group the triangles that are connected through their edges into patches, and
+// the patches into (at most) numParts partitions of about the same number of
+// triangles. A strip never leaves its patch, so the partitions can be stripped
+// independently, each exactly as by the serial algorithm. The triangles of
+// partition p are cells[offsets[p], offsets[p+1]), in increasing order. Return
+// the number of partitions.
+vtkIdType PartitionPatches(vtkPolyData* mesh, const char* visited, vtkIdType beginCellId,
+  vtkIdType endCellId, vtkIdType numParts, std::vector<vtkIdType>& offsets,
+  std::vector<vtkIdType>& cells)
+{
+  const vtkIdType numCells = endCellId - beginCellId;
+  auto isFree = [mesh, visited](vtkIdType cellId) {
+    return !visited[cellId] && mesh->GetCellType(cellId) == VTK_TRIANGLE;
+  };
+
+  // Find the pairs of adjacent triangles in parallel. The parents of the union
+  // find forest are initialized at the same time (-1 for the other cells).
+  std::vector<vtkIdType> parent(numCells);
+  vtkSMPThreadLocal<std::vector<std::pair<vtkIdType, vtkIdType>>> localPairs;
+  vtkSMPThreadLocalObject<vtkIdList> localNeighbors;
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(beginCellId, endCellId, [&](vtkIdType cellId, vtkIdType endId) {
+    auto& pairs = localPairs.Local();
+    vtkIdList* neighbors = localNeighbors.Local();
+    vtkIdList* ptIds = localPtIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endId; ++cellId)
+    {
+      if (!isFree(cellId))
+      {
+        parent[cellId - beginCellId] = -1;
+        continue;
+      }
+      parent[cellId - beginCellId] = cellId - beginCellId;
+      mesh->GetCellPoints(cellId, npts, pts, ptIds);
+      for (int i = 0; i < 3; ++i)
+      {
+        mesh->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], neighbors);
+        for (vtkIdType j = 0; j < neighbors->GetNumberOfIds(); ++j)
+        {
+          const vtkIdType neighbor = neighbors->GetId(j);
+          if (neighbor > cellId && isFree(neighbor))
+          {
+            pairs.emplace_back(cellId - beginCellId, neighbor - beginCellId);
+          }
+        }
+      }
+    }
+  }); // end lambda
+
+  // Merge the patches. The root of a patch is its smallest cell.
+  auto findRoot = [&parent](vtkIdType cellId) {
+    while (parent[cellId] != cellId)
+    {
+      cellId = parent[cellId] = parent[parent[cellId]];
+    }
+    return cellId;
+  };
+  for (const auto& pairs : localPairs)
+  {
+    for (const auto& pair : pairs)
+    {
+      const vtkIdType root0 = findRoot(pair.first);
+      const vtkIdType root1 = findRoot(pair.second);
+      parent[std::max(root0, root1)] = std::min(root0, root1);
+    }
+  }
+
+  // Count the triangles of each patch (stored at its root), then assign the
+  // patches to the partitions in the order of their roots.
+  std::vector<vtkIdType> patchSize(numCells, 0);
+  vtkIdType numTris = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (parent[cellId] >= 0)
+    {
+      parent[cellId] = findRoot(cellId);
+      ++patchSize[parent[cellId]];
+      ++numTris;
+    }
+  }
+  const vtkIdType trisPerPartition = (numTris + numParts - 1) / numParts;
+  vtkIdType part = 0, partSize = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (parent[cellId] == cellId)
+    {
+      if (partSize >= trisPerPartition)
+      {
+        ++part;
+        partSize = 0;
+      }
+      partSize += patchSize[cellId];
+      patchSize[cellId] = part; // from now on, the partition of the patch
+    }
+  }
+  numParts = part + 1;
+
+  offsets.assign(numParts + 1, 0);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (parent[cellId] >= 0)
+    {
+      ++offsets[patchSize[parent[cellId]] + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  cells.resize(numTris);
+  std::vector<vtkIdType> next(offsets.begin(), offsets.end() - 1);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (parent[cellId] >= 0)
+    {
+      cells[next[patchSize[parent[cellId]]]++] = beginCellId + cellId;
+    }
+  }
+  return numParts;
+}
+
+// Build the triangle strips of each partition of the triangles, following the
+// serial algorithm. The partitions are made of whole patches, so they can share
+// the array of visited cells.
+struct BuildPartitionStrips
+{
+  vtkPolyData* Mesh;
+  char* Visited;
+  const std::vector<vtkIdType>& Offsets;
+  const std::vector<vtkIdType>& Cells;
+  int MaximumLength;
+  vtkAlgorithm* Filter;
+  std::vector<StripPartition>& Partitions;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+  BuildPartitionStrips(vtkPolyData* mesh, char* visited, const std::vector<vtkIdType>& offsets,
+    const std::vector<vtkIdType>& cells, int maxLength, vtkAlgorithm* filter,
+    std::vector<StripPartition>& partitions)
+    : Mesh(mesh)
+    , Visited(visited)
+    , Offsets(offsets)
+    , Cells(cells)
+    , MaximumLength(maxLength)
+    , Filter(filter)
+    , Partitions(partitions)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType part, vtkIdType endPart)
+  {
+    vtkIdList* cellIds = this->CellIds.Local();
+    vtkIdList* ptIds = this->PtIds.Local();
+    std::vector<vtkIdType> pts(this->MaximumLength + 2);
+    const vtkIdType* triPts;
+    vtkIdType numTriPts, neighbor = 0;
+    int i, numPts;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (; part < endPart; ++part)
+    {
+      const vtkIdType begin = this->Offsets[part];
+      const vtkIdType end = this->Offsets[part + 1];
+      vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      StripPartition& strips = this->Partitions[part];
+      strips.Offsets.push_back(0);
+      strips.CellOffsets.push_back(0);
+
+      for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+        const vtkIdType cellId = this->Cells[idx];
+        if (idx % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->Filter->CheckAbort();
+          }
+          if (this->Filter->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        if (this->Visited[cellId] || this->Mesh->GetCellType(cellId) != VTK_TRIANGLE)
+        {
+          continue;
+        }
+
+        //  Got a starting point for the strip.  Initialize.  Find a neighbor
+        //  to extend strip.
+        //
+        this->Visited[cellId] = 1;
+        strips.CellIds.push_back(cellId);
+        numPts = 3;
+
+        this->Mesh->GetCellPoints(cellId, numTriPts, triPts, ptIds);
+
+        for (i = 0; i < 3; i++)
+        {
+          pts[1] = triPts[i];
+          pts[2] = triPts[(i + 1) % 3];
+
+          this->Mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
+          if (cellIds->GetNumberOfIds() > 0 && !this->Visited[neighbor = cellIds->GetId(0)] &&
+            this->Mesh->GetCellType(neighbor) == VTK_TRIANGLE)
+          {
+            pts[0] = triPts[(i + 2) % 3];
+            break;
+          }
+        }
+        //  If no unvisited neighbor, just create the strip of one triangle.
+        //
+        if (i >= 3)
+        {
+          pts[0] = triPts[0];
+          pts[1] = triPts[1];
+          pts[2] = triPts[2];
+        }
+        else // continue strip
+        {
+          //  Have a neighbor.  March along grabbing new points
+          //
+          while (neighbor >= 0)
+          {
+            this->Visited[neighbor] = 1;
+            strips.CellIds.push_back(neighbor);
+            this->Mesh->GetCellPoints(neighbor, numTriPts, triPts, ptIds);
+            for (i = 0; i < 3; i++)
+            {
+              if (triPts[i] != pts[numPts - 2] && triPts[i] != pts[numPts - 1])
+              {
+                break;
+              }
+            }
+
+            // only add the triangle to the strip if it isn't degenerate.
+            if (i < 3)
+            {
+              pts[numPts] = triPts[i];
+              this->Mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
+              numPts++;
+            }
+
+            if (cellIds->GetNumberOfIds() <= 0 || this->Visited[neighbor = cellIds->GetId(0)] ||
+              this->Mesh->GetCellType(neighbor) != VTK_TRIANGLE ||
+              numPts >= (this->MaximumLength + 2))
+            {
+              neighbor = (-1);
+            }
+          } // while
+        }   // else continue strip
+
+        strips.Conn.insert(strips.Conn.end(), pts.begin(), pts.begin() + numPts);
+        strips.Offsets.push_back(static_cast<vtkIdType>(strips.Conn.size()));
+        strips.CellOffsets.push_back(static_cast<vtkIdType>(strips.CellIds.size()));
+        strips.LongestStrip = std::max(strips.LongestStrip, numPts);
+      } // for all cells of the partition
+    }
+  }
+
+  void Reduce() {}
+};
+} // anonymous namespace
+
 // Construct object with MaximumLength set to 1000.
 vtkStripper::vtkStripper()
 {
@@ -26,6 +315,8 @@ vtkStripper::vtkStripper()
   this->PassThroughCellIds = 0;
   this->PassThroughPointIds = 0;
   this->JoinContiguousSegments = 0;
+  this->PartitionedStripping = 0;
+  this->NumberOfPartitions = 0;
 }
 
 int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
@@ -217,18 +508,86 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
     visited[i] = ghostCells && ghostCells->GetValue(i) ? 1 : 0;
   }
 
+  longestStrip = 0;
+  numStrips = 0;
+  bool abort = false;
+
+  // Build the triangle strips of the partitions of the polygons in parallel.
+  // The strips are then appended in the order of their first triangle, which
+  // is the order in which the serial algorithm creates them.
+  if (this->PartitionedStripping && newStrips)
+  {
+    vtkIdType numParts = this->NumberOfPartitions > 0
+      ? this->NumberOfPartitions
+      : vtkSMPTools::GetEstimatedNumberOfThreads();
+    numParts = std::min(numParts, inNumPolys / VTK_MINIMUM_CELLS_PER_STRIP_PARTITION);
+    std::vector<vtkIdType> partOffsets, partCells;
+    if (numParts > 1)
+    {
+      // The cells using a point are not sorted when the links are built in
+      // parallel. Sort them in decreasing order, as the serial construction of
+      // the links does, so that the strips do not depend on the number of threads.
+      if (vtkStaticCellLinks* links = vtkStaticCellLinks::SafeDownCast(mesh->GetLinks()))
+      {
+        links->SortLinks(true);
+      }
+
+      numParts = PartitionPatches(
+        mesh, visited, inNumLines, numCells, numParts, partOffsets, partCells);
+    }
+    if (numParts > 1)
+    {
+      std::vector<StripPartition> partitions(numParts);
+      BuildPartitionStrips build(
+        mesh, visited, partOffsets, partCells, this->MaximumLength, this, partitions);
+      vtkSMPTools::For(0, numParts, 1, build);
+      abort = this->GetAbortOutput();
+
+      // (first triangle, partition, strip in the partition) of every strip
+      std::vector<std::array<vtkIdType, 3>> order;
+      for (vtkIdType part = 0; part < numParts; ++part)
+      {
+        const StripPartition& strips = partitions[part];
+        const vtkIdType numPartStrips = static_cast<vtkIdType>(strips.Offsets.size()) - 1;
+        for (vtkIdType s = 0; s < numPartStrips; ++s)
+        {
+          order.push_back({ { strips.CellIds[strips.CellOffsets[s]], part, s } });
+        }
+        longestStrip = std::max(longestStrip, strips.LongestStrip);
+      }
+      std::sort(order.begin(), order.end());
+
+      for (const auto& strip : order)
+      {
+        const StripPartition& strips = partitions[strip[1]];
+        const vtkIdType s = strip[2];
+        newStrips->InsertNextCell(
+          strips.Offsets[s + 1] - strips.Offsets[s], strips.Conn.data() + strips.Offsets[s]);
+        for (i = strips.CellOffsets[s]; i < strips.CellOffsets[s + 1]; ++i)
+        {
+          if (this->PassCellDataAsFieldData)
+          {
+            newfdStrips->InsertNextTuple(strips.CellIds[i], cd);
+          }
+          if (this->PassThroughCellIds)
+          {
+            origStripIds->InsertNextValue(strips.CellIds[i]);
+          }
+        }
+      }
+      numStrips += static_cast<vtkIdType>(order.size());
+    }
+  }
+
   // Loop over all cells and find one that hasn't been visited.
   // Start a triangle strip (or poly-line) and mark as visited, and
   // then find a neighbor that isn't visited.  Add this to the strip
   // (or poly-line) and mark as visited (and so on).
   //
-  longestStrip = 0;
-  numStrips = 0;
   longestLine = 0;
   numLines = 0;
 
   int cellType;
-  bool abort = false;
   vtkIdType progressInterval = numCells / 20 + 1;
   for (cellId = 0; cellId < numCells && !abort; cellId++)
   {
@@ -734,5 +1093,7 @@ void vtkStripper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PassThroughCellIds: " << this->PassThroughCellIds << endl;
   os << indent << "PassThroughPointIds: " << this->PassThroughPointIds << endl;
   os << indent << "JoinContiguousSegments: " << this->JoinContiguousSegments << endl;
+  os << indent << "PartitionedStripping: " << this->PartitionedStripping << endl;
+  os << indent << "NumberOfPartitions: " << this->NumberOfPartitions << endl;
 }
 VTK_ABI_NAMESPACE_END
@@ -35,6 +35,9 @@
  * If there is a ghost cell array in the input, the ghost array is discarded.
  * Any cell tagged as ghost is skipped when stripping. Ghost points are kept.
  *
+ * The triangle strips of large meshes can be built in parallel, see
+ * PartitionedStripping.
+ *
  * @warning
  * If triangle strips or poly-lines exist in the input data they will
  * be passed through to the output data. This filter will only construct
@@ -117,6 +120,35 @@ public:
   vtkBooleanMacro(JoinContiguousSegments, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the parallel generation of the triangle strips. When on, the
+   * triangles are grouped into patches of triangles connected through their
+   * edges, and the patches into partitions that are stripped concurrently
+   * using vtkSMPTools. A strip never leaves its patch, so the strips are the
+   * same, and are output in the same order, as with the serial algorithm.
+   * The field data (see PassCellDataAsFieldData) and the original cell ids
+   * remain consistent with the strips. A single connected surface is a single
+   * patch, which is stripped by one thread. Poly-lines are always built
+   * serially. By default this is off.
+   */
+  vtkSetMacro(PartitionedStripping, vtkTypeBool);
+  vtkGetMacro(PartitionedStripping, vtkTypeBool);
+  vtkBooleanMacro(PartitionedStripping, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of partitions used when PartitionedStripping is on.
+   * If set to 0 (the default), the estimated number of threads of
+   * vtkSMPTools is used. The number of partitions is reduced for small
+   * meshes, and to the number of patches. The strips are built serially when
+   * a single partition is left. The strips do not depend on this value.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
 protected:
   vtkStripper();
   ~vtkStripper() override = default;
@@ -129,6 +161,8 @@ protected:
   vtkTypeBool PassThroughCellIds;
   vtkTypeBool PassThroughPointIds;
   vtkTypeBool JoinContiguousSegments;
+  vtkTypeBool PartitionedStripping;
+  int NumberOfPartitions;
 
 private:
   vtkStripper(const vtkStripper&) = delete;
@@ -2,20 +2,318 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkTriangleFilter.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangleStrip.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTriangleFilter);
 
+namespace
+{
+// The polygons and triangle strips are triangulated in parallel in three
+// passes: the triangles of each cell are counted, a prefix sum of the counts
+// gives the location of the triangles of each cell in the output, and the
+// output connectivity and cell data are filled.
+
+// Count the triangles of each cell. Triangles and strips are counted
+// directly. The other polygons are triangulated (ear-cut) with a thread-local
+// vtkPolygon, and their triangles are kept in thread-local buffers until
+// they are copied to the output.
+struct CountTriangles
+{
+  struct LocalData
+  {
+    vtkSmartPointer<vtkCellArrayIterator> Iterator;
+    vtkSmartPointer<vtkPolygon> Polygon;
+    vtkSmartPointer<vtkIdList> TriIds;
+    std::vector<vtkIdType> Triangles;
+  };
+
+  vtkCellArray* Cells;
+  vtkPoints* Points;
+  bool Strips;
+  double Tolerance;
+  vtkAlgorithm* Filter;
+  double ProgressOffset; // progress = ProgressOffset + ProgressScale * cellId
+  double ProgressScale;
+  vtkSMPThreadLocal<LocalData> Local;
+
+  // Number of triangles of each cell (in place prefix sum later on), and for
+  // the triangulated polygons, where their triangles are kept.
+  std::vector<vtkIdType>& TriOffsets;
+  std::vector<const std::vector<vtkIdType>*>& TriBuffers;
+  std::vector<vtkIdType>& TriBufferOffsets;
+
+  CountTriangles(vtkCellArray* cells, vtkPoints* points, bool strips, double tol,
+    vtkAlgorithm* filter, double progressOffset, double progressScale,
+    std::vector<vtkIdType>& triOffsets, std::vector<const std::vector<vtkIdType>*>& triBuffers,
+    std::vector<vtkIdType>& triBufferOffsets)
+    : Cells(cells)
+    , Points(points)
+    , Strips(strips)
+    , Tolerance(tol)
+    , Filter(filter)
+    , ProgressOffset(progressOffset)
+    , ProgressScale(progressScale)
+    , TriOffsets(triOffsets)
+    , TriBuffers(triBuffers)
+    , TriBufferOffsets(triBufferOffsets)
+  {
+  }
+
+  void Initialize()
+  {
+    LocalData& local = this->Local.Local();
+    local.Iterator.TakeReference(this->Cells->NewIterator());
+    local.Polygon = vtkSmartPointer<vtkPolygon>::New();
+    if (this->Tolerance > 0.0)
+    {
+      local.Polygon->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
+    }
+    local.TriIds = vtkSmartPointer<vtkIdList>::New();
+    local.TriIds->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    LocalData& local = this->Local.Local();
+    vtkPolygon* poly = local.Polygon;
+    vtkIdList* triIds = local.TriIds;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double x[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      local.Iterator->GetCellAtId(cellId, npts, pts);
+      if (this->Strips)
+      {
+        this->TriOffsets[cellId] = (npts > 2 ? npts - 2 : 0);
+      }
+      else if (npts == 3)
+      {
+        this->TriOffsets[cellId] = 1;
+      }
+      else // triangulate polygon
+      {
+        poly->PointIds->SetNumberOfIds(npts);
+        poly->Points->SetNumberOfPoints(npts);
+        for (vtkIdType i = 0; i < npts; i++)
+        {
+          poly->PointIds->SetId(i, pts[i]);
+          this->Points->GetPoint(pts[i], x);
+          poly->Points->SetPoint(i, x);
+        }
+        poly->TriangulateLocalIds(0, triIds);
+        const vtkIdType numIds = 3 * (triIds->GetNumberOfIds() / 3);
+        this->TriOffsets[cellId] = numIds / 3;
+        this->TriBuffers[cellId] = &local.Triangles;
+        this->TriBufferOffsets[cellId] = static_cast<vtkIdType>(local.Triangles.size());
+        for (vtkIdType i = 0; i < numIds; ++i)
+        {
+          local.Triangles.push_back(pts[triIds->GetId(i)]);
+        }
+      }
+    }
+    if (isFirst)
+    {
+      this->Filter->UpdateProgress(this->ProgressOffset + this->ProgressScale * endCellId);
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Fill the output triangles of each cell, and copy their cell data.
+struct GenerateTriangles
+{
+  vtkCellArray* Cells;
+  bool Strips;
+  const std::vector<vtkIdType>& TriOffsets;
+  const std::vector<const std::vector<vtkIdType>*>& TriBuffers;
+  const std::vector<vtkIdType>& TriBufferOffsets;
+  vtkIdType* Offsets;
+  vtkIdType* Conn;
+  ArrayList* Arrays;
+  vtkIdType InCellId;
+  vtkIdType OutCellId;
+  vtkAlgorithm* Filter;
+  double ProgressOffset; // progress = ProgressOffset + ProgressScale * cellId
+  double ProgressScale;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  GenerateTriangles(vtkCellArray* cells, bool strips, const std::vector<vtkIdType>& triOffsets,
+    const std::vector<const std::vector<vtkIdType>*>& triBuffers,
+    const std::vector<vtkIdType>& triBufferOffsets, vtkIdType* offsets, vtkIdType* conn,
+    ArrayList* arrays, vtkIdType inCellId, vtkIdType outCellId, vtkAlgorithm* filter,
+    double progressOffset, double progressScale)
+    : Cells(cells)
+    , Strips(strips)
+    , TriOffsets(triOffsets)
+    , TriBuffers(triBuffers)
+    , TriBufferOffsets(triBufferOffsets)
+    , Offsets(offsets)
+    , Conn(conn)
+    , Arrays(arrays)
+    , InCellId(inCellId)
+    , OutCellId(outCellId)
+    , Filter(filter)
+    , ProgressOffset(progressOffset)
+    , ProgressScale(progressScale)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Cells->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType triId = this->TriOffsets[cellId];
+      const vtkIdType numTris = this->TriOffsets[cellId + 1] - triId;
+      if (numTris == 0)
+      {
+        continue;
+      }
+
+      vtkIdType* conn = this->Conn + 3 * triId;
+      if (this->Strips)
+      {
+        // flip the ordering of every other triangle to preserve consistency,
+        // see vtkTriangleStrip::DecomposeStrip()
+        iter->GetCellAtId(cellId, npts, pts);
+        for (vtkIdType i = 0; i < numTris; ++i, conn += 3)
+        {
+          conn[0] = pts[i + (i % 2)];
+          conn[1] = pts[i + 1 - (i % 2)];
+          conn[2] = pts[i + 2];
+        }
+      }
+      else if (this->TriBuffers[cellId])
+      {
+        const vtkIdType* tris = this->TriBuffers[cellId]->data() + this->TriBufferOffsets[cellId];
+        std::copy(tris, tris + 3 * numTris, conn);
+      }
+      else
+      {
+        iter->GetCellAtId(cellId, npts, pts);
+        std::copy(pts, pts + 3, conn);
+      }
+
+      for (vtkIdType i = 0; i < numTris; ++i)
+      {
+        this->Offsets[triId + i] = 3 * (triId + i);
+        this->Arrays->Copy(this->InCellId + cellId, this->OutCellId + triId + i);
+      }
+    }
+    if (isFirst)
+    {
+      this->Filter->UpdateProgress(this->ProgressOffset + this->ProgressScale * endCellId);
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Triangulate the polygons (or triangle strips) of the given cell array. The
+// cell data of the input cell inCellId+i is copied to the triangles generated
+// from the i-th cell, numbered from outCellId. The progress goes from
+// inCellId / numInCells to (inCellId + numCells) / numInCells. Returns nullptr
+// on abort.
+vtkSmartPointer<vtkCellArray> TriangulateCells(vtkAlgorithm* filter, vtkCellArray* cells,
+  vtkPoints* points, bool strips, double tol, vtkCellData* inCD, vtkCellData* outCD,
+  vtkIdType inCellId, vtkIdType outCellId, vtkIdType numInCells)
+{
+  const vtkIdType numCells = cells->GetNumberOfCells();
+  const double progressOffset = static_cast<double>(inCellId) / numInCells;
+  const double progressScale = 0.5 / numInCells;
+  std::vector<vtkIdType> triOffsets(numCells + 1, 0);
+  std::vector<const std::vector<vtkIdType>*> triBuffers;
+  std::vector<vtkIdType> triBufferOffsets;
+  if (!strips)
+  {
+    triBuffers.resize(numCells, nullptr);
+    triBufferOffsets.resize(numCells, 0);
+  }
+
+  CountTriangles count(cells, points, strips, tol, filter, progressOffset, progressScale,
+    triOffsets, triBuffers, triBufferOffsets);
+  vtkSMPTools::For(0, numCells, count);
+  if (filter->GetAbortOutput())
+  {
+    return nullptr;
+  }
+
+  // Prefix sum: the offset of the first triangle of each cell
+  vtkIdType numTris = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    const vtkIdType num = triOffsets[cellId];
+    triOffsets[cellId] = numTris;
+    numTris += num;
+  }
+  triOffsets[numCells] = numTris;
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTris + 1);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(3 * numTris);
+  // AddArrays() does not preserve the values of the output arrays when it
+  // grows them, so grow them first to keep the cell data of the triangles
+  // already generated (the polygons, when the strips are triangulated).
+  for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+  {
+    outCD->GetAbstractArray(i)->Resize(outCellId + numTris);
+  }
+  ArrayList arrays;
+  arrays.AddArrays(outCellId + numTris, inCD, outCD, 0.0, false);
+
+  GenerateTriangles generate(cells, strips, triOffsets, triBuffers, triBufferOffsets,
+    offsets->GetPointer(0), conn->GetPointer(0), &arrays, inCellId, outCellId, filter,
+    progressOffset + progressScale * numCells, progressScale);
+  vtkSMPTools::For(0, numCells, generate);
+  offsets->SetValue(numTris, 3 * numTris);
+
+  auto tris = vtkSmartPointer<vtkCellArray>::New();
+  tris->SetData(offsets, conn);
+  return tris;
+}
+} // anonymous namespace
+
 //-------------------------------------------------------------------------
 int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -212,59 +510,17 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
     else
     {
-      outCellId = output->GetNumberOfCells();
-      newPolys->AllocateCopy(inPolys);
-
-      vtkNew<vtkIdList> ptIds;
-      ptIds->Allocate(VTK_CELL_SIZE);
-      vtkIdType triPts[3];
-      // It may be necessary to specify a custom tessellation
-      // tolerance.
-      vtkNew<vtkPolygon> poly;
-      if (this->Tolerance > 0.0)
+      newPolys = TriangulateCells(this, inPolys, inPts, false, this->Tolerance, inCD, outCD,
+        inCellId, output->GetNumberOfCells(), numInCells);
+      if (!newPolys) // aborted
       {
-        poly->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
+        abort = true;
       }
-
-      auto iter = vtk::TakeSmartPointer(inPolys->NewIterator());
-      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal() && !abort;
-           iter->GoToNextCell(), ++inCellId)
+      else
       {
-        if (!(inCellId % updateInterval)) // manage progress reports / early abort
-        {
-          this->UpdateProgress((float)inCellId / numInCells);
-          abort = this->CheckAbort();
-        }
-        iter->GetCurrentCell(npts, pts);
-        if (npts == 3)
-        {
-          newPolys->InsertNextCell(3, pts);
-          outCD->CopyData(inCD, inCellId, outCellId++);
-        }
-        else // triangulate polygon
-        {
-          // initialize polygon
-          poly->PointIds->SetNumberOfIds(npts);
-          poly->Points->SetNumberOfPoints(npts);
-          for (vtkIdType i = 0; i < npts; i++)
-          {
-            poly->PointIds->SetId(i, pts[i]);
-            poly->Points->SetPoint(i, inPts->GetPoint(pts[i]));
-          }
-          poly->TriangulateLocalIds(0, ptIds);
-          const int numSimplices = ptIds->GetNumberOfIds() / 3;
-          for (vtkIdType i = 0; i < numSimplices; i++)
-          {
-            for (vtkIdType j = 0; j < 3; j++)
-            {
-              triPts[j] = poly->PointIds->GetId(ptIds->GetId(3 * i + j));
-            }
-            newPolys->InsertNextCell(3, triPts);
-            outCD->CopyData(inCD, inCellId, outCellId++);
-          } // for each simplex
-        }   // triangulate polygon
+        output->SetPolys(newPolys);
       }
-      output->SetPolys(newPolys);
+      inCellId += numInPolys;
     }
   }
 
@@ -286,30 +542,20 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // strips
   if (!abort && numInStrips > 0)
   {
-    outCellId = output->GetNumberOfCells();
-    if (newPolys == nullptr)
+    vtkSmartPointer<vtkCellArray> stripTris = TriangulateCells(this, inStrips, inPts, true,
+      this->Tolerance, inCD, outCD, inCellId, output->GetNumberOfCells(), numInCells);
+    if (stripTris && newPolys)
     {
-      newPolys = vtkSmartPointer<vtkCellArray>::New();
-      newPolys->AllocateCopy(inStrips);
+      newPolys->Append(stripTris);
     }
-
-    auto iter = vtk::TakeSmartPointer(inStrips->NewIterator());
-    for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal() && !abort;
-         iter->GoToNextCell(), ++inCellId)
+    else if (stripTris)
     {
-      if (!(inCellId % updateInterval)) // manage progress reports / early abort
-      {
-        this->UpdateProgress((float)inCellId / numInCells);
-        abort = this->CheckAbort();
-      }
-      iter->GetCurrentCell(npts, pts);
-      vtkTriangleStrip::DecomposeStrip(npts, pts, newPolys);
-      for (vtkIdType i = 0; i < (npts - 2); i++)
-      {
-        outCD->CopyData(inCD, inCellId, outCellId++);
-      }
-    } // for all strips
-    output->SetPolys(newPolys);
+      newPolys = stripTris;
+    }
+    if (newPolys)
+    {
+      output->SetPolys(newPolys);
+    }
   }
 
   // Update output
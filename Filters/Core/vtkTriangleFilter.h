@@ -8,6 +8,13 @@
  * strips.  It also generates line segments from polylines unless PassLines
  * is off, and generates individual vertex cells from vtkVertex point lists
  * unless PassVerts is off.
+ *
+ * Polygons and triangle strips are triangulated in parallel using
+ * vtkSMPTools: the triangles of each cell are counted (non-triangular
+ * polygons are triangulated with a thread-local vtkPolygon), their offsets
+ * are computed with a prefix sum, and the output triangles and their cell
+ * data are then filled in parallel. The output is the same as the one of a
+ * serial traversal of the cells.
  */
 
 #ifndef vtkTriangleFilter_h
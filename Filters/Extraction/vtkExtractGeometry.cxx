@@ -17,6 +17,8 @@
 #include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkExtractGeometry);
 vtkCxxSetObjectMacro(vtkExtractGeometry, ImplicitFunction, vtkImplicitFunction);
@@ -87,29 +89,37 @@ struct EvaluatePointsInsidenessFunctor
     const auto& points = vtk::DataArrayTupleRange<3>(this->PointsArray);
     auto insideness = vtk::DataArrayValueRange<1>(this->InsidenessArray);
 
-    double point[3];
+    // The points are evaluated by blocks with the batched evaluation of the
+    // implicit function.
+    constexpr vtkIdType blockSize = 256;
+    double blockPoints[3 * blockSize];
+    double values[blockSize];
     const bool isFirst = vtkSMPTools::GetSingleThread();
-    const auto checkAbortInterval = std::min((endPointId - beginPointId) / 10 + 1, (vtkIdType)1000);
-    for (vtkIdType pointId = beginPointId; pointId < endPointId; ++pointId)
+    for (vtkIdType blockBegin = beginPointId; blockBegin < endPointId; blockBegin += blockSize)
     {
-      if (pointId % checkAbortInterval == 0)
+      if (isFirst)
       {
-        if (isFirst)
-        {
-          this->Self->CheckAbort();
-        }
-        if (this->Self->GetAbortOutput())
-        {
-          break;
-        }
+        this->Self->CheckAbort();
+      }
+      if (this->Self->GetAbortOutput())
+      {
+        break;
       }
+      const vtkIdType blockEnd = std::min(blockBegin + blockSize, endPointId);
       // GetTuple creates a copy of the tuple using GetTypedTuple if it's not a vktDataArray
       // we do that since the input points can be implicit points, and GetTypedTuple is faster
       // than accessing the component of the TupleReference using GetTypedComponent internally.
-      points.GetTuple(pointId, point);
-
-      const auto scalar = this->ImplicitFunction->FunctionValue(point) * this->Multiplier;
-      insideness[pointId] = static_cast<unsigned char>(scalar < 0.0);
+      double* point = blockPoints;
+      for (vtkIdType pointId = blockBegin; pointId < blockEnd; ++pointId, point += 3)
+      {
+        points.GetTuple(pointId, point);
+      }
+      this->ImplicitFunction->FunctionValueBatch(blockPoints, values, blockEnd - blockBegin);
+      for (vtkIdType pointId = blockBegin; pointId < blockEnd; ++pointId)
+      {
+        const double scalar = values[pointId - blockBegin] * this->Multiplier;
+        insideness[pointId] = static_cast<unsigned char>(scalar < 0.0);
+      }
     }
   }
 };
@@ -153,28 +163,36 @@ struct EvaluatePointsScalarsFunctor
     const auto& points = vtk::DataArrayTupleRange<3>(this->PointsArray);
     auto scalars = vtk::DataArrayValueRange<1>(this->ScalarsArray);
 
-    double point[3];
+    // The points are evaluated by blocks with the batched evaluation of the
+    // implicit function.
+    constexpr vtkIdType blockSize = 256;
+    double blockPoints[3 * blockSize];
+    double values[blockSize];
     const bool isFirst = vtkSMPTools::GetSingleThread();
-    const auto checkAbortInterval = std::min((endPointId - beginPointId) / 10 + 1, (vtkIdType)1000);
-    for (vtkIdType pointId = beginPointId; pointId < endPointId; ++pointId)
+    for (vtkIdType blockBegin = beginPointId; blockBegin < endPointId; blockBegin += blockSize)
     {
-      if (pointId % checkAbortInterval == 0)
+      if (isFirst)
       {
-        if (isFirst)
-        {
-          this->Self->CheckAbort();
-        }
-        if (this->Self->GetAbortOutput())
-        {
-          break;
-        }
+        this->Self->CheckAbort();
       }
+      if (this->Self->GetAbortOutput())
+      {
+        break;
+      }
+      const vtkIdType blockEnd = std::min(blockBegin + blockSize, endPointId);
       // GetTuple creates a copy of the tuple using GetTypedTuple if it's not a vktDataArray
       // we do that since the input points can be implicit points, and GetTypedTuple is faster
       // than accessing the component of the TupleReference using GetTypedComponent internally.
-      points.GetTuple(pointId, point);
-
-      scalars[pointId] = this->ImplicitFunction->FunctionValue(point) * this->Multiplier;
+      double* point = blockPoints;
+      for (vtkIdType pointId = blockBegin; pointId < blockEnd; ++pointId, point += 3)
+      {
+        points.GetTuple(pointId, point);
+      }
+      this->ImplicitFunction->FunctionValueBatch(blockPoints, values, blockEnd - blockBegin);
+      for (vtkIdType pointId = blockBegin; pointId < blockEnd; ++pointId)
+      {
+        scalars[pointId] = values[pointId - blockBegin] * this->Multiplier;
+      }
     }
   }
 };
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the curvatures computed by vtkCurvatures on a sphere, and that they
+// do not depend on the number of threads.
+
+#include "vtkCurvatures.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkDataArray> ComputeCurvature(vtkPolyData* input, int type, int numThreads)
+{
+  vtkSMPTools::Initialize(numThreads);
+  vtkNew<vtkCurvatures> curvatures;
+  curvatures->SetInputData(input);
+  curvatures->SetCurvatureType(type);
+  curvatures->Update();
+  vtkSmartPointer<vtkDataArray> result = curvatures->GetOutput()->GetPointData()->GetScalars();
+  return result;
+}
+
+bool TestCurvature(const char* name, vtkPolyData* input, int type, double expected)
+{
+  vtkSmartPointer<vtkDataArray> serial = ComputeCurvature(input, type, 1);
+  vtkSmartPointer<vtkDataArray> threaded = ComputeCurvature(input, type, 4);
+  if (!serial || !threaded || serial->GetNumberOfTuples() != input->GetNumberOfPoints() ||
+    threaded->GetNumberOfTuples() != input->GetNumberOfPoints())
+  {
+    std::cerr << name << ": missing curvature array" << std::endl;
+    return false;
+  }
+
+  double mean = 0.0;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    if (serial->GetComponent(ptId, 0) != threaded->GetComponent(ptId, 0))
+    {
+      std::cerr << name << ": curvature at point " << ptId
+                << " differs with the number of threads" << std::endl;
+      return false;
+    }
+    mean += serial->GetComponent(ptId, 0);
+  }
+  mean /= input->GetNumberOfPoints();
+  std::cout << name << ": " << mean << " (expected " << expected << ")" << std::endl;
+  if (std::abs(mean - expected) > 0.05 * expected)
+  {
+    std::cerr << name << ": expected a curvature of " << expected << ", got " << mean
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCurvatures(int, char*[])
+{
+  const double radius = 2.0;
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(radius);
+  sphere->SetThetaResolution(80);
+  sphere->SetPhiResolution(80);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  bool success = true;
+  success &= TestCurvature("Gauss", input, VTK_CURVATURE_GAUSS, 1.0 / (radius * radius));
+  success &= TestCurvature("Mean", input, VTK_CURVATURE_MEAN, 1.0 / radius);
+
+  vtkSMPTools::Initialize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
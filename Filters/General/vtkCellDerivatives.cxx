@@ -5,6 +5,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkCellScratch.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
@@ -14,7 +15,6 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
-#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 
 #include <cmath>
@@ -57,10 +57,6 @@ struct CellDerivatives
   int ComputeVectorDerivs;
   int ComputeVorticity;
 
-  // A convenience to avoid repeated allocations
-  vtkSMPThreadLocal<vtkSmartPointer<vtkGenericCell>> Cell;
-  vtkSMPThreadLocal<vtkSmartPointer<vtkDoubleArray>> CellScalars;
-  vtkSMPThreadLocal<vtkSmartPointer<vtkDoubleArray>> CellVectors;
   vtkCellDerivatives* Filter;
 
   CellDerivatives(vtkDataSet* input, ScalarsT* s, VectorsT* v, vtkDoubleArray* g,
@@ -93,27 +89,14 @@ struct CellDerivatives
     }
   }
 
-  void Initialize()
-  {
-    this->Cell.Local().TakeReference(vtkGenericCell::New());
-    this->CellScalars.Local().TakeReference(vtkDoubleArray::New());
-    if (this->ComputeScalarDerivs)
-    {
-      this->CellScalars.Local()->SetNumberOfComponents(this->InScalars->GetNumberOfComponents());
-      this->CellScalars.Local()->Allocate(this->NumComp * VTK_CELL_SIZE);
-    }
-    this->CellVectors.Local().TakeReference(vtkDoubleArray::New());
-    this->CellVectors.Local()->SetNumberOfComponents(3);
-    this->CellVectors.Local()->Allocate(3 * VTK_CELL_SIZE);
-  }
-
   void operator()(vtkIdType cellId, vtkIdType endCellId)
   {
     int subId;
     double pcoords[3], derivs[9], tens[9], w[3], *scalars, *vectors;
-    vtkGenericCell* cell = this->Cell.Local();
-    vtkDoubleArray* cellScalars = this->CellScalars.Local();
-    vtkDoubleArray* cellVectors = this->CellVectors.Local();
+    // The cell and the per cell buffers come from the thread-local scratch,
+    // which stops allocating memory once it has grown to the largest cell.
+    vtkCellScratch::Frame frame;
+    vtkGenericCell* cell = frame.GetGenericCell();
     vtkDoubleArray* outGradients = this->OutGradients;
     vtkDoubleArray* outVorticity = this->OutVorticity;
     vtkDoubleArray* outTensors = this->OutTensors;
@@ -136,21 +119,28 @@ struct CellDerivatives
       }
       this->Input->GetCell(cellId, cell);
       subId = cell->GetParametricCenter(pcoords);
+      const vtkIdType numPts = cell->GetNumberOfPoints();
+      const vtkIdType* ptIds = cell->PointIds->GetPointer(0);
+      vtkCellScratch::Frame cellFrame;
 
       if (computeScalarDerivs)
       {
-        cellScalars->SetNumberOfTuples(cell->GetNumberOfPoints());
-        inScalars->GetTuples(cell->PointIds, cellScalars);
-        scalars = cellScalars->GetPointer(0);
+        scalars = cellFrame.Allocate<double>(numPts * this->NumComp);
+        for (vtkIdType i = 0; i < numPts; ++i)
+        {
+          inScalars->GetTuple(ptIds[i], scalars + i * this->NumComp);
+        }
         cell->Derivatives(subId, pcoords, scalars, 1, derivs);
         outGradients->SetTuple(cellId, derivs);
       }
 
       if (computeVectorDerivs || computeVorticity)
       {
-        cellVectors->SetNumberOfTuples(cell->GetNumberOfPoints());
-        inVectors->GetTuples(cell->PointIds, cellVectors);
-        vectors = cellVectors->GetPointer(0);
+        vectors = cellFrame.Allocate<double>(numPts * 3);
+        for (vtkIdType i = 0; i < numPts; ++i)
+        {
+          inVectors->GetTuple(ptIds[i], vectors + 3 * i);
+        }
         cell->Derivatives(0, pcoords, vectors, 3, derivs);
 
         // Insert appropriate tensor
@@ -218,8 +208,6 @@ struct CellDerivatives
       }
     } // for all cells
   }
-
-  void Reduce() {}
 };
 
 struct CellDerivativesWorker
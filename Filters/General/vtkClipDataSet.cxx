@@ -19,6 +19,8 @@
 #include "vtkNonLinearCell.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyhedron.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
@@ -286,11 +288,20 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
     {
       inPD->SetScalars(tmpScalars);
     }
-    double pt[3];
-    for (i = 0; i < numPts; i++)
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+    if (pointSet && pointSet->GetPoints())
     {
-      input->GetPoint(i, pt);
-      tmpScalars->SetValue(i, this->ClipFunction->FunctionValue(pt));
+      // Threaded, batched evaluation of the implicit function.
+      this->ClipFunction->FunctionValue(pointSet->GetPoints()->GetData(), tmpScalars);
+    }
+    else
+    {
+      double pt[3];
+      for (i = 0; i < numPts; i++)
+      {
+        input->GetPoint(i, pt);
+        tmpScalars->SetValue(i, this->ClipFunction->FunctionValue(pt));
+      }
     }
     clipScalars = tmpScalars;
   }
@@ -16,13 +16,310 @@
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 #include "vtkTriangleStrip.h"
 
-#include <memory> // For unique_ptr
+#include <algorithm>
 
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+bool CellUsesPoint(vtkIdType npts, const vtkIdType* pts, vtkIdType ptId)
+{
+  return std::find(pts, pts + npts, ptId) != pts + npts;
+}
+
+// Weighted mean curvature of the edge (v_l,v_r) of a facet (v_l,v_r,v_o),
+// shared with the neighbor facet (pts).
+double ComputeEdgeMeanCurvature(vtkPolyData* polyData, vtkIdType v_l, vtkIdType v_r,
+  vtkIdType v_o, vtkIdType npts, const vtkIdType* pts)
+{
+  double n_f[3]; // normal of facet
+  double n_n[3]; // normal of edge
+  double t[3];   // to store the cross product of n_f n_n
+  double ore[3]; // origin of e
+  double end[3]; // end of e
+  double oth[3]; //     third vertex necessary for comp of n
+  double vn0[3];
+  double vn1[3]; // vertices for computation of neighbour's n
+  double vn2[3];
+  double e[3]; // edge (oriented)
+  double Hf;
+
+  // find 3 corners of f: in order!
+  polyData->GetPoint(v_l, ore);
+  polyData->GetPoint(v_r, end);
+  polyData->GetPoint(v_o, oth);
+  // compute normal of f
+  vtkTriangle::ComputeNormal(ore, end, oth, n_f);
+  // compute common edge
+  e[0] = end[0] - ore[0];
+  e[1] = end[1] - ore[1];
+  e[2] = end[2] - ore[2];
+  const double length = vtkMath::Normalize(e);
+  double Af = vtkTriangle::TriangleArea(ore, end, oth);
+  // find 3 corners of n: in order!
+  polyData->GetPoint(pts[0], vn0);
+  polyData->GetPoint(pts[std::min<vtkIdType>(1, npts - 1)], vn1);
+  polyData->GetPoint(pts[std::min<vtkIdType>(2, npts - 1)], vn2);
+  Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
+  // compute normal of n
+  vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
+  // the cosine is n_f * n_n
+  const double cs = vtkMath::Dot(n_f, n_n);
+  // the sin is (n_f x n_n) * e
+  vtkMath::Cross(n_f, n_n, t);
+  const double sn = vtkMath::Dot(t, e);
+  // signed angle in [-pi,pi]
+  if (sn != 0.0 || cs != 0.0)
+  {
+    const double angle = atan2(sn, cs);
+    Hf = length * angle;
+  }
+  else
+  {
+    Hf = 0.0;
+  }
+  // weight Hf by the area of the facets
+  if (Af != 0.0)
+  {
+    (Hf /= Af) *= 3.0;
+  }
+  return Hf;
+}
+
+// Compute the mean curvature at each point from the edges of the cells using
+// it. An edge contributes only if it has exactly one neighbor facet n, and it
+// is accounted for by the facet f < n.
+struct ComputeMeanCurvature
+{
+  vtkPolyData* PolyData;
+  vtkStaticCellLinks* Links;
+  bool Invert;
+  double* MeanCurvature;
+  vtkAlgorithm* Filter;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkIdList> NeighborIds;
+
+  ComputeMeanCurvature(vtkPolyData* polyData, vtkStaticCellLinks* links, bool invert,
+    double* meanCurvature, vtkAlgorithm* filter)
+    : PolyData(polyData)
+    , Links(links)
+    , Invert(invert)
+    , MeanCurvature(meanCurvature)
+    , Filter(filter)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList* cellIds = this->CellIds.Local();
+    vtkIdList* neighborIds = this->NeighborIds.Local();
+    vtkIdType nv, npts;
+    const vtkIdType* vertices;
+    const vtkIdType* pts;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      const vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      double H = 0.0;
+      int numNeighbors = 0;
+
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        const vtkIdType f = cells[i];
+        if (i > 0 && f == cells[i - 1])
+        {
+          continue; // degenerate cell using the point several times
+        }
+        this->PolyData->GetCellPoints(f, nv, vertices, cellIds);
+
+        for (vtkIdType v = 0; v < nv; v++)
+        {
+          const vtkIdType v_l = vertices[v];
+          const vtkIdType v_r = vertices[(v + 1) % nv];
+          const vtkIdType v_o = vertices[(v + 2) % nv];
+          const int multiplicity = (v_l == ptId) + (v_r == ptId);
+          if (!multiplicity)
+          {
+            continue;
+          }
+
+          // The edge neighbors of f are the other cells using both points of
+          // the edge, all of them use ptId.
+          const vtkIdType other = (v_l == ptId ? v_r : v_l);
+          vtkIdType n = -1; // n short for neighbor
+          vtkIdType numEdgeNeighbors = 0;
+          for (vtkIdType j = 0; j < ncells && numEdgeNeighbors < 2; ++j)
+          {
+            const vtkIdType c = cells[j];
+            if (c == f || (j > 0 && c == cells[j - 1]))
+            {
+              continue;
+            }
+            this->PolyData->GetCellPoints(c, npts, pts, neighborIds);
+            if (CellUsesPoint(npts, pts, other))
+            {
+              n = c;
+              ++numEdgeNeighbors;
+            }
+          }
+
+          // compute only if there is really ONE neighbour
+          // AND the edge is accounted for by f (ensured by n > f)
+          if (numEdgeNeighbors == 1 && n > f)
+          {
+            this->PolyData->GetCellPoints(n, npts, pts, neighborIds);
+            const double Hf = ComputeEdgeMeanCurvature(this->PolyData, v_l, v_r, v_o, npts, pts);
+            for (int k = 0; k < multiplicity; ++k)
+            {
+              H += Hf;
+              ++numNeighbors;
+            }
+          }
+        }
+      }
+
+      if (numNeighbors > 0)
+      {
+        H = 0.5 * H / numNeighbors;
+        this->MeanCurvature[ptId] = (this->Invert ? -H : H);
+      }
+      else
+      {
+        this->MeanCurvature[ptId] = 0.0;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Compute the Gauss curvature at each point from the angles and areas of the
+// facets using it. Points not used by any facet are left untouched.
+struct ComputeGaussCurvatureWorker
+{
+  vtkPolyData* Output;
+  vtkCellArray* Facets;
+  vtkStaticCellLinksTemplate<vtkIdType>* Links;
+  double* GaussCurvature;
+  vtkAlgorithm* Filter;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+  ComputeGaussCurvatureWorker(vtkPolyData* output, vtkCellArray* facets,
+    vtkStaticCellLinksTemplate<vtkIdType>* links, double* gaussCurvature, vtkAlgorithm* filter)
+    : Output(output)
+    , Facets(facets)
+    , Links(links)
+    , GaussCurvature(gaussCurvature)
+    , Filter(filter)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList* cellIds = this->CellIds.Local();
+    double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
+    double alpha[3];
+    vtkIdType npts;
+    const vtkIdType* vert;
+    const double pi2 = 2.0 * vtkMath::Pi();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      const vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      double K = pi2;
+      double dA = 0.0;
+
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        if (i > 0 && cells[i] == cells[i - 1])
+        {
+          continue; // degenerate facet using the point several times
+        }
+        this->Facets->GetCellAtId(cells[i], npts, vert, cellIds);
+        if (npts < 3 || (vert[0] != ptId && vert[1] != ptId && vert[2] != ptId))
+        {
+          continue; // only the first three points of a facet are used
+        }
+
+        this->Output->GetPoint(vert[0], v0);
+        this->Output->GetPoint(vert[1], v1);
+        this->Output->GetPoint(vert[2], v2);
+        // edges
+        for (int k = 0; k < 3; ++k)
+        {
+          e0[k] = v1[k] - v0[k];
+          e1[k] = v2[k] - v1[k];
+          e2[k] = v0[k] - v2[k];
+        }
+
+        alpha[0] = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e1, e2);
+        alpha[1] = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e2, e0);
+        alpha[2] = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e0, e1);
+
+        // surf. area
+        const double A = double(vtkTriangle::TriangleArea(v0, v1, v2));
+        for (int j = 0; j < 3; ++j)
+        {
+          if (vert[j] == ptId)
+          {
+            dA += A;
+            K -= alpha[(j + 1) % 3];
+          }
+        }
+      }
+
+      if (dA > 0.0)
+      {
+        this->GaussCurvature[ptId] = 3.0 * K / dA;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+} // anonymous namespace
+
 vtkStandardNewMacro(vtkCurvatures);
 
 //-------------------------------------------------------//
@@ -62,143 +359,28 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
     return;
   }
 
-  int numPts = polyData->GetNumberOfPoints();
+  const vtkIdType numPts = polyData->GetNumberOfPoints();
 
-  //     create-allocate
-  const vtkNew<vtkIdList> vertices;
-  const vtkNew<vtkIdList> vertices_n;
-  const vtkNew<vtkIdList> neighbours;
   const vtkNew<vtkDoubleArray> meanCurvature;
   meanCurvature->SetName("Mean_Curvature");
   meanCurvature->SetNumberOfComponents(1);
   meanCurvature->SetNumberOfTuples(numPts);
-  // Get the array so we can write to it directly
-  double* meanCurvatureData = meanCurvature->GetPointer(0);
 
-  //     create-allocate
-  double n_f[3]; // normal of facet (could be stored for later?)
-  double n_n[3]; // normal of edge
-  double t[3];   // to store the cross product of n_f n_n
-  double ore[3]; // origin of e
-  double end[3]; // end of e
-  double oth[3]; //     third vertex necessary for comp of n
-  double vn0[3];
-  double vn1[3]; // vertices for computation of neighbour's n
-  double vn2[3];
-  double e[3]; // edge (oriented)
-
-  polyData->BuildLinks();
-  // data init
-  const int F = polyData->GetNumberOfCells();
-  // init, preallocate the mean curvature
-  const std::unique_ptr<int[]> num_neighb(new int[numPts]);
-  for (int v = 0; v < numPts; v++)
-  {
-    meanCurvatureData[v] = 0.0;
-    num_neighb[v] = 0;
-  }
-
-  //     main loop
-  vtkDebugMacro(<< "Main loop: loop over facets such that id > id of neighb");
-  vtkDebugMacro(<< "so that every edge comes only once");
-
-  for (vtkIdType f = 0; f < F; ++f)
+  // Every point gathers the contributions of the edges it uses, so that the
+  // points can be processed in parallel.
+  if (polyData->NeedToBuildCells())
   {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    polyData->GetCellPoints(f, vertices);
-    const vtkIdType nv = vertices->GetNumberOfIds();
-
-    for (vtkIdType v = 0; v < nv; v++)
-    {
-      // get neighbour
-      const vtkIdType v_l = vertices->GetId(v);
-      const vtkIdType v_r = vertices->GetId((v + 1) % nv);
-      const vtkIdType v_o = vertices->GetId((v + 2) % nv);
-      polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
-
-      vtkIdType n; // n short for neighbor
-
-      // compute only if there is really ONE neighbour
-      // AND meanCurvature has not been computed yet!
-      // (ensured by n > f)
-      if (neighbours->GetNumberOfIds() == 1 && (n = neighbours->GetId(0)) > f)
-      {
-        double Hf; // temporary store
-
-        // find 3 corners of f: in order!
-        polyData->GetPoint(v_l, ore);
-        polyData->GetPoint(v_r, end);
-        polyData->GetPoint(v_o, oth);
-        // compute normal of f
-        vtkTriangle::ComputeNormal(ore, end, oth, n_f);
-        // compute common edge
-        e[0] = end[0];
-        e[1] = end[1];
-        e[2] = end[2];
-        e[0] -= ore[0];
-        e[1] -= ore[1];
-        e[2] -= ore[2];
-        const double length = vtkMath::Normalize(e);
-        double Af = vtkTriangle::TriangleArea(ore, end, oth);
-        // find 3 corners of n: in order!
-        polyData->GetCellPoints(n, vertices_n);
-        polyData->GetPoint(vertices_n->GetId(0), vn0);
-        polyData->GetPoint(vertices_n->GetId(1), vn1);
-        polyData->GetPoint(vertices_n->GetId(2), vn2);
-        Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
-        // compute normal of n
-        vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
-        // the cosine is n_f * n_n
-        const double cs = vtkMath::Dot(n_f, n_n);
-        // the sin is (n_f x n_n) * e
-        vtkMath::Cross(n_f, n_n, t);
-        const double sn = vtkMath::Dot(t, e);
-        // signed angle in [-pi,pi]
-        if (sn != 0.0 || cs != 0.0)
-        {
-          const double angle = atan2(sn, cs);
-          Hf = length * angle;
-        }
-        else
-        {
-          Hf = 0.0;
-        }
-        // add weighted Hf to scalar at v_l and v_r
-        if (Af != 0.0)
-        {
-          (Hf /= Af) *= 3.0;
-        }
-        meanCurvatureData[v_l] += Hf;
-        meanCurvatureData[v_r] += Hf;
-        num_neighb[v_l] += 1;
-        num_neighb[v_r] += 1;
-      }
-    }
+    polyData->BuildCells();
   }
+  vtkNew<vtkStaticCellLinks> links;
+  links->SetDataSet(polyData);
+  links->BuildLinks();
+  links->SortLinks();
 
-  // put curvature in vtkArray
-  for (int v = 0; v < numPts; v++)
-  {
-    if (num_neighb[v] > 0)
-    {
-      const double Hf = 0.5 * meanCurvatureData[v] / num_neighb[v];
-      if (this->InvertMeanCurvature)
-      {
-        meanCurvatureData[v] = -Hf;
-      }
-      else
-      {
-        meanCurvatureData[v] = Hf;
-      }
-    }
-    else
-    {
-      meanCurvatureData[v] = 0.0;
-    }
-  }
+  vtkDebugMacro(<< "Main loop: loop over the edges of the cells using each point");
+  ComputeMeanCurvature compute(
+    polyData, links, this->InvertMeanCurvature != 0, meanCurvature->GetPointer(0), this);
+  vtkSMPTools::For(0, numPts, compute);
 
   mesh->GetPointData()->AddArray(meanCurvature);
   mesh->GetPointData()->SetActiveScalars("Mean_Curvature");
@@ -261,80 +443,13 @@ void vtkCurvatures::GetGaussCurvature(vtkPolyData* output)
 void vtkCurvatures::ComputeGaussCurvature(
   vtkCellArray* facets, vtkPolyData* output, double* gaussCurvatureData)
 {
-  double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
-
-  double A, alpha0, alpha1, alpha2;
-
-  vtkIdType f;
-  const vtkIdType* vert = nullptr;
-
-  // other data
-  vtkIdType Nv = output->GetNumberOfPoints();
-
-  const std::unique_ptr<double[]> K(new double[Nv]);
-  const std::unique_ptr<double[]> dA(new double[Nv]);
-  double pi2 = 2.0 * vtkMath::Pi();
-  for (int k = 0; k < Nv; k++)
-  {
-    K[k] = pi2;
-    dA[k] = 0.0;
-  }
-
-  facets->InitTraversal();
-  while (facets->GetNextCell(f, vert))
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    output->GetPoint(vert[0], v0);
-    output->GetPoint(vert[1], v1);
-    output->GetPoint(vert[2], v2);
-    // edges
-    e0[0] = v1[0];
-    e0[1] = v1[1];
-    e0[2] = v1[2];
-    e0[0] -= v0[0];
-    e0[1] -= v0[1];
-    e0[2] -= v0[2];
-
-    e1[0] = v2[0];
-    e1[1] = v2[1];
-    e1[2] = v2[2];
-    e1[0] -= v1[0];
-    e1[1] -= v1[1];
-    e1[2] -= v1[2];
-
-    e2[0] = v0[0];
-    e2[1] = v0[1];
-    e2[2] = v0[2];
-    e2[0] -= v2[0];
-    e2[1] -= v2[1];
-    e2[2] -= v2[2];
-
-    alpha0 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e1, e2);
-    alpha1 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e2, e0);
-    alpha2 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e0, e1);
-
-    // surf. area
-    A = double(vtkTriangle::TriangleArea(v0, v1, v2));
-    // UPDATE
-    dA[vert[0]] += A;
-    dA[vert[1]] += A;
-    dA[vert[2]] += A;
-    K[vert[0]] -= alpha1;
-    K[vert[1]] -= alpha2;
-    K[vert[2]] -= alpha0;
-  }
+  const vtkIdType numPts = output->GetNumberOfPoints();
+  vtkStaticCellLinksTemplate<vtkIdType> links;
+  links.ThreadedBuildLinks(numPts, facets->GetNumberOfCells(), facets);
+  links.SortLinks();
 
-  // put curvature in vtkArray
-  for (int v = 0; v < Nv; v++)
-  {
-    if (dA[v] > 0.0)
-    {
-      gaussCurvatureData[v] = 3.0 * K[v] / dA[v];
-    }
-  }
+  ComputeGaussCurvatureWorker compute(output, facets, &links, gaussCurvatureData, this);
+  vtkSMPTools::For(0, numPts, compute);
 }
 
 void vtkCurvatures::GetMaximumCurvature(vtkPolyData* input, vtkPolyData* output)
@@ -41,6 +41,10 @@
  *  can be set and the Curvature reported by the Mean calculation will
  * be inverted.
  *
+ * The curvatures are gathered at each point from the cells using it, in
+ * parallel with vtkSMPTools. The result does not depend on the number of
+ * threads.
+ *
  * For a little more information see
  * <a href="https://public.kitware.com/pipermail/vtkusers/2002-July/012198.html"
  * >Computing curvature of a surface</a>
@@ -16,10 +16,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkRunLengthArray.h"
 #include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDiscreteFlyingEdges3D);
@@ -86,10 +89,10 @@ public:
   // tables at the point of instantiation.
   unsigned char IncludesAxes[256];
 
-  // Algorithm-derived data. XCases tracks the x-row edge cases. The
-  // EdgeMetaData tracks information needed for parallel partitioning,
-  // and to enable generation of the output primitives without using
-  // a point locator.
+  // Algorithm-derived data. XCases tracks the x-row edge cases, it is not
+  // allocated when the scalars are stored as runs. The EdgeMetaData tracks
+  // information needed for parallel partitioning, and to enable generation
+  // of the output primitives without using a point locator.
   unsigned char* XCases;
   vtkIdType* EdgeMetaData;
 
@@ -109,6 +112,15 @@ public:
   int Max2;
   int Inc2;
 
+  // When the scalars are stored as runs, the rows are decoded into buffers
+  // as they are needed rather than read through Scalars. RunRowOffset is the
+  // run row of the first x-row of the extent, and RunStart is the position
+  // of the extent along the rows.
+  const vtkRunLengthImplicitBackend<T>* Runs;
+  vtkIdType RunRowOffset;
+  vtkIdType RunRowsPerSlice;
+  int RunStart;
+
   // Output data. Threads write to partitioned memory.
   T* NewScalars;
   vtkCellArray* NewTris;
@@ -124,8 +136,76 @@ public:
 
   // The three main passes of the algorithm.
   void ProcessXEdge(double value, T const* inPtr, vtkIdType row, vtkIdType slice); // PASS 1
-  void ProcessYZEdges(vtkIdType row, vtkIdType slice);                             // PASS 2
-  void GenerateOutput(double value, T* inPtr, vtkIdType row, vtkIdType slice);     // PASS 4
+  void ProcessRunXEdge(double value, vtkIdType row, vtkIdType slice, unsigned char* ePtr);
+  void ProcessYZEdges(vtkIdType row, vtkIdType slice, unsigned char* const xCases[4]); // PASS 2
+  void GenerateOutput(double value, T* inPtr, vtkIdType row, vtkIdType slice,
+    unsigned char* const xCases[4]); // PASS 4
+
+  // Compute the x-edge cases of an x-row from its runs, when the scalars are
+  // stored as runs. The voxels covered by each run are classified at once,
+  // then each pair of neighbor voxels gives the case of the x-edge between
+  // them. The buffer must hold Dims[0] values.
+  void ComputeRunXCases(double value, vtkIdType row, vtkIdType slice, unsigned char* ePtr) const;
+
+  // Get the x-edge cases of the four x-rows bounding the voxel row (row,
+  // slice). When XCases is not allocated, the cases are computed from the
+  // runs into runCases, which holds four x-rows. The voxel rows of a slice
+  // must then be visited in order from row 0, so that the x-rows at row+1
+  // are reused as the x-rows at row for the next voxel row.
+  void GetXCases(double value, vtkIdType row, vtkIdType slice, unsigned char* runCases,
+    unsigned char* xCases[4]) const
+  {
+    if (this->XCases)
+    {
+      xCases[0] = this->XCases + slice * this->SliceOffset + row * (this->Dims[0] - 1);
+      xCases[1] = xCases[0] + this->Dims[0] - 1;
+      xCases[2] = xCases[0] + this->SliceOffset;
+      xCases[3] = xCases[2] + this->Dims[0] - 1;
+    }
+    else if (row == 0)
+    {
+      for (int k = 0; k < 4; ++k)
+      {
+        xCases[k] = runCases + k * this->Dims[0];
+      }
+      this->ComputeRunXCases(value, 0, slice, xCases[0]);
+      this->ComputeRunXCases(value, 1, slice, xCases[1]);
+      this->ComputeRunXCases(value, 0, slice + 1, xCases[2]);
+      this->ComputeRunXCases(value, 1, slice + 1, xCases[3]);
+    }
+    else
+    {
+      std::swap(xCases[0], xCases[1]);
+      std::swap(xCases[2], xCases[3]);
+      this->ComputeRunXCases(value, row + 1, slice, xCases[1]);
+      this->ComputeRunXCases(value, row + 1, slice + 1, xCases[3]);
+    }
+  }
+
+  // Decode the scalars of an x-row when they are stored as runs.
+  void DecodeRow(vtkIdType row, vtkIdType slice, T* buffer) const
+  {
+    this->Runs->DecodeRow(this->RunRowOffset + row + slice * this->RunRowsPerSlice,
+      this->RunStart, this->RunStart + static_cast<int>(this->Dims[0]) - 1, buffer);
+  }
+
+  // Decode the slices around a slice, from slice-1 to slice+2, which are
+  // the scalars used to generate the output of the voxels of the slice.
+  // The buffer holds four slices laid out like the input scalars.
+  void DecodeSlices(vtkIdType slice, T* buffer) const
+  {
+    for (vtkIdType k = slice - 1; k <= slice + 2; ++k)
+    {
+      if (k >= 0 && k < this->Dims[2])
+      {
+        T* rowPtr = buffer + (k - slice + 1) * this->Inc2;
+        for (vtkIdType row = 0; row < this->Dims[1]; ++row, rowPtr += this->Inc1)
+        {
+          this->DecodeRow(row, k, rowPtr);
+        }
+      }
+    }
+  }
 
   // Place holder for now in case fancy bit fiddling is needed later.
   void SetXEdge(unsigned char* ePtr, unsigned char edgeCase) { *ePtr = edgeCase; }
@@ -323,11 +403,11 @@ public:
     void operator()(vtkIdType slice, vtkIdType end)
     {
       vtkIdType row;
-      TT *rowPtr, *slicePtr = this->Algo->Scalars + slice * this->Algo->Inc2;
+      std::vector<unsigned char> runCases(this->Algo->Runs ? this->Algo->Dims[0] : 0);
       bool isFirst = vtkSMPTools::GetSingleThread();
       for (; slice < end && !this->Filter->GetAbortOutput(); ++slice)
       {
-        for (row = 0, rowPtr = slicePtr; row < this->Algo->Dims[1]; ++row)
+        for (row = 0; row < this->Algo->Dims[1]; ++row)
         {
           if (isFirst)
           {
@@ -337,26 +417,37 @@ public:
           {
             break;
           }
-          this->Algo->ProcessXEdge(this->Value, rowPtr, row, slice);
-          rowPtr += this->Algo->Inc1;
+          if (this->Algo->Runs)
+          {
+            this->Algo->ProcessRunXEdge(this->Value, row, slice, runCases.data());
+          }
+          else
+          {
+            this->Algo->ProcessXEdge(this->Value,
+              this->Algo->Scalars + slice * this->Algo->Inc2 + row * this->Algo->Inc1, row, slice);
+          }
         } // for all rows in this slice
-        slicePtr += this->Algo->Inc2;
-      } // for all slices in this batch
+      }   // for all slices in this batch
     }
   };
   template <class TT>
   class Pass2
   {
   public:
-    Pass2(vtkDiscreteFlyingEdges3DAlgorithm<TT>* algo, vtkDiscreteFlyingEdges3D* filter)
+    Pass2(
+      vtkDiscreteFlyingEdges3DAlgorithm<TT>* algo, double value, vtkDiscreteFlyingEdges3D* filter)
     {
       this->Algo = algo;
+      this->Value = value;
       this->Filter = filter;
     }
     vtkDiscreteFlyingEdges3DAlgorithm<TT>* Algo;
+    double Value;
     vtkDiscreteFlyingEdges3D* Filter;
     void operator()(vtkIdType slice, vtkIdType end)
     {
+      unsigned char* xCases[4];
+      std::vector<unsigned char> runCases(this->Algo->Runs ? 4 * this->Algo->Dims[0] : 0);
       bool isFirst = vtkSMPTools::GetSingleThread();
       for (; slice < end && !this->Filter->GetAbortOutput(); ++slice)
       {
@@ -370,7 +461,8 @@ public:
           {
             break;
           }
-          this->Algo->ProcessYZEdges(row, slice);
+          this->Algo->GetXCases(this->Value, row, slice, runCases.data(), xCases);
+          this->Algo->ProcessYZEdges(row, slice, xCases);
         } // for all rows in this slice
       }   // for all slices in this batch
     }
@@ -394,7 +486,10 @@ public:
       vtkIdType row;
       vtkIdType* eMD0 = this->Algo->EdgeMetaData + slice * 6 * this->Algo->Dims[1];
       vtkIdType* eMD1 = eMD0 + 6 * this->Algo->Dims[1];
-      TT *rowPtr, *slicePtr = this->Algo->Scalars + slice * this->Algo->Inc2;
+      TT* rowPtr;
+      unsigned char* xCases[4];
+      std::vector<TT> sliceBuffer(this->Algo->Runs ? 4 * this->Algo->Inc2 : 0);
+      std::vector<unsigned char> runCases(this->Algo->Runs ? 4 * this->Algo->Dims[0] : 0);
       bool isFirst = vtkSMPTools::GetSingleThread();
       for (; slice < end; ++slice)
       {
@@ -409,13 +504,22 @@ public:
         // It's possible to skip entire slices if there is nothing to generate
         if (eMD1[3] > eMD0[3]) // there are triangle primitives!
         {
-          for (row = 0, rowPtr = slicePtr; row < this->Algo->Dims[1] - 1; ++row)
+          if (this->Algo->Runs)
+          {
+            this->Algo->DecodeSlices(slice, sliceBuffer.data());
+            rowPtr = sliceBuffer.data() + this->Algo->Inc2;
+          }
+          else
           {
-            this->Algo->GenerateOutput(this->Value, rowPtr, row, slice);
+            rowPtr = this->Algo->Scalars + slice * this->Algo->Inc2;
+          }
+          for (row = 0; row < this->Algo->Dims[1] - 1; ++row)
+          {
+            this->Algo->GetXCases(this->Value, row, slice, runCases.data(), xCases);
+            this->Algo->GenerateOutput(this->Value, rowPtr, row, slice, xCases);
             rowPtr += this->Algo->Inc1;
           } // for all rows in this slice
         }   // if there are triangles
-        slicePtr += this->Algo->Inc2;
         eMD0 = eMD1;
         eMD1 = eMD0 + 6 * this->Algo->Dims[1];
       } // for all slices in this batch
@@ -424,9 +528,8 @@ public:
 
   // Interface between VTK and templated functions
   static void Contour(vtkDiscreteFlyingEdges3D* self, vtkImageData* input, vtkDataArray* inScalars,
-    int extent[6], vtkIdType* incs, T* scalars, vtkPolyData* output, vtkPoints* newPts,
-    vtkCellArray* newTris, vtkDataArray* newScalars, vtkFloatArray* newNormals,
-    vtkFloatArray* newGradients);
+    int extent[6], vtkIdType* incs, vtkPolyData* output, vtkPoints* newPts, vtkCellArray* newTris,
+    vtkDataArray* newScalars, vtkFloatArray* newNormals, vtkFloatArray* newGradients);
 };
 
 //------------------------------------------------------------------------------
@@ -977,6 +1080,74 @@ void vtkDiscreteFlyingEdges3DAlgorithm<T>::ProcessXEdge(
   edgeMetaData[5] = maxInt; // where intersections end along x edge
 }
 
+//------------------------------------------------------------------------------
+// PASS 1 for scalars stored as runs: the x-edge cases are computed from the
+// runs of the x-row into ePtr, which only holds this x-row, and the x-edge
+// intersections are counted from them.
+template <class T>
+void vtkDiscreteFlyingEdges3DAlgorithm<T>::ProcessRunXEdge(
+  double value, vtkIdType row, vtkIdType slice, unsigned char* ePtr)
+{
+  vtkIdType nxcells = this->Dims[0] - 1;
+  vtkIdType minInt = nxcells, maxInt = 0;
+  vtkIdType sum = 0;
+
+  this->ComputeRunXCases(value, row, slice, ePtr);
+
+  vtkIdType* edgeMetaData = this->EdgeMetaData + (slice * this->Dims[1] + row) * 6;
+  std::fill_n(edgeMetaData, 6, 0);
+  for (vtkIdType i = 0; i < nxcells; ++i)
+  {
+    if (ePtr[i] == vtkDiscreteFlyingEdges3DAlgorithm::LeftOutside ||
+      ePtr[i] == vtkDiscreteFlyingEdges3DAlgorithm::RightOutside)
+    {
+      ++sum;
+      if (i < minInt)
+      {
+        minInt = i;
+      }
+      maxInt = i + 1;
+    }
+  }
+
+  edgeMetaData[0] = sum;
+  edgeMetaData[4] = minInt;
+  edgeMetaData[5] = maxInt;
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkDiscreteFlyingEdges3DAlgorithm<T>::ComputeRunXCases(
+  double value, vtkIdType row, vtkIdType slice, unsigned char* ePtr) const
+{
+  // Flag the voxels that have the label value, run by run.
+  const T labelValue = static_cast<T>(value);
+  const int first = this->RunStart;
+  const int last = first + static_cast<int>(this->Dims[0]) - 1;
+  std::fill_n(ePtr, this->Dims[0], this->Runs->GetBackgroundValue() == labelValue ? 1 : 0);
+  const int* starts;
+  const int* ends;
+  const T* values;
+  const int numRuns = this->Runs->GetRowRuns(
+    this->RunRowOffset + row + slice * this->RunRowsPerSlice, starts, ends, values);
+  for (int r = 0; r < numRuns; ++r)
+  {
+    const int start = std::max(starts[r], first);
+    const int end = std::min(ends[r], last);
+    if (start <= end)
+    {
+      std::fill(ePtr + (start - first), ePtr + (end - first + 1), values[r] == labelValue ? 1 : 0);
+    }
+  }
+
+  // The first bit of an x-edge case is set when its left voxel is inside,
+  // the second bit when its right voxel is inside.
+  for (vtkIdType i = 0; i < this->Dims[0] - 1; ++i)
+  {
+    ePtr[i] |= ePtr[i + 1] << 1;
+  }
+}
+
 //------------------------------------------------------------------------------
 // PASS 2: Process a single x-row of voxels. Count the number of y- and
 // z-intersections by topological reasoning from x-edge cases. Determine the
@@ -985,14 +1156,12 @@ void vtkDiscreteFlyingEdges3DAlgorithm<T>::ProcessXEdge(
 // four x-edge rows that bound the voxel x-row and which contain edge case
 // information.
 template <class T>
-void vtkDiscreteFlyingEdges3DAlgorithm<T>::ProcessYZEdges(vtkIdType row, vtkIdType slice)
+void vtkDiscreteFlyingEdges3DAlgorithm<T>::ProcessYZEdges(
+  vtkIdType row, vtkIdType slice, unsigned char* const xCases[4])
 {
   // Grab the four edge cases bounding this voxel x-row.
   unsigned char *ePtr[4], ec0, ec1, ec2, ec3, xInts = 1;
-  ePtr[0] = this->XCases + slice * this->SliceOffset + row * (this->Dims[0] - 1);
-  ePtr[1] = ePtr[0] + this->Dims[0] - 1;
-  ePtr[2] = ePtr[0] + this->SliceOffset;
-  ePtr[3] = ePtr[2] + this->Dims[0] - 1;
+  std::copy(xCases, xCases + 4, ePtr);
 
   // Grab the edge meta data surrounding the voxel row.
   vtkIdType* eMD[4];
@@ -1112,7 +1281,7 @@ void vtkDiscreteFlyingEdges3DAlgorithm<T>::ProcessYZEdges(vtkIdType row, vtkIdTy
 // algorithm.
 template <class T>
 void vtkDiscreteFlyingEdges3DAlgorithm<T>::GenerateOutput(
-  double value, T* rowPtr, vtkIdType row, vtkIdType slice)
+  double value, T* rowPtr, vtkIdType row, vtkIdType slice, unsigned char* const xCases[4])
 {
   // Grab the edge meta data surrounding the voxel row.
   vtkIdType* eMD[4];
@@ -1139,10 +1308,10 @@ void vtkDiscreteFlyingEdges3DAlgorithm<T>::GenerateOutput(
 
   // Grab the four edge cases bounding this voxel x-row. Begin at left trim edge.
   unsigned char* ePtr[4];
-  ePtr[0] = this->XCases + slice * this->SliceOffset + row * (this->Dims[0] - 1) + xL;
-  ePtr[1] = ePtr[0] + this->Dims[0] - 1;
-  ePtr[2] = ePtr[0] + this->SliceOffset;
-  ePtr[3] = ePtr[2] + this->Dims[0] - 1;
+  for (int k = 0; k < 4; ++k)
+  {
+    ePtr[k] = xCases[k] + xL;
+  }
 
   // Traverse all voxels in this row, those containing the contour are
   // further identified for processing, meaning generating points and
@@ -1223,7 +1392,7 @@ void vtkDiscreteFlyingEdges3DAlgorithm<T>::GenerateOutput(
 // class. It also invokes the three passes of the Flying Edges algorithm.
 template <class T>
 void vtkDiscreteFlyingEdges3DAlgorithm<T>::Contour(vtkDiscreteFlyingEdges3D* self,
-  vtkImageData* input, vtkDataArray* inScalars, int extent[6], vtkIdType* incs, T* scalars,
+  vtkImageData* input, vtkDataArray* inScalars, int extent[6], vtkIdType* incs,
   vtkPolyData* output, vtkPoints* newPts, vtkCellArray* newTris, vtkDataArray* newScalars,
   vtkFloatArray* newNormals, vtkFloatArray* newGradients)
 {
@@ -1238,7 +1407,8 @@ void vtkDiscreteFlyingEdges3DAlgorithm<T>::Contour(vtkDiscreteFlyingEdges3D* sel
   // This may be subvolume of the total 3D image. Capture information for
   // subsequent processing.
   vtkDiscreteFlyingEdges3DAlgorithm<T> algo;
-  algo.Scalars = scalars;
+  algo.Scalars = nullptr;
+  algo.Runs = nullptr;
   algo.Min0 = extent[0];
   algo.Max0 = extent[1];
   algo.Inc0 = incs[0];
@@ -1249,13 +1419,34 @@ void vtkDiscreteFlyingEdges3DAlgorithm<T>::Contour(vtkDiscreteFlyingEdges3D* sel
   algo.Max2 = extent[5];
   algo.Inc2 = incs[2];
 
-  // Now allocate working arrays. The XCases array tracks x-edge cases.
+  // Labels stored as runs are decoded a few slices at a time, rather than
+  // being expanded into a dense array of the size of the volume.
+  vtkRunLengthArray<T>* runArray = vtkArrayDownCast<vtkRunLengthArray<T>>(inScalars);
+  const int* inExt = input->GetExtent();
+  const vtkIdType rowsPerSlice = inExt[3] - inExt[2] + 1;
+  if (runArray && runArray->GetBackend() &&
+    runArray->GetBackend()->GetRowLength() == inExt[1] - inExt[0] + 1 &&
+    runArray->GetBackend()->GetNumberOfRows() == rowsPerSlice * (inExt[5] - inExt[4] + 1))
+  {
+    algo.Runs = runArray->GetBackend().get();
+    algo.RunRowOffset = (extent[2] - inExt[2]) + (extent[4] - inExt[4]) * rowsPerSlice;
+    algo.RunRowsPerSlice = rowsPerSlice;
+    algo.RunStart = extent[0] - inExt[0];
+  }
+  else
+  {
+    algo.Scalars = static_cast<T*>(input->GetArrayPointerForExtent(inScalars, extent));
+  }
+
+  // Now allocate working arrays. The XCases array tracks x-edge cases, the
+  // cases of runs are computed again where they are needed instead.
   algo.Dims[0] = algo.Max0 - algo.Min0 + 1;
   algo.Dims[1] = algo.Max1 - algo.Min1 + 1;
   algo.Dims[2] = algo.Max2 - algo.Min2 + 1;
   algo.NumberOfEdges = algo.Dims[1] * algo.Dims[2];
   algo.SliceOffset = (algo.Dims[0] - 1) * algo.Dims[1];
-  algo.XCases = new unsigned char[(algo.Dims[0] - 1) * algo.NumberOfEdges];
+  algo.XCases =
+    algo.Runs ? nullptr : new unsigned char[(algo.Dims[0] - 1) * algo.NumberOfEdges];
 
   // Also allocate the characterization (metadata) array for the x edges.
   // This array tracks the number of x-, y- and z- intersections on the voxel
@@ -1290,7 +1481,7 @@ void vtkDiscreteFlyingEdges3DAlgorithm<T>::Contour(vtkDiscreteFlyingEdges3D* sel
     // PASS 2: Traverse all voxel x-rows and process voxel y&z edges.  The
     // result is a count of the number of y- and z-intersections, as well as
     // the number of triangles generated along these voxel rows.
-    Pass2<T> pass2(&algo, self);
+    Pass2<T> pass2(&algo, value, self);
     vtkSMPTools::For(0, algo.Dims[2] - 1, pass2);
 
     // PASS 3: Now allocate and generate output. First we have to update the
@@ -1515,7 +1706,7 @@ int vtkDiscreteFlyingEdges3D::RequestData(
 
   if (this->ComputeScalars)
   {
-    newScalars.TakeReference(inScalars->NewInstance());
+    newScalars.TakeReference(vtkDataArray::CreateDataArray(inScalars->GetDataType()));
     newScalars->SetNumberOfComponents(1);
     newScalars->SetName(inScalars->GetName());
   }
@@ -1532,13 +1723,12 @@ int vtkDiscreteFlyingEdges3D::RequestData(
     newGradients->SetName("Gradients");
   }
 
-  void* ptr = input->GetArrayPointerForExtent(inScalars, exExt);
   vtkIdType incs[3];
   input->GetIncrements(inScalars, incs);
   switch (inScalars->GetDataType())
   {
     vtkTemplateMacro(vtkDiscreteFlyingEdges3DAlgorithm<VTK_TT>::Contour(this, input, inScalars,
-      exExt, incs, (VTK_TT*)ptr, output, newPts, newTris, newScalars, newNormals, newGradients));
+      exExt, incs, output, newPts, newTris, newScalars, newNormals, newGradients));
   }
 
   vtkDebugMacro(<< "Created: " << newPts->GetNumberOfPoints() << " points, "
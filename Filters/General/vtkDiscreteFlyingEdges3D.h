@@ -31,6 +31,12 @@
  * found in the input segmentation mask to contiguous forms of smaller type.
  *
  * @warning
+ * Label maps whose scalars are a vtkRunLengthArray (for instance from
+ * vtkImageStencilToImage) are decoded a few slices at a time, and their
+ * x-edge cases are computed from the runs of each row where they are needed.
+ * Neither the dense volume nor the per-edge case array are allocated.
+ *
+ * @warning
  * This class has been threaded with vtkSMPTools. Using TBB or other
  * non-sequential type (set in the CMake variable
  * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
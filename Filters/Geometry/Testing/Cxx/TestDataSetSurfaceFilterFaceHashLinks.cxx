@@ -0,0 +1,301 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the threaded external face extraction of vtkDataSetSurfaceFilter on a
+// vtkUnstructuredGrid mixing several linear 3D cell types: the output must be the
+// same, in the same order, as the one of the serial quad hash that is still used for
+// other vtkUnstructuredGridBase subclasses, it must not depend on the number of
+// threads, and the boundary faces must match the ones of vtkGeometryFilter. The face
+// shared by a quadratic and a linear tetrahedron must be hidden when the boundaries
+// are matched ignoring the cell order.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkGeometryFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMappedUnstructuredGridGenerator.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridBase.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr int Dim = 4;
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (Dim + 1) * (j + (Dim + 1) * k);
+}
+
+// Build a grid of Dim^3 hexahedral bricks. Depending on their position, bricks are
+// represented by a hexahedron, a voxel, two wedges or five tetrahedra. A pyramid is
+// glued on top of the grid and an interior hexahedron can be hidden.
+vtkSmartPointer<vtkUnstructuredGrid> CreateGrid(bool hideCell)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Dim; ++k)
+  {
+    for (int j = 0; j <= Dim; ++j)
+    {
+      for (int i = 0; i <= Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  const vtkIdType apex = points->InsertNextPoint(0.5, 0.5, Dim + 1.0);
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->AllocateEstimate(Dim * Dim * Dim * 5, 8);
+  vtkIdType hiddenCellId = -1;
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        const vtkIdType p[8] = { PointId(i, j, k), PointId(i + 1, j, k), PointId(i + 1, j + 1, k),
+          PointId(i, j + 1, k), PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+          PointId(i + 1, j + 1, k + 1), PointId(i, j + 1, k + 1) };
+        switch ((i + 2 * j + 3 * k) % 4)
+        {
+          case 0:
+          {
+            vtkIdType cellId = grid->InsertNextCell(VTK_HEXAHEDRON, 8, p);
+            if (i == 1 && j == 2 && k == 1)
+            {
+              hiddenCellId = cellId;
+            }
+            break;
+          }
+          case 1:
+          {
+            const vtkIdType voxel[8] = { p[0], p[1], p[3], p[2], p[4], p[5], p[7], p[6] };
+            grid->InsertNextCell(VTK_VOXEL, 8, voxel);
+            break;
+          }
+          case 2:
+          {
+            const vtkIdType wedge0[6] = { p[0], p[1], p[2], p[4], p[5], p[6] };
+            const vtkIdType wedge1[6] = { p[0], p[2], p[3], p[4], p[6], p[7] };
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge0);
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge1);
+            break;
+          }
+          default:
+          {
+            const vtkIdType tets[5][4] = { { p[0], p[1], p[3], p[4] }, { p[1], p[2], p[3], p[6] },
+              { p[1], p[4], p[5], p[6] }, { p[3], p[4], p[6], p[7] }, { p[1], p[3], p[4], p[6] } };
+            for (const auto& tet : tets)
+            {
+              grid->InsertNextCell(VTK_TETRA, 4, tet);
+            }
+          }
+        }
+      }
+    }
+  }
+  const vtkIdType pyramid[5] = { PointId(0, 0, Dim), PointId(1, 0, Dim), PointId(1, 1, Dim),
+    PointId(0, 1, Dim), apex };
+  grid->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfValues(grid->GetNumberOfCells());
+  ghosts->FillValue(0);
+  if (hideCell)
+  {
+    ghosts->SetValue(hiddenCellId, vtkDataSetAttributes::HIDDENCELL);
+  }
+  grid->GetCellData()->AddArray(ghosts);
+  return grid;
+}
+
+// Build a quadratic tetrahedron and a linear tetrahedron sharing a face.
+vtkSmartPointer<vtkUnstructuredGrid> CreateMixedOrderGrid()
+{
+  vtkNew<vtkPoints> points;
+  const double coords[11][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+    { 0.5, 0, 0 }, { 0.5, 0.5, 0 }, { 0, 0.5, 0 }, { 0, 0, 0.5 }, { 0.5, 0, 0.5 },
+    { 0, 0.5, 0.5 }, { -1, 0, 0 } };
+  for (const auto& coord : coords)
+  {
+    points->InsertNextPoint(coord);
+  }
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->AllocateEstimate(2, 10);
+  const vtkIdType quadraticTet[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  grid->InsertNextCell(VTK_QUADRATIC_TETRA, 10, quadraticTet);
+  const vtkIdType tet[4] = { 0, 3, 2, 10 };
+  grid->InsertNextCell(VTK_TETRA, 4, tet);
+  return grid;
+}
+
+// Collect the faces of the output as (sorted input point ids, input cell id).
+std::vector<std::pair<std::vector<vtkIdType>, vtkIdType>> GetFaces(
+  vtkPolyData* output, vtkIdTypeArray* pointIds, vtkIdTypeArray* cellIds)
+{
+  std::vector<std::pair<std::vector<vtkIdType>, vtkIdType>> faces;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = output->GetPolys();
+  vtkIdType cellId = output->GetNumberOfVerts() + output->GetNumberOfLines();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); ++cellId)
+  {
+    std::vector<vtkIdType> face(pts, pts + npts);
+    if (pointIds)
+    {
+      for (auto& ptId : face)
+      {
+        ptId = pointIds->GetValue(ptId);
+      }
+    }
+    std::sort(face.begin(), face.end());
+    faces.emplace_back(face, cellIds->GetValue(cellId));
+  }
+  std::sort(faces.begin(), faces.end());
+  return faces;
+}
+
+vtkSmartPointer<vtkPolyData> ExtractSurface(vtkUnstructuredGridBase* grid, int numberOfThreads)
+{
+  vtkSMPTools::Initialize(numberOfThreads);
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(grid);
+  surface->PassThroughCellIdsOn();
+  surface->PassThroughPointIdsOn();
+  surface->Update();
+  return surface->GetOutput();
+}
+
+bool CompareArrays(vtkDataArray* array1, vtkDataArray* array2)
+{
+  if (!array1 || !array2 || array1->GetNumberOfValues() != array2->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < array1->GetNumberOfValues(); ++i)
+  {
+    if (array1->GetVariantValue(i) != array2->GetVariantValue(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The outputs must be identical, including the order of the points and polygons.
+bool CompareOutputs(vtkPolyData* output1, vtkPolyData* output2, const char* name)
+{
+  if (output1->GetNumberOfPoints() != output2->GetNumberOfPoints() ||
+    output1->GetNumberOfCells() != output2->GetNumberOfCells() ||
+    !CompareArrays(output1->GetPoints()->GetData(), output2->GetPoints()->GetData()))
+  {
+    std::cerr << name << ": the points differ." << std::endl;
+    return false;
+  }
+  vtkIdType npts1, npts2;
+  const vtkIdType *pts1, *pts2;
+  vtkCellArray* polys1 = output1->GetPolys();
+  vtkCellArray* polys2 = output2->GetPolys();
+  for (polys1->InitTraversal(), polys2->InitTraversal();
+       polys1->GetNextCell(npts1, pts1) && polys2->GetNextCell(npts2, pts2);)
+  {
+    if (npts1 != npts2 || !std::equal(pts1, pts1 + npts1, pts2))
+    {
+      std::cerr << name << ": the polygons differ." << std::endl;
+      return false;
+    }
+  }
+  if (!CompareArrays(output1->GetPointData()->GetArray("vtkOriginalPointIds"),
+        output2->GetPointData()->GetArray("vtkOriginalPointIds")) ||
+    !CompareArrays(output1->GetCellData()->GetArray("vtkOriginalCellIds"),
+      output2->GetCellData()->GetArray("vtkOriginalCellIds")))
+  {
+    std::cerr << name << ": the original ids differ." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDataSetSurfaceFilterFaceHashLinks(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = CreateGrid(true);
+
+  vtkSmartPointer<vtkPolyData> serial = ExtractSurface(grid, 1);
+  vtkSmartPointer<vtkPolyData> threaded = ExtractSurface(grid, 0);
+
+  // The output must not depend on the number of threads.
+  if (!CompareOutputs(serial, threaded, "Serial and threaded outputs"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The serial quad hash, used for other vtkUnstructuredGridBase subclasses, must
+  // produce the same output in the same order.
+  vtkUnstructuredGridBase* mapped;
+  vtkMappedUnstructuredGridGenerator::GenerateMappedUnstructuredGrid(&mapped, grid);
+  vtkSmartPointer<vtkPolyData> quadHash = ExtractSurface(mapped, 1);
+  mapped->Delete();
+  if (!CompareOutputs(quadHash, threaded, "Quad hash and threaded outputs"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Compare with the boundary faces extracted by vtkGeometryFilter. The neighbors of
+  // a hidden cell do not have the same faces there, so no cell is hidden here.
+  grid = CreateGrid(false);
+  threaded = ExtractSurface(grid, 0);
+  vtkNew<vtkGeometryFilter> geometry;
+  geometry->SetInputData(grid);
+  geometry->MergingOff();
+  geometry->PassThroughCellIdsOn();
+  geometry->Update();
+  vtkPolyData* expected = geometry->GetOutput();
+
+  const auto faces = GetFaces(threaded,
+    vtkIdTypeArray::SafeDownCast(threaded->GetPointData()->GetArray("vtkOriginalPointIds")),
+    vtkIdTypeArray::SafeDownCast(threaded->GetCellData()->GetArray("vtkOriginalCellIds")));
+  const auto expectedFaces = GetFaces(expected, nullptr,
+    vtkIdTypeArray::SafeDownCast(expected->GetCellData()->GetArray("vtkOriginalCellIds")));
+  if (faces.empty() || faces != expectedFaces)
+  {
+    std::cerr << "Expected " << expectedFaces.size() << " boundary faces, got " << faces.size()
+              << "." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Nonlinear cells do not go through the face hash links. With
+  // MatchBoundariesIgnoringCellOrder, the face shared by the quadratic and the linear
+  // tetrahedra must be hidden: only the 6 outer triangles remain.
+  grid = CreateMixedOrderGrid();
+  vtkNew<vtkDataSetSurfaceFilter> mixed;
+  mixed->SetInputData(grid);
+  mixed->SetNonlinearSubdivisionLevel(0);
+  mixed->SetMatchBoundariesIgnoringCellOrder(1);
+  mixed->Update();
+  if (mixed->GetOutput()->GetNumberOfPolys() != 6)
+  {
+    std::cerr << "Expected 6 triangles for the mixed order grid, got "
+              << mixed->GetOutput()->GetNumberOfPolys() << "." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -3,6 +3,7 @@
 
 #include "vtkDataSetSurfaceFilter.h"
 
+#include "vtkBatch.h"
 #include "vtkBezierCurve.h"
 #include "vtkBezierQuadrilateral.h"
 #include "vtkBezierTriangle.h"
@@ -28,7 +29,11 @@
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticFaceHashLinksTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
 #include "vtkStructuredGrid.h"
@@ -48,6 +53,7 @@
 #include <cassert>
 #include <numeric>
 #include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -278,6 +284,429 @@ bool StructuredExecuteWithBlanking(
   return true;
 }
 
+//------------------------------------------------------------------------------
+// Faces of the fixed-topology linear 3D cells, listed in the order in which
+// vtkStaticFaceHashLinksTemplate enumerates them. Rank is the position at which
+// the serial quad hash inserts the face, and Pts is the loop of cell-local
+// point ids it inserts. Together they let the threaded face extraction below
+// reproduce the output of the quad hash exactly.
+struct SurfaceFace
+{
+  int Rank;
+  int NumberOfPoints;
+  int Pts[6];
+};
+
+constexpr SurfaceFace TetraFaces[4] = { { 0, 3, { 0, 1, 3 } }, { 3, 3, { 1, 2, 3 } },
+  { 2, 3, { 0, 3, 2 } }, { 1, 3, { 0, 2, 1 } } };
+constexpr SurfaceFace VoxelFaces[6] = { { 2, 4, { 0, 4, 6, 2 } }, { 3, 4, { 1, 3, 7, 5 } },
+  { 0, 4, { 0, 1, 5, 4 } }, { 4, 4, { 2, 6, 7, 3 } }, { 1, 4, { 0, 2, 3, 1 } },
+  { 5, 4, { 4, 5, 7, 6 } } };
+constexpr SurfaceFace HexahedronFaces[6] = { { 2, 4, { 0, 4, 7, 3 } }, { 3, 4, { 1, 2, 6, 5 } },
+  { 0, 4, { 0, 1, 5, 4 } }, { 4, 4, { 2, 3, 7, 6 } }, { 1, 4, { 0, 3, 2, 1 } },
+  { 5, 4, { 4, 5, 6, 7 } } };
+constexpr SurfaceFace WedgeFaces[5] = { { 3, 3, { 0, 1, 2 } }, { 4, 3, { 3, 5, 4 } },
+  { 1, 4, { 1, 0, 3, 4 } }, { 2, 4, { 2, 1, 4, 5 } }, { 0, 4, { 0, 2, 5, 3 } } };
+constexpr SurfaceFace PyramidFaces[5] = { { 0, 4, { 3, 2, 1, 0 } }, { 1, 3, { 0, 1, 4 } },
+  { 2, 3, { 1, 2, 4 } }, { 3, 3, { 2, 3, 4 } }, { 4, 3, { 3, 0, 4 } } };
+constexpr SurfaceFace PentagonalPrismFaces[7] = { { 5, 5, { 0, 1, 2, 3, 4 } },
+  { 6, 5, { 5, 6, 7, 8, 9 } }, { 0, 4, { 0, 1, 6, 5 } }, { 1, 4, { 1, 2, 7, 6 } },
+  { 2, 4, { 2, 3, 8, 7 } }, { 3, 4, { 3, 4, 9, 8 } }, { 4, 4, { 4, 0, 5, 9 } } };
+constexpr SurfaceFace HexagonalPrismFaces[8] = { { 6, 6, { 0, 1, 2, 3, 4, 5 } },
+  { 7, 6, { 6, 7, 8, 9, 10, 11 } }, { 0, 4, { 0, 1, 7, 6 } }, { 1, 4, { 1, 2, 8, 7 } },
+  { 2, 4, { 2, 3, 9, 8 } }, { 3, 4, { 3, 4, 10, 9 } }, { 4, 4, { 4, 5, 11, 10 } },
+  { 5, 4, { 5, 0, 6, 11 } } };
+
+//------------------------------------------------------------------------------
+// The external faces of the linear 3D cells of an unstructured grid. Faces are
+// stored in the order the quad hash would have traversed them.
+struct ExternalFaces
+{
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Connectivity;
+  std::vector<vtkIdType> SourceIds;
+
+  vtkIdType GetNumberOfFaces() const
+  {
+    return this->Offsets.empty() ? 0 : static_cast<vtkIdType>(this->Offsets.size()) - 1;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Threaded extraction of the faces used by exactly one linear 3D cell. The faces
+// are grouped by vtkStaticFaceHashLinksTemplate using their minimum point id,
+// which is also the bin used by the quad hash of vtkDataSetSurfaceFilter. Each
+// hash is processed independently: its faces are sorted by (cell id, insertion
+// rank) and the faces that are not matched by another face are kept. A count
+// pass followed by a fill pass over batches of hashes makes the output
+// independent of the number of threads.
+template <typename TInputIdType, typename TFaceIdType>
+struct ExtractExternalFaces
+{
+  using TFaceHashLinks = vtkStaticFaceHashLinksTemplate<TInputIdType, TFaceIdType>;
+
+  struct FacesBatchData
+  {
+    // Accumulators during the count pass, converted to offsets afterwards.
+    vtkIdType FacesOffset;
+    vtkIdType ConnectivityOffset;
+
+    FacesBatchData()
+      : FacesOffset(0)
+      , ConnectivityOffset(0)
+    {
+    }
+    FacesBatchData& operator+=(const FacesBatchData& other)
+    {
+      this->FacesOffset += other.FacesOffset;
+      this->ConnectivityOffset += other.ConnectivityOffset;
+      return *this;
+    }
+    FacesBatchData operator+(const FacesBatchData& other) const
+    {
+      FacesBatchData result = *this;
+      result += other;
+      return result;
+    }
+  };
+
+  // A face of the hash currently processed by a thread.
+  struct HashFace
+  {
+    vtkIdType CellId;
+    int Rank;
+    int NumberOfPoints;
+    vtkIdType PtsOffset;
+    bool Visible;
+  };
+
+  struct LocalData
+  {
+    std::vector<HashFace> Faces;
+    std::vector<vtkIdType> Pts;
+  };
+
+  vtkUnstructuredGrid* Input;
+  const TFaceHashLinks& FaceHashLinks;
+  vtkUnsignedCharArray* CellGhosts;
+  vtkDataSetSurfaceFilter* Self;
+  vtkBatches<FacesBatchData> Batches;
+  ExternalFaces* Output;
+  vtkSMPThreadLocal<LocalData> TLData;
+  vtkSMPThreadLocalObject<vtkIdList> TLCellPointIds;
+  vtkSMPThreadLocalObject<vtkGenericCell> TLCell;
+
+  ExtractExternalFaces(vtkUnstructuredGrid* input, const TFaceHashLinks& faceHashLinks,
+    vtkUnsignedCharArray* cellGhosts, vtkDataSetSurfaceFilter* self, ExternalFaces* output)
+    : Input(input)
+    , FaceHashLinks(faceHashLinks)
+    , CellGhosts(cellGhosts)
+    , Self(self)
+    , Output(output)
+  {
+    // The last hash gathers the 0D, 1D and 2D cells which are not processed here.
+    this->Batches.Initialize(faceHashLinks.GetNumberOfHashes() - 1);
+  }
+
+  // Append a face of the cell to the list of faces of the hash. The face is
+  // rotated so that its minimum point id comes first, as done by the quad hash.
+  static void AddFace(LocalData& localData, vtkIdType cellId, int rank, int numPts,
+    const vtkIdType* facePts)
+  {
+    int first = 0;
+    for (int i = 1; i < numPts; ++i)
+    {
+      if (facePts[i] < facePts[first])
+      {
+        first = i;
+      }
+    }
+    HashFace face;
+    face.CellId = cellId;
+    face.Rank = rank;
+    face.NumberOfPoints = numPts;
+    face.PtsOffset = static_cast<vtkIdType>(localData.Pts.size());
+    face.Visible = true;
+    for (int i = 0; i < numPts; ++i)
+    {
+      localData.Pts.push_back(facePts[(first + i) % numPts]);
+    }
+    localData.Faces.push_back(face);
+  }
+
+  static void AddFace(LocalData& localData, vtkIdType cellId, const SurfaceFace& face,
+    const vtkIdType* cellPts)
+  {
+    vtkIdType facePts[6];
+    for (int i = 0; i < face.NumberOfPoints; ++i)
+    {
+      facePts[i] = cellPts[face.Pts[i]];
+    }
+    ExtractExternalFaces::AddFace(localData, cellId, face.Rank, face.NumberOfPoints, facePts);
+  }
+
+  // Gather the faces of a hash and mark the ones shared by several cells.
+  void ProcessHash(vtkIdType hash, LocalData& localData)
+  {
+    localData.Faces.clear();
+    localData.Pts.clear();
+    const vtkIdType numberOfFaces = this->FaceHashLinks.GetNumberOfFacesInHash(hash);
+    if (numberOfFaces == 0)
+    {
+      return;
+    }
+    const TInputIdType* cellIds = this->FaceHashLinks.GetCellIdOfFacesInHash(hash);
+    const TFaceIdType* faceIds = this->FaceHashLinks.GetFaceIdOfFacesInHash(hash);
+    vtkIdList* cellPointIds = this->TLCellPointIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType i = 0; i < numberOfFaces; ++i)
+    {
+      const vtkIdType cellId = static_cast<vtkIdType>(cellIds[i]);
+      const int faceId = static_cast<int>(faceIds[i]);
+      // We skip cells marked as hidden
+      if (this->CellGhosts &&
+        (this->CellGhosts->GetValue(cellId) & vtkDataSetAttributes::CellGhostTypes::HIDDENCELL))
+      {
+        continue;
+      }
+      const int cellType = this->Input->GetCellType(cellId);
+      switch (cellType)
+      {
+        case VTK_TETRA:
+          this->Input->GetCellPoints(cellId, npts, pts, cellPointIds);
+          ExtractExternalFaces::AddFace(localData, cellId, TetraFaces[faceId], pts);
+          break;
+        case VTK_VOXEL:
+          this->Input->GetCellPoints(cellId, npts, pts, cellPointIds);
+          ExtractExternalFaces::AddFace(localData, cellId, VoxelFaces[faceId], pts);
+          break;
+        case VTK_HEXAHEDRON:
+          this->Input->GetCellPoints(cellId, npts, pts, cellPointIds);
+          ExtractExternalFaces::AddFace(localData, cellId, HexahedronFaces[faceId], pts);
+          break;
+        case VTK_WEDGE:
+          this->Input->GetCellPoints(cellId, npts, pts, cellPointIds);
+          ExtractExternalFaces::AddFace(localData, cellId, WedgeFaces[faceId], pts);
+          break;
+        case VTK_PYRAMID:
+          this->Input->GetCellPoints(cellId, npts, pts, cellPointIds);
+          ExtractExternalFaces::AddFace(localData, cellId, PyramidFaces[faceId], pts);
+          break;
+        case VTK_PENTAGONAL_PRISM:
+          this->Input->GetCellPoints(cellId, npts, pts, cellPointIds);
+          ExtractExternalFaces::AddFace(localData, cellId, PentagonalPrismFaces[faceId], pts);
+          break;
+        case VTK_HEXAGONAL_PRISM:
+          this->Input->GetCellPoints(cellId, npts, pts, cellPointIds);
+          ExtractExternalFaces::AddFace(localData, cellId, HexagonalPrismFaces[faceId], pts);
+          break;
+        default:
+        {
+          // Other linear 3D cells (e.g., polyhedra) provide their faces directly.
+          vtkGenericCell* cell = this->TLCell.Local();
+          this->Input->GetCell(cellId, cell);
+          vtkCell* face = cell->GetFace(faceId);
+          ExtractExternalFaces::AddFace(localData, cellId, faceId,
+            static_cast<int>(face->PointIds->GetNumberOfIds()), face->PointIds->GetPointer(0));
+        }
+      }
+    }
+
+    // Restore the order in which the faces would have been inserted in the quad hash.
+    std::sort(localData.Faces.begin(), localData.Faces.end(),
+      [](const HashFace& a, const HashFace& b) {
+        return a.CellId < b.CellId || (a.CellId == b.CellId && a.Rank < b.Rank);
+      });
+
+    // Hide any face shared by two or more cells. Faces of a hash share their first
+    // point, so they match if the remaining points are the same in either direction.
+    const vtkIdType* hashPts = localData.Pts.data();
+    const size_t numberOfHashFaces = localData.Faces.size();
+    for (size_t i = 0; i < numberOfHashFaces; ++i)
+    {
+      HashFace& faceA = localData.Faces[i];
+      const vtkIdType* ptsA = hashPts + faceA.PtsOffset;
+      for (size_t j = i + 1; j < numberOfHashFaces; ++j)
+      {
+        HashFace& faceB = localData.Faces[j];
+        if (faceA.NumberOfPoints != faceB.NumberOfPoints)
+        {
+          continue;
+        }
+        const int n = faceA.NumberOfPoints;
+        const vtkIdType* ptsB = hashPts + faceB.PtsOffset;
+        bool forward = true;
+        bool backward = true;
+        for (int k = 1; k < n && (forward || backward); ++k)
+        {
+          forward = forward && ptsA[k] == ptsB[k];
+          backward = backward && ptsA[k] == ptsB[n - k];
+        }
+        if (forward || backward)
+        {
+          faceA.Visible = false;
+          faceB.Visible = false;
+        }
+      }
+    }
+  }
+
+  bool CheckAbort(vtkIdType batchId, vtkIdType beginBatchId, vtkIdType endBatchId, bool isFirst)
+  {
+    const auto checkAbortInterval =
+      std::min((endBatchId - beginBatchId) / 10 + 1, static_cast<vtkIdType>(1000));
+    if (batchId % checkAbortInterval == 0)
+    {
+      if (isFirst)
+      {
+        this->Self->CheckAbort();
+      }
+      if (this->Self->GetAbortOutput())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Count the number of external faces and their connectivity size per batch.
+  void Count(vtkIdType beginBatchId, vtkIdType endBatchId)
+  {
+    auto& localData = this->TLData.Local();
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatchId; batchId < endBatchId; ++batchId)
+    {
+      if (this->CheckAbort(batchId, beginBatchId, endBatchId, isFirst))
+      {
+        break;
+      }
+      auto& batch = this->Batches[batchId];
+      auto& batchData = batch.Data;
+      for (vtkIdType hash = batch.BeginId; hash < batch.EndId; ++hash)
+      {
+        this->ProcessHash(hash, localData);
+        for (const auto& face : localData.Faces)
+        {
+          if (face.Visible)
+          {
+            batchData.FacesOffset++;
+            batchData.ConnectivityOffset += face.NumberOfPoints;
+          }
+        }
+      }
+    }
+  }
+
+  // Write the external faces of each batch at the offsets computed by Count().
+  void Fill(vtkIdType beginBatchId, vtkIdType endBatchId)
+  {
+    auto& localData = this->TLData.Local();
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType* offsets = this->Output->Offsets.data();
+    vtkIdType* connectivity = this->Output->Connectivity.data();
+    vtkIdType* sourceIds = this->Output->SourceIds.data();
+    for (vtkIdType batchId = beginBatchId; batchId < endBatchId; ++batchId)
+    {
+      if (this->CheckAbort(batchId, beginBatchId, endBatchId, isFirst))
+      {
+        break;
+      }
+      auto& batch = this->Batches[batchId];
+      vtkIdType faceOffset = batch.Data.FacesOffset;
+      vtkIdType connectivityOffset = batch.Data.ConnectivityOffset;
+      for (vtkIdType hash = batch.BeginId; hash < batch.EndId; ++hash)
+      {
+        this->ProcessHash(hash, localData);
+        for (const auto& face : localData.Faces)
+        {
+          if (face.Visible)
+          {
+            offsets[faceOffset] = connectivityOffset;
+            sourceIds[faceOffset++] = face.CellId;
+            std::copy_n(localData.Pts.data() + face.PtsOffset, face.NumberOfPoints,
+              connectivity + connectivityOffset);
+            connectivityOffset += face.NumberOfPoints;
+          }
+        }
+      }
+    }
+  }
+
+  void Execute()
+  {
+    const vtkIdType numberOfBatches = this->Batches.GetNumberOfBatches();
+    vtkSMPTools::For(0, numberOfBatches,
+      [&](vtkIdType beginBatchId, vtkIdType endBatchId) { this->Count(beginBatchId, endBatchId); });
+    if (this->Self->GetAbortOutput())
+    {
+      return;
+    }
+    const auto globalSum = this->Batches.BuildOffsetsAndGetGlobalSum();
+    this->Output->Offsets.resize(static_cast<size_t>(globalSum.FacesOffset + 1));
+    this->Output->Connectivity.resize(static_cast<size_t>(globalSum.ConnectivityOffset));
+    this->Output->SourceIds.resize(static_cast<size_t>(globalSum.FacesOffset));
+    this->Output->Offsets[globalSum.FacesOffset] = globalSum.ConnectivityOffset;
+    vtkSMPTools::For(0, numberOfBatches,
+      [&](vtkIdType beginBatchId, vtkIdType endBatchId) { this->Fill(beginBatchId, endBatchId); });
+  }
+};
+
+//------------------------------------------------------------------------------
+template <typename TInputIdType, typename TFaceIdType>
+void ExecuteExtractExternalFaces(vtkUnstructuredGrid* input, vtkUnsignedCharArray* cellGhosts,
+  vtkDataSetSurfaceFilter* self, ExternalFaces* output)
+{
+  vtkStaticFaceHashLinksTemplate<TInputIdType, TFaceIdType> faceHashLinks;
+  faceHashLinks.BuildHashLinks(input);
+  ExtractExternalFaces<TInputIdType, TFaceIdType> extract(
+    input, faceHashLinks, cellGhosts, self, output);
+  extract.Execute();
+}
+
+//------------------------------------------------------------------------------
+// Dispatch the external face extraction on the smallest id types able to
+// represent the input, as done by vtkGeometryFilter.
+void ExtractUnstructuredGridExternalFaces(vtkUnstructuredGrid* input,
+  vtkUnsignedCharArray* cellGhosts, vtkDataSetSurfaceFilter* self, ExternalFaces* output)
+{
+  if (input->GetNumberOfPoints() == 0)
+  {
+    return;
+  }
+#ifdef VTK_USE_64BIT_IDS
+  bool use64BitsIds = (input->GetNumberOfPoints() > VTK_TYPE_INT32_MAX ||
+    input->GetNumberOfCells() > VTK_TYPE_INT32_MAX);
+  if (use64BitsIds)
+  {
+    using TInputIdType = vtkTypeInt64;
+    if (!input->GetFaces())
+    {
+      using TFaceIdType = vtkTypeInt8;
+      ExecuteExtractExternalFaces<TInputIdType, TFaceIdType>(input, cellGhosts, self, output);
+    }
+    else
+    {
+      using TFaceIdType = vtkTypeInt32;
+      ExecuteExtractExternalFaces<TInputIdType, TFaceIdType>(input, cellGhosts, self, output);
+    }
+  }
+  else
+#endif
+  {
+    using TInputIdType = vtkTypeInt32;
+    if (!input->GetFaces())
+    {
+      using TFaceIdType = vtkTypeInt8;
+      ExecuteExtractExternalFaces<TInputIdType, TFaceIdType>(input, cellGhosts, self, output);
+    }
+    else
+    {
+      using TFaceIdType = vtkTypeInt32;
+      ExecuteExtractExternalFaces<TInputIdType, TFaceIdType>(input, cellGhosts, self, output);
+    }
+  }
+}
 }
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -1426,6 +1855,25 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
     }
   }
 
+  // Boundary faces of the 3D cells of a vtkUnstructuredGrid are extracted in a
+  // threaded pass using vtkStaticFaceHashLinksTemplate rather than the quad hash.
+  // The face hash links only match the faces of linear cells, so they are not used
+  // when nonlinear 3D cells remain: the quad hash then hides the faces they share
+  // with linear cells. vtkUnstructuredGrid inputs with nonlinear cells are currently
+  // converted to 2D cells by vtkUnstructuredGridGeometryFilter above, at any
+  // NonlinearSubdivisionLevel, and the faces are matched ignoring the cell order
+  // there if MatchBoundariesIgnoringCellOrder is on.
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  bool useFaceHashLinks = grid != nullptr;
+  if (auto cellTypes = grid ? grid->GetDistinctCellTypesArray() : nullptr)
+  {
+    for (vtkIdType i = 0; i < cellTypes->GetNumberOfValues() && useFaceHashLinks; ++i)
+    {
+      const unsigned char type = cellTypes->GetValue(i);
+      useFaceHashLinks = vtkCellTypes::GetDimension(type) != 3 || vtkCellTypes::IsLinear(type);
+    }
+  }
+
   vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
   vtkUnsignedCharArray* ghostCells = input->GetCellGhostArray();
   vtkCellArray* newVerts;
@@ -1458,6 +1906,7 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   vtkIdList* pts;
   vtkCell* face;
   int flag2D = 0;
+  int flag3D = 0;
 
   // These are for subdividing quadratic cells
   std::vector<double> parametricCoords;
@@ -1472,7 +1921,18 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   std::vector<double> weights;
 
   this->NumberOfNewCells = 0;
-  this->InitializeQuadHash(numPts);
+  if (useFaceHashLinks)
+  {
+    // Only the point map and the edge map are needed.
+    this->DeleteQuadHash();
+    this->PointMap = new vtkIdType[numPts];
+    std::fill_n(this->PointMap, numPts, -1);
+    this->EdgeMap = new vtkEdgeInterpolationMap;
+  }
+  else
+  {
+    this->InitializeQuadHash(numPts);
+  }
 
   // Allocate
   //
@@ -1558,6 +2018,13 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
 
     cellType = input->GetCellType(cellId);
 
+    if (useFaceHashLinks && vtkCellTypes::GetDimension(static_cast<unsigned char>(cellType)) == 3)
+    {
+      // save 3D cells for the threaded face extraction
+      flag3D = 1;
+      continue;
+    }
+
     switch (cellType)
     {
       case VTK_VERTEX:
@@ -2195,37 +2662,84 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
 
   } // for all cells.
 
-  // Now transfer geometry from hash to output (only triangles and quads).
-  this->InitQuadHashTraversal();
-  while ((q = this->GetNextVisibleQuadFromHash()))
+  if (useFaceHashLinks)
   {
-    // If one of the points is hidden (meaning invalid), do not
-    // extract surface cell.
-    // Removed checking for whether all points are ghost, because that's an
-    // incorrect assumption.
-    bool oneHidden = false;
-    // handle all polys
-    for (i = 0; i < q->numPts; i++)
+    // Extract the faces used by a single 3D cell and transfer them to the output
+    // in the order the quad hash would have produced.
+    ExternalFaces externalFaces;
+    if (flag3D && !abort)
     {
-      if (ghosts)
+      ExtractUnstructuredGridExternalFaces(grid, ghostCells, this, &externalFaces);
+    }
+    std::vector<vtkIdType> facePtIds;
+    const vtkIdType numExternalFaces = externalFaces.GetNumberOfFaces();
+    for (vtkIdType faceId = 0; faceId < numExternalFaces && !this->GetAbortOutput(); ++faceId)
+    {
+      const vtkIdType* facePts =
+        externalFaces.Connectivity.data() + externalFaces.Offsets[faceId];
+      numFacePts = externalFaces.Offsets[faceId + 1] - externalFaces.Offsets[faceId];
+      facePtIds.resize(static_cast<size_t>(numFacePts));
+
+      // If one of the points is hidden (meaning invalid), do not
+      // extract surface cell.
+      bool oneHidden = false;
+      for (i = 0; i < numFacePts; i++)
       {
-        unsigned char val = ghosts->GetValue(q->ptArray[i]);
-        if (val & vtkDataSetAttributes::HIDDENPOINT)
+        if (ghosts)
         {
-          oneHidden = true;
+          unsigned char val = ghosts->GetValue(facePts[i]);
+          if (val & vtkDataSetAttributes::HIDDENPOINT)
+          {
+            oneHidden = true;
+          }
         }
+        facePtIds[i] = this->GetOutputPointId(facePts[i], input, newPts, outputPD);
       }
 
-      q->ptArray[i] = this->GetOutputPointId(q->ptArray[i], input, newPts, outputPD);
+      if (oneHidden)
+      {
+        continue;
+      }
+      const vtkIdType sourceId = externalFaces.SourceIds[faceId];
+      newPolys->InsertNextCell(numFacePts, facePtIds.data());
+      this->RecordOrigCellId(this->NumberOfNewCells, sourceId);
+      outputCD->CopyData(inputCD, sourceId, this->NumberOfNewCells++);
     }
-
-    if (oneHidden)
+  }
+  else
+  {
+    // Now transfer geometry from hash to output (only triangles and quads).
+    this->InitQuadHashTraversal();
+    while ((q = this->GetNextVisibleQuadFromHash()))
     {
-      continue;
+      // If one of the points is hidden (meaning invalid), do not
+      // extract surface cell.
+      // Removed checking for whether all points are ghost, because that's an
+      // incorrect assumption.
+      bool oneHidden = false;
+      // handle all polys
+      for (i = 0; i < q->numPts; i++)
+      {
+        if (ghosts)
+        {
+          unsigned char val = ghosts->GetValue(q->ptArray[i]);
+          if (val & vtkDataSetAttributes::HIDDENPOINT)
+          {
+            oneHidden = true;
+          }
+        }
+
+        q->ptArray[i] = this->GetOutputPointId(q->ptArray[i], input, newPts, outputPD);
+      }
+
+      if (oneHidden)
+      {
+        continue;
+      }
+      newPolys->InsertNextCell(q->numPts, q->ptArray);
+      this->RecordOrigCellId(this->NumberOfNewCells, q);
+      outputCD->CopyData(inputCD, q->SourceId, this->NumberOfNewCells++);
     }
-    newPolys->InsertNextCell(q->numPts, q->ptArray);
-    this->RecordOrigCellId(this->NumberOfNewCells, q);
-    outputCD->CopyData(inputCD, q->SourceId, this->NumberOfNewCells++);
   }
 
   if (this->PassThroughCellIds)
@@ -57,12 +57,18 @@
  * @warning
  * A key step in this algorithm (for 3D cells) is to count the number times a
  * face is used by a cell. If used only once, then the face is considered a
- * boundary face and sent to the filter output. The filter determines this by
- * creating a hash table of faces: faces that are placed into the hash table
- * a single time are used only once, and therefore sent to the output. Thus
- * large amounts of extra memory is necessary to build the hash table. This
- * obsoleted approach requires a significant amount of memory, and is a
- * significant bottleneck to threading.
+ * boundary face and sent to the filter output. For vtkUnstructuredGrid inputs,
+ * the faces are grouped with vtkStaticFaceHashLinksTemplate and the boundary
+ * faces are extracted in parallel; the output is identical to the one produced
+ * by the serial face hash, which requires significantly more memory and is
+ * still used for other vtkUnstructuredGridBase subclasses. When nonlinear cells
+ * are subdivided, the faces produced by vtkUnstructuredGridGeometryFilter are
+ * processed without allocating any face hash.
+ *
+ * @warning
+ * This class has been partially threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE)
+ * may improve performance significantly.
  *
  * @warning
  * This filter may create duplicate points. Unlike vtkGeometryFilter, it does
@@ -70,7 +76,7 @@
  * not used by any output polygonal primitive (i.e., not on the boundary).
  *
  * @sa
- * vtkGeometryFilter vtkStructuredGridGeometryFilter
+ * vtkGeometryFilter vtkStructuredGridGeometryFilter vtkStaticFaceHashLinksTemplate
  */
 
 #ifndef vtkDataSetSurfaceFilter_h
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkImageWriter and vtkPNMWriter write the same files when they
+// stream their input one slab at a time, and that the pipeline only ever
+// generates one slab at a time.  Also checks that the writers that cannot
+// stream warn about it.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkImageData.h"
+#include "vtkImageMandelbrotSource.h"
+#include "vtkImageShiftScale.h"
+#include "vtkImageWriter.h"
+#include "vtkNew.h"
+#include "vtkPNGWriter.h"
+#include "vtkPNMWriter.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include "vtksys/FStream.hxx"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+// The number of executions of the source, and the largest one.
+struct ExecutionCount
+{
+  int Executions = 0;
+  vtkIdType MaximumNumberOfPoints = 0;
+};
+
+void CountExecution(vtkObject* caller, unsigned long, void* clientData, void*)
+{
+  ExecutionCount* count = static_cast<ExecutionCount*>(clientData);
+  vtkIdType n = vtkImageMandelbrotSource::SafeDownCast(caller)->GetOutput()->GetNumberOfPoints();
+  count->Executions++;
+  count->MaximumNumberOfPoints = std::max(count->MaximumNumberOfPoints, n);
+}
+
+std::string ReadFile(const std::string& fileName)
+{
+  vtksys::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Write the image with and without streaming, and compare the files.
+bool TestWriter(vtkImageWriter* writer, vtkImageMandelbrotSource* source,
+  const std::string& prefix, int divisions, int numberOfFiles)
+{
+  ExecutionCount count;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(CountExecution);
+  callback->SetClientData(&count);
+  source->AddObserver(vtkCommand::EndEvent, callback);
+
+  const char* suffixes[2] = { "whole", "streamed" };
+  for (int streamed = 0; streamed < 2; streamed++)
+  {
+    count = ExecutionCount();
+    source->Modified();
+    writer->SetNumberOfStreamDivisions(streamed ? divisions : 1);
+    writer->SetFilePrefix((prefix + suffixes[streamed]).c_str());
+    writer->Write();
+    if (writer->GetErrorCode() != 0)
+    {
+      std::cerr << "The writer failed with error " << writer->GetErrorCode() << std::endl;
+      return false;
+    }
+  }
+  source->RemoveObserver(callback);
+
+  // the last write generated the image one slab at a time
+  const int* extent = source->GetWholeExtent();
+  vtkIdType slab = static_cast<vtkIdType>(extent[1] - extent[0] + 1) *
+    (extent[3] - extent[2] + 1) * ((extent[5] - extent[4]) / divisions + 1);
+  if (count.Executions != divisions || count.MaximumNumberOfPoints > slab)
+  {
+    std::cerr << "The source executed " << count.Executions << " times with up to "
+              << count.MaximumNumberOfPoints << " points" << std::endl;
+    return false;
+  }
+
+  for (int i = 0; i < numberOfFiles; i++)
+  {
+    std::string suffix = "." + std::to_string(extent[4] + i);
+    std::string whole = ReadFile(prefix + suffixes[0] + suffix);
+    std::string streamed = ReadFile(prefix + suffixes[1] + suffix);
+    if (whole.empty() || whole != streamed)
+    {
+      std::cerr << "The streamed file " << prefix << suffixes[1] << suffix << " differs"
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestImageWriterStreaming(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string prefix = std::string(tempDir) + "/TestImageWriterStreaming_";
+  delete[] tempDir;
+
+  vtkNew<vtkImageMandelbrotSource> source;
+  source->SetWholeExtent(0, 63, -5, 42, 3, 25);
+  source->SetMaximumNumberOfIterations(50);
+
+  vtkNew<vtkImageShiftScale> cast;
+  cast->SetInputConnection(source->GetOutputPort());
+  cast->SetScale(5.0);
+  cast->ClampOverflowOn();
+
+  // a single raw file of shorts, written in slabs that do not divide the slices evenly
+  bool success = true;
+  vtkNew<vtkImageWriter> writer;
+  cast->SetOutputScalarTypeToUnsignedShort();
+  writer->SetInputConnection(cast->GetOutputPort());
+  writer->SetFileDimensionality(3);
+  success &= TestWriter(writer, source, prefix + "raw_", 5, 1);
+
+  // one PNM file per slice
+  vtkNew<vtkPNMWriter> pnmWriter;
+  cast->SetOutputScalarTypeToUnsignedChar();
+  pnmWriter->SetInputConnection(cast->GetOutputPort());
+  success &= TestWriter(pnmWriter, source, prefix + "pnm_", 4, 23);
+
+  // the writers that write the whole image themselves warn that they cannot stream
+  vtkNew<vtkTest::ErrorObserver> warningObserver;
+  vtkNew<vtkPNGWriter> pngWriter;
+  pngWriter->AddObserver(vtkCommand::WarningEvent, warningObserver);
+  pngWriter->SetNumberOfStreamDivisions(4);
+  success &= (warningObserver->CheckWarningMessage("cannot stream") == 0);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -16,9 +16,97 @@
 #include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageWriter);
 
+//------------------------------------------------------------------------------
+// The state of the writer while it streams its input slab by slab.  The
+// slabs are formatted by the writer on the pipeline thread, the background
+// thread only writes the formatted bytes and does not access the writer.
+class vtkImageWriter::vtkInternals
+{
+public:
+  ~vtkInternals()
+  {
+    this->Wait();
+    delete this->File;
+  }
+
+  // Wait until the previous slab has been written.
+  void Wait()
+  {
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+  }
+
+  // Report the errors of the background thread to the writer, this is
+  // called on the pipeline thread after Wait().
+  void ReportErrors(vtkImageWriter* self)
+  {
+    if (!this->UnopenedFileName.empty())
+    {
+      vtkErrorWithObjectMacro(self, "WritePiece: Could not open file " << this->UnopenedFileName);
+      self->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    }
+    else if (this->WriteFailed)
+    {
+      self->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    }
+    this->UnopenedFileName.clear();
+    this->WriteFailed = false;
+  }
+
+  // Write the formatted slab, this is called on the background thread.
+  void Write()
+  {
+    std::ios_base::openmode mode = ios::out;
+#ifdef _WIN32
+    mode |= ios::binary;
+#endif
+    if (this->File)
+    {
+      this->File->write(this->Buffers[0].data(), this->Buffers[0].size());
+      this->File->flush();
+      this->WriteFailed = this->File->fail();
+    }
+    for (size_t i = 0; i < this->FileNames.size() && !this->WriteFailed; ++i)
+    {
+      // one file per slice
+      vtksys::ofstream file(this->FileNames[i].c_str(), mode);
+      if (file.fail())
+      {
+        this->UnopenedFileName = this->FileNames[i];
+        return;
+      }
+      file.write(this->Buffers[i].data(), this->Buffers[i].size());
+      file.flush();
+      this->WriteFailed = file.fail();
+    }
+  }
+
+  std::thread Thread;
+
+  // The bytes of the slab, to append to File if FileDimensionality is 3, or
+  // the contents of the file of each slice of the slab otherwise.
+  std::vector<std::string> Buffers;
+  std::vector<std::string> FileNames;
+
+  // The file that all slabs are appended to, if FileDimensionality is 3.
+  ostream* File = nullptr;
+
+  // The errors of the background thread, reported after Wait().
+  std::string UnopenedFileName;
+  bool WriteFailed = false;
+};
+
 //------------------------------------------------------------------------------
 vtkImageWriter::vtkImageWriter()
 {
@@ -39,6 +127,11 @@ vtkImageWriter::vtkImageWriter()
 
   this->MinimumFileNumber = this->MaximumFileNumber = 0;
   this->FilesDeleted = 0;
+
+  this->NumberOfStreamDivisions = 1;
+  this->CurrentDivision = 0;
+  this->Internals = new vtkInternals;
+
   this->SetNumberOfOutputPorts(0);
 }
 
@@ -52,6 +145,7 @@ vtkImageWriter::~vtkImageWriter()
   this->FilePattern = nullptr;
   delete[] this->FileName;
   this->FileName = nullptr;
+  delete this->Internals;
 }
 
 //------------------------------------------------------------------------------
@@ -65,6 +159,7 @@ void vtkImageWriter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "FileDimensionality: " << this->FileDimensionality << "\n";
   os << indent << "WriteToMemory: " << this->WriteToMemory << "\n";
+  os << indent << "NumberOfStreamDivisions: " << this->NumberOfStreamDivisions << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -77,15 +172,74 @@ vtkImageData* vtkImageWriter::GetInput()
   return vtkImageData::SafeDownCast(this->GetExecutive()->GetInputData(0, 0));
 }
 //------------------------------------------------------------------------------
+void vtkImageWriter::SetNumberOfStreamDivisions(int divisions)
+{
+  divisions = std::max(divisions, 1);
+  if (divisions > 1 && !this->CanStreamInput())
+  {
+    vtkWarningMacro("SetNumberOfStreamDivisions: " << this->GetClassName()
+                                                   << " cannot stream, it writes the whole input.");
+  }
+  if (this->NumberOfStreamDivisions != divisions)
+  {
+    this->NumberOfStreamDivisions = divisions;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkImageWriter::GetNumberOfStreamPieces(const int wExtent[6])
+{
+  if (this->WriteToMemory || !this->CanStreamInput() ||
+    (this->FileDimensionality != 2 && this->FileDimensionality != 3))
+  {
+    return 1;
+  }
+  int slices = wExtent[5] - wExtent[4] + 1;
+  return std::max(std::min(this->NumberOfStreamDivisions, slices), 1);
+}
 
-int vtkImageWriter::RequestData(vtkInformation* vtkNotUsed(request),
+//------------------------------------------------------------------------------
+int vtkImageWriter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
 {
-  this->SetErrorCode(vtkErrorCode::NoError);
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  if (!inInfo || !inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()))
+  {
+    return 1;
+  }
+
+  int wExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wExt);
+  int numberOfPieces = this->GetNumberOfStreamPieces(wExt);
+  if (numberOfPieces > 1)
+  {
+    // request the current slab of slices
+    vtkIdType slices = wExt[5] - wExt[4] + 1;
+    int uExt[6] = { wExt[0], wExt[1], wExt[2], wExt[3], 0, 0 };
+    uExt[4] = wExt[4] + static_cast<int>(this->CurrentDivision * slices / numberOfPieces);
+    uExt[5] = wExt[4] + static_cast<int>((this->CurrentDivision + 1) * slices / numberOfPieces) - 1;
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), uExt, 6);
+  }
+
+  return 1;
+}
 
+//------------------------------------------------------------------------------
+int vtkImageWriter::RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+  vtkInformationVector* vtkNotUsed(outputVector))
+{
   vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
   vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+  // the slabs after the first one continue the streaming
+  if (this->CurrentDivision > 0 && input)
+  {
+    return this->WritePiece(request, input, inInfo);
+  }
+
+  this->SetErrorCode(vtkErrorCode::NoError);
+
   // Error checking
   if (input == nullptr)
   {
@@ -114,6 +268,10 @@ int vtkImageWriter::RequestData(vtkInformation* vtkNotUsed(request),
   // Write
   this->InvokeEvent(vtkCommand::StartEvent);
   this->UpdateProgress(0.0);
+  if (this->GetNumberOfStreamPieces(wExt) > 1)
+  {
+    return this->WritePiece(request, input, inInfo);
+  }
   if (this->WriteToMemory)
   {
     this->MemoryWrite(2, input, wExt, inInfo);
@@ -138,6 +296,165 @@ int vtkImageWriter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Writes one slab while streaming.  The slab is formatted here, and its bytes
+// are written on a background thread, so that the pipeline can generate the
+// next slab in the meantime.
+int vtkImageWriter::WritePiece(vtkInformation* request, vtkImageData* input, vtkInformation* inInfo)
+{
+  vtkInternals* internals = this->Internals;
+  int* wExt = vtkStreamingDemandDrivenPipeline::GetWholeExtent(inInfo);
+  int* uExt = inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+  int numberOfPieces = this->GetNumberOfStreamPieces(wExt);
+
+  // the previous slab must be written before the next one, and its errors
+  // are reported from this thread
+  internals->Wait();
+  internals->ReportErrors(this);
+
+  std::ios_base::openmode mode = ios::out;
+#ifdef _WIN32
+  mode |= ios::binary;
+#endif
+
+  if (this->CurrentDivision == 0)
+  {
+    // Tell the pipeline to start looping.
+    request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+
+    // a three dimensional file is opened once, and each slab is appended
+    if (this->FileDimensionality == 3)
+    {
+      if (this->FileName)
+      {
+        snprintf(this->InternalFileName, this->InternalFileNameSize, "%s", this->FileName);
+      }
+      else if (this->FilePrefix)
+      {
+        snprintf(this->InternalFileName, this->InternalFileNameSize, this->FilePattern,
+          this->FilePrefix, this->FileNumber);
+      }
+      else
+      {
+        snprintf(
+          this->InternalFileName, this->InternalFileNameSize, this->FilePattern, this->FileNumber);
+      }
+
+      internals->File = new vtksys::ofstream(this->InternalFileName, mode);
+      if (internals->File->fail())
+      {
+        vtkErrorMacro("WritePiece: Could not open file " << this->InternalFileName);
+        this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+      }
+      else
+      {
+        this->WriteFileHeader(internals->File, input, wExt);
+        internals->File->flush();
+        if (internals->File->fail())
+        {
+          this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+        }
+      }
+    }
+  }
+
+  // stop at the first error
+  bool failed = (this->ErrorCode != vtkErrorCode::NoError);
+  if (!failed)
+  {
+    // the progress of each slab starts where the previous one ended
+    this->UpdateProgress(static_cast<double>(this->CurrentDivision) / numberOfPieces);
+
+    internals->Buffers.clear();
+    internals->FileNames.clear();
+    if (internals->File)
+    {
+      std::ostringstream buffer;
+      this->WriteFile(&buffer, input, uExt, wExt);
+      internals->Buffers.push_back(buffer.str());
+    }
+    else
+    {
+      // one file per slice, with the names given to them by RecursiveWrite()
+      for (int idxZ = uExt[4]; idxZ <= uExt[5]; ++idxZ)
+      {
+        if (this->FileName)
+        {
+          snprintf(this->InternalFileName, this->InternalFileNameSize, "%s", this->FileName);
+        }
+        else
+        {
+          if (this->FilePrefix)
+          {
+            snprintf(this->InternalFileName, this->InternalFileNameSize, this->FilePattern,
+              this->FilePrefix, this->FileNumber);
+          }
+          else
+          {
+            snprintf(this->InternalFileName, this->InternalFileNameSize, this->FilePattern,
+              this->FileNumber);
+          }
+          this->MinimumFileNumber = std::min(this->MinimumFileNumber, this->FileNumber);
+          this->MaximumFileNumber = std::max(this->MaximumFileNumber, this->FileNumber);
+        }
+        ++this->FileNumber;
+
+        int sliceExt[6] = { uExt[0], uExt[1], uExt[2], uExt[3], idxZ, idxZ };
+        std::ostringstream buffer;
+        this->WriteFileHeader(&buffer, input, wExt);
+        this->WriteFile(&buffer, input, sliceExt, wExt);
+        this->WriteFileTrailer(&buffer, input);
+        internals->FileNames.emplace_back(this->InternalFileName);
+        internals->Buffers.push_back(buffer.str());
+      }
+    }
+    internals->Thread = std::thread(&vtkInternals::Write, internals);
+  }
+
+  this->CurrentDivision++;
+  if (this->CurrentDivision == numberOfPieces || failed)
+  {
+    internals->Wait();
+    internals->ReportErrors(this);
+    internals->Buffers.clear();
+    internals->FileNames.clear();
+
+    if (internals->File)
+    {
+      if (!internals->File->fail())
+      {
+        this->WriteFileTrailer(internals->File, input);
+        internals->File->flush();
+        if (internals->File->fail())
+        {
+          this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+        }
+      }
+      delete internals->File;
+      internals->File = nullptr;
+      ++this->FileNumber;
+    }
+
+    if (this->ErrorCode == vtkErrorCode::OutOfDiskSpaceError)
+    {
+      this->DeleteFiles();
+    }
+
+    this->UpdateProgress(1.0);
+    this->InvokeEvent(vtkCommand::EndEvent);
+
+    delete[] this->InternalFileName;
+    this->InternalFileName = nullptr;
+    this->InternalFileNameSize = 0;
+
+    // Tell the pipeline to stop looping.
+    request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+    this->CurrentDivision = 0;
+  }
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Writes all the data from the input.
 void vtkImageWriter::Write()
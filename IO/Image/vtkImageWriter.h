@@ -9,6 +9,14 @@
  * determines whether the data will be written in one or multiple files.
  * This class is used as the superclass of most image writing classes
  * such as vtkBMPWriter etc. It supports streaming.
+ *
+ * If NumberOfStreamDivisions is greater than one, the input is requested
+ * and written one slab of slices at a time, so that the memory used by the
+ * pipeline is proportional to the size of a slab rather than to the size
+ * of the whole image.  Each slab is formatted by the writer, then its bytes
+ * are written to disk on a separate thread while the pipeline generates the
+ * next one.  Only the raw format of this class, vtkPNMWriter, vtkBMPWriter
+ * and vtkPostScriptWriter stream, see CanStreamInput().
  */
 
 #ifndef vtkImageWriter_h
@@ -68,6 +76,22 @@ public:
    */
   vtkImageData* GetInput();
 
+  ///@{
+  /**
+   * Set/Get the number of slabs of slices that the input is divided into.
+   * When this is greater than one, the writer updates its input one slab at
+   * a time and appends each slab to the file(s) as soon as it has been
+   * generated, so the whole image is never held in memory.  Only the raw
+   * format of this class, vtkPNMWriter, vtkBMPWriter and vtkPostScriptWriter
+   * support streaming, and only with a FileDimensionality of 2 or 3.  The
+   * other writers, such as vtkNIFTIImageWriter, vtkMetaImageWriter and
+   * vtkTIFFWriter, warn and write the whole input at once.  The default is 1,
+   * which writes the whole input at once.
+   */
+  virtual void SetNumberOfStreamDivisions(int divisions);
+  vtkGetMacro(NumberOfStreamDivisions, int);
+  ///@}
+
   /**
    * The main interface which triggers the writer to start.
    */
@@ -110,11 +134,36 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Whether the writer can write its input one slab at a time.  This is true
+   * for the writers that produce their files through WriteFileHeader(),
+   * WriteFile() and WriteFileTrailer() only.  Subclasses that write the whole
+   * image themselves return false.
+   */
+  virtual bool CanStreamInput() { return true; }
+
+  // Request the current slab of slices when streaming.
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
   int MinimumFileNumber;
   int MaximumFileNumber;
   int FilesDeleted;
 
+  int NumberOfStreamDivisions;
+  int CurrentDivision;
+
 private:
+  // The number of slabs that the given whole extent is streamed in.
+  int GetNumberOfStreamPieces(const int wExtent[6]);
+
+  // Format the current slab and write it in the background, and finish
+  // after the last one.
+  int WritePiece(vtkInformation* request, vtkImageData* input, vtkInformation* inInfo);
+
+  class vtkInternals;
+  vtkInternals* Internals;
+
   vtkImageWriter(const vtkImageWriter&) = delete;
   void operator=(const vtkImageWriter&) = delete;
 };
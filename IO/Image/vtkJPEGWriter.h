@@ -73,6 +73,11 @@ protected:
   vtkJPEGWriter();
   ~vtkJPEGWriter() override;
 
+  /**
+   * libjpeg compresses the whole image at once, so this writer does not stream.
+   */
+  bool CanStreamInput() override { return false; }
+
   void WriteSlice(vtkImageData* data, int* uExtent);
 
 private:
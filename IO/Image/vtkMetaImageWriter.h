@@ -98,6 +98,11 @@ protected:
   vtkMetaImageWriter();
   ~vtkMetaImageWriter() override;
 
+  /**
+   * MetaIO writes the whole image at once, so this writer does not stream.
+   */
+  bool CanStreamInput() override { return false; }
+
   vtkSetFilePathMacro(MHDFileName);
   char* MHDFileName;
   bool Compress;
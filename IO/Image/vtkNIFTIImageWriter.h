@@ -162,6 +162,11 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * The header and the image are written at once, so this writer does not stream.
+   */
+  bool CanStreamInput() override { return false; }
+
   /**
    * Make a new filename by replacing extension "ext1" with "ext2".
    * The extensions must include a period, must be three characters
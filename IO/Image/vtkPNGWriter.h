@@ -97,6 +97,11 @@ protected:
   vtkPNGWriter();
   ~vtkPNGWriter() override;
 
+  /**
+   * libpng compresses the whole image at once, so this writer does not stream.
+   */
+  bool CanStreamInput() override { return false; }
+
   void WriteSlice(vtkImageData* data, int* uExtent);
   int CompressionLevel;
   vtkUnsignedCharArray* Result;
@@ -58,6 +58,11 @@ protected:
   vtkTIFFWriter();
   ~vtkTIFFWriter() override = default;
 
+  /**
+   * Write() writes the whole input with libtiff, so this writer does not stream.
+   */
+  bool CanStreamInput() override { return false; }
+
   void WriteFile(ostream* file, vtkImageData* data, int ext[6], int wExt[6]) override;
   void WriteFileHeader(ostream*, vtkImageData*, int wExt[6]) override;
   void WriteFileTrailer(ostream*, vtkImageData*) override;
@@ -127,6 +127,12 @@ protected:
   vtkMINCImageWriter();
   ~vtkMINCImageWriter() override;
 
+  /**
+   * The MINC file is written through its own RequestUpdateExtent(), so the slab
+   * streaming of vtkImageWriter does not apply.
+   */
+  bool CanStreamInput() override { return false; }
+
   int MINCImageType;
   int MINCImageTypeSigned;
   int MINCImageMinMaxDims;
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Compares the Felzenszwalb algorithm of vtkImageEuclideanDistance with a
+// brute force computation of the squared distances, with anisotropic spacing,
+// float output and signed distances, and with the Saito algorithm.
+
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// A mask with a few zero voxels, so that the distances are large.
+void MakeMask(vtkImageData* image, int nx, int ny, int nz, const double spacing[3])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(nx + ny + nz);
+  image->SetExtent(-2, nx - 3, 1, ny, 0, nz - 1);
+  image->SetSpacing(spacing);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* values = static_cast<unsigned char*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    values[i] = (random->GetNextRangeValue(0.0, 1.0) < 0.02 ? 0 : 1);
+    random->Next();
+  }
+}
+
+// Squared distance from a voxel to the nearest voxel of the given mask value.
+double ComputeDistance(vtkImageData* mask, int i, int j, int k, bool value)
+{
+  const int* extent = mask->GetExtent();
+  const double* spacing = mask->GetSpacing();
+  double minimum = VTK_DOUBLE_MAX;
+  for (int z = extent[4]; z <= extent[5]; ++z)
+  {
+    for (int y = extent[2]; y <= extent[3]; ++y)
+    {
+      for (int x = extent[0]; x <= extent[1]; ++x)
+      {
+        if ((mask->GetScalarComponentAsDouble(x, y, z, 0) != 0) == value)
+        {
+          const double dx = (x - i) * spacing[0];
+          const double dy = (y - j) * spacing[1];
+          const double dz = (z - k) * spacing[2];
+          minimum = std::min(minimum, dx * dx + dy * dy + dz * dz);
+        }
+      }
+    }
+  }
+  return minimum;
+}
+
+bool Compare(vtkImageData* mask, vtkImageData* distance, bool signedDistance, double tolerance)
+{
+  const int* extent = mask->GetExtent();
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        double expected = 0.0;
+        if (mask->GetScalarComponentAsDouble(i, j, k, 0) != 0)
+        {
+          expected = ComputeDistance(mask, i, j, k, false);
+        }
+        else if (signedDistance)
+        {
+          expected = -ComputeDistance(mask, i, j, k, true);
+        }
+        const double value = distance->GetScalarComponentAsDouble(i, j, k, 0);
+        if (std::abs(value - expected) > tolerance * std::max(1.0, std::abs(expected)))
+        {
+          std::cerr << "Wrong distance at " << i << " " << j << " " << k << ": " << value
+                    << " instead of " << expected << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestMask(int nx, int ny, int nz, const double spacing[3])
+{
+  vtkNew<vtkImageData> mask;
+  MakeMask(mask, nx, ny, nz, spacing);
+
+  vtkNew<vtkImageEuclideanDistance> distance;
+  distance->SetInputData(mask);
+  distance->SetAlgorithmToFelzenszwalb();
+  distance->Update();
+  if (distance->GetOutput()->GetScalarType() != VTK_DOUBLE ||
+    !Compare(mask, distance->GetOutput(), false, 1e-12))
+  {
+    std::cerr << "Wrong Felzenszwalb distance." << std::endl;
+    return false;
+  }
+
+  // Unsupported output types are clamped to float or double.
+  distance->SetOutputScalarType(VTK_UNSIGNED_CHAR);
+  distance->Update();
+  if (distance->GetOutput()->GetScalarType() != VTK_FLOAT ||
+    !Compare(mask, distance->GetOutput(), false, 1e-6))
+  {
+    std::cerr << "Wrong float distance." << std::endl;
+    return false;
+  }
+
+  distance->SignedDistanceOn();
+  distance->Update();
+  if (!Compare(mask, distance->GetOutput(), true, 1e-6))
+  {
+    std::cerr << "Wrong signed distance." << std::endl;
+    return false;
+  }
+
+  // Saito's algorithm is exact without anisotropy, the signed distance is
+  // only supported by the Felzenszwalb algorithm.
+  if (spacing[0] == 1.0 && spacing[1] == 1.0 && spacing[2] == 1.0)
+  {
+    distance->SetAlgorithmToSaito();
+    distance->Update();
+    if (!Compare(mask, distance->GetOutput(), false, 1e-6))
+    {
+      std::cerr << "Wrong Saito distance." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int ImageEuclideanDistance(int, char*[])
+{
+  // Use several threads even on a single core.
+  vtkSMPTools::Initialize(4);
+
+  const double isotropic[3] = { 1.0, 1.0, 1.0 };
+  const double anisotropic[3] = { 0.7, 1.3, 2.1 };
+  if (!TestMask(23, 17, 11, isotropic) || !TestMask(19, 14, 9, anisotropic) ||
+    !TestMask(61, 47, 1, anisotropic))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Compares vtkImageFFT with a direct computation of the discrete Fourier
+// transform, for real and complex images with even, odd and prime sizes, and
+// checks that vtkImageRFFT gives the image back.
+
+#include "vtkImageData.h"
+#include "vtkImageFFT.h"
+#include "vtkImageRFFT.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+#include <complex>
+#include <iostream>
+
+namespace
+{
+void MakeImage(vtkImageData* image, const int dims[3], int numberOfComponents)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(numberOfComponents);
+  image->SetDimensions(dims[0], dims[1], dims[2]);
+  image->AllocateScalars(VTK_FLOAT, numberOfComponents);
+  float* values = static_cast<float*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints() * numberOfComponents; ++i)
+  {
+    values[i] = static_cast<float>(random->GetNextRangeValue(-1.0, 1.0));
+    random->Next();
+  }
+}
+
+std::complex<double> GetValue(vtkImageData* image, int i, int j, int k)
+{
+  const int numberOfComponents = image->GetNumberOfScalarComponents();
+  const double real = image->GetScalarComponentAsDouble(i, j, k, 0);
+  return { real, numberOfComponents > 1 ? image->GetScalarComponentAsDouble(i, j, k, 1) : 0.0 };
+}
+
+// Direct computation of one coefficient of the transform.
+std::complex<double> ComputeDFT(vtkImageData* image, const int dims[3], const int freq[3])
+{
+  std::complex<double> sum = 0.0;
+  for (int k = 0; k < dims[2]; ++k)
+  {
+    for (int j = 0; j < dims[1]; ++j)
+    {
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        const double phase = -2.0 * vtkMath::Pi() *
+          (static_cast<double>(freq[0]) * i / dims[0] + static_cast<double>(freq[1]) * j / dims[1] +
+            static_cast<double>(freq[2]) * k / dims[2]);
+        sum += GetValue(image, i, j, k) * std::polar(1.0, phase);
+      }
+    }
+  }
+  return sum;
+}
+
+bool TestImage(const int dims[3], int numberOfComponents)
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image, dims, numberOfComponents);
+
+  vtkNew<vtkImageFFT> fft;
+  fft->SetInputData(image);
+  vtkNew<vtkImageRFFT> rfft;
+  rfft->SetInputConnection(fft->GetOutputPort());
+  rfft->Update();
+  vtkImageData* spectrum = fft->GetOutput();
+  vtkImageData* result = rfft->GetOutput();
+
+  for (int k = 0; k < dims[2]; ++k)
+  {
+    for (int j = 0; j < dims[1]; ++j)
+    {
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        const int freq[3] = { i, j, k };
+        if ((i + 2 * j + 3 * k) % 7 == 0 &&
+          std::abs(GetValue(spectrum, i, j, k) - ComputeDFT(image, dims, freq)) > 1e-9)
+        {
+          std::cerr << "Wrong transform at " << i << " " << j << " " << k << " for size "
+                    << dims[0] << " " << dims[1] << " " << dims[2] << std::endl;
+          return false;
+        }
+        // The inverse of the transform of a real image is real.
+        if (std::abs(GetValue(result, i, j, k) - GetValue(image, i, j, k)) > 1e-9)
+        {
+          std::cerr << "Wrong inverse transform." << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int ImageFFT(int, char*[])
+{
+  // Sizes with factors of 2, 3, 5 and with large prime factors.
+  const int sizes[][3] = { { 16, 12, 1 }, { 15, 8, 6 }, { 7, 26, 5 }, { 34, 13, 9 } };
+  for (const auto& dims : sizes)
+  {
+    for (int numberOfComponents = 1; numberOfComponents <= 2; ++numberOfComponents)
+    {
+      if (!TestImage(dims, numberOfComponents))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Compares the recursive mode of vtkImageGaussianSmooth with the convolution
+// away from the boundaries, checks the boundaries and the update extents, and
+// checks the gaussian derivatives of vtkImageGradient with anisotropic spacing.
+
+#include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkImageGradient.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// An image of random values between 0 and 100.
+void MakeImage(vtkImageData* image, int scalarType, int numberOfComponents)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(scalarType);
+  image->SetExtent(-5, 42, 3, 39, 0, 30);
+  image->AllocateScalars(scalarType, numberOfComponents);
+  const int* extent = image->GetExtent();
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        for (int c = 0; c < numberOfComponents; ++c)
+        {
+          image->SetScalarComponentFromDouble(i, j, k, c, random->GetNextRangeValue(0.0, 100.0));
+          random->Next();
+        }
+      }
+    }
+  }
+}
+
+// The largest difference between two images inside the given extent.
+double MaximumDifference(vtkImageData* a, vtkImageData* b, const int extent[6])
+{
+  double maximum = 0.0;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        for (int c = 0; c < a->GetNumberOfScalarComponents(); ++c)
+        {
+          maximum = std::max(maximum,
+            std::abs(a->GetScalarComponentAsDouble(i, j, k, c) -
+              b->GetScalarComponentAsDouble(i, j, k, c)));
+        }
+      }
+    }
+  }
+  return maximum;
+}
+
+bool TestSmooth(int scalarType, int numberOfComponents, const double std[3], double tolerance)
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image, scalarType, numberOfComponents);
+  int extent[6];
+  image->GetExtent(extent);
+
+  vtkNew<vtkImageGaussianSmooth> convolution;
+  convolution->SetInputData(image);
+  convolution->SetStandardDeviations(std[0], std[1], std[2]);
+  convolution->SetRadiusFactor(4.0);
+  convolution->Update();
+
+  vtkNew<vtkImageGaussianSmooth> recursive;
+  recursive->SetInputData(image);
+  recursive->SetStandardDeviations(std[0], std[1], std[2]);
+  recursive->RecursiveOn();
+  recursive->Update();
+
+  // The convolution clips the kernel at the boundaries.
+  int interior[6];
+  for (int a = 0; a < 3; ++a)
+  {
+    const int radius = static_cast<int>(std::ceil(4.0 * std[a]));
+    interior[2 * a] = extent[2 * a] + radius;
+    interior[2 * a + 1] = extent[2 * a + 1] - radius;
+  }
+  const double difference =
+    MaximumDifference(convolution->GetOutput(), recursive->GetOutput(), interior);
+  if (difference > tolerance)
+  {
+    std::cerr << "Recursive smoothing of " << vtkImageScalarTypeNameMacro(scalarType)
+              << " differs by " << difference << " from the convolution." << std::endl;
+    return false;
+  }
+
+  // A piece of the output is the same as the whole output.
+  vtkNew<vtkImageData> whole;
+  whole->DeepCopy(recursive->GetOutput());
+  const int piece[6] = { extent[0] + 3, extent[1] - 7, extent[2] + 5, extent[3], extent[4] + 2,
+    extent[5] - 1 };
+  recursive->UpdateExtent(piece);
+  if (MaximumDifference(whole, recursive->GetOutput(), piece) != 0.0)
+  {
+    std::cerr << "The output for an update extent differs." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestConstant()
+{
+  // The boundaries are handled by repeating the boundary voxels.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(30, 20, 2);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  std::fill_n(static_cast<float*>(image->GetScalarPointer()), 30 * 20 * 2, 7.0f);
+
+  vtkNew<vtkImageGaussianSmooth> recursive;
+  recursive->SetInputData(image);
+  recursive->SetStandardDeviations(3.0, 40.0, 0.2);
+  recursive->RecursiveOn();
+  recursive->Update();
+  const float* values = static_cast<float*>(recursive->GetOutput()->GetScalarPointer());
+  for (int i = 0; i < 30 * 20 * 2; ++i)
+  {
+    if (std::abs(values[i] - 7.0f) > 1e-4)
+    {
+      std::cerr << "A constant image is not constant after smoothing: " << values[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestGradient()
+{
+  // A linear function with a different spacing along each axis, its
+  // gradient is not changed by the smoothing away from the boundaries.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 36, 30);
+  image->SetSpacing(0.5, 1.0, 1.5);
+  image->AllocateScalars(VTK_DOUBLE, 1);
+  const double slope[3] = { 2.0, -1.0, 0.5 };
+  for (int k = 0; k < 30; ++k)
+  {
+    for (int j = 0; j < 36; ++j)
+    {
+      for (int i = 0; i < 40; ++i)
+      {
+        image->SetScalarComponentFromDouble(
+          i, j, k, 0, slope[0] * 0.5 * i + slope[1] * 1.0 * j + slope[2] * 1.5 * k);
+      }
+    }
+  }
+
+  const double std = 1.5;
+  vtkNew<vtkImageGradient> gradient;
+  gradient->SetInputData(image);
+  gradient->SetDimensionality(3);
+  gradient->SetStandardDeviation(std);
+  gradient->Update();
+  vtkImageData* output = gradient->GetOutput();
+  for (int k = 12; k < 18; ++k)
+  {
+    for (int j = 14; j < 22; ++j)
+    {
+      for (int i = 16; i < 24; ++i)
+      {
+        for (int c = 0; c < 3; ++c)
+        {
+          if (std::abs(output->GetScalarComponentAsDouble(i, j, k, c) - slope[c]) > 1e-3)
+          {
+            std::cerr << "Wrong gradient at " << i << " " << j << " " << k << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+
+  // The gradient of the gaussian is the gradient of the smoothed image.
+  MakeImage(image, VTK_DOUBLE, 1);
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  smooth->SetInputData(image);
+  smooth->SetStandardDeviations(std / 0.5, std / 1.0, std / 1.5);
+  smooth->RecursiveOn();
+  vtkNew<vtkImageGradient> smoothGradient;
+  smoothGradient->SetInputConnection(smooth->GetOutputPort());
+  smoothGradient->SetDimensionality(3);
+  smoothGradient->Update();
+  gradient->Update();
+  if (MaximumDifference(gradient->GetOutput(), smoothGradient->GetOutput(),
+        gradient->GetOutput()->GetExtent()) > 1e-9)
+  {
+    std::cerr << "The gradient of the gaussian differs from the smoothed gradient." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int ImageGaussianSmoothRecursive(int, char*[])
+{
+  // Use several threads even on a single core.
+  vtkSMPTools::Initialize(4);
+
+  const double isotropic[3] = { 2.0, 2.0, 2.0 };
+  const double anisotropic[3] = { 3.0, 2.5, 1.0 };
+  bool success = TestSmooth(VTK_FLOAT, 1, isotropic, 1.0);
+  success &= TestSmooth(VTK_DOUBLE, 3, anisotropic, 1.0);
+  success &= TestSmooth(VTK_SHORT, 2, anisotropic, 1.5);
+  success &= TestConstant();
+  success &= TestGradient();
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,226 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the multi-component histograms of vtkImageAccumulate and the joint
+// histograms of vtkImageHistogram against a direct count, with and without
+// a stencil, for histograms with few bins and for histograms with so many
+// bins that each thread stores them sparsely.
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageAccumulate.h"
+#include "vtkImageData.h"
+#include "vtkImageEllipsoidSource.h"
+#include "vtkImageHistogram.h"
+#include "vtkImageStencilData.h"
+#include "vtkImageToImageStencil.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace
+{
+// A three-component image with pseudo-random values.
+void MakeImage(vtkImageData* image)
+{
+  image->SetExtent(0, 39, -3, 26, 1, 20);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+  unsigned char* ptr = static_cast<unsigned char*>(image->GetScalarPointer());
+  unsigned int seed = 12345;
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints() * 3; i++)
+  {
+    seed = seed * 1103515245u + 12345u;
+    ptr[i] = static_cast<unsigned char>((seed >> 16) % 200);
+  }
+}
+
+// Call a function for each voxel in the stencil.
+template <class F>
+void ForEachVoxel(vtkImageData* image, vtkImageStencilData* stencil, F f)
+{
+  const int* extent = image->GetExtent();
+  for (int k = extent[4]; k <= extent[5]; k++)
+  {
+    for (int j = extent[2]; j <= extent[3]; j++)
+    {
+      for (int i = extent[0]; i <= extent[1]; i++)
+      {
+        if (!stencil || stencil->IsInside(i, j, k))
+        {
+          f(static_cast<unsigned char*>(image->GetScalarPointer(i, j, k)));
+        }
+      }
+    }
+  }
+}
+
+bool TestAccumulate(vtkImageData* image, vtkImageStencilData* stencil, int binsPerComponent)
+{
+  vtkNew<vtkImageAccumulate> accumulate;
+  accumulate->SetInputData(image);
+  accumulate->SetStencilData(stencil);
+  double spacing = 256.0 / binsPerComponent;
+  accumulate->SetComponentSpacing(spacing, spacing, spacing);
+  accumulate->SetComponentOrigin(10.0, 0.0, 0.0);
+  accumulate->SetComponentExtent(
+    0, binsPerComponent - 1, 0, binsPerComponent - 1, 0, binsPerComponent - 1);
+  accumulate->Update();
+
+  // count directly
+  std::map<vtkIdType, vtkIdType> counts;
+  double sum[3] = { 0.0, 0.0, 0.0 };
+  vtkIdType voxelCount = 0;
+  ForEachVoxel(image, stencil, [&](const unsigned char* v) {
+    vtkIdType bin = 0;
+    bool inside = true;
+    for (int c = 2; c >= 0; c--)
+    {
+      int b = vtkMath::Floor((v[c] - (c == 0 ? 10.0 : 0.0)) / spacing);
+      inside &= (b >= 0 && b < binsPerComponent);
+      bin = bin * binsPerComponent + b;
+      sum[c] += v[c];
+    }
+    if (inside)
+    {
+      counts[bin]++;
+    }
+    voxelCount += 3;
+  });
+
+  vtkImageData* output = accumulate->GetOutput();
+  const vtkIdType* histogram = static_cast<vtkIdType*>(output->GetScalarPointer());
+  vtkIdType total = 0;
+  for (vtkIdType bin = 0; bin < output->GetNumberOfPoints(); bin++)
+  {
+    total += histogram[bin];
+    auto count = counts.find(bin);
+    if (histogram[bin] != (count == counts.end() ? 0 : count->second))
+    {
+      std::cerr << "vtkImageAccumulate: wrong count " << histogram[bin] << " in bin " << bin
+                << std::endl;
+      return false;
+    }
+  }
+  if (accumulate->GetVoxelCount() != voxelCount || total == 0)
+  {
+    std::cerr << "vtkImageAccumulate: wrong voxel count " << accumulate->GetVoxelCount()
+              << " instead of " << voxelCount << std::endl;
+    return false;
+  }
+  for (int c = 0; c < 3; c++)
+  {
+    // the voxel count includes every component
+    if (std::abs(accumulate->GetMean()[c] - sum[c] / voxelCount) > 1e-9)
+    {
+      std::cerr << "vtkImageAccumulate: wrong mean " << accumulate->GetMean()[c] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestJointHistogram(
+  vtkImageData* image, vtkImageStencilData* stencil, int numberOfBins, double binOrigin)
+{
+  vtkNew<vtkImageHistogram> histogram;
+  histogram->SetInputData(image);
+  histogram->SetStencilData(stencil);
+  histogram->SetNumberOfBins(numberOfBins);
+  histogram->SetBinOrigin(binOrigin);
+  histogram->SetBinSpacing(200.0 / numberOfBins);
+  histogram->GenerateHistogramImageOff();
+  histogram->GenerateJointHistogramOn();
+  histogram->Update();
+
+  // count directly, with the clamping of vtkImageHistogram
+  std::map<std::vector<vtkIdType>, vtkIdType> counts;
+  ForEachVoxel(image, stencil, [&](const unsigned char* v) {
+    std::vector<vtkIdType> bins(3);
+    for (int c = 0; c < 3; c++)
+    {
+      double x = (v[c] - binOrigin) / histogram->GetBinSpacing();
+      x = (x > 0.0 ? x : 0.0);
+      x = (x < numberOfBins - 1 ? x : numberOfBins - 1);
+      bins[2 - c] = static_cast<int>(x + 0.5);
+    }
+    counts[bins]++;
+  });
+
+  // the bins are sorted with the first component varying fastest
+  vtkIdTypeArray* joint = histogram->GetJointHistogram();
+  if (joint->GetNumberOfComponents() != 4 ||
+    joint->GetNumberOfTuples() != static_cast<vtkIdType>(counts.size()))
+  {
+    std::cerr << "vtkImageHistogram: " << joint->GetNumberOfTuples() << " joint bins instead of "
+              << counts.size() << std::endl;
+    return false;
+  }
+  std::vector<vtkIdType> marginal(numberOfBins, 0);
+  vtkIdType idx = 0;
+  for (const auto& count : counts)
+  {
+    vtkIdType tuple[4];
+    joint->GetTypedTuple(idx++, tuple);
+    if (tuple[0] != count.first[2] || tuple[1] != count.first[1] || tuple[2] != count.first[0] ||
+      tuple[3] != count.second)
+    {
+      std::cerr << "vtkImageHistogram: wrong joint bin " << tuple[0] << "," << tuple[1] << ","
+                << tuple[2] << " with count " << tuple[3] << std::endl;
+      return false;
+    }
+    for (int c = 0; c < 3; c++)
+    {
+      marginal[tuple[c]] += tuple[3];
+    }
+  }
+
+  // the sum of the marginals is the histogram of all components
+  vtkIdTypeArray* sums = histogram->GetHistogram();
+  for (int bin = 0; bin < numberOfBins; bin++)
+  {
+    if (sums->GetValue(bin) != marginal[bin])
+    {
+      std::cerr << "vtkImageHistogram: the marginals do not match the histogram." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int ImageJointHistogram(int, char*[])
+{
+  // make sure that the bins of several threads are summed
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkImageData> image;
+  MakeImage(image);
+
+  vtkNew<vtkImageEllipsoidSource> ellipsoid;
+  ellipsoid->SetWholeExtent(image->GetExtent());
+  ellipsoid->SetCenter(15.0, 10.0, 12.0);
+  ellipsoid->SetRadius(14.0, 11.0, 9.0);
+  ellipsoid->SetInValue(1.0);
+  ellipsoid->SetOutValue(0.0);
+  vtkNew<vtkImageToImageStencil> toStencil;
+  toStencil->SetInputConnection(ellipsoid->GetOutputPort());
+  toStencil->ThresholdByUpper(0.5);
+  toStencil->Update();
+  vtkImageStencilData* stencil = toStencil->GetOutput();
+
+  bool success = true;
+  for (vtkImageStencilData* mask : { static_cast<vtkImageStencilData*>(nullptr), stencil })
+  {
+    // few bins, and more bins than each thread stores densely
+    success &= TestAccumulate(image, mask, 16);
+    success &= TestAccumulate(image, mask, 128);
+    success &= TestJointHistogram(image, mask, 20, 5.0);
+    success &= TestJointHistogram(image, mask, 200, 0.0);
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,226 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Compares vtkImageMedian3D and vtkImageHybridMedian2D with a direct
+// computation from the sorted neighborhood of each voxel, for integer types
+// (that use a histogram) and floating point types, and for several
+// percentiles. NaN values are ordered after all the other values.
+
+#include "vtkImageData.h"
+#include "vtkImageHybridMedian2D.h"
+#include "vtkImageMedian3D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace
+{
+void MakeImage(vtkImageData* image, int scalarType, int numberOfComponents, int nz)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(scalarType);
+  image->SetExtent(-3, 17, 2, 15, 0, nz - 1);
+  image->AllocateScalars(scalarType, numberOfComponents);
+  const double range = (scalarType == VTK_UNSIGNED_CHAR ? 255.0 : 3000.0);
+  for (int k = 0; k < nz; ++k)
+  {
+    for (int j = 2; j <= 15; ++j)
+    {
+      for (int i = -3; i <= 17; ++i)
+      {
+        for (int c = 0; c < numberOfComponents; ++c)
+        {
+          double value = random->GetNextRangeValue(0.0, range);
+          random->Next();
+          if (scalarType != VTK_UNSIGNED_CHAR)
+          {
+            value -= 1000.0;
+          }
+          image->SetScalarComponentFromDouble(i, j, k, c, value);
+        }
+      }
+    }
+  }
+}
+
+// Sets every seventh value of a float image to NaN.
+void AddNaNs(vtkImageData* image)
+{
+  float* values = static_cast<float*>(image->GetScalarPointer());
+  const vtkIdType n = image->GetNumberOfPoints() * image->GetNumberOfScalarComponents();
+  for (vtkIdType i = 0; i < n; i += 7)
+  {
+    values[i] = std::numeric_limits<float>::quiet_NaN();
+  }
+}
+
+bool IsNaN(double value)
+{
+  return std::isnan(value);
+}
+
+// The value of the given percentile among the neighborhood values.
+template <class T>
+double ComputePercentile(std::vector<T>& values, double percentile)
+{
+  std::sort(values.begin(), values.end(),
+    [](T a, T b) { return a < b || (!IsNaN(a) && IsNaN(b)); });
+  const size_t n = values.size();
+  if (percentile == 50.0)
+  {
+    T m = values[n / 2];
+    if (n % 2 == 0)
+    {
+      m = static_cast<T>(values[n / 2 - 1] + (m - values[n / 2 - 1]) / 2);
+    }
+    return m;
+  }
+  return values[static_cast<size_t>(percentile * (n - 1) / 100.0 + 0.5)];
+}
+
+template <class T>
+bool TestMedian(int scalarType, const int kernelSize[3], double percentile, bool withNaNs = false)
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image, scalarType, 2, 9);
+  if (withNaNs)
+  {
+    AddNaNs(image);
+  }
+  const int* extent = image->GetExtent();
+
+  vtkNew<vtkImageMedian3D> median;
+  median->SetInputData(image);
+  median->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  median->SetPercentile(percentile);
+  median->Update();
+  vtkImageData* output = median->GetOutput();
+
+  std::vector<T> values;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        for (int c = 0; c < 2; ++c)
+        {
+          values.clear();
+          const int idx[3] = { i, j, k };
+          int hoodMin[3], hoodMax[3];
+          for (int a = 0; a < 3; ++a)
+          {
+            const int first = idx[a] - kernelSize[a] / 2;
+            hoodMin[a] = std::max(first, extent[2 * a]);
+            hoodMax[a] = std::min(first + kernelSize[a] - 1, extent[2 * a + 1]);
+          }
+          for (int z = hoodMin[2]; z <= hoodMax[2]; ++z)
+          {
+            for (int y = hoodMin[1]; y <= hoodMax[1]; ++y)
+            {
+              for (int x = hoodMin[0]; x <= hoodMax[0]; ++x)
+              {
+                values.push_back(static_cast<T>(image->GetScalarComponentAsDouble(x, y, z, c)));
+              }
+            }
+          }
+          const double expected = ComputePercentile(values, percentile);
+          const double actual = output->GetScalarComponentAsDouble(i, j, k, c);
+          if (actual != expected && !(IsNaN(actual) && IsNaN(expected)))
+          {
+            std::cerr << "Wrong percentile " << percentile << " for type "
+                      << vtkImageScalarTypeNameMacro(scalarType) << " at " << i << " " << j << " "
+                      << k << ": " << actual << " instead of " << expected << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// The median of the values of the image at the given offsets of a pixel,
+// the offsets outside of the image are skipped.
+template <class T>
+T ComputeHybridMedian(vtkImageData* image, int i, int j, const int offsets[9][2])
+{
+  const int* extent = image->GetExtent();
+  std::vector<T> values;
+  for (int n = 0; n < 9; ++n)
+  {
+    const int x = i + offsets[n][0];
+    const int y = j + offsets[n][1];
+    if (x >= extent[0] && x <= extent[1] && y >= extent[2] && y <= extent[3])
+    {
+      values.push_back(static_cast<T>(image->GetScalarComponentAsDouble(x, y, 0, 0)));
+    }
+  }
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+template <class T>
+bool TestHybridMedian(int scalarType)
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image, scalarType, 1, 1);
+  const int* extent = image->GetExtent();
+
+  vtkNew<vtkImageHybridMedian2D> median;
+  median->SetInputData(image);
+  median->Update();
+  vtkImageData* output = median->GetOutput();
+
+  const int plus[9][2] = { { 0, 0 }, { -1, 0 }, { -2, 0 }, { 1, 0 }, { 2, 0 }, { 0, -1 },
+    { 0, -2 }, { 0, 1 }, { 0, 2 } };
+  const int cross[9][2] = { { 0, 0 }, { -1, -1 }, { -2, -2 }, { 1, 1 }, { 2, 2 }, { -1, 1 },
+    { -2, 2 }, { 1, -1 }, { 2, -2 } };
+  for (int j = extent[2]; j <= extent[3]; ++j)
+  {
+    for (int i = extent[0]; i <= extent[1]; ++i)
+    {
+      T values[3] = { ComputeHybridMedian<T>(image, i, j, plus),
+        ComputeHybridMedian<T>(image, i, j, cross),
+        static_cast<T>(image->GetScalarComponentAsDouble(i, j, 0, 0)) };
+      std::sort(values, values + 3);
+      if (output->GetScalarComponentAsDouble(i, j, 0, 0) != values[1])
+      {
+        std::cerr << "Wrong hybrid median for type " << vtkImageScalarTypeNameMacro(scalarType)
+                  << " at " << i << " " << j << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int ImageMedian3D(int, char*[])
+{
+  const int kernelSizes[][3] = { { 5, 3, 4 }, { 7, 7, 1 }, { 1, 1, 1 } };
+  const double percentiles[] = { 50.0, 0.0, 100.0, 30.0 };
+  bool success = true;
+  for (const auto& kernelSize : kernelSizes)
+  {
+    for (double percentile : percentiles)
+    {
+      success &= TestMedian<unsigned char>(VTK_UNSIGNED_CHAR, kernelSize, percentile);
+      success &= TestMedian<short>(VTK_SHORT, kernelSize, percentile);
+      success &= TestMedian<int>(VTK_INT, kernelSize, percentile);
+      success &= TestMedian<float>(VTK_FLOAT, kernelSize, percentile);
+      success &= TestMedian<float>(VTK_FLOAT, kernelSize, percentile, true);
+    }
+  }
+
+  success &= TestHybridMedian<unsigned char>(VTK_UNSIGNED_CHAR);
+  success &= TestHybridMedian<short>(VTK_SHORT);
+  success &= TestHybridMedian<double>(VTK_DOUBLE);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks oblique reslicing with vtkImageReslice against nearest, trilinear
+// and tricubic interpolation written out in the test, for each border mode,
+// in double and in single precision.
+
+#include "vtkAbstractImageInterpolator.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkImageInterpolatorInternals.h"
+#include "vtkImageReslice.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// A smooth two-component image with a non-zero origin and non-unit spacing.
+void MakeImage(vtkImageData* image, const int extent[6])
+{
+  image->SetExtent(const_cast<int*>(extent));
+  image->SetOrigin(-3.0, 2.0, 1.5);
+  image->SetSpacing(1.1, 0.9, 1.3);
+  image->AllocateScalars(VTK_FLOAT, 2);
+  float* ptr = static_cast<float*>(image->GetScalarPointer());
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        *ptr++ = static_cast<float>(100.0 * std::sin(0.2 * i) * std::cos(0.15 * j) + 2.0 * k);
+        *ptr++ = static_cast<float>((i * 7 + j * 3 + k * 5) % 11);
+      }
+    }
+  }
+}
+
+// The index of the sample at i along an axis of extent [lo, hi].
+int BorderIndex(int i, int lo, int hi, int border)
+{
+  if (border == VTK_IMAGE_BORDER_REPEAT)
+  {
+    const int n = hi - lo + 1;
+    return lo + ((i - lo) % n + n) % n;
+  }
+  if (border == VTK_IMAGE_BORDER_MIRROR)
+  {
+    // reflect about the first and the last sample, without repeating them
+    const int period = 2 * (hi - lo);
+    const int a = std::abs(i - lo) % period;
+    return lo + (a <= hi - lo ? a : period - a);
+  }
+  return std::min(std::max(i, lo), hi);
+}
+
+// The first of the four samples around x along an axis and their weights.
+// The position is rounded with the fast floor of the interpolators, which
+// keeps 16 bits of the fraction.
+int Weights(int mode, double x, double w[4])
+{
+  double f;
+  const int i = vtkInterpolationMath::Floor(x, f);
+  w[0] = w[1] = w[2] = w[3] = 0.0;
+  if (mode == VTK_RESLICE_NEAREST)
+  {
+    w[1] = 1.0;
+    return vtkInterpolationMath::Round(x) - 1;
+  }
+  if (mode == VTK_RESLICE_LINEAR)
+  {
+    w[1] = 1.0 - f;
+    w[2] = f;
+  }
+  else // Catmull-Rom cubic
+  {
+    w[0] = 0.5 * (-f * f * f + 2.0 * f * f - f);
+    w[1] = 0.5 * (3.0 * f * f * f - 5.0 * f * f + 2.0);
+    w[2] = 0.5 * (-3.0 * f * f * f + 4.0 * f * f + f);
+    w[3] = 0.5 * (f * f * f - f * f);
+  }
+  return i - 1;
+}
+
+// Interpolate component c of the image at the structured coords x.
+double Interpolate(vtkImageData* image, int mode, int border, const double x[3], int c)
+{
+  const int* extent = image->GetExtent();
+  int first[3];
+  double w[3][4];
+  for (int a = 0; a < 3; ++a)
+  {
+    first[a] = Weights(mode, x[a], w[a]);
+  }
+  double value = 0.0;
+  for (int k = 0; k < 4; ++k)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        const double weight = w[0][i] * w[1][j] * w[2][k];
+        if (weight != 0.0)
+        {
+          const int ii = BorderIndex(first[0] + i, extent[0], extent[1], border);
+          const int jj = BorderIndex(first[1] + j, extent[2], extent[3], border);
+          const int kk = BorderIndex(first[2] + k, extent[4], extent[5], border);
+          value += weight * image->GetScalarComponentAsDouble(ii, jj, kk, c);
+        }
+      }
+    }
+  }
+  return value;
+}
+
+// An oblique reslice of the image, rotated about its center.
+void SetupReslice(vtkImageReslice* reslice, vtkImageData* image, int outputSize)
+{
+  double center[3];
+  image->GetCenter(center);
+  vtkNew<vtkTransform> transform;
+  transform->Translate(center);
+  transform->RotateWXYZ(33.0, 1.0, 2.0, 3.0);
+  transform->Translate(-center[0], -center[1], -center[2]);
+
+  reslice->SetInputData(image);
+  reslice->SetResliceAxes(transform->GetMatrix());
+  reslice->SetOutputScalarType(VTK_FLOAT);
+  reslice->SetOutputSpacing(0.95, 1.05, 1.2);
+  reslice->SetOutputOrigin(center[0] - 0.6 * outputSize, center[1] - 0.6 * outputSize,
+    center[2] - 0.1 * outputSize);
+  reslice->SetOutputExtent(0, outputSize - 1, 0, outputSize - 1, 0, outputSize / 4);
+  reslice->SetBackgroundLevel(-7.0);
+}
+
+bool CheckReslice(vtkImageData* image, int mode, int border, bool single)
+{
+  vtkNew<vtkImageReslice> reslice;
+  SetupReslice(reslice, image, 40);
+  reslice->SetInterpolationMode(mode);
+  reslice->SetWrap(border == VTK_IMAGE_BORDER_REPEAT);
+  reslice->SetMirror(border == VTK_IMAGE_BORDER_MIRROR);
+  reslice->SetSinglePrecision(single);
+  reslice->Update();
+
+  vtkImageData* output = reslice->GetOutput();
+  vtkFloatArray* scalars = vtkArrayDownCast<vtkFloatArray>(output->GetPointData()->GetScalars());
+  vtkMatrix4x4* axes = reslice->GetResliceAxes();
+  const double* spacing = output->GetSpacing();
+  const double* origin = output->GetOrigin();
+  const double* inOrigin = image->GetOrigin();
+  const double* inSpacing = image->GetSpacing();
+  const int* inExtent = image->GetExtent();
+  const int* extent = output->GetExtent();
+  const double tol = (single ? 1e-2 : 1e-4);
+  const double boundsTol = (single ? 1e-3 : 1e-9);
+
+  int numberInBounds = 0;
+  vtkIdType idx = 0;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i, ++idx)
+      {
+        double point[4] = { origin[0] + i * spacing[0], origin[1] + j * spacing[1],
+          origin[2] + k * spacing[2], 1.0 };
+        axes->MultiplyPoint(point, point);
+
+        // the points within half a voxel of the bounds are clamped, skip
+        // the points so close to the bounds, or to the middle between two
+        // voxels for nearest, that rounding decides
+        double x[3];
+        bool inBounds = true;
+        bool ambiguous = false;
+        for (int c = 0; c < 3; ++c)
+        {
+          x[c] = (point[c] - inOrigin[c]) / inSpacing[c];
+          if (border == VTK_IMAGE_BORDER_CLAMP)
+          {
+            inBounds &= (x[c] >= inExtent[2 * c] - 0.5 && x[c] <= inExtent[2 * c + 1] + 0.5);
+            ambiguous |= (std::abs(x[c] - (inExtent[2 * c] - 0.5)) < boundsTol ||
+              std::abs(x[c] - (inExtent[2 * c + 1] + 0.5)) < boundsTol);
+          }
+          if (mode == VTK_RESLICE_NEAREST)
+          {
+            ambiguous |= (vtkInterpolationMath::Round(x[c] - boundsTol) !=
+              vtkInterpolationMath::Round(x[c] + boundsTol));
+          }
+        }
+        numberInBounds += inBounds;
+        for (int c = 0; c < 2 && !ambiguous; ++c)
+        {
+          const double value = (inBounds ? Interpolate(image, mode, border, x, c) : -7.0);
+          if (std::abs(scalars->GetTypedComponent(idx, c) - value) > tol)
+          {
+            std::cerr << "Mode " << mode << ", border " << border << ", single " << single
+                      << ": wrong value " << scalars->GetTypedComponent(idx, c) << " instead of "
+                      << value << " at " << i << "," << j << "," << k << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+
+  // the output must have samples both inside and outside of the input
+  if (border == VTK_IMAGE_BORDER_CLAMP && (numberInBounds == 0 || numberInBounds == idx))
+  {
+    std::cerr << "The reslice does not cross the bounds of the input." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int ImageResliceOblique(int, char*[])
+{
+  const int extent[6] = { 0, 29, -4, 27, 2, 25 };
+  vtkNew<vtkImageData> image;
+  MakeImage(image, extent);
+
+  bool success = true;
+  const int modes[3] = { VTK_RESLICE_NEAREST, VTK_RESLICE_LINEAR, VTK_RESLICE_CUBIC };
+  const int borders[3] = { VTK_IMAGE_BORDER_CLAMP, VTK_IMAGE_BORDER_REPEAT,
+    VTK_IMAGE_BORDER_MIRROR };
+  for (int mode : modes)
+  {
+    for (int border : borders)
+    {
+      success &= CheckReslice(image, mode, border, false);
+      // rounding in single precision can pick a different nearest voxel
+      if (mode != VTK_RESLICE_NEAREST)
+      {
+        success &= CheckReslice(image, mode, border, true);
+      }
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that label images whose scalars are stored as a vtkRunLengthArray
+// give the same results as dense label images in vtkImageStencilToImage,
+// vtkImageStencil, vtkImageAccumulate and vtkDiscreteFlyingEdges3D.
+
+#include "vtkDiscreteFlyingEdges3D.h"
+#include "vtkImageAccumulate.h"
+#include "vtkImageData.h"
+#include "vtkImageEllipsoidSource.h"
+#include "vtkImageStencil.h"
+#include "vtkImageStencilData.h"
+#include "vtkImageStencilToImage.h"
+#include "vtkImageToImageStencil.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRunLengthArray.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// A label image with the labels 0 to 3 in nested ellipsoids.
+void MakeLabels(vtkImageData* image)
+{
+  int extent[6] = { -5, 34, 2, 27, 0, 21 };
+  image->SetExtent(extent);
+  image->AllocateScalars(VTK_SHORT, 1);
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        const double x = (i - 14.0) / 17.0;
+        const double y = (j - 14.0) / 10.0;
+        const double z = (k - 10.0) / 9.0;
+        const double r = x * x + y * y + z * z;
+        short label = (r < 0.2 ? 3 : (r < 0.5 ? 2 : (r < 1.0 ? 1 : 0)));
+        image->SetScalarComponentFromDouble(i, j, k, 0, label);
+      }
+    }
+  }
+}
+
+// Copy a dense label image to an image with run-length scalars.
+void EncodeLabels(vtkImageData* image, vtkImageData* encoded)
+{
+  const int* extent = image->GetExtent();
+  const int nx = extent[1] - extent[0] + 1;
+  const vtkIdType rows = static_cast<vtkIdType>(image->GetNumberOfPoints() / nx);
+  const short* values = static_cast<short*>(image->GetScalarPointer());
+
+  vtkNew<vtkRunLengthArray<short>> runs;
+  runs->ConstructBackend(nx, rows, static_cast<short>(0));
+  runs->SetNumberOfComponents(1);
+  runs->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType row = 0; row < rows; ++row)
+  {
+    for (int i = 0; i < nx; ++i)
+    {
+      runs->GetBackend()->InsertNextRun(row, i, i, values[row * nx + i]);
+    }
+  }
+  encoded->CopyStructure(image);
+  encoded->GetPointData()->SetScalars(runs);
+}
+
+bool CompareScalars(vtkImageData* image1, vtkImageData* image2, const char* name)
+{
+  vtkDataArray* scalars1 = image1->GetPointData()->GetScalars();
+  vtkDataArray* scalars2 = image2->GetPointData()->GetScalars();
+  if (scalars1->GetNumberOfTuples() != scalars2->GetNumberOfTuples())
+  {
+    std::cerr << name << ": the number of tuples differs." << std::endl;
+    return false;
+  }
+  for (vtkIdType idx = 0; idx < scalars1->GetNumberOfTuples(); ++idx)
+  {
+    if (scalars1->GetComponent(idx, 0) != scalars2->GetComponent(idx, 0))
+    {
+      std::cerr << name << ": wrong value at " << idx << ": " << scalars2->GetComponent(idx, 0)
+                << " instead of " << scalars1->GetComponent(idx, 0) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestStencilToImage(vtkImageStencilData* stencil)
+{
+  vtkNew<vtkImageStencilToImage> dense;
+  dense->SetInputData(stencil);
+  dense->SetInsideValue(5);
+  dense->SetOutsideValue(-1);
+  dense->SetOutputScalarTypeToShort();
+  dense->Update();
+
+  vtkNew<vtkImageStencilToImage> runs;
+  runs->SetInputData(stencil);
+  runs->SetInsideValue(5);
+  runs->SetOutsideValue(-1);
+  runs->SetOutputScalarTypeToShort();
+  runs->RunLengthOutputOn();
+  runs->Update();
+
+  if (!vtkArrayDownCast<vtkRunLengthArray<short>>(
+        runs->GetOutput()->GetPointData()->GetScalars()))
+  {
+    std::cerr << "vtkImageStencilToImage did not produce runs." << std::endl;
+    return false;
+  }
+  return CompareScalars(dense->GetOutput(), runs->GetOutput(), "vtkImageStencilToImage");
+}
+
+bool TestStencil(vtkImageData* labels, vtkImageData* encoded, vtkImageStencilData* stencil)
+{
+  vtkNew<vtkImageStencil> dense;
+  dense->SetInputData(labels);
+  dense->SetStencilData(stencil);
+  dense->SetBackgroundValue(7);
+  dense->Update();
+
+  vtkNew<vtkImageStencil> runs;
+  runs->SetInputData(encoded);
+  runs->SetStencilData(stencil);
+  runs->SetBackgroundValue(7);
+  runs->ReverseStencilOn();
+  runs->Update();
+
+  // reversing the stencil swaps the voxels that keep their label
+  vtkNew<vtkImageStencil> reverse;
+  reverse->SetInputData(labels);
+  reverse->SetStencilData(stencil);
+  reverse->SetBackgroundValue(7);
+  reverse->ReverseStencilOn();
+  reverse->Update();
+
+  vtkNew<vtkImageStencil> forward;
+  forward->SetInputData(encoded);
+  forward->SetStencilData(stencil);
+  forward->SetBackgroundValue(7);
+  forward->Update();
+
+  return CompareScalars(dense->GetOutput(), forward->GetOutput(), "vtkImageStencil") &&
+    CompareScalars(reverse->GetOutput(), runs->GetOutput(), "vtkImageStencil reversed");
+}
+
+bool TestAccumulate(vtkImageData* labels, vtkImageData* encoded, vtkImageStencilData* stencil)
+{
+  for (int mode = 0; mode < 3; ++mode)
+  {
+    vtkNew<vtkImageAccumulate> dense;
+    vtkNew<vtkImageAccumulate> runs;
+    vtkImageAccumulate* filters[2] = { dense, runs };
+    for (vtkImageAccumulate* filter : filters)
+    {
+      filter->SetComponentExtent(0, 5, 0, 0, 0, 0);
+      filter->SetComponentOrigin(-1, 0, 0);
+      if (mode > 0)
+      {
+        filter->SetStencilData(stencil);
+        filter->SetReverseStencil(mode == 2);
+      }
+      filter->SetIgnoreZero(mode == 1);
+    }
+    dense->SetInputData(labels);
+    dense->Update();
+    runs->SetInputData(encoded);
+    runs->Update();
+
+    if (dense->GetVoxelCount() != runs->GetVoxelCount() ||
+      dense->GetMin()[0] != runs->GetMin()[0] || dense->GetMax()[0] != runs->GetMax()[0] ||
+      std::abs(dense->GetMean()[0] - runs->GetMean()[0]) > 1e-12 ||
+      std::abs(dense->GetStandardDeviation()[0] - runs->GetStandardDeviation()[0]) > 1e-9)
+    {
+      std::cerr << "vtkImageAccumulate statistics differ in mode " << mode << ": "
+                << runs->GetVoxelCount() << " " << runs->GetMean()[0] << " instead of "
+                << dense->GetVoxelCount() << " " << dense->GetMean()[0] << std::endl;
+      return false;
+    }
+    if (!CompareScalars(dense->GetOutput(), runs->GetOutput(), "vtkImageAccumulate"))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestFlyingEdges(vtkImageData* labels, vtkImageData* encoded)
+{
+  vtkNew<vtkDiscreteFlyingEdges3D> dense;
+  dense->SetInputData(labels);
+  dense->GenerateValues(3, 1, 3);
+  dense->ComputeNormalsOn();
+  dense->Update();
+
+  vtkNew<vtkDiscreteFlyingEdges3D> runs;
+  runs->SetInputData(encoded);
+  runs->GenerateValues(3, 1, 3);
+  runs->ComputeNormalsOn();
+  runs->Update();
+
+  vtkPolyData* output1 = dense->GetOutput();
+  vtkPolyData* output2 = runs->GetOutput();
+  if (output1->GetNumberOfPoints() == 0 ||
+    output1->GetNumberOfPoints() != output2->GetNumberOfPoints() ||
+    output1->GetNumberOfPolys() != output2->GetNumberOfPolys())
+  {
+    std::cerr << "vtkDiscreteFlyingEdges3D generated " << output2->GetNumberOfPoints()
+              << " points instead of " << output1->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  vtkDataArray* normals1 = output1->GetPointData()->GetNormals();
+  vtkDataArray* normals2 = output2->GetPointData()->GetNormals();
+  for (vtkIdType idx = 0; idx < output1->GetNumberOfPoints(); ++idx)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      if (output1->GetPoint(idx)[c] != output2->GetPoint(idx)[c] ||
+        normals1->GetComponent(idx, c) != normals2->GetComponent(idx, c))
+      {
+        std::cerr << "vtkDiscreteFlyingEdges3D generated a different point " << idx << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int ImageRunLengthLabels(int, char*[])
+{
+  vtkNew<vtkImageData> labels;
+  MakeLabels(labels);
+  vtkNew<vtkImageData> encoded;
+  EncodeLabels(labels, encoded);
+
+  // a stencil from an ellipsoid that is not centered on the labels
+  vtkNew<vtkImageEllipsoidSource> ellipsoid;
+  ellipsoid->SetWholeExtent(labels->GetExtent());
+  ellipsoid->SetCenter(8.0, 12.0, 9.0);
+  ellipsoid->SetRadius(12.0, 7.0, 8.0);
+  ellipsoid->SetInValue(1.0);
+  ellipsoid->SetOutValue(0.0);
+  vtkNew<vtkImageToImageStencil> toStencil;
+  toStencil->SetInputConnection(ellipsoid->GetOutputPort());
+  toStencil->ThresholdByUpper(0.5);
+  toStencil->Update();
+  vtkImageStencilData* stencil = toStencil->GetOutput();
+
+  bool success = TestStencilToImage(stencil);
+  success &= TestStencil(labels, encoded, stencil);
+  success &= TestAccumulate(labels, encoded, stencil);
+  success &= TestFlyingEdges(labels, encoded);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
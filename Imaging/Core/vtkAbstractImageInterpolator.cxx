@@ -87,6 +87,8 @@ vtkAbstractImageInterpolator::vtkAbstractImageInterpolator()
   this->InterpolationFuncFloat = &(vtkInterpolateNOP<float>::InterpolationFunc);
   this->RowInterpolationFuncDouble = &(vtkInterpolateNOP<double>::RowInterpolationFunc);
   this->RowInterpolationFuncFloat = &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -725,6 +727,8 @@ void vtkAbstractImageInterpolator::Update()
     this->InterpolationFuncFloat = &(vtkInterpolateNOP<float>::InterpolationFunc);
     this->RowInterpolationFuncDouble = &(vtkInterpolateNOP<double>::RowInterpolationFunc);
     this->RowInterpolationFuncFloat = &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+    this->LineInterpolationFuncDouble = nullptr;
+    this->LineInterpolationFuncFloat = nullptr;
 
     return;
   }
@@ -801,6 +805,11 @@ void vtkAbstractImageInterpolator::Update()
   this->GetInterpolationFunc(&this->InterpolationFuncDouble);
   this->GetInterpolationFunc(&this->InterpolationFuncFloat);
 
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncDouble);
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncFloat);
+
   if (this->SlidingWindow)
   {
     this->GetSlidingWindowFunc(&this->RowInterpolationFuncDouble);
@@ -888,6 +897,58 @@ void vtkAbstractImageInterpolator::GetInterpolationFunc(
 {
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const double origin[3], const double axis[3], int idX, int n, double* value)
+{
+  if (this->LineInterpolationFuncDouble)
+  {
+    this->LineInterpolationFuncDouble(this->InterpolationInfo, origin, axis, idX, n, value);
+    return;
+  }
+
+  int numscalars = this->InterpolationInfo->NumberOfComponents;
+  for (int i = idX; i < idX + n; i++)
+  {
+    const double point[3] = { origin[0] + i * axis[0], origin[1] + i * axis[1],
+      origin[2] + i * axis[2] };
+    this->InterpolationFuncDouble(this->InterpolationInfo, point, value);
+    value += numscalars;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const float origin[3], const float axis[3], int idX, int n, float* value)
+{
+  if (this->LineInterpolationFuncFloat)
+  {
+    this->LineInterpolationFuncFloat(this->InterpolationInfo, origin, axis, idX, n, value);
+    return;
+  }
+
+  int numscalars = this->InterpolationInfo->NumberOfComponents;
+  for (int i = idX; i < idX + n; i++)
+  {
+    const float point[3] = { origin[0] + i * axis[0], origin[1] + i * axis[1],
+      origin[2] + i * axis[2] };
+    this->InterpolationFuncFloat(this->InterpolationInfo, point, value);
+    value += numscalars;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(vtkInterpolationInfo*, const double[3], const double[3], int, int, double*))
+{
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(vtkInterpolationInfo*, const float[3], const float[3], int, int, float*))
+{
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::GetRowInterpolationFunc(
   void (**)(vtkInterpolationWeights*, int, int, int, double*, int))
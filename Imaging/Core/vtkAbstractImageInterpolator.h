@@ -148,6 +148,22 @@ public:
   bool CheckBoundsIJK(const float x[3]);
   ///@}
 
+  ///@{
+  /**
+   * Interpolate at the n structured coords origin + i*axis, for i from
+   * idX to idX + n - 1, and store the samples one after the other in
+   * value.  This gives the same samples as calling InterpolateIJK() for
+   * each point, but the interpolator can choose its code path once for
+   * the whole line instead of once for every point, which helps oblique
+   * sampling where the weights cannot be precomputed for the output
+   * extent.  The points should be checked with CheckBoundsIJK() beforehand.
+   */
+  void InterpolateLineIJK(
+    const double origin[3], const double axis[3], int idX, int n, double* value);
+  void InterpolateLineIJK(
+    const float origin[3], const float axis[3], int idX, int n, float* value);
+  ///@}
+
   ///@{
   /**
    * The border mode (default: clamp).  This controls how out-of-bounds
@@ -304,6 +320,19 @@ protected:
     void (**floatfunc)(vtkInterpolationWeights*, int, int, int, float*, int));
   ///@}
 
+  ///@{
+  /**
+   * Get the line interpolation functions.  The default sets them to
+   * nullptr, in which case InterpolateLineIJK() calls the interpolation
+   * function for each point of the line.
+   */
+  virtual void GetLineInterpolationFunc(
+    void (**doublefunc)(
+      vtkInterpolationInfo*, const double[3], const double[3], int, int, double*));
+  virtual void GetLineInterpolationFunc(
+    void (**floatfunc)(vtkInterpolationInfo*, const float[3], const float[3], int, int, float*));
+  ///@}
+
   vtkDataArray* Scalars;
   double StructuredBoundsDouble[6];
   float StructuredBoundsFloat[6];
@@ -332,6 +361,11 @@ protected:
   void (*RowInterpolationFuncFloat)(
     vtkInterpolationWeights* weights, int idX, int idY, int idZ, float* outPtr, int n);
 
+  void (*LineInterpolationFuncDouble)(vtkInterpolationInfo* info, const double origin[3],
+    const double axis[3], int idX, int n, double* outPtr);
+  void (*LineInterpolationFuncFloat)(vtkInterpolationInfo* info, const float origin[3],
+    const float axis[3], int idX, int n, float* outPtr);
+
 private:
   vtkAbstractImageInterpolator(const vtkAbstractImageInterpolator&) = delete;
   void operator=(const vtkAbstractImageInterpolator&) = delete;
@@ -886,6 +886,8 @@ void vtkGenericImageInterpolator::Update()
     this->InterpolationFuncFloat = &(vtkInterpolateNOP<float>::InterpolationFunc);
     this->RowInterpolationFuncDouble = &(vtkInterpolateNOP<double>::RowInterpolationFunc);
     this->RowInterpolationFuncFloat = &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+    this->LineInterpolationFuncDouble = nullptr;
+    this->LineInterpolationFuncFloat = nullptr;
 
     return;
   }
@@ -966,5 +968,10 @@ void vtkGenericImageInterpolator::Update()
   this->GetSlidingWindowFunc(&this->RowInterpolationFuncFloat);
   this->GetRowInterpolationFunc(&this->RowInterpolationFuncDouble);
   this->GetRowInterpolationFunc(&this->RowInterpolationFuncFloat);
+
+  // the line functions of the superclass also rely on GetVoidPointer(),
+  // so lines are interpolated one point at a time
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
 }
 VTK_ABI_NAMESPACE_END
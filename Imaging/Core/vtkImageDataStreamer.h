@@ -7,6 +7,14 @@
  * To satisfy a request, this filter calls update on its input
  * many times with smaller update extents.  All processing up stream
  * streams smaller pieces.
+ *
+ * The pieces are assembled into an output that holds the whole update
+ * extent.  To write an image that is too large to be held in memory, set
+ * the NumberOfStreamDivisions of the image writer instead, which writes
+ * each piece to the file as soon as it has been generated.
+ *
+ * @sa
+ * vtkImageWriter
  */
 
 #ifndef vtkImageDataStreamer_h
@@ -8,6 +8,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkTypeTraits.h"
 
+#include <algorithm>
+
 #include "vtkTemplateAliasMacro.h"
 // turn off 64-bit ints when templating over all types, because
 // they cannot be faithfully represented by doubles
@@ -142,6 +144,29 @@ void vtkImageInterpolator::InternalUpdate()
 namespace
 {
 
+//------------------------------------------------------------------------------
+// Border handling as types, so that the border mode can be chosen once for
+// a whole line of points rather than once for every point.
+struct vtkImageBorderClamp
+{
+  static int Index(int a, int b, int c) { return vtkInterpolationMath::Clamp(a, b, c); }
+};
+
+struct vtkImageBorderRepeat
+{
+  static int Index(int a, int b, int c) { return vtkInterpolationMath::Wrap(a, b, c); }
+};
+
+struct vtkImageBorderMirror
+{
+  static int Index(int a, int b, int c) { return vtkInterpolationMath::Mirror(a, b, c); }
+};
+
+// The line functions compute the offsets and the weights of a block of this
+// many points first, in a loop that does not read the image, and then read
+// and combine the samples of the block.
+const int vtkImageLineBlockSize = 64;
+
 //------------------------------------------------------------------------------
 template <class F, class T>
 struct vtkImageNLCInterpolate
@@ -151,41 +176,63 @@ struct vtkImageNLCInterpolate
   static void Trilinear(vtkInterpolationInfo* info, const F point[3], F* outPtr);
 
   static void Tricubic(vtkInterpolationInfo* info, const F point[3], F* outPtr);
+
+  // interpolate at one point, with the border mode given by B
+  template <class B>
+  static void NearestPoint(vtkInterpolationInfo* info, const F point[3], F* outPtr);
+
+  template <class B>
+  static void TrilinearPoint(vtkInterpolationInfo* info, const F point[3], F* outPtr);
+
+  template <class B>
+  static void TricubicPoint(vtkInterpolationInfo* info, const F point[3], F* outPtr);
+
+  // interpolate at the points origin + i*axis for i in [idX, idX + n)
+  template <class B>
+  static void NearestLine(vtkInterpolationInfo* info, const F origin[3], const F axis[3],
+    int idX, int n, F* outPtr);
+
+  template <class B>
+  static void TrilinearLine(vtkInterpolationInfo* info, const F origin[3], const F axis[3],
+    int idX, int n, F* outPtr);
+
+  template <class B>
+  static void TricubicLine(vtkInterpolationInfo* info, const F origin[3], const F axis[3],
+    int idX, int n, F* outPtr);
 };
 
 //------------------------------------------------------------------------------
 template <class F, class T>
 void vtkImageNLCInterpolate<F, T>::Nearest(vtkInterpolationInfo* info, const F point[3], F* outPtr)
 {
-  const T* inPtr = static_cast<const T*>(info->Pointer);
-  int* inExt = info->Extent;
-  vtkIdType* inInc = info->Increments;
-  int numscalars = info->NumberOfComponents;
-
-  int inIdX0 = vtkInterpolationMath::Round(point[0]);
-  int inIdY0 = vtkInterpolationMath::Round(point[1]);
-  int inIdZ0 = vtkInterpolationMath::Round(point[2]);
-
   switch (info->BorderMode)
   {
     case VTK_IMAGE_BORDER_REPEAT:
-      inIdX0 = vtkInterpolationMath::Wrap(inIdX0, inExt[0], inExt[1]);
-      inIdY0 = vtkInterpolationMath::Wrap(inIdY0, inExt[2], inExt[3]);
-      inIdZ0 = vtkInterpolationMath::Wrap(inIdZ0, inExt[4], inExt[5]);
+      NearestPoint<vtkImageBorderRepeat>(info, point, outPtr);
       break;
-
     case VTK_IMAGE_BORDER_MIRROR:
-      inIdX0 = vtkInterpolationMath::Mirror(inIdX0, inExt[0], inExt[1]);
-      inIdY0 = vtkInterpolationMath::Mirror(inIdY0, inExt[2], inExt[3]);
-      inIdZ0 = vtkInterpolationMath::Mirror(inIdZ0, inExt[4], inExt[5]);
+      NearestPoint<vtkImageBorderMirror>(info, point, outPtr);
       break;
-
     default:
-      inIdX0 = vtkInterpolationMath::Clamp(inIdX0, inExt[0], inExt[1]);
-      inIdY0 = vtkInterpolationMath::Clamp(inIdY0, inExt[2], inExt[3]);
-      inIdZ0 = vtkInterpolationMath::Clamp(inIdZ0, inExt[4], inExt[5]);
+      NearestPoint<vtkImageBorderClamp>(info, point, outPtr);
       break;
   }
+}
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+template <class B>
+inline void vtkImageNLCInterpolate<F, T>::NearestPoint(
+  vtkInterpolationInfo* info, const F point[3], F* outPtr)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  int* inExt = info->Extent;
+  vtkIdType* inInc = info->Increments;
+  int numscalars = info->NumberOfComponents;
+
+  int inIdX0 = B::Index(vtkInterpolationMath::Round(point[0]), inExt[0], inExt[1]);
+  int inIdY0 = B::Index(vtkInterpolationMath::Round(point[1]), inExt[2], inExt[3]);
+  int inIdZ0 = B::Index(vtkInterpolationMath::Round(point[2]), inExt[4], inExt[5]);
 
   inPtr += inIdX0 * inInc[0] + inIdY0 * inInc[1] + inIdZ0 * inInc[2];
   do
@@ -194,10 +241,67 @@ void vtkImageNLCInterpolate<F, T>::Nearest(vtkInterpolationInfo* info, const F p
   } while (--numscalars);
 }
 
+//------------------------------------------------------------------------------
+template <class F, class T>
+template <class B>
+void vtkImageNLCInterpolate<F, T>::NearestLine(vtkInterpolationInfo* info, const F origin[3],
+  const F axis[3], int idX, int n, F* outPtr)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  const int* inExt = info->Extent;
+  const vtkIdType inInc[3] = { info->Increments[0], info->Increments[1], info->Increments[2] };
+  const int numscalars = info->NumberOfComponents;
+
+  vtkIdType offsets[vtkImageLineBlockSize];
+  for (int i0 = idX; i0 < idX + n; i0 += vtkImageLineBlockSize)
+  {
+    const int m = std::min(vtkImageLineBlockSize, idX + n - i0);
+    for (int j = 0; j < m; j++)
+    {
+      const int i = i0 + j;
+      const F point[3] = { origin[0] + i * axis[0], origin[1] + i * axis[1],
+        origin[2] + i * axis[2] };
+      offsets[j] = B::Index(vtkInterpolationMath::Round(point[0]), inExt[0], inExt[1]) * inInc[0] +
+        B::Index(vtkInterpolationMath::Round(point[1]), inExt[2], inExt[3]) * inInc[1] +
+        B::Index(vtkInterpolationMath::Round(point[2]), inExt[4], inExt[5]) * inInc[2];
+    }
+
+    for (int j = 0; j < m; j++)
+    {
+      const T* tmpPtr = inPtr + offsets[j];
+      int c = numscalars;
+      do
+      {
+        *outPtr++ = *tmpPtr++;
+      } while (--c);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 template <class F, class T>
 void vtkImageNLCInterpolate<F, T>::Trilinear(
   vtkInterpolationInfo* info, const F point[3], F* outPtr)
+{
+  switch (info->BorderMode)
+  {
+    case VTK_IMAGE_BORDER_REPEAT:
+      TrilinearPoint<vtkImageBorderRepeat>(info, point, outPtr);
+      break;
+    case VTK_IMAGE_BORDER_MIRROR:
+      TrilinearPoint<vtkImageBorderMirror>(info, point, outPtr);
+      break;
+    default:
+      TrilinearPoint<vtkImageBorderClamp>(info, point, outPtr);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+template <class B>
+inline void vtkImageNLCInterpolate<F, T>::TrilinearPoint(
+  vtkInterpolationInfo* info, const F point[3], F* outPtr)
 {
   const T* inPtr = static_cast<const T*>(info->Pointer);
   int* inExt = info->Extent;
@@ -213,38 +317,13 @@ void vtkImageNLCInterpolate<F, T>::Trilinear(
   int inIdY1 = inIdY0 + (fy != 0);
   int inIdZ1 = inIdZ0 + (fz != 0);
 
-  switch (info->BorderMode)
-  {
-    case VTK_IMAGE_BORDER_REPEAT:
-      inIdX0 = vtkInterpolationMath::Wrap(inIdX0, inExt[0], inExt[1]);
-      inIdY0 = vtkInterpolationMath::Wrap(inIdY0, inExt[2], inExt[3]);
-      inIdZ0 = vtkInterpolationMath::Wrap(inIdZ0, inExt[4], inExt[5]);
-
-      inIdX1 = vtkInterpolationMath::Wrap(inIdX1, inExt[0], inExt[1]);
-      inIdY1 = vtkInterpolationMath::Wrap(inIdY1, inExt[2], inExt[3]);
-      inIdZ1 = vtkInterpolationMath::Wrap(inIdZ1, inExt[4], inExt[5]);
-      break;
-
-    case VTK_IMAGE_BORDER_MIRROR:
-      inIdX0 = vtkInterpolationMath::Mirror(inIdX0, inExt[0], inExt[1]);
-      inIdY0 = vtkInterpolationMath::Mirror(inIdY0, inExt[2], inExt[3]);
-      inIdZ0 = vtkInterpolationMath::Mirror(inIdZ0, inExt[4], inExt[5]);
-
-      inIdX1 = vtkInterpolationMath::Mirror(inIdX1, inExt[0], inExt[1]);
-      inIdY1 = vtkInterpolationMath::Mirror(inIdY1, inExt[2], inExt[3]);
-      inIdZ1 = vtkInterpolationMath::Mirror(inIdZ1, inExt[4], inExt[5]);
-      break;
+  inIdX0 = B::Index(inIdX0, inExt[0], inExt[1]);
+  inIdY0 = B::Index(inIdY0, inExt[2], inExt[3]);
+  inIdZ0 = B::Index(inIdZ0, inExt[4], inExt[5]);
 
-    default:
-      inIdX0 = vtkInterpolationMath::Clamp(inIdX0, inExt[0], inExt[1]);
-      inIdY0 = vtkInterpolationMath::Clamp(inIdY0, inExt[2], inExt[3]);
-      inIdZ0 = vtkInterpolationMath::Clamp(inIdZ0, inExt[4], inExt[5]);
-
-      inIdX1 = vtkInterpolationMath::Clamp(inIdX1, inExt[0], inExt[1]);
-      inIdY1 = vtkInterpolationMath::Clamp(inIdY1, inExt[2], inExt[3]);
-      inIdZ1 = vtkInterpolationMath::Clamp(inIdZ1, inExt[4], inExt[5]);
-      break;
-  }
+  inIdX1 = B::Index(inIdX1, inExt[0], inExt[1]);
+  inIdY1 = B::Index(inIdY1, inExt[2], inExt[3]);
+  inIdZ1 = B::Index(inIdZ1, inExt[4], inExt[5]);
 
   vtkIdType factX0 = inIdX0 * inInc[0];
   vtkIdType factX1 = inIdX1 * inInc[0];
@@ -280,6 +359,87 @@ void vtkImageNLCInterpolate<F, T>::Trilinear(
   } while (--numscalars);
 }
 
+//------------------------------------------------------------------------------
+template <class F, class T>
+template <class B>
+void vtkImageNLCInterpolate<F, T>::TrilinearLine(vtkInterpolationInfo* info, const F origin[3],
+  const F axis[3], int idX, int n, F* outPtr)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  const int* inExt = info->Extent;
+  const vtkIdType inInc[3] = { info->Increments[0], info->Increments[1], info->Increments[2] };
+  const int numscalars = info->NumberOfComponents;
+
+  // the offsets of the two x samples and of the four yz rows, and the
+  // fractional offsets, for each point of the block
+  vtkIdType factX[2][vtkImageLineBlockSize];
+  vtkIdType factYZ[4][vtkImageLineBlockSize];
+  F fX[vtkImageLineBlockSize], fY[vtkImageLineBlockSize], fZ[vtkImageLineBlockSize];
+
+  for (int i0 = idX; i0 < idX + n; i0 += vtkImageLineBlockSize)
+  {
+    const int m = std::min(vtkImageLineBlockSize, idX + n - i0);
+    for (int j = 0; j < m; j++)
+    {
+      const int i = i0 + j;
+      const F point[3] = { origin[0] + i * axis[0], origin[1] + i * axis[1],
+        origin[2] + i * axis[2] };
+      F fx, fy, fz;
+      const int inIdX0 = vtkInterpolationMath::Floor(point[0], fx);
+      const int inIdY0 = vtkInterpolationMath::Floor(point[1], fy);
+      const int inIdZ0 = vtkInterpolationMath::Floor(point[2], fz);
+
+      factX[0][j] = B::Index(inIdX0, inExt[0], inExt[1]) * inInc[0];
+      factX[1][j] = B::Index(inIdX0 + (fx != 0), inExt[0], inExt[1]) * inInc[0];
+      const vtkIdType factY0 = B::Index(inIdY0, inExt[2], inExt[3]) * inInc[1];
+      const vtkIdType factY1 = B::Index(inIdY0 + (fy != 0), inExt[2], inExt[3]) * inInc[1];
+      const vtkIdType factZ0 = B::Index(inIdZ0, inExt[4], inExt[5]) * inInc[2];
+      const vtkIdType factZ1 = B::Index(inIdZ0 + (fz != 0), inExt[4], inExt[5]) * inInc[2];
+      factYZ[0][j] = factY0 + factZ0;
+      factYZ[1][j] = factY0 + factZ1;
+      factYZ[2][j] = factY1 + factZ0;
+      factYZ[3][j] = factY1 + factZ1;
+      fX[j] = fx;
+      fY[j] = fy;
+      fZ[j] = fz;
+    }
+
+    for (int j = 0; j < m; j++)
+    {
+      const F fx = fX[j];
+      const F fy = fY[j];
+      const F fz = fZ[j];
+      const F rx = 1 - fx;
+      const F ry = 1 - fy;
+      const F rz = 1 - fz;
+
+      const F ryrz = ry * rz;
+      const F fyrz = fy * rz;
+      const F ryfz = ry * fz;
+      const F fyfz = fy * fz;
+
+      const vtkIdType i00 = factYZ[0][j];
+      const vtkIdType i01 = factYZ[1][j];
+      const vtkIdType i10 = factYZ[2][j];
+      const vtkIdType i11 = factYZ[3][j];
+
+      const T* inPtr0 = inPtr + factX[0][j];
+      const T* inPtr1 = inPtr + factX[1][j];
+      int c = numscalars;
+      do
+      {
+        *outPtr++ =
+          (rx * (ryrz * inPtr0[i00] + ryfz * inPtr0[i01] + fyrz * inPtr0[i10] +
+                  fyfz * inPtr0[i11]) +
+            fx * (ryrz * inPtr1[i00] + ryfz * inPtr1[i01] + fyrz * inPtr1[i10] +
+                   fyfz * inPtr1[i11]));
+        inPtr0++;
+        inPtr1++;
+      } while (--c);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // cubic helper function: set up the lookup indices and the interpolation
 // coefficients
@@ -303,6 +463,26 @@ inline void vtkTricubicInterpWeights(T F[4], T f)
 // tricubic interpolation
 template <class F, class T>
 void vtkImageNLCInterpolate<F, T>::Tricubic(vtkInterpolationInfo* info, const F point[3], F* outPtr)
+{
+  switch (info->BorderMode)
+  {
+    case VTK_IMAGE_BORDER_REPEAT:
+      TricubicPoint<vtkImageBorderRepeat>(info, point, outPtr);
+      break;
+    case VTK_IMAGE_BORDER_MIRROR:
+      TricubicPoint<vtkImageBorderMirror>(info, point, outPtr);
+      break;
+    default:
+      TricubicPoint<vtkImageBorderClamp>(info, point, outPtr);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+template <class B>
+inline void vtkImageNLCInterpolate<F, T>::TricubicPoint(
+  vtkInterpolationInfo* info, const F point[3], F* outPtr)
 {
   const T* inPtr = static_cast<const T*>(info->Pointer);
   int* inExt = info->Extent;
@@ -328,59 +508,11 @@ void vtkImageNLCInterpolate<F, T>::Tricubic(vtkInterpolationInfo* info, const F
 
   // the memory offsets
   vtkIdType factX[4], factY[4], factZ[4];
-
-  switch (info->BorderMode)
+  for (int l = 0; l < 4; l++)
   {
-    case VTK_IMAGE_BORDER_REPEAT:
-      factX[0] = vtkInterpolationMath::Wrap(inIdX0 - 1, minX, maxX) * inIncX;
-      factX[1] = vtkInterpolationMath::Wrap(inIdX0, minX, maxX) * inIncX;
-      factX[2] = vtkInterpolationMath::Wrap(inIdX0 + 1, minX, maxX) * inIncX;
-      factX[3] = vtkInterpolationMath::Wrap(inIdX0 + 2, minX, maxX) * inIncX;
-
-      factY[0] = vtkInterpolationMath::Wrap(inIdY0 - 1, minY, maxY) * inIncY;
-      factY[1] = vtkInterpolationMath::Wrap(inIdY0, minY, maxY) * inIncY;
-      factY[2] = vtkInterpolationMath::Wrap(inIdY0 + 1, minY, maxY) * inIncY;
-      factY[3] = vtkInterpolationMath::Wrap(inIdY0 + 2, minY, maxY) * inIncY;
-
-      factZ[0] = vtkInterpolationMath::Wrap(inIdZ0 - 1, minZ, maxZ) * inIncZ;
-      factZ[1] = vtkInterpolationMath::Wrap(inIdZ0, minZ, maxZ) * inIncZ;
-      factZ[2] = vtkInterpolationMath::Wrap(inIdZ0 + 1, minZ, maxZ) * inIncZ;
-      factZ[3] = vtkInterpolationMath::Wrap(inIdZ0 + 2, minZ, maxZ) * inIncZ;
-      break;
-
-    case VTK_IMAGE_BORDER_MIRROR:
-      factX[0] = vtkInterpolationMath::Mirror(inIdX0 - 1, minX, maxX) * inIncX;
-      factX[1] = vtkInterpolationMath::Mirror(inIdX0, minX, maxX) * inIncX;
-      factX[2] = vtkInterpolationMath::Mirror(inIdX0 + 1, minX, maxX) * inIncX;
-      factX[3] = vtkInterpolationMath::Mirror(inIdX0 + 2, minX, maxX) * inIncX;
-
-      factY[0] = vtkInterpolationMath::Mirror(inIdY0 - 1, minY, maxY) * inIncY;
-      factY[1] = vtkInterpolationMath::Mirror(inIdY0, minY, maxY) * inIncY;
-      factY[2] = vtkInterpolationMath::Mirror(inIdY0 + 1, minY, maxY) * inIncY;
-      factY[3] = vtkInterpolationMath::Mirror(inIdY0 + 2, minY, maxY) * inIncY;
-
-      factZ[0] = vtkInterpolationMath::Mirror(inIdZ0 - 1, minZ, maxZ) * inIncZ;
-      factZ[1] = vtkInterpolationMath::Mirror(inIdZ0, minZ, maxZ) * inIncZ;
-      factZ[2] = vtkInterpolationMath::Mirror(inIdZ0 + 1, minZ, maxZ) * inIncZ;
-      factZ[3] = vtkInterpolationMath::Mirror(inIdZ0 + 2, minZ, maxZ) * inIncZ;
-      break;
-
-    default:
-      factX[0] = vtkInterpolationMath::Clamp(inIdX0 - 1, minX, maxX) * inIncX;
-      factX[1] = vtkInterpolationMath::Clamp(inIdX0, minX, maxX) * inIncX;
-      factX[2] = vtkInterpolationMath::Clamp(inIdX0 + 1, minX, maxX) * inIncX;
-      factX[3] = vtkInterpolationMath::Clamp(inIdX0 + 2, minX, maxX) * inIncX;
-
-      factY[0] = vtkInterpolationMath::Clamp(inIdY0 - 1, minY, maxY) * inIncY;
-      factY[1] = vtkInterpolationMath::Clamp(inIdY0, minY, maxY) * inIncY;
-      factY[2] = vtkInterpolationMath::Clamp(inIdY0 + 1, minY, maxY) * inIncY;
-      factY[3] = vtkInterpolationMath::Clamp(inIdY0 + 2, minY, maxY) * inIncY;
-
-      factZ[0] = vtkInterpolationMath::Clamp(inIdZ0 - 1, minZ, maxZ) * inIncZ;
-      factZ[1] = vtkInterpolationMath::Clamp(inIdZ0, minZ, maxZ) * inIncZ;
-      factZ[2] = vtkInterpolationMath::Clamp(inIdZ0 + 1, minZ, maxZ) * inIncZ;
-      factZ[3] = vtkInterpolationMath::Clamp(inIdZ0 + 2, minZ, maxZ) * inIncZ;
-      break;
+    factX[l] = B::Index(inIdX0 + l - 1, minX, maxX) * inIncX;
+    factY[l] = B::Index(inIdY0 + l - 1, minY, maxY) * inIncY;
+    factZ[l] = B::Index(inIdZ0 + l - 1, minZ, maxZ) * inIncZ;
   }
 
   // get the interpolation coefficients
@@ -441,6 +573,103 @@ void vtkImageNLCInterpolate<F, T>::Tricubic(vtkInterpolationInfo* info, const F
   } while (--numscalars);
 }
 
+//------------------------------------------------------------------------------
+template <class F, class T>
+template <class B>
+void vtkImageNLCInterpolate<F, T>::TricubicLine(vtkInterpolationInfo* info, const F origin[3],
+  const F axis[3], int idX, int n, F* outPtr)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  const int* inExt = info->Extent;
+  const vtkIdType inInc[3] = { info->Increments[0], info->Increments[1], info->Increments[2] };
+  const int numscalars = info->NumberOfComponents;
+
+  // check if only one slice in a particular direction
+  const int multipleY0 = (inExt[2] != inExt[3]);
+  const int multipleZ0 = (inExt[4] != inExt[5]);
+
+  // the offsets and the weights of the four samples along each axis, and
+  // the y and z limits, for each point of the block
+  vtkIdType factX[vtkImageLineBlockSize][4];
+  vtkIdType factY[vtkImageLineBlockSize][4];
+  vtkIdType factZ[vtkImageLineBlockSize][4];
+  F fX[vtkImageLineBlockSize][4], fY[vtkImageLineBlockSize][4], fZ[vtkImageLineBlockSize][4];
+  int multipleY[vtkImageLineBlockSize], multipleZ[vtkImageLineBlockSize];
+
+  for (int i0 = idX; i0 < idX + n; i0 += vtkImageLineBlockSize)
+  {
+    const int m = std::min(vtkImageLineBlockSize, idX + n - i0);
+    for (int j = 0; j < m; j++)
+    {
+      const int i = i0 + j;
+      const F point[3] = { origin[0] + i * axis[0], origin[1] + i * axis[1],
+        origin[2] + i * axis[2] };
+      F fx, fy, fz;
+      const int inIdX0 = vtkInterpolationMath::Floor(point[0], fx);
+      const int inIdY0 = vtkInterpolationMath::Floor(point[1], fy);
+      const int inIdZ0 = vtkInterpolationMath::Floor(point[2], fz);
+
+      for (int l = 0; l < 4; l++)
+      {
+        factX[j][l] = B::Index(inIdX0 + l - 1, inExt[0], inExt[1]) * inInc[0];
+        factY[j][l] = B::Index(inIdY0 + l - 1, inExt[2], inExt[3]) * inInc[1];
+        factZ[j][l] = B::Index(inIdZ0 + l - 1, inExt[4], inExt[5]) * inInc[2];
+      }
+
+      vtkTricubicInterpWeights(fX[j], fx);
+      vtkTricubicInterpWeights(fY[j], fy);
+      vtkTricubicInterpWeights(fZ[j], fz);
+
+      // if only one coefficient will be used
+      multipleY[j] = multipleY0 & (fy != 0);
+      multipleZ[j] = multipleZ0 & (fz != 0);
+      if (multipleY[j] == 0)
+      {
+        fY[j][1] = 1;
+      }
+      if (multipleZ[j] == 0)
+      {
+        fZ[j][1] = 1;
+      }
+    }
+
+    for (int j = 0; j < m; j++)
+    {
+      const int j1 = 1 - multipleY[j];
+      const int j2 = 1 + 2 * multipleY[j];
+      const int k1 = 1 - multipleZ[j];
+      const int k2 = 1 + 2 * multipleZ[j];
+      const vtkIdType* fxj = factX[j];
+      const F* wx = fX[j];
+
+      const T* tmpInPtr = inPtr;
+      int c = numscalars;
+      do // loop over components
+      {
+        F val = 0;
+        int k = k1;
+        do // loop over z
+        {
+          const F ifz = fZ[j][k];
+          const vtkIdType factz = factZ[j][k];
+          int jj = j1;
+          do // loop over y
+          {
+            const F fzy = ifz * fY[j][jj];
+            const T* tmpPtr = tmpInPtr + factz + factY[j][jj];
+            val += fzy *
+              (wx[0] * tmpPtr[fxj[0]] + wx[1] * tmpPtr[fxj[1]] + wx[2] * tmpPtr[fxj[2]] +
+                wx[3] * tmpPtr[fxj[3]]);
+          } while (++jj <= j2);
+        } while (++k <= k2);
+
+        *outPtr++ = val;
+        tmpInPtr++;
+      } while (--c);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // Get the interpolation function for the specified data types
 template <class F>
@@ -476,6 +705,69 @@ void vtkImageInterpolatorGetInterpolationFunc(
   }
 }
 
+//------------------------------------------------------------------------------
+// Get the line interpolation function for the specified data types
+template <class F, class B>
+void vtkImageInterpolatorGetLineInterpolationFunc(
+  void (**interpolate)(vtkInterpolationInfo*, const F[3], const F[3], int, int, F*),
+  int dataType, int interpolationMode)
+{
+  switch (interpolationMode)
+  {
+    case VTK_NEAREST_INTERPOLATION:
+      switch (dataType)
+      {
+        vtkTemplateAliasMacro(
+          *interpolate = &(vtkImageNLCInterpolate<F, VTK_TT>::template NearestLine<B>));
+        default:
+          *interpolate = nullptr;
+      }
+      break;
+    case VTK_LINEAR_INTERPOLATION:
+      switch (dataType)
+      {
+        vtkTemplateAliasMacro(
+          *interpolate = &(vtkImageNLCInterpolate<F, VTK_TT>::template TrilinearLine<B>));
+        default:
+          *interpolate = nullptr;
+      }
+      break;
+    case VTK_CUBIC_INTERPOLATION:
+      switch (dataType)
+      {
+        vtkTemplateAliasMacro(
+          *interpolate = &(vtkImageNLCInterpolate<F, VTK_TT>::template TricubicLine<B>));
+        default:
+          *interpolate = nullptr;
+      }
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Choose the line interpolation function for the border mode
+template <class F>
+void vtkImageInterpolatorGetLineInterpolationFunc(
+  void (**interpolate)(vtkInterpolationInfo*, const F[3], const F[3], int, int, F*),
+  int dataType, int interpolationMode, int borderMode)
+{
+  switch (borderMode)
+  {
+    case VTK_IMAGE_BORDER_REPEAT:
+      vtkImageInterpolatorGetLineInterpolationFunc<F, vtkImageBorderRepeat>(
+        interpolate, dataType, interpolationMode);
+      break;
+    case VTK_IMAGE_BORDER_MIRROR:
+      vtkImageInterpolatorGetLineInterpolationFunc<F, vtkImageBorderMirror>(
+        interpolate, dataType, interpolationMode);
+      break;
+    default:
+      vtkImageInterpolatorGetLineInterpolationFunc<F, vtkImageBorderClamp>(
+        interpolate, dataType, interpolationMode);
+      break;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Interpolation for precomputed weights
 
@@ -1027,6 +1319,22 @@ void vtkImageInterpolator::GetRowInterpolationFunc(
     func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
 }
 
+//------------------------------------------------------------------------------
+void vtkImageInterpolator::GetLineInterpolationFunc(
+  void (**func)(vtkInterpolationInfo*, const double[3], const double[3], int, int, double*))
+{
+  vtkImageInterpolatorGetLineInterpolationFunc(func, this->InterpolationInfo->ScalarType,
+    this->InterpolationMode, this->InterpolationInfo->BorderMode);
+}
+
+//------------------------------------------------------------------------------
+void vtkImageInterpolator::GetLineInterpolationFunc(
+  void (**func)(vtkInterpolationInfo*, const float[3], const float[3], int, int, float*))
+{
+  vtkImageInterpolatorGetLineInterpolationFunc(func, this->InterpolationInfo->ScalarType,
+    this->InterpolationMode, this->InterpolationInfo->BorderMode);
+}
+
 //------------------------------------------------------------------------------
 void vtkImageInterpolator::PrecomputeWeightsForExtent(
   const double matrix[16], const int extent[6], int newExtent[6], vtkInterpolationWeights*& weights)
@@ -96,6 +96,7 @@ vtkImageReslice::vtkImageReslice()
   this->SlabSliceSpacingFraction = 1.0;
 
   this->Optimization = 1; // turn off when you're paranoid
+  this->SinglePrecision = 0;
 
   // for rescaling the data
   this->ScalarShift = 0.0;
@@ -227,6 +228,7 @@ void vtkImageReslice::PrintSelf(ostream& os, vtkIndent indent)
      << "SlabTrapezoidIntegration: " << (this->SlabTrapezoidIntegration ? "On\n" : "Off\n");
   os << indent << "SlabSliceSpacingFraction: " << this->SlabSliceSpacingFraction << "\n";
   os << indent << "Optimization: " << (this->Optimization ? "On\n" : "Off\n");
+  os << indent << "SinglePrecision: " << (this->SinglePrecision ? "On\n" : "Off\n");
   os << indent << "ScalarShift: " << this->ScalarShift << "\n";
   os << indent << "ScalarScale: " << this->ScalarScale << "\n";
   os << indent << "BackgroundColor: " << this->BackgroundColor[0] << " " << this->BackgroundColor[1]
@@ -2016,6 +2018,11 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
     optimizeNearest = true;
   }
 
+  // for an affine matrix with a single sample per voxel, the samples of each
+  // row lie on a line, so the bounds are checked first and then each run of
+  // in-bounds samples is interpolated with one call to the interpolator
+  bool lineMode = (nsamples == 1 && !perspective && !newtrans);
+
   // get pixel information
   int scalarType = outData->GetScalarType();
   int scalarSize = outData->GetScalarSize();
@@ -2177,10 +2184,13 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
 
               if (interpolator->CheckBoundsIJK(inPoint))
               {
-                // do the interpolation
+                // do the interpolation, or defer it if in line mode
                 sampleCount++;
                 isInBounds = true;
-                interpolator->InterpolateIJK(inPoint, tmpPtr);
+                if (!lineMode)
+                {
+                  interpolator->InterpolateIJK(inPoint, tmpPtr);
+                }
                 tmpPtr += inComponents;
               }
             }
@@ -2202,6 +2212,12 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
 
           if (wasInBounds)
           {
+            if (lineMode)
+            {
+              interpolator->InterpolateLineIJK(
+                inPoint1, xAxis, startIdX, numpixels, tmpPtr - inComponents * (idX - startIdX));
+            }
+
             if (outputStencil)
             {
               outputStencil->InsertNextExtent(startIdX, endIdX, idY, idZ);
@@ -3274,30 +3290,48 @@ void vtkImageReslice::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
   vtkAbstractTransform* newtrans = this->OptimizedTransform;
 
   vtkImageResliceFloatingPointType newmat[4][4];
+  float newmatf[4][4];
   for (int i = 0; i < 4; i++)
   {
-    newmat[i][0] = matrix->GetElement(i, 0);
-    newmat[i][1] = matrix->GetElement(i, 1);
-    newmat[i][2] = matrix->GetElement(i, 2);
-    newmat[i][3] = matrix->GetElement(i, 3);
+    for (int j = 0; j < 4; j++)
+    {
+      newmat[i][j] = matrix->GetElement(i, j);
+      newmatf[i][j] = static_cast<float>(newmat[i][j]);
+    }
   }
 
+  vtkImageResliceConvertScalarsType convertScalars =
+    (this->HasConvertScalars ? &vtkImageReslice::ConvertScalarsBase : nullptr);
+
   if (this->HitInputExtent == 0)
   {
     vtkImageResliceClearExecute(this, outData[0], outPtr, outExt, threadId);
   }
   else if (this->UsePermuteExecute)
   {
-    vtkReslicePermuteExecute(this, scalars, this->Interpolator, outData[0], outPtr,
-      this->ScalarShift, this->ScalarScale,
-      (this->HasConvertScalars ? &vtkImageReslice::ConvertScalarsBase : nullptr), outExt, threadId,
-      newmat);
+    if (this->SinglePrecision)
+    {
+      vtkReslicePermuteExecute(this, scalars, this->Interpolator, outData[0], outPtr,
+        this->ScalarShift, this->ScalarScale, convertScalars, outExt, threadId, newmatf);
+    }
+    else
+    {
+      vtkReslicePermuteExecute(this, scalars, this->Interpolator, outData[0], outPtr,
+        this->ScalarShift, this->ScalarScale, convertScalars, outExt, threadId, newmat);
+    }
   }
   else
   {
-    vtkImageResliceExecute(this, scalars, this->Interpolator, outData[0], outPtr, this->ScalarShift,
-      this->ScalarScale, (this->HasConvertScalars ? &vtkImageReslice::ConvertScalarsBase : nullptr),
-      outExt, threadId, newmat, newtrans);
+    if (this->SinglePrecision)
+    {
+      vtkImageResliceExecute(this, scalars, this->Interpolator, outData[0], outPtr,
+        this->ScalarShift, this->ScalarScale, convertScalars, outExt, threadId, newmatf, newtrans);
+    }
+    else
+    {
+      vtkImageResliceExecute(this, scalars, this->Interpolator, outData[0], outPtr,
+        this->ScalarShift, this->ScalarScale, convertScalars, outExt, threadId, newmat, newtrans);
+    }
   }
 }
 VTK_ABI_NAMESPACE_END
@@ -308,6 +308,19 @@ public:
   vtkBooleanMacro(Optimization, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Compute the sample positions and interpolate in single precision
+   * (default off).  This is faster, especially for oblique reslicing of
+   * large volumes, but the sample positions can be off by roughly 1e-7
+   * times the output extent, in voxels, which is small enough for most
+   * display purposes but not for exact resampling.
+   */
+  vtkSetMacro(SinglePrecision, vtkTypeBool);
+  vtkGetMacro(SinglePrecision, vtkTypeBool);
+  vtkBooleanMacro(SinglePrecision, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set a value to add to all the output voxels.
@@ -514,6 +527,7 @@ protected:
   vtkTypeBool Border;
   int InterpolationMode;
   vtkTypeBool Optimization;
+  vtkTypeBool SinglePrecision;
   int SlabMode;
   int SlabNumberOfSlices;
   vtkTypeBool SlabTrapezoidIntegration;
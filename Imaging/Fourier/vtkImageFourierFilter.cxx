@@ -3,14 +3,134 @@
 #include "vtkImageFourierFilter.h"
 
 #include "vtkMath.h"
+
+#include "vtk_kissfft.h"
+// clang-format off
+#include VTK_KISSFFT_HEADER(kiss_fft.h)
+#include VTK_KISSFFT_HEADER(tools/kiss_fftr.h)
+// clang-format on
+
+#include <algorithm>
 #include <cmath>
+#include <type_traits>
+#include <vector>
 
 /*=========================================================================
         Vectors of complex numbers.
 =========================================================================*/
 
-//------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// The kissfft plans of a thread. The plan of the last length used in each
+// direction is kept, since the rows of an axis all have the same length.
+class vtkImageFourierPlans
+{
+public:
+  ~vtkImageFourierPlans()
+  {
+    for (kiss_fft_cfg cfg : this->ComplexPlans)
+    {
+      kiss_fft_free(cfg);
+    }
+    kiss_fftr_free(this->RealPlan);
+  }
+
+  static vtkImageFourierPlans& GetLocal()
+  {
+    static VTK_THREAD_LOCAL vtkImageFourierPlans plans;
+    return plans;
+  }
+
+  kiss_fft_cfg GetComplexPlan(int N, bool inverse)
+  {
+    if (this->ComplexSizes[inverse] != N)
+    {
+      kiss_fft_free(this->ComplexPlans[inverse]);
+      this->ComplexPlans[inverse] = kiss_fft_alloc(N, inverse, nullptr, nullptr);
+      this->ComplexSizes[inverse] = N;
+    }
+    return this->ComplexPlans[inverse];
+  }
+
+  kiss_fftr_cfg GetRealPlan(int N)
+  {
+    if (this->RealSize != N)
+    {
+      kiss_fftr_free(this->RealPlan);
+      this->RealPlan = kiss_fftr_alloc(N, 0, nullptr, nullptr);
+      this->RealSize = N;
+    }
+    return this->RealPlan;
+  }
+
+  std::vector<vtkImageComplex>& GetRealRowBuffer(int N)
+  {
+    this->RealRow.resize(N);
+    return this->RealRow;
+  }
+
+  // vtkImageComplex has the layout of kiss_fft_cpx when kissfft computes
+  // with doubles, otherwise the values are converted.
+  void Transform(kiss_fft_cfg cfg, const vtkImageComplex* in, vtkImageComplex* out, int N)
+  {
+    if (std::is_same<kiss_fft_scalar, double>::value)
+    {
+      kiss_fft(
+        cfg, reinterpret_cast<const kiss_fft_cpx*>(in), reinterpret_cast<kiss_fft_cpx*>(out));
+      return;
+    }
+    this->In.resize(N);
+    this->Out.resize(N);
+    for (int i = 0; i < N; ++i)
+    {
+      this->In[i].r = static_cast<kiss_fft_scalar>(in[i].Real);
+      this->In[i].i = static_cast<kiss_fft_scalar>(in[i].Imag);
+    }
+    kiss_fft(cfg, this->In.data(), this->Out.data());
+    this->CopyOut(out, N);
+  }
+
+  // Compute the first N / 2 + 1 values of the spectrum of a real row.
+  void TransformReal(kiss_fftr_cfg cfg, const double* in, vtkImageComplex* out, int N)
+  {
+    if (std::is_same<kiss_fft_scalar, double>::value)
+    {
+      kiss_fftr(
+        cfg, reinterpret_cast<const kiss_fft_scalar*>(in), reinterpret_cast<kiss_fft_cpx*>(out));
+      return;
+    }
+    this->RealIn.resize(N);
+    this->Out.resize(N / 2 + 1);
+    for (int i = 0; i < N; ++i)
+    {
+      this->RealIn[i] = static_cast<kiss_fft_scalar>(in[i]);
+    }
+    kiss_fftr(cfg, this->RealIn.data(), this->Out.data());
+    this->CopyOut(out, N / 2 + 1);
+  }
+
+private:
+  void CopyOut(vtkImageComplex* out, int N)
+  {
+    for (int i = 0; i < N; ++i)
+    {
+      vtkImageComplexEuclidSet(out[i], this->Out[i].r, this->Out[i].i);
+    }
+  }
+
+  int ComplexSizes[2] = { 0, 0 };
+  kiss_fft_cfg ComplexPlans[2] = { nullptr, nullptr };
+  int RealSize = 0;
+  kiss_fftr_cfg RealPlan = nullptr;
+  std::vector<vtkImageComplex> RealRow;
+  std::vector<kiss_fft_cpx> In;
+  std::vector<kiss_fft_cpx> Out;
+  std::vector<kiss_fft_scalar> RealIn;
+};
+}
+
+//------------------------------------------------------------------------------
 void vtkImageFourierFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
@@ -135,83 +255,94 @@ void vtkImageFourierFilter::ExecuteFftStepN(
 
 //------------------------------------------------------------------------------
 // This function calculates the whole fft (or rfft) of an array.
-// The contents of the input array are changed.
-// It is engineered for no decimation so input and output cannot be equal.
+// The input and output arrays cannot be equal.
 // (fb = 1) => fft, (fb = -1) => rfft;
 void vtkImageFourierFilter::ExecuteFftForwardBackward(
   vtkImageComplex* in, vtkImageComplex* out, int N, int fb)
 {
-  vtkImageComplex *p1, *p2, *p3;
-  int block_size = 1;
-  int rest_size = N;
-  int n = 2;
-  int idx;
+  this->ExecuteFftBatch(in, out, N, 1, fb);
+}
+
+//------------------------------------------------------------------------------
+// This function calculates the whole fft of an array.
+void vtkImageFourierFilter::ExecuteFft(vtkImageComplex* in, vtkImageComplex* out, int N)
+{
+  this->ExecuteFftForwardBackward(in, out, N, 1);
+}
+
+//------------------------------------------------------------------------------
+// This function calculates the whole rfft of an array.
+void vtkImageFourierFilter::ExecuteRfft(vtkImageComplex* in, vtkImageComplex* out, int N)
+{
+  this->ExecuteFftForwardBackward(in, out, N, -1);
+}
+
+//------------------------------------------------------------------------------
+void vtkImageFourierFilter::ExecuteFftBatch(
+  const vtkImageComplex* in, vtkImageComplex* out, int N, int count, int fb)
+{
+  vtkImageFourierPlans& plans = vtkImageFourierPlans::GetLocal();
+  kiss_fft_cfg cfg = plans.GetComplexPlan(N, fb == -1);
+  for (int row = 0; row < count; ++row)
+  {
+    plans.Transform(cfg, in + row * static_cast<size_t>(N), out + row * static_cast<size_t>(N), N);
+  }
 
   // If this is a reverse transform (scale accordingly).
   if (fb == -1)
   {
-    p1 = in;
-    for (idx = 0; idx < N; ++idx)
+    const double scale = 1.0 / N;
+    vtkImageComplex* p = out;
+    for (size_t idx = 0; idx < count * static_cast<size_t>(N); ++idx)
     {
-      p1->Real = p1->Real / N;
-      p1->Imag = p1->Imag / N;
-      ++p1;
+      vtkImageComplexScale(*p, scale, *p);
+      ++p;
     }
   }
-  p1 = in;
-  p2 = out;
-  while (block_size < N && n <= N)
+}
+
+//------------------------------------------------------------------------------
+void vtkImageFourierFilter::ExecuteRealFftBatch(
+  const double* in, vtkImageComplex* out, int N, int count)
+{
+  vtkImageFourierPlans& plans = vtkImageFourierPlans::GetLocal();
+  if (N % 2 != 0)
   {
-    if ((rest_size % n) == 0)
+    // kissfft only has real transforms of even length.
+    std::vector<vtkImageComplex>& row = plans.GetRealRowBuffer(N);
+    kiss_fft_cfg cfg = plans.GetComplexPlan(N, false);
+    for (int idx = 0; idx < count; ++idx)
     {
-      // n is a prime factor, perform one "butterfly" stage of the fft.
-      if (n == 2)
+      for (int i = 0; i < N; ++i)
       {
-        this->ExecuteFftStep2(p1, p2, N, block_size, fb);
+        vtkImageComplexEuclidSet(row[i], in[i], 0.0);
       }
-      else
-      {
-        this->ExecuteFftStepN(p1, p2, N, block_size, n, fb);
-      }
-      block_size = block_size * n;
-      rest_size = rest_size / n;
-      // switch input and output.
-      p3 = p1;
-      p1 = p2;
-      p2 = p3;
-    }
-    else
-    {
-      // n is not a prime factor. increment n to see if n+1 is.
-      ++n;
+      plans.Transform(cfg, row.data(), out, N);
+      in += N;
+      out += N;
     }
+    return;
   }
-  // If the results ended up in the input, copy to output.
-  if (p1 != out)
+
+  kiss_fftr_cfg cfg = plans.GetRealPlan(N);
+  for (int idx = 0; idx < count; ++idx)
   {
-    for (n = 0; n < N; ++n)
+    plans.TransformReal(cfg, in, out, N);
+    // The spectrum of a real signal is conjugate symmetric.
+    for (int i = 1; i < N / 2; ++i)
     {
-      *out++ = *p1++;
+      vtkImageComplexConjugate(out[i], out[N - i]);
     }
+    in += N;
+    out += N;
   }
 }
 
 //------------------------------------------------------------------------------
-// This function calculates the whole fft of an array.
-// The contents of the input array are changed.
-// (It is engineered for no decimation)
-void vtkImageFourierFilter::ExecuteFft(vtkImageComplex* in, vtkImageComplex* out, int N)
-{
-  this->ExecuteFftForwardBackward(in, out, N, 1);
-}
-
-//------------------------------------------------------------------------------
-// This function calculates the whole fft of an array.
-// The contents of the input array are changed.
-// (It is engineered for no decimation)
-void vtkImageFourierFilter::ExecuteRfft(vtkImageComplex* in, vtkImageComplex* out, int N)
+int vtkImageFourierFilter::GetFftBatchSize(int N)
 {
-  this->ExecuteFftForwardBackward(in, out, N, -1);
+  // Keep the input and output buffers of a batch within 512 KiB.
+  return std::max(1, std::min(32, 16384 / std::max(N, 1)));
 }
 
 //------------------------------------------------------------------------------
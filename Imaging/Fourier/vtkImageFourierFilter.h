@@ -8,11 +8,15 @@
  * this superclass is a container for methods that manipulate these structure
  * including fast Fourier transforms.  Complex numbers may become a class.
  * This should really be a helper class.
+ *
+ * The transforms are computed with kissfft, on batches of rows that share
+ * the plan of their length, see ExecuteFftBatch().
  */
 
 #ifndef vtkImageFourierFilter_h
 #define vtkImageFourierFilter_h
 
+#include "vtkDeprecation.h"          // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkImageDecomposeFilter.h"
 #include "vtkImagingFourierModule.h" // For export macro
 
@@ -104,23 +108,46 @@ public:
 
   /**
    * This function calculates the whole fft of an array.
-   * The contents of the input array are changed.
-   * (It is engineered for no decimation)
+   * The input array is not changed.
    */
   void ExecuteFft(vtkImageComplex* in, vtkImageComplex* out, int N);
 
   /**
-   * This function calculates the whole fft of an array.
-   * The contents of the input array are changed.
-   * (It is engineered for no decimation)
+   * This function calculates the whole rfft of an array.
+   * The input array is not changed.
    */
   void ExecuteRfft(vtkImageComplex* in, vtkImageComplex* out, int N);
 
+  /**
+   * Calculate the fft (fb = 1) or the rfft (fb = -1) of count arrays of N
+   * complex numbers, stored one after the other. The results are stored with
+   * the same layout in out, which must not overlap in. The rfft is scaled
+   * by 1/N. The plans of the transforms are cached by each thread, so the
+   * rows of an image are best transformed in batches of GetFftBatchSize().
+   */
+  void ExecuteFftBatch(const vtkImageComplex* in, vtkImageComplex* out, int N, int count, int fb);
+
+  /**
+   * Calculate the fft of count arrays of N real numbers, stored one after
+   * the other, into count arrays of N complex numbers. When N is even, only
+   * half of each spectrum is computed and the other half is filled by
+   * symmetry.
+   */
+  void ExecuteRealFftBatch(const double* in, vtkImageComplex* out, int N, int count);
+
+  /**
+   * Return the number of rows of length N that should be transformed
+   * together, so that the buffers of a batch stay in the cache.
+   */
+  static int GetFftBatchSize(int N);
+
 protected:
   vtkImageFourierFilter() = default;
   ~vtkImageFourierFilter() override = default;
 
+  VTK_DEPRECATED_IN_9_4_0("The transforms are computed by ExecuteFftBatch.")
   void ExecuteFftStep2(vtkImageComplex* p_in, vtkImageComplex* p_out, int N, int bsize, int fb);
+  VTK_DEPRECATED_IN_9_4_0("The transforms are computed by ExecuteFftBatch.")
   void ExecuteFftStepN(
     vtkImageComplex* p_in, vtkImageComplex* p_out, int N, int bsize, int n, int fb);
   void ExecuteFftForwardBackward(vtkImageComplex* in, vtkImageComplex* out, int N, int fb);
@@ -8,7 +8,9 @@
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageRFFT);
@@ -57,8 +59,6 @@ template <class T>
 void vtkImageRFFTExecute(vtkImageRFFT* self, vtkImageData* inData, int inExt[6], T* inPtr,
   vtkImageData* outData, int outExt[6], double* outPtr, int id)
 {
-  vtkImageComplex* inComplex;
-  vtkImageComplex* outComplex;
   vtkImageComplex* pComplex;
   //
   int inMin0, inMax0;
@@ -69,8 +69,9 @@ void vtkImageRFFTExecute(vtkImageRFFT* self, vtkImageData* inData, int inExt[6],
   vtkIdType outInc0, outInc1, outInc2;
   double *outPtr0, *outPtr1, *outPtr2;
   //
-  int idx0, idx1, idx2, inSize0, numberOfComponents;
+  int idx0, idx1, idx2, inSize0, numberOfComponents, row, rows;
   unsigned long count = 0;
+  unsigned long nextProgress = 0;
   unsigned long target;
   double startProgress;
 
@@ -100,9 +101,13 @@ void vtkImageRFFTExecute(vtkImageRFFT* self, vtkImageData* inData, int inExt[6],
     return;
   }
 
-  // Allocate the arrays of complex numbers
-  inComplex = new vtkImageComplex[inSize0];
-  outComplex = new vtkImageComplex[inSize0];
+  // The rows are transformed by batches of neighbors along the second axis:
+  // reading and writing a batch one position of the rows at a time accesses
+  // the memory contiguously, even when the rows are along the y or z axis.
+  const int batchSize =
+    std::min(vtkImageFourierFilter::GetFftBatchSize(inSize0), outMax1 - outMin1 + 1);
+  std::vector<vtkImageComplex> inComplex(batchSize * static_cast<size_t>(inSize0));
+  std::vector<vtkImageComplex> outComplex(batchSize * static_cast<size_t>(inSize0));
 
   target = static_cast<unsigned long>(
     (outMax2 - outMin2 + 1) * (outMax1 - outMin1 + 1) * self->GetNumberOfIterations() / 50.0);
@@ -115,53 +120,57 @@ void vtkImageRFFTExecute(vtkImageRFFT* self, vtkImageData* inData, int inExt[6],
   {
     inPtr1 = inPtr2;
     outPtr1 = outPtr2;
-    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1; ++idx1)
+    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1; idx1 += rows)
     {
+      rows = std::min(batchSize, outMax1 - idx1 + 1);
       if (!id)
       {
-        if (!(count % target))
+        if (count >= nextProgress)
         {
           self->UpdateProgress(count / (50.0 * target) + startProgress);
+          nextProgress = count + target;
         }
-        count++;
+        count += rows;
       }
       // copy into complex numbers
       inPtr0 = inPtr1;
-      pComplex = inComplex;
-      for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
+      for (idx0 = 0; idx0 < inSize0; ++idx0)
       {
-        pComplex->Real = static_cast<double>(*inPtr0);
-        pComplex->Imag = 0.0;
-        if (numberOfComponents > 1)
-        { // yes we have an imaginary input
-          pComplex->Imag = static_cast<double>(inPtr0[1]);
+        for (row = 0; row < rows; ++row)
+        {
+          pComplex = &inComplex[row * inSize0 + idx0];
+          pComplex->Real = static_cast<double>(inPtr0[row * inInc1]);
+          pComplex->Imag = 0.0;
+          if (numberOfComponents > 1)
+          { // yes we have an imaginary input
+            pComplex->Imag = static_cast<double>(inPtr0[row * inInc1 + 1]);
+          }
         }
         inPtr0 += inInc0;
-        ++pComplex;
       }
 
       // Call the method that performs the RFFT
-      self->ExecuteRfft(inComplex, outComplex, inSize0);
+      self->ExecuteFftBatch(inComplex.data(), outComplex.data(), inSize0, rows, -1);
 
       // copy into output
       outPtr0 = outPtr1;
-      pComplex = outComplex + (outMin0 - inMin0);
       for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
       {
-        *outPtr0 = static_cast<double>(pComplex->Real);
-        outPtr0[1] = static_cast<double>(pComplex->Imag);
+        pComplex = &outComplex[idx0 - inMin0];
+        for (row = 0; row < rows; ++row)
+        {
+          outPtr0[row * outInc1] = pComplex->Real;
+          outPtr0[row * outInc1 + 1] = pComplex->Imag;
+          pComplex += inSize0;
+        }
         outPtr0 += outInc0;
-        ++pComplex;
       }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
+      inPtr1 += rows * inInc1;
+      outPtr1 += rows * outInc1;
     }
     inPtr2 += inInc2;
     outPtr2 += outInc2;
   }
-
-  delete[] inComplex;
-  delete[] outComplex;
 }
 
 //------------------------------------------------------------------------------
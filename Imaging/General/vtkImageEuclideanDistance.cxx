@@ -6,9 +6,13 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageEuclideanDistance);
@@ -21,6 +25,8 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
   this->Algorithm = VTK_EDT_SAITO;
+  this->OutputScalarType = VTK_DOUBLE;
+  this->SignedDistance = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -28,7 +34,7 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
 int vtkImageEuclideanDistance::IterativeRequestInformation(
   vtkInformation* vtkNotUsed(input), vtkInformation* output)
 {
-  vtkDataObject::SetPointDataActiveScalarInfo(output, VTK_DOUBLE, 1);
+  vtkDataObject::SetPointDataActiveScalarInfo(output, this->OutputScalarType, 1);
   return 1;
 }
 
@@ -45,18 +51,18 @@ int vtkImageEuclideanDistance::IterativeRequestUpdateExtent(
 }
 
 //------------------------------------------------------------------------------
-// This templated execute method handles any type input, but the output
-// is always doubles.
-template <class TT>
+// This templated execute method handles any type input, the output is
+// either doubles or floats.
+template <class TT, class OT>
 void vtkImageEuclideanDistanceCopyData(vtkImageEuclideanDistance* self, vtkImageData* inData,
-  TT* inPtr, vtkImageData* outData, int outExt[6], double* outPtr)
+  TT* inPtr, vtkImageData* outData, int outExt[6], OT* outPtr)
 {
   vtkIdType inInc0, inInc1, inInc2;
   TT *inPtr0, *inPtr1, *inPtr2;
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  OT *outPtr0, *outPtr1, *outPtr2;
 
   int idx0, idx1, idx2;
 
@@ -86,7 +92,7 @@ void vtkImageEuclideanDistanceCopyData(vtkImageEuclideanDistance* self, vtkImage
 
       for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
       {
-        *outPtr0 = *inPtr0;
+        *outPtr0 = static_cast<OT>(*inPtr0);
         inPtr0 += inInc0;
         outPtr0 += outInc0;
       }
@@ -99,21 +105,15 @@ void vtkImageEuclideanDistanceCopyData(vtkImageEuclideanDistance* self, vtkImage
 }
 
 //------------------------------------------------------------------------------
-// This templated execute method handles any type input, but the output
-// is always doubles.
-template <class T>
+// This templated execute method handles any type input, the output is
+// either doubles or floats.
+template <class T, class OT>
 void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance* self, vtkImageData* inData,
-  T* inPtr, vtkImageData* outData, int outExt[6], double* outPtr)
+  T* inPtr, vtkImageData* outData, int outExt[6], OT* outPtr)
 {
   vtkIdType inInc0, inInc1, inInc2;
-  T *inPtr0, *inPtr1, *inPtr2;
-
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
-
-  int idx0, idx1, idx2;
-  double maxDist;
 
   // Reorder axes
   self->PermuteExtent(outExt, outMin0, outMax0, outMin1, outMax1, outMin2, outMax2);
@@ -130,49 +130,43 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance* self, vtkIma
 
   if (self->GetInitialize() == 1)
   // Initialization required. Input image is only used as binary mask,
-  // so all non-zero values are set to maxDist
+  // so all non-zero values are set to maxDist. For a signed distance, the
+  // zero values are set to -maxDist, the distance to the nearest non-zero
+  // value being unknown.
   //
   {
-    maxDist = self->GetMaximumDistance();
-
-    inPtr2 = inPtr;
-    outPtr2 = outPtr;
-    for (idx2 = outMin2; idx2 <= outMax2; ++idx2)
+    const OT maxDist = static_cast<OT>(self->GetMaximumDistance());
+    OT zeroDist = 0;
+    if (self->GetSignedDistance() && self->GetAlgorithm() == VTK_EDT_FELZENSZWALB)
     {
-      inPtr1 = inPtr2;
-      outPtr1 = outPtr2;
-      for (idx1 = outMin1; idx1 <= outMax1; ++idx1)
-      {
-        inPtr0 = inPtr1;
-        outPtr0 = outPtr1;
+      zeroDist = -maxDist;
+    }
 
-        for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
+    vtkSMPTools::For(outMin2, outMax2 + 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType idx2 = begin; idx2 < end; ++idx2)
+      {
+        T* inPtr1 = inPtr + (idx2 - outMin2) * inInc2;
+        OT* outPtr1 = outPtr + (idx2 - outMin2) * outInc2;
+        for (int idx1 = outMin1; idx1 <= outMax1; ++idx1)
         {
-          if (*inPtr0 == 0)
+          T* inPtr0 = inPtr1;
+          OT* outPtr0 = outPtr1;
+          for (int idx0 = outMin0; idx0 <= outMax0; ++idx0)
           {
-            *outPtr0 = 0;
+            *outPtr0 = (*inPtr0 == 0 ? zeroDist : maxDist);
+            inPtr0 += inInc0;
+            outPtr0 += outInc0;
           }
-          else
-          {
-            *outPtr0 = maxDist;
-          }
-
-          inPtr0 += inInc0;
-          outPtr0 += outInc0;
+          inPtr1 += inInc1;
+          outPtr1 += outInc1;
         }
-
-        inPtr1 += inInc1;
-        outPtr1 += outInc1;
       }
-      inPtr2 += inInc2;
-      outPtr2 += outInc2;
-    }
+    });
   }
   else
   // No initialization required. We just copy inData to outData.
   {
-    vtkImageEuclideanDistanceCopyData(
-      self, inData, static_cast<T*>(inPtr), outData, outExt, static_cast<double*>(outPtr));
+    vtkImageEuclideanDistanceCopyData(self, inData, inPtr, outData, outExt, outPtr);
   }
 }
 
@@ -185,13 +179,14 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance* self, vtkIma
 //
 // Notations stay as close as possible to those used in the paper.
 //
-static void vtkImageEuclideanDistanceExecuteSaito(
-  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], double* outPtr)
+template <class OT>
+void vtkImageEuclideanDistanceExecuteSaito(
+  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], OT* outPtr)
 {
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  OT *outPtr0, *outPtr1, *outPtr2;
   int idx0, idx1, idx2, inSize0;
   double maxDist;
   double* sq;
@@ -249,7 +244,7 @@ static void vtkImageEuclideanDistanceExecuteSaito(
             df++;
             if (sq[df] < *outPtr0)
             {
-              *outPtr0 = sq[df];
+              *outPtr0 = static_cast<OT>(sq[df]);
             }
           }
           else
@@ -268,7 +263,7 @@ static void vtkImageEuclideanDistanceExecuteSaito(
             df++;
             if (sq[df] < *outPtr0)
             {
-              *outPtr0 = sq[df];
+              *outPtr0 = static_cast<OT>(sq[df]);
             }
           }
           else
@@ -329,7 +324,7 @@ static void vtkImageEuclideanDistanceExecuteSaito(
               }
               else if (m < *(outPtr0 + n * outInc0))
               {
-                *(outPtr0 + n * outInc0) = m;
+                *(outPtr0 + n * outInc0) = static_cast<OT>(m);
               }
             }
             a = b;
@@ -370,7 +365,7 @@ static void vtkImageEuclideanDistanceExecuteSaito(
               }
               else if (m < *(outPtr0 - n * outInc0))
               {
-                *(outPtr0 - n * outInc0) = m;
+                *(outPtr0 - n * outInc0) = static_cast<OT>(m);
               }
             }
             a = b;
@@ -396,20 +391,22 @@ static void vtkImageEuclideanDistanceExecuteSaito(
 //------------------------------------------------------------------------------
 // Execute Saito's algorithm, modified for Cache Efficiency
 //
-static void vtkImageEuclideanDistanceExecuteSaitoCached(
-  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], double* outPtr)
+template <class OT>
+void vtkImageEuclideanDistanceExecuteSaitoCached(
+  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], OT* outPtr)
 {
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  OT *outPtr0, *outPtr1, *outPtr2;
   //
   int idx0, idx1, idx2, inSize0;
 
   double maxDist;
 
   double* sq;
-  double *buff, *temp, buffer;
+  double *buff, buffer;
+  OT* temp;
   int df, a, b, n;
   double m;
 
@@ -423,7 +420,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
   maxDist = self->GetMaximumDistance();
 
   buff = static_cast<double*>(calloc(outMax0 + 1, sizeof(double)));
-  temp = static_cast<double*>(calloc(outMax0 + 1, sizeof(double)));
+  temp = static_cast<OT*>(calloc(outMax0 + 1, sizeof(OT)));
 
   // precompute sq[]. Anisotropy is handled here by using Spacing information
   sq = static_cast<double*>(calloc(inSize0 * 2 + 2, sizeof(double)));
@@ -463,7 +460,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
             df++;
             if (sq[df] < *outPtr0)
             {
-              *outPtr0 = sq[df];
+              *outPtr0 = static_cast<OT>(sq[df]);
             }
           }
           else
@@ -483,7 +480,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
             df++;
             if (sq[df] < *outPtr0)
             {
-              *outPtr0 = sq[df];
+              *outPtr0 = static_cast<OT>(sq[df]);
             }
           }
           else
@@ -511,7 +508,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
         outPtr0 = outPtr1;
         for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
         {
-          temp[idx0] = buff[idx0] = *outPtr0;
+          buff[idx0] = temp[idx0] = *outPtr0;
           outPtr0 += outInc0;
         }
 
@@ -545,7 +542,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
               }
               else if (m < *(outPtr0 + n))
               {
-                *(outPtr0 + n) = m;
+                *(outPtr0 + n) = static_cast<OT>(m);
               }
             }
             a = b;
@@ -585,7 +582,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
               }
               else if (m < *(outPtr0 - n))
               {
-                *(outPtr0 - n) = m;
+                *(outPtr0 - n) = static_cast<OT>(m);
               }
             }
             a = b;
@@ -616,12 +613,206 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
   free(temp);
   free(sq);
 }
+
+//------------------------------------------------------------------------------
+// Compute the lower envelope of the parabolas rooted at each value of a line,
+// where spacing is the square of the distance between two values. The values
+// not smaller than maxDist are not distances yet and are skipped, the
+// distances are clamped to maxDist.
+//
+// P. F. Felzenszwalb and D. P. Huttenlocher. Distance transforms of sampled
+// functions. Theory of Computing, 8(19). pp. 415--428, 2012.
+//
+static void vtkImageEuclideanDistanceLowerEnvelope(const double* f, double* d, int n,
+  double spacing, double maxDist, double* h, int* v, double* z)
+{
+  // Work in voxel units, h[q] is the height of the parabola of q at 0.
+  const double scale = 1.0 / spacing;
+  int k = -1;
+  for (int q = 0; q < n; ++q)
+  {
+    if (f[q] >= maxDist)
+    {
+      continue;
+    }
+    h[q] = f[q] * scale + static_cast<double>(q) * q;
+    if (k < 0)
+    {
+      k = 0;
+      v[0] = q;
+      z[0] = -std::numeric_limits<double>::infinity();
+      z[1] = std::numeric_limits<double>::infinity();
+      continue;
+    }
+
+    // Intersection with the rightmost parabola of the envelope, which is
+    // hidden when the intersection is left of its own left bound.
+    double s = (h[q] - h[v[k]]) / (2.0 * (q - v[k]));
+    while (s <= z[k])
+    {
+      --k;
+      s = (h[q] - h[v[k]]) / (2.0 * (q - v[k]));
+    }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = std::numeric_limits<double>::infinity();
+  }
+
+  if (k < 0)
+  {
+    std::fill(d, d + n, maxDist);
+    return;
+  }
+
+  k = 0;
+  for (int q = 0; q < n; ++q)
+  {
+    while (z[k + 1] < q)
+    {
+      ++k;
+    }
+    const double dq = q - v[k];
+    d[q] = std::min(spacing * dq * dq + f[v[k]], maxDist);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Execute Felzenszwalb's algorithm along the lines of the current axis, the
+// lines are processed in parallel.
+//
+// For a signed distance, each value holds two squared distances, at least one
+// of them being zero: the positive part is the distance to the nearest zero
+// voxel, and the negative part the distance to the nearest non-zero voxel.
+// Each pass keeps this property, since the transform of a zero value is zero.
+//
+template <class OT>
+void vtkImageEuclideanDistanceExecuteFelzenszwalb(
+  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], OT* outPtr)
+{
+  int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
+  vtkIdType outInc0, outInc1, outInc2;
+
+  // Reorder axes
+  self->PermuteExtent(outExt, outMin0, outMax0, outMin1, outMax1, outMin2, outMax2);
+  vtkIdType outIncrements[3];
+  outData->GetIncrements(outIncrements);
+  self->PermuteIncrements(outIncrements, outInc0, outInc1, outInc2);
+
+  const int inSize0 = outMax0 - outMin0 + 1;
+  const vtkIdType inSize1 = outMax1 - outMin1 + 1;
+  const vtkIdType numberOfLines = inSize1 * (outMax2 - outMin2 + 1);
+
+  double spacing = 1.0;
+  if (self->GetConsiderAnisotropy())
+  {
+    spacing = outData->GetSpacing()[self->GetIteration()];
+  }
+  spacing *= spacing;
+
+  const double maxDist = self->GetMaximumDistance();
+  const bool signedDistance = (self->GetSignedDistance() != 0);
+
+  vtkSMPTools::For(0, numberOfLines, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double> f(inSize0), d(inSize0), g(inSize0), e(inSize0), h(inSize0);
+    std::vector<double> z(inSize0 + 1);
+    std::vector<int> v(inSize0);
+
+    for (vtkIdType line = begin; line < end; ++line)
+    {
+      OT* outPtr0 = outPtr + (line % inSize1) * outInc1 + (line / inSize1) * outInc2;
+
+      if (signedDistance)
+      {
+        for (int idx0 = 0; idx0 < inSize0; ++idx0)
+        {
+          const double value = outPtr0[idx0 * outInc0];
+          f[idx0] = std::max(value, 0.0);
+          g[idx0] = std::max(-value, 0.0);
+        }
+        vtkImageEuclideanDistanceLowerEnvelope(
+          f.data(), d.data(), inSize0, spacing, maxDist, h.data(), v.data(), z.data());
+        vtkImageEuclideanDistanceLowerEnvelope(
+          g.data(), e.data(), inSize0, spacing, maxDist, h.data(), v.data(), z.data());
+        for (int idx0 = 0; idx0 < inSize0; ++idx0)
+        {
+          outPtr0[idx0 * outInc0] = static_cast<OT>(d[idx0] - e[idx0]);
+        }
+      }
+      else
+      {
+        for (int idx0 = 0; idx0 < inSize0; ++idx0)
+        {
+          f[idx0] = outPtr0[idx0 * outInc0];
+        }
+        vtkImageEuclideanDistanceLowerEnvelope(
+          f.data(), d.data(), inSize0, spacing, maxDist, h.data(), v.data(), z.data());
+        for (int idx0 = 0; idx0 < inSize0; ++idx0)
+        {
+          outPtr0[idx0 * outInc0] = static_cast<OT>(d[idx0]);
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Initialize the output of the current iteration, and run the algorithm.
+template <class OT>
+void vtkImageEuclideanDistanceExecute(vtkImageEuclideanDistance* self, vtkImageData* inData,
+  void* inPtr, vtkImageData* outData, int outExt[6], OT* outPtr)
+{
+  if (self->GetIteration() == 0)
+  {
+    switch (inData->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageEuclideanDistanceInitialize(
+        self, inData, static_cast<VTK_TT*>(inPtr), outData, outExt, outPtr));
+      default:
+        vtkErrorWithObjectMacro(self, << "Execute: Unknown ScalarType");
+        return;
+    }
+  }
+  else
+  {
+    if (inData != outData)
+      switch (inData->GetScalarType())
+      {
+        vtkTemplateMacro(vtkImageEuclideanDistanceCopyData(
+          self, inData, static_cast<VTK_TT*>(inPtr), outData, outExt, outPtr));
+      }
+  }
+
+  // Call the specific algorithms.
+  switch (self->GetAlgorithm())
+  {
+    case VTK_EDT_SAITO:
+      vtkImageEuclideanDistanceExecuteSaito(self, outData, outExt, outPtr);
+      break;
+    case VTK_EDT_SAITO_CACHED:
+      vtkImageEuclideanDistanceExecuteSaitoCached(self, outData, outExt, outPtr);
+      break;
+    case VTK_EDT_FELZENSZWALB:
+      vtkImageEuclideanDistanceExecuteFelzenszwalb(self, outData, outExt, outPtr);
+      break;
+    default:
+      vtkErrorWithObjectMacro(self, << "Execute: Unknown Algorithm");
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkImageEuclideanDistance::AllocateOutputScalars(
   vtkImageData* outData, int outExt[6], vtkInformation* outInfo)
 {
   outData->SetExtent(outExt);
   outData->AllocateScalars(outInfo);
+
+  // The intermediate outputs of the iterations do not get the spacing from
+  // the pipeline, while the algorithms need it to consider anisotropy.
+  if (outInfo->Has(vtkDataObject::SPACING()))
+  {
+    outData->SetSpacing(outInfo->Get(vtkDataObject::SPACING()));
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -665,13 +856,6 @@ int vtkImageEuclideanDistance::IterativeRequestData(vtkInformation* vtkNotUsed(r
     }
   }
 
-  // this filter expects that the output be doubles.
-  if (outData->GetScalarType() != VTK_DOUBLE)
-  {
-    vtkErrorMacro(<< "Execute: Output must be type double.");
-    return 1;
-  }
-
   // this filter expects input to have 1 components
   if (outData->GetNumberOfScalarComponents() != 1)
   {
@@ -679,39 +863,20 @@ int vtkImageEuclideanDistance::IterativeRequestData(vtkInformation* vtkNotUsed(r
     return 1;
   }
 
-  if (this->GetIteration() == 0)
-  {
-    switch (inData->GetScalarType())
-    {
-      vtkTemplateMacro(vtkImageEuclideanDistanceInitialize(
-        this, inData, static_cast<VTK_TT*>(inPtr), outData, outExt, static_cast<double*>(outPtr)));
-      default:
-        vtkErrorMacro(<< "Execute: Unknown ScalarType");
-        return 1;
-    }
-  }
-  else
-  {
-    if (inData != outData)
-      switch (inData->GetScalarType())
-      {
-        vtkTemplateMacro(vtkImageEuclideanDistanceCopyData(this, inData,
-          static_cast<VTK_TT*>(inPtr), outData, outExt, static_cast<double*>(outPtr)));
-      }
-  }
-
-  // Call the specific algorithms.
-  switch (this->GetAlgorithm())
+  // this filter expects that the output be doubles or floats.
+  switch (outData->GetScalarType())
   {
-    case VTK_EDT_SAITO:
-      vtkImageEuclideanDistanceExecuteSaito(this, outData, outExt, static_cast<double*>(outPtr));
+    case VTK_DOUBLE:
+      vtkImageEuclideanDistanceExecute(
+        this, inData, inPtr, outData, outExt, static_cast<double*>(outPtr));
       break;
-    case VTK_EDT_SAITO_CACHED:
-      vtkImageEuclideanDistanceExecuteSaitoCached(
-        this, outData, outExt, static_cast<double*>(outPtr));
+    case VTK_FLOAT:
+      vtkImageEuclideanDistanceExecute(
+        this, inData, inPtr, outData, outExt, static_cast<float*>(outPtr));
       break;
     default:
-      vtkErrorMacro(<< "Execute: Unknown Algorithm");
+      vtkErrorMacro(<< "Execute: Output must be type double or float.");
+      return 1;
   }
 
   this->UpdateProgress((this->GetIteration() + 1.0) / 3.0);
@@ -736,9 +901,17 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << "Saito\n";
   }
+  else if (this->Algorithm == VTK_EDT_FELZENSZWALB)
+  {
+    os << "Felzenszwalb\n";
+  }
   else
   {
     os << "Saito Cached\n";
   }
+
+  os << indent << "Output Scalar Type: " << vtkImageScalarTypeNameMacro(this->OutputScalarType)
+     << "\n";
+  os << indent << "Signed Distance: " << (this->SignedDistance ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -19,6 +19,12 @@
  * slow it very significantly. In that case, one should use
  * vtkImageEuclideanDistance::SetAlgorithmToSaitoCached() instead for better performance.
  *
+ * The Felzenszwalb algorithm computes the exact distance in linear time, by
+ * taking the lower envelope of the parabolas rooted at each voxel of a line.
+ * Its passes are threaded over the lines of the image, and it is the
+ * algorithm of choice for large images. It can also compute a signed
+ * distance map from a binary mask, see SignedDistanceOn().
+ *
  * References:
  *
  * T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance
@@ -28,6 +34,9 @@
  * O. Cuisenaire. Distance Transformation: fast algorithms and applications
  * to medical image processing. PhD Thesis, Universite catholique de Louvain,
  * October 1999. http://ltswww.epfl.ch/~cuisenai/papers/oc_thesis.pdf
+ *
+ * P. F. Felzenszwalb and D. P. Huttenlocher. Distance transforms of sampled
+ * functions. Theory of Computing, 8(19). pp. 415--428, 2012.
  */
 
 #ifndef vtkImageEuclideanDistance_h
@@ -38,6 +47,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1
+#define VTK_EDT_FELZENSZWALB 2
 
 VTK_ABI_NAMESPACE_BEGIN
 class VTKIMAGINGGENERAL_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
@@ -83,12 +93,39 @@ public:
    * Selects a Euclidean DT algorithm.
    * 1. Saito
    * 2. Saito-cached
-   * More algorithms will be added later on.
+   * 3. Felzenszwalb, linear time and threaded
    */
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
   void SetAlgorithmToSaito() { this->SetAlgorithm(VTK_EDT_SAITO); }
   void SetAlgorithmToSaitoCached() { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }
+  void SetAlgorithmToFelzenszwalb() { this->SetAlgorithm(VTK_EDT_FELZENSZWALB); }
+  ///@}
+
+  ///@{
+  /**
+   * Set the scalar type of the output, either VTK_DOUBLE (the default) or
+   * VTK_FLOAT. Float output halves the memory used by the filter, the
+   * squared distances are exact up to 2^24. Other types are clamped to one
+   * of these two.
+   */
+  vtkSetClampMacro(OutputScalarType, int, VTK_FLOAT, VTK_DOUBLE);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToDouble() { this->SetOutputScalarType(VTK_DOUBLE); }
+  void SetOutputScalarTypeToFloat() { this->SetOutputScalarType(VTK_FLOAT); }
+  ///@}
+
+  ///@{
+  /**
+   * Compute a signed distance map from a binary mask. The non-zero voxels
+   * get the square of their distance to the nearest zero voxel, and the
+   * zero voxels get minus the square of their distance to the nearest
+   * non-zero voxel. This is only supported by the Felzenszwalb algorithm,
+   * and the input is used as a mask only if Initialize is on. Off by default.
+   */
+  vtkSetMacro(SignedDistance, vtkTypeBool);
+  vtkGetMacro(SignedDistance, vtkTypeBool);
+  vtkBooleanMacro(SignedDistance, vtkTypeBool);
   ///@}
 
   int IterativeRequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -101,6 +138,8 @@ protected:
   vtkTypeBool Initialize;
   vtkTypeBool ConsiderAnisotropy;
   int Algorithm;
+  int OutputScalarType;
+  vtkTypeBool SignedDistance;
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(vtkImageData* outData, int outExt[6], vtkInformation* outInfo);
@@ -3,11 +3,14 @@
 #include "vtkImageGaussianSmooth.h"
 
 #include "vtkImageData.h"
+#include "vtkImageRecursiveGaussianInternal.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -23,6 +26,7 @@ vtkImageGaussianSmooth::vtkImageGaussianSmooth()
   this->RadiusFactors[0] = 1.5;
   this->RadiusFactors[1] = 1.5;
   this->RadiusFactors[2] = 1.5;
+  this->Recursive = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -44,6 +48,8 @@ void vtkImageGaussianSmooth::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "StandardDeviations: ( " << this->StandardDeviations[0] << ", "
      << this->StandardDeviations[1] << ", " << this->StandardDeviations[2] << " )\n";
+
+  os << indent << "Recursive: " << (this->Recursive ? "On" : "Off") << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -103,6 +109,14 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int* inExt, int* wholeE
   // Expand filtered axes
   for (idx = 0; idx < this->Dimensionality; ++idx)
   {
+    // the recursive filter needs whole lines
+    if (this->Recursive)
+    {
+      inExt[idx * 2] = wholeExtent[idx * 2];
+      inExt[idx * 2 + 1] = wholeExtent[idx * 2 + 1];
+      continue;
+    }
+
     radius = static_cast<int>(this->StandardDeviations[idx] * this->RadiusFactors[idx]);
     inExt[idx * 2] -= radius;
     if (inExt[idx * 2] < wholeExtent[idx * 2])
@@ -327,6 +341,99 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis, vtkImageData* inData, int inE
   delete[] kernel;
 }
 
+//------------------------------------------------------------------------------
+// This method applies the recursive filter along one axis. The lines of the
+// output cover the whole input extent along the axis.
+void vtkImageGaussianSmooth::ExecuteRecursiveAxis(
+  int axis, vtkImageData* inData, int inExt[6], vtkImageData* outData, int outExt[6])
+{
+  int coords[3] = { outExt[0], outExt[2], outExt[4] };
+  coords[axis] = inExt[axis * 2];
+  const int inSize = inExt[axis * 2 + 1] - inExt[axis * 2] + 1;
+  const int outSize[3] = { outExt[1] - outExt[0] + 1, outExt[3] - outExt[2] + 1,
+    outExt[5] - outExt[4] + 1 };
+  const int outStart = outExt[axis * 2] - inExt[axis * 2];
+  vtkIdType inIncs[3], outIncs[3];
+  inData->GetIncrements(inIncs);
+  outData->GetIncrements(outIncs);
+  void* inPtr = inData->GetScalarPointer(coords);
+  void* outPtr = outData->GetScalarPointerForExtent(outExt);
+  const vtkRecursiveGaussian gauss(this->StandardDeviations[axis]);
+
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkRecursiveGaussianAxis(gauss, axis, static_cast<VTK_TT*>(inPtr), inIncs,
+      inSize, static_cast<VTK_TT*>(outPtr), outIncs, outSize, outStart,
+      inData->GetNumberOfScalarComponents()));
+    default:
+      vtkErrorMacro("Unknown scalar type");
+      return;
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkImageGaussianSmooth::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->Recursive)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // The recursive filter needs whole lines, so instead of splitting the
+  // output extent into pieces, the lines of each axis are split among the
+  // threads.
+  this->PrepareImageData(inputVector, outputVector);
+  vtkImageData* inData = vtkImageData::GetData(inputVector[0]);
+  vtkImageData* outData = vtkImageData::GetData(outputVector);
+
+  // this filter expects that input is the same type as output.
+  if (inData->GetScalarType() != outData->GetScalarType())
+  {
+    vtkErrorMacro("Execute: input ScalarType, " << inData->GetScalarType()
+                                                << ", must match out ScalarType "
+                                                << outData->GetScalarType());
+    return 1;
+  }
+
+  int outExt[6], inExt[6], wholeExt[6];
+  outData->GetExtent(outExt);
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] || outExt[4] > outExt[5])
+  {
+    return 1;
+  }
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  std::copy(outExt, outExt + 6, inExt);
+  this->InternalRequestUpdateExtent(inExt, wholeExt);
+
+  // Decompose, starting with z like the convolution, each axis reduces the
+  // extent of the intermediate result to the output extent along that axis.
+  vtkSmartPointer<vtkImageData> source = inData;
+  int sourceExt[6];
+  std::copy(inExt, inExt + 6, sourceExt);
+  for (int axis = this->Dimensionality - 1; axis >= 0 && !this->AbortExecute; --axis)
+  {
+    int targetExt[6];
+    std::copy(sourceExt, sourceExt + 6, targetExt);
+    targetExt[axis * 2] = outExt[axis * 2];
+    targetExt[axis * 2 + 1] = outExt[axis * 2 + 1];
+    vtkSmartPointer<vtkImageData> target = outData;
+    if (axis > 0)
+    {
+      target = vtkSmartPointer<vtkImageData>::New();
+      target->SetExtent(targetExt);
+      target->AllocateScalars(inData->GetScalarType(), inData->GetNumberOfScalarComponents());
+    }
+    this->ExecuteRecursiveAxis(axis, source, sourceExt, target, targetExt);
+    this->UpdateProgress(static_cast<double>(this->Dimensionality - axis) / this->Dimensionality);
+    source = target;
+    std::copy(targetExt, targetExt + 6, sourceExt);
+  }
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // This method decomposes the gaussian and smooths along each axis.
 void vtkImageGaussianSmooth::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
@@ -6,6 +6,14 @@
  *
  * vtkImageGaussianSmooth implements a convolution of the input image
  * with a gaussian. Supports from one to three dimensional convolutions.
+ *
+ * By default the gaussian is truncated at RadiusFactors times the standard
+ * deviations, so the cost per voxel grows with the standard deviations. When
+ * Recursive is on, a recursive approximation of the gaussian (Young and van
+ * Vliet) is used instead, whose cost per voxel does not depend on the
+ * standard deviations. It is accurate to a few percent for standard
+ * deviations larger than one pixel, and needs the whole extent of the input
+ * along the smoothed axes.
  */
 
 #ifndef vtkImageGaussianSmooth_h
@@ -31,6 +39,8 @@ public:
   ///@{
   /**
    * Sets/Gets the Standard deviation of the gaussian in pixel units.
+   * For images with anisotropic spacing, divide the standard deviation in
+   * world units by the spacing of each axis.
    */
   vtkSetVector3Macro(StandardDeviations, double);
   void SetStandardDeviation(double std) { this->SetStandardDeviations(std, std, std); }
@@ -66,6 +76,19 @@ public:
   vtkGetMacro(Dimensionality, int);
   ///@}
 
+  ///@{
+  /**
+   * Use a recursive approximation of the gaussian, whose cost does not
+   * depend on the standard deviations. The RadiusFactors are ignored and
+   * the boundaries are handled by repeating the boundary voxels. Standard
+   * deviations smaller than 0.5 are handled as 0.5, except zero that
+   * leaves the axis unchanged. The default is off.
+   */
+  vtkSetMacro(Recursive, vtkTypeBool);
+  vtkGetMacro(Recursive, vtkTypeBool);
+  vtkBooleanMacro(Recursive, vtkTypeBool);
+  ///@}
+
 protected:
   vtkImageGaussianSmooth();
   ~vtkImageGaussianSmooth() override;
@@ -73,12 +96,16 @@ protected:
   int Dimensionality;
   double StandardDeviations[3];
   double RadiusFactors[3];
+  vtkTypeBool Recursive;
 
   void ComputeKernel(double* kernel, int min, int max, double std);
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   void InternalRequestUpdateExtent(int*, int*);
   void ExecuteAxis(int axis, vtkImageData* inData, int inExt[6], vtkImageData* outData,
     int outExt[6], int* pcycle, int target, int* pcount, int total, vtkInformation* inInfo);
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  void ExecuteRecursiveAxis(
+    int axis, vtkImageData* inData, int inExt[6], vtkImageData* outData, int outExt[6]);
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
     int outExt[6], int id) override;
@@ -3,9 +3,12 @@
 #include "vtkImageGradient.h"
 
 #include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkImageData.h"
+#include "vtkImageRecursiveGaussianInternal.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -22,6 +25,8 @@ vtkImageGradient::vtkImageGradient()
 {
   this->HandleBoundaries = 1;
   this->Dimensionality = 2;
+  this->StandardDeviation = 0.0;
+  this->SmoothedArray = nullptr;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -34,6 +39,7 @@ void vtkImageGradient::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "HandleBoundaries: " << this->HandleBoundaries << "\n";
   os << indent << "Dimensionality: " << this->Dimensionality << "\n";
+  os << indent << "StandardDeviation: " << this->StandardDeviation << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -93,6 +99,14 @@ int vtkImageGradient::RequestUpdateExtent(
   // input pixels than we are producing output pixels.
   for (int idx = 0; idx < this->Dimensionality; ++idx)
   {
+    // The recursive smoothing needs whole lines.
+    if (this->StandardDeviation > 0.0)
+    {
+      inUExt[idx * 2] = wholeExtent[idx * 2];
+      inUExt[idx * 2 + 1] = wholeExtent[idx * 2 + 1];
+      continue;
+    }
+
     inUExt[idx * 2] -= 1;
     inUExt[idx * 2 + 1] += 1;
 
@@ -223,6 +237,35 @@ void vtkImageGradientExecute(vtkImageGradient* self, vtkImageData* inData, T* in
   }
 }
 
+//------------------------------------------------------------------------------
+// Smooth the input array with the recursive gaussian along the axes of the
+// gradient, the standard deviation is divided by the spacing of each axis.
+template <class T>
+void vtkImageGradientSmooth(
+  vtkImageData* inData, const T* inPtr, double* outPtr, int dimensionality, double std)
+{
+  const int* inExt = inData->GetExtent();
+  const double* spacing = inData->GetSpacing();
+  const int size[3] = { inExt[1] - inExt[0] + 1, inExt[3] - inExt[2] + 1,
+    inExt[5] - inExt[4] + 1 };
+  const vtkIdType incs[3] = { 1, size[0], static_cast<vtkIdType>(size[0]) * size[1] };
+
+  for (int axis = 0; axis < dimensionality; ++axis)
+  {
+    const vtkRecursiveGaussian gauss(std / std::abs(spacing[axis]));
+    if (axis == 0)
+    {
+      vtkRecursiveGaussianAxis(gauss, axis, inPtr, incs, size[axis], outPtr, incs, size, 0, 1);
+    }
+    else
+    {
+      vtkRecursiveGaussianAxis(gauss, axis, static_cast<const double*>(outPtr), incs, size[axis],
+        outPtr, incs, size, 0, 1);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
 int vtkImageGradient::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
@@ -254,7 +297,27 @@ int vtkImageGradient::RequestData(
   }
   outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ue2, 6);
 
-  if (!this->Superclass::RequestData(request, inputVector, outputVector))
+  // Smooth the input once, before the threads compute the differences.
+  vtkNew<vtkDoubleArray> smoothed;
+  vtkDataArray* inputArray = this->GetInputArrayToProcess(0, inputVector);
+  if (this->StandardDeviation > 0.0 && inputArray && inputArray->GetNumberOfComponents() == 1)
+  {
+    smoothed->SetNumberOfTuples(input->GetNumberOfPoints());
+    switch (inputArray->GetDataType())
+    {
+      vtkTemplateMacro(vtkImageGradientSmooth(input,
+        static_cast<VTK_TT*>(inputArray->GetVoidPointer(0)), smoothed->GetPointer(0),
+        this->Dimensionality, this->StandardDeviation));
+      default:
+        vtkErrorMacro("Execute: Unknown ScalarType " << inputArray->GetDataType());
+        return 0;
+    }
+    this->SmoothedArray = smoothed;
+  }
+
+  int success = this->Superclass::RequestData(request, inputVector, outputVector);
+  this->SmoothedArray = nullptr;
+  if (!success)
   {
     return 0;
   }
@@ -312,6 +375,12 @@ void vtkImageGradient::ThreadedRequestData(vtkInformation*, vtkInformationVector
     return;
   }
 
+  // The differences of the smoothed input are the gradient of the gaussian.
+  if (this->SmoothedArray)
+  {
+    inputArray = this->SmoothedArray;
+  }
+
   void* inPtr = inputArray->GetVoidPointer(0);
   double* outPtr = static_cast<double*>(output->GetScalarPointerForExtent(outExt));
   switch (inputArray->GetDataType())
@@ -9,6 +9,11 @@
  * determines whether to perform a 2d or 3d gradient. The default is
  * two dimensional XY gradient.  OutputScalarType is always
  * double. Gradient is computed using central differences.
+ *
+ * When StandardDeviation is positive, the input is first smoothed with a
+ * recursive approximation of the gaussian, so that the output is the
+ * gradient of the gaussian at that scale, with a cost that does not depend
+ * on the standard deviation.
  */
 
 #ifndef vtkImageGradient_h
@@ -18,6 +23,8 @@
 #include "vtkThreadedImageAlgorithm.h"
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+
 class VTKIMAGINGGENERAL_EXPORT vtkImageGradient : public vtkThreadedImageAlgorithm
 {
 public:
@@ -45,12 +52,29 @@ public:
   vtkBooleanMacro(HandleBoundaries, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the standard deviation of the gaussian that smooths the input
+   * before the differences are computed, in world units. It is divided by
+   * the spacing along each axis, so that the smoothing is isotropic for
+   * images with anisotropic spacing. The smoothing needs the whole extent
+   * of the input along the axes of the gradient. The default is 0, that
+   * computes the differences of the input itself.
+   */
+  vtkSetClampMacro(StandardDeviation, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(StandardDeviation, double);
+  ///@}
+
 protected:
   vtkImageGradient();
   ~vtkImageGradient() override = default;
 
   vtkTypeBool HandleBoundaries;
   int Dimensionality;
+  double StandardDeviation;
+
+  // The smoothed input, during the execution.
+  vtkDataArray* SmoothedArray;
 
   int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
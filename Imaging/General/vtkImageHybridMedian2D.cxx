@@ -9,6 +9,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include <algorithm>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -32,6 +33,46 @@ vtkImageHybridMedian2D::vtkImageHybridMedian2D()
   this->HandleBoundaries = 1;
 }
 
+namespace
+{
+// Compare and exchange two values of a selection network.
+template <class T>
+inline void vtkHybridMedianSort(T& a, T& b)
+{
+  if (a > b)
+  {
+    std::swap(a, b);
+  }
+}
+
+// Compute the median of 9 values with a selection network of 19 exchanges,
+// which is much faster than sorting them.
+template <class T>
+T vtkHybridMedianOf9(T* p)
+{
+  vtkHybridMedianSort(p[1], p[2]);
+  vtkHybridMedianSort(p[4], p[5]);
+  vtkHybridMedianSort(p[7], p[8]);
+  vtkHybridMedianSort(p[0], p[1]);
+  vtkHybridMedianSort(p[3], p[4]);
+  vtkHybridMedianSort(p[6], p[7]);
+  vtkHybridMedianSort(p[1], p[2]);
+  vtkHybridMedianSort(p[4], p[5]);
+  vtkHybridMedianSort(p[7], p[8]);
+  vtkHybridMedianSort(p[0], p[3]);
+  vtkHybridMedianSort(p[5], p[8]);
+  vtkHybridMedianSort(p[4], p[7]);
+  vtkHybridMedianSort(p[3], p[6]);
+  vtkHybridMedianSort(p[1], p[4]);
+  vtkHybridMedianSort(p[2], p[5]);
+  vtkHybridMedianSort(p[4], p[7]);
+  vtkHybridMedianSort(p[4], p[2]);
+  vtkHybridMedianSort(p[6], p[4]);
+  vtkHybridMedianSort(p[4], p[2]);
+  return p[4];
+}
+}
+
 template <class T>
 void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D* self, vtkImageData* inData, T* inPtr2,
   vtkImageData* outData, T* outPtr2, int outExt[6], int id, vtkInformation* inInfo)
@@ -86,126 +127,145 @@ void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D* self, vtkImageData* i
       outPtr0 = outPtr1;
       for (idx0 = min0; idx0 <= max0; ++idx0)
       {
+        // away from the boundaries, the neighborhoods are complete
+        const bool interior = (idx0 - 1 > wholeMin0 && idx0 + 1 < wholeMax0 &&
+          idx1 - 1 > wholeMin1 && idx1 + 1 < wholeMax1);
         inPtrC = inPtr0;
         outPtrC = outPtr0;
         for (idxC = 0; idxC < numComps; ++idxC)
         {
-          // compute median of + neighborhood
-          // note that y axis direction is up in vtk images, not down
-          // as in screen coordinates
-          array.clear();
-          // Center
-          ptr = inPtrC;
-          array.push_back(*ptr);
-          // left
-          ptr = inPtrC;
-          if (idx0 > wholeMin0)
+          if (interior)
           {
-            ptr -= inInc0;
-            array.push_back(*ptr);
+            const vtkIdType inIncD1 = inInc0 + inInc1;
+            const vtkIdType inIncD2 = inInc0 - inInc1;
+            T plus[9] = { inPtrC[0], inPtrC[-inInc0], inPtrC[-2 * inInc0], inPtrC[inInc0],
+              inPtrC[2 * inInc0], inPtrC[-inInc1], inPtrC[-2 * inInc1], inPtrC[inInc1],
+              inPtrC[2 * inInc1] };
+            T cross[9] = { inPtrC[0], inPtrC[-inIncD1], inPtrC[-2 * inIncD1], inPtrC[inIncD1],
+              inPtrC[2 * inIncD1], inPtrC[-inIncD2], inPtrC[-2 * inIncD2], inPtrC[inIncD2],
+              inPtrC[2 * inIncD2] };
+            median1 = vtkHybridMedianOf9(plus);
+            median2 = vtkHybridMedianOf9(cross);
           }
-          if (idx0 - 1 > wholeMin0)
-          {
-            ptr -= inInc0;
-            array.push_back(*ptr);
-          }
-          // right
-          ptr = inPtrC;
-          if (idx0 < wholeMax0)
-          {
-            ptr += inInc0;
-            array.push_back(*ptr);
-          }
-          if (idx0 + 1 < wholeMax0)
-          {
-            ptr += inInc0;
-            array.push_back(*ptr);
-          }
-          // down
-          ptr = inPtrC;
-          if (idx1 > wholeMin1)
-          {
-            ptr -= inInc1;
-            array.push_back(*ptr);
-          }
-          if (idx1 - 1 > wholeMin1)
-          {
-            ptr -= inInc1;
-            array.push_back(*ptr);
-          }
-          // up
-          ptr = inPtrC;
-          if (idx1 < wholeMax1)
-          {
-            ptr += inInc1;
-            array.push_back(*ptr);
-          }
-          if (idx1 + 1 < wholeMax1)
+          else
           {
-            ptr += inInc1;
+            // compute median of + neighborhood
+            // note that y axis direction is up in vtk images, not down
+            // as in screen coordinates
+            array.clear();
+            // Center
+            ptr = inPtrC;
             array.push_back(*ptr);
-          }
+            // left
+            ptr = inPtrC;
+            if (idx0 > wholeMin0)
+            {
+              ptr -= inInc0;
+              array.push_back(*ptr);
+            }
+            if (idx0 - 1 > wholeMin0)
+            {
+              ptr -= inInc0;
+              array.push_back(*ptr);
+            }
+            // right
+            ptr = inPtrC;
+            if (idx0 < wholeMax0)
+            {
+              ptr += inInc0;
+              array.push_back(*ptr);
+            }
+            if (idx0 + 1 < wholeMax0)
+            {
+              ptr += inInc0;
+              array.push_back(*ptr);
+            }
+            // down
+            ptr = inPtrC;
+            if (idx1 > wholeMin1)
+            {
+              ptr -= inInc1;
+              array.push_back(*ptr);
+            }
+            if (idx1 - 1 > wholeMin1)
+            {
+              ptr -= inInc1;
+              array.push_back(*ptr);
+            }
+            // up
+            ptr = inPtrC;
+            if (idx1 < wholeMax1)
+            {
+              ptr += inInc1;
+              array.push_back(*ptr);
+            }
+            if (idx1 + 1 < wholeMax1)
+            {
+              ptr += inInc1;
+              array.push_back(*ptr);
+            }
 
-          std::sort(array.begin(), array.end());
-          median1 = array[static_cast<unsigned int>(0.5 * array.size())];
+            std::sort(array.begin(), array.end());
+            median1 = array[static_cast<unsigned int>(0.5 * array.size())];
 
-          // compute median of x neighborhood
-          // note that y axis direction is up in vtk images, not down
-          // as in screen coordinates
-          array.clear();
-          // Center
-          ptr = inPtrC;
-          array.push_back(*ptr);
-          // lower left
-          if (idx0 > wholeMin0 && idx1 > wholeMin1)
-          {
-            ptr -= inInc0 + inInc1;
-            array.push_back(*ptr);
-          }
-          if (idx0 - 1 > wholeMin0 && idx1 - 1 > wholeMin1)
-          {
-            ptr -= inInc0 + inInc1;
-            array.push_back(*ptr);
-          }
-          // upper right
-          ptr = inPtrC;
-          if (idx0 < wholeMax0 && idx1 < wholeMax1)
-          {
-            ptr += inInc0 + inInc1;
-            array.push_back(*ptr);
-          }
-          if (idx0 + 1 < wholeMax0 && idx1 + 1 < wholeMax1)
-          {
-            ptr += inInc0 + inInc1;
+            // compute median of x neighborhood
+            // note that y axis direction is up in vtk images, not down
+            // as in screen coordinates
+            array.clear();
+            // Center
+            ptr = inPtrC;
             array.push_back(*ptr);
-          }
-          // upper left
-          ptr = inPtrC;
-          if (idx0 > wholeMin0 && idx1 < wholeMax1)
-          {
-            ptr += -inInc0 + inInc1;
-            array.push_back(*ptr);
-          }
-          if (idx0 - 1 > wholeMin0 && idx1 + 1 < wholeMax1)
-          {
-            ptr += -inInc0 + inInc1;
-            array.push_back(*ptr);
-          }
-          // lower right
-          ptr = inPtrC;
-          if (idx0 < wholeMax0 && idx1 > wholeMin1)
-          {
-            ptr += inInc0 - inInc1;
-            array.push_back(*ptr);
-          }
-          if (idx0 + 1 < wholeMax0 && idx1 - 1 > wholeMin1)
-          {
-            ptr += inInc0 - inInc1;
-            array.push_back(*ptr);
-          }
+            // lower left
+            if (idx0 > wholeMin0 && idx1 > wholeMin1)
+            {
+              ptr -= inInc0 + inInc1;
+              array.push_back(*ptr);
+            }
+            if (idx0 - 1 > wholeMin0 && idx1 - 1 > wholeMin1)
+            {
+              ptr -= inInc0 + inInc1;
+              array.push_back(*ptr);
+            }
+            // upper right
+            ptr = inPtrC;
+            if (idx0 < wholeMax0 && idx1 < wholeMax1)
+            {
+              ptr += inInc0 + inInc1;
+              array.push_back(*ptr);
+            }
+            if (idx0 + 1 < wholeMax0 && idx1 + 1 < wholeMax1)
+            {
+              ptr += inInc0 + inInc1;
+              array.push_back(*ptr);
+            }
+            // upper left
+            ptr = inPtrC;
+            if (idx0 > wholeMin0 && idx1 < wholeMax1)
+            {
+              ptr += -inInc0 + inInc1;
+              array.push_back(*ptr);
+            }
+            if (idx0 - 1 > wholeMin0 && idx1 + 1 < wholeMax1)
+            {
+              ptr += -inInc0 + inInc1;
+              array.push_back(*ptr);
+            }
+            // lower right
+            ptr = inPtrC;
+            if (idx0 < wholeMax0 && idx1 > wholeMin1)
+            {
+              ptr += inInc0 - inInc1;
+              array.push_back(*ptr);
+            }
+            if (idx0 + 1 < wholeMax0 && idx1 - 1 > wholeMin1)
+            {
+              ptr += inInc0 - inInc1;
+              array.push_back(*ptr);
+            }
 
-          std::sort(array.begin(), array.end());
-          median2 = array[static_cast<unsigned int>(0.5 * array.size())];
+            std::sort(array.begin(), array.end());
+            median2 = array[static_cast<unsigned int>(0.5 * array.size())];
+          }
 
           // Compute the median of the three. (med1, med2 and center)
           if (median1 > median2)
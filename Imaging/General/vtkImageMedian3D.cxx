@@ -11,7 +11,12 @@
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
-#include <algorithm> // for std::nth_element
+#include <algorithm>   // for std::merge
+#include <cmath>       // for std::isnan
+#include <iterator>    // for std::back_inserter
+#include <limits>      // for std::numeric_limits
+#include <type_traits> // for std::is_integral
+#include <vector>      // for std::vector
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageMedian3D);
@@ -21,6 +26,7 @@ vtkStandardNewMacro(vtkImageMedian3D);
 vtkImageMedian3D::vtkImageMedian3D()
 {
   this->NumberOfElements = 0;
+  this->Percentile = 50.0;
   this->SetKernelSize(1, 1, 1);
   this->HandleBoundaries = 1;
 }
@@ -34,6 +40,7 @@ void vtkImageMedian3D::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfElements: " << this->NumberOfElements << endl;
+  os << indent << "Percentile: " << this->Percentile << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -72,112 +79,327 @@ namespace
 {
 
 //------------------------------------------------------------------------------
-// Compute the median with std::nth_element
+// The median of an even number of values, from the two middle values.
 template <class T>
-T vtkComputeMedianOfArray(T* aBegin, T* aEnd)
+T vtkMedianOfPair(T low, T high)
 {
-  T* aMid = aBegin + (aEnd - aBegin) / 2;
-  std::nth_element(aBegin, aMid, aEnd);
-  T m = *aMid;
+  return static_cast<T>(low + (high - low) / 2);
+}
 
-  // if even size, get max of lower part of array and compute the average
-  if (aMid - aBegin == aEnd - aMid)
+//------------------------------------------------------------------------------
+// The columns of values of the neighborhood, one per position along the
+// rows, kept in a ring so that the values leaving the neighborhood do not
+// have to be read again.
+template <class T>
+class vtkMedianColumns
+{
+public:
+  // One more column is kept, so that a removed column remains valid until
+  // the next one is added.
+  explicit vtkMedianColumns(int maxNumberOfColumns)
+    : Columns(maxNumberOfColumns + 1)
   {
-    T* lowMid = std::max_element(aBegin, aMid);
-    m = *lowMid + (m - *lowMid) / 2;
   }
 
-  return m;
-}
+  // Return the storage for the column that will be added next.
+  std::vector<T>& GetNextColumn()
+  {
+    std::vector<T>& column = this->Columns[(this->First + this->Size) % this->Columns.size()];
+    column.clear();
+    return column;
+  }
+
+  int GetNumberOfColumns() const { return this->Size; }
+
+protected:
+  std::vector<T>& AddColumn()
+  {
+    return this->Columns[(this->First + this->Size++) % this->Columns.size()];
+  }
+
+  std::vector<T>& RemoveColumn()
+  {
+    std::vector<T>& column = this->Columns[this->First];
+    this->First = (this->First + 1) % this->Columns.size();
+    --this->Size;
+    return column;
+  }
+
+private:
+  std::vector<std::vector<T>> Columns;
+  size_t First = 0;
+  int Size = 0;
+};
+
+//------------------------------------------------------------------------------
+// The values of the neighborhood of 8 and 16 bit integer types, counted in a
+// histogram with 256 coarse bins of 256 fine bins each. The values are
+// selected with a cursor that moves from the previous selection, by coarse
+// bins when it can, since the rank changes little from one voxel to the next.
+template <class T>
+class vtkMedianHistogram : public vtkMedianColumns<T>
+{
+public:
+  explicit vtkMedianHistogram(int maxNumberOfColumns)
+    : vtkMedianColumns<T>(maxNumberOfColumns)
+    , Coarse(256, 0)
+    , Fine(65536, 0)
+  {
+  }
+
+  // Add the values of the next column to the neighborhood.
+  void Push()
+  {
+    const std::vector<T>& column = this->AddColumn();
+    for (T value : column)
+    {
+      const int key = vtkMedianHistogram::Key(value);
+      ++this->Coarse[key >> 8];
+      ++this->Fine[key];
+      this->Below += (key < this->Cursor);
+    }
+    this->Count += static_cast<vtkIdType>(column.size());
+  }
+
+  // Remove the values of the first column from the neighborhood.
+  void Pop()
+  {
+    const std::vector<T>& column = this->RemoveColumn();
+    for (T value : column)
+    {
+      const int key = vtkMedianHistogram::Key(value);
+      --this->Coarse[key >> 8];
+      --this->Fine[key];
+      this->Below -= (key < this->Cursor);
+    }
+    this->Count -= static_cast<vtkIdType>(column.size());
+  }
+
+  vtkIdType GetCount() const { return this->Count; }
+
+  // Return the value of the given rank among the sorted values.
+  T Select(vtkIdType rank)
+  {
+    // Move down until the cursor is not above the rank
+    while (this->Below > rank)
+    {
+      if ((this->Cursor & 255) == 0 && this->Below - this->Coarse[(this->Cursor >> 8) - 1] > rank)
+      {
+        this->Cursor -= 256;
+        this->Below -= this->Coarse[this->Cursor >> 8];
+      }
+      else
+      {
+        this->Below -= this->Fine[--this->Cursor];
+      }
+    }
+    // Move up until the bin of the cursor holds the rank
+    for (;;)
+    {
+      if ((this->Cursor & 255) == 0 && this->Below + this->Coarse[this->Cursor >> 8] <= rank)
+      {
+        this->Below += this->Coarse[this->Cursor >> 8];
+        this->Cursor += 256;
+      }
+      else if (this->Below + this->Fine[this->Cursor] <= rank)
+      {
+        this->Below += this->Fine[this->Cursor++];
+      }
+      else
+      {
+        break;
+      }
+    }
+    return vtkMedianHistogram::Value(this->Cursor);
+  }
+
+  void Clear()
+  {
+    while (this->GetNumberOfColumns() > 0)
+    {
+      this->Pop();
+    }
+  }
+
+private:
+  static int Key(T value)
+  {
+    return static_cast<int>(value) - static_cast<int>(std::numeric_limits<T>::min());
+  }
+  static T Value(int key)
+  {
+    return static_cast<T>(key + static_cast<int>(std::numeric_limits<T>::min()));
+  }
+
+  std::vector<int> Coarse;
+  std::vector<int> Fine;
+  vtkIdType Count = 0;
+  int Cursor = 0;      // The key of the last selected value
+  vtkIdType Below = 0; // The number of values below the cursor
+};
+
+//------------------------------------------------------------------------------
+// The order of the sorted window. NaNs are placed after all the other values,
+// so that floating point values still have a strict weak ordering.
+template <class T, bool IsFloat = std::is_floating_point<T>::value>
+struct vtkMedianLess
+{
+  bool operator()(T a, T b) const { return a < b; }
+};
+
+template <class T>
+struct vtkMedianLess<T, true>
+{
+  bool operator()(T a, T b) const { return a < b || (!std::isnan(a) && std::isnan(b)); }
+};
+
+//------------------------------------------------------------------------------
+// The values of the neighborhood of the other types, kept sorted. Each column
+// is sorted once when it enters the neighborhood. The column that leaves the
+// neighborhood and the one that enters it are merged with the window in a
+// single pass, so each step costs the number of values of the window.
+template <class T>
+class vtkMedianSortedWindow : public vtkMedianColumns<T>
+{
+public:
+  explicit vtkMedianSortedWindow(int maxNumberOfColumns)
+    : vtkMedianColumns<T>(maxNumberOfColumns)
+  {
+  }
+
+  void Push()
+  {
+    const vtkMedianLess<T> less;
+    std::vector<T>& column = this->AddColumn();
+    std::sort(column.begin(), column.end(), less);
+    this->Merged.resize(this->Window.size() + column.size());
+    if (this->Removed)
+    {
+      // Skip the removed values, which are all in the window, while merging.
+      auto removed = this->Removed->begin();
+      auto added = column.begin();
+      auto merged = this->Merged.begin();
+      for (T value : this->Window)
+      {
+        if (removed != this->Removed->end() && !less(value, *removed) && !less(*removed, value))
+        {
+          ++removed;
+          continue;
+        }
+        while (added != column.end() && less(*added, value))
+        {
+          *merged++ = *added++;
+        }
+        *merged++ = value;
+      }
+      merged = std::copy(added, column.end(), merged);
+      this->Merged.resize(merged - this->Merged.begin());
+      this->Removed = nullptr;
+    }
+    else
+    {
+      std::merge(this->Window.begin(), this->Window.end(), column.begin(), column.end(),
+        this->Merged.begin(), less);
+    }
+    this->Window.swap(this->Merged);
+  }
+
+  void Pop()
+  {
+    this->Flush();
+    this->Removed = &this->RemoveColumn();
+  }
+
+  vtkIdType GetCount()
+  {
+    this->Flush();
+    return static_cast<vtkIdType>(this->Window.size());
+  }
+
+  T Select(vtkIdType rank) const { return this->Window[rank]; }
+
+  void Clear()
+  {
+    while (this->GetNumberOfColumns() > 0)
+    {
+      this->RemoveColumn();
+    }
+    this->Window.clear();
+    this->Removed = nullptr;
+  }
+
+private:
+  // Remove the last removed column from the window, when no column was added.
+  void Flush()
+  {
+    if (this->Removed)
+    {
+      this->Merged.clear();
+      std::set_difference(this->Window.begin(), this->Window.end(), this->Removed->begin(),
+        this->Removed->end(), std::back_inserter(this->Merged), vtkMedianLess<T>());
+      this->Window.swap(this->Merged);
+      this->Removed = nullptr;
+    }
+  }
+
+  std::vector<T> Window;
+  std::vector<T> Merged;
+  const std::vector<T>* Removed = nullptr;
+};
+
+//------------------------------------------------------------------------------
+// The histogram is used for the integer types with at most 16 bits.
+template <class T, bool UseHistogram = (std::is_integral<T>::value && sizeof(T) <= 2)>
+struct vtkMedianWindow
+{
+  using Type = vtkMedianSortedWindow<T>;
+};
+
+template <class T>
+struct vtkMedianWindow<T, true>
+{
+  using Type = vtkMedianHistogram<T>;
+};
 
 } // end anonymous namespace
 
 //------------------------------------------------------------------------------
-// This method contains the second switch statement that calls the correct
-// templated function for the mask types.
+// The neighborhood of each output voxel is clipped by the input extent, and
+// slides along the rows: only the columns of values that leave and enter the
+// neighborhood update the window.
 template <class T>
 void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* inPtr,
   vtkImageData* outData, T* outPtr, int outExt[6], int id, vtkDataArray* inArray)
 {
-  int *kernelMiddle, *kernelSize;
-  // For looping though output (and input) pixels.
-  int outIdx0, outIdx1, outIdx2;
-  vtkIdType inInc0, inInc1, inInc2;
-  int outIdxC;
-  vtkIdType outIncX, outIncY, outIncZ;
-  T *inPtr0, *inPtr1, *inPtr2;
-  // For looping through hood pixels
-  int hoodMin0, hoodMax0, hoodMin1, hoodMax1, hoodMin2, hoodMax2;
-  int hoodStartMin0, hoodStartMax0, hoodStartMin1, hoodStartMax1;
-  int hoodIdx0, hoodIdx1, hoodIdx2;
-  T *tmpPtr0, *tmpPtr1, *tmpPtr2;
-  // The portion of the out image that needs no boundary processing.
-  int middleMin0, middleMax0, middleMin1, middleMax1, middleMin2, middleMax2;
-  int numComp;
-  int* inExt;
-  unsigned long count = 0;
-  unsigned long target;
-
   if (!inArray)
   {
     return;
   }
 
-  // Array used to compute the median
-  T* workArray = new T[self->GetNumberOfElements()];
+  typename vtkMedianWindow<T>::Type window(self->GetKernelSize()[0]);
 
   // Get information to march through data
+  vtkIdType inInc0, inInc1, inInc2;
+  vtkIdType outInc0, outInc1, outInc2;
   inData->GetIncrements(inInc0, inInc1, inInc2);
-  outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
-  kernelMiddle = self->GetKernelMiddle();
-  kernelSize = self->GetKernelSize();
-
-  numComp = inArray->GetNumberOfComponents();
-
-  hoodMin0 = outExt[0] - kernelMiddle[0];
-  hoodMin1 = outExt[2] - kernelMiddle[1];
-  hoodMin2 = outExt[4] - kernelMiddle[2];
-  hoodMax0 = kernelSize[0] + hoodMin0 - 1;
-  hoodMax1 = kernelSize[1] + hoodMin1 - 1;
-  hoodMax2 = kernelSize[2] + hoodMin2 - 1;
-
-  // Clip by the input image extent
-  inExt = inData->GetExtent();
-  hoodMin0 = (hoodMin0 > inExt[0]) ? hoodMin0 : inExt[0];
-  hoodMin1 = (hoodMin1 > inExt[2]) ? hoodMin1 : inExt[2];
-  hoodMin2 = (hoodMin2 > inExt[4]) ? hoodMin2 : inExt[4];
-  hoodMax0 = (hoodMax0 < inExt[1]) ? hoodMax0 : inExt[1];
-  hoodMax1 = (hoodMax1 < inExt[3]) ? hoodMax1 : inExt[3];
-  hoodMax2 = (hoodMax2 < inExt[5]) ? hoodMax2 : inExt[5];
-
-  // Save the starting neighborhood dimensions (2 loops only once)
-  hoodStartMin0 = hoodMin0;
-  hoodStartMax0 = hoodMax0;
-  hoodStartMin1 = hoodMin1;
-  hoodStartMax1 = hoodMax1;
-
-  // The portion of the output that needs no boundary computation.
-  middleMin0 = inExt[0] + kernelMiddle[0];
-  middleMax0 = inExt[1] - (kernelSize[0] - 1) + kernelMiddle[0];
-  middleMin1 = inExt[2] + kernelMiddle[1];
-  middleMax1 = inExt[3] - (kernelSize[1] - 1) + kernelMiddle[1];
-  middleMin2 = inExt[4] + kernelMiddle[2];
-  middleMax2 = inExt[5] - (kernelSize[2] - 1) + kernelMiddle[2];
-
-  target =
+  outData->GetIncrements(outInc0, outInc1, outInc2);
+  const int* kernelMiddle = self->GetKernelMiddle();
+  const int* kernelSize = self->GetKernelSize();
+  const int* inExt = inData->GetExtent();
+  const int numComp = inArray->GetNumberOfComponents();
+  const double percentile = self->GetPercentile();
+
+  unsigned long count = 0;
+  unsigned long target =
     static_cast<unsigned long>((outExt[5] - outExt[4] + 1) * (outExt[3] - outExt[2] + 1) / 50.0);
   target++;
 
-  // loop through pixel of output
-  inPtr = static_cast<T*>(inArray->GetVoidPointer((hoodMin0 - inExt[0]) * inInc0 +
-    (hoodMin1 - inExt[2]) * inInc1 + (hoodMin2 - inExt[4]) * inInc2));
-  inPtr2 = inPtr;
-  for (outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
+  for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
   {
-    inPtr1 = inPtr2;
-    hoodMin1 = hoodStartMin1;
-    hoodMax1 = hoodStartMax1;
-    for (outIdx1 = outExt[2]; !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
+    // The neighborhood, clipped by the input image extent
+    const int hoodMin2 = std::max(outIdx2 - kernelMiddle[2], inExt[4]);
+    const int hoodMax2 = std::min(outIdx2 - kernelMiddle[2] + kernelSize[2] - 1, inExt[5]);
+    for (int outIdx1 = outExt[2]; !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
     {
       if (!id)
       {
@@ -187,76 +409,74 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
         }
         count++;
       }
-      inPtr0 = inPtr1;
-      hoodMin0 = hoodStartMin0;
-      hoodMax0 = hoodStartMax0;
-      for (outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
-      {
-        for (outIdxC = 0; outIdxC < numComp; outIdxC++)
-        {
-          // Compute median of neighborhood
-          T* workEnd = workArray;
+      const int hoodMin1 = std::max(outIdx1 - kernelMiddle[1], inExt[2]);
+      const int hoodMax1 = std::min(outIdx1 - kernelMiddle[1] + kernelSize[1] - 1, inExt[3]);
+      T* outPtr1 = outPtr + (outIdx1 - outExt[2]) * outInc1 + (outIdx2 - outExt[4]) * outInc2;
 
-          // loop through neighborhood pixels
-          tmpPtr2 = inPtr0 + outIdxC;
-          for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
+      for (int outIdxC = 0; outIdxC < numComp; ++outIdxC)
+      {
+        // Add the column of neighborhood values at hoodIdx0
+        auto push = [&](int hoodIdx0) {
+          std::vector<T>& column = window.GetNextColumn();
+          for (int hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
           {
-            tmpPtr1 = tmpPtr2;
-            for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
+            const T* tmpPtr = inPtr + (hoodIdx0 - inExt[0]) * inInc0 +
+              (hoodMin1 - inExt[2]) * inInc1 + (hoodIdx2 - inExt[4]) * inInc2 + outIdxC;
+            for (int hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
             {
-              tmpPtr0 = tmpPtr1;
-              for (hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
-              {
-                // Add this pixel to the median
-                *workEnd++ = *tmpPtr0;
-                tmpPtr0 += inInc0;
-              }
-              tmpPtr1 += inInc1;
+              column.push_back(*tmpPtr);
+              tmpPtr += inInc1;
             }
-            tmpPtr2 += inInc2;
           }
+          window.Push();
+        };
 
-          // Replace this pixel with the hood median
-          *outPtr++ = vtkComputeMedianOfArray(workArray, workEnd);
-        }
-
-        // shift neighborhood considering boundaries
-        if (outIdx0 >= middleMin0)
+        int hoodMin0 = std::max(outExt[0] - kernelMiddle[0], inExt[0]);
+        int hoodMax0 = std::min(outExt[0] - kernelMiddle[0] + kernelSize[0] - 1, inExt[1]);
+        for (int hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
         {
-          inPtr0 += inInc0;
-          ++hoodMin0;
+          push(hoodIdx0);
         }
-        if (outIdx0 < middleMax0)
+
+        for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
         {
-          ++hoodMax0;
+          // Slide the neighborhood
+          if (outIdx0 > outExt[0])
+          {
+            if (outIdx0 - kernelMiddle[0] > hoodMin0)
+            {
+              window.Pop();
+              ++hoodMin0;
+            }
+            if (outIdx0 - kernelMiddle[0] + kernelSize[0] - 1 <= inExt[1])
+            {
+              push(++hoodMax0);
+            }
+          }
+
+          // Replace this pixel with the hood percentile
+          const vtkIdType n = window.GetCount();
+          T value;
+          if (percentile == 50.0)
+          {
+            value = window.Select(n / 2);
+            if (n % 2 == 0)
+            {
+              value = vtkMedianOfPair(window.Select(n / 2 - 1), value);
+            }
+          }
+          else
+          {
+            value = window.Select(static_cast<vtkIdType>(percentile * (n - 1) / 100.0 + 0.5));
+          }
+          outPtr1[(outIdx0 - outExt[0]) * outInc0 + outIdxC] = value;
         }
+
+        // Empty the window for the next row
+        window.Clear();
       }
-      // shift neighborhood considering boundaries
-      if (outIdx1 >= middleMin1)
-      {
-        inPtr1 += inInc1;
-        ++hoodMin1;
-      }
-      if (outIdx1 < middleMax1)
-      {
-        ++hoodMax1;
-      }
-      outPtr += outIncY;
     }
-    // shift neighborhood considering boundaries
-    if (outIdx2 >= middleMin2)
-    {
-      inPtr2 += inInc2;
-      ++hoodMin2;
-    }
-    if (outIdx2 < middleMax2)
-    {
-      ++hoodMax2;
-    }
-    outPtr += outIncZ;
   }
-
-  delete[] workArray;
 }
 
 //------------------------------------------------------------------------------
@@ -8,7 +8,18 @@
  * median value from a rectangular neighborhood around that pixel.
  * Neighborhoods can be no more than 3 dimensional.  Setting one
  * axis of the neighborhood kernelSize to 1 changes the filter
- * into a 2D median.
+ * into a 2D median. It can also compute any other percentile of the
+ * neighborhood, such as the minimum or the maximum, see SetPercentile().
+ *
+ * The neighborhood slides along the rows of the image: at each step, the
+ * values that leave and enter the neighborhood update a histogram for
+ * 8 and 16 bit integer types (with a coarse and a fine level, as described
+ * by Perreault and Hebert), or a sorted window for the other types. With the
+ * histogram, the cost per output voxel grows with the area of the kernel
+ * cross-section rather than with its volume. The sorted window is merged
+ * with the entering and leaving values in O(kernel volume) per output voxel,
+ * which avoids the sort of the whole neighborhood. NaN values are sorted
+ * after all the other values.
  */
 
 #ifndef vtkImageMedian3D_h
@@ -38,11 +49,25 @@ public:
   vtkGetMacro(NumberOfElements, int);
   ///@}
 
+  ///@{
+  /**
+   * Set the percentile of the neighborhood values that replaces each voxel,
+   * from 0 (the minimum) to 100 (the maximum). The default of 50 gives the
+   * median, for which the two middle values are averaged when the number of
+   * values is even (at the boundaries, or for even kernel sizes). Any other
+   * percentile p gives the value of rank p*(n-1)/100, rounded to the
+   * nearest, among the n sorted values.
+   */
+  vtkSetClampMacro(Percentile, double, 0.0, 100.0);
+  vtkGetMacro(Percentile, double);
+  ///@}
+
 protected:
   vtkImageMedian3D();
   ~vtkImageMedian3D() override;
 
   int NumberOfElements;
+  double Percentile;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkImageRecursiveGaussianInternal
+ * @brief   recursive gaussian filtering of the lines of an image
+ *
+ * This file implements the third order recursive approximation of the
+ * gaussian by Young and van Vliet, used by vtkImageGaussianSmooth when
+ * Recursive is on and by vtkImageGradient when its StandardDeviation is
+ * positive. A causal and an anti-causal recursion are applied along each
+ * line, so that the cost per voxel does not depend on the standard deviation.
+ * The boundaries are handled as if the first and last values of each line were
+ * repeated forever, with the initialization of the anti-causal recursion
+ * given by Triggs and Sdika.
+ *
+ * The lines are filtered in groups of adjacent lines that are gathered in an
+ * interleaved buffer, so that the recursions vectorize across the lines, and
+ * the groups are dispatched with vtkSMPTools.
+ *
+ * See I.T. Young and L.J. van Vliet, "Recursive implementation of the
+ * Gaussian filter", Signal Processing 44, 1995, and B. Triggs and M. Sdika,
+ * "Boundary conditions for Young-van Vliet recursive filtering", IEEE
+ * Transactions on Signal Processing 54, 2006.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkImageGaussianSmooth vtkImageGradient
+ */
+
+#ifndef vtkImageRecursiveGaussianInternal_h
+#define vtkImageRecursiveGaussianInternal_h
+
+#include "vtkSMPTools.h"
+#include "vtkType.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Number of lines that are filtered together.
+constexpr int VTK_RECURSIVE_GAUSSIAN_LANES = 16;
+
+// The coefficients of the recursions for a standard deviation in pixels.
+struct vtkRecursiveGaussian
+{
+  bool Identity;
+  double B;
+  double A[3];
+  // Response of the anti-causal recursion after the end of a line, to the
+  // deviation of the last three values of the causal recursion from the
+  // value at the end of the line.
+  double M[3][3];
+
+  explicit vtkRecursiveGaussian(double sigma)
+  {
+    this->Identity = !(sigma > 0.0);
+    sigma = std::max(sigma, 0.5);
+    double q;
+    if (sigma >= 2.5)
+    {
+      q = 0.98711 * sigma - 0.96330;
+    }
+    else
+    {
+      q = 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma);
+    }
+    const double q2 = q * q;
+    const double q3 = q2 * q;
+    const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    this->A[0] = (2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+    this->A[1] = -(1.4281 * q2 + 1.26661 * q3) / b0;
+    this->A[2] = 0.422205 * q3 / b0;
+    this->B = 1.0 - this->A[0] - this->A[1] - this->A[2];
+
+    // Run both recursions past the end of the line until the deviations
+    // have vanished, instead of using the closed form of the matrix.
+    const int n = static_cast<int>(40.0 * q) + 64;
+    std::vector<double> d(n + 6);
+    std::vector<double> e(n + 6);
+    for (int j = 0; j < 3; ++j)
+    {
+      std::fill(d.begin(), d.end(), 0.0);
+      std::fill(e.begin(), e.end(), 0.0);
+      d[2 - j] = 1.0;
+      for (int k = 3; k < n + 3; ++k)
+      {
+        d[k] = this->A[0] * d[k - 1] + this->A[1] * d[k - 2] + this->A[2] * d[k - 3];
+      }
+      for (int k = n + 2; k >= 3; --k)
+      {
+        e[k] = this->B * d[k] + this->A[0] * e[k + 1] + this->A[1] * e[k + 2] +
+          this->A[2] * e[k + 3];
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        this->M[i][j] = e[3 + i];
+      }
+    }
+  }
+
+  // Filter the interleaved lines of length n in place.
+  void FilterLanes(double* buffer, int n) const
+  {
+    const int lanes = VTK_RECURSIVE_GAUSSIAN_LANES;
+    const double b = this->B;
+    const double a1 = this->A[0];
+    const double a2 = this->A[1];
+    const double a3 = this->A[2];
+    double first[lanes], last[lanes], p1[lanes], p2[lanes], p3[lanes];
+    for (int l = 0; l < lanes; ++l)
+    {
+      first[l] = buffer[l];
+      last[l] = buffer[(n - 1) * lanes + l];
+      p1[l] = first[l];
+      p2[l] = first[l];
+      p3[l] = first[l];
+    }
+
+    // causal recursion, steady state before the start of the line
+    for (int i = 0; i < n; ++i)
+    {
+      double* row = buffer + i * lanes;
+      for (int l = 0; l < lanes; ++l)
+      {
+        const double w = b * row[l] + a1 * p1[l] + a2 * p2[l] + a3 * p3[l];
+        p3[l] = p2[l];
+        p2[l] = p1[l];
+        p1[l] = w;
+        row[l] = w;
+      }
+    }
+
+    // initialization of the anti-causal recursion after the end of the line
+    for (int l = 0; l < lanes; ++l)
+    {
+      double dev[3];
+      for (int j = 0; j < 3; ++j)
+      {
+        dev[j] = (n - 1 - j >= 0 ? buffer[(n - 1 - j) * lanes + l] : first[l]) - last[l];
+      }
+      p1[l] =
+        last[l] + this->M[0][0] * dev[0] + this->M[0][1] * dev[1] + this->M[0][2] * dev[2];
+      p2[l] =
+        last[l] + this->M[1][0] * dev[0] + this->M[1][1] * dev[1] + this->M[1][2] * dev[2];
+      p3[l] =
+        last[l] + this->M[2][0] * dev[0] + this->M[2][1] * dev[1] + this->M[2][2] * dev[2];
+    }
+
+    // anti-causal recursion
+    for (int i = n - 1; i >= 0; --i)
+    {
+      double* row = buffer + i * lanes;
+      for (int l = 0; l < lanes; ++l)
+      {
+        const double y = b * row[l] + a1 * p1[l] + a2 * p2[l] + a3 * p3[l];
+        p3[l] = p2[l];
+        p2[l] = p1[l];
+        p1[l] = y;
+        row[l] = y;
+      }
+    }
+  }
+};
+
+template <class T>
+inline typename std::enable_if<std::is_integral<T>::value, T>::type vtkRecursiveGaussianCast(
+  double value)
+{
+  // the approximation of the gaussian can slightly overshoot
+  value = std::min(value, static_cast<double>(std::numeric_limits<T>::max()));
+  value = std::max(value, static_cast<double>(std::numeric_limits<T>::min()));
+  return static_cast<T>(value);
+}
+
+template <class T>
+inline typename std::enable_if<!std::is_integral<T>::value, T>::type vtkRecursiveGaussianCast(
+  double value)
+{
+  return static_cast<T>(value);
+}
+
+// Filter all the lines along the given axis. The input lines start at inPtr
+// and have inSize values, the output lines start at outPtr and are the part
+// of the filtered input lines that starts at outStart and has
+// outSize[axis] values. The increments are in scalars, and the input and
+// output may be the same memory when all their lines coincide.
+template <class IT, class OT>
+void vtkRecursiveGaussianAxis(const vtkRecursiveGaussian& gauss, int axis, const IT* inPtr,
+  const vtkIdType inIncs[3], int inSize, OT* outPtr, const vtkIdType outIncs[3],
+  const int outSize[3], int outStart, int numComp)
+{
+  const int lanes = VTK_RECURSIVE_GAUSSIAN_LANES;
+  // the lanes are the scalars along the first of the other axes
+  const int axisU = (axis == 0 ? 1 : 0);
+  const int axisV = (axis == 2 ? 1 : 2);
+  const vtkIdType numLanes = static_cast<vtkIdType>(outSize[axisU]) * numComp;
+  const vtkIdType numGroups = (numLanes + lanes - 1) / lanes;
+  const vtkIdType inIncA = inIncs[axis];
+  const vtkIdType outIncA = outIncs[axis];
+  const int outLength = outSize[axis];
+  if (numLanes == 0 || outSize[axisV] == 0 || outLength == 0)
+  {
+    return;
+  }
+
+  vtkSMPTools::For(0, numGroups * outSize[axisV], [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double> buffer(static_cast<size_t>(inSize) * lanes);
+    vtkIdType inOffsets[lanes], outOffsets[lanes];
+    for (vtkIdType task = begin; task < end; ++task)
+    {
+      const vtkIdType v = task / numGroups;
+      const vtkIdType firstLane = (task % numGroups) * lanes;
+      const int count = static_cast<int>(std::min<vtkIdType>(lanes, numLanes - firstLane));
+      for (int l = 0; l < count; ++l)
+      {
+        const vtkIdType u = (firstLane + l) / numComp;
+        const vtkIdType c = (firstLane + l) % numComp;
+        inOffsets[l] = u * inIncs[axisU] + v * inIncs[axisV] + c;
+        outOffsets[l] = u * outIncs[axisU] + v * outIncs[axisV] + c;
+      }
+
+      // gather the lines, the unused lanes are filtered as zeros
+      for (int i = 0; i < inSize; ++i)
+      {
+        double* row = buffer.data() + static_cast<size_t>(i) * lanes;
+        const IT* inLine = inPtr + i * inIncA;
+        int l = 0;
+        for (; l < count; ++l)
+        {
+          row[l] = static_cast<double>(inLine[inOffsets[l]]);
+        }
+        for (; l < lanes; ++l)
+        {
+          row[l] = 0.0;
+        }
+      }
+
+      if (!gauss.Identity)
+      {
+        gauss.FilterLanes(buffer.data(), inSize);
+      }
+
+      for (int i = 0; i < outLength; ++i)
+      {
+        const double* row = buffer.data() + static_cast<size_t>(outStart + i) * lanes;
+        OT* outLine = outPtr + i * outIncA;
+        for (int l = 0; l < count; ++l)
+        {
+          outLine[outOffsets[l]] = vtkRecursiveGaussianCast<OT>(row[l]);
+        }
+      }
+    }
+  });
+}
+
+} // anonymous namespace
+
+#endif // vtkImageRecursiveGaussianInternal_h
+// VTK-HeaderTest-Exclude: vtkImageRecursiveGaussianInternal.h
@@ -15,6 +15,8 @@
 #include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkSampleFunction);
 vtkCxxSetObjectMacro(vtkSampleFunction, ImplicitFunction, vtkImplicitFunction);
@@ -54,22 +56,32 @@ public:
 
     void operator()(vtkIdType k, vtkIdType end)
     {
-      double x[3];
+      // The function is evaluated one row of samples at a time.
       vtkIdType* extent = this->Algo->Extent;
+      const vtkIdType rowSize = this->Algo->Dims[0];
+      std::vector<double> points(3 * rowSize);
+      std::vector<double> values(rowSize);
       vtkIdType i, j, jOffset, kOffset;
       for (; k < end; ++k)
       {
-        x[2] = this->Algo->Origin[2] + k * this->Algo->Spacing[2];
+        const double z = this->Algo->Origin[2] + k * this->Algo->Spacing[2];
         kOffset = (k - extent[4]) * this->Algo->SliceSize;
         for (j = extent[2]; j <= extent[3]; ++j)
         {
-          x[1] = this->Algo->Origin[1] + j * this->Algo->Spacing[1];
-          jOffset = (j - extent[2]) * this->Algo->Dims[0];
-          for (i = extent[0]; i <= extent[1]; ++i)
+          const double y = this->Algo->Origin[1] + j * this->Algo->Spacing[1];
+          jOffset = (j - extent[2]) * rowSize;
+          double* x = points.data();
+          for (i = extent[0]; i <= extent[1]; ++i, x += 3)
           {
             x[0] = this->Algo->Origin[0] + i * this->Algo->Spacing[0];
-            this->Algo->Scalars[(i - extent[0]) + jOffset + kOffset] =
-              static_cast<TT>(this->Algo->ImplicitFunction->FunctionValue(x));
+            x[1] = y;
+            x[2] = z;
+          }
+          this->Algo->ImplicitFunction->FunctionValueBatch(points.data(), values.data(), rowSize);
+          TT* scalars = this->Algo->Scalars + jOffset + kOffset;
+          for (i = 0; i < rowSize; ++i)
+          {
+            scalars[i] = static_cast<TT>(values[i]);
           }
         }
       }
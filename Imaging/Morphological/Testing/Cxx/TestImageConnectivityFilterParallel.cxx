@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Test that the parallel labeling of vtkImageConnectivityFilter gives the
+// same output as the serial fill, for all the label and extraction modes.
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageConnectivityFilter.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <iostream>
+
+namespace
+{
+// An image of random blobs, with many small regions.
+void MakeImage(vtkImageData* image, int nx, int ny, int nz)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(nx + ny + nz);
+  image->SetExtent(2, nx + 1, -3, ny - 4, 0, nz - 1);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* values = static_cast<short*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); i++)
+  {
+    values[i] = static_cast<short>(random->GetNextRangeValue(0.0, 100.0));
+    random->Next();
+  }
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+  {
+    for (int j = 0; j < a->GetNumberOfComponents(); j++)
+    {
+      if (a->GetComponent(i, j) != b->GetComponent(i, j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkImageConnectivityFilter* filter, const char* name, const int* updateExtent)
+{
+  filter->ParallelLabelingOff();
+  if (updateExtent)
+  {
+    filter->UpdateExtent(updateExtent);
+  }
+  else
+  {
+    filter->Update();
+  }
+  vtkNew<vtkImageData> serial;
+  serial->DeepCopy(filter->GetOutput());
+  vtkNew<vtkIdTypeArray> labels;
+  labels->DeepCopy(filter->GetExtractedRegionLabels());
+  vtkNew<vtkIdTypeArray> sizes;
+  sizes->DeepCopy(filter->GetExtractedRegionSizes());
+  vtkNew<vtkIdTypeArray> seedIds;
+  seedIds->DeepCopy(filter->GetExtractedRegionSeedIds());
+  vtkNew<vtkIntArray> extents;
+  extents->DeepCopy(filter->GetExtractedRegionExtents());
+
+  filter->ParallelLabelingOn();
+  if (updateExtent)
+  {
+    filter->UpdateExtent(updateExtent);
+  }
+  else
+  {
+    filter->Update();
+  }
+  vtkImageData* parallel = filter->GetOutput();
+
+  if (!SameArrays(serial->GetPointData()->GetScalars(), parallel->GetPointData()->GetScalars()))
+  {
+    std::cerr << name << ": the labels of the voxels differ." << std::endl;
+    return false;
+  }
+  if (!SameArrays(labels, filter->GetExtractedRegionLabels()) ||
+    !SameArrays(sizes, filter->GetExtractedRegionSizes()) ||
+    !SameArrays(seedIds, filter->GetExtractedRegionSeedIds()) ||
+    !SameArrays(extents, filter->GetExtractedRegionExtents()))
+  {
+    std::cerr << name << ": the region arrays differ." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestImage(vtkImageData* image)
+{
+  int extent[6];
+  image->GetExtent(extent);
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkUnsignedCharArray> scalars;
+  for (int i = 0; i < 40; i++)
+  {
+    points->InsertNextPoint(extent[0] + (7 * i) % (extent[1] - extent[0] + 1),
+      extent[2] + (11 * i) % (extent[3] - extent[2] + 1),
+      extent[4] + (5 * i) % (extent[5] - extent[4] + 1));
+    scalars->InsertNextValue(static_cast<unsigned char>(i % 5));
+  }
+  vtkNew<vtkPolyData> seeds;
+  seeds->SetPoints(points);
+  vtkNew<vtkPolyData> seedsWithScalars;
+  seedsWithScalars->SetPoints(points);
+  seedsWithScalars->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkImageConnectivityFilter> filter;
+  filter->SetInputData(image);
+  filter->SetScalarRange(70, 100);
+  filter->SetLabelScalarTypeToInt();
+  bool success = Compare(filter, "AllRegions", nullptr);
+
+  filter->GenerateRegionExtentsOn();
+  filter->SetLabelModeToSizeRank();
+  success &= Compare(filter, "SizeRank", nullptr);
+
+  filter->SetSizeRange(2, 50);
+  success &= Compare(filter, "SizeRange", nullptr);
+
+  // The output is truncated when there are more regions than labels.
+  filter->SetLabelScalarTypeToUnsignedChar();
+  success &= Compare(filter, "UnsignedChar", nullptr);
+
+  filter->SetSizeRange(1, VTK_ID_MAX);
+  filter->GenerateRegionExtentsOff();
+  filter->SetLabelModeToSeedScalar();
+  success &= Compare(filter, "UnsignedChar without size range", nullptr);
+
+  filter->SetExtractionModeToLargestRegion();
+  success &= Compare(filter, "LargestRegion", nullptr);
+
+  filter->SetLabelScalarTypeToShort();
+  filter->SetSeedData(seedsWithScalars);
+  success &= Compare(filter, "LargestRegion with seeds", nullptr);
+
+  filter->SetExtractionModeToSeededRegions();
+  success &= Compare(filter, "SeededRegions", nullptr);
+
+  filter->SetSeedData(seeds);
+  filter->SetExtractionModeToAllRegions();
+  filter->GenerateRegionExtentsOn();
+  success &= Compare(filter, "AllRegions with seeds", nullptr);
+
+  filter->SetLabelModeToConstantValue();
+  filter->SetLabelConstantValue(7);
+  const int updateExtent[6] = { extent[0] + 1, extent[1] - 2, extent[2] + 3, extent[3],
+    extent[4], extent[5] > extent[4] ? extent[5] - 1 : extent[5] };
+  success &= Compare(filter, "Update extent", updateExtent);
+
+  return success;
+}
+}
+
+int TestImageConnectivityFilterParallel(int, char*[])
+{
+  // Use several threads even on a single core.
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkImageData> image;
+  MakeImage(image, 40, 30, 20);
+  bool success = TestImage(image);
+
+  MakeImage(image, 64, 50, 1);
+  success &= TestImage(image);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Compares vtkImageContinuousDilate3D, vtkImageContinuousErode3D and
+// vtkImageDilateErode3D with a direct computation over the neighborhood of
+// each voxel, for ellipsoid and box kernels of odd, even and unit sizes, and
+// checks that vtkImageOpenClose3D forwards the kernel shape.
+
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageContinuousErode3D.h"
+#include "vtkImageData.h"
+#include "vtkImageDilateErode3D.h"
+#include "vtkImageEllipsoidSource.h"
+#include "vtkImageOpenClose3D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// An image of random values in [0, range), or of random blobs of the values
+// 0, 1 and 2 when range is 3.
+void MakeImage(vtkImageData* image, int scalarType, int numberOfComponents, double range)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(scalarType + numberOfComponents);
+  image->SetExtent(-4, 21, 3, 22, -2, 9);
+  image->AllocateScalars(scalarType, numberOfComponents);
+  const int* extent = image->GetExtent();
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        for (int c = 0; c < numberOfComponents; ++c)
+        {
+          double value = random->GetNextRangeValue(0.0, range);
+          random->Next();
+          if (range == 3.0)
+          {
+            // mostly zeros, so that the dilation does not fill everything
+            value = (value < 2.5 ? 0.0 : (value < 2.9 ? 1.0 : 2.0));
+          }
+          image->SetScalarComponentFromDouble(i, j, k, c, value);
+        }
+      }
+    }
+  }
+}
+
+// The offsets of the neighborhood, computed like the filters do.
+std::vector<int> MakeOffsets(const int kernelSize[3], bool box)
+{
+  vtkNew<vtkImageEllipsoidSource> ellipse;
+  ellipse->SetWholeExtent(0, kernelSize[0] - 1, 0, kernelSize[1] - 1, 0, kernelSize[2] - 1);
+  ellipse->SetCenter((kernelSize[0] - 1) * 0.5, (kernelSize[1] - 1) * 0.5,
+    (kernelSize[2] - 1) * 0.5);
+  ellipse->SetRadius(kernelSize[0] * 0.5, kernelSize[1] * 0.5, kernelSize[2] * 0.5);
+  ellipse->Update();
+  std::vector<int> offsets;
+  for (int z = 0; z < kernelSize[2]; ++z)
+  {
+    for (int y = 0; y < kernelSize[1]; ++y)
+    {
+      for (int x = 0; x < kernelSize[0]; ++x)
+      {
+        if (box || ellipse->GetOutput()->GetScalarComponentAsDouble(x, y, z, 0) != 0.0)
+        {
+          offsets.push_back(x - kernelSize[0] / 2);
+          offsets.push_back(y - kernelSize[1] / 2);
+          offsets.push_back(z - kernelSize[2] / 2);
+        }
+      }
+    }
+  }
+  return offsets;
+}
+
+bool IsInside(const int* extent, int i, int j, int k)
+{
+  return i >= extent[0] && i <= extent[1] && j >= extent[2] && j <= extent[3] &&
+    k >= extent[4] && k <= extent[5];
+}
+
+// The dilation (or the erosion) of a component, neighbors outside of the
+// image are ignored.
+double ComputeContinuous(vtkImageData* image, const std::vector<int>& offsets, int i, int j,
+  int k, int c, bool dilate)
+{
+  const int* extent = image->GetExtent();
+  double result = image->GetScalarComponentAsDouble(i, j, k, c);
+  for (size_t n = 0; n < offsets.size(); n += 3)
+  {
+    const int x = i + offsets[n];
+    const int y = j + offsets[n + 1];
+    const int z = k + offsets[n + 2];
+    if (IsInside(extent, x, y, z))
+    {
+      const double value = image->GetScalarComponentAsDouble(x, y, z, c);
+      result = (dilate ? std::max(result, value) : std::min(result, value));
+    }
+  }
+  return result;
+}
+
+// The erode value becomes the dilate value next to the dilate value.
+double ComputeDilateErode(vtkImageData* image, const std::vector<int>& offsets, int i, int j,
+  int k, int c, double dilateValue, double erodeValue)
+{
+  const int* extent = image->GetExtent();
+  const double value = image->GetScalarComponentAsDouble(i, j, k, c);
+  if (value != erodeValue)
+  {
+    return value;
+  }
+  for (size_t n = 0; n < offsets.size(); n += 3)
+  {
+    const int x = i + offsets[n];
+    const int y = j + offsets[n + 1];
+    const int z = k + offsets[n + 2];
+    if (IsInside(extent, x, y, z) && image->GetScalarComponentAsDouble(x, y, z, c) == dilateValue)
+    {
+      return dilateValue;
+    }
+  }
+  return value;
+}
+
+// Compare the output inside the given extent with the direct computation.
+bool CheckOutput(vtkImageData* image, vtkImageData* output, const int extent[6],
+  const std::vector<int>& offsets, int mode, const char* name)
+{
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        for (int c = 0; c < image->GetNumberOfScalarComponents(); ++c)
+        {
+          const double expected = (mode == 2
+              ? ComputeDilateErode(image, offsets, i, j, k, c, 1.0, 0.0)
+              : ComputeContinuous(image, offsets, i, j, k, c, mode == 0));
+          if (output->GetScalarComponentAsDouble(i, j, k, c) != expected)
+          {
+            std::cerr << name << " is wrong at " << i << " " << j << " " << k << ": "
+                      << output->GetScalarComponentAsDouble(i, j, k, c) << " instead of "
+                      << expected << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <class TFilter>
+bool TestFilter(TFilter* filter, vtkImageData* image, const int kernelSize[3], int shape,
+  int mode, const char* name)
+{
+  filter->SetInputData(image);
+  filter->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  filter->SetKernelShape(shape);
+  filter->Update();
+  const std::vector<int> offsets = MakeOffsets(kernelSize, shape == TFilter::Box);
+  if (!CheckOutput(image, filter->GetOutput(), image->GetExtent(), offsets, mode, name))
+  {
+    std::cerr << "  kernel size " << kernelSize[0] << " " << kernelSize[1] << " "
+              << kernelSize[2] << (shape == TFilter::Box ? " box" : " ellipsoid") << std::endl;
+    return false;
+  }
+
+  // a piece of the output only uses the input it requests
+  const int piece[6] = { 1, 15, 4, 20, 3, 7 };
+  filter->UpdateExtent(piece);
+  if (!CheckOutput(image, filter->GetOutput(), piece, offsets, mode, name))
+  {
+    std::cerr << "  for an update extent" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestOpenClose()
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image, VTK_UNSIGNED_CHAR, 1, 3.0);
+
+  vtkNew<vtkImageOpenClose3D> openClose;
+  openClose->SetInputData(image);
+  openClose->SetKernelSize(7, 5, 3);
+  openClose->SetOpenValue(0.0);
+  openClose->SetCloseValue(1.0);
+  openClose->SetKernelShapeToBox();
+  openClose->Update();
+  if (openClose->GetKernelShape() != vtkImageDilateErode3D::Box ||
+    openClose->GetFilter1()->GetKernelShape() != vtkImageDilateErode3D::Box)
+  {
+    std::cerr << "The kernel shape is not forwarded to the sub filters." << std::endl;
+    return false;
+  }
+
+  // closing is a dilation followed by an erosion
+  vtkNew<vtkImageDilateErode3D> dilate;
+  dilate->SetInputData(image);
+  dilate->SetKernelSize(7, 5, 3);
+  dilate->SetKernelShapeToBox();
+  dilate->SetDilateValue(1.0);
+  dilate->SetErodeValue(0.0);
+  vtkNew<vtkImageDilateErode3D> erode;
+  erode->SetInputConnection(dilate->GetOutputPort());
+  erode->SetKernelSize(7, 5, 3);
+  erode->SetKernelShapeToBox();
+  erode->SetDilateValue(0.0);
+  erode->SetErodeValue(1.0);
+  erode->Update();
+  const vtkIdType n = image->GetNumberOfPoints();
+  const unsigned char* expected =
+    static_cast<unsigned char*>(erode->GetOutput()->GetScalarPointer());
+  const unsigned char* values =
+    static_cast<unsigned char*>(openClose->GetOutput()->GetScalarPointer());
+  if (!std::equal(values, values + n, expected))
+  {
+    std::cerr << "vtkImageOpenClose3D differs from its sub filters." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestImageMorphologyKernels(int, char*[])
+{
+  const int kernelSizes[][3] = { { 5, 3, 4 }, { 11, 1, 7 }, { 1, 8, 1 }, { 1, 1, 1 },
+    { 40, 2, 3 } };
+  vtkNew<vtkImageData> floatImage;
+  MakeImage(floatImage, VTK_FLOAT, 2, 100.0);
+  vtkNew<vtkImageData> shortImage;
+  MakeImage(shortImage, VTK_SHORT, 1, 3000.0);
+  vtkNew<vtkImageData> labelImage;
+  MakeImage(labelImage, VTK_UNSIGNED_CHAR, 2, 3.0);
+
+  bool success = true;
+  for (const auto& kernelSize : kernelSizes)
+  {
+    for (int shape = vtkImageDilateErode3D::Ellipsoid; shape <= vtkImageDilateErode3D::Box;
+         ++shape)
+    {
+      vtkNew<vtkImageContinuousDilate3D> dilate;
+      success &= TestFilter(dilate.Get(), floatImage, kernelSize, shape, 0, "Dilation");
+      vtkNew<vtkImageContinuousErode3D> erode;
+      success &= TestFilter(erode.Get(), shortImage, kernelSize, shape, 1, "Erosion");
+      vtkNew<vtkImageDilateErode3D> dilateErode;
+      dilateErode->SetDilateValue(1.0);
+      dilateErode->SetErodeValue(0.0);
+      success &= TestFilter(dilateErode.Get(), labelImage, kernelSize, shape, 2, "DilateErode");
+    }
+  }
+  success &= TestOpenClose();
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
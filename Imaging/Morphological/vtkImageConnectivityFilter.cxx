@@ -16,6 +16,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTemplateAliasMacro.h"
@@ -23,6 +24,9 @@
 #include "vtkVersion.h"
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
 #include <stack>
 #include <vector>
 
@@ -50,6 +54,8 @@ vtkImageConnectivityFilter::vtkImageConnectivityFilter()
 
   this->GenerateRegionExtents = 0;
 
+  this->ParallelLabeling = 0;
+
   this->ExtractedRegionLabels = vtkIdTypeArray::New();
   this->ExtractedRegionSizes = vtkIdTypeArray::New();
   this->ExtractedRegionSeedIds = vtkIdTypeArray::New();
@@ -286,6 +292,20 @@ protected:
     vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr, int extent[6],
     vtkICF::RegionVector& regionInfo);
 
+  // Add a region found by the parallel labeling, along with its component,
+  // and remove regions like AddRegion() does when there are no labels left.
+  template <class OT>
+  static void AddComponentRegion(vtkICF::RegionVector& regionInfo,
+    std::vector<vtkIdType>& regionComponents, const vtkICF::Region& region, vtkIdType component,
+    vtkIdType sizeRange[2], int extractionMode);
+
+  // Execute method for the parallel labeling, with LT as the type of the
+  // voxel indices.
+  template <class OT, class LT>
+  static void ParallelExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
+    vtkDataSet* seedData, OT* outPtr, unsigned char* maskPtr, int extent[6],
+    vtkICF::RegionVector& regionInfo);
+
 public:
   // Create a bit mask from the input
   template <class IT>
@@ -419,6 +439,338 @@ public:
   }
 };
 
+//------------------------------------------------------------------------------
+// Connected components of the bitmask, labeled in parallel.  The voxels form
+// a union-find forest where each voxel points to a voxel of its component
+// with a smaller index, so the root of a component is its first voxel in
+// raster order, whatever the order of the unions.  The image is split into
+// slabs along its last axis: the slabs are labeled concurrently, then the
+// components are merged across the faces between slabs.
+template <class LT>
+class vtkICFComponents
+{
+public:
+  vtkICFComponents(const unsigned char* maskPtr, const int maxIdx[3], bool computeExtents)
+    : Mask(maskPtr)
+    , ComputeExtents(computeExtents)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      this->Dims[i] = maxIdx[i] + 1;
+    }
+    this->NumberOfVoxels =
+      static_cast<vtkIdType>(this->Dims[0]) * this->Dims[1] * this->Dims[2];
+    this->Parent.reset(new std::atomic<LT>[this->NumberOfVoxels]);
+
+    // The slabs are made of z slices, or of rows for 2D images.
+    this->SliceAxis = (this->Dims[2] > 1 ? 2 : 1);
+    this->SliceSize = (this->SliceAxis == 2 ? this->Dims[0] * static_cast<vtkIdType>(this->Dims[1])
+                                           : this->Dims[0]);
+    int numberOfSlices = this->Dims[this->SliceAxis];
+    int numberOfSlabs = std::min(numberOfSlices, 8 * vtkSMPTools::GetEstimatedNumberOfThreads());
+    for (int slab = 0; slab <= numberOfSlabs; slab++)
+    {
+      this->SlabStarts.push_back(static_cast<int>(
+        static_cast<vtkIdType>(slab) * numberOfSlices / std::max(numberOfSlabs, 1)));
+    }
+  }
+
+  void Execute()
+  {
+    int numberOfSlabs = static_cast<int>(this->SlabStarts.size()) - 1;
+    if (numberOfSlabs < 1)
+    {
+      return;
+    }
+
+    // label each slab, then merge the labels across the slab faces
+    vtkSMPTools::For(0, numberOfSlabs, 1, [this](int begin, int end) {
+      for (int slab = begin; slab < end; slab++)
+      {
+        this->LabelSlab(slab);
+      }
+    });
+    vtkSMPTools::For(1, numberOfSlabs, 1, [this](int begin, int end) {
+      for (int slab = begin; slab < end; slab++)
+      {
+        this->MergeSlabFace(slab);
+      }
+    });
+
+    // point all the voxels to their root, and count the roots of each slab
+    std::vector<vtkIdType> slabRoots(numberOfSlabs + 1, 0);
+    vtkSMPTools::For(0, numberOfSlabs, 1, [this, &slabRoots](int begin, int end) {
+      for (int slab = begin; slab < end; slab++)
+      {
+        vtkIdType count = 0;
+        for (vtkIdType v = this->GetSlabBegin(slab); v < this->GetSlabBegin(slab + 1); v++)
+        {
+          if (this->Parent[v].load(std::memory_order_relaxed) != Background())
+          {
+            LT root = this->Find(static_cast<LT>(v));
+            this->Parent[v].store(root, std::memory_order_relaxed);
+            count += (root == v);
+          }
+        }
+        slabRoots[slab + 1] = count;
+      }
+    });
+
+    // number the components in raster order, and store the number of each
+    // component as -(number + 1) in the parent of its root
+    for (int slab = 0; slab < numberOfSlabs; slab++)
+    {
+      slabRoots[slab + 1] += slabRoots[slab];
+    }
+    vtkIdType numberOfComponents = slabRoots[numberOfSlabs];
+    this->Roots.resize(numberOfComponents);
+    vtkSMPTools::For(0, numberOfSlabs, 1, [this, &slabRoots](int begin, int end) {
+      for (int slab = begin; slab < end; slab++)
+      {
+        vtkIdType component = slabRoots[slab];
+        for (vtkIdType v = this->GetSlabBegin(slab); v < this->GetSlabBegin(slab + 1); v++)
+        {
+          if (this->Parent[v].load(std::memory_order_relaxed) == v)
+          {
+            this->Parent[v].store(static_cast<LT>(-component - 1), std::memory_order_relaxed);
+            this->Roots[component++] = v;
+          }
+        }
+      }
+    });
+
+    this->ComputeSizesAndExtents(numberOfSlabs);
+  }
+
+  vtkIdType GetNumberOfComponents() const { return static_cast<vtkIdType>(this->Roots.size()); }
+
+  // Get the component of a voxel, or -1 if the voxel is not in the mask
+  vtkIdType GetComponent(vtkIdType voxel) const
+  {
+    LT p = this->Parent[voxel].load(std::memory_order_relaxed);
+    if (p == Background())
+    {
+      return -1;
+    }
+    if (p >= 0)
+    {
+      p = this->Parent[p].load(std::memory_order_relaxed);
+    }
+    return -static_cast<vtkIdType>(p) - 1;
+  }
+
+  vtkIdType GetSize(vtkIdType component) const
+  {
+    return this->Sizes[component].load(std::memory_order_relaxed);
+  }
+
+  // Get the extent of a component, or the position of its first voxel if
+  // the extents were not computed
+  void GetExtent(vtkIdType component, int extent[6]) const
+  {
+    if (this->ComputeExtents)
+    {
+      for (int i = 0; i < 6; i++)
+      {
+        extent[i] = this->Extents[6 * component + i].load(std::memory_order_relaxed);
+      }
+    }
+    else
+    {
+      vtkIdType root = this->Roots[component];
+      extent[0] = extent[1] = static_cast<int>(root % this->Dims[0]);
+      root /= this->Dims[0];
+      extent[2] = extent[3] = static_cast<int>(root % this->Dims[1]);
+      extent[4] = extent[5] = static_cast<int>(root / this->Dims[1]);
+    }
+  }
+
+private:
+  static LT Background() { return std::numeric_limits<LT>::max(); }
+
+  vtkIdType GetSlabBegin(int slab) const { return this->SlabStarts[slab] * this->SliceSize; }
+
+  bool InMask(vtkIdType v) const { return ((this->Mask[v >> 3] >> (v & 0x7)) & 1) == 0; }
+
+  // Find the root of a voxel, with path halving.  The parents only ever move
+  // closer to the root, so concurrent updates are safe.
+  LT Find(LT v)
+  {
+    LT p = this->Parent[v].load(std::memory_order_relaxed);
+    while (p != v)
+    {
+      LT gp = this->Parent[p].load(std::memory_order_relaxed);
+      if (gp != p)
+      {
+        this->Parent[v].store(gp, std::memory_order_relaxed);
+      }
+      v = gp;
+      p = this->Parent[v].load(std::memory_order_relaxed);
+    }
+    return v;
+  }
+
+  // Join the components of two voxels, the root with the larger index is
+  // attached to the other root.  Only roots are modified, with a
+  // compare-and-swap that fails if another thread attached the root first.
+  void Union(LT a, LT b)
+  {
+    for (;;)
+    {
+      a = this->Find(a);
+      b = this->Find(b);
+      if (a == b)
+      {
+        return;
+      }
+      if (a > b)
+      {
+        std::swap(a, b);
+      }
+      LT expected = b;
+      if (this->Parent[b].compare_exchange_weak(expected, a, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+  }
+
+  void LabelSlab(int slab)
+  {
+    const vtkIdType rowSize = this->Dims[0];
+    const vtkIdType sliceSize = rowSize * this->Dims[1];
+    const vtkIdType slabBegin = this->GetSlabBegin(slab);
+    const vtkIdType slabEnd = this->GetSlabBegin(slab + 1);
+    for (vtkIdType rowStart = slabBegin; rowStart < slabEnd; rowStart += rowSize)
+    {
+      // the neighbors must be in the same slab
+      const bool hasRowBelow = (rowStart - rowSize >= slabBegin && rowStart % sliceSize != 0);
+      const bool hasSliceBelow = (rowStart - sliceSize >= slabBegin);
+      for (vtkIdType v = rowStart; v < rowStart + rowSize; v++)
+      {
+        if (!this->InMask(v))
+        {
+          this->Parent[v].store(Background(), std::memory_order_relaxed);
+          continue;
+        }
+        this->Parent[v].store(static_cast<LT>(v), std::memory_order_relaxed);
+        if (v > rowStart && this->InMask(v - 1))
+        {
+          this->Union(static_cast<LT>(v), static_cast<LT>(v - 1));
+        }
+        if (hasRowBelow && this->InMask(v - rowSize))
+        {
+          this->Union(static_cast<LT>(v), static_cast<LT>(v - rowSize));
+        }
+        if (hasSliceBelow && this->InMask(v - sliceSize))
+        {
+          this->Union(static_cast<LT>(v), static_cast<LT>(v - sliceSize));
+        }
+      }
+    }
+  }
+
+  void MergeSlabFace(int slab)
+  {
+    const vtkIdType faceBegin = this->GetSlabBegin(slab);
+    for (vtkIdType v = faceBegin; v < faceBegin + this->SliceSize; v++)
+    {
+      if (this->InMask(v) && this->InMask(v - this->SliceSize))
+      {
+        this->Union(static_cast<LT>(v), static_cast<LT>(v - this->SliceSize));
+      }
+    }
+  }
+
+  static void AtomicMin(std::atomic<int>& value, int x)
+  {
+    int current = value.load(std::memory_order_relaxed);
+    while (x < current && !value.compare_exchange_weak(current, x, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  static void AtomicMax(std::atomic<int>& value, int x)
+  {
+    int current = value.load(std::memory_order_relaxed);
+    while (x > current && !value.compare_exchange_weak(current, x, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  // Count the voxels of the components, by runs of voxels of a row.
+  void ComputeSizesAndExtents(int numberOfSlabs)
+  {
+    vtkIdType numberOfComponents = this->GetNumberOfComponents();
+    this->Sizes.reset(new std::atomic<vtkIdType>[numberOfComponents]);
+    if (this->ComputeExtents)
+    {
+      this->Extents.reset(new std::atomic<int>[6 * numberOfComponents]);
+    }
+    vtkSMPTools::For(0, numberOfComponents, [this](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType c = begin; c < end; c++)
+      {
+        this->Sizes[c].store(0, std::memory_order_relaxed);
+        if (this->ComputeExtents)
+        {
+          for (int i = 0; i < 6; i++)
+          {
+            this->Extents[6 * c + i].store(i % 2 == 0 ? VTK_INT_MAX : VTK_INT_MIN);
+          }
+        }
+      }
+    });
+
+    vtkSMPTools::For(0, numberOfSlabs, 1, [this](int begin, int end) {
+      const vtkIdType rowSize = this->Dims[0];
+      for (vtkIdType rowStart = this->GetSlabBegin(begin); rowStart < this->GetSlabBegin(end);
+           rowStart += rowSize)
+      {
+        const vtkIdType row = rowStart / rowSize;
+        const int j = static_cast<int>(row % this->Dims[1]);
+        const int k = static_cast<int>(row / this->Dims[1]);
+        vtkIdType v = rowStart;
+        while (v < rowStart + rowSize)
+        {
+          vtkIdType component = this->GetComponent(v);
+          vtkIdType runStart = v;
+          do
+          {
+            v++;
+          } while (v < rowStart + rowSize && this->GetComponent(v) == component);
+          if (component < 0)
+          {
+            continue;
+          }
+          this->Sizes[component].fetch_add(v - runStart, std::memory_order_relaxed);
+          if (this->ComputeExtents)
+          {
+            std::atomic<int>* extent = &this->Extents[6 * component];
+            AtomicMin(extent[0], static_cast<int>(runStart - rowStart));
+            AtomicMax(extent[1], static_cast<int>(v - 1 - rowStart));
+            AtomicMin(extent[2], j);
+            AtomicMax(extent[3], j);
+            AtomicMin(extent[4], k);
+            AtomicMax(extent[5], k);
+          }
+        }
+      }
+    });
+  }
+
+  const unsigned char* Mask;
+  bool ComputeExtents;
+  int Dims[3];
+  vtkIdType NumberOfVoxels;
+  int SliceAxis;
+  vtkIdType SliceSize;
+  std::vector<int> SlabStarts;
+  std::unique_ptr<std::atomic<LT>[]> Parent;
+  std::vector<vtkIdType> Roots;
+  std::unique_ptr<std::atomic<vtkIdType>[]> Sizes;
+  std::unique_ptr<std::atomic<int>[]> Extents;
+};
+
 //------------------------------------------------------------------------------
 bool vtkICF::IntersectExtents(const int extent1[6], const int extent2[6], int output[6])
 {
@@ -1292,25 +1644,248 @@ void vtkICF::ExecuteOutput(vtkImageConnectivityFilter* self, vtkImageData* outDa
   vtkICF::RegionVector regionInfo;
   regionInfo.push_back(vtkICF::Region(0, 0, extent));
 
-  // execution depends on how regions are seeded
   vtkDataArray* seedScalars = nullptr;
   if (seedData)
   {
     seedScalars = seedData->GetPointData()->GetScalars();
-    vtkICF::SeededExecute(self, outData, seedData, stencil, outPtr, maskPtr, extent, regionInfo);
   }
 
-  // if no seeds, or if AllRegions selected, search for all regions
-  int extractionMode = self->GetExtractionMode();
-  if (!seedData || extractionMode == vtkImageConnectivityFilter::AllRegions)
+  if (self->GetParallelLabeling())
   {
-    vtkICF::SeedlessExecute(self, outData, stencil, outPtr, maskPtr, extent, regionInfo);
+    // the voxel indices are stored as int when possible
+    vtkIdType numberOfVoxels = 1;
+    for (int i = 0; i < 3; i++)
+    {
+      numberOfVoxels *= extent[2 * i + 1] - extent[2 * i] + 1;
+    }
+    if (numberOfVoxels < VTK_INT_MAX)
+    {
+      vtkICF::ParallelExecute<OT, int>(
+        self, outData, seedData, outPtr, maskPtr, extent, regionInfo);
+    }
+    else
+    {
+      vtkICF::ParallelExecute<OT, vtkIdType>(
+        self, outData, seedData, outPtr, maskPtr, extent, regionInfo);
+    }
+  }
+  else
+  {
+    // execution depends on how regions are seeded
+    if (seedData)
+    {
+      vtkICF::SeededExecute(self, outData, seedData, stencil, outPtr, maskPtr, extent, regionInfo);
+    }
+
+    // if no seeds, or if AllRegions selected, search for all regions
+    int extractionMode = self->GetExtractionMode();
+    if (!seedData || extractionMode == vtkImageConnectivityFilter::AllRegions)
+    {
+      vtkICF::SeedlessExecute(self, outData, stencil, outPtr, maskPtr, extent, regionInfo);
+    }
   }
 
   // do final relabelling and other bookkeeping
   vtkICF::Finish(self, outData, outPtr, stencil, extent, seedScalars, regionInfo);
 }
 
+//------------------------------------------------------------------------------
+template <class OT>
+void vtkICF::AddComponentRegion(vtkICF::RegionVector& regionInfo,
+  std::vector<vtkIdType>& regionComponents, const vtkICF::Region& region, vtkIdType component,
+  vtkIdType sizeRange[2], int extractionMode)
+{
+  regionInfo.push_back(region);
+  regionComponents.push_back(component);
+  if (regionInfo.size() <= static_cast<size_t>(vtkTypeTraits<OT>::Max()))
+  {
+    return;
+  }
+
+  // the same steps as AddRegion(), but without modifying the output
+  size_t m = 1;
+  for (size_t i = 1; i < regionInfo.size(); i++)
+  {
+    vtkIdType s = regionInfo[i].size;
+    if (s >= sizeRange[0] && s <= sizeRange[1])
+    {
+      regionInfo[m] = regionInfo[i];
+      regionComponents[m++] = regionComponents[i];
+    }
+  }
+  regionInfo.resize(m);
+  regionComponents.resize(m);
+
+  if (regionInfo.size() > static_cast<size_t>(vtkTypeTraits<OT>::Max()))
+  {
+    if (extractionMode == vtkImageConnectivityFilter::LargestRegion)
+    {
+      vtkICF::RegionVector::iterator largest = regionInfo.largest();
+      regionComponents[1] = regionComponents[std::distance(regionInfo.begin(), largest)];
+      regionInfo[1] = *largest;
+      regionInfo.erase(regionInfo.begin() + 2, regionInfo.end());
+      regionComponents.resize(2);
+    }
+    else
+    {
+      vtkICF::RegionVector::iterator smallest = regionInfo.smallest();
+      regionComponents.erase(
+        regionComponents.begin() + std::distance(regionInfo.begin(), smallest));
+      regionInfo.erase(smallest);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Label the components in parallel, then go through them in the order in
+// which SeededExecute() and SeedlessExecute() would fill them, so that the
+// regions and their labels are the same.
+template <class OT, class LT>
+void vtkICF::ParallelExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
+  vtkDataSet* seedData, OT* outPtr, unsigned char* maskPtr, int extent[6],
+  vtkICF::RegionVector& regionInfo)
+{
+  // Get execution parameters
+  int extractionMode = self->GetExtractionMode();
+  vtkIdType sizeRange[2];
+  self->GetSizeRange(sizeRange);
+
+  int maxIdx[3];
+  for (int i = 0; i < 3; i++)
+  {
+    maxIdx[i] = extent[2 * i + 1] - extent[2 * i];
+  }
+
+  vtkICFComponents<LT> components(maskPtr, maxIdx, self->GetGenerateRegionExtents() != 0);
+  components.Execute();
+  vtkIdType numberOfComponents = components.GetNumberOfComponents();
+
+  // the component of each region (the background has none)
+  std::vector<vtkIdType> regionComponents(1, -1);
+  std::vector<char> used(numberOfComponents, 0);
+  int regionExtent[6];
+
+  if (seedData)
+  {
+    double spacing[3];
+    double origin[3];
+    outData->GetOrigin(origin);
+    outData->GetSpacing(spacing);
+
+    vtkIdType nPoints = seedData->GetNumberOfPoints();
+    vtkDataArray* scalars = seedData->GetPointData()->GetScalars();
+
+    for (vtkIdType i = 0; i < nPoints; i++)
+    {
+      if (scalars && scalars->GetComponent(i, 0) == 0)
+      {
+        continue;
+      }
+
+      double point[3];
+      seedData->GetPoint(i, point);
+      int idx[3];
+      bool outOfBounds = false;
+
+      // convert point from data coords to image index
+      for (int j = 0; j < 3; j++)
+      {
+        idx[j] = vtkMath::Floor((point[j] - origin[j]) / spacing[j] + 0.5);
+        idx[j] -= extent[2 * j];
+        outOfBounds |= (idx[j] < 0 || idx[j] > maxIdx[j]);
+      }
+
+      if (outOfBounds)
+      {
+        continue;
+      }
+
+      // a seed in a region that was already filled is ignored
+      vtkIdType component = components.GetComponent(
+        idx[0] + (maxIdx[0] + 1) * (idx[1] + (maxIdx[1] + 1) * static_cast<vtkIdType>(idx[2])));
+      if (component < 0 || used[component])
+      {
+        continue;
+      }
+      used[component] = 1;
+
+      // without extents, the extent is the seed position
+      regionExtent[0] = regionExtent[1] = idx[0];
+      regionExtent[2] = regionExtent[3] = idx[1];
+      regionExtent[4] = regionExtent[5] = idx[2];
+      if (self->GetGenerateRegionExtents())
+      {
+        components.GetExtent(component, regionExtent);
+      }
+
+      vtkICF::AddComponentRegion<OT>(regionInfo, regionComponents,
+        vtkICF::Region(components.GetSize(component), i, regionExtent), component, sizeRange,
+        extractionMode);
+    }
+  }
+
+  if (!seedData || extractionMode == vtkImageConnectivityFilter::AllRegions)
+  {
+    // the components are numbered in the order of the raster scan
+    for (vtkIdType component = 0; component < numberOfComponents; component++)
+    {
+      if (used[component])
+      {
+        continue;
+      }
+      vtkIdType voxelCount = components.GetSize(component);
+      if (voxelCount == 1 && static_cast<OT>(regionInfo.size()) == vtkTypeTraits<OT>::Max())
+      {
+        // smallest region is definitely the one we would add
+        continue;
+      }
+      components.GetExtent(component, regionExtent);
+      vtkICF::AddComponentRegion<OT>(regionInfo, regionComponents,
+        vtkICF::Region(voxelCount, -1, regionExtent), component, sizeRange, extractionMode);
+    }
+  }
+
+  // write the index of the region of each voxel to the output
+  std::vector<OT> componentLabels(numberOfComponents, 0);
+  for (size_t i = 1; i < regionComponents.size(); i++)
+  {
+    componentLabels[regionComponents[i]] = static_cast<OT>(i);
+  }
+
+  int outExt[6];
+  outData->GetExtent(outExt);
+  int labelExt[6];
+  if (!vtkICF::IntersectExtents(outExt, extent, labelExt))
+  {
+    return;
+  }
+  vtkIdType outInc[3];
+  outData->GetIncrements(outInc);
+
+  vtkSMPTools::For(labelExt[4], labelExt[5] + 1, [&](int zBegin, int zEnd) {
+    for (int zIdx = zBegin; zIdx < zEnd; zIdx++)
+    {
+      for (int yIdx = labelExt[2]; yIdx <= labelExt[3]; yIdx++)
+      {
+        OT* outPtr1 = outPtr + (zIdx - outExt[4]) * outInc[2] + (yIdx - outExt[2]) * outInc[1] +
+          (labelExt[0] - outExt[0]) * outInc[0];
+        vtkIdType voxel = (labelExt[0] - extent[0]) +
+          (maxIdx[0] + 1) *
+            ((yIdx - extent[2]) + (maxIdx[1] + 1) * static_cast<vtkIdType>(zIdx - extent[4]));
+        for (int xIdx = labelExt[0]; xIdx <= labelExt[1]; xIdx++)
+        {
+          vtkIdType component = components.GetComponent(voxel++);
+          if (component >= 0)
+          {
+            *outPtr1 = componentLabels[component];
+          }
+          outPtr1 += outInc[0];
+        }
+      }
+    }
+  });
+}
+
 } // end anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -1486,6 +2061,8 @@ void vtkImageConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "GenerateRegionExtents: " << (this->GenerateRegionExtents ? "On\n" : "Off\n");
 
+  os << indent << "ParallelLabeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
+
   os << indent << "SeedConnection: " << this->GetSeedConnection() << "\n";
 
   os << indent << "StencilConnection: " << this->GetStencilConnection() << "\n";
@@ -44,6 +44,10 @@
  * is called.  These extents can be useful for cropping the output
  * of the filter.
  *
+ * For large images, ParallelLabelingOn() labels the regions with several
+ * threads instead of filling them one at a time.  The output is identical
+ * to the output of the serial fill.
+ *
  * @sa
  * vtkConnectivityFilter, vtkPolyDataConnectivityFilter, vtkmImageConnectivity
  */
@@ -242,6 +246,21 @@ public:
   vtkGetMacro(ActiveComponent, int);
   ///@}
 
+  ///@{
+  /**
+   * Turn this on to label the regions in parallel.  The image is split into
+   * slabs that are labeled concurrently with a union-find, the labels are
+   * merged across the faces of the slabs, then the regions are numbered in
+   * the order in which the serial fill finds them.  All the options are
+   * supported and the output does not depend on the number of threads.
+   * This mode needs 4 bytes per voxel of temporary memory (8 bytes for
+   * images of more than 2^31 voxels).  The default is off.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  ///@}
+
 protected:
   vtkImageConnectivityFilter();
   ~vtkImageConnectivityFilter() override;
@@ -255,6 +274,7 @@ protected:
   int ActiveComponent;
   int LabelScalarType;
   vtkTypeBool GenerateRegionExtents;
+  vtkTypeBool ParallelLabeling;
 
   vtkIdTypeArray* ExtractedRegionLabels;
   vtkIdTypeArray* ExtractedRegionSizes;
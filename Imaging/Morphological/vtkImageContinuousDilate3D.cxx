@@ -5,13 +5,16 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternal.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeTraits.h"
 
 #include <algorithm>
+#include <functional>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageContinuousDilate3D);
@@ -27,6 +30,7 @@ vtkImageContinuousDilate3D::vtkImageContinuousDilate3D()
   this->KernelSize[0] = 0;
   this->KernelSize[1] = 0;
   this->KernelSize[2] = 0;
+  this->KernelShape = Ellipsoid;
 
   this->Ellipse = vtkImageEllipsoidSource::New();
   // Setup the Ellipse to default size
@@ -47,6 +51,8 @@ vtkImageContinuousDilate3D::~vtkImageContinuousDilate3D()
 void vtkImageContinuousDilate3D::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "KernelShape: " << (this->KernelShape == Box ? "Box" : "Ellipsoid") << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -96,137 +102,24 @@ void vtkImageContinuousDilate3D::SetKernelSize(int size0, int size1, int size2)
 }
 
 //------------------------------------------------------------------------------
-// This templated function executes the filter on any region,
-// whether it needs boundary checking or not.
-// If the filter needs to be faster, the function could be duplicated
-// for strictly center (no boundary) processing.
+// This templated function executes the filter on any region. The maximum
+// over the neighborhood is computed by sliding windows along the rows, the
+// neighborhood voxels outside of the input are ignored.
 template <class T>
-void vtkImageContinuousDilate3DExecute(vtkImageContinuousDilate3D* self, vtkImageData* mask,
-  vtkImageData* inData, T* inPtr, vtkImageData* outData, const int* outExt, T* outPtr, int id,
-  vtkDataArray* inArray)
+void vtkImageContinuousDilate3DExecute(vtkImageContinuousDilate3D* self,
+  const vtkImageMorphologyKernel& kernel, vtkImageData* inData, T* inPtr, vtkImageData* outData,
+  const int* outExt, T* outPtr, int id, vtkDataArray* inArray)
 {
-  // to compute the range
-  unsigned long count = 0;
-
-  // Get information to march through data
-  vtkIdType inInc0, inInc1, inInc2;
-  inData->GetIncrements(inInc0, inInc1, inInc2);
+  vtkIdType inIncs[3], outIncs[3];
+  inData->GetIncrements(inArray, inIncs);
+  outData->GetIncrements(outIncs);
   const int* inExt = inData->GetExtent();
-  int inImageMin0 = inExt[0];
-  int inImageMax0 = inExt[1];
-  int inImageMin1 = inExt[2];
-  int inImageMax1 = inExt[3];
-  int inImageMin2 = inExt[4];
-  int inImageMax2 = inExt[5];
-  vtkIdType outInc0, outInc1, outInc2;
-  outData->GetIncrements(outInc0, outInc1, outInc2);
-  int outMin0 = outExt[0];
-  int outMax0 = outExt[1];
-  int outMin1 = outExt[2];
-  int outMax1 = outExt[3];
-  int outMin2 = outExt[4];
-  int outMax2 = outExt[5];
   int numComps = outData->GetNumberOfScalarComponents();
 
-  // Get ivars of this object (easier than making friends)
-  const int* kernelSize = self->GetKernelSize();
-  const int* kernelMiddle = self->GetKernelMiddle();
-  int hoodMin0 = -kernelMiddle[0];
-  int hoodMin1 = -kernelMiddle[1];
-  int hoodMin2 = -kernelMiddle[2];
-  int hoodMax0 = hoodMin0 + kernelSize[0] - 1;
-  int hoodMax1 = hoodMin1 + kernelSize[1] - 1;
-  int hoodMax2 = hoodMin2 + kernelSize[2] - 1;
-
-  // Setup mask info
-  const unsigned char* maskPtr = static_cast<unsigned char*>(mask->GetScalarPointer());
-  vtkIdType maskInc0, maskInc1, maskInc2;
-  mask->GetIncrements(maskInc0, maskInc1, maskInc2);
-
-  // in and out should be marching through corresponding pixels.
-  inPtr = static_cast<T*>(inArray->GetVoidPointer(
-    (outMin0 - inExt[0]) * inInc0 + (outMin1 - inExt[2]) * inInc1 + (outMin2 - inExt[4]) * inInc2));
-
-  unsigned long target =
-    static_cast<unsigned long>(numComps * (outMax2 - outMin2 + 1) * (outMax1 - outMin1 + 1) / 50.0);
-  target++;
-
-  // loop through components
-  for (int outIdxC = 0; outIdxC < numComps; ++outIdxC)
+  for (int idxC = 0; idxC < numComps; ++idxC)
   {
-    // loop through pixels of output
-    T* outPtr2 = outPtr;
-    const T* inPtr2 = inPtr;
-    for (int outIdx2 = outMin2; outIdx2 <= outMax2; ++outIdx2)
-    {
-      T* outPtr1 = outPtr2;
-      const T* inPtr1 = inPtr2;
-      for (int outIdx1 = outMin1; !self->AbortExecute && outIdx1 <= outMax1; ++outIdx1)
-      {
-        if (!id)
-        {
-          if (!(count % target))
-          {
-            self->UpdateProgress(count / (50.0 * target));
-          }
-          count++;
-        }
-
-        T* outPtr0 = outPtr1;
-        const T* inPtr0 = inPtr1;
-        for (int outIdx0 = outMin0; outIdx0 <= outMax0; ++outIdx0)
-        {
-          // Find max
-          T pixelMax = *inPtr0;
-          // loop through neighborhood pixels
-          // as sort of a hack to handle boundaries,
-          // input pointer will be marching through data that does not exist.
-          int hoodMinClamp2 = std::max(hoodMin2, inImageMin2 - outIdx2);
-          int hoodMaxClamp2 = std::min(hoodMax2, inImageMax2 - outIdx2);
-          const T* hoodPtr2 = inPtr0 - kernelMiddle[0] * inInc0 - kernelMiddle[1] * inInc1 -
-            kernelMiddle[2] * inInc2 + (hoodMinClamp2 - hoodMin2) * inInc2;
-          const unsigned char* maskPtr2 = maskPtr + (hoodMinClamp2 - hoodMin2) * maskInc2;
-          for (int hoodIdx2 = hoodMinClamp2; hoodIdx2 <= hoodMaxClamp2; ++hoodIdx2)
-          {
-            int hoodMinClamp1 = std::max(hoodMin1, inImageMin1 - outIdx1);
-            int hoodMaxClamp1 = std::min(hoodMax1, inImageMax1 - outIdx1);
-            const T* hoodPtr1 = hoodPtr2 + (hoodMinClamp1 - hoodMin1) * inInc1;
-            const unsigned char* maskPtr1 = maskPtr2 + (hoodMinClamp1 - hoodMin1) * maskInc1;
-            for (int hoodIdx1 = hoodMinClamp1; hoodIdx1 <= hoodMaxClamp1; ++hoodIdx1)
-            {
-              int hoodMinClamp0 = std::max(hoodMin0, inImageMin0 - outIdx0);
-              int hoodMaxClamp0 = std::min(hoodMax0, inImageMax0 - outIdx0);
-              const T* hoodPtr0 = hoodPtr1 + (hoodMinClamp0 - hoodMin0) * inInc0;
-              const unsigned char* maskPtr0 = maskPtr1 + (hoodMinClamp0 - hoodMin0) * maskInc0;
-              for (int hoodIdx0 = hoodMinClamp0; hoodIdx0 <= hoodMaxClamp0; ++hoodIdx0)
-              {
-                if (*maskPtr0 != 0)
-                {
-                  pixelMax = std::max(pixelMax, *hoodPtr0);
-                }
-
-                hoodPtr0 += inInc0;
-                maskPtr0 += maskInc0;
-              }
-              hoodPtr1 += inInc1;
-              maskPtr1 += maskInc1;
-            }
-            hoodPtr2 += inInc2;
-            maskPtr2 += maskInc2;
-          }
-          *outPtr0 = pixelMax;
-
-          inPtr0 += inInc0;
-          outPtr0 += outInc0;
-        }
-        inPtr1 += inInc1;
-        outPtr1 += outInc1;
-      }
-      inPtr2 += inInc2;
-      outPtr2 += outInc2;
-    }
-    ++inPtr;
-    ++outPtr;
+    vtkImageMorphologyExecute(self, kernel, inPtr + idxC, inIncs, inExt, outPtr + idxC, outIncs,
+      outExt, vtkTypeTraits<T>::Min(), std::less<T>(), id);
   }
 }
 
@@ -254,7 +147,7 @@ void vtkImageContinuousDilate3D::ThreadedRequestData(vtkInformation* vtkNotUsed(
 
   vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector);
 
-  // The inPtr is reset anyway, so just get the id 0 pointer.
+  // The pointer to the start of the input extent.
   inPtr = inArray->GetVoidPointer(0);
 
   // Error checking on mask
@@ -274,9 +167,12 @@ void vtkImageContinuousDilate3D::ThreadedRequestData(vtkInformation* vtkNotUsed(
     return;
   }
 
+  const vtkImageMorphologyKernel kernel(
+    mask, this->KernelSize, this->KernelMiddle, this->KernelShape == Box);
+
   switch (inArray->GetDataType())
   {
-    vtkTemplateMacro(vtkImageContinuousDilate3DExecute(this, mask, inData[0][0],
+    vtkTemplateMacro(vtkImageContinuousDilate3DExecute(this, kernel, inData[0][0],
       static_cast<VTK_TT*>(inPtr), outData[0], outExt, static_cast<VTK_TT*>(outPtr), id, inArray));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
@@ -37,11 +37,34 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  /**
+   * Enum constants for SetKernelShape().
+   */
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1
+  };
+
+  ///@{
+  /**
+   * Set the shape of the neighborhood, an ellipsoid (the default) or a box
+   * of the kernel size. The cost of a box per voxel does not depend on the
+   * kernel size, the cost of an ellipsoid grows with the size of its cross
+   * section in the YZ plane.
+   */
+  vtkSetClampMacro(KernelShape, int, Ellipsoid, Box);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  vtkGetMacro(KernelShape, int);
+  ///@}
+
 protected:
   vtkImageContinuousDilate3D();
   ~vtkImageContinuousDilate3D() override;
 
   vtkImageEllipsoidSource* Ellipse;
+  int KernelShape;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -3,12 +3,15 @@
 #include "vtkImageDilateErode3D.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternal.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
+#include <functional>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageDilateErode3D);
@@ -24,6 +27,7 @@ vtkImageDilateErode3D::vtkImageDilateErode3D()
   this->KernelSize[0] = 0;
   this->KernelSize[1] = 0;
   this->KernelSize[2] = 0;
+  this->KernelShape = Ellipsoid;
 
   this->DilateValue = 0.0;
   this->ErodeValue = 255.0;
@@ -50,6 +54,7 @@ void vtkImageDilateErode3D::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "DilateValue: " << this->DilateValue << "\n";
   os << indent << "ErodeValue: " << this->ErodeValue << "\n";
+  os << indent << "KernelShape: " << (this->KernelShape == Box ? "Box" : "Ellipsoid") << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -99,142 +104,84 @@ void vtkImageDilateErode3D::SetKernelSize(int size0, int size1, int size2)
 }
 
 //------------------------------------------------------------------------------
-// This templated function executes the filter on any region,
-// whether it needs boundary checking or not.
-// If the filter needs to be faster, the function could be duplicated
-// for strictly center (no boundary) processing.
+// This templated function executes the filter on any region. The voxels
+// that have the dilate value are marked, the marks are dilated over the
+// neighborhood by sliding windows along the rows, and the voxels with the
+// erode value that get a mark take the dilate value.
 template <class T>
-void vtkImageDilateErode3DExecute(vtkImageDilateErode3D* self, vtkImageData* mask,
-  vtkImageData* inData, T* inPtr, vtkImageData* outData, const int* outExt, T* outPtr, int id)
+void vtkImageDilateErode3DExecute(vtkImageDilateErode3D* self,
+  const vtkImageMorphologyKernel& kernel, vtkImageData* inData, vtkImageData* outData,
+  const int* outExt, T* outPtr, int id)
 {
-  // to compute the range
-  unsigned long count = 0;
-
-  // Get information to march through data
-  vtkIdType inInc0, inInc1, inInc2;
-  inData->GetIncrements(inInc0, inInc1, inInc2);
+  vtkIdType inIncs[3], outIncs[3];
+  inData->GetIncrements(inIncs);
+  outData->GetIncrements(outIncs);
   const int* inExt = inData->GetExtent();
-  int inImageMin0 = inExt[0];
-  int inImageMax0 = inExt[1];
-  int inImageMin1 = inExt[2];
-  int inImageMax1 = inExt[3];
-  int inImageMin2 = inExt[4];
-  int inImageMax2 = inExt[5];
-  vtkIdType outInc0, outInc1, outInc2;
-  outData->GetIncrements(outInc0, outInc1, outInc2);
-  int outMin0 = outExt[0];
-  int outMax0 = outExt[1];
-  int outMin1 = outExt[2];
-  int outMax1 = outExt[3];
-  int outMin2 = outExt[4];
-  int outMax2 = outExt[5];
   int numComps = outData->GetNumberOfScalarComponents();
 
   // Get ivars of this object (easier than making friends)
   T erodeValue = static_cast<T>(self->GetErodeValue());
   T dilateValue = static_cast<T>(self->GetDilateValue());
-  const int* kernelSize = self->GetKernelSize();
-  const int* kernelMiddle = self->GetKernelMiddle();
-  int hoodMin0 = -kernelMiddle[0];
-  int hoodMin1 = -kernelMiddle[1];
-  int hoodMin2 = -kernelMiddle[2];
-  int hoodMax0 = hoodMin0 + kernelSize[0] - 1;
-  int hoodMax1 = hoodMin1 + kernelSize[1] - 1;
-  int hoodMax2 = hoodMin2 + kernelSize[2] - 1;
-
-  // Setup mask info
-  const unsigned char* maskPtr = static_cast<unsigned char*>(mask->GetScalarPointer());
-  vtkIdType maskInc0, maskInc1, maskInc2;
-  mask->GetIncrements(maskInc0, maskInc1, maskInc2);
-
-  // in and out should be marching through corresponding pixels.
-  inPtr = static_cast<T*>(inData->GetScalarPointer(outMin0, outMin1, outMin2));
-
-  unsigned long target =
-    static_cast<unsigned long>(numComps * (outMax2 - outMin2 + 1) * (outMax1 - outMin1 + 1) / 50.0);
-  target++;
 
-  // loop through components
-  for (int outIdxC = 0; outIdxC < numComps; ++outIdxC)
+  // the part of the input covered by the neighborhoods
+  int markExt[6];
+  for (int axis = 0; axis < 3; ++axis)
   {
-    // loop through pixels of output
-    T* outPtr2 = outPtr;
-    const T* inPtr2 = inPtr;
-    for (int outIdx2 = outMin2; outIdx2 <= outMax2; ++outIdx2)
+    markExt[2 * axis] = std::max(inExt[2 * axis], outExt[2 * axis] + kernel.HoodMin[axis]);
+    markExt[2 * axis + 1] =
+      std::min(inExt[2 * axis + 1], outExt[2 * axis + 1] + kernel.HoodMax[axis]);
+  }
+  const int markSize[3] = { markExt[1] - markExt[0] + 1, markExt[3] - markExt[2] + 1,
+    markExt[5] - markExt[4] + 1 };
+  const vtkIdType markIncs[3] = { 1, markSize[0],
+    static_cast<vtkIdType>(markSize[0]) * markSize[1] };
+  const int outSize[3] = { outExt[1] - outExt[0] + 1, outExt[3] - outExt[2] + 1,
+    outExt[5] - outExt[4] + 1 };
+  const vtkIdType dilatedIncs[3] = { 1, outSize[0],
+    static_cast<vtkIdType>(outSize[0]) * outSize[1] };
+  std::vector<unsigned char> marks(markIncs[2] * markSize[2]);
+  std::vector<unsigned char> dilated(dilatedIncs[2] * outSize[2]);
+
+  const T* markPtr = static_cast<T*>(inData->GetScalarPointer(markExt[0], markExt[2], markExt[4]));
+  const T* inPtr = static_cast<T*>(inData->GetScalarPointer(outExt[0], outExt[2], outExt[4]));
+  for (int idxC = 0; idxC < numComps; ++idxC)
+  {
+    vtkIdType markId = 0;
+    for (int idx2 = 0; idx2 < markSize[2]; ++idx2)
     {
-      T* outPtr1 = outPtr2;
-      const T* inPtr1 = inPtr2;
-      for (int outIdx1 = outMin1; !self->AbortExecute && outIdx1 <= outMax1; ++outIdx1)
+      for (int idx1 = 0; idx1 < markSize[1]; ++idx1)
       {
-        if (!id)
+        const T* inRow = markPtr + idxC + idx1 * inIncs[1] + idx2 * inIncs[2];
+        for (int idx0 = 0; idx0 < markSize[0]; ++idx0)
         {
-          if (!(count % target))
-          {
-            self->UpdateProgress(count / (50.0 * target));
-          }
-          count++;
+          marks[markId++] = (inRow[idx0 * inIncs[0]] == dilateValue);
         }
+      }
+    }
 
-        T* outPtr0 = outPtr1;
-        const T* inPtr0 = inPtr1;
-        for (int outIdx0 = outMin0; outIdx0 <= outMax0; ++outIdx0)
+    vtkImageMorphologyExecute<unsigned char>(self, kernel, marks.data(), markIncs, markExt,
+      dilated.data(), dilatedIncs, outExt, 0, std::less<unsigned char>(), id);
+
+    vtkIdType dilatedId = 0;
+    for (int idx2 = 0; idx2 < outSize[2]; ++idx2)
+    {
+      for (int idx1 = 0; idx1 < outSize[1]; ++idx1)
+      {
+        const T* inRow = inPtr + idxC + idx1 * inIncs[1] + idx2 * inIncs[2];
+        T* outRow = outPtr + idxC + idx1 * outIncs[1] + idx2 * outIncs[2];
+        for (int idx0 = 0; idx0 < outSize[0]; ++idx0)
         {
           // Default behavior (copy input pixel)
-          *outPtr0 = *inPtr0;
-          if (*inPtr0 == erodeValue)
+          T value = inRow[idx0 * inIncs[0]];
+          if (value == erodeValue && dilated[dilatedId])
           {
-            // loop through neighborhood pixels
-            // as sort of a hack to handle boundaries,
-            // input pointer will be marching through data that does not exist.
-            int hoodMinClamp2 = std::max(hoodMin2, inImageMin2 - outIdx2);
-            int hoodMaxClamp2 = std::min(hoodMax2, inImageMax2 - outIdx2);
-            const T* hoodPtr2 = inPtr0 - kernelMiddle[0] * inInc0 - kernelMiddle[1] * inInc1 -
-              kernelMiddle[2] * inInc2 + (hoodMinClamp2 - hoodMin2) * inInc2;
-            const unsigned char* maskPtr2 = maskPtr + (hoodMinClamp2 - hoodMin2) * maskInc2;
-            for (int hoodIdx2 = hoodMinClamp2; hoodIdx2 <= hoodMaxClamp2; ++hoodIdx2)
-            {
-              int hoodMinClamp1 = std::max(hoodMin1, inImageMin1 - outIdx1);
-              int hoodMaxClamp1 = std::min(hoodMax1, inImageMax1 - outIdx1);
-              const T* hoodPtr1 = hoodPtr2 + (hoodMinClamp1 - hoodMin1) * inInc1;
-              const unsigned char* maskPtr1 = maskPtr2 + (hoodMinClamp1 - hoodMin1) * maskInc1;
-              for (int hoodIdx1 = hoodMinClamp1; hoodIdx1 <= hoodMaxClamp1; ++hoodIdx1)
-              {
-                int hoodMinClamp0 = std::max(hoodMin0, inImageMin0 - outIdx0);
-                int hoodMaxClamp0 = std::min(hoodMax0, inImageMax0 - outIdx0);
-                const T* hoodPtr0 = hoodPtr1 + (hoodMinClamp0 - hoodMin0) * inInc0;
-                const unsigned char* maskPtr0 = maskPtr1 + (hoodMinClamp0 - hoodMin0) * maskInc0;
-                for (int hoodIdx0 = hoodMinClamp0; hoodIdx0 <= hoodMaxClamp0; ++hoodIdx0)
-                {
-                  if (*maskPtr0 != 0)
-                  {
-                    if (*hoodPtr0 == dilateValue)
-                    {
-                      *outPtr0 = dilateValue;
-                    }
-                  }
-
-                  hoodPtr0 += inInc0;
-                  maskPtr0 += maskInc0;
-                }
-                hoodPtr1 += inInc1;
-                maskPtr1 += maskInc1;
-              }
-              hoodPtr2 += inInc2;
-              maskPtr2 += maskInc2;
-            }
+            value = dilateValue;
           }
-
-          inPtr0 += inInc0;
-          outPtr0 += outInc0;
+          outRow[idx0 * outIncs[0]] = value;
+          ++dilatedId;
         }
-        inPtr1 += inInc1;
-        outPtr1 += outInc1;
       }
-      inPtr2 += inInc2;
-      outPtr2 += outInc2;
     }
-    ++inPtr;
-    ++outPtr;
   }
 }
 
@@ -243,14 +190,9 @@ void vtkImageDilateErode3DExecute(vtkImageDilateErode3D* self, vtkImageData* mas
 // templated function for the input and output Data types.
 // It handles image boundaries, so the image does not shrink.
 void vtkImageDilateErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* vtkNotUsed(outputVector),
   vtkImageData*** inData, vtkImageData** outData, int outExt[6], int id)
 {
-  int inExt[6], wholeExt[6];
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
-  this->InternalRequestUpdateExtent(inExt, outExt, wholeExt);
-  void* inPtr = inData[0][0]->GetScalarPointerForExtent(inExt);
   void* outPtr = outData[0]->GetScalarPointerForExtent(outExt);
   vtkImageData* mask;
 
@@ -271,10 +213,13 @@ void vtkImageDilateErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(reque
     return;
   }
 
+  const vtkImageMorphologyKernel kernel(
+    mask, this->KernelSize, this->KernelMiddle, this->KernelShape == Box);
+
   switch (inData[0][0]->GetScalarType())
   {
-    vtkTemplateMacro(vtkImageDilateErode3DExecute(this, mask, inData[0][0],
-      static_cast<VTK_TT*>(inPtr), outData[0], outExt, static_cast<VTK_TT*>(outPtr), id));
+    vtkTemplateMacro(vtkImageDilateErode3DExecute(
+      this, kernel, inData[0][0], outData[0], outExt, static_cast<VTK_TT*>(outPtr), id));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
       return;
@@ -5,7 +5,7 @@
  * @brief   Dilates one value and erodes another.
  *
  * vtkImageDilateErode3D will dilate one value and erode another.
- * It uses an elliptical foot print, and only erodes/dilates on the
+ * It uses an elliptical foot print (or a box), and only erodes/dilates on the
  * boundary of the two values.  The filter is restricted to the
  * X, Y, and Z axes for now.  It can degenerate to a 2 or 1 dimensional
  * filter by setting the kernel size to 1 for a specific axis.
@@ -39,6 +39,28 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  /**
+   * Enum constants for SetKernelShape().
+   */
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1
+  };
+
+  ///@{
+  /**
+   * Set the shape of the neighborhood, an ellipsoid (the default) or a box
+   * of the kernel size. The cost of a box per voxel does not depend on the
+   * kernel size, the cost of an ellipsoid grows with the size of its cross
+   * section in the YZ plane.
+   */
+  vtkSetClampMacro(KernelShape, int, Ellipsoid, Box);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  vtkGetMacro(KernelShape, int);
+  ///@}
+
   ///@{
   /**
    * Set/Get the Dilate and Erode values to be used by this filter.
@@ -54,6 +76,7 @@ protected:
   ~vtkImageDilateErode3D() override;
 
   vtkImageEllipsoidSource* Ellipse;
+  int KernelShape;
   double DilateValue;
   double ErodeValue;
 
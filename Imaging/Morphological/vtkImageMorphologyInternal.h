@@ -0,0 +1,329 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkImageMorphologyInternal
+ * @brief   maximum or minimum of an image over a structuring element
+ *
+ * This file computes the maximum (or the minimum) of an image over a flat
+ * structuring element, for vtkImageContinuousDilate3D,
+ * vtkImageContinuousErode3D and vtkImageDilateErode3D. The voxels of the
+ * structuring element that fall outside of the image are ignored.
+ *
+ * A box is separable, so it is handled as a sequence of one dimensional
+ * windows along each axis. Any other structuring element (the ellipsoid)
+ * is decomposed into the chords of its rows along the X axis, and the
+ * result is the maximum over the chords of the maxima of the input rows
+ * over each chord. The maximum over a window of length L along a line uses
+ * the van Herk/Gil-Werman algorithm, with about three comparisons per voxel
+ * whatever the value of L. A box costs a constant number of comparisons
+ * per voxel, and an ellipsoid a number proportional to the number of its
+ * rows instead of its volume.
+ *
+ * See M. van Herk, "A fast algorithm for local minimum and maximum filters
+ * on rectangular and octagonal kernels", Pattern Recognition Letters 13,
+ * 1992, and J. Gil and M. Werman, "Computing 2-D min, median, and max
+ * filters", IEEE Transactions on Pattern Analysis and Machine Intelligence
+ * 15, 1993.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkImageContinuousDilate3D vtkImageContinuousErode3D vtkImageDilateErode3D
+ */
+
+#ifndef vtkImageMorphologyInternal_h
+#define vtkImageMorphologyInternal_h
+
+#include "vtkAlgorithm.h"
+#include "vtkImageData.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Windows shorter than this are computed directly.
+constexpr int VTK_MORPHOLOGY_DIRECT_LENGTH = 4;
+
+// The structuring element, relative to the kernel middle.
+struct vtkImageMorphologyKernel
+{
+  // A row of the structuring element along X, at the given offsets along Y
+  // and Z, from Start to End along X.
+  struct Chord
+  {
+    int Offset1;
+    int Offset2;
+    int Start;
+    int End;
+  };
+
+  bool Box;
+  int HoodMin[3];
+  int HoodMax[3];
+  std::vector<Chord> Chords;
+
+  vtkImageMorphologyKernel(
+    vtkImageData* mask, const int kernelSize[3], const int kernelMiddle[3], bool box)
+  {
+    this->Box = box;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      this->HoodMin[axis] = -kernelMiddle[axis];
+      this->HoodMax[axis] = kernelSize[axis] - 1 - kernelMiddle[axis];
+    }
+    if (box)
+    {
+      return;
+    }
+
+    const unsigned char* maskPtr = static_cast<unsigned char*>(mask->GetScalarPointer());
+    vtkIdType maskIncs[3];
+    mask->GetIncrements(maskIncs);
+    for (int idx2 = 0; idx2 < kernelSize[2]; ++idx2)
+    {
+      for (int idx1 = 0; idx1 < kernelSize[1]; ++idx1)
+      {
+        const unsigned char* maskRow = maskPtr + idx1 * maskIncs[1] + idx2 * maskIncs[2];
+        int idx0 = 0;
+        while (idx0 < kernelSize[0])
+        {
+          if (maskRow[idx0 * maskIncs[0]] == 0)
+          {
+            ++idx0;
+            continue;
+          }
+          Chord chord;
+          chord.Offset1 = idx1 - kernelMiddle[1];
+          chord.Offset2 = idx2 - kernelMiddle[2];
+          chord.Start = idx0 - kernelMiddle[0];
+          while (idx0 < kernelSize[0] && maskRow[idx0 * maskIncs[0]] != 0)
+          {
+            ++idx0;
+          }
+          chord.End = idx0 - 1 - kernelMiddle[0];
+          this->Chords.push_back(chord);
+        }
+      }
+    }
+  }
+};
+
+// Reusable buffers for the lines.
+template <class T>
+struct vtkImageMorphologyLines
+{
+  std::vector<T> Values;
+  std::vector<T> Prefix;
+  std::vector<T> Suffix;
+  std::vector<T> Result;
+};
+
+// Combine into result[i], for i from 0 to count - 1, the maximum (for the
+// less comparison) of the line over the window from p0 + i + start to
+// p0 + i + end. The line has values from lineMin to lineMax, with the given
+// stride, and is padded with the neutral value.
+template <class T, class Compare>
+void vtkImageMorphologySlide(const T* line, vtkIdType stride, int lineMin, int lineMax, int p0,
+  int count, int start, int end, T neutral, Compare comp, T* result,
+  vtkImageMorphologyLines<T>& lines)
+{
+  const int length = end - start + 1;
+  const int n = count + length - 1;
+  lines.Values.resize(n);
+  T* values = lines.Values.data();
+  const int first = p0 + start;
+  for (int t = 0; t < n; ++t)
+  {
+    const int idx = first + t;
+    values[t] = (idx >= lineMin && idx <= lineMax ? line[(idx - lineMin) * stride] : neutral);
+  }
+
+  if (length <= VTK_MORPHOLOGY_DIRECT_LENGTH)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      T v = result[i];
+      for (int t = i; t < i + length; ++t)
+      {
+        v = (comp(v, values[t]) ? values[t] : v);
+      }
+      result[i] = v;
+    }
+    return;
+  }
+
+  // maxima from the start of each block of the window length, and to the
+  // end of each block, every window covers the end of one block and the
+  // start of the next one
+  lines.Prefix.resize(n);
+  lines.Suffix.resize(n);
+  T* prefix = lines.Prefix.data();
+  T* suffix = lines.Suffix.data();
+  for (int t = 0; t < n; ++t)
+  {
+    prefix[t] = values[t];
+    if (t % length != 0 && comp(values[t], prefix[t - 1]))
+    {
+      prefix[t] = prefix[t - 1];
+    }
+  }
+  for (int t = n - 1; t >= 0; --t)
+  {
+    suffix[t] = values[t];
+    if (t % length != length - 1 && t < n - 1 && comp(values[t], suffix[t + 1]))
+    {
+      suffix[t] = suffix[t + 1];
+    }
+  }
+  for (int i = 0; i < count; ++i)
+  {
+    T v = (comp(suffix[i], prefix[i + length - 1]) ? prefix[i + length - 1] : suffix[i]);
+    result[i] = (comp(result[i], v) ? v : result[i]);
+  }
+}
+
+// The maximum (for the less comparison) of one component of the input over
+// the structuring element, for the voxels of outExt. The input pointer is
+// the voxel at the start of inExt, the extent of the image, and the output
+// pointer the voxel at the start of outExt. The increments are in scalars.
+template <class T, class Compare>
+void vtkImageMorphologyExecute(vtkAlgorithm* self, const vtkImageMorphologyKernel& kernel,
+  const T* inPtr, const vtkIdType inIncs[3], const int inExt[6], T* outPtr,
+  const vtkIdType outIncs[3], const int outExt[6], T neutral, Compare comp, int id)
+{
+  vtkImageMorphologyLines<T> lines;
+  const int outSize[3] = { outExt[1] - outExt[0] + 1, outExt[3] - outExt[2] + 1,
+    outExt[5] - outExt[4] + 1 };
+
+  if (!kernel.Box)
+  {
+    // the maximum over the chords of the rows, starting with the voxel
+    lines.Result.resize(outSize[0]);
+    T* result = lines.Result.data();
+    for (int idx2 = outExt[4]; idx2 <= outExt[5] && !self->AbortExecute; ++idx2)
+    {
+      if (!id)
+      {
+        self->UpdateProgress(static_cast<double>(idx2 - outExt[4]) / outSize[2]);
+      }
+      for (int idx1 = outExt[2]; idx1 <= outExt[3]; ++idx1)
+      {
+        const T* inRow = inPtr + (idx1 - inExt[2]) * inIncs[1] + (idx2 - inExt[4]) * inIncs[2];
+        for (int i = 0; i < outSize[0]; ++i)
+        {
+          result[i] = inRow[(outExt[0] + i - inExt[0]) * inIncs[0]];
+        }
+        for (const auto& chord : kernel.Chords)
+        {
+          const int y = idx1 + chord.Offset1;
+          const int z = idx2 + chord.Offset2;
+          if (y < inExt[2] || y > inExt[3] || z < inExt[4] || z > inExt[5])
+          {
+            continue;
+          }
+          vtkImageMorphologySlide(inPtr + (y - inExt[2]) * inIncs[1] + (z - inExt[4]) * inIncs[2],
+            inIncs[0], inExt[0], inExt[1], outExt[0], outSize[0], chord.Start, chord.End, neutral,
+            comp, result, lines);
+        }
+        T* outRow = outPtr + (idx1 - outExt[2]) * outIncs[1] + (idx2 - outExt[4]) * outIncs[2];
+        for (int i = 0; i < outSize[0]; ++i)
+        {
+          outRow[i * outIncs[0]] = result[i];
+        }
+      }
+    }
+    return;
+  }
+
+  // A box is separable, it is applied along z, y and x to the part of the
+  // input that the neighborhoods of the output voxels cover.
+  int srcExt[6];
+  const T* srcPtr = inPtr;
+  vtkIdType srcIncs[3] = { inIncs[0], inIncs[1], inIncs[2] };
+  int axes[3];
+  int numAxes = 0;
+  for (int axis = 2; axis >= 0; --axis)
+  {
+    srcExt[2 * axis] = std::max(inExt[2 * axis], outExt[2 * axis] + kernel.HoodMin[axis]);
+    srcExt[2 * axis + 1] =
+      std::min(inExt[2 * axis + 1], outExt[2 * axis + 1] + kernel.HoodMax[axis]);
+    srcPtr += (srcExt[2 * axis] - inExt[2 * axis]) * srcIncs[axis];
+    if (kernel.HoodMin[axis] != 0 || kernel.HoodMax[axis] != 0)
+    {
+      axes[numAxes++] = axis;
+    }
+  }
+  if (numAxes == 0)
+  {
+    // copy the input with a window of one voxel
+    axes[numAxes++] = 0;
+  }
+
+  std::vector<T> temp[2];
+  for (int pass = 0; pass < numAxes; ++pass)
+  {
+    const int axis = axes[pass];
+    int dstExt[6];
+    std::copy(srcExt, srcExt + 6, dstExt);
+    dstExt[2 * axis] = outExt[2 * axis];
+    dstExt[2 * axis + 1] = outExt[2 * axis + 1];
+    T* dstPtr = outPtr;
+    vtkIdType dstIncs[3] = { outIncs[0], outIncs[1], outIncs[2] };
+    if (pass < numAxes - 1)
+    {
+      std::vector<T>& buffer = temp[pass % 2];
+      buffer.resize(static_cast<size_t>(dstExt[1] - dstExt[0] + 1) *
+        (dstExt[3] - dstExt[2] + 1) * (dstExt[5] - dstExt[4] + 1));
+      dstPtr = buffer.data();
+      dstIncs[0] = 1;
+      dstIncs[1] = dstExt[1] - dstExt[0] + 1;
+      dstIncs[2] = dstIncs[1] * (dstExt[3] - dstExt[2] + 1);
+    }
+
+    // the lines along the axis, for all the voxels of the other two axes
+    const int axisU = (axis == 0 ? 1 : 0);
+    const int axisV = (axis == 2 ? 1 : 2);
+    const int count = dstExt[2 * axis + 1] - dstExt[2 * axis] + 1;
+    lines.Result.resize(count);
+    T* result = lines.Result.data();
+    for (int v = dstExt[2 * axisV]; v <= dstExt[2 * axisV + 1] && !self->AbortExecute; ++v)
+    {
+      if (!id)
+      {
+        self->UpdateProgress((pass + static_cast<double>(v - dstExt[2 * axisV]) /
+                                (dstExt[2 * axisV + 1] - dstExt[2 * axisV] + 1)) /
+          numAxes);
+      }
+      for (int u = dstExt[2 * axisU]; u <= dstExt[2 * axisU + 1]; ++u)
+      {
+        const T* srcLine = srcPtr + (u - srcExt[2 * axisU]) * srcIncs[axisU] +
+          (v - srcExt[2 * axisV]) * srcIncs[axisV];
+        T* dstLine = dstPtr + (u - dstExt[2 * axisU]) * dstIncs[axisU] +
+          (v - dstExt[2 * axisV]) * dstIncs[axisV];
+        std::fill(result, result + count, neutral);
+        vtkImageMorphologySlide(srcLine, srcIncs[axis], srcExt[2 * axis], srcExt[2 * axis + 1],
+          dstExt[2 * axis], count, kernel.HoodMin[axis], kernel.HoodMax[axis], neutral, comp,
+          result, lines);
+        for (int i = 0; i < count; ++i)
+        {
+          dstLine[i * dstIncs[axis]] = result[i];
+        }
+      }
+    }
+
+    srcPtr = dstPtr;
+    std::copy(dstExt, dstExt + 6, srcExt);
+    std::copy(dstIncs, dstIncs + 3, srcIncs);
+  }
+}
+
+} // anonymous namespace
+
+#endif // vtkImageMorphologyInternal_h
+// VTK-HeaderTest-Exclude: vtkImageMorphologyInternal.h
@@ -6,7 +6,8 @@
  *
  * vtkImageOpenClose3D performs opening or closing by having two
  * vtkImageErodeDilates in series.  The size of operation
- * is determined by the method SetKernelSize, and the operator is an ellipse.
+ * is determined by the method SetKernelSize, and the operator is an ellipse,
+ * or a box when SetKernelShapeToBox is used.
  * OpenValue and CloseValue determine how the filter behaves.  For binary
  * images Opening and closing behaves as expected.
  * Close value is first dilated, and then eroded.
@@ -65,6 +66,17 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  ///@{
+  /**
+   * Selects the shape of the neighborhood, see vtkImageDilateErode3D.
+   * The box is faster for large kernel sizes.
+   */
+  void SetKernelShape(int shape);
+  void SetKernelShapeToEllipsoid();
+  void SetKernelShapeToBox();
+  int GetKernelShape();
+  ///@}
+
   ///@{
   /**
    * Determines the value that will opened.
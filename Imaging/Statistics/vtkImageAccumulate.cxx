@@ -3,14 +3,21 @@
 #include "vtkImageAccumulate.h"
 
 #include "vtkImageData.h"
+#include "vtkImageHistogramInternal.h"
+#include "vtkImagePointDataIterator.h"
 #include "vtkImageStencilData.h"
 #include "vtkImageStencilIterator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkRunLengthArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -105,58 +112,168 @@ vtkImageStencilData* vtkImageAccumulate::GetStencil()
 }
 
 //------------------------------------------------------------------------------
-// This templated function executes the filter for any type of data.
+// anonymous namespace for internal classes and functions
+namespace
+{
+
+// The bins and the statistics gathered by each thread.
+struct vtkImageAccumulateThreadData
+{
+  vtkImageHistogramBins Bins;
+  double Sum[3];
+  double SumSqr[3];
+  double Min[3];
+  double Max[3];
+  vtkIdType VoxelCount;
+};
+
+//------------------------------------------------------------------------------
+// Functor for vtkSMPTools, each thread accumulates the pieces of the extent
+// that it is given into its own bins, and the bins are summed in Reduce().
 template <class T>
-int vtkImageAccumulateExecute(vtkImageAccumulate* self, vtkImageData* inData, T*,
-  vtkImageData* outData, vtkIdType* outPtr, double min[3], double max[3], double mean[3],
-  double standardDeviation[3], vtkIdType* voxelCount, int* updateExtent)
+class vtkImageAccumulateFunctor
 {
-  // variables used to compute statistics (filter handles max 3 components)
-  double sum[3];
-  sum[0] = sum[1] = sum[2] = 0.0;
-  double sumSqr[3];
-  sumSqr[0] = sumSqr[1] = sumSqr[2] = 0.0;
-  min[0] = min[1] = min[2] = VTK_DOUBLE_MAX;
-  max[0] = max[1] = max[2] = VTK_DOUBLE_MIN;
-  standardDeviation[0] = standardDeviation[1] = standardDeviation[2] = 0.0;
-  *voxelCount = 0;
+public:
+  vtkImageAccumulateFunctor(vtkImageAccumulate* self, vtkImageData* inData,
+    vtkImageData* outData, vtkIdType* outPtr, const int* updateExtent, int splitAxis,
+    double min[3], double max[3], double sum[3], double sumSqr[3], vtkIdType* voxelCount)
+    : Self(self)
+    , InData(inData)
+    , OutPtr(outPtr)
+    , UpdateExtent(updateExtent)
+    , SplitAxis(splitAxis)
+    , MinOut(min)
+    , MaxOut(max)
+    , SumOut(sum)
+    , SumSqrOut(sumSqr)
+    , VoxelCountOut(voxelCount)
+  {
+    this->Stencil = self->GetStencil();
+    this->ReverseStencil = (self->GetReverseStencil() != 0);
+    this->IgnoreZero = (self->GetIgnoreZero() != 0);
+    this->NumberOfComponents = inData->GetNumberOfScalarComponents();
+
+    outData->GetExtent(this->OutExtent);
+    outData->GetIncrements(this->OutIncs);
+    outData->GetOrigin(this->Origin);
+    outData->GetSpacing(this->Spacing);
+    this->NumberOfBins = 1;
+    for (int i = 0; i < 3; i++)
+    {
+      this->NumberOfBins *= (this->OutExtent[2 * i + 1] - this->OutExtent[2 * i] + 1);
+    }
 
-  // input's number of components is used as output dimensionality
-  int numC = inData->GetNumberOfScalarComponents();
-  if (numC > 3)
+    // scalars that are stored as runs are accumulated one run at a time
+    this->Runs = nullptr;
+    vtkRunLengthArray<T>* runArray =
+      vtkArrayDownCast<vtkRunLengthArray<T>>(inData->GetPointData()->GetScalars());
+    const int* inExt = inData->GetExtent();
+    this->RowsPerSlice = inExt[3] - inExt[2] + 1;
+    if (runArray && runArray->GetBackend() && this->NumberOfComponents == 1 &&
+      runArray->GetBackend()->GetRowLength() == inExt[1] - inExt[0] + 1 &&
+      runArray->GetBackend()->GetNumberOfRows() == this->RowsPerSlice * (inExt[5] - inExt[4] + 1))
+    {
+      this->Runs = runArray->GetBackend().get();
+    }
+  }
+
+  void Initialize()
   {
-    return 0;
+    vtkImageAccumulateThreadData& data = this->ThreadData.Local();
+    data.Bins.Initialize(this->NumberOfBins);
+    for (int i = 0; i < 3; i++)
+    {
+      data.Sum[i] = 0.0;
+      data.SumSqr[i] = 0.0;
+      data.Min[i] = VTK_DOUBLE_MAX;
+      data.Max[i] = VTK_DOUBLE_MIN;
+    }
+    data.VoxelCount = 0;
   }
 
-  // get information for output data
-  int outExtent[6];
-  outData->GetExtent(outExtent);
-  vtkIdType outIncs[3];
-  outData->GetIncrements(outIncs);
-  double origin[3];
-  outData->GetOrigin(origin);
-  double spacing[3];
-  outData->GetSpacing(spacing);
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int extent[6];
+    vtkImageHistogramPieceExtent(this->UpdateExtent, this->SplitAxis, begin, end, extent);
+    // progress can only be reported from the main thread
+    vtkAlgorithm* progress = (vtkSMPTools::GetSingleThread() ? this->Self : nullptr);
+    if (this->Runs)
+    {
+      this->AccumulateRuns(extent, progress);
+    }
+    else
+    {
+      this->AccumulateVoxels(extent, progress);
+    }
+  }
 
-  // zero count in every bin
-  vtkIdType size = 1;
-  size *= (outExtent[1] - outExtent[0] + 1);
-  size *= (outExtent[3] - outExtent[2] + 1);
-  size *= (outExtent[5] - outExtent[4] + 1);
-  for (vtkIdType j = 0; j < size; j++)
+  void Reduce()
   {
-    outPtr[j] = 0;
+    double* min = this->MinOut;
+    double* max = this->MaxOut;
+    double* sum = this->SumOut;
+    double* sumSqr = this->SumSqrOut;
+    vtkIdType* voxelCount = this->VoxelCountOut;
+
+    for (const vtkImageAccumulateThreadData& data : this->ThreadData)
+    {
+      data.Bins.AddTo(this->OutPtr);
+      for (int i = 0; i < 3; i++)
+      {
+        sum[i] += data.Sum[i];
+        sumSqr[i] += data.SumSqr[i];
+        min[i] = (data.Min[i] < min[i] ? data.Min[i] : min[i]);
+        max[i] = (data.Max[i] > max[i] ? data.Max[i] : max[i]);
+      }
+      *voxelCount += data.VoxelCount;
+    }
   }
 
-  vtkImageStencilData* stencil = self->GetStencil();
-  bool reverseStencil = (self->GetReverseStencil() != 0);
-  bool ignoreZero = (self->GetIgnoreZero() != 0);
+private:
+  void AccumulateVoxels(const int extent[6], vtkAlgorithm* progress);
+  void AccumulateRuns(const int extent[6], vtkAlgorithm* progress);
+
+  vtkImageAccumulate* Self;
+  vtkImageData* InData;
+  vtkIdType* OutPtr;
+  const int* UpdateExtent;
+  int SplitAxis;
+  double* MinOut;
+  double* MaxOut;
+  double* SumOut;
+  double* SumSqrOut;
+  vtkIdType* VoxelCountOut;
+  vtkImageStencilData* Stencil;
+  bool ReverseStencil;
+  bool IgnoreZero;
+  int NumberOfComponents;
+  int OutExtent[6];
+  vtkIdType OutIncs[3];
+  double Origin[3];
+  double Spacing[3];
+  vtkIdType NumberOfBins;
+  const vtkRunLengthImplicitBackend<T>* Runs;
+  vtkIdType RowsPerSlice;
+  vtkSMPThreadLocal<vtkImageAccumulateThreadData> ThreadData;
+};
 
-  vtkImageStencilIterator<T> inIter(inData, stencil, updateExtent, self);
+//------------------------------------------------------------------------------
+template <class T>
+void vtkImageAccumulateFunctor<T>::AccumulateVoxels(const int extent[6], vtkAlgorithm* progress)
+{
+  vtkImageAccumulateThreadData& data = this->ThreadData.Local();
+  const int numC = this->NumberOfComponents;
+  const int* outExtent = this->OutExtent;
+  const vtkIdType* outIncs = this->OutIncs;
+  const double* origin = this->Origin;
+  const double* spacing = this->Spacing;
+  const bool ignoreZero = this->IgnoreZero;
+
+  vtkImageStencilIterator<T> inIter(this->InData, this->Stencil, extent, progress);
 
   while (!inIter.IsAtEnd())
   {
-    if (inIter.IsInStencil() ^ reverseStencil)
+    if (inIter.IsInStencil() ^ this->ReverseStencil)
     {
       T* inPtr = inIter.BeginSpan();
       T* spanEndPtr = inIter.EndSpan();
@@ -165,24 +282,24 @@ int vtkImageAccumulateExecute(vtkImageAccumulate* self, vtkImageData* inData, T*
       {
         // find the bin for this pixel.
         bool outOfBounds = false;
-        vtkIdType* outPtrC = outPtr;
+        vtkIdType bin = 0;
         for (int idxC = 0; idxC < numC; ++idxC)
         {
           double v = static_cast<double>(*inPtr++);
           if (!ignoreZero || v != 0)
           {
             // gather statistics
-            sum[idxC] += v;
-            sumSqr[idxC] += v * v;
-            if (v > max[idxC])
+            data.Sum[idxC] += v;
+            data.SumSqr[idxC] += v * v;
+            if (v > data.Max[idxC])
             {
-              max[idxC] = v;
+              data.Max[idxC] = v;
             }
-            if (v < min[idxC])
+            if (v < data.Min[idxC])
             {
-              min[idxC] = v;
+              data.Min[idxC] = v;
             }
-            (*voxelCount)++;
+            data.VoxelCount++;
           }
 
           // compute the index
@@ -191,7 +308,7 @@ int vtkImageAccumulateExecute(vtkImageAccumulate* self, vtkImageData* inData, T*
           // verify that it is in range
           if (outIdx >= outExtent[idxC * 2] && outIdx <= outExtent[idxC * 2 + 1])
           {
-            outPtrC += (outIdx - outExtent[idxC * 2]) * outIncs[idxC];
+            bin += (outIdx - outExtent[idxC * 2]) * outIncs[idxC];
           }
           else
           {
@@ -202,13 +319,116 @@ int vtkImageAccumulateExecute(vtkImageAccumulate* self, vtkImageData* inData, T*
         // increment the bin
         if (!outOfBounds)
         {
-          ++(*outPtrC);
+          data.Bins.Add(bin);
         }
       }
     }
 
     inIter.NextSpan();
   }
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkImageAccumulateFunctor<T>::AccumulateRuns(const int extent[6], vtkAlgorithm* progress)
+{
+  vtkImageAccumulateThreadData& data = this->ThreadData.Local();
+  const vtkRunLengthImplicitBackend<T>* runs = this->Runs;
+  const double background = static_cast<double>(runs->GetBackgroundValue());
+  const int* inExt = this->InData->GetExtent();
+
+  // add a value that is repeated count times
+  auto accumulate = [&](double v, vtkIdType count) {
+    if (!this->IgnoreZero || v != 0)
+    {
+      data.Sum[0] += v * count;
+      data.SumSqr[0] += v * v * count;
+      data.Max[0] = std::max(data.Max[0], v);
+      data.Min[0] = std::min(data.Min[0], v);
+      data.VoxelCount += count;
+    }
+    int outIdx = vtkMath::Floor((v - this->Origin[0]) / this->Spacing[0]);
+    if (outIdx >= this->OutExtent[0] && outIdx <= this->OutExtent[1])
+    {
+      data.Bins.Add((outIdx - this->OutExtent[0]) * this->OutIncs[0], count);
+    }
+  };
+
+  vtkImagePointDataIterator iter(this->InData, extent, this->Stencil, progress);
+  while (!iter.IsAtEnd())
+  {
+    if (iter.IsInStencil() ^ this->ReverseStencil)
+    {
+      const int* idx = iter.GetIndex();
+      const vtkIdType row = (idx[1] - inExt[2]) + (idx[2] - inExt[4]) * this->RowsPerSlice;
+      const int spanStart = idx[0] - inExt[0];
+      const int spanEnd = spanStart + static_cast<int>(iter.SpanEndId() - iter.GetId()) - 1;
+
+      const int* starts;
+      const int* ends;
+      const T* values;
+      const int n = runs->GetRowRuns(row, starts, ends, values);
+      int next = spanStart;
+      for (int i = static_cast<int>(std::lower_bound(ends, ends + n, spanStart) - ends);
+           i < n && starts[i] <= spanEnd; ++i)
+      {
+        const int r1 = std::max(starts[i], spanStart);
+        const int r2 = std::min(ends[i], spanEnd);
+        if (r1 > next)
+        {
+          accumulate(background, r1 - next);
+        }
+        accumulate(static_cast<double>(values[i]), r2 - r1 + 1);
+        next = r2 + 1;
+      }
+      if (next <= spanEnd)
+      {
+        accumulate(background, spanEnd - next + 1);
+      }
+    }
+    iter.NextSpan();
+  }
+}
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// This templated function executes the filter for any type of data.
+template <class T>
+int vtkImageAccumulateExecute(vtkImageAccumulate* self, vtkImageData* inData, T*,
+  vtkImageData* outData, vtkIdType* outPtr, double min[3], double max[3], double mean[3],
+  double standardDeviation[3], vtkIdType* voxelCount, int* updateExtent)
+{
+  // variables used to compute statistics (filter handles max 3 components)
+  double sum[3];
+  sum[0] = sum[1] = sum[2] = 0.0;
+  double sumSqr[3];
+  sumSqr[0] = sumSqr[1] = sumSqr[2] = 0.0;
+  min[0] = min[1] = min[2] = VTK_DOUBLE_MAX;
+  max[0] = max[1] = max[2] = VTK_DOUBLE_MIN;
+  standardDeviation[0] = standardDeviation[1] = standardDeviation[2] = 0.0;
+  *voxelCount = 0;
+
+  // input's number of components is used as output dimensionality
+  int numC = inData->GetNumberOfScalarComponents();
+  if (numC > 3)
+  {
+    return 0;
+  }
+
+  // zero count in every bin
+  vtkIdType size = outData->GetNumberOfPoints();
+  for (vtkIdType j = 0; j < size; j++)
+  {
+    outPtr[j] = 0;
+  }
+
+  // each thread accumulates whole slices (or rows, for a single slice)
+  int splitAxis;
+  vtkIdType pieces = vtkImageHistogramNumberOfPieces(updateExtent, splitAxis);
+  vtkImageAccumulateFunctor<T> functor(
+    self, inData, outData, outPtr, updateExtent, splitAxis, min, max, sum, sumSqr, voxelCount);
+  vtkSMPTools::For(0, pieces, functor);
 
   // initialize the statistics
   mean[0] = 0;
@@ -246,7 +466,6 @@ int vtkImageAccumulateExecute(vtkImageAccumulate* self, vtkImageData* inData, T*
 int vtkImageAccumulate::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  void* inPtr;
   void* outPtr;
 
   // get the input
@@ -265,8 +484,8 @@ int vtkImageAccumulate::RequestData(vtkInformation* vtkNotUsed(request),
   outData->SetExtent(outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
   outData->AllocateScalars(outInfo);
 
-  vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector);
-  inPtr = inData->GetArrayPointerForExtent(inArray, uExt);
+  // the input is read through iterators, which do not require contiguous
+  // scalars when the scalars are stored as runs
   outPtr = outData->GetScalarPointer();
 
   // Components turned into x, y and z
@@ -287,7 +506,7 @@ int vtkImageAccumulate::RequestData(vtkInformation* vtkNotUsed(request),
   int retVal = 0;
   switch (inData->GetScalarType())
   {
-    vtkTemplateMacro(retVal = vtkImageAccumulateExecute(this, inData, static_cast<VTK_TT*>(inPtr),
+    vtkTemplateMacro(retVal = vtkImageAccumulateExecute(this, inData, static_cast<VTK_TT*>(nullptr),
                        outData, static_cast<vtkIdType*>(outPtr), this->Min, this->Max, this->Mean,
                        this->StandardDeviation, &this->VoxelCount, uExt));
     default:
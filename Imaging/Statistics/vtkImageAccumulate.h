@@ -20,6 +20,12 @@
  * option with vtkImageMask may result in results being slightly off since 0
  * could be a valid value from your input.
  *
+ * If the input scalars are a vtkRunLengthArray, each run is accumulated as
+ * a whole rather than voxel by voxel.
+ *
+ * The histogram is computed with vtkSMPTools. Each thread counts into its
+ * own bins, which are stored sparsely when the histogram has many bins, and
+ * the bins of all threads are summed at the end.
  */
 
 #ifndef vtkImageAccumulate_h
@@ -4,6 +4,7 @@
 
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkImageHistogramInternal.h"
 #include "vtkImageStencilData.h"
 #include "vtkImageStencilIterator.h"
 #include "vtkInformation.h"
@@ -11,11 +12,16 @@
 #include "vtkMath.h"
 #include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTemplateAliasMacro.h"
 
+#include <algorithm>
 #include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 // turn off 64-bit ints when templating over all types
 #undef VTK_USE_INT64
@@ -63,7 +69,10 @@ vtkImageHistogram::vtkImageHistogram()
   this->HistogramImageSize[1] = 256;
   this->HistogramImageScale = vtkImageHistogram::Linear;
 
+  this->GenerateJointHistogram = false;
+
   this->Histogram = vtkIdTypeArray::New();
+  this->JointHistogram = vtkIdTypeArray::New();
   this->Total = 0;
 
   this->ThreadData = nullptr;
@@ -80,6 +89,10 @@ vtkImageHistogram::~vtkImageHistogram()
   {
     this->Histogram->Delete();
   }
+  if (this->JointHistogram)
+  {
+    this->JointHistogram->Delete();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -103,8 +116,11 @@ void vtkImageHistogram::PrintSelf(ostream& os, vtkIndent indent)
      << this->HistogramImageSize[1] << "\n";
   os << indent << "HistogramImageScale: " << this->GetHistogramImageScaleAsString() << "\n";
 
+  os << indent << "GenerateJointHistogram: " << (this->GenerateJointHistogram ? "On\n" : "Off\n");
+
   os << indent << "Total: " << this->Total << "\n";
   os << indent << "Histogram: " << this->Histogram << "\n";
+  os << indent << "JointHistogram: " << this->JointHistogram << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -134,6 +150,12 @@ vtkIdTypeArray* vtkImageHistogram::GetHistogram()
   return this->Histogram;
 }
 
+//------------------------------------------------------------------------------
+vtkIdTypeArray* vtkImageHistogram::GetJointHistogram()
+{
+  return this->JointHistogram;
+}
+
 //------------------------------------------------------------------------------
 void vtkImageHistogram::SetStencilData(vtkImageStencilData* stencil)
 {
@@ -544,6 +566,138 @@ void vtkImageHistogramGenerateImage(
   }
 }
 
+//------------------------------------------------------------------------------
+// Functor for vtkSMPTools, computes the joint histogram of all components
+// with thread-local bins that are summed in Reduce().
+template <class T>
+class vtkImageJointHistogramFunctor
+{
+public:
+  vtkImageJointHistogramFunctor(vtkImageHistogram* self, vtkImageData* inData,
+    vtkImageStencilData* stencil, const int* extent, int splitAxis, vtkIdType jointBins,
+    std::vector<std::pair<vtkIdType, vtkIdType>>* result)
+    : Self(self)
+    , InData(inData)
+    , Stencil(stencil)
+    , Extent(extent)
+    , SplitAxis(splitAxis)
+    , JointBins(jointBins)
+    , Result(result)
+  {
+    this->NumberOfComponents = inData->GetNumberOfScalarComponents();
+    this->NumberOfBins = self->GetNumberOfBins();
+    this->BinOrigin = self->GetBinOrigin();
+    this->BinSpacing = self->GetBinSpacing();
+  }
+
+  void Initialize() { this->ThreadBins.Local().Initialize(this->JointBins); }
+
+  void operator()(vtkIdType begin, vtkIdType end);
+
+  void Reduce();
+
+private:
+  vtkImageHistogram* Self;
+  vtkImageData* InData;
+  vtkImageStencilData* Stencil;
+  const int* Extent;
+  int SplitAxis;
+  vtkIdType JointBins;
+  std::vector<std::pair<vtkIdType, vtkIdType>>* Result;
+  int NumberOfComponents;
+  int NumberOfBins;
+  double BinOrigin;
+  double BinSpacing;
+  vtkSMPThreadLocal<vtkImageHistogramBins> ThreadBins;
+};
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkImageJointHistogramFunctor<T>::operator()(vtkIdType begin, vtkIdType end)
+{
+  vtkImageHistogramBins& bins = this->ThreadBins.Local();
+  int extent[6];
+  vtkImageHistogramPieceExtent(this->Extent, this->SplitAxis, begin, end, extent);
+  // progress can only be reported from the main thread
+  vtkAlgorithm* progress = (vtkSMPTools::GetSingleThread() ? this->Self : nullptr);
+  vtkImageStencilIterator<T> inIter(this->InData, this->Stencil, extent, progress);
+
+  // compute shift/scale values for fast bin computation
+  int nc = this->NumberOfComponents;
+  double xmin = 0.0;
+  double xmax = this->NumberOfBins - 1;
+  double xshift = -this->BinOrigin;
+  double xscale = 1.0 / this->BinSpacing;
+
+  // iterate over all spans in the stencil
+  while (!inIter.IsAtEnd())
+  {
+    if (inIter.IsInStencil())
+    {
+      T* inPtr = inIter.BeginSpan();
+      T* inPtrEnd = inIter.EndSpan();
+
+      // iterate over all voxels in the span
+      while (inPtr != inPtrEnd)
+      {
+        vtkIdType bin = 0;
+        vtkIdType stride = 1;
+        for (int c = 0; c < nc; c++)
+        {
+          double x = *inPtr++;
+
+          x += xshift;
+          x *= xscale;
+
+          // clamp as for the histogram, NaN goes to the first bin
+          x = (x > xmin ? x : xmin);
+          x = (x < xmax ? x : xmax);
+
+          bin += static_cast<int>(x + 0.5) * stride;
+          stride *= this->NumberOfBins;
+        }
+        bins.Add(bin);
+      }
+    }
+    inIter.NextSpan();
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkImageJointHistogramFunctor<T>::Reduce()
+{
+  std::vector<std::pair<vtkIdType, vtkIdType>>& result = *this->Result;
+  result.clear();
+
+  if (this->JointBins <= VTK_HISTOGRAM_MAX_DENSE_BINS)
+  {
+    // sum the bins of all threads, then keep the bins that are not empty
+    std::vector<vtkIdType> histogram(this->JointBins, 0);
+    for (const vtkImageHistogramBins& bins : this->ThreadBins)
+    {
+      bins.AddTo(histogram.data());
+    }
+    for (vtkIdType i = 0; i < this->JointBins; i++)
+    {
+      if (histogram[i] != 0)
+      {
+        result.emplace_back(i, histogram[i]);
+      }
+    }
+  }
+  else
+  {
+    std::unordered_map<vtkIdType, vtkIdType> histogram;
+    for (const vtkImageHistogramBins& bins : this->ThreadBins)
+    {
+      bins.AddTo(histogram);
+    }
+    result.assign(histogram.begin(), histogram.end());
+    std::sort(result.begin(), result.end());
+  }
+}
+
 } // end anonymous namespace
 
 // Functor for vtkSMPTools execution
@@ -799,6 +953,14 @@ int vtkImageHistogram::RequestData(
     delete[] this->ThreadData;
   }
 
+  // compute the joint histogram of all components
+  this->JointHistogram->SetNumberOfComponents(inData->GetNumberOfScalarComponents() + 1);
+  this->JointHistogram->SetNumberOfTuples(0);
+  if (this->GenerateJointHistogram)
+  {
+    this->ComputeJointHistogram(inData);
+  }
+
   // generate the output image
   if (this->GetNumberOfOutputPorts() > 0 && this->GenerateHistogramImage)
   {
@@ -993,4 +1155,55 @@ void vtkImageHistogram::ComputeImageScalarRange(vtkImageData* data, double range
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
   }
 }
+
+//------------------------------------------------------------------------------
+void vtkImageHistogram::ComputeJointHistogram(vtkImageData* data)
+{
+  int nc = data->GetNumberOfScalarComponents();
+  int* extent = data->GetExtent();
+  if (extent[1] < extent[0] || extent[3] < extent[2] || extent[5] < extent[4])
+  {
+    return;
+  }
+
+  // the joint bin index must fit in a vtkIdType
+  double jointBins = std::pow(static_cast<double>(this->NumberOfBins), nc);
+  if (jointBins > static_cast<double>(VTK_ID_MAX))
+  {
+    vtkErrorMacro("Too many bins for a joint histogram of " << nc << " components.");
+    return;
+  }
+
+  // each thread bins whole slices (or rows, for a single slice)
+  int splitAxis;
+  vtkIdType pieces = vtkImageHistogramNumberOfPieces(extent, splitAxis);
+  std::vector<std::pair<vtkIdType, vtkIdType>> result;
+  bool debug = this->Debug;
+  this->Debug = false;
+  switch (data->GetScalarType())
+  {
+    vtkTemplateAliasMacro(
+      vtkImageJointHistogramFunctor<VTK_TT> functor(this, data, this->GetStencil(), extent,
+        splitAxis, static_cast<vtkIdType>(jointBins), &result);
+      vtkSMPTools::For(0, pieces, functor));
+    default:
+      vtkErrorMacro(<< "Execute: Unknown ScalarType");
+  }
+  this->Debug = debug;
+
+  // convert the linear bin index into one index per component
+  vtkIdType n = static_cast<vtkIdType>(result.size());
+  this->JointHistogram->SetNumberOfTuples(n);
+  vtkIdType* outPtr = this->JointHistogram->GetPointer(0);
+  for (vtkIdType i = 0; i < n; i++)
+  {
+    vtkIdType bin = result[i].first;
+    for (int c = 0; c < nc; c++)
+    {
+      *outPtr++ = bin % this->NumberOfBins;
+      bin /= this->NumberOfBins;
+    }
+    *outPtr++ = result[i].second;
+  }
+}
 VTK_ABI_NAMESPACE_END
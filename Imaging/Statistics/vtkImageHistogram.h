@@ -10,7 +10,8 @@
  * result in a multi-dimensional histogram.  Instead, the resulting
  * histogram will be the sum of the histograms of each of the individual
  * components, unless SetActiveComponent is used to choose a single
- * component.
+ * component.  A joint histogram of all of the components can also be
+ * computed, see GenerateJointHistogram.
  * @par Thanks:
  * Thanks to David Gobbi at the Seaman Family MR Centre and Dept. of Clinical
  * Neurosciences, Foothills Medical Centre, Calgary, for providing this class.
@@ -171,6 +172,30 @@ public:
    */
   vtkIdType GetTotal() { return this->Total; }
 
+  ///@{
+  /**
+   * If this is On, then a joint histogram of all the components will also
+   * be computed (default Off).  Each voxel of an image with N components
+   * is counted in the N-dimensional bin given by the bins of its
+   * components, where NumberOfBins, BinOrigin and BinSpacing are used for
+   * every component.  The ActiveComponent is ignored.  This is meant for
+   * two-dimensional transfer functions and for mutual information.
+   */
+  vtkSetMacro(GenerateJointHistogram, vtkTypeBool);
+  vtkBooleanMacro(GenerateJointHistogram, vtkTypeBool);
+  vtkGetMacro(GenerateJointHistogram, vtkTypeBool);
+  ///@}
+
+  /**
+   * Get the joint histogram, if GenerateJointHistogram is On.  Only the
+   * bins that are not empty are stored.  For an image with N components,
+   * each tuple has N+1 components: the bin index for each component,
+   * followed by the count.  The tuples are sorted with the bin index of
+   * the first component varying fastest.  You must call Update() before
+   * calling this method.
+   */
+  vtkIdTypeArray* GetJointHistogram();
+
   /**
    * This is part of the executive, but is public so that it can be accessed
    * by non-member functions.
@@ -199,6 +224,12 @@ protected:
    */
   void ComputeImageScalarRange(vtkImageData* data, double range[2]);
 
+  /**
+   * Compute the joint histogram of all the components of the data with
+   * vtkSMPTools, with the bins of each thread summed at the end.
+   */
+  void ComputeJointHistogram(vtkImageData* data);
+
   int ActiveComponent;
   vtkTypeBool AutomaticBinning;
   int MaximumNumberOfBins;
@@ -206,12 +237,14 @@ protected:
   int HistogramImageSize[2];
   int HistogramImageScale;
   vtkTypeBool GenerateHistogramImage;
+  vtkTypeBool GenerateJointHistogram;
 
   int NumberOfBins;
   double BinOrigin;
   double BinSpacing;
 
   vtkIdTypeArray* Histogram;
+  vtkIdTypeArray* JointHistogram;
   vtkIdType Total;
 
   // Used for vtkMultiThreader operation.
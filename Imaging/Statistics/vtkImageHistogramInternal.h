@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkImageHistogramInternal
+ * @brief   thread-local histogram bins for the image statistics filters
+ *
+ * This file holds the bin counts that vtkImageAccumulate and
+ * vtkImageHistogram accumulate in each thread with vtkSMPTools, before they
+ * are summed in the reduction. A histogram with few bins is stored as an
+ * array. A histogram with more bins, such as a joint histogram of several
+ * components, is stored as a hash map of the bins that are not empty, so
+ * that the memory that each thread uses is proportional to the number of
+ * voxels it visits rather than to the number of bins.
+ *
+ * The work is split along the slowest axis of the extent that has more than
+ * one slice, so that each piece can be visited with a vtkImageStencilIterator.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkImageAccumulate vtkImageHistogram
+ */
+
+#ifndef vtkImageHistogramInternal_h
+#define vtkImageHistogramInternal_h
+
+#include "vtkType.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Histograms with more bins than this are stored sparsely.
+constexpr vtkIdType VTK_HISTOGRAM_MAX_DENSE_BINS = 1 << 20;
+
+// The bin counts of one thread.
+class vtkImageHistogramBins
+{
+public:
+  // Allocate the bins on first use, all counts are zero.
+  void Initialize(vtkIdType numberOfBins)
+  {
+    this->Sparse = (numberOfBins > VTK_HISTOGRAM_MAX_DENSE_BINS);
+    if (!this->Sparse)
+    {
+      this->Dense.assign(numberOfBins, 0);
+    }
+  }
+
+  void Add(vtkIdType bin, vtkIdType count = 1)
+  {
+    if (this->Sparse)
+    {
+      this->Map[bin] += count;
+    }
+    else
+    {
+      this->Dense[bin] += count;
+    }
+  }
+
+  // Add the counts to a histogram with the same number of bins.
+  void AddTo(vtkIdType* histogram) const
+  {
+    if (this->Sparse)
+    {
+      for (const auto& bin : this->Map)
+      {
+        histogram[bin.first] += bin.second;
+      }
+    }
+    else
+    {
+      vtkIdType n = static_cast<vtkIdType>(this->Dense.size());
+      for (vtkIdType i = 0; i < n; i++)
+      {
+        histogram[i] += this->Dense[i];
+      }
+    }
+  }
+
+  // Add the counts of the bins that are not empty to a sparse histogram.
+  void AddTo(std::unordered_map<vtkIdType, vtkIdType>& histogram) const
+  {
+    if (this->Sparse)
+    {
+      for (const auto& bin : this->Map)
+      {
+        histogram[bin.first] += bin.second;
+      }
+    }
+    else
+    {
+      vtkIdType n = static_cast<vtkIdType>(this->Dense.size());
+      for (vtkIdType i = 0; i < n; i++)
+      {
+        if (this->Dense[i] != 0)
+        {
+          histogram[i] += this->Dense[i];
+        }
+      }
+    }
+  }
+
+private:
+  bool Sparse = false;
+  std::vector<vtkIdType> Dense;
+  std::unordered_map<vtkIdType, vtkIdType> Map;
+};
+
+// The axis along which the extent is split, and the number of pieces.
+inline vtkIdType vtkImageHistogramNumberOfPieces(const int extent[6], int& axis)
+{
+  axis = 2;
+  while (axis > 0 && extent[2 * axis] == extent[2 * axis + 1])
+  {
+    axis--;
+  }
+  return extent[2 * axis + 1] - extent[2 * axis] + 1;
+}
+
+// The extent of the pieces from begin to end (exclusive).
+inline void vtkImageHistogramPieceExtent(
+  const int extent[6], int axis, vtkIdType begin, vtkIdType end, int pieceExtent[6])
+{
+  for (int i = 0; i < 6; i++)
+  {
+    pieceExtent[i] = extent[i];
+  }
+  pieceExtent[2 * axis] = extent[2 * axis] + static_cast<int>(begin);
+  pieceExtent[2 * axis + 1] = extent[2 * axis] + static_cast<int>(end) - 1;
+}
+
+} // anonymous namespace
+
+#endif // vtkImageHistogramInternal_h
+// VTK-HeaderTest-Exclude: vtkImageHistogramInternal.h
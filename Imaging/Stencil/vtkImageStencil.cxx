@@ -9,8 +9,11 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkRunLengthArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -231,6 +234,58 @@ void vtkImageStencilExecute(vtkImageStencil* self, vtkImageData* inData, T*, vtk
   }
 }
 
+//------------------------------------------------------------------------------
+// Execute the filter for input scalars that are stored as runs along the
+// rows, by decoding the runs directly into the output spans.  Returns false
+// if the input scalars are not a vtkRunLengthArray.
+template <class T>
+bool vtkImageStencilRunLengthExecute(vtkImageStencil* self, vtkImageData* inData,
+  vtkImageData* outData, T*, int outExt[6], int id, vtkInformation* outInfo)
+{
+  vtkRunLengthArray<T>* inArray =
+    vtkArrayDownCast<vtkRunLengthArray<T>>(inData->GetPointData()->GetScalars());
+  const int* inExt = inData->GetExtent();
+  const vtkIdType rowsPerSlice = inExt[3] - inExt[2] + 1;
+  if (!inArray || !inArray->GetBackend() || inArray->GetNumberOfComponents() != 1 ||
+    inArray->GetBackend()->GetRowLength() != inExt[1] - inExt[0] + 1 ||
+    inArray->GetBackend()->GetNumberOfRows() != rowsPerSlice * (inExt[5] - inExt[4] + 1))
+  {
+    return false;
+  }
+  const vtkRunLengthImplicitBackend<T>* runs = inArray->GetBackend().get();
+
+  vtkImageStencilIterator<T> outIter(outData, self->GetStencil(), outExt, self, id);
+
+  // whether to reverse the stencil
+  bool reverseStencil = (self->GetReverseStencil() != 0);
+
+  T* background;
+  vtkAllocBackground(self, background, outInfo);
+
+  while (!outIter.IsAtEnd())
+  {
+    T* outPtr = outIter.BeginSpan();
+    T* outSpanEndPtr = outIter.EndSpan();
+
+    if (outIter.IsInStencil() ^ reverseStencil)
+    {
+      const int* idx = outIter.GetIndex();
+      const vtkIdType row = (idx[1] - inExt[2]) + (idx[2] - inExt[4]) * rowsPerSlice;
+      const int start = idx[0] - inExt[0];
+      runs->DecodeRow(row, start, start + static_cast<int>(outSpanEndPtr - outPtr) - 1, outPtr);
+    }
+    else
+    {
+      std::fill(outPtr, outSpanEndPtr, *background);
+    }
+
+    outIter.NextSpan();
+  }
+
+  vtkFreeBackground(self, background);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkImageStencil::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector, vtkImageData*** inData,
@@ -240,11 +295,28 @@ void vtkImageStencil::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
   void* outPtr;
   vtkImageData* inData2 = this->GetBackgroundInput();
 
-  inPtr = inData[0][0]->GetScalarPointer();
   outPtr = outData[0]->GetScalarPointerForExtent(outExt);
 
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
+  // input scalars stored as runs are used without creating the values of
+  // every voxel, unless a background input is used
+  if (inData2 == nullptr)
+  {
+    bool done = false;
+    switch (inData[0][0]->GetScalarType())
+    {
+      vtkTemplateMacro(done = vtkImageStencilRunLengthExecute(this, inData[0][0], outData[0],
+                         static_cast<VTK_TT*>(outPtr), outExt, id, outInfo));
+    }
+    if (done)
+    {
+      return;
+    }
+  }
+
+  inPtr = inData[0][0]->GetScalarPointer();
+
   inPtr2 = nullptr;
   if (inData2)
   {
@@ -7,8 +7,12 @@
 #include "vtkImageStencilIterator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkRunLengthArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeTraits.h"
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageStencilToImage);
@@ -19,6 +23,7 @@ vtkImageStencilToImage::vtkImageStencilToImage()
   this->OutsideValue = 0;
   this->InsideValue = 1;
   this->OutputScalarType = VTK_UNSIGNED_CHAR;
+  this->RunLengthOutput = 0;
 
   this->SetNumberOfInputPorts(1);
 }
@@ -53,14 +58,13 @@ int vtkImageStencilToImage::RequestInformation(vtkInformation* vtkNotUsed(reques
 
 //------------------------------------------------------------------------------
 template <class T>
-void vtkImageStencilToImageExecute(vtkImageStencilToImage* self, vtkImageStencilData* stencil,
-  vtkImageData* outData, T*, int outExt[6], int id)
+void vtkImageStencilToImageClampValues(vtkImageStencilToImage* self, T& inValue, T& outValue)
 {
   double inValueD = self->GetInsideValue();
   double outValueD = self->GetOutsideValue();
 
-  double tmin = outData->GetScalarTypeMin();
-  double tmax = outData->GetScalarTypeMax();
+  double tmin = vtkTypeTraits<T>::Min();
+  double tmax = vtkTypeTraits<T>::Max();
 
   if (inValueD < tmin)
   {
@@ -79,8 +83,17 @@ void vtkImageStencilToImageExecute(vtkImageStencilToImage* self, vtkImageStencil
     outValueD = tmax;
   }
 
-  T inValue = static_cast<T>(inValueD);
-  T outValue = static_cast<T>(outValueD);
+  inValue = static_cast<T>(inValueD);
+  outValue = static_cast<T>(outValueD);
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkImageStencilToImageExecute(vtkImageStencilToImage* self, vtkImageStencilData* stencil,
+  vtkImageData* outData, T*, int outExt[6], int id)
+{
+  T inValue, outValue;
+  vtkImageStencilToImageClampValues(self, inValue, outValue);
 
   vtkImageStencilIterator<T> outIter(outData, stencil, outExt, self, id);
 
@@ -109,6 +122,43 @@ void vtkImageStencilToImageExecute(vtkImageStencilToImage* self, vtkImageStencil
   }
 }
 
+//------------------------------------------------------------------------------
+// Create the output scalars from the extents of the stencil, without
+// allocating a value for each voxel.
+template <class T>
+void vtkImageStencilToImageRunLength(
+  vtkImageStencilToImage* self, vtkImageStencilData* stencil, vtkImageData* outData, T*)
+{
+  T inValue, outValue;
+  vtkImageStencilToImageClampValues(self, inValue, outValue);
+
+  const int* extent = outData->GetExtent();
+  const int rowLength = extent[1] - extent[0] + 1;
+  const vtkIdType numRows =
+    static_cast<vtkIdType>(extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1);
+
+  vtkNew<vtkRunLengthArray<T>> scalars;
+  scalars->ConstructBackend(rowLength, numRows, outValue);
+  auto backend = scalars->GetBackend();
+  vtkIdType row = 0;
+  for (int idZ = extent[4]; idZ <= extent[5]; idZ++)
+  {
+    for (int idY = extent[2]; idY <= extent[3]; idY++)
+    {
+      int iter = 0;
+      int r1, r2;
+      while (stencil && stencil->GetNextExtent(r1, r2, extent[0], extent[1], idY, idZ, iter))
+      {
+        backend->InsertNextRun(row, r1 - extent[0], r2 - extent[0], inValue);
+      }
+      row++;
+    }
+  }
+  scalars->SetNumberOfComponents(1);
+  scalars->SetNumberOfTuples(rowLength * numRows);
+  outData->GetPointData()->SetScalars(scalars);
+}
+
 //------------------------------------------------------------------------------
 int vtkImageStencilToImage::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -117,13 +167,26 @@ int vtkImageStencilToImage::RequestData(vtkInformation* vtkNotUsed(request),
   int updateExtent[6];
   outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), updateExtent);
   vtkImageData* outData = static_cast<vtkImageData*>(outInfo->Get(vtkDataObject::DATA_OBJECT()));
-  this->AllocateOutputData(outData, outInfo, updateExtent);
-  void* outPtr = outData->GetScalarPointerForExtent(updateExtent);
-
   vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
   vtkImageStencilData* inData =
     static_cast<vtkImageStencilData*>(inInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+  if (this->RunLengthOutput)
+  {
+    outData->SetExtent(updateExtent);
+    switch (this->OutputScalarType)
+    {
+      vtkTemplateMacro(
+        vtkImageStencilToImageRunLength(this, inData, outData, static_cast<VTK_TT*>(nullptr)));
+      default:
+        vtkErrorMacro("Execute: Unknown ScalarType");
+    }
+    return 1;
+  }
+
+  this->AllocateOutputData(outData, outInfo, updateExtent);
+  void* outPtr = outData->GetScalarPointerForExtent(updateExtent);
+
   switch (outData->GetScalarType())
   {
     vtkTemplateMacro(vtkImageStencilToImageExecute(
@@ -154,5 +217,6 @@ void vtkImageStencilToImage::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "InsideValue: " << this->InsideValue << "\n";
   os << indent << "OutsideValue: " << this->OutsideValue << "\n";
   os << indent << "OutputScalarType: " << this->OutputScalarType << "\n";
+  os << indent << "RunLengthOutput: " << (this->RunLengthOutput ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
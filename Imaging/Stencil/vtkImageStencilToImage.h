@@ -9,6 +9,10 @@
  * inside the stencil and 0 outside.  When used in combination with
  * vtkPolyDataToImageStencil or vtkImplicitFunctionToImageStencil, this
  * can be used to create a binary image from a mesh or a function.
+ *
+ * If RunLengthOutput is on, the output scalars are a vtkRunLengthArray that
+ * stores the extents of the stencil instead of a value for every voxel, so
+ * that masks of large images can be created without allocating the image.
  * @sa
  * vtkImplicitModeller
  */
@@ -61,6 +65,19 @@ public:
   void SetOutputScalarTypeToChar() { this->SetOutputScalarType(VTK_CHAR); }
   ///@}
 
+  ///@{
+  /**
+   * Store the output scalars as runs of the inside value along the rows,
+   * with the outside value as background, instead of storing one value for
+   * every voxel.  Filters that are aware of vtkRunLengthArray, such as
+   * vtkImageStencil, vtkImageAccumulate and vtkDiscreteFlyingEdges3D, use
+   * the runs directly.  The default is off.
+   */
+  vtkSetMacro(RunLengthOutput, vtkTypeBool);
+  vtkBooleanMacro(RunLengthOutput, vtkTypeBool);
+  vtkGetMacro(RunLengthOutput, vtkTypeBool);
+  ///@}
+
 protected:
   vtkImageStencilToImage();
   ~vtkImageStencilToImage() override;
@@ -72,6 +89,7 @@ protected:
   double OutsideValue;
   double InsideValue;
   int OutputScalarType;
+  vtkTypeBool RunLengthOutput;
 
   int FillInputPortInformation(int, vtkInformation*) override;
 
@@ -8,6 +8,7 @@
 
 #include "vtkCell.h" // for cell types
 #include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkCellIterator.h"
 #include "vtkDataArray.h"
 #include "vtkGenericCell.h"
@@ -15,6 +16,7 @@
 #include "vtkIdTypeArray.h"
 #include "vtkMappedUnstructuredGrid.h"
 #include "vtkNew.h"
+#include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -437,6 +439,17 @@ void vtkMappedUnstructuredGridGenerator::GenerateMappedUnstructuredGrid(
   *grid = mg;
 }
 
+void vtkMappedUnstructuredGridGenerator::GenerateMappedUnstructuredGrid(
+  vtkUnstructuredGridBase** grid, vtkUnstructuredGrid* ug)
+{
+  MappedGrid* mg = MappedGrid::New();
+  mg->GetImplementation()->Initialize(ug);
+  mg->GetPointData()->ShallowCopy(ug->GetPointData());
+  mg->GetCellData()->ShallowCopy(ug->GetCellData());
+
+  *grid = mg;
+}
+
 vtkMappedUnstructuredGridGenerator* vtkMappedUnstructuredGridGenerator::New()
 {
   return new vtkMappedUnstructuredGridGenerator;
@@ -36,6 +36,14 @@ public:
    */
   static void GenerateMappedUnstructuredGrid(vtkUnstructuredGridBase** grid);
 
+  /**
+   * Generate a mapped unstructured grid that maps to the given grid, with
+   * the same point and cell data. The user is responsible for deleting the
+   * generated grid after use.
+   */
+  static void GenerateMappedUnstructuredGrid(
+    vtkUnstructuredGridBase** grid, vtkUnstructuredGrid* ug);
+
   /**
    * Generate an unstructured grid. The user is responsible
    * for deleting the generated grid after use.
@@ -0,0 +1,838 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*
+CPU micro-benchmarks of the data model and of the core SMP filters. Each
+benchmark is run on synthetic datasets of the requested sizes and, when it is
+threaded, for each of the requested numbers of threads. The timings are
+reported on the standard output and can be written to a JSON file (with a
+layout similar to Google Benchmark's) to track performance regressions.
+
+To add a benchmark, add a call to AddBenchmark() in main(): the setup function
+builds the input data for a given size and returns the function to time, which
+returns the number of items it processed.
+*/
+
+#include "vtkAffineArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkContourFilter.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
+#include "vtkImageData.h"
+#include "vtkImageReslice.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkProbeFilter.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkThreshold.h"
+#include "vtkTransform.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkVersion.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+#include <vtksys/FStream.hxx>
+#include <vtksys/RegularExpression.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Synthetic datasets
+//------------------------------------------------------------------------------
+
+// A size^3 volume holding a perturbed distance field to its center as point
+// data ("Scalars") and cell data ("CellScalars").
+vtkSmartPointer<vtkImageData> MakeVolume(int size)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(size, size, size);
+  const double spacing = 1.0 / (size - 1);
+  image->SetSpacing(spacing, spacing, spacing);
+  image->SetOrigin(-0.5, -0.5, -0.5);
+
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkSMPTools::For(0, image->GetNumberOfPoints(), [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      image->GetPoint(ptId, x);
+      const double r = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+      scalars->SetValue(ptId, static_cast<float>(r + 0.03 * std::sin(25.0 * x[0] * x[1])));
+    }
+  });
+  image->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkFloatArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  cellScalars->SetNumberOfTuples(image->GetNumberOfCells());
+  vtkSMPTools::For(0, image->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellScalars->SetValue(cellId, static_cast<float>(cellId % 97) / 97.0f);
+    }
+  });
+  image->GetCellData()->SetScalars(cellScalars);
+  return image;
+}
+
+// Random points in the bounds of the volume.
+vtkSmartPointer<vtkPoints> MakeRandomPoints(vtkIdType numPts)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = random->GetNextRangeValue(-0.5, 0.5);
+    }
+    points->SetPoint(ptId, x);
+  }
+  return points;
+}
+
+// A closed triangle mesh: an isosurface of the volume.
+vtkSmartPointer<vtkPolyData> MakeSurface(int size)
+{
+  vtkNew<vtkFlyingEdges3D> contour;
+  contour->SetInputData(MakeVolume(size));
+  contour->SetValue(0, 0.35);
+  contour->ComputeNormalsOff();
+  contour->ComputeGradientsOff();
+  contour->Update();
+  return contour->GetOutput();
+}
+
+// The voxels of a (size/2)^3 volume as polyhedral cells, with the point data
+// of the volume. When requested, the polyhedron topology is precomputed.
+vtkSmartPointer<vtkUnstructuredGrid> MakePolyhedra(int size, bool topology)
+{
+  vtkSmartPointer<vtkImageData> volume = MakeVolume(std::max(size / 2, 2));
+  int dims[3];
+  volume->GetDimensions(dims);
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(volume->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < volume->GetNumberOfPoints(); ++ptId)
+  {
+    points->SetPoint(ptId, volume->GetPoint(ptId));
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->ShallowCopy(volume->GetPointData());
+  grid->AllocateExact(volume->GetNumberOfCells(), 8 * volume->GetNumberOfCells());
+
+  auto id = [&dims](int i, int j, int k) -> vtkIdType {
+    return i + static_cast<vtkIdType>(dims[0]) * (j + static_cast<vtkIdType>(dims[1]) * k);
+  };
+  for (int k = 0; k < dims[2] - 1; ++k)
+  {
+    for (int j = 0; j < dims[1] - 1; ++j)
+    {
+      for (int i = 0; i < dims[0] - 1; ++i)
+      {
+        const vtkIdType p[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        const vtkIdType faces[] = { 4, p[0], p[3], p[2], p[1], 4, p[4], p[5], p[6], p[7], 4, p[0],
+          p[1], p[5], p[4], 4, p[1], p[2], p[6], p[5], 4, p[2], p[3], p[7], p[6], 4, p[3], p[0],
+          p[4], p[7] };
+        grid->InsertNextCell(VTK_POLYHEDRON, 8, p, 6, faces);
+      }
+    }
+  }
+  if (topology)
+  {
+    grid->BuildPolyhedronTopology();
+  }
+  return grid;
+}
+
+template <typename ArrayT>
+vtkSmartPointer<ArrayT> MakeVectors(vtkIdType numTuples)
+{
+  auto array = vtkSmartPointer<ArrayT>::New();
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType tupleId = 0; tupleId < numTuples; ++tupleId)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      array->SetTypedComponent(tupleId, comp, static_cast<double>(tupleId % 1024) + comp);
+    }
+  }
+  return array;
+}
+
+//------------------------------------------------------------------------------
+// Benchmarked operations
+//------------------------------------------------------------------------------
+
+// The benchmarked loops store a checksum so that they are not optimized out.
+volatile double Sink = 0.0;
+std::atomic<vtkIdType> Checksum(0);
+
+vtkIdType SumWithGetTuple(vtkDataArray* array)
+{
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  double sum = 0.0;
+  double tuple[3];
+  for (vtkIdType tupleId = 0; tupleId < numTuples; ++tupleId)
+  {
+    array->GetTuple(tupleId, tuple);
+    sum += tuple[0] + tuple[1] + tuple[2];
+  }
+  Sink = sum;
+  return numTuples;
+}
+
+template <typename ArrayT>
+vtkIdType SumWithTupleRange(ArrayT* array)
+{
+  double sum = 0.0;
+  for (const auto tuple : vtk::DataArrayTupleRange<3>(array))
+  {
+    sum += tuple[0] + tuple[1] + tuple[2];
+  }
+  Sink = sum;
+  return array->GetNumberOfTuples();
+}
+
+template <typename ArrayT>
+vtkIdType SumWithValueRange(ArrayT* array)
+{
+  double sum = 0.0;
+  for (const auto value : vtk::DataArrayValueRange(array))
+  {
+    sum += value;
+  }
+  Sink = sum;
+  return array->GetNumberOfTuples();
+}
+
+// A cell array of triangles, two triangles per point of a size^3 grid.
+vtkSmartPointer<vtkCellArray> MakeTriangles(int size)
+{
+  const vtkIdType numPts = static_cast<vtkIdType>(size) * size * size;
+  const vtkIdType numCells = 2 * numPts;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> conn;
+  offsets->SetNumberOfValues(numCells + 1);
+  conn->SetNumberOfValues(3 * numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    offsets->SetValue(cellId, 3 * cellId);
+    for (vtkIdType i = 0; i < 3; ++i)
+    {
+      conn->SetValue(3 * cellId + i, (cellId / 2 + i * size) % numPts);
+    }
+  }
+  offsets->SetValue(numCells, 3 * numCells);
+  auto cells = vtkSmartPointer<vtkCellArray>::New();
+  cells->SetData(offsets, conn);
+  return cells;
+}
+
+// Re-execute a filter, returns the given number of processed items.
+vtkIdType UpdateFilter(vtkAlgorithm* filter, vtkIdType numItems)
+{
+  filter->Modified();
+  filter->Update();
+  return numItems;
+}
+
+//------------------------------------------------------------------------------
+// Harness
+//------------------------------------------------------------------------------
+
+using BenchmarkFunction = std::function<vtkIdType()>;
+
+struct Benchmark
+{
+  std::string Name;
+  bool Threaded;
+  std::function<BenchmarkFunction(int)> SetUp;
+};
+
+struct BenchmarkResult
+{
+  std::string Name;
+  int Size;
+  int NumberOfThreads;
+  vtkIdType Items;
+  std::vector<double> Times;
+
+  double Mean() const
+  {
+    double sum = 0.0;
+    for (double time : this->Times)
+    {
+      sum += time;
+    }
+    return sum / this->Times.size();
+  }
+
+  double Median() const
+  {
+    std::vector<double> times(this->Times);
+    std::sort(times.begin(), times.end());
+    const std::size_t mid = times.size() / 2;
+    return times.size() % 2 ? times[mid] : 0.5 * (times[mid - 1] + times[mid]);
+  }
+
+  double Min() const { return *std::min_element(this->Times.begin(), this->Times.end()); }
+
+  double StandardDeviation() const
+  {
+    const double mean = this->Mean();
+    double sum = 0.0;
+    for (double time : this->Times)
+    {
+      sum += (time - mean) * (time - mean);
+    }
+    return this->Times.size() > 1 ? std::sqrt(sum / (this->Times.size() - 1)) : 0.0;
+  }
+
+  std::string RunName() const
+  {
+    std::ostringstream name;
+    name << this->Name << "/" << this->Size << "/threads:" << this->NumberOfThreads;
+    return name.str();
+  }
+};
+
+std::vector<int> ParseList(const std::string& list)
+{
+  std::vector<int> values;
+  std::istringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ','))
+  {
+    if (!item.empty())
+    {
+      values.push_back(std::atoi(item.c_str()));
+    }
+  }
+  return values;
+}
+
+double Now()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+BenchmarkResult Run(const BenchmarkFunction& function, double minTime, int minIterations)
+{
+  BenchmarkResult result;
+  result.Items = function(); // warm up
+  double totalTime = 0.0;
+  while ((totalTime < minTime || static_cast<int>(result.Times.size()) < minIterations) &&
+    result.Times.size() < 10000)
+  {
+    const double start = Now();
+    function();
+    const double time = Now() - start;
+    result.Times.push_back(time);
+    totalTime += time;
+  }
+  return result;
+}
+
+void WriteJSON(std::ostream& os, const std::vector<BenchmarkResult>& results)
+{
+  char date[64];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  os << std::setprecision(9);
+  os << "{\n  \"context\": {\n";
+  os << "    \"date\": \"" << date << "\",\n";
+  os << "    \"vtk_version\": \"" << vtkVersion::GetVTKVersionFull() << "\",\n";
+  os << "    \"smp_backend\": \"" << vtkSMPTools::GetBackend() << "\",\n";
+  os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << "\n";
+  os << "  },\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    const BenchmarkResult& result = results[i];
+    const double median = result.Median();
+    os << (i == 0 ? "\n" : ",\n") << "    {";
+    os << "\"name\": \"" << result.RunName() << "\", ";
+    os << "\"benchmark\": \"" << result.Name << "\", ";
+    os << "\"size\": " << result.Size << ", ";
+    os << "\"threads\": " << result.NumberOfThreads << ", ";
+    os << "\"iterations\": " << result.Times.size() << ", ";
+    os << "\"real_time\": " << result.Mean() << ", ";
+    os << "\"median_time\": " << median << ", ";
+    os << "\"min_time\": " << result.Min() << ", ";
+    os << "\"stddev_time\": " << result.StandardDeviation() << ", ";
+    os << "\"time_unit\": \"s\", ";
+    os << "\"items\": " << result.Items << ", ";
+    os << "\"items_per_second\": " << (median > 0.0 ? result.Items / median : 0.0) << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+std::vector<Benchmark> Benchmarks;
+
+void AddBenchmark(const char* name, bool threaded, std::function<BenchmarkFunction(int)> setUp)
+{
+  Benchmarks.push_back(Benchmark{ name, threaded, setUp });
+}
+
+void AddDataArrayBenchmarks()
+{
+  AddBenchmark("DataArray/AOS/GetTuple", false, [](int size) -> BenchmarkFunction {
+    auto array = MakeVectors<vtkDoubleArray>(static_cast<vtkIdType>(size) * size * size);
+    return [array]() { return SumWithGetTuple(array); };
+  });
+  AddBenchmark("DataArray/AOS/TupleRange", false, [](int size) -> BenchmarkFunction {
+    auto array = MakeVectors<vtkDoubleArray>(static_cast<vtkIdType>(size) * size * size);
+    return [array]() { return SumWithTupleRange(array.Get()); };
+  });
+  AddBenchmark("DataArray/AOS/TupleRangeGeneric", false, [](int size) -> BenchmarkFunction {
+    vtkSmartPointer<vtkDataArray> array =
+      MakeVectors<vtkDoubleArray>(static_cast<vtkIdType>(size) * size * size);
+    return [array]() { return SumWithTupleRange(array.Get()); };
+  });
+  AddBenchmark("DataArray/SOA/GetTuple", false, [](int size) -> BenchmarkFunction {
+    auto array =
+      MakeVectors<vtkSOADataArrayTemplate<double>>(static_cast<vtkIdType>(size) * size * size);
+    return [array]() { return SumWithGetTuple(array); };
+  });
+  AddBenchmark("DataArray/SOA/TupleRange", false, [](int size) -> BenchmarkFunction {
+    auto array =
+      MakeVectors<vtkSOADataArrayTemplate<double>>(static_cast<vtkIdType>(size) * size * size);
+    return [array]() { return SumWithTupleRange(array.Get()); };
+  });
+  AddBenchmark("DataArray/Implicit/GetTuple", false, [](int size) -> BenchmarkFunction {
+    auto array = vtkSmartPointer<vtkAffineArray<double>>::New();
+    array->ConstructBackend(0.5, 1.0);
+    array->SetNumberOfComponents(3);
+    array->SetNumberOfTuples(static_cast<vtkIdType>(size) * size * size);
+    return [array]() { return SumWithGetTuple(array); };
+  });
+  AddBenchmark("DataArray/Implicit/ValueRange", false, [](int size) -> BenchmarkFunction {
+    auto array = vtkSmartPointer<vtkAffineArray<double>>::New();
+    array->ConstructBackend(0.5, 1.0);
+    array->SetNumberOfComponents(3);
+    array->SetNumberOfTuples(static_cast<vtkIdType>(size) * size * size);
+    return [array]() { return SumWithValueRange(array.Get()); };
+  });
+}
+
+void AddCellArrayBenchmarks()
+{
+  AddBenchmark("CellArray/GetNextCell", false, [](int size) -> BenchmarkFunction {
+    auto cells = MakeTriangles(size);
+    return [cells]() {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      vtkIdType sum = 0;
+      for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+      {
+        sum += pts[npts - 1];
+      }
+      Sink = sum;
+      return cells->GetNumberOfCells();
+    };
+  });
+  AddBenchmark("CellArray/Iterator", false, [](int size) -> BenchmarkFunction {
+    auto cells = MakeTriangles(size);
+    return [cells]() {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      vtkIdType sum = 0;
+      auto iter = vtk::TakeSmartPointer(cells->NewIterator());
+      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+      {
+        iter->GetCurrentCell(npts, pts);
+        sum += pts[npts - 1];
+      }
+      Sink = sum;
+      return cells->GetNumberOfCells();
+    };
+  });
+  AddBenchmark("CellArray/GetCellAtId", true, [](int size) -> BenchmarkFunction {
+    auto cells = MakeTriangles(size);
+    return [cells]() {
+      vtkSMPThreadLocalObject<vtkIdList> idLists;
+      vtkSMPTools::For(0, cells->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+        vtkIdList* idList = idLists.Local();
+        vtkIdType npts;
+        const vtkIdType* pts;
+        vtkIdType sum = 0;
+        for (; cellId < endCellId; ++cellId)
+        {
+          cells->GetCellAtId(cellId, npts, pts, idList);
+          sum += pts[npts - 1];
+        }
+        Checksum += sum;
+      });
+      return cells->GetNumberOfCells();
+    };
+  });
+}
+
+void AddLocatorBenchmarks()
+{
+  AddBenchmark("Locator/StaticPointLocator/Build", true, [](int size) -> BenchmarkFunction {
+    auto cloud = vtkSmartPointer<vtkPolyData>::New();
+    cloud->SetPoints(MakeRandomPoints(static_cast<vtkIdType>(size) * size * size));
+    auto locator = vtkSmartPointer<vtkStaticPointLocator>::New();
+    locator->SetDataSet(cloud);
+    return [locator, cloud]() {
+      locator->Modified();
+      locator->BuildLocator();
+      return cloud->GetNumberOfPoints();
+    };
+  });
+  AddBenchmark(
+    "Locator/StaticPointLocator/FindClosestPoint", true, [](int size) -> BenchmarkFunction {
+      auto cloud = vtkSmartPointer<vtkPolyData>::New();
+      cloud->SetPoints(MakeRandomPoints(static_cast<vtkIdType>(size) * size * size));
+      auto locator = vtkSmartPointer<vtkStaticPointLocator>::New();
+      locator->SetDataSet(cloud);
+      locator->BuildLocator();
+      vtkSmartPointer<vtkPoints> queries = MakeRandomPoints(cloud->GetNumberOfPoints());
+      return [locator, cloud, queries]() {
+        const vtkIdType numQueries = queries->GetNumberOfPoints();
+        vtkSMPTools::For(0, numQueries, [&](vtkIdType ptId, vtkIdType endPtId) {
+          double x[3];
+          vtkIdType sum = 0;
+          for (; ptId < endPtId; ++ptId)
+          {
+            queries->GetPoint(ptId, x);
+            sum += locator->FindClosestPoint(x);
+          }
+          Checksum += sum;
+        });
+        return numQueries;
+      };
+    });
+  AddBenchmark("Locator/PointLocator/Build", false, [](int size) -> BenchmarkFunction {
+    auto cloud = vtkSmartPointer<vtkPolyData>::New();
+    cloud->SetPoints(MakeRandomPoints(static_cast<vtkIdType>(size) * size * size));
+    auto locator = vtkSmartPointer<vtkPointLocator>::New();
+    locator->SetDataSet(cloud);
+    return [locator, cloud]() {
+      locator->Modified();
+      locator->BuildLocator();
+      return cloud->GetNumberOfPoints();
+    };
+  });
+  AddBenchmark("Locator/StaticCellLocator/Build", true, [](int size) -> BenchmarkFunction {
+    vtkSmartPointer<vtkPolyData> surface = MakeSurface(size);
+    auto locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+    locator->SetDataSet(surface);
+    return [locator, surface]() {
+      locator->Modified();
+      locator->BuildLocator();
+      return surface->GetNumberOfCells();
+    };
+  });
+  AddBenchmark(
+    "Locator/StaticCellLocator/FindClosestPoint", true, [](int size) -> BenchmarkFunction {
+      vtkSmartPointer<vtkPolyData> surface = MakeSurface(size);
+      auto locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+      locator->SetDataSet(surface);
+      locator->BuildLocator();
+      vtkSmartPointer<vtkPoints> queries = MakeRandomPoints(10 * size * size);
+      return [locator, surface, queries]() {
+        const vtkIdType numQueries = queries->GetNumberOfPoints();
+        vtkSMPThreadLocalObject<vtkGenericCell> cells;
+        vtkSMPTools::For(0, numQueries, [&](vtkIdType ptId, vtkIdType endPtId) {
+          vtkGenericCell* cell = cells.Local();
+          double x[3], closest[3], dist2;
+          vtkIdType cellId;
+          int subId;
+          vtkIdType sum = 0;
+          for (; ptId < endPtId; ++ptId)
+          {
+            queries->GetPoint(ptId, x);
+            locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+            sum += cellId;
+          }
+          Checksum += sum;
+        });
+        return numQueries;
+      };
+    });
+}
+
+void AddFilterBenchmarks()
+{
+  AddBenchmark("Filter/FlyingEdges3D", true, [](int size) -> BenchmarkFunction {
+    auto contour = vtkSmartPointer<vtkFlyingEdges3D>::New();
+    vtkSmartPointer<vtkImageData> volume = MakeVolume(size);
+    contour->SetInputData(volume);
+    contour->SetValue(0, 0.35);
+    contour->ComputeNormalsOn();
+    const vtkIdType numItems = volume->GetNumberOfPoints();
+    return [contour, numItems]() { return UpdateFilter(contour, numItems); };
+  });
+  AddBenchmark("Filter/Threshold", true, [](int size) -> BenchmarkFunction {
+    auto threshold = vtkSmartPointer<vtkThreshold>::New();
+    vtkSmartPointer<vtkImageData> volume = MakeVolume(size);
+    threshold->SetInputData(volume);
+    threshold->SetInputArrayToProcess(
+      0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scalars");
+    threshold->SetLowerThreshold(0.2);
+    threshold->SetUpperThreshold(0.4);
+    threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+    const vtkIdType numItems = volume->GetNumberOfCells();
+    return [threshold, numItems]() { return UpdateFilter(threshold, numItems); };
+  });
+  AddBenchmark("Filter/CellDataToPointData", true, [](int size) -> BenchmarkFunction {
+    vtkNew<vtkThreshold> threshold;
+    threshold->SetInputData(MakeVolume(size));
+    threshold->SetInputArrayToProcess(
+      0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scalars");
+    threshold->SetLowerThreshold(0.45);
+    threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_LOWER);
+    threshold->Update();
+    auto c2p = vtkSmartPointer<vtkCellDataToPointData>::New();
+    c2p->SetInputData(threshold->GetOutput());
+    const vtkIdType numItems = threshold->GetOutput()->GetNumberOfCells();
+    return [c2p, numItems]() { return UpdateFilter(c2p, numItems); };
+  });
+  AddBenchmark("Filter/PolyDataNormals", true, [](int size) -> BenchmarkFunction {
+    auto normals = vtkSmartPointer<vtkPolyDataNormals>::New();
+    vtkSmartPointer<vtkPolyData> surface = MakeSurface(size);
+    normals->SetInputData(surface);
+    normals->SplittingOff();
+    const vtkIdType numItems = surface->GetNumberOfCells();
+    return [normals, numItems]() { return UpdateFilter(normals, numItems); };
+  });
+  AddBenchmark("Filter/ProbeFilter", true, [](int size) -> BenchmarkFunction {
+    vtkNew<vtkPolyData> cloud;
+    cloud->SetPoints(MakeRandomPoints(static_cast<vtkIdType>(size) * size * size));
+    auto probe = vtkSmartPointer<vtkProbeFilter>::New();
+    probe->SetInputData(cloud);
+    probe->SetSourceData(MakeVolume(size));
+    const vtkIdType numItems = cloud->GetNumberOfPoints();
+    return [probe, numItems]() { return UpdateFilter(probe, numItems); };
+  });
+
+  // Polyhedral meshes, with the polyhedra computing their faces and edges
+  // each time they are loaded, and with the precomputed polyhedron topology.
+  AddBenchmark("DataModel/BuildPolyhedronTopology", true, [](int size) -> BenchmarkFunction {
+    vtkSmartPointer<vtkUnstructuredGrid> grid = MakePolyhedra(size, false);
+    return [grid]() {
+      grid->BuildPolyhedronTopology();
+      return grid->GetNumberOfCells();
+    };
+  });
+  for (bool topology : { false, true })
+  {
+    AddBenchmark(topology ? "Filter/ContourPolyhedra/Topology" : "Filter/ContourPolyhedra", false,
+      [topology](int size) -> BenchmarkFunction {
+        auto contour = vtkSmartPointer<vtkContourFilter>::New();
+        vtkSmartPointer<vtkUnstructuredGrid> grid = MakePolyhedra(size, topology);
+        contour->SetInputData(grid);
+        contour->SetValue(0, 0.35);
+        const vtkIdType numItems = grid->GetNumberOfCells();
+        return [contour, numItems]() { return UpdateFilter(contour, numItems); };
+      });
+    AddBenchmark(topology ? "Filter/ProbePolyhedra/Topology" : "Filter/ProbePolyhedra", true,
+      [topology](int size) -> BenchmarkFunction {
+        vtkNew<vtkPolyData> cloud;
+        cloud->SetPoints(MakeRandomPoints(static_cast<vtkIdType>(size) * size * size / 8));
+        auto probe = vtkSmartPointer<vtkProbeFilter>::New();
+        probe->SetInputData(cloud);
+        probe->SetSourceData(MakePolyhedra(size, topology));
+        const vtkIdType numItems = cloud->GetNumberOfPoints();
+        return [probe, numItems]() { return UpdateFilter(probe, numItems); };
+      });
+  }
+
+  // Oblique reslices of the volume, the rates are in output voxels per second.
+  for (int mode : { VTK_RESLICE_LINEAR, VTK_RESLICE_CUBIC })
+  {
+    AddBenchmark(mode == VTK_RESLICE_LINEAR ? "Filter/ImageResliceOblique/Linear"
+                                            : "Filter/ImageResliceOblique/Cubic",
+      true, [mode](int size) -> BenchmarkFunction {
+        vtkNew<vtkTransform> rotation;
+        rotation->RotateWXYZ(33.0, 1.0, 2.0, 3.0);
+        vtkSmartPointer<vtkImageData> volume = MakeVolume(size);
+        auto reslice = vtkSmartPointer<vtkImageReslice>::New();
+        reslice->SetInputData(volume);
+        reslice->SetResliceAxes(rotation->GetMatrix());
+        reslice->SetInterpolationMode(mode);
+        reslice->SetOutputScalarType(VTK_FLOAT);
+        reslice->SetOutputExtent(volume->GetExtent());
+        reslice->SetOutputSpacing(volume->GetSpacing());
+        reslice->SetOutputOrigin(volume->GetOrigin());
+        const vtkIdType numItems = static_cast<vtkIdType>(size) * size * size;
+        return [reslice, numItems]() { return UpdateFilter(reslice, numItems); };
+      });
+  }
+}
+}
+
+/*=========================================================================
+The main entry point
+=========================================================================*/
+int main(int argc, char* argv[])
+{
+  std::string regex;
+  std::string sizes = "32,64,128";
+  std::string threads = "1,2,4,0";
+  std::string jsonFileName;
+  double minTime = 0.5;
+  int minIterations = 3;
+  bool displayHelp = false;
+  bool listBenchmarks = false;
+
+  vtksys::CommandLineArguments arguments;
+  arguments.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arguments.AddArgument("-regex", argT::SPACE_ARGUMENT, &regex,
+    "Specify a regular expression for what benchmarks should be run.");
+  arguments.AddArgument("-sizes", argT::SPACE_ARGUMENT, &sizes,
+    "Specify a comma separated list of dataset sizes. The datasets have about "
+    "size^3 points or cells. Defaults to 32,64,128.");
+  arguments.AddArgument("-threads", argT::SPACE_ARGUMENT, &threads,
+    "Specify a comma separated list of numbers of threads for the threaded "
+    "benchmarks, 0 standing for the default number of threads. Defaults to 1,2,4,0.");
+  arguments.AddArgument("-min-time", argT::SPACE_ARGUMENT, &minTime,
+    "Specify the minimum time in seconds spent running each benchmark. Defaults to 0.5.");
+  arguments.AddArgument("-min-iterations", argT::SPACE_ARGUMENT, &minIterations,
+    "Specify the minimum number of timed iterations of each benchmark. Defaults to 3.");
+  arguments.AddArgument("-json", argT::SPACE_ARGUMENT, &jsonFileName,
+    "Specify a file where to write the results in JSON.");
+  arguments.AddBooleanArgument(
+    "-list", &listBenchmarks, "Provide a listing of available benchmarks.");
+  arguments.AddBooleanArgument(
+    "--help", &displayHelp, "Provide a listing of command line options.");
+  arguments.AddBooleanArgument(
+    "-help", &displayHelp, "Provide a listing of command line options.");
+
+  if (!arguments.Parse())
+  {
+    std::cerr << "Problem parsing arguments" << std::endl;
+    return 1;
+  }
+  if (displayHelp)
+  {
+    std::cerr << "Usage" << std::endl
+              << std::endl
+              << "  CPUBenchmarks [options]" << std::endl
+              << std::endl
+              << "Options" << std::endl;
+    std::cerr << arguments.GetHelp();
+    return 0;
+  }
+
+  AddDataArrayBenchmarks();
+  AddCellArrayBenchmarks();
+  AddLocatorBenchmarks();
+  AddFilterBenchmarks();
+
+  vtksys::RegularExpression re;
+  if (!regex.empty() && !re.compile(regex))
+  {
+    std::cerr << "Invalid regular expression " << regex << std::endl;
+    return 1;
+  }
+
+  if (listBenchmarks)
+  {
+    for (const Benchmark& benchmark : Benchmarks)
+    {
+      if (regex.empty() || re.find(benchmark.Name))
+      {
+        std::cout << benchmark.Name << (benchmark.Threaded ? " (threaded)" : "") << std::endl;
+      }
+    }
+    return 0;
+  }
+
+  const std::vector<int> sizeList = ParseList(sizes);
+  const std::vector<int> threadList = ParseList(threads);
+  std::vector<BenchmarkResult> results;
+  std::cout << std::left << std::setw(56) << "Benchmark" << std::right << std::setw(12)
+            << "Median (s)" << std::setw(12) << "Min (s)" << std::setw(10) << "Iters"
+            << std::setw(14) << "Items/s" << std::endl;
+  for (const Benchmark& benchmark : Benchmarks)
+  {
+    if (!regex.empty() && !re.find(benchmark.Name))
+    {
+      continue;
+    }
+    for (int size : sizeList)
+    {
+      if (size < 2)
+      {
+        continue;
+      }
+      const BenchmarkFunction function = benchmark.SetUp(size);
+      const std::vector<int> benchmarkThreads =
+        benchmark.Threaded ? threadList : std::vector<int>(1, 1);
+      for (int numThreads : benchmarkThreads)
+      {
+        const vtkSMPTools::Config config(
+          numThreads, vtkSMPTools::GetBackend(), vtkSMPTools::GetNestedParallelism());
+        BenchmarkResult result;
+        vtkSMPTools::LocalScope(config, [&]() {
+          result = Run(function, minTime, minIterations);
+          result.NumberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+        });
+        result.Name = benchmark.Name;
+        result.Size = size;
+        const double median = result.Median();
+        std::cout << std::left << std::setw(56) << result.RunName() << std::right
+                  << std::setw(12) << std::setprecision(4) << median << std::setw(12)
+                  << result.Min() << std::setw(10) << result.Times.size() << std::setw(14)
+                  << std::setprecision(4) << (median > 0.0 ? result.Items / median : 0.0)
+                  << std::endl;
+        results.push_back(result);
+      }
+    }
+  }
+
+  if (!jsonFileName.empty())
+  {
+    vtksys::ofstream file(jsonFileName.c_str());
+    if (!file)
+    {
+      std::cerr << "Cannot write " << jsonFileName << std::endl;
+      return 1;
+    }
+    WriteJSON(file, results);
+  }
+  return 0;
+}